@@ -30,6 +30,13 @@ extern "C" {
 
 /* Includes ------------------------------------------------------------------*/
 #include "cca02m2_audio.h"
+#ifdef USE_AUDIO_PIPELINE
+#include "acoustic_bf.h"
+#include "acoustic_sl.h"
+#endif /* USE_AUDIO_PIPELINE */
+#ifdef USE_AUDIO_FEATURES
+#include "fft_mel.h"
+#endif /* USE_AUDIO_FEATURES */
 
 /** @addtogroup X_CUBE_MEMSMIC1_Applications
   * @{
@@ -54,15 +61,176 @@ extern "C" {
 depending on USB functionalities implemented by user*/
 #define DISABLE_USB_DRIVEN_ACQUISITION
 
+#ifdef USE_AUDIO_PIPELINE
+/*Distance between the microphones of a pair, in tenths of a millimeter. AcousticBF with PCM input
+and internal delay requires 21 mm, that is one sample at 16 kHz*/
+#define AUDIO_PIPELINE_MIC_DISTANCE     210U
+
+/*The IRQs below are not used by the application and are triggered by software
+to run the library processing out of the audio interrupt*/
+#define SW_TASK1_IRQn                   EXTI1_IRQn
+#define SW_TASK1_IRQHandler             EXTI1_IRQHandler
+#define SW_TASK2_IRQn                   EXTI2_IRQn
+#define SW_TASK2_IRQHandler             EXTI2_IRQHandler
+#define AUDIO_PIPELINE_BF_IT_PRIORITY   (CCA02M2_AUDIO_IN_IT_PRIORITY + 1U)
+#define AUDIO_PIPELINE_SL_IT_PRIORITY   (CCA02M2_AUDIO_IN_IT_PRIORITY + 2U)
+
+/*USB channels, built from the pipeline sources: AUDIO_SRC_MIC(n) is the raw microphone n, AUDIO_SRC_BEAM the
+steered beam and AUDIO_SRC_OMNI the omni reference of AcousticBF, which also stands in for a rear beam: that one
+would take a second AcousticBF instance. Both can be defined in the project, AUDIO_USB_CHANNELS must match the
+number of entries of AUDIO_USB_CHANNEL_MAP, 8 at most (checked at build time). E.g. 2 raw microphones, beam and
+omni reference: { AUDIO_SRC_MIC(0), AUDIO_SRC_MIC(1), AUDIO_SRC_BEAM, AUDIO_SRC_OMNI } on 4 channels*/
+#define AUDIO_SRC_MIC(n)                ((uint8_t)(n))
+#define AUDIO_SRC_BEAM                  0x10U
+#define AUDIO_SRC_OMNI                  0x11U
+#ifndef AUDIO_USB_CHANNEL_MAP
+#define AUDIO_USB_CHANNELS              AUDIO_IN_CHANNELS
+#if (AUDIO_IN_CHANNELS == 4)
+#define AUDIO_USB_CHANNEL_MAP           { AUDIO_SRC_BEAM, AUDIO_SRC_MIC(1), AUDIO_SRC_MIC(2), AUDIO_SRC_MIC(3) }
+#else
+#define AUDIO_USB_CHANNEL_MAP           { AUDIO_SRC_BEAM, AUDIO_SRC_MIC(1) }
+#endif
+#endif /* AUDIO_USB_CHANNEL_MAP */
+#else
+#define AUDIO_USB_CHANNELS              AUDIO_IN_CHANNELS
+#endif /* USE_AUDIO_PIPELINE */
+
+/*Spatial locations of the USB channels (wChannelConfig of the descriptor), 0 leaves all of them unnamed*/
+#define AUDIO_USB_CHANNEL_CONFIG        ((AUDIO_USB_CHANNELS == 2) ? 0x0003U : 0x0000U)
+/*Bytes per sample of the USB stream and of PCM_Buffer: 2, 3 or 4*/
+#define AUDIO_USB_SUBFRAME_SIZE         (AUDIO_IN_BIT_DEPTH / 8U)
+/*Isochronous payload of the USB stream, in bytes per second*/
+#define AUDIO_USB_BANDWIDTH             ((uint32_t)AUDIO_IN_SAMPLING_FREQUENCY * AUDIO_USB_CHANNELS * AUDIO_USB_SUBFRAME_SIZE)
+
+#ifdef USE_AUDIO_FEATURES
+/*Log-mel features of the steered beam for a keyword spotter: 32 ms frames every 10 ms,
+passed to Audio_Features_Ready. Set AUDIO_FEATURES_MFCC to a non-zero value for MFCC*/
+#define AUDIO_FEATURES_FFT_LEN          512U
+#define AUDIO_FEATURES_HOP              160U
+#define AUDIO_FEATURES_MELS             40U
+#define AUDIO_FEATURES_MFCC             0U
+#define AUDIO_FEATURES_F_MIN            20.0f
+#define AUDIO_FEATURES_F_MAX            ((float32_t)AUDIO_IN_SAMPLING_FREQUENCY / 2.0f)
+
+#define SW_TASK3_IRQn                   EXTI3_IRQn
+#define SW_TASK3_IRQHandler             EXTI3_IRQHandler
+#define AUDIO_PIPELINE_FEATURES_IT_PRIORITY (CCA02M2_AUDIO_IN_IT_PRIORITY + 3U)
+#endif /* USE_AUDIO_FEATURES */
+
+/*Records sent on the USB telemetry interface (USE_USB_TELEMETRY in usbd_conf.h): the periodic ones every
+AUDIO_TLM_PERIOD_MS, the AcousticSL one at every estimate. The host writes commands made of the command byte
+followed by its little endian argument*/
+#define AUDIO_TLM_PERIOD_MS             100U
+#define AUDIO_TLM_TIMINGS               0x01U   /* Audio_Tlm_Timings_t, periodic */
+#define AUDIO_TLM_LEVELS                0x02U   /* Audio_Tlm_Levels_t, periodic */
+#define AUDIO_TLM_SL                    0x03U   /* Audio_Tlm_SL_t, at every AcousticSL estimate */
+#define AUDIO_TLM_BF                    0x04U   /* Audio_Tlm_BF_t, periodic */
+#define AUDIO_TLM_USB                   0x05U   /* USBD_AUDIO_StatsTypeDef of the audio class, periodic */
+#define AUDIO_TLM_CMD_PERIOD            0x81U   /* uint16_t period in ms, 0 stops the periodic records */
+#define AUDIO_TLM_CMD_ENABLE            0x82U   /* uint8_t mask, bit n-1 enables the records of type n */
+#define AUDIO_TLM_CMD_BEAM              0x83U   /* int8_t beam locked by the host, -1 to steer on AcousticSL */
+#define AUDIO_TLM_CMD_PDM               0x84U   /* uint8_t 1 starts the raw PDM frames, 0 stops them */
+
+#ifdef USE_AUDIO_PDM_CAPTURE
+/*Raw PDM frames, sent on the telemetry interface every N_MS: an Audio_PDM_Header_t in a short packet, then
+one plane per microphone of AUDIO_PDM_PLANE_SIZE bytes. The SPI captures the bits MSB first in 16-bit words,
+stored little endian: swap the bytes of each word for the bit stream in time order*/
+#define AUDIO_PDM_MAGIC                 0x314D4450U   /* "PDM1" */
+#define AUDIO_PDM_MICS                  2U
+#define AUDIO_PDM_PLANE_SIZE            ((AUDIO_PDM_CLOCK / 8000U) * N_MS)
+#define AUDIO_PDM_FORMAT_SPI16_MSB      0x01U
+#endif /* USE_AUDIO_PDM_CAPTURE */
 
 /**
   * @}
   */
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup AUDIO_APPLICATION_Exported_Types
+  * @{
+  */
+typedef struct
+{
+  uint32_t Channels;                            /* channels of the USB stream */
+  uint32_t Bandwidth;                           /* USB payload, in bytes per second */
+  uint32_t InterleaveCycles;                    /* CPU cycles of the last interleave into the USB ring */
+  uint32_t ProcessCycles;                       /* CPU cycles of the last AudioProcess */
+  uint32_t MicSkew;                             /* capture skew of the microphones in samples, UINT32_MAX until
+                                                   measured by Audio_Idle_Process */
+  uint32_t SLOverruns;                          /* AcousticSL windows overwritten before the SW task 2 estimated them */
+  CCA02M2_AUDIO_IN_Counters_t Capture;          /* sample time and overruns of the capture */
+} Audio_Stream_Info_t;
+
+typedef struct
+{
+  uint32_t ProcessCycles;                       /* last AudioProcess, audio interrupt */
+  uint32_t ProcessMaxCycles;                    /* longest AudioProcess since the previous record */
+  uint32_t InterleaveCycles;                    /* last interleave into the USB ring */
+  uint32_t BFCycles;                            /* last AcousticBF second step, SW task 1 */
+  uint32_t SLCycles;                            /* last AcousticSL estimate, SW task 2 */
+  uint32_t FeaturesCycles;                      /* last log-mel frame, SW task 3 */
+} Audio_Tlm_Timings_t;
+
+typedef struct
+{
+  uint32_t CapturePending;                      /* frames captured and not processed yet */
+  uint32_t TelemetryDropped;                    /* records lost on a full telemetry queue */
+  uint32_t MicSkew;                             /* capture skew of the microphones in samples, UINT32_MAX until
+                                                   measured by Audio_Idle_Process */
+  uint32_t CaptureLate;                         /* blocks still processed when captured again */
+  uint32_t CaptureMissed;                       /* blocks overwritten before their interrupt was served */
+  uint32_t CaptureReentries;                    /* capture callbacks entered while the previous one ran */
+  uint32_t SLOverruns;                          /* AcousticSL windows lost, see Audio_Stream_Info_t */
+} Audio_Tlm_Levels_t;
+
+typedef struct
+{
+  int16_t Angle;                                /* AcousticSL angle, ACOUSTIC_SL_NO_AUDIO_DETECTED on silence */
+  uint8_t BeamTarget;                           /* beam selected */
+  uint8_t BeamCurrent;                          /* beam on the output, differs while switching */
+  uint32_t Window;                              /* samples analysed for the estimate */
+  uint64_t SampleTime;                          /* capture sample following the window, see Audio_Stream_Info_t */
+} Audio_Tlm_SL_t;
+
+typedef struct
+{
+  uint32_t BeamPower;                           /* mean square of the beam output, 16-bit scale */
+  uint32_t OmniPower;                           /* mean square of the omni reference, 16-bit scale */
+  uint32_t Samples;                             /* samples averaged */
+} Audio_Tlm_BF_t;
+
+typedef struct
+{
+  uint32_t Magic;                               /* AUDIO_PDM_MAGIC */
+  uint32_t Sequence;                            /* frame number, also counts the frames dropped */
+  uint32_t Clock;                               /* microphone clock, in Hz */
+  uint16_t PlaneSize;                           /* bytes per microphone */
+  uint8_t Mics;                                 /* planes following the header */
+  uint8_t Format;                               /* AUDIO_PDM_FORMAT_SPI16_MSB */
+} Audio_PDM_Header_t;
+/**
+  * @}
+  */
+
 /* Exported functions ------------------------------------------------------- */
 void Init_Acquisition_Peripherals(uint32_t AudioFreq, uint32_t ChnlNbrIn, uint32_t ChnlNbrOut);
+void Audio_Get_Stream_Info(Audio_Stream_Info_t *info);
+void Audio_Idle_Process(void);
+int8_t Audio_Telemetry_Command(uint8_t *Buf, uint32_t Len);
 void Start_Acquisition(void);
+int32_t Audio_Capture_Start(void);
 void Error_Handler(void);
 void AudioProcess(void);
+#ifdef USE_AUDIO_PIPELINE
+void SW_Task1_Start(void);
+void SW_Task2_Start(void);
+void SW_Task1_Callback(void);
+void SW_Task2_Callback(void);
+#endif /* USE_AUDIO_PIPELINE */
+#ifdef USE_AUDIO_FEATURES
+void SW_Task3_Start(void);
+void SW_Task3_Callback(void);
+void Audio_Features_Ready(const int16_t *features, uint32_t len);
+#endif /* USE_AUDIO_FEATURES */
 
 /**
   * @}
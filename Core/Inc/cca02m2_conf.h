@@ -48,8 +48,45 @@ modification in the application layer developed with the older versions of the d
 
 #define N_MS (N_MS_PER_INTERRUPT)
 
+/*Microphones captured by the DFSDM, 2 or 4. With 4 the MIC3 and MIC4 coupons of the CCA02M2 (DATIN on PB10)
+are captured too: the four filters convert the same samples, see CCA02M2_AUDIO_IN_CheckSkew*/
 #define AUDIO_IN_CHANNELS 2
+
+/*Milliseconds of audio in each DMA block of the DFSDM, 1 to AUDIO_IN_MAX_BLOCK_MS (16). The driver interrupts once
+per block and the pipeline runs the libraries on each millisecond of it: 8 divides the interrupt rate by 8 for a
+beam forming only product, 1 keeps the lowest latency. The USB packet ring must hold AUDIO_IN_RING_BLOCKS blocks,
+define AUDIO_IN_RING_SIZE in the project for longer blocks*/
+#define AUDIO_IN_BLOCK_MS 1U
+
+/*Uncomment this define to run the localization and beam forming pipeline. Without it the firmware streams
+the raw microphones at 48 kHz, as the original X-CUBE-MEMSMIC1 application. AcousticBF processes PCM at
+16 kHz, so with the pipeline the capture and the USB stream run at this frequency and the stream carries the
+channels of AUDIO_USB_CHANNEL_MAP (beam and MIC1 by default, see audio_application.h)*/
+/*#define USE_AUDIO_PIPELINE*/
+
+#ifdef USE_AUDIO_PIPELINE
+#define AUDIO_IN_SAMPLING_FREQUENCY 16000
+/*Comment this define to skip the log-mel feature extraction on the steered beam*/
+#define USE_AUDIO_FEATURES
+/*Comment this define to capture the microphones interleaved in PCM_Buffer. With it the driver converts each
+microphone into its own plane, read in place by the pipeline (16-bit samples only)*/
+#define USE_AUDIO_PLANAR_CAPTURE
+#else
 #define AUDIO_IN_SAMPLING_FREQUENCY 48000
+#endif /* USE_AUDIO_PIPELINE */
+
+/*Uncomment this define to stream the raw PDM bits of MIC1 and MIC2 on the USB telemetry interface
+(USE_USB_TELEMETRY) instead of running the pipeline, for offline algorithm development. The DFSDM only
+drives the microphone clock, the bits are captured by SPI2 and SPI3 in slave mode: wire PC2 (CKOUT) to
+PB13 and PC10, PB14 to PC11 (see README.md). Two microphones only: AUDIO_IN_CHANNELS must be 2*/
+/*#define USE_AUDIO_PDM_CAPTURE*/
+/*Microphone clock of the raw PDM capture, in Hz: 1024000 matches the PDM input of AcousticBF*/
+#define AUDIO_PDM_CLOCK                 1024000U
+
+/*Resolution of the captured samples and of the USB stream: AUDIO_RESOLUTION_16b, AUDIO_RESOLUTION_24b
+(packed in 3 bytes) or AUDIO_RESOLUTION_32b (24 significant bits, left-justified). At the same volume
+24 and 32-bit samples are 16 times the 16-bit ones, with 3 more bits of the DFSDM output and no clipping*/
+#define AUDIO_IN_BIT_DEPTH              AUDIO_RESOLUTION_16b
 
 #define AUDIO_IN_BUFFER_SIZE            DEFAULT_AUDIO_IN_BUFFER_SIZE
 #define AUDIO_VOLUME_INPUT              64U
@@ -64,6 +64,9 @@ void AUDIO_DFSDM_DMAx_MIC2_IRQHandler(void);
 void AUDIO_DFSDM_DMAx_MIC3_IRQHandler(void);
 void AUDIO_DFSDM_DMAx_MIC4_IRQHandler(void);
 void AUDIO_IN_I2S_IRQHandler(void);
+void EXTI1_IRQHandler(void);
+void EXTI2_IRQHandler(void);
+void EXTI3_IRQHandler(void);
 /* USER CODE END EFP */
 
 #ifdef __cplusplus
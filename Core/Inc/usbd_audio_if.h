@@ -29,13 +29,28 @@ extern "C" {
 
 
 /* Includes ------------------------------------------------------------------*/
+#include "usbd_conf.h"
+#ifdef USE_USB_AUDIO_CLASS_2
+#include "usbd_audio2_in.h"
+#else
 #include "usbd_audio_in.h"
+#endif /* USE_USB_AUDIO_CLASS_2 */
+#ifdef USE_USB_TELEMETRY
+#include "usbd_telemetry.h"
+#endif /* USE_USB_TELEMETRY */
 #include "cube_hal.h"
 /* Exported types ------------------------------------------------------------*/
 /* Exported constants --------------------------------------------------------*/
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
 void Send_Audio_to_USB(int16_t *audioData, uint16_t PCMSamples);
+int16_t *Reserve_Audio_to_USB(uint16_t PCMSamples);
+void Commit_Audio_to_USB(uint16_t PCMSamples);
+void Get_USB_Audio_Stats(USBD_AUDIO_StatsTypeDef *stats, uint8_t ResetPeaks);
+#ifdef USE_USB_TELEMETRY
+uint8_t Send_Telemetry_to_USB(uint8_t Type, const void *pData, uint8_t Size);
+uint8_t Send_PDM_to_USB(const void *pHeader, uint8_t HeaderSize, uint8_t *const pPlanes[], uint16_t PlaneSize, uint8_t Planes);
+#endif /* USE_USB_TELEMETRY */
 
 
 #ifdef __cplusplus
@@ -57,8 +57,17 @@ extern "C" {
 extern PCD_HandleTypeDef hpcd;
 /* Exported types ------------------------------------------------------------*/
 /* Exported constants --------------------------------------------------------*/
+/* Vendor specific bulk interface (Class/TELEMETRY) added next to the microphone:
+   DSP telemetry to the host and configuration writes from it. Comment out for
+   an audio only device. */
+#define USE_USB_TELEMETRY
+
 /* Common Config */
+#ifdef USE_USB_TELEMETRY
+#define USBD_MAX_NUM_INTERFACES               3
+#else
 #define USBD_MAX_NUM_INTERFACES               2
+#endif
 #define USBD_MAX_NUM_CONFIGURATION            1
 #define USBD_MAX_STR_DESC_SIZ                 200
 #define USBD_SUPPORT_USER_STRING              0
@@ -68,6 +77,9 @@ extern PCD_HandleTypeDef hpcd;
 /* AUDIO Class Config */
 #define USBD_AUDIO_FREQ                       48000
 #define AUDIO_TOTAL_IF_NUM              0x02
+/* Uncomment to enumerate as a USB Audio Class 2.0 microphone (Class/AUDIO2),
+   whose sampling frequency can be switched by the host */
+/* #define USE_USB_AUDIO_CLASS_2 */
 
 /* Exported macro ------------------------------------------------------------*/
 /* Memory management macros */
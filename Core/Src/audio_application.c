@@ -23,6 +23,33 @@
 #include "audio_application.h"
 #include "usbd_audio_if.h"
 
+#if defined(USE_AUDIO_PDM_CAPTURE) && !defined(USE_USB_TELEMETRY)
+#error "USE_AUDIO_PDM_CAPTURE streams the PDM frames on the telemetry interface, define USE_USB_TELEMETRY"
+#endif
+#if defined(USE_AUDIO_PDM_CAPTURE) && (AUDIO_IN_CHANNELS > 2)
+#error "USE_AUDIO_PDM_CAPTURE records MIC1 and MIC2 only, the two SPI of the shared data line: set AUDIO_IN_CHANNELS to 2"
+#endif
+#if (AUDIO_IN_CHANNELS != 2) && (AUDIO_IN_CHANNELS != 4)
+#error "AUDIO_IN_CHANNELS must be 2 or 4"
+#endif
+#if defined(USE_AUDIO_PLANAR_CAPTURE) && (!defined(USE_AUDIO_PIPELINE) || (AUDIO_IN_BIT_DEPTH != AUDIO_RESOLUTION_16b))
+#error "USE_AUDIO_PLANAR_CAPTURE feeds the pipeline with 16-bit planes, define USE_AUDIO_PIPELINE and AUDIO_RESOLUTION_16b"
+#endif
+#if (AUDIO_IN_BLOCK_MS < 1) || (AUDIO_IN_BLOCK_MS > AUDIO_IN_MAX_BLOCK_MS)
+#error "AUDIO_IN_BLOCK_MS must be 1 to AUDIO_IN_MAX_BLOCK_MS"
+#endif
+#if !defined(USE_AUDIO_PDM_CAPTURE) && ((AUDIO_IN_RING_BLOCKS * (AUDIO_IN_SAMPLING_FREQUENCY / 1000) * AUDIO_USB_CHANNELS \
+                                         * AUDIO_USB_SUBFRAME_SIZE * AUDIO_IN_BLOCK_MS) > AUDIO_IN_RING_SIZE)
+#error "The USB packet ring holds AUDIO_IN_RING_BLOCKS blocks of AUDIO_IN_BLOCK_MS, define a larger AUDIO_IN_RING_SIZE"
+#endif
+/* The packets of the stream, up to two frames more than nominal while the rate
+   is corrected, fit the packet buffers of the class and its TX FIFO (0xC8 words
+   in usbd_conf_l4.c), and a full speed isochronous endpoint */
+#if ((((AUDIO_IN_SAMPLING_FREQUENCY / 1000) + 2) * AUDIO_USB_CHANNELS * AUDIO_USB_SUBFRAME_SIZE) > AUDIO_IN_PACKET_BYTES) \
+    || ((((AUDIO_IN_SAMPLING_FREQUENCY / 1000) + 2) * AUDIO_USB_CHANNELS * AUDIO_USB_SUBFRAME_SIZE) > 1023)
+#error "A USB packet exceeds AUDIO_IN_PACKET or 1023 bytes, lower AUDIO_IN_SAMPLING_FREQUENCY, AUDIO_USB_CHANNELS or AUDIO_IN_BIT_DEPTH"
+#endif
+
 /** @addtogroup X_CUBE_MEMSMIC1_Applications
   * @{
   */
@@ -36,13 +63,70 @@
   */
 
 /* Private typedef -----------------------------------------------------------*/
+#ifdef USE_AUDIO_PIPELINE
+/* Cardioid beam formed on a microphone pair, pointing to the front microphone */
+typedef struct
+{
+  uint8_t front_mic;                            /* channel of the front microphone in PCM_Buffer */
+  uint8_t rear_mic;                             /* channel of the rear microphone in PCM_Buffer */
+  int16_t direction;                            /* AcousticSL angle of the beam, in degrees */
+} Beam_t;
+
+typedef enum
+{
+  BEAM_STEADY = 0,
+  BEAM_FADE_OUT,
+  BEAM_FADE_IN
+} Beam_State_t;
+
+#if (AUDIO_IN_BIT_DEPTH == AUDIO_RESOLUTION_16b)
+typedef int16_t Usb_Sample_t;
+#else
+typedef int32_t Usb_Sample_t;                   /* 24 significant bits, left-justified */
+#endif
+#endif /* USE_AUDIO_PIPELINE */
+
 /* Private define ------------------------------------------------------------*/
+#define SAMPLES_PER_MS                  (AUDIO_IN_SAMPLING_FREQUENCY / 1000)
+
+#ifdef USE_AUDIO_PIPELINE
+#define SL_SAMPLES_TO_PROCESS           256U    /* GCC-PHAT window: one estimate every 16 ms */
+#define SL_HOP_MS                       (SL_SAMPLES_TO_PROCESS / SAMPLES_PER_MS) /* between two windows */
+#define BEAM_CROSSFADE_SAMPLES          (4U * SAMPLES_PER_MS) /* each half of a switch, through the omni reference */
+#define BEAM_HYSTERESIS                 15      /* degrees a new beam must win by before switching */
+#define ACOUSTIC_MEMORY_SIZE            (32U * 1024U) /* bytes, shared by AcousticBF and AcousticSL */
+
+#if (AUDIO_IN_CHANNELS == 4)
+/* End-fire directions of the M1-M2 and M3-M4 pairs in the 4 channels AcousticSL reference */
+#define BEAMS_TABLE                     { {0, 1, 90}, {1, 0, 270}, {2, 3, 0}, {3, 2, 180} }
+#else
+/* End-fire directions of the pair in the 2 channels AcousticSL reference (-90..90) */
+#define BEAMS_TABLE                     { {0, 1, -90}, {1, 0, 90} }
+#endif
+#define BEAMS_NUMBER                    (sizeof(Beams) / sizeof(Beam_t))
+
+#if (AUDIO_IN_BIT_DEPTH == AUDIO_RESOLUTION_16b)
+#define USB_SAMPLE_SCALE                1
+#else
+#define USB_SAMPLE_SCALE                4096    /* 16-bit pipeline sample to the left-justified 24-bit scale */
+#endif
+#endif /* USE_AUDIO_PIPELINE */
+
+#ifdef USE_AUDIO_FEATURES
+#define AUDIO_FEATURES_MEMORY_SIZE      (16U * 1024U) /* bytes, log-mel extractor arena */
+#endif /* USE_AUDIO_FEATURES */
+
 /* Private macro -------------------------------------------------------------*/
 
 /** @defgroup AUDIO_APPLICATION_Exported_Variables
   * @{
   */
-uint16_t PCM_Buffer[((AUDIO_IN_CHANNELS * AUDIO_IN_SAMPLING_FREQUENCY) / 1000)  * N_MS ];
+/* 24-bit samples are packed by the driver after being filtered as 32-bit words */
+#if (AUDIO_IN_BIT_DEPTH == AUDIO_RESOLUTION_16b)
+uint16_t PCM_Buffer[((AUDIO_IN_CHANNELS * AUDIO_IN_SAMPLING_FREQUENCY) / 1000)  * AUDIO_IN_BLOCK_MS ];
+#else
+uint16_t PCM_Buffer[((AUDIO_IN_CHANNELS * AUDIO_IN_SAMPLING_FREQUENCY) / 1000)  * AUDIO_IN_BLOCK_MS * 2U];
+#endif
 CCA02M2_AUDIO_Init_t MicParams;
 
 /**
@@ -53,6 +137,141 @@ CCA02M2_AUDIO_Init_t MicParams;
   * @{
   */
 /* Private variables ---------------------------------------------------------*/
+#ifndef USE_AUDIO_PDM_CAPTURE
+/* DMA buffers of the driver: two blocks of 32-bit DFSDM results per microphone */
+static int32_t Capture_Arena[CCA02M2_AUDIO_IN_ARENA_SIZE(AUDIO_IN_SAMPLING_FREQUENCY, AUDIO_IN_CHANNELS,
+                                                         AUDIO_IN_BLOCK_MS) / 4U];
+#endif /* USE_AUDIO_PDM_CAPTURE */
+
+#ifdef USE_AUDIO_PIPELINE
+static AcousticBF_Handler_t libBeamforming_Handler_Instance;
+static AcousticBF_Config_t lib_Beamforming_Config_Instance;
+static AcousticSL_Handler_t libSoundSourceLoc_Handler_Instance;
+static AcousticSL_Config_t libSoundSourceLoc_Config_Instance;
+
+/* Internal memory of both libraries, carved at init */
+static uint32_t Acoustic_Memory[ACOUSTIC_MEMORY_SIZE / 4U];
+
+#ifdef USE_AUDIO_PLANAR_CAPTURE
+/* Microphones converted by the driver, two blocks per plane, read in place by both libraries */
+static int16_t Mic_Planes[AUDIO_IN_CHANNELS][2U * SAMPLES_PER_MS * AUDIO_IN_BLOCK_MS];
+#else
+/* Microphones deinterleaved once per callback and read by both libraries */
+static int16_t Mic_Buffer[AUDIO_IN_CHANNELS][SAMPLES_PER_MS * AUDIO_IN_BLOCK_MS];
+#endif /* USE_AUDIO_PLANAR_CAPTURE */
+
+#if (AUDIO_IN_BIT_DEPTH != AUDIO_RESOLUTION_16b)
+/* Full resolution microphones for USB, the libraries get them saturated to 16 bits */
+static int32_t Mic_HiRes[AUDIO_IN_CHANNELS][SAMPLES_PER_MS * AUDIO_IN_BLOCK_MS];
+#endif
+
+/* 1 ms of AcousticBF output: steered beam and omni reference, interleaved */
+static int16_t Beam_Buffer[2U * SAMPLES_PER_MS];
+
+/* Beam and omni reference of the frame, planar like Mic_Buffer for the USB interleave */
+static Usb_Sample_t Beam_Out[SAMPLES_PER_MS * AUDIO_IN_BLOCK_MS];
+static Usb_Sample_t Omni_Out[SAMPLES_PER_MS * AUDIO_IN_BLOCK_MS];
+
+/* Source of each USB channel, resolved from AUDIO_USB_CHANNEL_MAP at init */
+static const uint8_t Usb_Channel_Map[] = AUDIO_USB_CHANNEL_MAP;
+_Static_assert((sizeof(Usb_Channel_Map) == AUDIO_USB_CHANNELS) && (AUDIO_USB_CHANNELS <= 8),
+               "AUDIO_USB_CHANNELS must match the entries of AUDIO_USB_CHANNEL_MAP, 8 at most");
+static const Usb_Sample_t *Usb_Sources[AUDIO_USB_CHANNELS];
+
+static const Beam_t Beams[] = BEAMS_TABLE;
+static volatile uint32_t Beam_Target = 0;
+static uint32_t Beam_Current = 0;
+static Beam_State_t Beam_State = BEAM_STEADY;
+static uint32_t Beam_Fade = BEAM_CROSSFADE_SAMPLES;
+
+/* Capture sample following the AcousticSL window, set with SL_Trigger_Seq when the window is triggered.
+   The SW task 2 reads both with the interrupts masked: a 64-bit read is not atomic */
+static volatile uint64_t SL_Sample_Time = 0;
+
+/* AcousticSL windows triggered by the audio interrupt and the last one taken by the SW task 2 */
+static volatile uint32_t SL_Trigger_Seq = 0;
+static uint32_t SL_Done_Seq = 0;
+#endif /* USE_AUDIO_PIPELINE */
+
+#ifdef USE_AUDIO_FEATURES
+static FFT_mel_instance_t Features_Instance;
+static float32_t Features_Memory[AUDIO_FEATURES_MEMORY_SIZE / 4U];
+
+/* Beam output collected one hop at a time, the SW task 3 reads the buffer not being written */
+static int16_t Features_Input[2][AUDIO_FEATURES_HOP];
+static uint32_t Features_Fill = 0;
+static uint32_t Features_Write = 0;
+#endif /* USE_AUDIO_FEATURES */
+
+static uint32_t Interleave_Cycles = 0;
+static uint32_t Process_Cycles = 0;
+static uint32_t BF_Cycles = 0;
+static uint32_t SL_Cycles = 0;
+static uint32_t SL_Overruns = 0;
+static uint32_t Features_Cycles = 0;
+/* Last result of the skew self-test, run by Audio_Idle_Process */
+static volatile uint32_t Mic_Skew = UINT32_MAX;
+
+#ifdef USE_AUDIO_PDM_CAPTURE
+/* Double buffer of each microphone, filled by its SPI */
+static uint16_t PDM_Buffer[AUDIO_PDM_MICS][AUDIO_PDM_PLANE_SIZE];
+/* Frames sent to the host, copied from the half just captured: a slow host cannot see the capture
+   overwrite a frame. Only one frame is in flight, the other one is free for the next copy */
+static uint16_t PDM_Frame[2][AUDIO_PDM_MICS][AUDIO_PDM_PLANE_SIZE / 2U];
+static uint8_t PDM_Frame_Next = 0;
+static volatile uint8_t PDM_Streaming = 0;
+static uint32_t PDM_Sequence = 0;
+#endif /* USE_AUDIO_PDM_CAPTURE */
+
+#ifdef USE_USB_TELEMETRY
+/* Set by the host on the telemetry interface */
+static volatile uint16_t Tlm_Period = AUDIO_TLM_PERIOD_MS;
+static volatile uint8_t Tlm_Enable = 0xFFU;
+static uint32_t Tlm_Elapsed = 0;
+static uint32_t Tlm_Process_Max = 0;
+#ifdef USE_AUDIO_PIPELINE
+static volatile int32_t Beam_Locked = -1;
+/* Beam and omni energy over the telemetry period, accumulated by the audio interrupt */
+static uint64_t Tlm_Beam_Energy = 0;
+static uint64_t Tlm_Omni_Energy = 0;
+static uint32_t Tlm_Energy_Samples = 0;
+#endif /* USE_AUDIO_PIPELINE */
+#endif /* USE_USB_TELEMETRY */
+/**
+  * @}
+  */
+
+/** @defgroup AUDIO_APPLICATION_Private_Functions
+  * @{
+  */
+#ifdef USE_AUDIO_PIPELINE
+static void Audio_Libraries_Init(void);
+#ifndef USE_AUDIO_PLANAR_CAPTURE
+static void Audio_Deinterleave(void);
+#endif /* USE_AUDIO_PLANAR_CAPTURE */
+static void Audio_Pipeline_Process(int16_t *const pMic[], uint64_t SampleTime, int16_t *pOut);
+#if (AUDIO_IN_BIT_DEPTH == AUDIO_RESOLUTION_16b)
+static void Audio_Interleave(const int16_t *const pSrc[], uint32_t channels, uint32_t frames, int16_t *pDst);
+#else
+static void Audio_Interleave_HiRes(const int32_t *const pSrc[], uint32_t channels, uint32_t frames, uint8_t *pDst);
+#endif
+static int16_t Beam_Crossfade(int16_t beam, int16_t omni);
+static uint32_t Beam_Select(int32_t angle);
+static int32_t Beam_Distance(int32_t angle_a, int32_t angle_b);
+static void SW_IRQ_Tasks_Init(void);
+#endif /* USE_AUDIO_PIPELINE */
+#ifdef USE_AUDIO_FEATURES
+static void Audio_Features_Init(void);
+static void Audio_Features_Push(int16_t sample);
+static void Audio_Features_Callback(void *features, uint32_t len, void *param);
+#endif /* USE_AUDIO_FEATURES */
+static void Audio_Capture_Counters(CCA02M2_AUDIO_IN_Counters_t *pCounters);
+#ifdef USE_USB_TELEMETRY
+static void Audio_Telemetry_Send(void);
+#endif /* USE_USB_TELEMETRY */
+#ifdef USE_AUDIO_PDM_CAPTURE
+static void Audio_PDM_Send(uint32_t Half);
+#endif /* USE_AUDIO_PDM_CAPTURE */
 /**
   * @}
   */
@@ -69,7 +288,11 @@ CCA02M2_AUDIO_Init_t MicParams;
 void CCA02M2_AUDIO_IN_HalfTransfer_CallBack(uint32_t Instance)
 {
   UNUSED(Instance);
+#ifdef USE_AUDIO_PDM_CAPTURE
+  Audio_PDM_Send(0);
+#else
   AudioProcess();
+#endif /* USE_AUDIO_PDM_CAPTURE */
 }
 
 /**
@@ -80,13 +303,20 @@ void CCA02M2_AUDIO_IN_HalfTransfer_CallBack(uint32_t Instance)
 void CCA02M2_AUDIO_IN_TransferComplete_CallBack(uint32_t Instance)
 {
   UNUSED(Instance);
+#ifdef USE_AUDIO_PDM_CAPTURE
+  Audio_PDM_Send(1);
+#else
   AudioProcess();
+#endif /* USE_AUDIO_PDM_CAPTURE */
 }
 
 /**
   * @brief  User function that is called when 1 ms of PDM data is available.
-  *       In this application only PDM to PCM conversion and USB streaming
-  *                  is performed.
+  *       With USE_AUDIO_PIPELINE the USB channels are built from the raw
+  *                  microphones, the steered beam and the omni reference as set
+  *                  by AUDIO_USB_CHANNEL_MAP (the beam also feeds the log-mel
+  *                  extraction with USE_AUDIO_FEATURES), otherwise only PDM to PCM
+  *                  conversion and USB streaming is performed.
   *       User can add his own code here to perform some DSP or audio analysis.
   * @param  none
   * @retval None
@@ -94,8 +324,65 @@ void CCA02M2_AUDIO_IN_TransferComplete_CallBack(uint32_t Instance)
 
 void AudioProcess(void)
 {
+  uint32_t start = DWT->CYCCNT;
+
   /*for L4 PDM to PCM conversion is performed in hardware by DFSDM peripheral*/
-  Send_Audio_to_USB((int16_t *)PCM_Buffer, (AUDIO_IN_SAMPLING_FREQUENCY / 1000)*AUDIO_IN_CHANNELS * N_MS);
+#ifdef USE_AUDIO_PIPELINE
+  int16_t *pMic[AUDIO_IN_CHANNELS];
+  int16_t *pUSB;
+  uint64_t sample_time;
+  uint32_t ch;
+#ifdef USE_AUDIO_PLANAR_CAPTURE
+  CCA02M2_AUDIO_IN_Block_t block;
+
+  /* The planes of the block stay valid until the driver completes block.ReleaseSequence */
+  if (CCA02M2_AUDIO_IN_GetBlock(CCA02M2_AUDIO_INSTANCE, &block) != BSP_ERROR_NONE)
+  {
+    Error_Handler();
+  }
+  for (ch = 0; ch < AUDIO_IN_CHANNELS; ch++)
+  {
+    pMic[ch] = block.pPlane[ch];
+  }
+  sample_time = block.SampleTime;
+#else
+  CCA02M2_AUDIO_IN_Counters_t counters;
+
+  Audio_Deinterleave();
+  for (ch = 0; ch < AUDIO_IN_CHANNELS; ch++)
+  {
+    pMic[ch] = Mic_Buffer[ch];
+  }
+  Audio_Capture_Counters(&counters);
+  sample_time = counters.SampleTime;
+#endif /* USE_AUDIO_PLANAR_CAPTURE */
+
+  /* The pipeline interleaves its output straight into the USB packet ring */
+  pUSB = Reserve_Audio_to_USB((AUDIO_IN_SAMPLING_FREQUENCY / 1000)*AUDIO_USB_CHANNELS * MicParams.BlockMs);
+  Audio_Pipeline_Process(pMic, sample_time, pUSB);
+  if (pUSB != NULL)
+  {
+    Commit_Audio_to_USB((AUDIO_IN_SAMPLING_FREQUENCY / 1000)*AUDIO_USB_CHANNELS * MicParams.BlockMs);
+  }
+#else
+  /* The sampling frequency may have been lowered by the host (USB Audio Class 2.0) */
+  Send_Audio_to_USB((int16_t *)PCM_Buffer, (MicParams.SampleRate / 1000)*AUDIO_IN_CHANNELS * MicParams.BlockMs);
+#endif /* USE_AUDIO_PIPELINE */
+
+  Process_Cycles = DWT->CYCCNT - start;
+
+#ifdef USE_USB_TELEMETRY
+  if (Process_Cycles > Tlm_Process_Max)
+  {
+    Tlm_Process_Max = Process_Cycles;
+  }
+  Tlm_Elapsed += MicParams.BlockMs;
+  if ((Tlm_Period != 0U) && (Tlm_Elapsed >= Tlm_Period))
+  {
+    Tlm_Elapsed = 0;
+    Audio_Telemetry_Send();
+  }
+#endif /* USE_USB_TELEMETRY */
 }
 
 /**
@@ -108,16 +395,103 @@ void AudioProcess(void)
   */
 void Init_Acquisition_Peripherals(uint32_t AudioFreq, uint32_t ChnlNbrIn, uint32_t ChnlNbrOut)
 {
-  MicParams.BitsPerSample = 16;
+#ifdef USE_AUDIO_PDM_CAPTURE
+  /* Raw bits of MIC1 and MIC2, the sample rate of instance 2 is the microphone clock */
+  UNUSED(AudioFreq);
+  UNUSED(ChnlNbrIn);
+  MicParams.BitsPerSample = AUDIO_RESOLUTION_16b;
+  MicParams.ChannelsNbr = AUDIO_PDM_MICS;
+  MicParams.Device = AUDIO_IN_DIGITAL_MIC1 | AUDIO_IN_DIGITAL_MIC2;
+  MicParams.SampleRate = AUDIO_PDM_CLOCK;
+  MicParams.Volume = AUDIO_VOLUME_INPUT;
+  MicParams.BlockMs = N_MS;
+  MicParams.pArena = NULL;
+  MicParams.ArenaSize = 0;
+
+  if (CCA02M2_AUDIO_IN_Init(2U, &MicParams) != BSP_ERROR_NONE)
+  {
+    Error_Handler();
+  }
+#else
+  MicParams.BitsPerSample = AUDIO_IN_BIT_DEPTH;
   MicParams.ChannelsNbr = ChnlNbrIn;
   MicParams.Device = AUDIO_IN_DIGITAL_MIC;
   MicParams.SampleRate = AudioFreq;
   MicParams.Volume = AUDIO_VOLUME_INPUT;
+  MicParams.BlockMs = AUDIO_IN_BLOCK_MS;
+  MicParams.pArena = Capture_Arena;
+  MicParams.ArenaSize = sizeof(Capture_Arena);
 
   if (CCA02M2_AUDIO_IN_Init(CCA02M2_AUDIO_INSTANCE, &MicParams) != BSP_ERROR_NONE)
   {
     Error_Handler();
   }
+#endif /* USE_AUDIO_PDM_CAPTURE */
+
+  /* Cycle counter for Audio_Get_Stream_Info */
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+#ifdef USE_AUDIO_PIPELINE
+  Audio_Libraries_Init();
+#endif /* USE_AUDIO_PIPELINE */
+}
+
+/**
+  * @brief  Reports the USB stream layout and the CPU cost of the last audio frame, in cycles of the core
+  *         clock. The frame budget is SystemCoreClock * MicParams.BlockMs / 1000 cycles.
+  * @param  info: filled with the stream information
+  * @retval None
+  */
+void Audio_Get_Stream_Info(Audio_Stream_Info_t *info)
+{
+  info->Channels = AUDIO_USB_CHANNELS;
+  info->Bandwidth = AUDIO_USB_BANDWIDTH;
+  info->InterleaveCycles = Interleave_Cycles;
+  info->ProcessCycles = Process_Cycles;
+  info->MicSkew = Mic_Skew;
+  info->SLOverruns = SL_Overruns;
+  Audio_Capture_Counters(&info->Capture);
+}
+
+/**
+  * @brief  Reads the sample time and the overrun counters of the capture: raw PDM or DFSDM instance.
+  * @param  pCounters: filled with the counters, cleared when the capture is not running
+  * @retval None
+  */
+static void Audio_Capture_Counters(CCA02M2_AUDIO_IN_Counters_t *pCounters)
+{
+#ifdef USE_AUDIO_PDM_CAPTURE
+  if (CCA02M2_AUDIO_IN_GetCounters(2U, pCounters) != BSP_ERROR_NONE)
+#else
+  if (CCA02M2_AUDIO_IN_GetCounters(CCA02M2_AUDIO_INSTANCE, pCounters) != BSP_ERROR_NONE)
+#endif /* USE_AUDIO_PDM_CAPTURE */
+  {
+    (void)memset(pCounters, 0, sizeof(CCA02M2_AUDIO_IN_Counters_t));
+  }
+}
+
+/**
+  * @brief  Runs the checks too long for the audio interrupt, to be called from the main loop: the sample skew
+  *         self-test of the microphones, which correlates a few blocks of the capture across the calls.
+  * @param  None
+  * @retval None
+  */
+void Audio_Idle_Process(void)
+{
+  uint32_t skew;
+  int32_t ret = CCA02M2_AUDIO_IN_CheckSkew(CCA02M2_AUDIO_INSTANCE, &skew);
+
+  /* Busy while the correlation is accumulated: the last result stands */
+  if (ret == BSP_ERROR_NONE)
+  {
+    Mic_Skew = skew;
+  }
+  else if (ret != BSP_ERROR_BUSY)
+  {
+    Mic_Skew = UINT32_MAX;
+  }
 }
 
 /**
@@ -130,18 +504,896 @@ void Init_Acquisition_Peripherals(uint32_t AudioFreq, uint32_t ChnlNbrIn, uint32
   */
 void Start_Acquisition(void)
 {
-  if (CCA02M2_AUDIO_IN_Record(CCA02M2_AUDIO_INSTANCE, (uint8_t *) PCM_Buffer, AUDIO_IN_BUFFER_SIZE) != BSP_ERROR_NONE)
+  if (Audio_Capture_Start() != BSP_ERROR_NONE)
   {
     Error_Handler();
   }
 }
 
+/**
+  * @brief  Starts the driver on the buffers of the capture mode, at the sampling frequency of MicParams: raw
+  *         PDM planes, planar PCM read in place by the pipeline or PCM_Buffer.
+  * @param  None
+  * @retval BSP status
+  */
+int32_t Audio_Capture_Start(void)
+{
+#ifdef USE_AUDIO_PDM_CAPTURE
+  return CCA02M2_AUDIO_IN_RecordPDM(2U, (uint8_t *) PDM_Buffer, sizeof(PDM_Buffer));
+#elif defined(USE_AUDIO_PLANAR_CAPTURE)
+  int16_t *planes[AUDIO_IN_CHANNELS];
+  uint32_t ch;
+
+  for (ch = 0; ch < AUDIO_IN_CHANNELS; ch++)
+  {
+    planes[ch] = Mic_Planes[ch];
+  }
+  return CCA02M2_AUDIO_IN_RecordPlanar(CCA02M2_AUDIO_INSTANCE, planes, sizeof(Mic_Planes[0]));
+#else
+  /* Two blocks of DFSDM results, the half transfers pace the callbacks */
+  return CCA02M2_AUDIO_IN_Record(CCA02M2_AUDIO_INSTANCE, (uint8_t *) PCM_Buffer,
+                                 (MicParams.SampleRate / 1000U) * 2U * MicParams.BlockMs);
+#endif /* USE_AUDIO_PDM_CAPTURE */
+}
+
 
 void Error_Handler(void)
 {
   while (1);
 }
 
+#ifdef USE_AUDIO_PIPELINE
+/**
+  * @brief  Callback of the SW task 1: AcousticBF processing, run at a lower priority than the audio interrupt.
+  * @param  None
+  * @retval None
+  */
+void SW_Task1_Callback(void)
+{
+  uint32_t start = DWT->CYCCNT;
+
+  (void)AcousticBF_SecondStep(&libBeamforming_Handler_Instance);
+  BF_Cycles = DWT->CYCCNT - start;
+}
+
+/**
+  * @brief  Callback of the SW task 2: AcousticSL processing, run once per localization window at the lowest
+  *         priority. The tracked angle selects the beam used by the audio interrupt.
+  * @param  None
+  * @retval None
+  */
+void SW_Task2_Callback(void)
+{
+  int32_t angle = ACOUSTIC_SL_NO_AUDIO_DETECTED;
+  uint32_t start = DWT->CYCCNT;
+  uint32_t primask;
+  uint32_t seq;
+  uint64_t sample_time;
+
+  /* The window and its sample time, latched together before the next trigger can change them */
+  primask = __get_PRIMASK();
+  __disable_irq();
+  seq = SL_Trigger_Seq;
+  sample_time = SL_Sample_Time;
+  __set_PRIMASK(primask);
+
+  /* The task is pended once for any number of triggers: the windows before the last one were overwritten */
+  if ((seq - SL_Done_Seq) > 1U)
+  {
+    SL_Overruns += seq - SL_Done_Seq - 1U;
+  }
+  SL_Done_Seq = seq;
+
+  /* The window is also lost when the next trigger comes while it is copied, the angle is then not updated */
+  if (AcousticSL_Process(&angle, &libSoundSourceLoc_Handler_Instance) == ACOUSTIC_SL_OVERRUN_ERROR)
+  {
+    SL_Overruns++;
+  }
+#ifdef USE_USB_TELEMETRY
+  if ((angle != ACOUSTIC_SL_NO_AUDIO_DETECTED) && (Beam_Locked < 0))
+#else
+  if (angle != ACOUSTIC_SL_NO_AUDIO_DETECTED)
+#endif /* USE_USB_TELEMETRY */
+  {
+    Beam_Target = Beam_Select(angle);
+  }
+  SL_Cycles = DWT->CYCCNT - start;
+
+#ifdef USE_USB_TELEMETRY
+  if ((Tlm_Enable & (1U << (AUDIO_TLM_SL - 1U))) != 0U)
+  {
+    Audio_Tlm_SL_t sl;
+
+    sl.Angle = (int16_t)angle;
+    sl.BeamTarget = (uint8_t)Beam_Target;
+    sl.BeamCurrent = (uint8_t)Beam_Current;
+    sl.Window = SL_SAMPLES_TO_PROCESS;
+    sl.SampleTime = sample_time;
+    (void)Send_Telemetry_to_USB(AUDIO_TLM_SL, &sl, sizeof(sl));
+  }
+#else
+  UNUSED(sample_time);
+#endif /* USE_USB_TELEMETRY */
+}
+
+/**
+  * @brief  Initializes AcousticBF and AcousticSL on the same memory arena and input buffers.
+  * @param  None
+  * @retval None
+  */
+static void Audio_Libraries_Init(void)
+{
+  uint32_t error_value = 0;
+  uint32_t bf_words;
+  uint32_t i;
+
+  SL_Trigger_Seq = 0;
+  SL_Done_Seq = 0;
+  SL_Overruns = 0;
+
+  /* AcousticBF: cardioid on the PCM microphones, the omni reference is the second output channel */
+  libBeamforming_Handler_Instance.algorithm_type_init = ACOUSTIC_BF_TYPE_CARDIOID_BASIC;
+  libBeamforming_Handler_Instance.ref_mic_enable = ACOUSTIC_BF_REF_ENABLE;
+  libBeamforming_Handler_Instance.ptr_out_channels = 2;
+  libBeamforming_Handler_Instance.data_format = ACOUSTIC_BF_DATA_FORMAT_PCM;
+  libBeamforming_Handler_Instance.sampling_frequency = ACOUSTIC_BF_FS_16;
+  libBeamforming_Handler_Instance.ptr_M1_channels = 1;
+  libBeamforming_Handler_Instance.ptr_M2_channels = 1;
+  libBeamforming_Handler_Instance.delay_enable = ACOUSTIC_BF_DELAY_ENABLE;
+  libBeamforming_Handler_Instance.mixer_enable = ACOUSTIC_BF_MIXER_DISABLE;
+  (void)AcousticBF_getMemorySize(&libBeamforming_Handler_Instance);
+
+  /* AcousticSL: GCC-PHAT on the same deinterleaved microphones */
+  libSoundSourceLoc_Handler_Instance.channel_number = AUDIO_IN_CHANNELS;
+  libSoundSourceLoc_Handler_Instance.M12_distance = AUDIO_PIPELINE_MIC_DISTANCE;
+  libSoundSourceLoc_Handler_Instance.M34_distance = AUDIO_PIPELINE_MIC_DISTANCE;
+  libSoundSourceLoc_Handler_Instance.sampling_frequency = AUDIO_IN_SAMPLING_FREQUENCY;
+  libSoundSourceLoc_Handler_Instance.algorithm = ACOUSTIC_SL_ALGORITHM_GCCP;
+  libSoundSourceLoc_Handler_Instance.ptr_M1_channels = 1;
+  libSoundSourceLoc_Handler_Instance.ptr_M2_channels = 1;
+  libSoundSourceLoc_Handler_Instance.ptr_M3_channels = 1;
+  libSoundSourceLoc_Handler_Instance.ptr_M4_channels = 1;
+  libSoundSourceLoc_Handler_Instance.samples_to_process = (int16_t)SL_SAMPLES_TO_PROCESS;
+  libSoundSourceLoc_Handler_Instance.hop_size = (uint16_t)(SL_HOP_MS * SAMPLES_PER_MS);
+  (void)AcousticSL_getMemorySize(&libSoundSourceLoc_Handler_Instance);
+
+  bf_words = (libBeamforming_Handler_Instance.internal_memory_size + 3U) / 4U;
+  if ((bf_words + ((libSoundSourceLoc_Handler_Instance.internal_memory_size + 3U) / 4U)) > (ACOUSTIC_MEMORY_SIZE / 4U))
+  {
+    Error_Handler();
+  }
+  libBeamforming_Handler_Instance.pInternalMemory = &Acoustic_Memory[0];
+  libSoundSourceLoc_Handler_Instance.pInternalMemory = &Acoustic_Memory[bf_words];
+
+  error_value = AcousticBF_Init(&libBeamforming_Handler_Instance);
+  error_value |= AcousticSL_Init(&libSoundSourceLoc_Handler_Instance);
+  if (error_value != 0U)
+  {
+    Error_Handler();
+  }
+
+  lib_Beamforming_Config_Instance.algorithm_type = ACOUSTIC_BF_TYPE_CARDIOID_BASIC;
+  lib_Beamforming_Config_Instance.mic_distance = AUDIO_PIPELINE_MIC_DISTANCE;
+  lib_Beamforming_Config_Instance.volume = 0;
+  lib_Beamforming_Config_Instance.M2_gain = 0.0f;
+  error_value = AcousticBF_setConfig(&libBeamforming_Handler_Instance, &lib_Beamforming_Config_Instance);
+
+  /* the alpha-beta tracker hands over between talkers faster than the histogram voting */
+  libSoundSourceLoc_Config_Instance.resolution = 10;
+  libSoundSourceLoc_Config_Instance.threshold = 24;
+  libSoundSourceLoc_Config_Instance.tracker = ACOUSTIC_SL_TRACKER_ALPHA_BETA;
+  libSoundSourceLoc_Config_Instance.responsiveness = ACOUSTIC_SL_DEFAULT_RESPONSIVENESS;
+  error_value |= AcousticSL_setConfig(&libSoundSourceLoc_Handler_Instance, &libSoundSourceLoc_Config_Instance);
+  if (error_value != 0U)
+  {
+    Error_Handler();
+  }
+
+  Beam_Target = 0;
+  Beam_Current = 0;
+  Beam_State = BEAM_STEADY;
+  Beam_Fade = BEAM_CROSSFADE_SAMPLES;
+
+  /* USB channels */
+  for (i = 0; i < AUDIO_USB_CHANNELS; i++)
+  {
+    if (Usb_Channel_Map[i] == AUDIO_SRC_BEAM)
+    {
+      Usb_Sources[i] = Beam_Out;
+    }
+    else if (Usb_Channel_Map[i] == AUDIO_SRC_OMNI)
+    {
+      Usb_Sources[i] = Omni_Out;
+    }
+    else if (Usb_Channel_Map[i] < AUDIO_IN_CHANNELS)
+    {
+#ifdef USE_AUDIO_PLANAR_CAPTURE
+      /* Moved to the planes of each block by Audio_Pipeline_Process */
+      Usb_Sources[i] = Mic_Planes[Usb_Channel_Map[i]];
+#elif (AUDIO_IN_BIT_DEPTH == AUDIO_RESOLUTION_16b)
+      Usb_Sources[i] = Mic_Buffer[Usb_Channel_Map[i]];
+#else
+      Usb_Sources[i] = Mic_HiRes[Usb_Channel_Map[i]];
+#endif
+    }
+    else
+    {
+      Error_Handler();
+    }
+  }
+
+#ifdef USE_AUDIO_FEATURES
+  Audio_Features_Init();
+#endif /* USE_AUDIO_FEATURES */
+
+  SW_IRQ_Tasks_Init();
+}
+
+#ifndef USE_AUDIO_PLANAR_CAPTURE
+/**
+  * @brief  Deinterleaves the captured frame into Mic_Buffer, shared by AcousticSL and AcousticBF, and into
+  *         Mic_HiRes for the USB channels at 24 and 32 bits. One pass per channel; packed 24-bit samples are
+  *         assembled left-justified from their 3 bytes.
+  * @param  None
+  * @retval None
+  */
+static void Audio_Deinterleave(void)
+{
+  uint32_t samples = SAMPLES_PER_MS * MicParams.BlockMs;
+  uint32_t i;
+  uint32_t ch;
+#if (AUDIO_IN_BIT_DEPTH == AUDIO_RESOLUTION_16b)
+  const int16_t *pIn;
+  int16_t *pMic;
+
+  for (ch = 0; ch < AUDIO_IN_CHANNELS; ch++)
+  {
+    pIn = &((const int16_t *)PCM_Buffer)[ch];
+    pMic = Mic_Buffer[ch];
+    for (i = 0; i < samples; i++)
+    {
+      pMic[i] = *pIn;
+      pIn = &pIn[AUDIO_IN_CHANNELS];
+    }
+  }
+#else
+#if (AUDIO_IN_BIT_DEPTH == AUDIO_RESOLUTION_24b)
+  const uint8_t *pIn;
+#else
+  const int32_t *pIn;
+#endif
+  int32_t *pHiRes;
+  int16_t *pMic;
+  int32_t word;
+
+  for (ch = 0; ch < AUDIO_IN_CHANNELS; ch++)
+  {
+#if (AUDIO_IN_BIT_DEPTH == AUDIO_RESOLUTION_24b)
+    pIn = &((const uint8_t *)PCM_Buffer)[3U * ch];
+#else
+    pIn = &((const int32_t *)PCM_Buffer)[ch];
+#endif
+    pHiRes = Mic_HiRes[ch];
+    pMic = Mic_Buffer[ch];
+    for (i = 0; i < samples; i++)
+    {
+#if (AUDIO_IN_BIT_DEPTH == AUDIO_RESOLUTION_24b)
+      word = (int32_t)(((uint32_t)pIn[0] << 8) | ((uint32_t)pIn[1] << 16) | ((uint32_t)pIn[2] << 24));
+      pIn = &pIn[3U * AUDIO_IN_CHANNELS];
+#else
+      word = *pIn;
+      pIn = &pIn[AUDIO_IN_CHANNELS];
+#endif
+      pHiRes[i] = word;
+      pMic[i] = (int16_t)__SSAT(word >> 12, 16);
+    }
+  }
+#endif
+}
+#endif /* USE_AUDIO_PLANAR_CAPTURE */
+
+/**
+  * @brief  Runs the localization and the beam on the captured frame, then interleaves the USB channels
+  *         selected by AUDIO_USB_CHANNEL_MAP.
+  * @param  pMic: 16-bit samples of each microphone
+  * @param  SampleTime: capture sample time of the first sample of the frame
+  * @param  pOut: interleaved output frame in the USB packet ring, NULL when the ring has no room
+  * @retval None
+  */
+static void Audio_Pipeline_Process(int16_t *const pMic[], uint64_t SampleTime, int16_t *pOut)
+{
+  uint32_t ms;
+  uint32_t i;
+
+  for (ms = 0; ms < MicParams.BlockMs; ms++)
+  {
+    uint32_t offset = ms * SAMPLES_PER_MS;
+    const Beam_t *pBeam = &Beams[Beam_Current];
+
+#if (AUDIO_IN_CHANNELS == 4)
+    if (AcousticSL_Data_Input(&pMic[0][offset], &pMic[1][offset], &pMic[2][offset],
+                              &pMic[3][offset], &libSoundSourceLoc_Handler_Instance) == 1U)
+#else
+    if (AcousticSL_Data_Input(&pMic[0][offset], &pMic[1][offset], NULL, NULL,
+                              &libSoundSourceLoc_Handler_Instance) == 1U)
+#endif
+    {
+      SL_Sample_Time = SampleTime + offset + SAMPLES_PER_MS;
+      SL_Trigger_Seq++;
+      if ((MicParams.BlockMs - (ms + 1U)) >= SL_HOP_MS)
+      {
+        /* The rest of the block triggers the next window before the SW task could run */
+        SW_Task2_Callback();
+      }
+      else
+      {
+        /* The input ring of AcousticSL keeps the window until the next trigger, one hop later: the rest of
+           the block is fed before the SW task runs without touching it */
+        SW_Task2_Start();
+      }
+    }
+
+    if (AcousticBF_FirstStep(&pMic[pBeam->front_mic][offset], &pMic[pBeam->rear_mic][offset],
+                             Beam_Buffer, &libBeamforming_Handler_Instance) == 1U)
+    {
+      if ((ms + 1U) < MicParams.BlockMs)
+      {
+        /* The next millisecond of the block comes before the SW task could run */
+        SW_Task1_Callback();
+      }
+      else
+      {
+        SW_Task1_Start();
+      }
+    }
+
+    for (i = 0; i < SAMPLES_PER_MS; i++)
+    {
+      int16_t sample = Beam_Crossfade(Beam_Buffer[2U * i], Beam_Buffer[(2U * i) + 1U]);
+
+      Beam_Out[offset + i] = (Usb_Sample_t)sample * USB_SAMPLE_SCALE;
+      Omni_Out[offset + i] = (Usb_Sample_t)Beam_Buffer[(2U * i) + 1U] * USB_SAMPLE_SCALE;
+#ifdef USE_USB_TELEMETRY
+      Tlm_Beam_Energy += (uint64_t)((int32_t)sample * (int32_t)sample);
+      Tlm_Omni_Energy += (uint64_t)((int32_t)Beam_Buffer[(2U * i) + 1U] * (int32_t)Beam_Buffer[(2U * i) + 1U]);
+#endif /* USE_USB_TELEMETRY */
+#ifdef USE_AUDIO_FEATURES
+      Audio_Features_Push(sample);
+#endif /* USE_AUDIO_FEATURES */
+    }
+  }
+#ifdef USE_USB_TELEMETRY
+  Tlm_Energy_Samples += SAMPLES_PER_MS * MicParams.BlockMs;
+#endif /* USE_USB_TELEMETRY */
+
+  if (pOut != NULL)
+  {
+    uint32_t start = DWT->CYCCNT;
+
+#ifdef USE_AUDIO_PLANAR_CAPTURE
+    for (i = 0; i < AUDIO_USB_CHANNELS; i++)
+    {
+      if (Usb_Channel_Map[i] < AUDIO_IN_CHANNELS)
+      {
+        Usb_Sources[i] = pMic[Usb_Channel_Map[i]];
+      }
+    }
+#endif /* USE_AUDIO_PLANAR_CAPTURE */
+#if (AUDIO_IN_BIT_DEPTH == AUDIO_RESOLUTION_16b)
+    Audio_Interleave(Usb_Sources, AUDIO_USB_CHANNELS, SAMPLES_PER_MS * MicParams.BlockMs, pOut);
+#else
+    Audio_Interleave_HiRes(Usb_Sources, AUDIO_USB_CHANNELS, SAMPLES_PER_MS * MicParams.BlockMs, (uint8_t *)pOut);
+#endif
+    Interleave_Cycles = DWT->CYCCNT - start;
+  }
+}
+
+#if (AUDIO_IN_BIT_DEPTH == AUDIO_RESOLUTION_16b)
+/**
+  * @brief  Interleaves planar channels. Channels are taken in pairs: two frames of each channel are read as
+  *         one word and repacked with PKHBT/PKHTB into one word per frame, a last odd channel is copied
+  *         sample by sample.
+  * @param  pSrc: planar source of each channel
+  * @param  channels: number of channels
+  * @param  frames: number of samples per channel
+  * @param  pDst: interleaved output, frames * channels samples
+  * @retval None
+  */
+static void Audio_Interleave(const int16_t *const pSrc[], uint32_t channels, uint32_t frames, int16_t *pDst)
+{
+  uint32_t ch;
+  uint32_t i;
+
+  for (ch = 0; (ch + 1U) < channels; ch += 2U)
+  {
+    q15_t *pA = (q15_t *)pSrc[ch];
+    q15_t *pB = (q15_t *)pSrc[ch + 1U];
+    q15_t *pOut = &pDst[ch];
+
+    for (i = 0; (i + 1U) < frames; i += 2U)
+    {
+      q31_t a = read_q15x2_ia(&pA);
+      q31_t b = read_q15x2_ia(&pB);
+
+      write_q15x2(pOut, (q31_t)__PKHBT(a, b, 16));
+      write_q15x2(&pOut[channels], (q31_t)__PKHTB(b, a, 16));
+      pOut += 2U * channels;
+    }
+    if (i < frames)
+    {
+      pOut[0] = *pA;
+      pOut[1] = *pB;
+    }
+  }
+
+  if (ch < channels)
+  {
+    const int16_t *pA = pSrc[ch];
+
+    for (i = 0; i < frames; i++)
+    {
+      pDst[(i * channels) + ch] = pA[i];
+    }
+  }
+}
+#else
+/**
+  * @brief  Interleaves planar left-justified 24-bit channels in the USB format: 32-bit words, or 3 bytes
+  *         samples packed 4 at a time into 3 words.
+  * @param  pSrc: planar source of each channel
+  * @param  channels: number of channels
+  * @param  frames: number of samples per channel
+  * @param  pDst: interleaved output, frames * channels samples
+  * @retval None
+  */
+static void Audio_Interleave_HiRes(const int32_t *const pSrc[], uint32_t channels, uint32_t frames, uint8_t *pDst)
+{
+  uint32_t ch;
+  uint32_t i;
+#if (AUDIO_IN_BIT_DEPTH == AUDIO_RESOLUTION_32b)
+  int32_t *pOut = (int32_t *)pDst;
+
+  for (i = 0; i < frames; i++)
+  {
+    for (ch = 0; ch < channels; ch++)
+    {
+      pOut[(i * channels) + ch] = pSrc[ch][i];
+    }
+  }
+#else
+  uint32_t q[4];
+  uint32_t w[3];
+  uint32_t n = 0;
+
+  for (i = 0; i < frames; i++)
+  {
+    for (ch = 0; ch < channels; ch++)
+    {
+      q[n] = (uint32_t)pSrc[ch][i];
+      n++;
+      if (n == 4U)
+      {
+        w[0] = (q[0] >> 8) | (q[1] << 16);
+        w[1] = (q[1] >> 16) | ((q[2] << 8) & 0xFFFF0000U);
+        w[2] = (q[2] >> 24) | (q[3] & 0xFFFFFF00U);
+        (void)memcpy(pDst, w, 12U);
+        pDst = &pDst[12];
+        n = 0;
+      }
+    }
+  }
+  for (i = 0; i < n; i++)
+  {
+    q[i] >>= 8;
+    (void)memcpy(pDst, &q[i], 3U);
+    pDst = &pDst[3];
+  }
+#endif
+}
+#endif
+
+/**
+  * @brief  Beam switching: the output fades from the current beam to the omni reference, the microphone pair
+  *         is switched while the beam is muted, then the output fades in the new beam.
+  * @param  beam: sample of the steered beam
+  * @param  omni: sample of the omni reference
+  * @retval Output sample
+  */
+static int16_t Beam_Crossfade(int16_t beam, int16_t omni)
+{
+  switch (Beam_State)
+  {
+    case BEAM_STEADY:
+      if (Beam_Target != Beam_Current)
+      {
+        Beam_State = BEAM_FADE_OUT;
+      }
+      break;
+    case BEAM_FADE_OUT:
+      Beam_Fade--;
+      if (Beam_Fade == 0U)
+      {
+        Beam_Current = Beam_Target;
+        Beam_State = BEAM_FADE_IN;
+      }
+      break;
+    case BEAM_FADE_IN:
+      Beam_Fade++;
+      if (Beam_Fade == BEAM_CROSSFADE_SAMPLES)
+      {
+        Beam_State = BEAM_STEADY;
+      }
+      break;
+    default:
+      Beam_State = BEAM_STEADY;
+      break;
+  }
+
+  return (int16_t)((((int32_t)beam * (int32_t)Beam_Fade) + ((int32_t)omni * (int32_t)(BEAM_CROSSFADE_SAMPLES - Beam_Fade)))
+                   / (int32_t)BEAM_CROSSFADE_SAMPLES);
+}
+
+/**
+  * @brief  Selects the beam closest to the tracked angle, keeping the current one unless a beam is closer
+  *         by at least BEAM_HYSTERESIS degrees.
+  * @param  angle: AcousticSL tracked angle
+  * @retval Index of the selected beam
+  */
+static uint32_t Beam_Select(int32_t angle)
+{
+  uint32_t selected = Beam_Target;
+  int32_t best_distance = Beam_Distance(angle, Beams[selected].direction) - BEAM_HYSTERESIS;
+  uint32_t i;
+
+  for (i = 0; i < BEAMS_NUMBER; i++)
+  {
+    int32_t distance = Beam_Distance(angle, Beams[i].direction);
+    if (distance < best_distance)
+    {
+      best_distance = distance;
+      selected = i;
+    }
+  }
+  return selected;
+}
+
+/**
+  * @brief  Angular distance on the circle.
+  * @param  angle_a: first angle in degrees
+  * @param  angle_b: second angle in degrees
+  * @retval Distance in degrees, from 0 to 180
+  */
+static int32_t Beam_Distance(int32_t angle_a, int32_t angle_b)
+{
+  int32_t distance = angle_a - angle_b;
+
+  if (distance < 0)
+  {
+    distance = -distance;
+  }
+  distance %= 360;
+  if (distance > 180)
+  {
+    distance = 360 - distance;
+  }
+  return distance;
+}
+
+/**
+  * @brief  Configures the IRQs used as SW tasks, below the priority of the audio interrupt.
+  * @param  None
+  * @retval None
+  */
+static void SW_IRQ_Tasks_Init(void)
+{
+  HAL_NVIC_SetPriority(SW_TASK1_IRQn, AUDIO_PIPELINE_BF_IT_PRIORITY, 0);
+  HAL_NVIC_EnableIRQ(SW_TASK1_IRQn);
+
+  HAL_NVIC_SetPriority(SW_TASK2_IRQn, AUDIO_PIPELINE_SL_IT_PRIORITY, 0);
+  HAL_NVIC_EnableIRQ(SW_TASK2_IRQn);
+
+#ifdef USE_AUDIO_FEATURES
+  HAL_NVIC_SetPriority(SW_TASK3_IRQn, AUDIO_PIPELINE_FEATURES_IT_PRIORITY, 0);
+  HAL_NVIC_EnableIRQ(SW_TASK3_IRQn);
+#endif /* USE_AUDIO_FEATURES */
+}
+
+/**
+  * @brief  Starts the SW task 1 (AcousticBF processing).
+  * @param  None
+  * @retval None
+  */
+void SW_Task1_Start(void)
+{
+  HAL_NVIC_SetPendingIRQ(SW_TASK1_IRQn);
+}
+
+/**
+  * @brief  Starts the SW task 2 (AcousticSL processing).
+  * @param  None
+  * @retval None
+  */
+void SW_Task2_Start(void)
+{
+  HAL_NVIC_SetPendingIRQ(SW_TASK2_IRQn);
+}
+#endif /* USE_AUDIO_PIPELINE */
+
+#ifdef USE_AUDIO_FEATURES
+/**
+  * @brief  Callback of the SW task 3: log-mel extraction of the last hop of the beam, at the lowest priority.
+  * @param  None
+  * @retval None
+  */
+void SW_Task3_Callback(void)
+{
+  uint32_t start = DWT->CYCCNT;
+
+  (void)FFT_Mel_Data_Input(Features_Input[Features_Write ^ 1U], AUDIO_FEATURES_HOP, &Features_Instance);
+  Features_Cycles = DWT->CYCCNT - start;
+}
+
+/**
+  * @brief  Starts the SW task 3 (feature extraction).
+  * @param  None
+  * @retval None
+  */
+void SW_Task3_Start(void)
+{
+  HAL_NVIC_SetPendingIRQ(SW_TASK3_IRQn);
+}
+
+/**
+  * @brief  Called from the SW task 3 with the features of every frame.
+  *         Being __weak it can be overwritten by the application to forward them to the keyword spotter.
+  * @param  features: AUDIO_FEATURES_MELS log-mel energies, or AUDIO_FEATURES_MFCC coefficients, with 8 fractional bits
+  * @param  len: number of features
+  * @retval None
+  */
+__weak void Audio_Features_Ready(const int16_t *features, uint32_t len)
+{
+  UNUSED(features);
+  UNUSED(len);
+}
+
+/**
+  * @brief  Initializes the log-mel extractor on its static arena.
+  * @param  None
+  * @retval None
+  */
+static void Audio_Features_Init(void)
+{
+  Features_Instance.init_params.FFT_len = AUDIO_FEATURES_FFT_LEN;
+  Features_Instance.init_params.hop = AUDIO_FEATURES_HOP;
+  Features_Instance.init_params.sample_rate = AUDIO_IN_SAMPLING_FREQUENCY;
+  Features_Instance.init_params.num_mels = AUDIO_FEATURES_MELS;
+  Features_Instance.init_params.f_min = AUDIO_FEATURES_F_MIN;
+  Features_Instance.init_params.f_max = AUDIO_FEATURES_F_MAX;
+  Features_Instance.init_params.num_mfcc = AUDIO_FEATURES_MFCC;
+  Features_Instance.init_params.win_type = FFT_HANNING_WIN;
+  Features_Instance.init_params.data_type = INT16;
+  Features_Instance.init_params.output_type = FFT_MEL_OUTPUT_Q8;
+  Features_Instance.init_params.callback = Audio_Features_Callback;
+  Features_Instance.init_params.callback_param = NULL;
+  Features_Instance.init_params.userBuffer = Features_Memory;
+
+  if ((FFT_Mel_getMemorySize(&Features_Instance) > (int32_t)AUDIO_FEATURES_MEMORY_SIZE)
+      || (FFT_Mel_Init(&Features_Instance) != FFT_ERROR_NONE))
+  {
+    Error_Handler();
+  }
+
+  Features_Fill = 0;
+  Features_Write = 0;
+}
+
+/**
+  * @brief  Collects one beam sample, starting the SW task 3 every AUDIO_FEATURES_HOP samples.
+  * @param  sample: beam output sample
+  * @retval None
+  */
+static void Audio_Features_Push(int16_t sample)
+{
+  Features_Input[Features_Write][Features_Fill] = sample;
+  Features_Fill++;
+
+  if (Features_Fill == AUDIO_FEATURES_HOP)
+  {
+    Features_Fill = 0;
+    Features_Write ^= 1U;
+    SW_Task3_Start();
+  }
+}
+
+/**
+  * @brief  Feature extractor callback, forwards the Q8 features of the frame.
+  * @param  features: features of the frame
+  * @param  len: number of features
+  * @param  param: not used
+  * @retval None
+  */
+static void Audio_Features_Callback(void *features, uint32_t len, void *param)
+{
+  UNUSED(param);
+  Audio_Features_Ready((const int16_t *)features, len);
+}
+#endif /* USE_AUDIO_FEATURES */
+
+#ifdef USE_USB_TELEMETRY
+/**
+  * @brief  Configuration write of the host on the telemetry interface, called from the USB interrupt.
+  * @param  Buf: command byte followed by its argument
+  * @param  Len: length of the write
+  * @retval 0 if the command is applied, -1 otherwise
+  */
+int8_t Audio_Telemetry_Command(uint8_t *Buf, uint32_t Len)
+{
+  int8_t ret = 0;
+
+  if (Len < 2U)
+  {
+    ret = -1;
+  }
+  else
+  {
+    switch (Buf[0])
+    {
+      case AUDIO_TLM_CMD_PERIOD:
+        if (Len >= 3U)
+        {
+          Tlm_Period = (uint16_t)Buf[1] | ((uint16_t)Buf[2] << 8);
+        }
+        else
+        {
+          ret = -1;
+        }
+        break;
+      case AUDIO_TLM_CMD_ENABLE:
+        Tlm_Enable = Buf[1];
+        break;
+#ifdef USE_AUDIO_PIPELINE
+      case AUDIO_TLM_CMD_BEAM:
+        if ((int8_t)Buf[1] < 0)
+        {
+          Beam_Locked = -1;
+        }
+        else if (Buf[1] < BEAMS_NUMBER)
+        {
+          /* The audio interrupt switches to the locked beam with the usual crossfade */
+          Beam_Locked = (int32_t)Buf[1];
+          Beam_Target = Buf[1];
+        }
+        else
+        {
+          ret = -1;
+        }
+        break;
+#endif /* USE_AUDIO_PIPELINE */
+#ifdef USE_AUDIO_PDM_CAPTURE
+      case AUDIO_TLM_CMD_PDM:
+        if ((Buf[1] != 0U) && (PDM_Streaming == 0U))
+        {
+          PDM_Sequence = 0;
+        }
+        PDM_Streaming = (Buf[1] != 0U) ? 1U : 0U;
+        break;
+#endif /* USE_AUDIO_PDM_CAPTURE */
+      default:
+        ret = -1;
+        break;
+    }
+  }
+  return ret;
+}
+
+/**
+  * @brief  Queues the periodic telemetry records, from the audio interrupt. The records are dropped when the
+  *         host does not read them, the audio processing never waits on USB.
+  * @param  None
+  * @retval None
+  */
+static void Audio_Telemetry_Send(void)
+{
+  uint8_t enable = Tlm_Enable;
+
+  if ((enable & (1U << (AUDIO_TLM_TIMINGS - 1U))) != 0U)
+  {
+    Audio_Tlm_Timings_t timings;
+
+    timings.ProcessCycles = Process_Cycles;
+    timings.ProcessMaxCycles = Tlm_Process_Max;
+    timings.InterleaveCycles = Interleave_Cycles;
+    timings.BFCycles = BF_Cycles;
+    timings.SLCycles = SL_Cycles;
+    timings.FeaturesCycles = Features_Cycles;
+    (void)Send_Telemetry_to_USB(AUDIO_TLM_TIMINGS, &timings, sizeof(timings));
+  }
+  Tlm_Process_Max = 0;
+
+  if ((enable & (1U << (AUDIO_TLM_LEVELS - 1U))) != 0U)
+  {
+    Audio_Tlm_Levels_t levels;
+    CCA02M2_AUDIO_IN_Counters_t counters;
+
+    if (CCA02M2_AUDIO_IN_GetPosition(CCA02M2_AUDIO_INSTANCE, &levels.CapturePending) != BSP_ERROR_NONE)
+    {
+      levels.CapturePending = 0;
+    }
+    levels.TelemetryDropped = USBD_TELEMETRY_Get_Dropped();
+    levels.MicSkew = Mic_Skew;
+    Audio_Capture_Counters(&counters);
+    levels.CaptureLate = counters.LateBlocks;
+    levels.CaptureMissed = counters.MissedBlocks;
+    levels.CaptureReentries = counters.Reentries;
+    levels.SLOverruns = SL_Overruns;
+    (void)Send_Telemetry_to_USB(AUDIO_TLM_LEVELS, &levels, sizeof(levels));
+  }
+
+  if ((enable & (1U << (AUDIO_TLM_USB - 1U))) != 0U)
+  {
+    USBD_AUDIO_StatsTypeDef usb;
+
+    Get_USB_Audio_Stats(&usb, 1);
+    (void)Send_Telemetry_to_USB(AUDIO_TLM_USB, &usb, sizeof(usb));
+  }
+
+#ifdef USE_AUDIO_PIPELINE
+  if (((enable & (1U << (AUDIO_TLM_BF - 1U))) != 0U) && (Tlm_Energy_Samples != 0U))
+  {
+    Audio_Tlm_BF_t bf;
+
+    bf.BeamPower = (uint32_t)(Tlm_Beam_Energy / Tlm_Energy_Samples);
+    bf.OmniPower = (uint32_t)(Tlm_Omni_Energy / Tlm_Energy_Samples);
+    bf.Samples = Tlm_Energy_Samples;
+    (void)Send_Telemetry_to_USB(AUDIO_TLM_BF, &bf, sizeof(bf));
+  }
+  Tlm_Beam_Energy = 0;
+  Tlm_Omni_Energy = 0;
+  Tlm_Energy_Samples = 0;
+#endif /* USE_AUDIO_PIPELINE */
+}
+#endif /* USE_USB_TELEMETRY */
+
+#ifdef USE_AUDIO_PDM_CAPTURE
+/**
+  * @brief  Passes the half of the PDM buffers just captured to the host, from the capture interrupt. The
+  *         planes are copied into the frame buffer not in flight and sent from there. A frame passed while
+  *         the previous one is still being sent is dropped and its sequence number skipped, so the host
+  *         sees the gap; the frames it receives are whole.
+  * @param  Half: 0 for the first half of the buffers, 1 for the second one
+  * @retval None
+  */
+static void Audio_PDM_Send(uint32_t Half)
+{
+  Audio_PDM_Header_t header;
+  uint8_t *planes[AUDIO_PDM_MICS];
+  uint32_t mic;
+
+  if (PDM_Streaming == 0U)
+  {
+    return;
+  }
+
+  header.Magic = AUDIO_PDM_MAGIC;
+  header.Sequence = PDM_Sequence++;
+  header.Clock = AUDIO_PDM_CLOCK;
+  header.PlaneSize = AUDIO_PDM_PLANE_SIZE;
+  header.Mics = AUDIO_PDM_MICS;
+  header.Format = AUDIO_PDM_FORMAT_SPI16_MSB;
+
+  for (mic = 0; mic < AUDIO_PDM_MICS; mic++)
+  {
+    (void)memcpy(PDM_Frame[PDM_Frame_Next][mic], &PDM_Buffer[mic][Half * (AUDIO_PDM_PLANE_SIZE / 2U)],
+                 AUDIO_PDM_PLANE_SIZE);
+    planes[mic] = (uint8_t *)PDM_Frame[PDM_Frame_Next][mic];
+  }
+  if (Send_PDM_to_USB(&header, sizeof(header), planes, AUDIO_PDM_PLANE_SIZE, AUDIO_PDM_MICS) == USBD_OK)
+  {
+    PDM_Frame_Next ^= 1U;
+  }
+}
+#endif /* USE_AUDIO_PDM_CAPTURE */
+
 /**
   * @}
   */
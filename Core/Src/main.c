@@ -46,6 +46,9 @@ UART_HandleTypeDef huart2;
 /* USER CODE BEGIN PV */
 USBD_HandleTypeDef hUSBDDevice;
 extern USBD_AUDIO_ItfTypeDef  USBD_AUDIO_fops;
+#ifdef USE_USB_TELEMETRY
+extern USBD_TELEMETRY_ItfTypeDef  USBD_TELEMETRY_fops;
+#endif
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -89,13 +92,18 @@ int main(void)
 
   /* USER CODE BEGIN SysInit */
   /* Initialize USB descriptor basing on channels number and sampling frequency */
-  USBD_AUDIO_Init_Microphone_Descriptor(&hUSBDDevice, AUDIO_IN_SAMPLING_FREQUENCY, AUDIO_IN_CHANNELS);
+  USBD_AUDIO_Init_Microphone_Descriptor_Config(&hUSBDDevice, AUDIO_IN_SAMPLING_FREQUENCY, AUDIO_USB_CHANNELS,
+                                               AUDIO_USB_CHANNEL_CONFIG, AUDIO_IN_BIT_DEPTH);
   /* Init Device Library */
   USBD_Init(&hUSBDDevice, &AUDIO_Desc, 0);
   /* Add Supported Class */
   USBD_RegisterClass(&hUSBDDevice, &USBD_AUDIO);
   /* Add Interface callbacks for AUDIO Class */
   USBD_AUDIO_RegisterInterface(&hUSBDDevice, &USBD_AUDIO_fops);
+#ifdef USE_USB_TELEMETRY
+  /* Add Interface callbacks for the telemetry interface */
+  USBD_TELEMETRY_RegisterInterface(&USBD_TELEMETRY_fops);
+#endif
   /* Start Device Process */
   USBD_Start(&hUSBDDevice);
   /* USER CODE END SysInit */
@@ -118,6 +126,7 @@ int main(void)
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
+    Audio_Idle_Process();
   }
   /* USER CODE END 3 */
 }
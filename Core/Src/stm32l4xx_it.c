@@ -22,6 +22,7 @@
 #include "stm32l4xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "audio_application.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -211,12 +212,54 @@ void USB_IRQHandler(void)
 
 
 /**
-  * @brief  This function handles DFSDM Left DMAinterrupt request.
+  * @brief  This function handles DFSDM Left DMAinterrupt request, or the SPI DMA of the raw PDM capture
+  *         that uses the same channel.
   * @param  None
   * @retval None
   */
 void AUDIO_DFSDM_DMAx_MIC1_IRQHandler(void)
 {
+#ifdef USE_AUDIO_PDM_CAPTURE
+  CCA02M2_AUDIO_IN_IRQHandler(2, AUDIO_IN_DIGITAL_MIC1);
+#else
   HAL_DMA_IRQHandler(&hDmaDfsdm[0]);
+#endif /* USE_AUDIO_PDM_CAPTURE */
 }
+
+#ifdef USE_AUDIO_PIPELINE
+/**
+  * @brief  This function handles the SW task 1 (AcousticBF processing).
+  * @param  None
+  * @retval None
+  */
+void SW_TASK1_IRQHandler(void)
+{
+  HAL_NVIC_ClearPendingIRQ(SW_TASK1_IRQn);
+  SW_Task1_Callback();
+}
+
+/**
+  * @brief  This function handles the SW task 2 (AcousticSL processing).
+  * @param  None
+  * @retval None
+  */
+void SW_TASK2_IRQHandler(void)
+{
+  HAL_NVIC_ClearPendingIRQ(SW_TASK2_IRQn);
+  SW_Task2_Callback();
+}
+#endif /* USE_AUDIO_PIPELINE */
+
+#ifdef USE_AUDIO_FEATURES
+/**
+  * @brief  This function handles the SW task 3 (feature extraction).
+  * @param  None
+  * @retval None
+  */
+void SW_TASK3_IRQHandler(void)
+{
+  HAL_NVIC_ClearPendingIRQ(SW_TASK3_IRQn);
+  SW_Task3_Callback();
+}
+#endif /* USE_AUDIO_FEATURES */
 /* USER CODE END 1 */
@@ -21,6 +21,9 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "usbd_audio_if.h"
+#ifdef USE_USB_TELEMETRY
+#include "audio_application.h"
+#endif /* USE_USB_TELEMETRY */
 
 extern uint16_t PCM_Buffer[];
 extern CCA02M2_AUDIO_Init_t MicParams;
@@ -38,6 +41,13 @@ static int8_t Audio_Stop(void);
 static int8_t Audio_Pause(void);
 static int8_t Audio_Resume(void);
 static int8_t Audio_CommandMgr(uint8_t cmd);
+static int8_t Audio_GetPosition(uint32_t *frames);
+#ifdef USE_USB_AUDIO_CLASS_2
+static int8_t Audio_SetFrequency(uint32_t AudioFreq);
+#endif /* USE_USB_AUDIO_CLASS_2 */
+#ifdef USE_USB_TELEMETRY
+static int8_t Telemetry_Receive(uint8_t *Buf, uint32_t Len);
+#endif /* USE_USB_TELEMETRY */
 
 /* Private variables ---------------------------------------------------------*/
 extern USBD_HandleTypeDef hUSBDDevice;
@@ -52,8 +62,19 @@ USBD_AUDIO_ItfTypeDef USBD_AUDIO_fops =
   Audio_Pause,
   Audio_Resume,
   Audio_CommandMgr,
+  Audio_GetPosition,
+#ifdef USE_USB_AUDIO_CLASS_2
+  Audio_SetFrequency,
+#endif /* USE_USB_AUDIO_CLASS_2 */
 };
 
+#ifdef USE_USB_TELEMETRY
+USBD_TELEMETRY_ItfTypeDef USBD_TELEMETRY_fops =
+{
+  Telemetry_Receive,
+};
+#endif /* USE_USB_TELEMETRY */
+
 
 /* Private functions ---------------------------------------------------------*/
 /* This table maps the audio device class setting in 1/256 dB to a
@@ -106,7 +127,7 @@ static int8_t Audio_DeInit(uint32_t options)
 static int8_t Audio_Record(void)
 {
 #ifndef DISABLE_USB_DRIVEN_ACQUISITION
-  return CCA02M2_AUDIO_IN_Record(CCA02M2_AUDIO_INSTANCE, (uint8_t *) PCM_Buffer, 0);
+  return Audio_Capture_Start();
 #else
   return BSP_ERROR_NONE;
 #endif  /* DISABLE_USB_DRIVEN_ACQUISITION */
@@ -188,6 +209,75 @@ static int8_t Audio_CommandMgr(uint8_t cmd)
 {
   return BSP_ERROR_NONE;
 }
+
+/**
+  * @brief  Frames captured by the microphones and not passed to the USB engine yet,
+  *     used to lock the USB stream on the host frame clock
+  * @param  frames: number of frames
+  * @retval BSP_ERROR_NONE in case of success, AUDIO_ERROR otherwise
+  */
+static int8_t Audio_GetPosition(uint32_t *frames)
+{
+  return CCA02M2_AUDIO_IN_GetPosition(CCA02M2_AUDIO_INSTANCE, frames);
+}
+
+#ifdef USE_USB_AUDIO_CLASS_2
+/**
+  * @brief  Switches the acquisition to the sampling frequency set by the host.
+  *     The pipeline runs at AUDIO_IN_SAMPLING_FREQUENCY only, without it the
+  *     PCM buffer holds up to AUDIO_IN_SAMPLING_FREQUENCY.
+  * @param  AudioFreq: sampling frequency, in Hz
+  * @retval BSP_ERROR_NONE in case of success, AUDIO_ERROR otherwise
+  */
+static int8_t Audio_SetFrequency(uint32_t AudioFreq)
+{
+  int32_t ret;
+
+#ifdef USE_AUDIO_PIPELINE
+  if (AudioFreq != AUDIO_IN_SAMPLING_FREQUENCY)
+#else
+  if (AudioFreq > AUDIO_IN_SAMPLING_FREQUENCY)
+#endif /* USE_AUDIO_PIPELINE */
+  {
+    return BSP_ERROR_WRONG_PARAM;
+  }
+
+#ifdef DISABLE_USB_DRIVEN_ACQUISITION
+  /* The acquisition is free running: it is restarted at the new frequency */
+  ret = CCA02M2_AUDIO_IN_Stop(CCA02M2_AUDIO_INSTANCE);
+  if (ret == BSP_ERROR_NONE)
+  {
+    ret = CCA02M2_AUDIO_IN_SetSampleRate(CCA02M2_AUDIO_INSTANCE, AudioFreq);
+  }
+  if (ret == BSP_ERROR_NONE)
+  {
+    MicParams.SampleRate = AudioFreq;
+    ret = Audio_Capture_Start();
+  }
+#else
+  /* The stream is stopped, the acquisition restarts with Audio_Record */
+  ret = CCA02M2_AUDIO_IN_SetSampleRate(CCA02M2_AUDIO_INSTANCE, AudioFreq);
+  if (ret == BSP_ERROR_NONE)
+  {
+    MicParams.SampleRate = AudioFreq;
+  }
+#endif  /* DISABLE_USB_DRIVEN_ACQUISITION */
+  return (int8_t)ret;
+}
+#endif /* USE_USB_AUDIO_CLASS_2 */
+
+#ifdef USE_USB_TELEMETRY
+/**
+  * @brief  Configuration write received on the telemetry interface
+  * @param  Buf: received packet
+  * @param  Len: packet length
+  * @retval 0 in case of success, -1 otherwise
+  */
+static int8_t Telemetry_Receive(uint8_t *Buf, uint32_t Len)
+{
+  return Audio_Telemetry_Command(Buf, Len);
+}
+#endif /* USE_USB_TELEMETRY */
 /**
   * @brief  Fills USB audio buffer with the right amount of data, depending on the
   *     channel/frequency configuration
@@ -203,6 +293,84 @@ void Send_Audio_to_USB(int16_t *audioData, uint16_t PCMSamples)
   USBD_AUDIO_Data_Transfer(&hUSBDDevice, (int16_t *)audioData, PCMSamples);
 }
 
+/**
+  * @brief  Returns the block of the USB packet ring to be filled in place with the
+  *     next PCMSamples samples, avoiding the copy done by Send_Audio_to_USB
+  * @param  PCMSamples: number of PCM samples of the block
+  * @retval Pointer to the block, NULL when the host is not streaming or the packet
+  *     ring is full: the block is then dropped, its samples are not sent
+  */
+int16_t *Reserve_Audio_to_USB(uint16_t PCMSamples)
+{
+  int16_t *audioData;
+
+  (void)USBD_AUDIO_Reserve(&hUSBDDevice, PCMSamples, &audioData);
+  return audioData;
+}
+
+/**
+  * @brief  Releases to the USB engine the block returned by Reserve_Audio_to_USB
+  * @param  PCMSamples: number of PCM samples of the block
+  */
+void Commit_Audio_to_USB(uint16_t PCMSamples)
+{
+  USBD_AUDIO_Commit(&hUSBDDevice, PCMSamples);
+}
+
+/**
+  * @brief  Statistics of the USB stream: packets sent, size corrections, dummy
+  *     packets, underruns and overruns of the packet ring, fill level (latency)
+  *     and CPU cost of a packet
+  * @param  stats: filled with the statistics
+  * @param  ResetPeaks: non-zero to restart the fill level and cycles peaks
+  */
+void Get_USB_Audio_Stats(USBD_AUDIO_StatsTypeDef *stats, uint8_t ResetPeaks)
+{
+  USBD_AUDIO_Get_Stats(&hUSBDDevice, stats, ResetPeaks);
+}
+
+#ifdef USE_USB_TELEMETRY
+/**
+  * @brief  Queues a telemetry record for the host. It never waits on the USB
+  *     engine and can be called from the audio interrupts.
+  * @param  Type: record type
+  * @param  pData: record payload
+  * @param  Size: payload size, up to TELEMETRY_MAX_PAYLOAD bytes
+  * @retval USBD_OK, USBD_BUSY when the record was dropped
+  */
+uint8_t Send_Telemetry_to_USB(uint8_t Type, const void *pData, uint8_t Size)
+{
+  return USBD_TELEMETRY_Post(Type, pData, Size);
+}
+
+/**
+  * @brief  Passes a raw PDM frame to the host on the telemetry endpoint: the
+  *     header in a short packet, then the planes sent from the caller memory.
+  * @param  pHeader: frame header
+  * @param  HeaderSize: header size, up to TELEMETRY_STREAM_MAX_HEADER bytes
+  * @param  pPlanes: one plane per microphone, not written before the frame is sent
+  * @param  PlaneSize: plane size in bytes
+  * @param  Planes: number of planes, up to TELEMETRY_STREAM_MAX_PARTS
+  * @retval USBD_OK, USBD_BUSY when the frame was dropped
+  */
+uint8_t Send_PDM_to_USB(const void *pHeader, uint8_t HeaderSize, uint8_t *const pPlanes[], uint16_t PlaneSize, uint8_t Planes)
+{
+  USBD_TELEMETRY_PartTypeDef parts[TELEMETRY_STREAM_MAX_PARTS];
+  uint8_t i;
+
+  if(Planes > TELEMETRY_STREAM_MAX_PARTS)
+  {
+    return USBD_FAIL;
+  }
+  for(i = 0; i < Planes; i++)
+  {
+    parts[i].pBuf = pPlanes[i];
+    parts[i].Size = PlaneSize;
+  }
+  return USBD_TELEMETRY_Stream(pHeader, HeaderSize, parts, Planes);
+}
+#endif /* USE_USB_TELEMETRY */
+
 
 
 
@@ -217,7 +217,7 @@ USBD_StatusTypeDef  USBD_LL_Init(USBD_HandleTypeDef *pdev)
   hpcd.Init.dma_enable = 0;
   hpcd.Init.low_power_enable = 0;
   hpcd.Init.phy_itface = PCD_PHY_EMBEDDED;
-  hpcd.Init.Sof_enable = 0;
+  hpcd.Init.Sof_enable = 1;
   hpcd.Init.speed = PCD_SPEED_FULL;
   hpcd.Init.vbus_sensing_enable = 0;
   /* Link The driver to the stack */
@@ -229,6 +229,10 @@ USBD_StatusTypeDef  USBD_LL_Init(USBD_HandleTypeDef *pdev)
   HAL_PCD_SetRxFiFo(&hpcd, 0x36);
   HAL_PCD_SetTxFiFo(&hpcd, 0, 0x32);
   HAL_PCD_SetTxFiFo(&hpcd, 1, 0xC8);
+#ifdef USE_USB_TELEMETRY
+  /* Telemetry bulk IN, one 64 bytes packet: the 320 words of FIFO are all used */
+  HAL_PCD_SetTxFiFo(&hpcd, 2, 0x10);
+#endif
 
 
   return USBD_OK;
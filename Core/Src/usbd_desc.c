@@ -74,9 +74,15 @@ __ALIGN_BEGIN uint8_t hUSBDDeviceDesc[USB_LEN_DEV_DESC] __ALIGN_END =
   USB_DESC_TYPE_DEVICE,       /* bDescriptorType */
   0x00,                       /* bcdUSB */
   0x02,
+#ifdef USE_USB_AUDIO_CLASS_2
+  0xEF,                       /* bDeviceClass: the function is described by an IAD */
+  0x02,                       /* bDeviceSubClass */
+  0x01,                       /* bDeviceProtocol */
+#else
   0x00,                       /* bDeviceClass */
   0x00,                       /* bDeviceSubClass */
   0x00,                       /* bDeviceProtocol */
+#endif /* USE_USB_AUDIO_CLASS_2 */
   USB_MAX_EP0_SIZE,           /* bMaxPacketSize*/
   LOBYTE(USBD_VID),           /* idVendor */
   HIBYTE(USBD_VID),           /* idVendor */
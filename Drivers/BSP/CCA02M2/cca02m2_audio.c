@@ -20,13 +20,15 @@
 /* Includes ------------------------------------------------------------------*/
 #include "cca02m2_audio.h"
 #include "cca02m2_conf.h"
-#include "audio.h"
+#include "audio.h"
+#include <string.h>
 // On STM32L4XX_NUCLEO board PDM-over-SAI is not supported
 #undef USE_STM32WBXX_NUCLEO
 #include "stm32l4xx_hal_sai.h"
 
 #ifndef USE_STM32L4XX_NUCLEO
 #include "arm_math.h"
+#include "pdm2pcm_mc.h"
 #endif
 
 /** @addtogroup BSP
@@ -88,6 +90,26 @@
   : ((__FREQUENCY__) == (AUDIO_FREQUENCY_48K)) ? (10U) \
   : ((__FREQUENCY__) == (AUDIO_FREQUENCY_96K)) ? (5U) : (5U)
 
+/* 24 and 32-bit resolutions keep 3 more bits of the filter output: the microphone full scale
+   then fills the 24-bit data register of the DFSDM */
+#define DFSDM_MIC_BIT_SHIFT_HIRES(__FREQUENCY__) ((DFSDM_MIC_BIT_SHIFT(__FREQUENCY__)) - 3U)
+
+/* Skew self-test: the microphones are correlated over DFSDM_SKEW_SAMPLES samples, taken from the DMA buffers at
+   most DFSDM_SKEW_SPAN samples at a time and DFSDM_SKEW_MARGIN samples away from the ones the DMA is writing */
+#define DFSDM_SKEW_SAMPLES      512U
+#define DFSDM_SKEW_SPAN         64U
+#define DFSDM_SKEW_MARGIN       4U
+/* Sound travel across the largest microphone spacing of the board, 30 mm from MIC1 to MIC4: the correlation
+   peak of a sound source is that far at most */
+#define DFSDM_SKEW_ACOUSTIC_US  88U
+/* Skew measured beyond the acoustic delay, in samples */
+#define DFSDM_SKEW_MAX_LAG      4U
+#define DFSDM_SKEW_LAG(__FREQUENCY__) \
+  ((((DFSDM_SKEW_ACOUSTIC_US * (__FREQUENCY__)) + 999999U) / 1000000U) + DFSDM_SKEW_MAX_LAG)
+#define DFSDM_SKEW_LAGS         ((2U * DFSDM_SKEW_LAG(AUDIO_FREQUENCY_96K)) + 1U)
+/* Normalized correlation peak under which the microphones did not pick up a common sound */
+#define DFSDM_SKEW_COHERENCE    0.5f
+
 #ifdef USE_STM32WBXX_NUCLEO
 
 #define SAI_DIVIDER(__FREQUENCY__) \
@@ -126,6 +148,10 @@ static DFSDM_Channel_HandleTypeDef hAudioInDfsdmChannel[4];
 DMA_HandleTypeDef hDmaDfsdm[4];
 static DFSDM_Filter_HandleTypeDef hAudioInDfsdmFilter[4];
 
+/* Raw PDM capture handles, one SPI slave per microphone of the MIC1/MIC2 line */
+static SPI_HandleTypeDef hAudioInPdmSpi[2];
+static DMA_HandleTypeDef hDmaPdmSpi[2];
+
 #else
 
 #define DECIMATOR_NUM_TAPS (16U)
@@ -138,6 +164,10 @@ static arm_fir_decimate_instance_q15 ARM_Decimator_State[4];
 static PDM2PCM_Handler_t PDM2PCMHandler[4];
 static PDM2PCM_Config_t  PDM2PCMConfig[4];
 
+/* Multi-channel decimator, used instead of the PDM filters when PDM2PCM_MC_Active is 1 */
+static PDM2PCM_MC_instance_t PDM2PCM_MC_Handler;
+static uint32_t PDM2PCM_MC_Active = 0;
+
 #ifdef USE_STM32WBXX_NUCLEO
 // SAI (Serial Audio Interface) handle: only when using STM32WB boards
 #ifdef USE_STM32WBXX_NUCLEO
@@ -182,7 +212,27 @@ static __IO uint32_t RecBuffTrigger = 0;
 static __IO uint32_t RecBuffHalf = 0;
 static __IO uint32_t MicBuffIndex[4];
 #ifdef USE_STM32L4XX_NUCLEO
-static int32_t MicRecBuff[4][DEFAULT_AUDIO_IN_BUFFER_SIZE];
+/* Circular DMA buffer of each microphone, carved from the arena of CCA02M2_AUDIO_Init_t or MicRecDefault */
+static int32_t *MicRecBuff[4];
+static int32_t MicRecDefault[4][DEFAULT_AUDIO_IN_BUFFER_SIZE];
+static uint32_t MicRecLength = 0;
+/* Samples of each circular DMA buffer of the filter group, to resume it and check its skew */
+static uint32_t DfsdmDmaLength = 0;
+/* Skew self-test: samples taken from the DMA buffers and correlation of the microphones with the first one */
+static int32_t DfsdmSkewSpan[4][DFSDM_SKEW_SPAN];
+static float DfsdmSkewCorr[3][DFSDM_SKEW_LAGS];
+static float DfsdmSkewEnergy[4];
+static uint32_t DfsdmSkewSamples = 0;
+static uint32_t DfsdmSkewBlocks = 0;
+/* Planar capture: planes of the application and last block reported to the transfer callbacks */
+static int16_t *PlanarBuff[4];
+static CCA02M2_AUDIO_IN_Block_t PlanarBlock;
+static uint32_t PlanarSequence = 0;
+/* Sample time and overrun detection of the circular recordings of instances 1 and 2, see AUDIO_IN_Deliver */
+static CCA02M2_AUDIO_IN_Counters_t AudioInCounters[AUDIO_IN_INSTANCES_NBR];
+static uint64_t AudioInSampleNext[AUDIO_IN_INSTANCES_NBR];
+static uint32_t AudioInNextHalf[AUDIO_IN_INSTANCES_NBR];
+static uint32_t AudioInBusy[AUDIO_IN_INSTANCES_NBR];
 #endif
 
 /**
@@ -207,6 +257,28 @@ static void DFSDM_FilterRegConvHalfCpltCallback(DFSDM_Filter_HandleTypeDef *hdfs
 static void DFSDM_FilterRegConvCpltCallback(DFSDM_Filter_HandleTypeDef *hdfsdm_filter);
 #endif /* (USE_HAL_DFSDM_REGISTER_CALLBACKS == 1) */
 
+/* Synchronized start of the DFSDM filters */
+static int32_t DFSDM_Group_Start(uint32_t Length);
+
+/* Blocks reported to the application, with their sample time and overrun counters */
+static void AUDIO_IN_Deliver(uint32_t Instance, uint32_t Half);
+static void AUDIO_IN_Counters_Reset(uint32_t Instance);
+
+/* 24 and 32-bit conversion of the DFSDM results */
+static void DFSDM_Block_Process(uint32_t Offset);
+static void DFSDM_Planar_Process(uint32_t Half);
+static void DFSDM_HiRes_Process(uint32_t Offset);
+static void DFSDM_Skew_Accumulate(uint32_t Channels, uint32_t Span, uint32_t Lag);
+
+/* Raw PDM capture */
+static int32_t AUDIO_IN_PDM_Init(uint32_t PdmClock, uint32_t Mics);
+static void AUDIO_IN_PDM_MspInit(uint32_t Mic);
+#if (USE_HAL_SPI_REGISTER_CALLBACKS == 1U)
+static void SPI_PdmRxCpltCallback(SPI_HandleTypeDef *hspi);
+static void SPI_PdmRxHalfCpltCallback(SPI_HandleTypeDef *hspi);
+static void SPI_PdmErrorCallback(SPI_HandleTypeDef *hspi);
+#endif /* (USE_HAL_SPI_REGISTER_CALLBACKS == 1U) */
+
 #else
 
 #ifdef USE_STM32WBXX_NUCLEO
@@ -254,6 +326,15 @@ __weak int32_t CCA02M2_AUDIO_IN_Init(uint32_t Instance, CCA02M2_AUDIO_Init_t *Au
     AudioInCtx[Instance].BitsPerSample   = AudioInit->BitsPerSample;
     AudioInCtx[Instance].Volume          = AudioInit->Volume;
     AudioInCtx[Instance].State           = AUDIO_IN_STATE_RESET;
+    AudioInCtx[Instance].BlockMs         = (AudioInit->BlockMs == 0U) ? N_MS_PER_INTERRUPT : AudioInit->BlockMs;
+    AudioInCtx[Instance].pArena          = AudioInit->pArena;
+    AudioInCtx[Instance].ArenaSize       = AudioInit->ArenaSize;
+
+    if ((Instance != 1U) && (AudioInCtx[Instance].BlockMs != N_MS_PER_INTERRUPT))
+    {
+      /* The PDM buffers of the other instances are sized at build time */
+      return BSP_ERROR_WRONG_PARAM;
+    }
 
     if (Instance == 0U)
     {
@@ -454,6 +535,42 @@ __weak int32_t CCA02M2_AUDIO_IN_Init(uint32_t Instance, CCA02M2_AUDIO_Init_t *Au
 #ifdef USE_STM32L4XX_NUCLEO
 
       int8_t i;
+      uint32_t length = (AudioInit->SampleRate / 1000U) * 2U * AudioInCtx[Instance].BlockMs;
+
+      if ((AudioInit->BitsPerSample != AUDIO_RESOLUTION_16b) && (AudioInit->BitsPerSample != AUDIO_RESOLUTION_24b)
+          && (AudioInit->BitsPerSample != AUDIO_RESOLUTION_32b))
+      {
+        return BSP_ERROR_WRONG_PARAM;
+      }
+      if ((AudioInCtx[Instance].BlockMs > AUDIO_IN_MAX_BLOCK_MS) || (AudioInit->ChannelsNbr > 4U))
+      {
+        return BSP_ERROR_WRONG_PARAM;
+      }
+      /* Two blocks of 32-bit results per microphone, in the arena when there is one */
+      if (AudioInit->pArena == NULL)
+      {
+        if (length > DEFAULT_AUDIO_IN_BUFFER_SIZE)
+        {
+          return BSP_ERROR_WRONG_PARAM;
+        }
+        for (i = 0; i < 4; i++)
+        {
+          MicRecBuff[i] = MicRecDefault[i];
+        }
+      }
+      else
+      {
+        if (AudioInit->ArenaSize < CCA02M2_AUDIO_IN_ARENA_SIZE(AudioInit->SampleRate, AudioInit->ChannelsNbr,
+                                                               AudioInCtx[Instance].BlockMs))
+        {
+          return BSP_ERROR_WRONG_PARAM;
+        }
+        for (i = 0; i < 4; i++)
+        {
+          MicRecBuff[i] = ((uint32_t)i < AudioInit->ChannelsNbr) ? &AudioInit->pArena[(uint32_t)i * length] : NULL;
+        }
+      }
+      MicRecLength = length;
       DFSDM_Filter_TypeDef *FilterInstnace[4] = {AUDIO_DFSDMx_MIC1_FILTER, AUDIO_DFSDMx_MIC2_FILTER, AUDIO_DFSDMx_MIC3_FILTER, AUDIO_DFSDMx_MIC4_FILTER};
       DFSDM_Channel_TypeDef *ChannelInstance[4] = {AUDIO_DFSDMx_MIC1_CHANNEL, AUDIO_DFSDMx_MIC2_CHANNEL, AUDIO_DFSDMx_MIC3_CHANNEL, AUDIO_DFSDMx_MIC4_CHANNEL};
       uint32_t DigitalMicPins[4] = {DFSDM_CHANNEL_SAME_CHANNEL_PINS, DFSDM_CHANNEL_FOLLOWING_CHANNEL_PINS, DFSDM_CHANNEL_SAME_CHANNEL_PINS, DFSDM_CHANNEL_FOLLOWING_CHANNEL_PINS};
@@ -499,7 +616,14 @@ __weak int32_t CCA02M2_AUDIO_IN_Init(uint32_t Instance, CCA02M2_AUDIO_Init_t *Au
         dfsdm_config.SincOrder       = DFSDM_FILTER_ORDER(AudioInCtx[Instance].SampleRate);
         dfsdm_config.Oversampling    = DFSDM_OVER_SAMPLING(AudioInCtx[Instance].SampleRate);
         dfsdm_config.ClockDivider    = DFSDM_CLOCK_DIVIDER(AudioInCtx[Instance].SampleRate);
-        dfsdm_config.RightBitShift   = DFSDM_MIC_BIT_SHIFT(AudioInCtx[Instance].SampleRate);
+        if (AudioInCtx[Instance].BitsPerSample == AUDIO_RESOLUTION_16b)
+        {
+          dfsdm_config.RightBitShift = DFSDM_MIC_BIT_SHIFT(AudioInCtx[Instance].SampleRate);
+        }
+        else
+        {
+          dfsdm_config.RightBitShift = DFSDM_MIC_BIT_SHIFT_HIRES(AudioInCtx[Instance].SampleRate);
+        }
 
         if (((AudioInit->Device >> (uint8_t)i) & AUDIO_IN_DIGITAL_MIC1) == AUDIO_IN_DIGITAL_MIC1)
         {
@@ -531,7 +655,23 @@ __weak int32_t CCA02M2_AUDIO_IN_Init(uint32_t Instance, CCA02M2_AUDIO_Init_t *Au
     }
     else /* Instance = 2 */
     {
+#ifdef USE_STM32L4XX_NUCLEO
+      int32_t ret;
+
+      /* SampleRate is the PDM clock in Hz, ChannelsNbr the microphones of the MIC1/MIC2 line */
+      if ((AudioInit->SampleRate < 1000000U) || (AudioInit->SampleRate > 3200000U)
+          || (AudioInit->ChannelsNbr < 1U) || (AudioInit->ChannelsNbr > 2U))
+      {
+        return BSP_ERROR_WRONG_PARAM;
+      }
+      ret = AUDIO_IN_PDM_Init(AudioInit->SampleRate, AudioInit->ChannelsNbr);
+      if (ret != BSP_ERROR_NONE)
+      {
+        return ret;
+      }
+#else
       // PDM direttamente?
+#endif
     }
 
     /* Update BSP AUDIO IN state */
@@ -560,6 +700,21 @@ __weak int32_t CCA02M2_AUDIO_IN_DeInit(uint32_t Instance)
 #ifdef USE_STM32L4XX_NUCLEO
 
       int8_t i;
+      if (Instance == 2U)
+      {
+        for (i = 0; i < 2; i++)
+        {
+          if (hAudioInPdmSpi[i].Instance != NULL)
+          {
+            if (HAL_OK != HAL_SPI_DeInit(&hAudioInPdmSpi[i]))
+            {
+              return  BSP_ERROR_PERIPH_FAILURE;
+            }
+            (void)HAL_DMA_DeInit(&hDmaPdmSpi[i]);
+            hAudioInPdmSpi[i].Instance = NULL;
+          }
+        }
+      }
       for (i = 0; i < DFSDM_MIC_NUMBER; i++)
       {
         /* De-initializes DFSDM Filter handle */
@@ -588,8 +743,9 @@ __weak int32_t CCA02M2_AUDIO_IN_DeInit(uint32_t Instance)
           hAudioInDfsdmChannel[i].Instance = NULL;
         }
       }
-      /* Reset AudioInCtx[1].IsMultiBuff if any */
+      /* Reset AudioInCtx[1].IsMultiBuff and AudioInCtx[1].IsPlanar if any */
       AudioInCtx[1].IsMultiBuff = 0;
+      AudioInCtx[1].IsPlanar = 0;
 #else
       return  BSP_ERROR_WRONG_PARAM;
 #endif
@@ -1100,6 +1256,32 @@ __weak int32_t CCA02M2_AUDIO_IN_PDMToPCM_Init(uint32_t Instance, uint32_t AudioF
     static int16_t aCoeffs[] = { -1406, 1634, -1943, 2386, -3080, 4325, -7223, 21690, 21690, -7223, 4325, -3080, 2386, -1943, 1634, -1406, };
 #endif
 
+#if (USE_PDM2PCM_MC == 1U) && (ENABLE_HIGH_PERFORMANCE_MODE == 0U)
+    /* 16-bit samples: all the microphones in one call of the multi-channel decimator, 8 KHz included */
+    PDM2PCM_MC_Active = 0;
+    if ((AudioInCtx[0].BitsPerSample == AUDIO_RESOLUTION_16b) && (ChnlNbrOut == ChnlNbrIn))
+    {
+      PDM2PCM_MC_Handler.init_params.channels = ChnlNbrIn;
+      PDM2PCM_MC_Handler.init_params.decimation = AudioInCtx[0].DecimationFactor;
+      PDM2PCM_MC_Handler.init_params.samples = (AudioFreq / 1000U) * N_MS_PER_INTERRUPT;
+      PDM2PCM_MC_Handler.init_params.sample_rate = AudioFreq;
+#ifdef USE_STM32WBXX_NUCLEO
+      PDM2PCM_MC_Handler.init_params.endianness = PDM2PCM_MC_ENDIANNESS_LE;
+#else
+      PDM2PCM_MC_Handler.init_params.endianness = (ChnlNbrIn == 1U) ? PDM2PCM_MC_ENDIANNESS_BE :
+                                                  PDM2PCM_MC_ENDIANNESS_LE;
+#endif
+      PDM2PCM_MC_Handler.init_params.mic_gain = 24;
+      PDM2PCM_MC_Handler.init_params.layout = PDM2PCM_MC_OUTPUT_INTERLEAVED;
+      if (PDM2PCM_MC_Init(&PDM2PCM_MC_Handler) != PDM2PCM_MC_ERROR_NONE)
+      {
+        return  BSP_ERROR_NO_INIT;
+      }
+      PDM2PCM_MC_Active = 1;
+      return BSP_ERROR_NONE;
+    }
+#endif
+
     /* Enable CRC peripheral to unlock the PDM library */
     __HAL_RCC_CRC_CLK_ENABLE();
 
@@ -1221,6 +1403,13 @@ __weak int32_t CCA02M2_AUDIO_IN_PDMToPCM(uint32_t Instance, uint16_t *PDMBuf, ui
 #else
     uint32_t index;
 
+#if (USE_PDM2PCM_MC == 1U) && (ENABLE_HIGH_PERFORMANCE_MODE == 0U)
+    if (PDM2PCM_MC_Active == 1U)
+    {
+      (void)PDM2PCM_MC_Process(&PDM2PCM_MC_Handler, (uint8_t *)PDMBuf, (int16_t *)PCMBuf);
+      return BSP_ERROR_NONE;
+    }
+#endif
     for (index = 0; index < AudioInCtx[Instance].ChannelsNbr; index++)
     {
       if (AudioInCtx[Instance].SampleRate == 8000U)
@@ -1323,14 +1512,11 @@ int32_t CCA02M2_AUDIO_IN_Record(uint32_t Instance, uint8_t *pBuf, uint32_t NbrOf
     else
     {
 #ifdef USE_STM32L4XX_NUCLEO
-      int32_t counter;
-
-      for (counter = (int32_t)(AudioInCtx[Instance].ChannelsNbr); counter > 0; counter --)
+      AudioInCtx[Instance].IsPlanar = 0;
+      AUDIO_IN_Counters_Reset(Instance);
+      if (DFSDM_Group_Start(NbrOfBytes) != BSP_ERROR_NONE)
       {
-        if (HAL_DFSDM_FilterRegularStart_DMA(&hAudioInDfsdmFilter[counter - 1], MicRecBuff[counter - 1], NbrOfBytes) != HAL_OK)
-        {
-          return BSP_ERROR_PERIPH_FAILURE;
-        }
+        return BSP_ERROR_PERIPH_FAILURE;
       }
       /* Update BSP AUDIO IN state */
       AudioInCtx[Instance].State = AUDIO_IN_STATE_RECORDING;
@@ -1383,6 +1569,21 @@ int32_t CCA02M2_AUDIO_IN_Stop(uint32_t Instance)
         return BSP_ERROR_PERIPH_FAILURE;
       }
 #endif
+#endif
+    }
+    else if (Instance == 2U)
+    {
+#ifdef USE_STM32L4XX_NUCLEO
+      uint32_t mic;
+      for (mic = 0; mic < AudioInCtx[Instance].ChannelsNbr; mic++)
+      {
+        if (HAL_SPI_DMAStop(&hAudioInPdmSpi[mic]) != HAL_OK)
+        {
+          return BSP_ERROR_PERIPH_FAILURE;
+        }
+      }
+#else
+      return  BSP_ERROR_WRONG_PARAM;
 #endif
     }
     else /*(Instance == 1U) */
@@ -1500,15 +1701,9 @@ int32_t CCA02M2_AUDIO_IN_Resume(uint32_t Instance)
     else /* (Instance == 1U) */
     {
 #ifdef USE_STM32L4XX_NUCLEO
-      int32_t counter;
-
-      for (counter = (int32_t)(AudioInCtx[Instance].ChannelsNbr); counter > 0; counter --)
+      if (DFSDM_Group_Start(DfsdmDmaLength) != BSP_ERROR_NONE)
       {
-        if (HAL_DFSDM_FilterRegularStart_DMA(&hAudioInDfsdmFilter[counter - 1], MicRecBuff[counter - 1],
-                                             DEFAULT_AUDIO_IN_BUFFER_SIZE) != HAL_OK)
-        {
-          return BSP_ERROR_PERIPH_FAILURE;
-        }
+        return BSP_ERROR_PERIPH_FAILURE;
       }
 #else
       return  BSP_ERROR_WRONG_PARAM;
@@ -1590,6 +1785,252 @@ int32_t CCA02M2_AUDIO_IN_RecordChannels(uint32_t Instance, uint8_t **pBuf, uint3
   }
 }
 
+/**
+  * @brief  Starts the planar 16-bit recording: each microphone is converted into its own plane, with the gain
+  *         and the high pass filter of CCA02M2_AUDIO_IN_Record but without interleave. Each transfer callback
+  *         reports a block of BlockMs ms (CCA02M2_AUDIO_Init_t), read with CCA02M2_AUDIO_IN_GetBlock.
+  * @param  Instance  AUDIO IN Instance. It can be only 1 (DFSDM used)
+  * @param  pPlanes   One plane per channel, pPlanes[0] for MIC1, each holding 2 blocks (double buffer)
+  * @param  NbrOfBytes  Size of each plane
+  * @retval BSP status
+  */
+int32_t CCA02M2_AUDIO_IN_RecordPlanar(uint32_t Instance, int16_t **pPlanes, uint32_t NbrOfBytes)
+{
+  if (Instance != 1U)
+  {
+    return BSP_ERROR_WRONG_PARAM;
+  }
+  else
+  {
+#ifdef USE_STM32L4XX_NUCLEO
+    uint32_t samples = (AudioInCtx[Instance].SampleRate / 1000U) * AudioInCtx[Instance].BlockMs;
+    uint32_t j;
+
+    if ((pPlanes == NULL) || (AudioInCtx[Instance].BitsPerSample != AUDIO_RESOLUTION_16b)
+        || (NbrOfBytes < (2U * samples * sizeof(int16_t))) || ((2U * samples) > MicRecLength))
+    {
+      return BSP_ERROR_WRONG_PARAM;
+    }
+    for (j = 0; j < AudioInCtx[Instance].ChannelsNbr; j++)
+    {
+      if (pPlanes[j] == NULL)
+      {
+        return BSP_ERROR_WRONG_PARAM;
+      }
+      PlanarBuff[j] = pPlanes[j];
+    }
+
+    PlanarSequence = 0;
+    AudioInCtx[Instance].IsMultiBuff = 0;
+    AudioInCtx[Instance].IsPlanar = 1;
+    AUDIO_IN_Counters_Reset(Instance);
+
+    if (DFSDM_Group_Start(2U * samples) != BSP_ERROR_NONE)
+    {
+      return BSP_ERROR_PERIPH_FAILURE;
+    }
+    /* Update BSP AUDIO IN state */
+    AudioInCtx[Instance].State = AUDIO_IN_STATE_RECORDING;
+    /* Return BSP status */
+    return BSP_ERROR_NONE;
+#else
+    UNUSED(pPlanes);
+    UNUSED(NbrOfBytes);
+    return BSP_ERROR_WRONG_PARAM;
+#endif
+  }
+}
+
+/**
+  * @brief  Reports the block of the planar recording just completed, from the transfer callbacks.
+  * @note   The planes belong to the application until the block ReleaseSequence is complete, that is one block
+  *         period after the next callback: the driver does not read them back, they can be processed in place.
+  * @param  Instance  AUDIO IN Instance. It can be only 1 (DFSDM used)
+  * @param  pBlock    Filled with the block
+  * @retval BSP status
+  */
+int32_t CCA02M2_AUDIO_IN_GetBlock(uint32_t Instance, CCA02M2_AUDIO_IN_Block_t *pBlock)
+{
+#ifdef USE_STM32L4XX_NUCLEO
+  uint32_t primask;
+#endif
+
+  if ((Instance != 1U) || (pBlock == NULL) || (AudioInCtx[Instance].IsPlanar != 1U))
+  {
+    return BSP_ERROR_WRONG_PARAM;
+  }
+#ifdef USE_STM32L4XX_NUCLEO
+  /* The block is rewritten by the transfer callbacks: planes, sequence and timestamps are copied together */
+  primask = __get_PRIMASK();
+  __disable_irq();
+  *pBlock = PlanarBlock;
+  __set_PRIMASK(primask);
+  return BSP_ERROR_NONE;
+#else
+  return BSP_ERROR_WRONG_PARAM;
+#endif
+}
+
+/**
+  * @brief  Sample skew self-test of the DFSDM filter group: the samples of the microphones are correlated with
+  *         the ones of the first microphone, the skew being the lag of the correlation peak beyond the acoustic
+  *         delay of the sound, which the spacing of the microphones bounds. Each call takes the samples of the
+  *         DMA buffers away from the ones being written, the DMA position and the block counter telling whether
+  *         they were overwritten while read, and reports the skew once DFSDM_SKEW_SAMPLES are correlated.
+  * @note   To be called from thread context, e.g. the main loop, never from the audio interrupt: the interrupts
+  *         are not masked and the correlation costs a few thousand multiply-accumulates per call.
+  * @note   A skew below the acoustic delay, DFSDM_SKEW_ACOUSTIC_US, cannot be told from the direction of the
+  *         sound; beyond it, skews of up to DFSDM_SKEW_MAX_LAG samples are measured, larger ones reported as
+  *         DFSDM_SKEW_MAX_LAG.
+  * @param  Instance  AUDIO IN Instance. It can be only 1 (DFSDM used)
+  * @param  pSkew     Largest skew of a microphone against the first one, in samples
+  * @retval BSP status: BSP_ERROR_BUSY while not recording, while the correlation is accumulated, and when the
+  *         microphones did not pick up a sound coherent enough to measure it
+  */
+int32_t CCA02M2_AUDIO_IN_CheckSkew(uint32_t Instance, uint32_t *pSkew)
+{
+#ifdef USE_STM32L4XX_NUCLEO
+  uint32_t length = DfsdmDmaLength;
+  uint32_t channels = AudioInCtx[1].ChannelsNbr;
+  uint32_t lag = DFSDM_SKEW_LAG(AudioInCtx[1].SampleRate);
+  uint32_t acoustic = lag - DFSDM_SKEW_MAX_LAG;
+  uint32_t blocks;
+  uint32_t span;
+  uint32_t position;
+  uint32_t advance;
+  uint32_t skew = 0;
+  uint32_t best;
+  uint32_t i, j, l;
+  float peak;
+
+  if ((Instance != 1U) || (pSkew == NULL) || (AudioInCtx[Instance].IsMultiBuff == 1U))
+  {
+    return BSP_ERROR_WRONG_PARAM;
+  }
+  else if (AudioInCtx[Instance].State != AUDIO_IN_STATE_RECORDING)
+  {
+    return BSP_ERROR_BUSY;
+  }
+  else if (channels < 2U)
+  {
+    *pSkew = 0;
+    return BSP_ERROR_NONE;
+  }
+  else
+  {
+    /* One span per block, the samples of the newer blocks being read at the next calls */
+    blocks = AudioInCounters[1].Blocks;
+    if ((blocks == DfsdmSkewBlocks) && (DfsdmSkewSamples != 0U))
+    {
+      return BSP_ERROR_BUSY;
+    }
+
+    /* The span ends with the last sample of the first filter, the followers being one sample ahead at most.
+       The oldest samples first, the DMA overwrites them next */
+    span = length - DFSDM_SKEW_MARGIN;
+    if (span > DFSDM_SKEW_SPAN)
+    {
+      span = DFSDM_SKEW_SPAN;
+    }
+    if (span < ((2U * lag) + 2U))
+    {
+      return BSP_ERROR_WRONG_PARAM;
+    }
+    position = length - __HAL_DMA_GET_COUNTER(hAudioInDfsdmFilter[0].hdmaReg);
+    for (j = 0; j < channels; j++)
+    {
+      for (i = 0; i < span; i++)
+      {
+        DfsdmSkewSpan[j][i] = MicRecBuff[j][(position + (length - span) + i) % length] / 256;
+      }
+    }
+    /* Less than a buffer since the position was read, and the followers not into the span */
+    advance = ((length - __HAL_DMA_GET_COUNTER(hAudioInDfsdmFilter[0].hdmaReg)) + length - position) % length;
+    if (((AudioInCounters[1].Blocks - blocks) > 1U) || ((advance + 2U) > (length - span)))
+    {
+      return BSP_ERROR_BUSY;
+    }
+    DfsdmSkewBlocks = blocks;
+
+    if (DfsdmSkewSamples == 0U)
+    {
+      (void)memset(DfsdmSkewCorr, 0, sizeof(DfsdmSkewCorr));
+      (void)memset(DfsdmSkewEnergy, 0, sizeof(DfsdmSkewEnergy));
+    }
+    DFSDM_Skew_Accumulate(channels, span, lag);
+    DfsdmSkewSamples += span - (2U * lag) - 1U;
+    if (DfsdmSkewSamples < DFSDM_SKEW_SAMPLES)
+    {
+      return BSP_ERROR_BUSY;
+    }
+    DfsdmSkewSamples = 0;
+
+    for (j = 1; j < channels; j++)
+    {
+      best = 0;
+      for (l = 1; l < ((2U * lag) + 1U); l++)
+      {
+        if (DfsdmSkewCorr[j - 1U][l] > DfsdmSkewCorr[j - 1U][best])
+        {
+          best = l;
+        }
+      }
+      peak = DfsdmSkewCorr[j - 1U][best];
+      if ((peak <= 0.0f) ||
+          ((peak * peak) < (DFSDM_SKEW_COHERENCE * DFSDM_SKEW_COHERENCE * DfsdmSkewEnergy[0] * DfsdmSkewEnergy[j])))
+      {
+        return BSP_ERROR_BUSY;
+      }
+      /* Offset from lag 0, at index lag */
+      best = (best > lag) ? (best - lag) : (lag - best);
+      if (best > acoustic)
+      {
+        best -= acoustic;
+        if (best > skew)
+        {
+          skew = best;
+        }
+      }
+    }
+    *pSkew = skew;
+  }
+  return BSP_ERROR_NONE;
+#else
+  UNUSED(Instance);
+  UNUSED(pSkew);
+  return BSP_ERROR_WRONG_PARAM;
+#endif
+}
+
+/**
+  * @brief  Reads the sample time and the overrun counters of the recording, cleared when it starts. The sample
+  *         time stops while the recording is paused.
+  * @param  Instance   AUDIO IN Instance. It can be 1 (DFSDM used) or 2 (PDM used)
+  * @param  pCounters  Filled with the counters
+  * @retval BSP status
+  */
+int32_t CCA02M2_AUDIO_IN_GetCounters(uint32_t Instance, CCA02M2_AUDIO_IN_Counters_t *pCounters)
+{
+#ifdef USE_STM32L4XX_NUCLEO
+  uint32_t primask;
+
+  if (((Instance != 1U) && (Instance != 2U)) || (pCounters == NULL))
+  {
+    return BSP_ERROR_WRONG_PARAM;
+  }
+  /* The 64-bit sample time is updated by the transfer callbacks */
+  primask = __get_PRIMASK();
+  __disable_irq();
+  *pCounters = AudioInCounters[Instance];
+  __set_PRIMASK(primask);
+  return BSP_ERROR_NONE;
+#else
+  UNUSED(Instance);
+  UNUSED(pCounters);
+  return BSP_ERROR_WRONG_PARAM;
+#endif
+}
+
 /**
   * @brief  Stop audio recording.
   * @param  Instance  AUDIO IN Instance. It can be 1(DFSDM used)
@@ -1692,6 +2133,9 @@ int32_t CCA02M2_AUDIO_IN_ResumeChannels(uint32_t Instance, uint32_t Device)
   * @param  Instance  AUDIO IN SAI PDM Instance. It can be only 2
   * @param  pbuf     Main buffer pointer for the recorded data storing
   * @param  NbrOfBytes     Size of the record buffer. Parameter not used when Instance is 0
+  * @note   On STM32L4 the buffer holds one plane per microphone, NbrOfBytes / ChannelsNbr bytes each, filled
+  *         in circular mode: the half transfer callback reports the first half of every plane and the transfer
+  *         complete callback the second half. Samples are 16-bit words of the SPI, first bit in the MSB.
   * @retval BSP status
   */
 int32_t CCA02M2_AUDIO_IN_RecordPDM(uint32_t Instance, uint8_t *pBuf, uint32_t NbrOfBytes)
@@ -1712,6 +2156,49 @@ int32_t CCA02M2_AUDIO_IN_RecordPDM(uint32_t Instance, uint8_t *pBuf, uint32_t Nb
     {
       return BSP_ERROR_PERIPH_FAILURE;
     }
+    AudioInCtx[Instance].State = AUDIO_IN_STATE_RECORDING;
+    return BSP_ERROR_NONE;
+#elif defined(USE_STM32L4XX_NUCLEO)
+
+    uint32_t mic;
+    uint32_t primask;
+    uint32_t plane = NbrOfBytes / AudioInCtx[Instance].ChannelsNbr;
+
+    /* Each half of a plane is a whole number of 16-bit words */
+    if ((pBuf == NULL) || ((plane % 4U) != 0U) || ((plane / 2U) > 0xFFFFU))
+    {
+      return BSP_ERROR_WRONG_PARAM;
+    }
+    AudioInCtx[Instance].pBuff = (uint16_t *)pBuf;
+    AudioInCtx[Instance].Size = NbrOfBytes;
+    AUDIO_IN_Counters_Reset(Instance);
+
+    /* The SPIs are armed deselected (software NSS, SSI set) while the microphone clock runs, then selected
+       back to back: all the planes start within one PDM clock period of each other */
+    for (mic = 0; mic < AudioInCtx[Instance].ChannelsNbr; mic++)
+    {
+      SET_BIT(hAudioInPdmSpi[mic].Instance->CR1, SPI_CR1_SSI);
+    }
+    for (mic = 0; mic < AudioInCtx[Instance].ChannelsNbr; mic++)
+    {
+      if (HAL_SPI_Receive_DMA(&hAudioInPdmSpi[mic], &pBuf[mic * plane], (uint16_t)(plane / 2U)) != HAL_OK)
+      {
+        while (mic > 0U)
+        {
+          mic--;
+          (void)HAL_SPI_DMAStop(&hAudioInPdmSpi[mic]);
+        }
+        return BSP_ERROR_PERIPH_FAILURE;
+      }
+    }
+    primask = __get_PRIMASK();
+    __disable_irq();
+    for (mic = 0; mic < AudioInCtx[Instance].ChannelsNbr; mic++)
+    {
+      CLEAR_BIT(hAudioInPdmSpi[mic].Instance->CR1, SPI_CR1_SSI);
+    }
+    __set_PRIMASK(primask);
+
     AudioInCtx[Instance].State = AUDIO_IN_STATE_RECORDING;
     return BSP_ERROR_NONE;
 #else
@@ -1764,6 +2251,9 @@ int32_t CCA02M2_AUDIO_IN_SetDevice(uint32_t Instance, uint32_t Device)
     audio_init.SampleRate    = AudioInCtx[Instance].SampleRate;
     audio_init.BitsPerSample = AudioInCtx[Instance].BitsPerSample;
     audio_init.Volume        = AudioInCtx[Instance].Volume;
+    audio_init.BlockMs       = AudioInCtx[Instance].BlockMs;
+    audio_init.pArena        = AudioInCtx[Instance].pArena;
+    audio_init.ArenaSize     = AudioInCtx[Instance].ArenaSize;
 
     if (CCA02M2_AUDIO_IN_Init(Instance, &audio_init) != BSP_ERROR_NONE)
     {
@@ -1842,6 +2332,9 @@ int32_t CCA02M2_AUDIO_IN_SetSampleRate(uint32_t Instance, uint32_t  SampleRate)
     audio_init.SampleRate    = SampleRate;
     audio_init.BitsPerSample = AudioInCtx[Instance].BitsPerSample;
     audio_init.Volume        = AudioInCtx[Instance].Volume;
+    audio_init.BlockMs       = AudioInCtx[Instance].BlockMs;
+    audio_init.pArena        = AudioInCtx[Instance].pArena;
+    audio_init.ArenaSize     = AudioInCtx[Instance].ArenaSize;
     if (CCA02M2_AUDIO_IN_Init(Instance, &audio_init) != BSP_ERROR_NONE)
     {
       return BSP_ERROR_NO_INIT;
@@ -1916,6 +2409,9 @@ int32_t CCA02M2_AUDIO_IN_SetBitsPerSample(uint32_t Instance, uint32_t BitsPerSam
     audio_init.SampleRate    = AudioInCtx[Instance].SampleRate;
     audio_init.BitsPerSample = BitsPerSample;
     audio_init.Volume        = AudioInCtx[Instance].Volume;
+    audio_init.BlockMs       = AudioInCtx[Instance].BlockMs;
+    audio_init.pArena        = AudioInCtx[Instance].pArena;
+    audio_init.ArenaSize     = AudioInCtx[Instance].ArenaSize;
     if (CCA02M2_AUDIO_IN_Init(Instance, &audio_init) != BSP_ERROR_NONE)
     {
       return BSP_ERROR_NO_INIT;
@@ -2017,6 +2513,13 @@ int32_t CCA02M2_AUDIO_IN_SetVolume(uint32_t Instance, uint32_t Volume)
       27, 27, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 29, 29, 29, 29, 29, 29, 29, 29, 29,
       29, 29, 29, 29, 30, 30, 30, 30, 30, 30, 30, 31
     };
+#if (USE_PDM2PCM_MC == 1U) && (ENABLE_HIGH_PERFORMANCE_MODE == 0U)
+    if (PDM2PCM_MC_Active == 1U)
+    {
+      (void)PDM2PCM_MC_SetGain(&PDM2PCM_MC_Handler, VolumeGain[Volume]);
+      return BSP_ERROR_NONE;
+    }
+#endif
     for (index = 0; index < AudioInCtx[Instance].ChannelsNbr; index++)
     {
       if (PDM2PCMConfig[index].mic_gain != VolumeGain[Volume])
@@ -2077,6 +2580,41 @@ int32_t CCA02M2_AUDIO_IN_GetState(uint32_t Instance, uint32_t *State)
   return BSP_ERROR_NONE;
 }
 
+/**
+  * @brief  Get the samples per channel captured since the last half or complete transfer callback
+  * @param  Instance  AUDIO IN Instance. It can only be 1 (DFSDM is used)
+  * @param  Position  Samples captured in the half buffer being filled by the DMA
+  * @retval BSP status
+  */
+int32_t CCA02M2_AUDIO_IN_GetPosition(uint32_t Instance, uint32_t *Position)
+{
+#ifdef USE_STM32L4XX_NUCLEO
+  uint32_t half_size;
+  uint32_t remaining;
+
+  if (Instance != 1U)
+  {
+    return BSP_ERROR_WRONG_PARAM;
+  }
+  else if (AudioInCtx[Instance].State != AUDIO_IN_STATE_RECORDING)
+  {
+    return BSP_ERROR_BUSY;
+  }
+  else
+  {
+    /* All the microphones are started together, the first DMA stands for all of them */
+    half_size = (AudioInCtx[Instance].SampleRate / 1000U) * AudioInCtx[Instance].BlockMs;
+    remaining = __HAL_DMA_GET_COUNTER(hAudioInDfsdmFilter[0].hdmaReg);
+    *Position = ((2U * half_size) - remaining) % half_size;
+  }
+  return BSP_ERROR_NONE;
+#else
+  UNUSED(Instance);
+  UNUSED(Position);
+  return BSP_ERROR_WRONG_PARAM;
+#endif
+}
+
 #ifdef USE_STM32L4XX_NUCLEO
 
 /**
@@ -2087,10 +2625,13 @@ int32_t CCA02M2_AUDIO_IN_GetState(uint32_t Instance, uint32_t *State)
   */
 void CCA02M2_AUDIO_IN_IRQHandler(uint32_t Instance, uint32_t Device)
 {
-  /* Prevent unused argument(s) compilation warning */
-  UNUSED(Instance);
-
-  if (Device == AUDIO_IN_DIGITAL_MIC1)
+  if (Instance == 2U)
+  {
+    /* Raw PDM capture: the DMA of the first SPI paces all the planes */
+    UNUSED(Device);
+    HAL_DMA_IRQHandler(hAudioInPdmSpi[0].hdmarx);
+  }
+  else if (Device == AUDIO_IN_DIGITAL_MIC1)
   {
     HAL_DMA_IRQHandler(hAudioInDfsdmFilter[0].hdmaReg);
   }
@@ -2119,28 +2660,31 @@ using HAL_DFSDM_FilterGetRegularValue.
   */
 void HAL_DFSDM_FilterRegConvCpltCallback(DFSDM_Filter_HandleTypeDef *hdfsdm_filter)
 {
-  uint32_t i, j;
-
   if (AudioInCtx[1].IsMultiBuff == 1U)
   {
     /* Call the record update function to get the second half */
     CCA02M2_AUDIO_IN_TransferComplete_CallBack(1);
   }
-  else
+  else if (AudioInCtx[1].IsPlanar == 1U)
   {
     if (hdfsdm_filter == &hAudioInDfsdmFilter[POS_VAL(AUDIO_IN_DIGITAL_MIC1)])
     {
-      for (j = 0; j < AudioInCtx[1].ChannelsNbr; j ++)
-      {
-        for (i = 0; i < ((AudioInCtx[1].SampleRate / (uint32_t)1000) * N_MS_PER_INTERRUPT); i++)
-        {
-          AudioInCtx[1].HP_Filters[j].Z = ((MicRecBuff[j][i + ((AudioInCtx[1].SampleRate / (uint32_t)1000) * N_MS_PER_INTERRUPT)] / 256) * (int32_t)(AudioInCtx[1].Volume)) / 128;
-          AudioInCtx[1].HP_Filters[j].oldOut = (0xFC * (AudioInCtx[1].HP_Filters[j].oldOut + AudioInCtx[1].HP_Filters[j].Z - AudioInCtx[1].HP_Filters[j].oldIn)) / 256;
-          AudioInCtx[1].HP_Filters[j].oldIn = AudioInCtx[1].HP_Filters[j].Z;
-          AudioInCtx[1].pBuff[(i * AudioInCtx[1].ChannelsNbr) + j] = (uint16_t)(SaturaLH(AudioInCtx[1].HP_Filters[j].oldOut, -32760, 32760));
-        }
-      }
-      CCA02M2_AUDIO_IN_TransferComplete_CallBack(1);
+      DFSDM_Planar_Process(1U);
+      AUDIO_IN_Deliver(1U, 1U);
+    }
+  }
+  else
+  {
+    if ((hdfsdm_filter == &hAudioInDfsdmFilter[POS_VAL(AUDIO_IN_DIGITAL_MIC1)])
+        && (AudioInCtx[1].BitsPerSample != AUDIO_RESOLUTION_16b))
+    {
+      DFSDM_HiRes_Process((AudioInCtx[1].SampleRate / (uint32_t)1000) * AudioInCtx[1].BlockMs);
+      AUDIO_IN_Deliver(1U, 1U);
+    }
+    else if (hdfsdm_filter == &hAudioInDfsdmFilter[POS_VAL(AUDIO_IN_DIGITAL_MIC1)])
+    {
+      DFSDM_Block_Process((AudioInCtx[1].SampleRate / (uint32_t)1000) * AudioInCtx[1].BlockMs);
+      AUDIO_IN_Deliver(1U, 1U);
     }
   }
 }
@@ -2152,34 +2696,116 @@ void HAL_DFSDM_FilterRegConvCpltCallback(DFSDM_Filter_HandleTypeDef *hdfsdm_filt
   */
 void HAL_DFSDM_FilterRegConvHalfCpltCallback(DFSDM_Filter_HandleTypeDef *hdfsdm_filter)
 {
-  uint32_t i, j;
-
   if (AudioInCtx[1].IsMultiBuff == 1U)
   {
     /* Call the record update function to get the first half */
     CCA02M2_AUDIO_IN_HalfTransfer_CallBack(1);
   }
-  else
+  else if (AudioInCtx[1].IsPlanar == 1U)
   {
     if (hdfsdm_filter == &hAudioInDfsdmFilter[POS_VAL(AUDIO_IN_DIGITAL_MIC1)])
     {
-      for (j = 0; j < AudioInCtx[1].ChannelsNbr; j ++)
-      {
-        for (i = 0; i < ((AudioInCtx[1].SampleRate / (uint32_t)1000)* N_MS_PER_INTERRUPT); i++)
-        {
-          AudioInCtx[1].HP_Filters[j].Z = ((MicRecBuff[j][i] / 256) * (int32_t)(AudioInCtx[1].Volume)) / 128;
-          AudioInCtx[1].HP_Filters[j].oldOut = (0xFC * (AudioInCtx[1].HP_Filters[j].oldOut + AudioInCtx[1].HP_Filters[j].Z - AudioInCtx[1].HP_Filters[j].oldIn)) / 256;
-          AudioInCtx[1].HP_Filters[j].oldIn = AudioInCtx[1].HP_Filters[j].Z;
-          AudioInCtx[1].pBuff[(i * AudioInCtx[1].ChannelsNbr) + j] = (uint16_t)(SaturaLH(AudioInCtx[1].HP_Filters[j].oldOut, -32760, 32760));
-        }
-      }
-      CCA02M2_AUDIO_IN_HalfTransfer_CallBack(1);
+      DFSDM_Planar_Process(0U);
+      AUDIO_IN_Deliver(1U, 0U);
+    }
+  }
+  else
+  {
+    if ((hdfsdm_filter == &hAudioInDfsdmFilter[POS_VAL(AUDIO_IN_DIGITAL_MIC1)])
+        && (AudioInCtx[1].BitsPerSample != AUDIO_RESOLUTION_16b))
+    {
+      DFSDM_HiRes_Process(0);
+      AUDIO_IN_Deliver(1U, 0U);
+    }
+    else if (hdfsdm_filter == &hAudioInDfsdmFilter[POS_VAL(AUDIO_IN_DIGITAL_MIC1)])
+    {
+      DFSDM_Block_Process(0);
+      AUDIO_IN_Deliver(1U, 0U);
     }
   }
 }
 
 #endif
 
+#if (USE_HAL_SPI_REGISTER_CALLBACKS == 1U)
+/**
+  * @brief  Rx Transfer completed callback of the raw PDM capture: second half of every plane.
+  * @param  hspi SPI handle
+  * @retval None
+  */
+static void SPI_PdmRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+  UNUSED(hspi);
+  AUDIO_IN_Deliver(2U, 1U);
+}
+
+/**
+  * @brief  Rx Half Transfer completed callback of the raw PDM capture: first half of every plane.
+  * @param  hspi SPI handle
+  * @retval None
+  */
+static void SPI_PdmRxHalfCpltCallback(SPI_HandleTypeDef *hspi)
+{
+  UNUSED(hspi);
+  AUDIO_IN_Deliver(2U, 0U);
+}
+
+/**
+  * @brief  SPI error callback of the raw PDM capture.
+  * @param  hspi SPI handle
+  * @retval None
+  */
+static void SPI_PdmErrorCallback(SPI_HandleTypeDef *hspi)
+{
+  UNUSED(hspi);
+  CCA02M2_AUDIO_IN_Error_CallBack(2);
+}
+#else
+/**
+  * @brief  Rx Transfer completed callback of the raw PDM capture: second half of every plane.
+  * @note   Being __weak it can be overwritten by the application, which then calls AUDIO_IN_Deliver through
+  *         its own SPI callbacks or sets USE_HAL_SPI_REGISTER_CALLBACKS to 1U, the driver then registering
+  *         its callbacks on its SPI handles only
+  * @param  hspi SPI handle
+  * @retval None
+  */
+__weak void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+  if (hspi == &hAudioInPdmSpi[0])
+  {
+    AUDIO_IN_Deliver(2U, 1U);
+  }
+}
+
+/**
+  * @brief  Rx Half Transfer completed callback of the raw PDM capture: first half of every plane.
+  * @note   Being __weak it can be overwritten by the application
+  * @param  hspi SPI handle
+  * @retval None
+  */
+__weak void HAL_SPI_RxHalfCpltCallback(SPI_HandleTypeDef *hspi)
+{
+  if (hspi == &hAudioInPdmSpi[0])
+  {
+    AUDIO_IN_Deliver(2U, 0U);
+  }
+}
+
+/**
+  * @brief  SPI error callback of the raw PDM capture.
+  * @note   Being __weak it can be overwritten by the application
+  * @param  hspi SPI handle
+  * @retval None
+  */
+__weak void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+  if (hspi == &hAudioInPdmSpi[0])
+  {
+    CCA02M2_AUDIO_IN_Error_CallBack(2);
+  }
+}
+#endif /* (USE_HAL_SPI_REGISTER_CALLBACKS == 1U) */
+
 #else
 
 #ifdef USE_STM32WBXX_NUCLEO
@@ -2487,6 +3113,524 @@ __weak void CCA02M2_AUDIO_IN_Error_CallBack(uint32_t Instance)
 /*******************************************************************************
 Static Functions
   *******************************************************************************/
+#ifdef USE_STM32L4XX_NUCLEO
+/**
+  * @brief  16-bit conversion of one DFSDM result: gain (128 is unity), high pass filter and saturation.
+  * @param  Sample  DFSDM result
+  * @param  Volume  Gain
+  * @param  pIn     Filter input state, the last gain output
+  * @param  pOut    Filter output state
+  * @retval 16-bit sample
+  */
+__STATIC_INLINE int16_t DFSDM_HP_Step(int32_t Sample, int32_t Volume, int32_t *pIn, int32_t *pOut)
+{
+  int32_t z = ((Sample / 256) * Volume) / 128;
+
+  *pOut = (0xFC * (*pOut + z - *pIn)) / 256;
+  *pIn = z;
+  return (int16_t)SaturaLH(*pOut, -32760, 32760);
+}
+
+/**
+  * @brief  24-bit conversion of one DFSDM result: gain (64 is unity), high pass filter and saturation.
+  * @param  Sample  DFSDM result
+  * @param  Volume  Gain
+  * @param  pIn     Filter input state, the last gain output
+  * @param  pOut    Filter output state
+  * @retval 24-bit sample
+  */
+__STATIC_INLINE int32_t DFSDM_HiRes_Step(int32_t Sample, int32_t Volume, int32_t *pIn, int32_t *pOut)
+{
+  int32_t z = ((Sample / 256) * Volume) / 64;
+  /* 0xFC / 256 pole, without the 32-bit overflow of the multiplication on 24-bit samples */
+  int32_t sum = *pOut + z - *pIn;
+
+  *pOut = sum - (sum / 64);
+  *pIn = z;
+  return SaturaLH(*pOut, -8388608, 8388607);
+}
+
+/**
+  * @brief  16-bit conversion of one block of DFSDM results: gain (128 is unity), high pass filter, saturation
+  *         and interleave into the record buffer. The channels are filtered in pairs with the filter states in
+  *         registers, the two samples of a pair are written with one word store.
+  * @param  Offset  First sample of the block in MicRecBuff
+  * @retval None
+  */
+static void DFSDM_Block_Process(uint32_t Offset)
+{
+  uint32_t i, j;
+  uint32_t samples = (AudioInCtx[1].SampleRate / (uint32_t)1000) * AudioInCtx[1].BlockMs;
+  uint32_t channels = AudioInCtx[1].ChannelsNbr;
+  int32_t volume = (int32_t)AudioInCtx[1].Volume;
+  const int32_t *pIn0, *pIn1;
+  uint16_t *pOut;
+  int32_t in0, out0;
+  int32_t in1, out1;
+  uint32_t pair;
+
+  for (j = 0; j < channels; j += 2U)
+  {
+    pIn0 = &MicRecBuff[j][Offset];
+    pOut = &AudioInCtx[1].pBuff[j];
+    in0 = AudioInCtx[1].HP_Filters[j].oldIn;
+    out0 = AudioInCtx[1].HP_Filters[j].oldOut;
+
+    if ((j + 1U) < channels)
+    {
+      pIn1 = &MicRecBuff[j + 1U][Offset];
+      in1 = AudioInCtx[1].HP_Filters[j + 1U].oldIn;
+      out1 = AudioInCtx[1].HP_Filters[j + 1U].oldOut;
+
+      for (i = 0; i < samples; i++)
+      {
+        pair = (uint16_t)DFSDM_HP_Step(pIn0[i], volume, &in0, &out0);
+        pair |= (uint32_t)(uint16_t)DFSDM_HP_Step(pIn1[i], volume, &in1, &out1) << 16;
+        (void)memcpy(pOut, &pair, 4U);
+        pOut = &pOut[channels];
+      }
+
+      AudioInCtx[1].HP_Filters[j + 1U].Z = in1;
+      AudioInCtx[1].HP_Filters[j + 1U].oldOut = out1;
+      AudioInCtx[1].HP_Filters[j + 1U].oldIn = in1;
+    }
+    else
+    {
+      for (i = 0; i < samples; i++)
+      {
+        *pOut = (uint16_t)DFSDM_HP_Step(pIn0[i], volume, &in0, &out0);
+        pOut = &pOut[channels];
+      }
+    }
+
+    AudioInCtx[1].HP_Filters[j].Z = in0;
+    AudioInCtx[1].HP_Filters[j].oldOut = out0;
+    AudioInCtx[1].HP_Filters[j].oldIn = in0;
+  }
+}
+
+/**
+  * @brief  Starts the DMA of the DFSDM filters of the recording as one group. The filters after the first one
+  *         wait for its software trigger (DFSDM_FILTER_SYNC_TRIGGER), so they are armed first and all of them
+  *         convert the same samples. Only the DMA of the first filter interrupts, for the whole group: it has
+  *         the lowest priority, so each of its transfers comes after the ones of the same sample.
+  * @param  Length  Samples of each circular DMA buffer, two blocks
+  * @retval BSP status
+  */
+static int32_t DFSDM_Group_Start(uint32_t Length)
+{
+  int32_t counter;
+
+  if ((Length > MicRecLength) || (AudioInCtx[1].ChannelsNbr == 0U) || (AudioInCtx[1].ChannelsNbr > 4U)
+      || (MicRecBuff[AudioInCtx[1].ChannelsNbr - 1U] == NULL))
+  {
+    return BSP_ERROR_WRONG_PARAM;
+  }
+  for (counter = (int32_t)(AudioInCtx[1].ChannelsNbr); counter > 0; counter --)
+  {
+    if (HAL_DFSDM_FilterRegularStart_DMA(&hAudioInDfsdmFilter[counter - 1], MicRecBuff[counter - 1], Length) != HAL_OK)
+    {
+      return BSP_ERROR_PERIPH_FAILURE;
+    }
+    if (counter > 1)
+    {
+      __HAL_DMA_DISABLE_IT(hAudioInDfsdmFilter[counter - 1].hdmaReg, DMA_IT_HT | DMA_IT_TC);
+    }
+  }
+  DfsdmDmaLength = Length;
+  AudioInNextHalf[1] = 0;
+  DfsdmSkewSamples = 0;
+  return BSP_ERROR_NONE;
+}
+
+/**
+  * @brief  Reports a block of a circular recording to the transfer callback of the application and keeps the
+  *         counters of the instance. A block that the DMA is already overwriting when its interrupt is served is
+  *         counted as missed and not reported; the HAL serves a pending half transfer before a pending transfer
+  *         complete, so this is the older of two blocks served together. The halves must otherwise alternate,
+  *         else one was lost without an interrupt of its own, and the DMA must still be writing the other half
+  *         when the callback returns, otherwise the block was consumed late. A callback longer than one and a
+  *         half blocks is still counted but can shift the sample time by a buffer.
+  * @param  Instance  AUDIO IN Instance: 1 (DFSDM group) or 2 (raw PDM)
+  * @param  Half      Half of the buffer holding the block: 0 or 1
+  * @retval None
+  */
+static void AUDIO_IN_Deliver(uint32_t Instance, uint32_t Half)
+{
+  DMA_HandleTypeDef *hdma;
+  uint32_t length;
+  uint32_t samples;
+  uint32_t written;
+
+  if (Instance == 1U)
+  {
+    hdma = hAudioInDfsdmFilter[0].hdmaReg;
+    length = DfsdmDmaLength;
+    samples = length / 2U;
+  }
+  else
+  {
+    /* 16-bit words per plane, 16 PDM bits each */
+    hdma = hAudioInPdmSpi[0].hdmarx;
+    length = AudioInCtx[2].Size / AudioInCtx[2].ChannelsNbr / 2U;
+    samples = (length / 2U) * 16U;
+  }
+
+  if (AudioInBusy[Instance] != 0U)
+  {
+    AudioInCounters[Instance].Reentries++;
+  }
+  written = length - __HAL_DMA_GET_COUNTER(hdma);
+  if (((written < (length / 2U)) ? 0U : 1U) == Half)
+  {
+    /* Out of order, it was already counted when the newer block was reported */
+    if (Half == AudioInNextHalf[Instance])
+    {
+      AudioInCounters[Instance].MissedBlocks++;
+      AudioInSampleNext[Instance] += samples;
+      AudioInNextHalf[Instance] = Half ^ 1U;
+    }
+    return;
+  }
+  if (Half != AudioInNextHalf[Instance])
+  {
+    AudioInCounters[Instance].MissedBlocks++;
+    AudioInSampleNext[Instance] += samples;
+  }
+  AudioInNextHalf[Instance] = Half ^ 1U;
+  AudioInCounters[Instance].SampleTime = AudioInSampleNext[Instance];
+  AudioInCounters[Instance].Blocks++;
+  AudioInSampleNext[Instance] += samples;
+  if ((Instance == 1U) && (AudioInCtx[1].IsPlanar == 1U))
+  {
+    PlanarBlock.SampleTime = AudioInCounters[1].SampleTime;
+  }
+
+  AudioInBusy[Instance]++;
+  if (Half == 0U)
+  {
+    CCA02M2_AUDIO_IN_HalfTransfer_CallBack(Instance);
+  }
+  else
+  {
+    CCA02M2_AUDIO_IN_TransferComplete_CallBack(Instance);
+  }
+  AudioInBusy[Instance]--;
+
+  written = length - __HAL_DMA_GET_COUNTER(hdma);
+  if (((written < (length / 2U)) ? 0U : 1U) == Half)
+  {
+    AudioInCounters[Instance].LateBlocks++;
+  }
+}
+
+/**
+  * @brief  Clears the sample time and the overrun counters at the start of a recording.
+  * @param  Instance  AUDIO IN Instance: 1 (DFSDM group) or 2 (raw PDM)
+  * @retval None
+  */
+static void AUDIO_IN_Counters_Reset(uint32_t Instance)
+{
+  (void)memset(&AudioInCounters[Instance], 0, sizeof(CCA02M2_AUDIO_IN_Counters_t));
+  AudioInSampleNext[Instance] = 0;
+  AudioInNextHalf[Instance] = 0;
+  AudioInBusy[Instance] = 0;
+}
+
+/**
+  * @brief  Planar 16-bit conversion of one block of DFSDM results into the planes of the application: the
+  *         processing of DFSDM_Block_Process without interleave, two samples of a plane per word store. The
+  *         block is then reported by CCA02M2_AUDIO_IN_GetBlock.
+  * @param  Half  Half of the DMA buffers and of the planes: 0 or 1
+  * @retval None
+  */
+static void DFSDM_Planar_Process(uint32_t Half)
+{
+  uint32_t i, j;
+  uint32_t timestamp = DWT->CYCCNT;
+  uint32_t samples = (AudioInCtx[1].SampleRate / (uint32_t)1000) * AudioInCtx[1].BlockMs;
+  int32_t volume = (int32_t)AudioInCtx[1].Volume;
+  const int32_t *pIn;
+  int16_t *pOut;
+  int32_t in, out;
+  uint32_t pair;
+
+  for (j = 0; j < AudioInCtx[1].ChannelsNbr; j++)
+  {
+    pIn = &MicRecBuff[j][Half * samples];
+    pOut = &PlanarBuff[j][Half * samples];
+    in = AudioInCtx[1].HP_Filters[j].oldIn;
+    out = AudioInCtx[1].HP_Filters[j].oldOut;
+
+    for (i = 0; (i + 1U) < samples; i += 2U)
+    {
+      pair = (uint16_t)DFSDM_HP_Step(pIn[i], volume, &in, &out);
+      pair |= (uint32_t)(uint16_t)DFSDM_HP_Step(pIn[i + 1U], volume, &in, &out) << 16;
+      (void)memcpy(&pOut[i], &pair, 4U);
+    }
+    if (i < samples)
+    {
+      pOut[i] = DFSDM_HP_Step(pIn[i], volume, &in, &out);
+    }
+
+    AudioInCtx[1].HP_Filters[j].Z = in;
+    AudioInCtx[1].HP_Filters[j].oldOut = out;
+    AudioInCtx[1].HP_Filters[j].oldIn = in;
+    PlanarBlock.pPlane[j] = pOut;
+  }
+
+  PlanarBlock.Channels = AudioInCtx[1].ChannelsNbr;
+  PlanarBlock.Samples = samples;
+  PlanarBlock.Sequence = PlanarSequence;
+  /* The same half is written again at the end of the block after next */
+  PlanarBlock.ReleaseSequence = PlanarSequence + 2U;
+  PlanarBlock.Timestamp = timestamp;
+  PlanarSequence++;
+}
+
+/**
+  * @brief  24 and 32-bit conversion of one block of DFSDM results: gain (64 is unity), high pass filter,
+  *         saturation to 24 bits and interleave into the record buffer. One pass per channel with the filter
+  *         states in registers; the samples are stored left-justified in 32 bits, or as their 3 low bytes for
+  *         AUDIO_RESOLUTION_24b.
+  * @note   The 16-bit output of the same input is the 24-bit value divided by 16 at the same volume.
+  * @param  Offset  First sample of the block in MicRecBuff
+  * @retval None
+  */
+static void DFSDM_HiRes_Process(uint32_t Offset)
+{
+  uint32_t i, j;
+  uint32_t samples = (AudioInCtx[1].SampleRate / (uint32_t)1000) * AudioInCtx[1].BlockMs;
+  uint32_t channels = AudioInCtx[1].ChannelsNbr;
+  int32_t volume = (int32_t)AudioInCtx[1].Volume;
+  const int32_t *pIn;
+  uint8_t *pOut24;
+  int32_t *pOut32;
+  int32_t in, out;
+  uint32_t sample;
+
+  for (j = 0; j < channels; j ++)
+  {
+    pIn = &MicRecBuff[j][Offset];
+    in = AudioInCtx[1].HP_Filters[j].oldIn;
+    out = AudioInCtx[1].HP_Filters[j].oldOut;
+
+    if (AudioInCtx[1].BitsPerSample == AUDIO_RESOLUTION_24b)
+    {
+      pOut24 = &((uint8_t *)AudioInCtx[1].pBuff)[3U * j];
+      for (i = 0; i < samples; i++)
+      {
+        sample = (uint32_t)DFSDM_HiRes_Step(pIn[i], volume, &in, &out);
+        pOut24[0] = (uint8_t)sample;
+        pOut24[1] = (uint8_t)(sample >> 8);
+        pOut24[2] = (uint8_t)(sample >> 16);
+        pOut24 = &pOut24[3U * channels];
+      }
+    }
+    else
+    {
+      pOut32 = &((int32_t *)AudioInCtx[1].pBuff)[j];
+      for (i = 0; i < samples; i++)
+      {
+        sample = (uint32_t)DFSDM_HiRes_Step(pIn[i], volume, &in, &out);
+        *pOut32 = (int32_t)(sample << 8);
+        pOut32 = &pOut32[channels];
+      }
+    }
+
+    AudioInCtx[1].HP_Filters[j].Z = in;
+    AudioInCtx[1].HP_Filters[j].oldOut = out;
+    AudioInCtx[1].HP_Filters[j].oldIn = in;
+  }
+}
+
+/**
+  * @brief  Adds the span of samples of the skew self-test to the correlation of the microphones with the first
+  *         one, on the first differences of the samples: the DC offset of the DFSDM results cancels and the
+  *         peak is sharper than on the low frequencies that dominate the sound.
+  * @param  Channels  Microphones of the span
+  * @param  Span      Samples of each microphone in DfsdmSkewSpan
+  * @param  Lag       Lags of -Lag to Lag samples are correlated, the span giving Span - 2 * Lag - 1 products each
+  * @retval None
+  */
+static void DFSDM_Skew_Accumulate(uint32_t Channels, uint32_t Span, uint32_t Lag)
+{
+  uint32_t i, j, l;
+  float ref;
+  float energy;
+  float corr;
+
+  for (j = 0; j < Channels; j++)
+  {
+    energy = 0.0f;
+    for (i = Lag + 1U; i < (Span - Lag); i++)
+    {
+      corr = (float)(DfsdmSkewSpan[j][i] - DfsdmSkewSpan[j][i - 1U]);
+      energy += corr * corr;
+    }
+    DfsdmSkewEnergy[j] += energy;
+  }
+
+  for (j = 1; j < Channels; j++)
+  {
+    for (l = 0; l < ((2U * Lag) + 1U); l++)
+    {
+      corr = 0.0f;
+      for (i = Lag + 1U; i < (Span - Lag); i++)
+      {
+        ref = (float)(DfsdmSkewSpan[0][i] - DfsdmSkewSpan[0][i - 1U]);
+        corr += ref * (float)(DfsdmSkewSpan[j][(i + l) - Lag] - DfsdmSkewSpan[j][(i + l) - Lag - 1U]);
+      }
+      DfsdmSkewCorr[j - 1U][l] += corr;
+    }
+  }
+}
+
+/**
+  * @brief  Raw PDM capture set up: the DFSDM channel of MIC1 drives CKOUT at the PDM clock, without filters,
+  *         and one SPI slave per microphone samples the MIC1/MIC2 line on the edge of its microphone.
+  * @param  PdmClock  PDM clock in Hz, rounded to a divider of the DFSDM audio clock
+  * @param  Mics      Microphones of the line: 1 (MIC1) or 2
+  * @retval BSP status
+  */
+static int32_t AUDIO_IN_PDM_Init(uint32_t PdmClock, uint32_t Mics)
+{
+  SPI_TypeDef *SpiInstance[2] = {AUDIO_IN_PDM_SPI_M1_INSTANCE, AUDIO_IN_PDM_SPI_M2_INSTANCE};
+  uint32_t SpiPhase[2] = {SPI_PHASE_1EDGE, SPI_PHASE_2EDGE};
+  uint32_t divider;
+  uint32_t mic;
+
+  /* Same audio clock as the PCM path */
+  if (MX_DFSDM1_ClockConfig(&hAudioInDfsdmChannel[0], AUDIO_FREQUENCY_16K) != HAL_OK)
+  {
+    return BSP_ERROR_CLOCK_FAILURE;
+  }
+  divider = (HAL_RCCEx_GetPeriphCLKFreq(RCC_PERIPHCLK_SAI1) + (PdmClock / 2U)) / PdmClock;
+  if ((divider < 2U) || (divider > 256U))
+  {
+    return BSP_ERROR_WRONG_PARAM;
+  }
+
+  DFSDM_ChannelMspInit(&hAudioInDfsdmChannel[0]);
+
+  __HAL_DFSDM_CHANNEL_RESET_HANDLE_STATE(&hAudioInDfsdmChannel[0]);
+  hAudioInDfsdmChannel[0].Instance                      = AUDIO_DFSDMx_MIC1_CHANNEL;
+  hAudioInDfsdmChannel[0].Init.OutputClock.Activation   = ENABLE;
+  hAudioInDfsdmChannel[0].Init.OutputClock.Selection    = DFSDM_CHANNEL_OUTPUT_CLOCK_AUDIO;
+  hAudioInDfsdmChannel[0].Init.OutputClock.Divider      = divider;
+  hAudioInDfsdmChannel[0].Init.Input.Multiplexer        = DFSDM_CHANNEL_EXTERNAL_INPUTS;
+  hAudioInDfsdmChannel[0].Init.Input.DataPacking        = DFSDM_CHANNEL_STANDARD_MODE;
+  hAudioInDfsdmChannel[0].Init.Input.Pins               = DFSDM_CHANNEL_SAME_CHANNEL_PINS;
+  hAudioInDfsdmChannel[0].Init.SerialInterface.Type     = DFSDM_CHANNEL_SPI_RISING;
+  hAudioInDfsdmChannel[0].Init.SerialInterface.SpiClock = DFSDM_CHANNEL_SPI_CLOCK_INTERNAL;
+  hAudioInDfsdmChannel[0].Init.Awd.FilterOrder          = DFSDM_CHANNEL_SINC1_ORDER;
+  hAudioInDfsdmChannel[0].Init.Awd.Oversampling         = 10;
+  hAudioInDfsdmChannel[0].Init.Offset                   = 0;
+  hAudioInDfsdmChannel[0].Init.RightBitShift            = 0;
+  if (HAL_DFSDM_ChannelInit(&hAudioInDfsdmChannel[0]) != HAL_OK)
+  {
+    return BSP_ERROR_PERIPH_FAILURE;
+  }
+
+  for (mic = 0; mic < Mics; mic++)
+  {
+    /* Takes the data line over from the DFSDM */
+    AUDIO_IN_PDM_MspInit(mic);
+
+    hAudioInPdmSpi[mic].Instance               = SpiInstance[mic];
+    hAudioInPdmSpi[mic].Init.Mode              = SPI_MODE_SLAVE;
+    hAudioInPdmSpi[mic].Init.Direction         = SPI_DIRECTION_1LINE;
+    hAudioInPdmSpi[mic].Init.DataSize          = SPI_DATASIZE_16BIT;
+    hAudioInPdmSpi[mic].Init.CLKPolarity       = SPI_POLARITY_LOW;
+    hAudioInPdmSpi[mic].Init.CLKPhase          = SpiPhase[mic];
+    hAudioInPdmSpi[mic].Init.NSS               = SPI_NSS_SOFT;
+    hAudioInPdmSpi[mic].Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_2;
+    hAudioInPdmSpi[mic].Init.FirstBit          = SPI_FIRSTBIT_MSB;
+    hAudioInPdmSpi[mic].Init.TIMode            = SPI_TIMODE_DISABLE;
+    hAudioInPdmSpi[mic].Init.CRCCalculation    = SPI_CRCCALCULATION_DISABLE;
+    hAudioInPdmSpi[mic].Init.CRCPolynomial     = 7;
+    hAudioInPdmSpi[mic].Init.CRCLength         = SPI_CRC_LENGTH_DATASIZE;
+    hAudioInPdmSpi[mic].Init.NSSPMode          = SPI_NSS_PULSE_DISABLE;
+    if (HAL_SPI_Init(&hAudioInPdmSpi[mic]) != HAL_OK)
+    {
+      return BSP_ERROR_PERIPH_FAILURE;
+    }
+  }
+
+#if (USE_HAL_SPI_REGISTER_CALLBACKS == 1U)
+  /* Only the DMA of the first microphone raises interrupts */
+  if ((HAL_SPI_RegisterCallback(&hAudioInPdmSpi[0], HAL_SPI_RX_COMPLETE_CB_ID, SPI_PdmRxCpltCallback) != HAL_OK) ||
+      (HAL_SPI_RegisterCallback(&hAudioInPdmSpi[0], HAL_SPI_RX_HALF_COMPLETE_CB_ID, SPI_PdmRxHalfCpltCallback) != HAL_OK) ||
+      (HAL_SPI_RegisterCallback(&hAudioInPdmSpi[0], HAL_SPI_ERROR_CB_ID, SPI_PdmErrorCallback) != HAL_OK))
+  {
+    return BSP_ERROR_PERIPH_FAILURE;
+  }
+#endif /* (USE_HAL_SPI_REGISTER_CALLBACKS == 1U) */
+  return BSP_ERROR_NONE;
+}
+
+/**
+  * @brief  Raw PDM capture MSP: pins, clock and circular DMA of the SPI of one microphone. Only the DMA of
+  *         the first microphone raises interrupts, the others run on the same clock.
+  * @param  Mic  0 for MIC1, 1 for MIC2
+  * @retval None
+  */
+static void AUDIO_IN_PDM_MspInit(uint32_t Mic)
+{
+  GPIO_InitTypeDef  GPIO_InitStruct;
+
+  GPIO_InitStruct.Mode  = GPIO_MODE_AF_PP;
+  GPIO_InitStruct.Pull  = GPIO_NOPULL;
+  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+
+  AUDIO_IN_PDM_DMAx_CLK_ENABLE();
+
+  if (Mic == 0U)
+  {
+    AUDIO_IN_PDM_SPI_M1_CLK_ENABLE();
+    AUDIO_IN_PDM_SPI_M1_GPIO_CLK_ENABLE();
+    GPIO_InitStruct.Alternate = AUDIO_IN_PDM_SPI_M1_AF;
+    GPIO_InitStruct.Pin = AUDIO_IN_PDM_SPI_M1_SCK_PIN;
+    HAL_GPIO_Init(AUDIO_IN_PDM_SPI_M1_SCK_GPIO_PORT, &GPIO_InitStruct);
+    GPIO_InitStruct.Pin = AUDIO_IN_PDM_SPI_M1_SD_PIN;
+    HAL_GPIO_Init(AUDIO_IN_PDM_SPI_M1_SD_GPIO_PORT, &GPIO_InitStruct);
+
+    hDmaPdmSpi[Mic].Instance          = AUDIO_IN_PDM_SPI_M1_DMAx_STREAM;
+    hDmaPdmSpi[Mic].Init.Request      = AUDIO_IN_PDM_SPI_M1_DMAx_REQUEST;
+  }
+  else
+  {
+    AUDIO_IN_PDM_SPI_M2_CLK_ENABLE();
+    AUDIO_IN_PDM_SPI_M2_GPIO_CLK_ENABLE();
+    GPIO_InitStruct.Alternate = AUDIO_IN_PDM_SPI_M2_AF;
+    GPIO_InitStruct.Pin = AUDIO_IN_PDM_SPI_M2_SCK_PIN;
+    HAL_GPIO_Init(AUDIO_IN_PDM_SPI_M2_SCK_GPIO_PORT, &GPIO_InitStruct);
+    GPIO_InitStruct.Pin = AUDIO_IN_PDM_SPI_M2_SD_PIN;
+    HAL_GPIO_Init(AUDIO_IN_PDM_SPI_M2_SD_GPIO_PORT, &GPIO_InitStruct);
+
+    hDmaPdmSpi[Mic].Instance          = AUDIO_IN_PDM_SPI_M2_DMAx_STREAM;
+    hDmaPdmSpi[Mic].Init.Request      = AUDIO_IN_PDM_SPI_M2_DMAx_REQUEST;
+  }
+
+  hDmaPdmSpi[Mic].Init.Direction           = DMA_PERIPH_TO_MEMORY;
+  hDmaPdmSpi[Mic].Init.PeriphInc           = DMA_PINC_DISABLE;
+  hDmaPdmSpi[Mic].Init.MemInc              = DMA_MINC_ENABLE;
+  hDmaPdmSpi[Mic].Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+  hDmaPdmSpi[Mic].Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+  hDmaPdmSpi[Mic].Init.Mode                = DMA_CIRCULAR;
+  hDmaPdmSpi[Mic].Init.Priority            = DMA_PRIORITY_HIGH;
+  __HAL_DMA_RESET_HANDLE_STATE(&hDmaPdmSpi[Mic]);
+  (void)HAL_DMA_Init(&hDmaPdmSpi[Mic]);
+  __HAL_LINKDMA(&hAudioInPdmSpi[Mic], hdmarx, hDmaPdmSpi[Mic]);
+
+  if (Mic == 0U)
+  {
+    HAL_NVIC_SetPriority(AUDIO_IN_PDM_SPI_M1_DMAx_IRQ, CCA02M2_AUDIO_IN_IT_PRIORITY, CCA02M2_AUDIO_IN_IT_PRIORITY);
+    HAL_NVIC_EnableIRQ(AUDIO_IN_PDM_SPI_M1_DMAx_IRQ);
+  }
+}
+#endif /* USE_STM32L4XX_NUCLEO */
+
 #if (USE_HAL_DFSDM_REGISTER_CALLBACKS == 1U)
 /**
   * @brief  Regular conversion complete callback.
@@ -2497,8 +3641,15 @@ using HAL_DFSDM_FilterGetRegularValue.
   */
 static void DFSDM_FilterRegConvCpltCallback(DFSDM_Filter_HandleTypeDef *hdfsdm_filter)
 {
-  uint32_t i, j = 0;
-  uint32_t index;
+  if (AudioInCtx[1].IsPlanar == 1U)
+  {
+    if (hdfsdm_filter == &hAudioInDfsdmFilter[POS_VAL(AUDIO_IN_DIGITAL_MIC1)])
+    {
+      DFSDM_Planar_Process(1U);
+      AUDIO_IN_Deliver(1U, 1U);
+    }
+    return;
+  }
 
   if (AudioInCtx[1].IsMultiBuff == 1U)
   {
@@ -2507,19 +3658,16 @@ static void DFSDM_FilterRegConvCpltCallback(DFSDM_Filter_HandleTypeDef *hdfsdm_f
   }
   else
   {
-    if (hdfsdm_filter == &hAudioInDfsdmFilter[POS_VAL(AUDIO_IN_DIGITAL_MIC1)])
+    if ((hdfsdm_filter == &hAudioInDfsdmFilter[POS_VAL(AUDIO_IN_DIGITAL_MIC1)])
+        && (AudioInCtx[1].BitsPerSample != AUDIO_RESOLUTION_16b))
     {
-      for (j = 0; j < AudioInCtx[1].ChannelsNbr; j ++)
-      {
-        for (i = 0; i < (AudioInCtx[1].SampleRate / 1000); i++)
-        {
-          AudioInCtx[1].HP_Filters[j].Z = ((MicRecBuff[j][i + (AudioInCtx[1].SampleRate / 1000) ] >> 8) * AudioInCtx[1].Volume) >> 7;
-          AudioInCtx[1].HP_Filters[j].oldOut = (0xFC * (AudioInCtx[1].HP_Filters[j].oldOut + AudioInCtx[1].HP_Filters[j].Z - AudioInCtx[1].HP_Filters[j].oldIn)) / 256;
-          AudioInCtx[1].HP_Filters[j].oldIn = AudioInCtx[1].HP_Filters[j].Z;
-          AudioInCtx[1].pBuff[i * AudioInCtx[1].ChannelsNbr + j] = SaturaLH(AudioInCtx[1].HP_Filters[j].oldOut, -32760, 32760);
-          RecBuffTrigger += 1U;
-        }
-      }
+      DFSDM_HiRes_Process(AudioInCtx[1].SampleRate / 1000);
+      RecBuffTrigger += (AudioInCtx[1].SampleRate / 1000) * AudioInCtx[1].ChannelsNbr;
+    }
+    else if (hdfsdm_filter == &hAudioInDfsdmFilter[POS_VAL(AUDIO_IN_DIGITAL_MIC1)])
+    {
+      DFSDM_Block_Process(AudioInCtx[1].SampleRate / 1000);
+      RecBuffTrigger += (AudioInCtx[1].SampleRate / 1000) * AudioInCtx[1].ChannelsNbr;
     }
     /* Call Half Transfer Complete callback */
     if (RecBuffTrigger == (AudioInCtx[1].Size / 2U))
@@ -2549,27 +3697,31 @@ static void DFSDM_FilterRegConvCpltCallback(DFSDM_Filter_HandleTypeDef *hdfsdm_f
   */
 static void DFSDM_FilterRegConvHalfCpltCallback(DFSDM_Filter_HandleTypeDef *hdfsdm_filter)
 {
-  uint32_t i, j = 0;
-  uint32_t index;
+  if (AudioInCtx[1].IsPlanar == 1U)
+  {
+    if (hdfsdm_filter == &hAudioInDfsdmFilter[POS_VAL(AUDIO_IN_DIGITAL_MIC1)])
+    {
+      DFSDM_Planar_Process(0U);
+      AUDIO_IN_Deliver(1U, 0U);
+    }
+    return;
+  }
 
   if (AudioInCtx[1].IsMultiBuff == 1U)
   {
     /* Call the record update function to get the first half */
     CCA02M2_AUDIO_IN_HalfTransfer_CallBack(1);
   }
+  else if ((hdfsdm_filter == &hAudioInDfsdmFilter[POS_VAL(AUDIO_IN_DIGITAL_MIC1)])
+           && (AudioInCtx[1].BitsPerSample != AUDIO_RESOLUTION_16b))
+  {
+    DFSDM_HiRes_Process(0);
+    RecBuffTrigger += (AudioInCtx[1].SampleRate / 1000) * AudioInCtx[1].ChannelsNbr;
+  }
   else if (hdfsdm_filter == &hAudioInDfsdmFilter[POS_VAL(AUDIO_IN_DIGITAL_MIC1)])
   {
-    for (j = 0; j < AudioInCtx[1].ChannelsNbr; j ++)
-    {
-      for (i = 0; i < (AudioInCtx[1].SampleRate / 1000); i++)
-      {
-        AudioInCtx[1].HP_Filters[j].Z = ((MicRecBuff[j][i] >> 8) * AudioInCtx[1].Volume) >> 7;
-        AudioInCtx[1].HP_Filters[j].oldOut = (0xFC * (AudioInCtx[1].HP_Filters[j].oldOut + AudioInCtx[1].HP_Filters[j].Z - AudioInCtx[1].HP_Filters[j].oldIn)) / 256;
-        AudioInCtx[1].HP_Filters[j].oldIn = AudioInCtx[1].HP_Filters[j].Z;
-        AudioInCtx[1].pBuff[i * AudioInCtx[1].ChannelsNbr + j] = SaturaLH(AudioInCtx[1].HP_Filters[j].oldOut, -32760, 32760);
-        RecBuffTrigger += 1U;
-      }
-    }
+    DFSDM_Block_Process(0);
+    RecBuffTrigger += (AudioInCtx[1].SampleRate / 1000) * AudioInCtx[1].ChannelsNbr;
   }
   /* Call Half Transfer Complete callback */
   if (RecBuffTrigger == (AudioInCtx[1].Size / 2U))
@@ -2722,7 +3874,9 @@ static void DFSDM_FilterMspInit(DFSDM_Filter_HandleTypeDef *hDfsdmFilter)
     hDmaDfsdm[mic_num].Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
     hDmaDfsdm[mic_num].Init.MemDataAlignment    = DMA_MDATAALIGN_WORD;
     hDmaDfsdm[mic_num].Init.Mode                = DMA_CIRCULAR;
-    hDmaDfsdm[mic_num].Init.Priority            = DMA_PRIORITY_HIGH;
+    /* MIC1 interrupts for the group: its transfers come last, after the ones of the same sample */
+    hDmaDfsdm[mic_num].Init.Priority            = (mic_num == POS_VAL(AUDIO_IN_DIGITAL_MIC1)) ? DMA_PRIORITY_HIGH :
+                                                  DMA_PRIORITY_VERY_HIGH;
     hDmaDfsdm[mic_num].State                    = HAL_DMA_STATE_RESET;
 
     /* Associate the DMA handle */
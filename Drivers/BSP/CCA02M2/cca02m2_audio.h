@@ -85,6 +85,9 @@ typedef struct
   uint32_t BitsPerSample;
   uint32_t ChannelsNbr;
   uint32_t Volume;
+  uint32_t BlockMs;             /* ms of each DMA block, 1 to AUDIO_IN_MAX_BLOCK_MS, 0 for N_MS_PER_INTERRUPT */
+  int32_t  *pArena;             /* DFSDM buffers, CCA02M2_AUDIO_IN_ARENA_SIZE bytes, NULL for the driver ones */
+  uint32_t ArenaSize;           /* Size of pArena in bytes */
 } CCA02M2_AUDIO_Init_t;
 
 typedef struct
@@ -100,11 +103,37 @@ typedef struct
   uint32_t Volume;              /* Audio IN volume                */
   uint32_t State;               /* Audio IN State                 */
   uint32_t IsMultiBuff;         /* Audio IN multi-buffer usage    */
+  uint32_t IsPlanar;            /* Audio IN planar 16-bit capture */
   uint32_t IsMspCallbacksValid; /* Is Msp Callbacks registred     */
   HP_FilterState_TypeDef HP_Filters[4]; /*!< HP filter state for each channel*/
   uint32_t DecimationFactor;
+  uint32_t BlockMs;             /* Audio IN ms per DMA block      */
+  int32_t  *pArena;             /* Audio IN DFSDM buffers         */
+  uint32_t ArenaSize;           /* Audio IN DFSDM buffers size    */
 } AUDIO_IN_Ctx_t;
 
+/* Block of the planar capture, reported to the transfer callbacks by CCA02M2_AUDIO_IN_GetBlock */
+typedef struct
+{
+  int16_t  *pPlane[4];          /* Samples of each channel, pPlane[0] is MIC1 */
+  uint32_t Channels;            /* Planes of the block            */
+  uint32_t Samples;             /* Samples of each plane          */
+  uint32_t Sequence;            /* Block number since the start of the recording */
+  uint32_t ReleaseSequence;     /* The planes are overwritten when this block is complete */
+  uint32_t Timestamp;           /* DWT cycle counter at the end of the block, when enabled */
+  uint64_t SampleTime;          /* First sample of the block, counted since the start of the recording */
+} CCA02M2_AUDIO_IN_Block_t;
+
+/* Sample time and overrun counters of a recording, read with CCA02M2_AUDIO_IN_GetCounters */
+typedef struct
+{
+  uint64_t SampleTime;          /* First sample of the last block reported, PDM bits for the raw PDM capture */
+  uint32_t Blocks;              /* Blocks reported to the transfer callbacks */
+  uint32_t Reentries;           /* Callbacks entered while the previous one was running */
+  uint32_t LateBlocks;          /* Blocks still processed when the DMA wrote into them again */
+  uint32_t MissedBlocks;        /* Blocks overwritten before their interrupt was served */
+} CCA02M2_AUDIO_IN_Counters_t;
+
 typedef struct
 {
   uint32_t Mode;
@@ -354,6 +383,33 @@ typedef struct
 #define AUDIO_DFSDMx_DMAx_MEM_DATA_SIZE    DMA_MDATAALIGN_WORD
 #define AUDIO_DFSDMx_DMAx_CLK_ENABLE()     __HAL_RCC_DMA1_CLK_ENABLE()
 
+/* Raw PDM capture (instance 2): the DFSDM only drives the microphone clock on CKOUT, the MIC1/MIC2
+   bitstream is sampled by two SPI slaves, MIC1 on the rising edge and MIC2 on the falling edge.
+   Wiring on the morpho connectors: PC2 (CKOUT) to PB13 and PC10, PB14 (DATIN of MIC1/MIC2) to PC11 */
+#define AUDIO_IN_PDM_SPI_M1_INSTANCE       SPI2
+#define AUDIO_IN_PDM_SPI_M1_CLK_ENABLE()   __HAL_RCC_SPI2_CLK_ENABLE()
+#define AUDIO_IN_PDM_SPI_M1_SCK_PIN        GPIO_PIN_13
+#define AUDIO_IN_PDM_SPI_M1_SCK_GPIO_PORT  GPIOB
+#define AUDIO_IN_PDM_SPI_M1_SD_PIN         GPIO_PIN_14
+#define AUDIO_IN_PDM_SPI_M1_SD_GPIO_PORT   GPIOB
+#define AUDIO_IN_PDM_SPI_M1_AF             GPIO_AF5_SPI2
+#define AUDIO_IN_PDM_SPI_M1_GPIO_CLK_ENABLE() __HAL_RCC_GPIOB_CLK_ENABLE()
+#define AUDIO_IN_PDM_SPI_M1_DMAx_STREAM    DMA1_Channel4
+#define AUDIO_IN_PDM_SPI_M1_DMAx_REQUEST   DMA_REQUEST_1
+#define AUDIO_IN_PDM_SPI_M1_DMAx_IRQ       DMA1_Channel4_IRQn
+
+#define AUDIO_IN_PDM_SPI_M2_INSTANCE       SPI3
+#define AUDIO_IN_PDM_SPI_M2_CLK_ENABLE()   __HAL_RCC_SPI3_CLK_ENABLE()
+#define AUDIO_IN_PDM_SPI_M2_SCK_PIN        GPIO_PIN_10
+#define AUDIO_IN_PDM_SPI_M2_SCK_GPIO_PORT  GPIOC
+#define AUDIO_IN_PDM_SPI_M2_SD_PIN         GPIO_PIN_11
+#define AUDIO_IN_PDM_SPI_M2_SD_GPIO_PORT   GPIOC
+#define AUDIO_IN_PDM_SPI_M2_AF             GPIO_AF6_SPI3
+#define AUDIO_IN_PDM_SPI_M2_GPIO_CLK_ENABLE() __HAL_RCC_GPIOC_CLK_ENABLE()
+#define AUDIO_IN_PDM_SPI_M2_DMAx_STREAM    DMA2_Channel1
+#define AUDIO_IN_PDM_SPI_M2_DMAx_REQUEST   DMA_REQUEST_3
+#define AUDIO_IN_PDM_DMAx_CLK_ENABLE()     do { __HAL_RCC_DMA1_CLK_ENABLE(); __HAL_RCC_DMA2_CLK_ENABLE(); } while(0)
+
 #ifdef USE_SPI3
 /* SPI Configuration defines */
 
@@ -447,6 +503,7 @@ typedef struct
 #define AUDIO_IN_DIGITAL_MIC_LAST AUDIO_IN_DIGITAL_MIC4
 #define AUDIO_IN_DIGITAL_MIC      (AUDIO_IN_DIGITAL_MIC1 |\
                                    AUDIO_IN_DIGITAL_MIC2 | AUDIO_IN_DIGITAL_MIC3 | AUDIO_IN_DIGITAL_MIC4)
+/* DFSDM filters of the recording, started as one synchronized group */
 #define DFSDM_MIC_NUMBER          AUDIO_IN_CHANNELS
 
 #define CHANNEL_DEMUX_MASK 0x55U
@@ -471,6 +528,12 @@ typedef struct
 #define PDM_FREQ_16K 1536
 #endif
 
+/* Software PDM to PCM of instance 0 at 16 bits: 1 converts all the microphones in one call of the multi-channel
+   decimator (pdm2pcm_mc.c), 0 with one PDM library call per microphone */
+#ifndef USE_PDM2PCM_MC
+#define USE_PDM2PCM_MC 1U
+#endif
+
 #ifndef PDM_FREQ_16K
 #define PDM_FREQ_16K 1280
 #endif
@@ -483,6 +546,16 @@ typedef struct
 /* Default Audio IN internal buffer size */
 #define DEFAULT_AUDIO_IN_BUFFER_SIZE (uint32_t)((AUDIO_IN_SAMPLING_FREQUENCY/1000)*2)*N_MS_PER_INTERRUPT
 
+/*Longest DMA block of the DFSDM instance, in ms. Blocks longer than N_MS_PER_INTERRUPT need an arena*/
+#ifndef AUDIO_IN_MAX_BLOCK_MS
+#define AUDIO_IN_MAX_BLOCK_MS 16U
+#endif
+
+/*Bytes of the arena of CCA02M2_AUDIO_Init_t: the circular DMA buffer of 32-bit DFSDM results of each
+  microphone, two blocks of BlockMs ms*/
+#define CCA02M2_AUDIO_IN_ARENA_SIZE(SampleRate, Channels, BlockMs) \
+  (((SampleRate) / 1000U) * 2U * (BlockMs) * (Channels) * 4U)
+
 /*BSP internal buffer size in half words (16 bits)*/
 #define PDM_INTERNAL_BUFFER_SIZE_I2S ((MAX_MIC_FREQ / 8) * MAX_AUDIO_IN_CHANNEL_NBR_PER_IF * N_MS_PER_INTERRUPT)
 #if MAX_AUDIO_IN_CHANNEL_NBR_TOTAL > 2
@@ -542,6 +615,10 @@ int32_t CCA02M2_AUDIO_IN_Pause(uint32_t Instance);
 int32_t CCA02M2_AUDIO_IN_Resume(uint32_t Instance);
 
 int32_t CCA02M2_AUDIO_IN_RecordChannels(uint32_t Instance, uint8_t **pBuf, uint32_t NbrOfBytes);
+int32_t CCA02M2_AUDIO_IN_RecordPlanar(uint32_t Instance, int16_t **pPlanes, uint32_t NbrOfBytes);
+int32_t CCA02M2_AUDIO_IN_GetBlock(uint32_t Instance, CCA02M2_AUDIO_IN_Block_t *pBlock);
+int32_t CCA02M2_AUDIO_IN_CheckSkew(uint32_t Instance, uint32_t *pSkew);
+int32_t CCA02M2_AUDIO_IN_GetCounters(uint32_t Instance, CCA02M2_AUDIO_IN_Counters_t *pCounters);
 int32_t CCA02M2_AUDIO_IN_StopChannels(uint32_t Instance, uint32_t Device);
 int32_t CCA02M2_AUDIO_IN_PauseChannels(uint32_t Instance, uint32_t Device);
 int32_t CCA02M2_AUDIO_IN_ResumeChannels(uint32_t Instance, uint32_t Device);
@@ -557,6 +634,7 @@ int32_t CCA02M2_AUDIO_IN_GetChannelsNbr(uint32_t Instance, uint32_t *ChannelNbr)
 int32_t CCA02M2_AUDIO_IN_SetVolume(uint32_t Instance, uint32_t Volume);
 int32_t CCA02M2_AUDIO_IN_GetVolume(uint32_t Instance, uint32_t *Volume);
 int32_t CCA02M2_AUDIO_IN_GetState(uint32_t Instance, uint32_t *State);
+int32_t CCA02M2_AUDIO_IN_GetPosition(uint32_t Instance, uint32_t *Position);
 
 /* Specific PDM recodr APIs */
 int32_t CCA02M2_AUDIO_IN_PDMToPCM_Init(uint32_t Instance, uint32_t AudioFreq, uint32_t ChnlNbrIn, uint32_t ChnlNbrOut);
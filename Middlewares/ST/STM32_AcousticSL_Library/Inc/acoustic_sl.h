@@ -45,6 +45,7 @@
 #define ACOUSTIC_SL_ALGORITHM_XCORR                	((uint32_t)0x00000001)
 #define ACOUSTIC_SL_ALGORITHM_GCCP                 	((uint32_t)0x00000002)
 #define ACOUSTIC_SL_ALGORITHM_BMPH                 	((uint32_t)0x00000004)
+#define ACOUSTIC_SL_ALGORITHM_SRPP                 	((uint32_t)0x00000008)
 /**
 * @}
 */
@@ -62,6 +63,9 @@
 #define ACOUSTIC_SL_DISTANCE_ERROR                 	((uint32_t)0x00000040)
 #define ACOUSTIC_SL_NUM_OF_SAMPLES_ERROR           	((uint32_t)0x00000080)
 #define ACOUSTIC_SL_PROCESSING_ERROR               	((uint32_t)0x00000100)
+#define ACOUSTIC_SL_HOP_SIZE_ERROR                 	((uint32_t)0x00000200)
+#define ACOUSTIC_SL_TRACKER_ERROR                  	((uint32_t)0x00000400)
+#define ACOUSTIC_SL_OVERRUN_ERROR                  	((uint32_t)0x00000800)
 
 #ifndef ACOUSTIC_LOCK_ERROR
 #define ACOUSTIC_LOCK_ERROR                      	((uint32_t)0x10000000)
@@ -69,7 +73,37 @@
 /**
 * @}
 */  
-#define ACOUSTIC_SL_NO_AUDIO_DETECTED              -100  
+#define ACOUSTIC_SL_NO_AUDIO_DETECTED              -100
+
+/** @defgroup Acoustic_SL_multi_source
+* @brief    Multi-source output limits
+* @{
+*/
+#define ACOUSTIC_SL_SRP_MAP_MAX_LENGTH             	((uint32_t)360)
+#define ACOUSTIC_SL_DEFAULT_MIN_SEPARATION         	((uint32_t)20)
+/**
+* @}
+*/
+
+/** @defgroup Acoustic_SL_tracker
+* @brief    Angle post-filters
+* @{
+*/
+#define ACOUSTIC_SL_TRACKER_HISTOGRAM              	((uint8_t)0x00)
+#define ACOUSTIC_SL_TRACKER_ALPHA_BETA             	((uint8_t)0x01)
+#define ACOUSTIC_SL_DEFAULT_RESPONSIVENESS         	((uint16_t)30)
+/**
+* @}
+*/
+
+/** @defgroup Acoustic_SL_srp_phat
+* @brief    Arbitrary geometry SRP-PHAT limits
+* @{
+*/
+#define ACOUSTIC_SL_SRPP_MAX_CHANNELS              	((uint32_t)8)
+/**
+* @}
+*/
 /**
 * @}
 */
@@ -90,8 +124,8 @@ typedef struct
   
   uint32_t sampling_frequency;                  /*!< Specifies the sampling frequency - for future use */
   
-  uint32_t channel_number;                      /*!< Specifies the number of channels, can be 2 for 180 estimation, 4 for 360 estimation. Default value is 
-  2. */  
+  uint32_t channel_number;                      /*!< Specifies the number of channels, can be 2 for 180 estimation, 4 for 360 estimation. With SRP-PHAT it
+  can range from 2 to ACOUSTIC_SL_SRPP_MAX_CHANNELS. Default value is 2. */  
   uint8_t ptr_M1_channels;                      /*!< Number of channels in the stream of Microphone 1. Deafult value is 1. */  
   uint8_t ptr_M2_channels;                      /*!< Number of channels in the stream of Microphone 2. Deafult value is 1. */ 
   uint8_t ptr_M3_channels;                      /*!< Number of channels in the stream of Microphone 3. Deafult value is 1. */
@@ -105,6 +139,12 @@ typedef struct
   be used to allocate the right amount of RAM */
   uint32_t * pInternalMemory;                   /*!< Pointer to the memory allocated by the user */
   int16_t samples_to_process;                   /*!< Specifies the number of samples to be processed at a time */      
+  int16_t mic_coordinates[ACOUSTIC_SL_SRPP_MAX_CHANNELS][3]; /*!< x, y, z position of each microphone in decimals of a millimeter,
+  used by SRP-PHAT only. Azimuth is measured from the x axis towards the y axis. If any z is not 0 the elevation is
+  estimated too, over the upper hemisphere. */
+  uint16_t hop_size;                            /*!< Number of new samples between two consecutive analysis windows, used by GCC-PHAT and SRP-PHAT only.
+  Values lower than samples_to_process make the windows overlap and raise the update rate. Default value is 0, that
+  is samples_to_process (no overlap). */
   
 } AcousticSL_Handler_t;
 
@@ -115,8 +155,42 @@ typedef struct
 {
   uint16_t threshold;                           /*!< Specifies a value related to a voice-activity score. With values below the threshold, the algorithm does not act. The threshold value ranges from 0 to 1000 and the default value is 24. */
   uint32_t resolution;                          /*!< Angle resolution for the algorithms. Ignored if XCORR is used. Deafult value is 4. */
+  uint8_t tracker;                              /*!< Post-filter of the estimated angle, ACOUSTIC_SL_TRACKER_HISTOGRAM or ACOUSTIC_SL_TRACKER_ALPHA_BETA.
+  The alpha-beta tracker follows angle and angular velocity on the circle with a constant cost per update and hands over
+  between talkers faster than the histogram voting. Ignored by BMPH. Default value is ACOUSTIC_SL_TRACKER_HISTOGRAM. */
+  uint16_t responsiveness;                      /*!< Alpha-beta tracker gain in percent, ranging from 1 (smooth, slow) to 100 (raw estimates).
+  If 0, ACOUSTIC_SL_DEFAULT_RESPONSIVENESS is used. */
 } AcousticSL_Config_t;
 
+/**
+* @brief  Single source estimated by AcousticSL_ProcessMulti().
+*/
+typedef struct
+{
+  int32_t angle;                                /*!< Direction of arrival in degrees, same reference used by AcousticSL_Process(). */
+  float confidence;                             /*!< Normalized steered response at the peak, ranging from 0 (no coherence) to 1. */
+} AcousticSL_Source_t;
+
+/**
+* @brief  Multi-source output handler, filled by AcousticSL_ProcessMulti().
+*/
+typedef struct
+{
+  AcousticSL_Source_t * pSources;               /*!< Pointer to a user array of at least max_sources elements. */
+  uint32_t max_sources;                         /*!< Maximum number of sources (K) to be reported. */
+  uint32_t min_separation;                      /*!< Minimum distance in degrees between two reported sources. If 0,
+  ACOUSTIC_SL_DEFAULT_MIN_SEPARATION is used. */
+  float * pSRP_map;                             /*!< Optional pointer to a user buffer for the steered response map, NULL if not needed. */
+  uint32_t SRP_map_size;                        /*!< Size of the pSRP_map buffer in elements. ACOUSTIC_SL_SRP_MAP_MAX_LENGTH always fits. */
+
+  int32_t estimated_angle;                      /*!< Output: filtered angle, the same value returned by AcousticSL_Process(). */
+  uint32_t sources_number;                      /*!< Output: number of valid entries written in pSources, 0 if no audio has been detected. */
+  uint32_t SRP_map_length;                      /*!< Output: number of values written in pSRP_map. */
+  float SRP_map_first_angle;                    /*!< Output: angle in degrees of pSRP_map[0]. */
+  float SRP_map_step;                           /*!< Output: angle in degrees between two consecutive pSRP_map values (modulo 360 for 4 channels setups). */
+  float angular_velocity;                       /*!< Output: tracked angular velocity in degrees per second, 0 unless the alpha-beta tracker is used. */
+} AcousticSL_MultiOutput_t;
+
 
 /**
 * @}
@@ -160,6 +234,12 @@ uint32_t AcousticSL_Init(AcousticSL_Handler_t * pHandler);
 * @retval 1 if data collection is finished and libSoundSourceLoc_Process must be called, 0 otherwise.
 * @note   Input function reads samples skipping the required number of values depending on the Ptr_Mx_Channels configuration.
 * @note   pM3 and pM4 are ignored in the case the library is setup for using 2 channels.
+* @note   With SRP-PHAT pM1 points to the first microphone of an interleaved stream of ptr_M1_channels channels,
+*         the k-th microphone being read at pM1[k]. pM2, pM3 and pM4 are ignored.
+* @note   With GCC-PHAT and SRP-PHAT, 1 is returned every hop_size samples (rounded to 1 ms of data) once the first window is full.
+*         The input ring holds the window plus one hop, so the triggered window stays intact until this function returns 1
+*         again: the windowing step at the start of AcousticSL_Process() must be over by then, otherwise the frame is
+*         dropped and AcousticSL_Process() returns ACOUSTIC_SL_OVERRUN_ERROR.
 */
 uint32_t AcousticSL_Data_Input(void *pM1, void *pM2, void *pM3, void *pM4, AcousticSL_Handler_t * pHandler);
 
@@ -167,14 +247,30 @@ uint32_t AcousticSL_Data_Input(void *pM1, void *pM2, void *pM3, void *pM4, Acous
 * @brief  Library run function, performs audio analysis when all required data has been collected.
 * @param  Estimated_Angle: pointer to the int32_t variable that will contain the computed value.
 * @param  pHandler: pointer to the handler of the current Source Localization instance running.
-* @retval 0 if everything is ok, 1 otherwise
+* @retval 0 if everything is ok, ACOUSTIC_SL_OVERRUN_ERROR if the window was overwritten by AcousticSL_Data_Input()
+*         before being copied: no angle is estimated from it.
 */
 uint32_t AcousticSL_Process(int32_t * Estimated_Angle, AcousticSL_Handler_t * pHandler);
 
+/**
+* @brief  Library run function returning multiple sources. It performs the same analysis as AcousticSL_Process() and
+*         extracts the K strongest local maxima of the steered response by non-maximum suppression.
+* @param  pOutput: pointer to the multi-source output handler. pSources, max_sources, min_separation, pSRP_map and
+*         SRP_map_size must be set by the user, the remaining fields are filled by the library.
+* @param  pHandler: pointer to the handler of the current Source Localization instance running.
+* @retval 0 if everything is ok, ACOUSTIC_SL_PROCESSING_ERROR if the output handler is not valid.
+* @note   Supported by GCC-PHAT, SRP-PHAT and BMPH algorithms only. With XCORR just estimated_angle is filled.
+* @note   With SRP-PHAT the map is evaluated at every azimuth of the estimated elevation, while AcousticSL_Process()
+*         only searches a coarse grid and the neighbourhood of its best point: 360 / resolution sums over the
+*         microphone pairs on top of the analysis, once per call whatever max_sources.
+*/
+uint32_t AcousticSL_ProcessMulti(AcousticSL_MultiOutput_t * pOutput, AcousticSL_Handler_t * pHandler);
+
 /**
 * @brief  Library setup function, it sets the values for threshold and resolution. It can be called at runtime to change
 *         dynamic parameters.
-* @note   Only the threshold and resolution are evaluated by the SetConfig function.
+* @note   Only the threshold, resolution and tracker parameters are evaluated by the SetConfig function.
+*         Changing the tracker restarts it.
 * @retval 0 if everything is fine.
 *         different from 0 if erroneous parameters have been passed to the Init function and the default value has been used.
 *         The specific error can be recognized by checking the relative bit in the returned word.
@@ -66,6 +66,12 @@ uint32_t AcousticSL_Init(AcousticSL_Handler_t * pHandler)
  * @retval 1 if data collection is finished and libSoundSourceLoc_Process must be called, 0 otherwise.
  * @note   Input function reads samples skipping the required number of values depending on the Ptr_Mx_Channels configuration.
  * @note   pM3 and pM4 are ignored in the case the library is setup for using 2 channels.
+ * @note   With SRP-PHAT pM1 points to the first microphone of an interleaved stream of ptr_M1_channels channels,
+ *         the k-th microphone being read at pM1[k]. pM2, pM3 and pM4 are ignored.
+ * @note   With GCC-PHAT and SRP-PHAT, 1 is returned every hop_size samples (rounded to 1 ms of data) once the first window is full.
+ *         The input ring holds the window plus one hop, so the triggered window stays intact until this function returns 1
+ *         again: the windowing step at the start of AcousticSL_Process() must be over by then, otherwise the frame is
+ *         dropped and AcousticSL_Process() returns ACOUSTIC_SL_OVERRUN_ERROR.
 */
 uint32_t AcousticSL_Data_Input(void *pM1, void *pM2, void *pM3, void *pM4, AcousticSL_Handler_t * pHandler)
 {
@@ -76,17 +82,33 @@ return libSoundSourceLoc_Data_Input((int16_t *)pM1, (int16_t *)pM2, (int16_t *)p
  * @brief  Library run function, performs audio analysis when all required data has been collected.
  * @param  Estimated_Angle: pointer to the int32_t variable that will contain the computed value.
  * @param  pHandler: pointer to the handler of the current Source Localization instance running.
- * @retval 0 if everything is ok, 1 otherwise
+ * @retval 0 if everything is ok, ACOUSTIC_SL_OVERRUN_ERROR if the window was overwritten by AcousticSL_Data_Input()
+ *         before being copied: no angle is estimated from it.
 */
 uint32_t AcousticSL_Process(int32_t * Estimated_Angle, AcousticSL_Handler_t * pHandler)
 {
   return libSoundSourceLoc_Process(Estimated_Angle, pHandler);
 }
 
+/**
+ * @brief  Library run function returning multiple sources. It performs the same analysis as AcousticSL_Process() and
+ *         extracts the K strongest local maxima of the steered response by non-maximum suppression.
+ * @param  pOutput: pointer to the multi-source output handler. pSources, max_sources, min_separation, pSRP_map and
+ *         SRP_map_size must be set by the user, the remaining fields are filled by the library.
+ * @param  pHandler: pointer to the handler of the current Source Localization instance running.
+ * @retval 0 if everything is ok, ACOUSTIC_SL_PROCESSING_ERROR if the output handler is not valid.
+ * @note   Supported by GCC-PHAT, SRP-PHAT and BMPH algorithms only. With XCORR just estimated_angle is filled.
+*/
+uint32_t AcousticSL_ProcessMulti(AcousticSL_MultiOutput_t * pOutput, AcousticSL_Handler_t * pHandler)
+{
+  return libSoundSourceLoc_ProcessMulti(pOutput, pHandler);
+}
+
 /**
  * @brief  Library setup function, it sets the values for threshold and resolution. It can be called at runtime to change
  *         dynamic parameters.
- * @note   Only the threshold and resolution are evaluated by the SetConfig function.
+ * @note   Only the threshold, resolution and tracker parameters are evaluated by the SetConfig function.
+ *         Changing the tracker restarts it.
  * @retval 0 if everything is fine.
  *         different from 0 if erroneous parameters have been passed to the Init function and the default value has been used.
  *         The specific error can be recognized by checking the relative bit in the returned word.
@@ -610,6 +610,10 @@ static void max_block_correlation(libSoundSourceLoc_Handler_Internal * SLocInter
     *v_max=0.0f;
     *i_max=-1;
     
+    //upper bound of the block energy, used to normalize the steered response map
+    arm_power_f32(SLocInternal->s, 2U*(uint32_t)SLocInternal->Mic_Number*(uint32_t)SLocInternal->num_of_freq, &SLocInternal->energy_norm);
+    SLocInternal->energy_norm *= (float32_t)SLocInternal->Mic_Number;
+    
     for (n=0;n<(int32_t)SLocInternal->num_of_angles;n++)
     {
       en_n=0.0f;
@@ -627,12 +631,14 @@ static void max_block_correlation(libSoundSourceLoc_Handler_Internal * SLocInter
         arm_cmplx_dot_prod_f32 (&(SLocInternal->s[w*2*(int32_t)SLocInternal->Mic_Number]), steering_vec, SLocInternal->Mic_Number, &dp_r, &dp_i);
         en_n += SQR(dp_r) + SQR(dp_i);
       }
+      SLocInternal->energy_theta[n]=en_n;
       if (en_n>*v_max)
       {
         *v_max=en_n;
         *i_max=n;
       }
     }
+    SLocInternal->SRP_Map_Valid=1;
   }
 }
 
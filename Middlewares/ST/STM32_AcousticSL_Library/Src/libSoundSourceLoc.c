@@ -92,6 +92,47 @@ typedef struct _libSoundSourceLoc_Handler_Internal{
   int16_t *       frequencies_under_analysis; // NUM OF FREQ
   int16_t *       sources; // 2* OUTPUT SOURCES
   float32_t *     steering_tau;
+  float32_t *     energy_theta; // NUM_ANGLES
+  float32_t       energy_norm;
+  
+  //multi-source
+  float32_t *     Phase12;
+  uint8_t         SRP_Map_Valid;
+  
+  //overlapped windows
+  uint32_t        Hop_Size;
+  int32_t         Hop_Counter;
+  volatile uint16_t Frame_Start;
+  volatile uint32_t Frame_Seq; // incremented by each trigger
+  uint8_t         Frame_Overrun;
+  uint32_t        Ring_Size; // window + longest run of samples collected between two triggers
+  uint32_t        Event_Sum;
+  uint32_t        Frame_Event_Sum;
+  
+  //srp-phat
+  float32_t *     SRP_Data; // AUDIO_CHANNELS * 2 * DFT_LEN
+  float32_t *     SRP_Corr; // PAIRS * (2 * MAX_LAG * OVERSAMPLING + 1)
+  float32_t *     SRP_Interp; // OVERSAMPLING * INTERP_TAPS
+  float32_t *     SRP_Map; // NUM_ANGLES, azimuth scan at the elevation of the last estimate
+  int8_t *        SRP_Tdoa; // ELEVATIONS * NUM_ANGLES * PAIRS, in 1/OVERSAMPLING of a sample
+  float32_t *     mic_coordinates; // 3 * AUDIO_CHANNELS
+  uint16_t        SRP_Pairs;
+  uint16_t        SRP_Max_Lag;
+  uint16_t        SRP_Oversampling;
+  uint16_t        SRP_Coarse_Span; // in 1/OVERSAMPLING of a sample
+  uint16_t        SRP_Elevations;
+  uint16_t        SRP_Elevation_Index;
+  
+  //alpha-beta tracker
+  uint8_t         Tracker;
+  uint8_t         Track_Valid;
+  uint16_t        Track_Responsiveness;
+  uint16_t        Track_Misses;
+  float32_t       Track_Alpha;
+  float32_t       Track_Beta;
+  float32_t       Track_Angle; // degrees
+  float32_t       Track_Velocity; // degrees per second
+  float32_t       Track_Period; // seconds between two updates
   
 } libSoundSourceLoc_Handler_Internal;
 
@@ -106,6 +147,9 @@ typedef struct _libSoundSourceLoc_Handler_Internal{
 #define FILTER_STEP_SEC 8
 #define FILTER_MAX_SEC 20
 
+#define TRACKER_HOLD_TIME               0.5f    /* seconds without detections before the track is dropped */
+#define TRACKER_VELOCITY_DECAY          0.5f    /* velocity damping for each update without detection */
+
 #define FACTOR_INDEX_2_HZ               (uint16_t)(SLocInternal->sampling_frequency/SLocInternal->Sample_Number_To_Process)
 
 #define MIN_RESOLUTION                  4U
@@ -133,6 +177,12 @@ typedef struct _libSoundSourceLoc_Handler_Internal{
 #define SaturaL(N, L) (((N)<(L))?(L):(N))
 #define SaturaH(N, H) (((N)>(H))?(H):(N))
 
+/* Input ring of GCC-PHAT and SRP-PHAT: the window of N samples followed by room for the samples collected, in
+   chunks of MS, until the next trigger every H samples. A triggered window stays intact until the next trigger. */
+#define RING_SIZE(N, H, MS) ((N) + ((((H) + (MS) - 1U)/(MS))*(MS)))
+
+#include "srp_phat.c"
+
 /* Private variables ---------------------------------------------------------*/
 
 /* Global variables ----------------------------------------------------------*/
@@ -142,6 +192,12 @@ static float32_t XCORR_GetAngle(libSoundSourceLoc_Handler_Internal * SLocInterna
 static float32_t GCC_GetAngle(libSoundSourceLoc_Handler_Internal * SLocInternal, int32_t * out_angles);
 static int32_t get_max_pos(libSoundSourceLoc_Handler_Internal * SLocInternal,int32_t length,int32_t step);
 static void FilterAngle(int32_t *SourceAngle, int32_t* LedStatus, uint16_t max_value, uint16_t A, uint16_t SatA, uint16_t B, uint16_t SatB);
+static void TrackAngle(libSoundSourceLoc_Handler_Internal * SLocInternal, int32_t *SourceAngle, uint16_t max_value);
+static void TrackReset(libSoundSourceLoc_Handler_Internal * SLocInternal);
+static int32_t TrackRound(float32_t angle, uint16_t max_value);
+static uint32_t SRP_GetMapLength(libSoundSourceLoc_Handler_Internal * SLocInternal, float32_t * first_angle, float32_t * step, uint8_t * circular);
+static float32_t SRP_GetMapValue(libSoundSourceLoc_Handler_Internal * SLocInternal, uint32_t index);
+static int32_t SRP_GetMapAngle(libSoundSourceLoc_Handler_Internal * SLocInternal, uint32_t index);
 
 /* Functions Definition ------------------------------------------------------*/
 static uint32_t libSoundSourceLoc_GetLibVersion(char *version)
@@ -204,6 +260,11 @@ static uint32_t libSoundSourceLoc_Init(AcousticSL_Handler_t * pHandler)
   {
     SLocInternal->Mic_Number=(uint16_t)pHandler->channel_number;
   }
+  else if( (pHandler->algorithm == ACOUSTIC_SL_ALGORITHM_SRPP) && (pHandler->channel_number >= 2U) &&
+          (pHandler->channel_number <= ACOUSTIC_SL_SRPP_MAX_CHANNELS) )
+  {
+    SLocInternal->Mic_Number=(uint16_t)pHandler->channel_number;
+  }
   else
   {
     SLocInternal->Mic_Number = 2; /*Set default Value*/
@@ -213,7 +274,8 @@ static uint32_t libSoundSourceLoc_Init(AcousticSL_Handler_t * pHandler)
   /*ALGORITHM SELECTION*/
   if(   (pHandler->algorithm == ACOUSTIC_SL_ALGORITHM_XCORR)
      || (pHandler->algorithm == ACOUSTIC_SL_ALGORITHM_GCCP)
-       || (pHandler->algorithm == ACOUSTIC_SL_ALGORITHM_BMPH))
+       || (pHandler->algorithm == ACOUSTIC_SL_ALGORITHM_BMPH)
+         || (pHandler->algorithm == ACOUSTIC_SL_ALGORITHM_SRPP))
   {
     SLocInternal->Type=pHandler->algorithm;
   }
@@ -253,7 +315,7 @@ static uint32_t libSoundSourceLoc_Init(AcousticSL_Handler_t * pHandler)
     SLocInternal->Sample_Number_To_Store=(uint32_t)pHandler->samples_to_process;
     SLocInternal->Sample_Number_To_Process=(uint32_t)pHandler->samples_to_process/2U;
   }
-  else if (SLocInternal->Type== ACOUSTIC_SL_ALGORITHM_GCCP)
+  else if ((SLocInternal->Type== ACOUSTIC_SL_ALGORITHM_GCCP) || (SLocInternal->Type== ACOUSTIC_SL_ALGORITHM_SRPP))
   {
     SLocInternal->Sample_Number_To_Store=(uint32_t)pHandler->samples_to_process;
     SLocInternal->Sample_Number_To_Process=(uint32_t)pHandler->samples_to_process;
@@ -263,7 +325,8 @@ static uint32_t libSoundSourceLoc_Init(AcousticSL_Handler_t * pHandler)
     /* no other use cases are handled */
   }
   
-  if ((SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_GCCP) || (SLocInternal->Type== ACOUSTIC_SL_ALGORITHM_BMPH))
+  if ((SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_GCCP) || (SLocInternal->Type== ACOUSTIC_SL_ALGORITHM_BMPH) ||
+      (SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_SRPP))
   {
     if( (SLocInternal->Sample_Number_To_Process == 32U)   ||
        (SLocInternal->Sample_Number_To_Process == 64U)   ||
@@ -284,16 +347,52 @@ static uint32_t libSoundSourceLoc_Init(AcousticSL_Handler_t * pHandler)
     }
   }
   
+  /* HOP SIZE*/
+  if ((SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_GCCP) || (SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_SRPP))
+  {
+    if ((pHandler->hop_size > 0U) && ((uint32_t)pHandler->hop_size <= SLocInternal->Sample_Number_To_Process))
+    {
+      SLocInternal->Hop_Size = pHandler->hop_size;
+    }
+    else
+    {
+      SLocInternal->Hop_Size = SLocInternal->Sample_Number_To_Process; /*Set default Value*/
+      if (pHandler->hop_size != 0U)
+      {
+        ret |= ACOUSTIC_SL_HOP_SIZE_ERROR;
+      }
+    }
+    /* the first window must be completely filled before triggering the processing */
+    SLocInternal->Hop_Counter = (int32_t)SLocInternal->Hop_Size - (int32_t)SLocInternal->Sample_Number_To_Process;
+  }
+  
+  /* TRACKER UPDATE PERIOD*/
+  if ((SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_GCCP) || (SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_SRPP))
+  {
+    SLocInternal->Track_Period = (float32_t)SLocInternal->Hop_Size/(float32_t)SLocInternal->sampling_frequency;
+  }
+  else
+  {
+    SLocInternal->Track_Period = (float32_t)SLocInternal->Sample_Number_To_Process/(float32_t)SLocInternal->sampling_frequency;
+  }
+  SLocInternal->Tracker = ACOUSTIC_SL_TRACKER_HISTOGRAM;
+  TrackReset(SLocInternal);
+  
   SLocInternal->Buffer_State = 0;
   SLocInternal->Input_Counter = 0;
   
   SLocInternal->Sample_Number_Each_ms = (uint16_t)SLocInternal->sampling_frequency / 1000U;
   SLocInternal->Callbacks.CheckEventFunction = CheckEvent;
   
+  if ((SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_GCCP) || (SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_SRPP))
+  {
+    SLocInternal->Ring_Size = RING_SIZE(SLocInternal->Sample_Number_To_Process, SLocInternal->Hop_Size, SLocInternal->Sample_Number_Each_ms);
+  }
+  
   /*SUPPORT VARIABLE USED FOR MEMORY ALLOCATION*/
   volatile uint32_t  byte_offset = sizeof(libSoundSourceLoc_Handler_Internal);
   
-  if (SLocInternal->Mic_Number >= 2U)
+  if ((SLocInternal->Mic_Number >= 2U) && (SLocInternal->Type != ACOUSTIC_SL_ALGORITHM_SRPP))
   {
     /*DISTANCE*/
     if( pHandler->M12_distance > 0U )
@@ -323,10 +422,10 @@ static uint32_t libSoundSourceLoc_Init(AcousticSL_Handler_t * pHandler)
       SLocInternal->Callbacks.SourceLocFunction = GCC_GetAngle;
       
       SLocInternal->M1_Data=(((uint8_t *)pHandler->pInternalMemory+byte_offset));
-      byte_offset+=(SLocInternal->Sample_Number_To_Process)*2U*sizeof(float32_t);  //dBuff for M1 size in byte
+      byte_offset+=(SLocInternal->Ring_Size + SLocInternal->Sample_Number_To_Process)*sizeof(float32_t);  //ring buffer + spectrum for M1 size in byte
       
       SLocInternal->M2_Data=(((uint8_t *)pHandler->pInternalMemory+byte_offset));
-      byte_offset+=(SLocInternal->Sample_Number_To_Process)*2U*sizeof(float32_t);  //dBuff for M2 size in byte
+      byte_offset+=(SLocInternal->Ring_Size + SLocInternal->Sample_Number_To_Process)*sizeof(float32_t);  //ring buffer + spectrum for M2 size in byte
       
     }
     else
@@ -336,7 +435,7 @@ static uint32_t libSoundSourceLoc_Init(AcousticSL_Handler_t * pHandler)
     SLocInternal->M12_TAUD = (int32_t)SLocInternal->M12_distance * ((int32_t)SLocInternal->sampling_frequency/(int32_t)SOUND_SPEED);
   }
   
-  if (SLocInternal->Mic_Number == 4U)
+  if ((SLocInternal->Mic_Number == 4U) && (SLocInternal->Type != ACOUSTIC_SL_ALGORITHM_SRPP))
   {
     /*DISTANCE*/
     if( pHandler->M34_distance > 0U )
@@ -361,10 +460,10 @@ static uint32_t libSoundSourceLoc_Init(AcousticSL_Handler_t * pHandler)
     else if (SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_GCCP)
     {
       SLocInternal->M3_Data=(((uint8_t *)pHandler->pInternalMemory+byte_offset));
-      byte_offset+=(SLocInternal->Sample_Number_To_Process)*2U*sizeof(float32_t);  //dBuff for M3 size in byte
+      byte_offset+=(SLocInternal->Ring_Size + SLocInternal->Sample_Number_To_Process)*sizeof(float32_t);  //ring buffer + spectrum for M3 size in byte
       
       SLocInternal->M4_Data=(((uint8_t *)pHandler->pInternalMemory+byte_offset));
-      byte_offset+=(SLocInternal->Sample_Number_To_Process)*2U*sizeof(float32_t);  //dBuff for M4 size in byte
+      byte_offset+=(SLocInternal->Ring_Size + SLocInternal->Sample_Number_To_Process)*sizeof(float32_t);  //ring buffer + spectrum for M4 size in byte
     }
     else
     {
@@ -394,6 +493,12 @@ static uint32_t libSoundSourceLoc_Init(AcousticSL_Handler_t * pHandler)
     SLocInternal->window=(float32_t *)((uint8_t *)pHandler->pInternalMemory+byte_offset);
     byte_offset+=SLocInternal->Sample_Number_To_Process*sizeof(float32_t);  /* size of Buff for sumArray in bytes */
     
+    if(SLocInternal->Mic_Number == 4U)
+    {
+      SLocInternal->Phase12=(float32_t *)((uint8_t *)pHandler->pInternalMemory+byte_offset);
+      byte_offset+=182U*sizeof(float32_t);  /* size of Buff for M12 Phase copy in bytes */
+    }
+    
     /*Init FFt function*/
     (void)arm_rfft_fast_init_f32(SLocInternal->SFast, (uint16_t)SLocInternal->Sample_Number_To_Process);
     
@@ -470,14 +575,26 @@ static uint32_t libSoundSourceLoc_Init(AcousticSL_Handler_t * pHandler)
     SLocInternal->steering_tau=(float32_t *)((uint8_t *)pHandler->pInternalMemory+byte_offset);
     byte_offset+=(MAX_AUDIO_CHANNELS*MAX_NUM_OF_ANGLES)*sizeof(float32_t);
     
+    SLocInternal->energy_theta=(float32_t *)((uint8_t *)pHandler->pInternalMemory+byte_offset);
+    byte_offset+=(MAX_NUM_OF_ANGLES)*sizeof(float32_t);
+    
     (void)arm_rfft_fast_init_f32(SLocInternal->SFast, (uint16_t)SLocInternal->Sample_Number_To_Process);
   }
+  else if (SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_SRPP)
+  {
+    SLocInternal->Callbacks.SourceLocFunction = SRPP_GetAngle;
+    
+    uint32_t srp_offset = byte_offset;
+    ret |= SRP_Init(pHandler, SLocInternal, &srp_offset);
+    byte_offset = srp_offset;
+  }
   else
   {
     /* no other use cases are handled */
   }
   
-  if ((SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_XCORR) || (SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_GCCP))
+  if ((SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_XCORR) || (SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_GCCP) ||
+      (SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_SRPP))
   {
     SLocInternal->SourceLocFilterArray=(int32_t *)(int32_t *)((uint8_t *)pHandler->pInternalMemory+byte_offset);
     byte_offset+=362U*sizeof(int32_t);  /* size of Buff for SourceLocFilterArray in bytes */
@@ -495,6 +612,23 @@ static uint32_t libSoundSourceLoc_getMemorySize(AcousticSL_Handler_t * pHandler)
 {  
   /*SUPPORT VARIABLE USED FOR MEMORY ALLOCATION*/
   volatile uint32_t  byte_offset = sizeof(libSoundSourceLoc_Handler_Internal);
+  uint32_t ring_size = 0;
+  
+  if((pHandler->algorithm == ACOUSTIC_SL_ALGORITHM_GCCP))
+  {
+    uint32_t samples = (uint32_t)pHandler->samples_to_process;
+    uint32_t hop = samples;
+    uint32_t each_ms = 16U;
+    if ((pHandler->hop_size > 0U) && ((uint32_t)pHandler->hop_size <= samples))
+    {
+      hop = pHandler->hop_size;
+    }
+    if ((pHandler->sampling_frequency == 32000U) || (pHandler->sampling_frequency == 48000U))
+    {
+      each_ms = pHandler->sampling_frequency/1000U;
+    }
+    ring_size = RING_SIZE(samples, hop, each_ms);
+  }
   
   if (pHandler->channel_number >= 2U)
   {
@@ -505,8 +639,8 @@ static uint32_t libSoundSourceLoc_getMemorySize(AcousticSL_Handler_t * pHandler)
     }
     else if ((pHandler->algorithm == ACOUSTIC_SL_ALGORITHM_GCCP))
     {
-      byte_offset+=((uint32_t)pHandler->samples_to_process)*2U*sizeof(float32_t);  //dBuff for M1 size in byte
-      byte_offset+=((uint32_t)pHandler->samples_to_process)*2U*sizeof(float32_t);  //dBuff for M2 size in byte
+      byte_offset+=(ring_size + (uint32_t)pHandler->samples_to_process)*sizeof(float32_t);  //ring buffer + spectrum for M1 size in byte
+      byte_offset+=(ring_size + (uint32_t)pHandler->samples_to_process)*sizeof(float32_t);  //ring buffer + spectrum for M2 size in byte
     }
     else
     {
@@ -523,8 +657,8 @@ static uint32_t libSoundSourceLoc_getMemorySize(AcousticSL_Handler_t * pHandler)
     }
     else if ((pHandler->algorithm == ACOUSTIC_SL_ALGORITHM_GCCP))
     {
-      byte_offset+=((uint32_t)pHandler->samples_to_process)*2U*sizeof(float32_t);  //dBuff for M3 size in byte
-      byte_offset+=((uint32_t)pHandler->samples_to_process)*2U*sizeof(float32_t);  //dBuff for M4 size in byte
+      byte_offset+=(ring_size + (uint32_t)pHandler->samples_to_process)*sizeof(float32_t);  //ring buffer + spectrum for M3 size in byte
+      byte_offset+=(ring_size + (uint32_t)pHandler->samples_to_process)*sizeof(float32_t);  //ring buffer + spectrum for M4 size in byte
     }
     else
     {
@@ -540,6 +674,10 @@ static uint32_t libSoundSourceLoc_getMemorySize(AcousticSL_Handler_t * pHandler)
     byte_offset+=182U*sizeof(float32_t);  /* size of Buff for Phase in bytes */
     byte_offset+=182U*sizeof(float32_t);  /* size of Buff for sumArray in bytes */
     byte_offset+=(uint32_t)pHandler->samples_to_process*sizeof(float32_t);  /* size of Buff for Window in bytes */
+    if(pHandler->channel_number == 4U)
+    {
+      byte_offset+=182U*sizeof(float32_t);  /* size of Buff for M12 Phase copy in bytes */
+    }
   }
   
   if (pHandler->channel_number >= 2U)
@@ -563,10 +701,17 @@ static uint32_t libSoundSourceLoc_getMemorySize(AcousticSL_Handler_t * pHandler)
       byte_offset+=(MAX_NUM_OF_FREQUENCIES)*sizeof(int16_t);
       byte_offset+=(2U*NUM_OUTPUT_SOURCES)*sizeof(int16_t);
       byte_offset+=(MAX_AUDIO_CHANNELS*MAX_NUM_OF_ANGLES)*sizeof(float32_t);
+      byte_offset+=(MAX_NUM_OF_ANGLES)*sizeof(float32_t);
     }
   }
   
-  if ((pHandler->algorithm == ACOUSTIC_SL_ALGORITHM_XCORR) || (pHandler->algorithm == ACOUSTIC_SL_ALGORITHM_GCCP))
+  if ((pHandler->algorithm == ACOUSTIC_SL_ALGORITHM_SRPP))
+  {
+    byte_offset+=SRP_GetMemorySize(pHandler);
+  }
+  
+  if ((pHandler->algorithm == ACOUSTIC_SL_ALGORITHM_XCORR) || (pHandler->algorithm == ACOUSTIC_SL_ALGORITHM_GCCP) ||
+      (pHandler->algorithm == ACOUSTIC_SL_ALGORITHM_SRPP))
   {
     byte_offset+=362U*sizeof(int32_t);  /* size of Buff for SourceLocFilterArray in bytes */
     if(pHandler->channel_number == 4U)
@@ -605,9 +750,18 @@ static uint32_t libSoundSourceLoc_Data_Input(void *pM1, void *pM2, void *pM3, vo
   }
   else if(SLocInternal->Type ==  ACOUSTIC_SL_ALGORITHM_GCCP )
   {
+    /* ring buffer: the event energy is updated with the incoming sample and the one leaving the window only */
     for (i = 0; i < SLocInternal->Sample_Number_Each_ms; i ++)
     {
-      ((float32_t *)(SLocInternal->M1_Data))[SLocInternal->Input_Counter] = (float32_t)((int16_t *)(pM1))[i*SLocInternal->ptr_M1_channels];//todo interleaving
+      int16_t sample = ((int16_t *)(pM1))[i*SLocInternal->ptr_M1_channels];
+      uint32_t outgoing = SLocInternal->Input_Counter + SLocInternal->Ring_Size - SLocInternal->Sample_Number_To_Process;
+      if(outgoing >= SLocInternal->Ring_Size)
+      {
+        outgoing -= SLocInternal->Ring_Size;
+      }
+      SLocInternal->Event_Sum -= (uint32_t)Abs(((float32_t *)(SLocInternal->M1_Data))[outgoing]);
+      SLocInternal->Event_Sum += (uint32_t)Abs(sample);
+      ((float32_t *)(SLocInternal->M1_Data))[SLocInternal->Input_Counter] = (float32_t)sample;
       ((float32_t *)(SLocInternal->M2_Data))[SLocInternal->Input_Counter] = (float32_t)((int16_t *)(pM2))[i*SLocInternal->ptr_M2_channels];
       if (SLocInternal->Mic_Number == 4U)
       {
@@ -615,6 +769,35 @@ static uint32_t libSoundSourceLoc_Data_Input(void *pM1, void *pM2, void *pM3, vo
         ((float32_t *)(SLocInternal->M4_Data))[SLocInternal->Input_Counter] = (float32_t)((int16_t *)(pM4))[i*SLocInternal->ptr_M4_channels];
       }
       SLocInternal->Input_Counter ++;
+      if(SLocInternal->Input_Counter == SLocInternal->Ring_Size)
+      {
+        SLocInternal->Input_Counter = 0;
+      }
+    }
+  }
+  else if(SLocInternal->Type ==  ACOUSTIC_SL_ALGORITHM_SRPP )
+  {
+    /* same ring buffer as GCC-PHAT, all the mics are read from the interleaved pM1 stream */
+    for (i = 0; i < SLocInternal->Sample_Number_Each_ms; i ++)
+    {
+      uint32_t m;
+      int16_t * pIn = &((int16_t *)(pM1))[i*SLocInternal->ptr_M1_channels];
+      uint32_t outgoing = SLocInternal->Input_Counter + SLocInternal->Ring_Size - SLocInternal->Sample_Number_To_Process;
+      if(outgoing >= SLocInternal->Ring_Size)
+      {
+        outgoing -= SLocInternal->Ring_Size;
+      }
+      SLocInternal->Event_Sum -= (uint32_t)Abs(SLocInternal->SRP_Data[outgoing]);
+      SLocInternal->Event_Sum += (uint32_t)Abs(pIn[0]);
+      for (m = 0; m < SLocInternal->Mic_Number; m++)
+      {
+        SLocInternal->SRP_Data[(m*(SLocInternal->Ring_Size + SLocInternal->Sample_Number_To_Process)) + SLocInternal->Input_Counter] = (float32_t)pIn[m];
+      }
+      SLocInternal->Input_Counter ++;
+      if(SLocInternal->Input_Counter == SLocInternal->Ring_Size)
+      {
+        SLocInternal->Input_Counter = 0;
+      }
     }
   }
   else
@@ -638,6 +821,31 @@ static uint32_t libSoundSourceLoc_Data_Input(void *pM1, void *pM2, void *pM3, vo
       SLocInternal->mics_read_offset = (uint16_t)SLocInternal->Sample_Number_To_Store;
     }
   }
+  else if((SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_GCCP) || (SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_SRPP))
+  {
+    SLocInternal->Hop_Counter += (int32_t)SLocInternal->Sample_Number_Each_ms;
+    if(SLocInternal->Hop_Counter >= (int32_t)SLocInternal->Hop_Size)
+    {
+      SLocInternal->Hop_Counter -= (int32_t)SLocInternal->Hop_Size;
+      if(SLocInternal->Hop_Counter >= (int32_t)SLocInternal->Hop_Size)
+      {
+        SLocInternal->Hop_Counter = 0; /* hop shorter than 1 ms of data */
+      }
+      ret = 1;
+      SLocInternal->Buffer_State = 1;
+      /* oldest sample of the window */
+      if(SLocInternal->Input_Counter >= SLocInternal->Sample_Number_To_Process)
+      {
+        SLocInternal->Frame_Start = SLocInternal->Input_Counter - (uint16_t)SLocInternal->Sample_Number_To_Process;
+      }
+      else
+      {
+        SLocInternal->Frame_Start = (uint16_t)((SLocInternal->Input_Counter + SLocInternal->Ring_Size) - SLocInternal->Sample_Number_To_Process);
+      }
+      SLocInternal->Frame_Event_Sum = SLocInternal->Event_Sum;
+      SLocInternal->Frame_Seq++;
+    }
+  }
   else
   {
     if(SLocInternal->Input_Counter == SLocInternal->Sample_Number_To_Store)
@@ -662,6 +870,8 @@ static uint32_t libSoundSourceLoc_Process(int32_t * Estimated_Angle, AcousticSL_
   
   int32_t Estimated_temp_360[2];
   
+  SLocInternal->SRP_Map_Valid = 0;
+  SLocInternal->Frame_Overrun = 0;
   if(SLocInternal->Buffer_State!=0U)
   {
     if((SLocInternal->Type==ACOUSTIC_SL_ALGORITHM_BMPH) || (SLocInternal->Callbacks.CheckEventFunction(SLocInternal)==1))
@@ -681,10 +891,17 @@ static uint32_t libSoundSourceLoc_Process(int32_t * Estimated_Angle, AcousticSL_
       Estimated_temp_360[0]=-100;
     }
   }
-  else if(SLocInternal->Mic_Number==4U)
+  else if((SLocInternal->Mic_Number==4U) || (SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_SRPP))
   {
-    /*TODO: filter on the index instead (before angle computation)*/
-    FilterAngle((int32_t *)&Estimated_temp_360[0], SLocInternal->SourceLocFilterArray, 360 , FILTER_STEP_MAIN , FILTER_MAX_MAIN, FILTER_STEP_SEC ,FILTER_MAX_SEC);
+    if(SLocInternal->Tracker == ACOUSTIC_SL_TRACKER_ALPHA_BETA)
+    {
+      TrackAngle(SLocInternal, (int32_t *)&Estimated_temp_360[0], 360);
+    }
+    else
+    {
+      /*TODO: filter on the index instead (before angle computation)*/
+      FilterAngle((int32_t *)&Estimated_temp_360[0], SLocInternal->SourceLocFilterArray, 360 , FILTER_STEP_MAIN , FILTER_MAX_MAIN, FILTER_STEP_SEC ,FILTER_MAX_SEC);
+    }
     
     if(Estimated_temp_360[0]==-1)
     {
@@ -693,7 +910,14 @@ static uint32_t libSoundSourceLoc_Process(int32_t * Estimated_Angle, AcousticSL_
   }
   else
   {
-    FilterAngle((int32_t *)&Estimated_temp_360[0], SLocInternal->SourceLocFilterArray, 180 , 10 , 50, 8 ,20);
+    if(SLocInternal->Tracker == ACOUSTIC_SL_TRACKER_ALPHA_BETA)
+    {
+      TrackAngle(SLocInternal, (int32_t *)&Estimated_temp_360[0], 180);
+    }
+    else
+    {
+      FilterAngle((int32_t *)&Estimated_temp_360[0], SLocInternal->SourceLocFilterArray, 180 , 10 , 50, 8 ,20);
+    }
     if(Estimated_temp_360[0]==-1)
     {
       Estimated_temp_360[0]=-100;
@@ -705,7 +929,147 @@ static uint32_t libSoundSourceLoc_Process(int32_t * Estimated_Angle, AcousticSL_
   }
   
   Estimated_Angle[0] = Estimated_temp_360[0];
-  return 0;
+  return (SLocInternal->Frame_Overrun != 0U) ? ACOUSTIC_SL_OVERRUN_ERROR : 0U;
+}
+
+static uint32_t libSoundSourceLoc_ProcessMulti(AcousticSL_MultiOutput_t * pOutput, AcousticSL_Handler_t * pHandler)
+{
+  libSoundSourceLoc_Handler_Internal * SLocInternal = (libSoundSourceLoc_Handler_Internal *)(pHandler->pInternalMemory);
+  
+  uint32_t ret;
+  uint32_t i, k, map_length;
+  float32_t first_angle, step;
+  uint8_t circular;
+  int32_t min_separation;
+  
+  if((pOutput == NULL) || ((pOutput->pSources == NULL) && (pOutput->max_sources > 0U)))
+  {
+    return ACOUSTIC_SL_PROCESSING_ERROR;
+  }
+  
+  ret = libSoundSourceLoc_Process(&pOutput->estimated_angle, pHandler);
+  
+  pOutput->sources_number = 0;
+  pOutput->SRP_map_length = 0;
+  pOutput->SRP_map_first_angle = 0.0f;
+  pOutput->SRP_map_step = 0.0f;
+  pOutput->angular_velocity = 0.0f;
+  if((SLocInternal->Tracker == ACOUSTIC_SL_TRACKER_ALPHA_BETA) && (SLocInternal->Track_Valid == 1U))
+  {
+    pOutput->angular_velocity = SLocInternal->Track_Velocity;
+  }
+  
+  if(SLocInternal->SRP_Map_Valid == 0U)
+  {
+    return ret;
+  }
+  
+  if(SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_SRPP)
+  {
+    /*each point is a sum over all the pairs: evaluated once here, not at each read of the suppression below*/
+    SRP_Map_Update(SLocInternal);
+  }
+  
+  map_length = SRP_GetMapLength(SLocInternal, &first_angle, &step, &circular);
+  pOutput->SRP_map_first_angle = first_angle;
+  pOutput->SRP_map_step = step;
+  
+  if(pOutput->pSRP_map != NULL)
+  {
+    pOutput->SRP_map_length = (map_length < pOutput->SRP_map_size) ? map_length : pOutput->SRP_map_size;
+    for(i=0; i<pOutput->SRP_map_length; i++)
+    {
+      pOutput->pSRP_map[i] = SRP_GetMapValue(SLocInternal, i);
+    }
+  }
+  
+  min_separation = (pOutput->min_separation > 0U) ? (int32_t)pOutput->min_separation : (int32_t)ACOUSTIC_SL_DEFAULT_MIN_SEPARATION;
+  
+  /*NON-MAXIMUM SUPPRESSION: strongest local maximum not too close to the sources already found*/
+  for(k=0; k<pOutput->max_sources; k++)
+  {
+    float32_t peak_value = 0.0f;
+    int32_t peak_angle = 0;
+    uint8_t peak_found = 0;
+    
+    for(i=0; i<map_length; i++)
+    {
+      float32_t value = SRP_GetMapValue(SLocInternal, i);
+      float32_t prev = value;
+      float32_t next = -1.0f;
+      
+      if(i > 0U)
+      {
+        prev = SRP_GetMapValue(SLocInternal, i-1U);
+      }
+      else if(circular == 1U)
+      {
+        prev = SRP_GetMapValue(SLocInternal, map_length-1U);
+      }
+      else
+      {
+        /* first value of a 180 degrees map only has a right neighbour */
+      }
+      
+      if(i < (map_length-1U))
+      {
+        next = SRP_GetMapValue(SLocInternal, i+1U);
+      }
+      else if(circular == 1U)
+      {
+        next = SRP_GetMapValue(SLocInternal, 0);
+      }
+      else
+      {
+        /* last value of a 180 degrees map only has a left neighbour */
+      }
+      
+      if((value > peak_value) && (value >= prev) && (value > next))
+      {
+        int32_t angle = SRP_GetMapAngle(SLocInternal, i);
+        uint8_t suppressed = 0;
+        uint32_t j;
+        
+        for(j=0; j<k; j++)
+        {
+          int32_t distance = angle - pOutput->pSources[j].angle;
+          if(distance < 0)
+          {
+            distance = -distance;
+          }
+          if(circular == 1U)
+          {
+            distance %= 360;
+            if(distance > 180)
+            {
+              distance = 360 - distance;
+            }
+          }
+          if(distance < min_separation)
+          {
+            suppressed = 1;
+          }
+        }
+        
+        if(suppressed == 0U)
+        {
+          peak_value = value;
+          peak_angle = angle;
+          peak_found = 1;
+        }
+      }
+    }
+    
+    if(peak_found == 0U)
+    {
+      break;
+    }
+    pOutput->pSources[k].angle = peak_angle;
+    pOutput->pSources[k].confidence = SaturaH(peak_value, 1.0f);
+    pOutput->sources_number++;
+  }
+  
+  return ret;
 }
 
 static uint32_t libSoundSourceLoc_setConfig(AcousticSL_Handler_t * pHandler, AcousticSL_Config_t * pConfig)
@@ -719,7 +1083,7 @@ static uint32_t libSoundSourceLoc_setConfig(AcousticSL_Handler_t * pHandler, Aco
   {
     SLocInternal->resolution = pConfig->resolution;
   }
-  else if ( SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_GCCP)
+  else if ( (SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_GCCP) || (SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_SRPP) )
   {
     SLocInternal->resolution = MIN_RESOLUTION; /*Set default Value*/
     ret |= ACOUSTIC_SL_RESOLUTION_ERROR;
@@ -729,7 +1093,7 @@ static uint32_t libSoundSourceLoc_setConfig(AcousticSL_Handler_t * pHandler, Aco
     /* no other use cases are handled */
   }
   
-  if ( (SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_BMPH) && (pConfig->resolution < MIN_RESOLUTION) )
+  if ( ((SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_BMPH) || (SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_SRPP)) && (pConfig->resolution < MIN_RESOLUTION) )
   {
     SLocInternal->resolution = MIN_RESOLUTION; /*Set default Value*/
     ret |= ACOUSTIC_SL_RESOLUTION_ERROR;
@@ -746,6 +1110,37 @@ static uint32_t libSoundSourceLoc_setConfig(AcousticSL_Handler_t * pHandler, Aco
     ret |= ACOUSTIC_SL_THRESHOLD_ERROR;
   }
   
+  /*TRACKER*/
+  if( (pConfig->tracker == ACOUSTIC_SL_TRACKER_HISTOGRAM) || (pConfig->tracker == ACOUSTIC_SL_TRACKER_ALPHA_BETA) )
+  {
+    if(SLocInternal->Tracker != pConfig->tracker)
+    {
+      TrackReset(SLocInternal);
+    }
+    SLocInternal->Tracker = pConfig->tracker;
+  }
+  else
+  {
+    SLocInternal->Tracker = ACOUSTIC_SL_TRACKER_HISTOGRAM; /*Set default Value*/
+    ret |= ACOUSTIC_SL_TRACKER_ERROR;
+  }
+  
+  if( (pConfig->responsiveness > 0U) && (pConfig->responsiveness <= 100U) )
+  {
+    SLocInternal->Track_Responsiveness = pConfig->responsiveness;
+  }
+  else
+  {
+    SLocInternal->Track_Responsiveness = ACOUSTIC_SL_DEFAULT_RESPONSIVENESS; /*Set default Value*/
+    if(pConfig->responsiveness != 0U)
+    {
+      ret |= ACOUSTIC_SL_TRACKER_ERROR;
+    }
+  }
+  /* Benedict-Bordner gains: beta = alpha^2 / (2 - alpha) */
+  SLocInternal->Track_Alpha = (float32_t)SLocInternal->Track_Responsiveness/100.0f;
+  SLocInternal->Track_Beta = (SLocInternal->Track_Alpha*SLocInternal->Track_Alpha)/(2.0f - SLocInternal->Track_Alpha);
+  
   if (SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_BMPH)
   {
     if ( SLocInternal->Mic_Number == 2U )
@@ -758,6 +1153,14 @@ static uint32_t libSoundSourceLoc_setConfig(AcousticSL_Handler_t * pHandler, Aco
     Frequency_init(SLocInternal);
     SteeringMatrix_init(SLocInternal);
   }
+  else if (SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_SRPP)
+  {
+    SRP_Tdoa_init(SLocInternal);
+  }
+  else
+  {
+    /* no other use cases are handled */
+  }
   
   return ret;
 }
@@ -768,6 +1171,8 @@ static uint32_t libSoundSourceLoc_getConfig(AcousticSL_Handler_t * pHandler, Aco
   
   pConfig->resolution=SLocInternal->resolution;
   pConfig->threshold=SLocInternal->EVENT_THRESHOLD;
+  pConfig->tracker=SLocInternal->Tracker;
+  pConfig->responsiveness=SLocInternal->Track_Responsiveness;
   return 0;
 }
 
@@ -776,20 +1181,20 @@ static uint32_t CheckEvent(libSoundSourceLoc_Handler_Internal * SLocInternal)
   uint32_t ret = 0;
   uint32_t a1,b;
   a1=0;
-  for(b=0;b<SLocInternal->Sample_Number_To_Process;b++)
+  if(SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_XCORR)
   {
-    if(SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_XCORR)
+    for(b=0;b<SLocInternal->Sample_Number_To_Process;b++)
     {
       a1=a1+(uint32_t)Abs(((int16_t *)(SLocInternal->M1_Data))[((SLocInternal->Buffer_State-1)*SLocInternal->Sample_Number_To_Process)+b]);
     }
-    else if(SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_GCCP)
-    {
-      a1=a1+(uint32_t)Abs(((float32_t *)(SLocInternal->M1_Data))[((SLocInternal->Buffer_State-1)*SLocInternal->Sample_Number_To_Process)+b]);
-    }
-    else
-    {
-      /* no other use cases are handled */
-    }
+  }
+  else if((SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_GCCP) || (SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_SRPP))
+  {
+    a1=SLocInternal->Frame_Event_Sum; /* kept up to date by libSoundSourceLoc_Data_Input */
+  }
+  else
+  {
+    /* no other use cases are handled */
   }
   a1=a1/SLocInternal->Sample_Number_To_Process;
   
@@ -868,7 +1273,9 @@ static float32_t GCC_GetAngle(libSoundSourceLoc_Handler_Internal * SLocInternal,
 {
   uint32_t j;
   float32_t fi = 0.0f;;
-  uint32_t buffer_offset = (SLocInternal->Buffer_State-1U)*SLocInternal->Sample_Number_To_Process;
+  uint32_t buffer_offset = SLocInternal->Ring_Size; /* spectrum follows the ring buffer */
+  uint32_t seq = SLocInternal->Frame_Seq;
+  uint32_t ring_index = SLocInternal->Frame_Start;
   float32_t * M1_Data = (float32_t *)SLocInternal->M1_Data;
   float32_t * M2_Data = (float32_t *)SLocInternal->M2_Data;
   float32_t * M3_Data = (float32_t *)SLocInternal->M3_Data;
@@ -878,19 +1285,34 @@ static float32_t GCC_GetAngle(libSoundSourceLoc_Handler_Internal * SLocInternal,
   float32_t * hanning = (float32_t *)SLocInternal->window;
   float32_t tempMag = 1e-7f;
   /*WINDOWING*/
+  /*all mics are unwrapped from the oldest sample on. The ring keeps the window intact until the next trigger: if
+    one occurred meanwhile, the copy may hold overwritten samples and the frame is dropped*/
   for(j=0;j<SLocInternal->Sample_Number_To_Process;j++)
   {
     if(SLocInternal->Mic_Number >= 2U)
     {
-      M1_Data[buffer_offset + j] *= hanning[j];
-      M2_Data[buffer_offset + j] *= hanning[j];
+      M1_Data[buffer_offset + j] = M1_Data[ring_index] * hanning[j];
+      M2_Data[buffer_offset + j] = M2_Data[ring_index] * hanning[j];
     }
     if(SLocInternal->Mic_Number == 4U)
     {
-      M3_Data[buffer_offset + j] *= hanning[j];
-      M4_Data[buffer_offset + j] *= hanning[j];
+      M3_Data[buffer_offset + j] = M3_Data[ring_index] * hanning[j];
+      M4_Data[buffer_offset + j] = M4_Data[ring_index] * hanning[j];
+    }
+    ring_index++;
+    if(ring_index == SLocInternal->Ring_Size)
+    {
+      ring_index = 0;
     }
   }
+  if(SLocInternal->Frame_Seq != seq)
+  {
+    SLocInternal->Frame_Overrun = 1;
+    SLocInternal->Buffer_State=0;
+    out_angles[0]=-1;
+    out_angles[1]=-1;
+    return -1.0f;
+  }
   /*FFTs*/
   if(SLocInternal->Mic_Number >= 2U)
   {
@@ -985,6 +1407,12 @@ static float32_t GCC_GetAngle(libSoundSourceLoc_Handler_Internal * SLocInternal,
     
     SLocInternal->Estimated_Angle_12=get_max_pos(SLocInternal,(int32_t)anglesNum,(((int32_t)anglesNum/40)+1));
     SLocInternal->Estimated_Angle_12= 180-(int32_t)floor((180.0/((float64_t)anglesNum*2.0))+((float64_t)SLocInternal->Estimated_Angle_12*(float64_t)(SLocInternal->resolution)));
+    
+    if(SLocInternal->Mic_Number == 4U)
+    {
+      /* M34 overwrites Phase: keep M12 curve for the multi-source map */
+      (void)memcpy(SLocInternal->Phase12, SLocInternal->Phase, (uint32_t)anglesNum*sizeof(float32_t));
+    }
   }
   if(SLocInternal->Mic_Number == 4U)
   {
@@ -1033,6 +1461,7 @@ static float32_t GCC_GetAngle(libSoundSourceLoc_Handler_Internal * SLocInternal,
   }
   float32_t angle_out_f = 0.0f;
   
+  SLocInternal->SRP_Map_Valid = 1;
   if(SLocInternal->Mic_Number == 2U)
   {
     angle_out_f=(float32_t)SLocInternal->Estimated_Angle_12;
@@ -1041,6 +1470,7 @@ static float32_t GCC_GetAngle(libSoundSourceLoc_Handler_Internal * SLocInternal,
   {
     if((SLocInternal->Estimated_Angle_12 + SLocInternal->Estimated_Angle_34) < (90 - ((int32_t)SLocInternal->resolution * 2)))
     {
+      SLocInternal->Buffer_State=0;
       out_angles[0]=-1;
       out_angles[1]=-1;
       return -1.0f;
@@ -1116,6 +1546,143 @@ static int32_t get_max_pos(libSoundSourceLoc_Handler_Internal * SLocInternal,int
   return maxPos;
 }
 
+/*Number of points of the steered response map, with the angle of the first one and the angular step*/
+static uint32_t SRP_GetMapLength(libSoundSourceLoc_Handler_Internal * SLocInternal, float32_t * first_angle, float32_t * step, uint8_t * circular)
+{
+  uint32_t length = 0;
+  
+  *first_angle = 0.0f;
+  *step = 0.0f;
+  *circular = 0;
+  
+  if(SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_GCCP)
+  {
+    *step = (float32_t)SLocInternal->resolution;
+    if(SLocInternal->Mic_Number == 4U)
+    {
+      length = 360U/SLocInternal->resolution;
+      *circular = 1;
+    }
+    else
+    {
+      length = 180U/SLocInternal->resolution;
+      *first_angle = (float32_t)SRP_GetMapAngle(SLocInternal, 0);
+    }
+  }
+  else if(SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_BMPH)
+  {
+    length = SLocInternal->num_of_angles;
+    *first_angle = (float32_t)adjust_output_angle(SLocInternal->theta[0], SLocInternal->array_type);
+    if(SLocInternal->array_type == LINEAR_ARRAY)
+    {
+      *step = 180.0f/((float32_t)length-1.0f);
+    }
+    else
+    {
+      *step = -360.0f/(float32_t)length;
+      *circular = 1;
+    }
+  }
+  else if(SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_SRPP)
+  {
+    length = SLocInternal->num_of_angles;
+    *step = (float32_t)SLocInternal->resolution;
+    *circular = 1;
+  }
+  else
+  {
+    /* no other use cases are handled */
+  }
+  return length;
+}
+
+/*Normalized steered response: PHAT coherence for GCC-PHAT and SRP-PHAT, block energy over its upper bound for BMPH*/
+static float32_t SRP_GetMapValue(libSoundSourceLoc_Handler_Internal * SLocInternal, uint32_t index)
+{
+  float32_t value = 0.0f;
+  
+  if(SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_GCCP)
+  {
+    int32_t anglesNum = 180/(int32_t)SLocInternal->resolution;
+    float32_t bins = (float32_t)(SLocInternal->Sample_Number_To_Process/8U);
+    
+    if(SLocInternal->Mic_Number == 4U)
+    {
+      /*pair angles giving back this azimuth through atan2(cos(angle_12), cos(angle_34))*/
+      int32_t azimuth = (int32_t)index*(int32_t)SLocInternal->resolution;
+      int32_t angle_12 = 90 - azimuth;
+      int32_t angle_34 = (azimuth > 180) ? (360 - azimuth) : azimuth;
+      int32_t index_12, index_34;
+      
+      if(angle_12 < -180)
+      {
+        angle_12 += 360;
+      }
+      if(angle_12 < 0)
+      {
+        angle_12 = -angle_12;
+      }
+      index_12 = SaturaH((180 - angle_12)/(int32_t)SLocInternal->resolution, anglesNum - 1);
+      index_34 = SaturaH((180 - angle_34)/(int32_t)SLocInternal->resolution, anglesNum - 1);
+      value = (SLocInternal->Phase12[index_12] + SLocInternal->Phase[index_34])/(2.0f*bins);
+    }
+    else
+    {
+      value = SLocInternal->Phase[anglesNum - 1 - (int32_t)index]/bins;
+    }
+  }
+  else if(SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_BMPH)
+  {
+    if(SLocInternal->energy_norm > 0.0f)
+    {
+      value = SLocInternal->energy_theta[index]/SLocInternal->energy_norm;
+    }
+  }
+  else if(SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_SRPP)
+  {
+    /*azimuth scan at the elevation of the last estimate, filled by SRP_Map_Update*/
+    value = SLocInternal->SRP_Map[index];
+  }
+  else
+  {
+    /* no other use cases are handled */
+  }
+  return value;
+}
+
+/*Angle of a steered response map point, with the same reference of libSoundSourceLoc_Process output*/
+static int32_t SRP_GetMapAngle(libSoundSourceLoc_Handler_Internal * SLocInternal, uint32_t index)
+{
+  int32_t angle = 0;
+  
+  if(SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_GCCP)
+  {
+    int32_t resolution = (int32_t)SLocInternal->resolution;
+    
+    if(SLocInternal->Mic_Number == 4U)
+    {
+      angle = (int32_t)index*resolution;
+    }
+    else
+    {
+      angle = 90 - (resolution/2) - (((180/resolution) - 1 - (int32_t)index)*resolution);
+    }
+  }
+  else if(SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_BMPH)
+  {
+    angle = (int32_t)adjust_output_angle(SLocInternal->theta[index], SLocInternal->array_type);
+  }
+  else if(SLocInternal->Type == ACOUSTIC_SL_ALGORITHM_SRPP)
+  {
+    angle = (int32_t)index*(int32_t)SLocInternal->resolution;
+  }
+  else
+  {
+    /* no other use cases are handled */
+  }
+  return angle;
+}
+
 /*LedStatus is a 32 bit signed array of minimum dimension = max_value + 1*/
 /*Source Angle is a number from 0 to max_value and -1 is for no source*/
 static void FilterAngle(int32_t *SourceAngle, int32_t* LedStatus, uint16_t max_value, uint16_t A, uint16_t SatA, uint16_t B, uint16_t SatB)
@@ -1166,5 +1733,87 @@ static void FilterAngle(int32_t *SourceAngle, int32_t* LedStatus, uint16_t max_v
 }
 
 
+/*Alpha-beta tracker, same interface of FilterAngle: Source Angle is a number from 0 to max_value and -1 is for no source*/
+/*With max_value = 360 the angle wraps on the circle, otherwise it is saturated to [0, max_value]*/
+static void TrackAngle(libSoundSourceLoc_Handler_Internal * SLocInternal, int32_t *SourceAngle, uint16_t max_value)
+{
+  float32_t range = (float32_t)max_value;
+  float32_t predicted, residual;
+  
+  if(*SourceAngle == -1)
+  {
+    if(SLocInternal->Track_Valid == 1U)
+    {
+      SLocInternal->Track_Misses++;
+      if(((float32_t)SLocInternal->Track_Misses*SLocInternal->Track_Period) > TRACKER_HOLD_TIME)
+      {
+        TrackReset(SLocInternal);
+      }
+      else
+      {
+        /*hold the last direction, the talker is assumed to pause rather than to move*/
+        SLocInternal->Track_Velocity *= TRACKER_VELOCITY_DECAY;
+        *SourceAngle = TrackRound(SLocInternal->Track_Angle, max_value);
+      }
+    }
+  }
+  else if(SLocInternal->Track_Valid == 0U)
+  {
+    SLocInternal->Track_Angle = (float32_t)*SourceAngle;
+    SLocInternal->Track_Velocity = 0.0f;
+    SLocInternal->Track_Misses = 0;
+    SLocInternal->Track_Valid = 1;
+  }
+  else
+  {
+    predicted = SLocInternal->Track_Angle + (SLocInternal->Track_Velocity*SLocInternal->Track_Period);
+    residual = (float32_t)*SourceAngle - predicted;
+    if(max_value == 360U)
+    {
+      /*shortest way around the circle*/
+      residual -= 360.0f*floorf((residual + 180.0f)/360.0f);
+    }
+    
+    SLocInternal->Track_Angle = predicted + (SLocInternal->Track_Alpha*residual);
+    SLocInternal->Track_Velocity += (SLocInternal->Track_Beta*residual)/SLocInternal->Track_Period;
+    SLocInternal->Track_Misses = 0;
+    
+    if(max_value == 360U)
+    {
+      SLocInternal->Track_Angle -= 360.0f*floorf(SLocInternal->Track_Angle/360.0f);
+    }
+    else if((SLocInternal->Track_Angle < 0.0f) || (SLocInternal->Track_Angle > range))
+    {
+      SLocInternal->Track_Angle = SaturaLH(SLocInternal->Track_Angle, 0.0f, range);
+      SLocInternal->Track_Velocity = 0.0f;
+    }
+    else
+    {
+      /* tracking inside the range */
+    }
+    *SourceAngle = TrackRound(SLocInternal->Track_Angle, max_value);
+  }
+}
+
+/*Nearest degree of the tracked angle: on the circle, 359.5 and above round to 0, not to 360*/
+static int32_t TrackRound(float32_t angle, uint16_t max_value)
+{
+  int32_t rounded = (int32_t)(angle + 0.5f);
+  
+  if((max_value == 360U) && (rounded >= 360))
+  {
+    rounded -= 360;
+  }
+  return rounded;
+}
+
+static void TrackReset(libSoundSourceLoc_Handler_Internal * SLocInternal)
+{
+  SLocInternal->Track_Valid = 0;
+  SLocInternal->Track_Misses = 0;
+  SLocInternal->Track_Angle = 0.0f;
+  SLocInternal->Track_Velocity = 0.0f;
+}
+
 #endif /*__LIB_SOUNDSOURCELOC_H*/
 
@@ -0,0 +1,496 @@
+/**
+******************************************************************************
+* @file    srp_phat.c
+* @author  SRA
+* @brief   Sound Source Localization based on SRP-PHAT for arbitrary geometries
+******************************************************************************
+* @attention
+*
+* Copyright (c) 2022 STMicroelectronics.
+* All rights reserved.
+*
+* This software is licensed under terms that can be found in the LICENSE file in
+* the root directory of this software component.
+* If no LICENSE file comes with this software, it is provided AS-IS.
+*
+*
+******************************************************************************
+*/
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __SRP_PHAT_H
+#define __SRP_PHAT_H
+
+#define SRP_COARSE_STEP                 4U      /* coarse grid uses one azimuth every SRP_COARSE_STEP */
+#define SRP_ELEVATION_STEP              10U     /* degrees between two elevation rings */
+#define SRP_MAX_ELEVATIONS              (90U/SRP_ELEVATION_STEP) /* rings from 0 to 80 degrees */
+#define SRP_DEFAULT_RADIUS              200     /* decimals of a millimeter */
+#define SRP_OVERSAMPLING                8U      /* steps of the pair correlations within one sample */
+#define SRP_INTERP_TAPS                 8U      /* windowed sinc interpolating the correlations between two lags */
+#define SRP_BINS(N)                     ((N)/8U) /* same band as GCC-PHAT: up to fs/8, where speech carries most of its energy */
+
+#include "arm_math.h"
+
+static void SRP_GetSetup(AcousticSL_Handler_t * pHandler, uint32_t * samples, uint32_t * ring, uint32_t * mics, uint32_t * max_lag, uint32_t * oversampling, uint32_t * elevations);
+static uint32_t SRP_GetMemorySize(AcousticSL_Handler_t * pHandler);
+static uint32_t SRP_Init(AcousticSL_Handler_t * pHandler, libSoundSourceLoc_Handler_Internal * SLocInternal, uint32_t * byte_offset);
+static void SRP_Tdoa_init(libSoundSourceLoc_Handler_Internal * SLocInternal);
+static float32_t SRPP_GetAngle(libSoundSourceLoc_Handler_Internal * SLocInternal, int32_t * out_angles);
+static float32_t SRP_Evaluate(libSoundSourceLoc_Handler_Internal * SLocInternal, uint32_t grid_index, uint8_t coarse);
+static void SRP_Map_Update(libSoundSourceLoc_Handler_Internal * SLocInternal);
+
+/* Static sizes derived from the handler, with the same defaults applied by the Init */
+static void SRP_GetSetup(AcousticSL_Handler_t * pHandler, uint32_t * samples, uint32_t * ring, uint32_t * mics, uint32_t * max_lag, uint32_t * oversampling, uint32_t * elevations)
+{
+  uint32_t fs = pHandler->sampling_frequency;
+  uint32_t hop;
+  uint32_t i, j, k;
+  float32_t max_distance = 0.0f;
+
+  *samples = (uint32_t)pHandler->samples_to_process;
+  if( (*samples != 32U) && (*samples != 64U) && (*samples != 128U) && (*samples != 256U) &&
+     (*samples != 512U) && (*samples != 1024U) && (*samples != 2048U) && (*samples != 4096U) )
+  {
+    *samples = 256;
+  }
+
+  *mics = pHandler->channel_number;
+  if( (*mics < 2U) || (*mics > ACOUSTIC_SL_SRPP_MAX_CHANNELS) )
+  {
+    *mics = 2;
+  }
+
+  if( (fs != 16000U) && (fs != 32000U) && (fs != 48000U) )
+  {
+    fs = 16000;
+  }
+
+  hop = *samples;
+  if( (pHandler->hop_size > 0U) && ((uint32_t)pHandler->hop_size <= *samples) )
+  {
+    hop = pHandler->hop_size;
+  }
+  *ring = RING_SIZE(*samples, hop, fs/1000U);
+
+  *elevations = 1;
+  for(i=0; i<*mics; i++)
+  {
+    if(pHandler->mic_coordinates[i][2] != 0)
+    {
+      *elevations = SRP_MAX_ELEVATIONS;
+    }
+    for(j=i+1U; j<*mics; j++)
+    {
+      float32_t d2 = 0.0f;
+      for(k=0; k<3U; k++)
+      {
+        float32_t d = (float32_t)pHandler->mic_coordinates[j][k] - (float32_t)pHandler->mic_coordinates[i][k];
+        d2 += d*d;
+      }
+      if(d2 > max_distance)
+      {
+        max_distance = d2;
+      }
+    }
+  }
+
+  if(max_distance > 0.0f)
+  {
+    max_distance = sqrtf(max_distance);
+  }
+  else
+  {
+    max_distance = 2.0f*(float32_t)SRP_DEFAULT_RADIUS; /* default circular array */
+  }
+
+  /* one sample of margin for the rounding of the lookup grid */
+  *max_lag = (uint32_t)(((max_distance/10000.0f)*(float32_t)fs)/SOUND_SPEED) + 1U;
+  if(*max_lag > ((*samples/2U) - 1U))
+  {
+    *max_lag = (*samples/2U) - 1U;
+  }
+  if(*max_lag > 127U)
+  {
+    *max_lag = 127U; /* lags are stored on 8 bits in the lookup grid */
+  }
+
+  /* fractional lags: small arrays span a few samples only, a whole sample step would leave a coarse azimuth grid */
+  *oversampling = SRP_OVERSAMPLING;
+  while((*oversampling > 1U) && ((*max_lag * *oversampling) > 127U))
+  {
+    *oversampling /= 2U;
+  }
+}
+
+static uint32_t SRP_GetMemorySize(AcousticSL_Handler_t * pHandler)
+{
+  uint32_t samples, ring, mics, max_lag, oversampling, elevations, pairs;
+  uint32_t byte_offset = 0;
+
+  SRP_GetSetup(pHandler, &samples, &ring, &mics, &max_lag, &oversampling, &elevations);
+  pairs = (mics*(mics-1U))/2U;
+
+  byte_offset+=mics*(ring + samples)*sizeof(float32_t);  /* ring buffer + spectrum for each mic in bytes */
+  byte_offset+=sizeof(arm_rfft_fast_instance_f32); /* arm_rfft_instance_f32 size in bytes */
+  byte_offset+=samples*sizeof(float32_t);  /* size of Buff for FFT output in bytes */
+  byte_offset+=samples*sizeof(float32_t);  /* size of Buff for IFFT output in bytes */
+  byte_offset+=samples*sizeof(float32_t);  /* size of Buff for Window in bytes */
+  byte_offset+=3U*ACOUSTIC_SL_SRPP_MAX_CHANNELS*sizeof(float32_t);  /* mic coordinates in bytes */
+  byte_offset+=pairs*((2U*max_lag*oversampling)+1U)*sizeof(float32_t);  /* GCC-PHAT fractional lags of each pair in bytes */
+  byte_offset+=oversampling*SRP_INTERP_TAPS*sizeof(float32_t);  /* interpolation filters in bytes */
+  byte_offset+=MAX_NUM_OF_ANGLES*sizeof(float32_t);  /* steered response map in bytes */
+  byte_offset+=(((MAX_NUM_OF_ANGLES*elevations*pairs)+3U)/4U)*4U;  /* TDOA lookup grid in bytes */
+
+  return byte_offset;
+}
+
+/* Carve the SRP-PHAT buffers starting at byte_offset, which is moved to the first free byte */
+static uint32_t SRP_Init(AcousticSL_Handler_t * pHandler, libSoundSourceLoc_Handler_Internal * SLocInternal, uint32_t * byte_offset)
+{
+  uint32_t samples, ring, mics, max_lag, oversampling, elevations;
+  uint32_t i, k;
+  uint8_t valid_geometry = 0;
+  uint32_t ret = 0;
+
+  SRP_GetSetup(pHandler, &samples, &ring, &mics, &max_lag, &oversampling, &elevations);
+  SLocInternal->SRP_Pairs = (uint16_t)((mics*(mics-1U))/2U);
+  SLocInternal->SRP_Max_Lag = (uint16_t)max_lag;
+  SLocInternal->SRP_Oversampling = (uint16_t)oversampling;
+  SLocInternal->SRP_Elevations = (uint16_t)elevations;
+  SLocInternal->SRP_Elevation_Index = 0;
+
+  SLocInternal->SRP_Data=(float32_t *)((uint8_t *)pHandler->pInternalMemory+*byte_offset);
+  *byte_offset+=mics*(ring + samples)*sizeof(float32_t);  /* ring buffer + spectrum for each mic in bytes */
+
+  SLocInternal->SFast=(arm_rfft_fast_instance_f32 *)(((uint8_t *)pHandler->pInternalMemory+*byte_offset));
+  *byte_offset+=sizeof(arm_rfft_fast_instance_f32); /* arm_rfft_instance_f32 size in bytes */
+
+  SLocInternal->FFT_Out=(float32_t *)((uint8_t *)pHandler->pInternalMemory+*byte_offset);
+  *byte_offset+=samples*sizeof(float32_t);  /* size of Buff for FFT output in bytes */
+
+  SLocInternal->PowerSpectrum=(float32_t *)((uint8_t *)pHandler->pInternalMemory+*byte_offset);
+  *byte_offset+=samples*sizeof(float32_t);  /* size of Buff for IFFT output in bytes */
+
+  SLocInternal->window=(float32_t *)((uint8_t *)pHandler->pInternalMemory+*byte_offset);
+  *byte_offset+=samples*sizeof(float32_t);  /* size of Buff for Window in bytes */
+
+  SLocInternal->mic_coordinates=(float32_t *)((uint8_t *)pHandler->pInternalMemory+*byte_offset);
+  *byte_offset+=3U*ACOUSTIC_SL_SRPP_MAX_CHANNELS*sizeof(float32_t);  /* mic coordinates in bytes */
+
+  SLocInternal->SRP_Corr=(float32_t *)((uint8_t *)pHandler->pInternalMemory+*byte_offset);
+  *byte_offset+=(uint32_t)SLocInternal->SRP_Pairs*((2U*max_lag*oversampling)+1U)*sizeof(float32_t);  /* GCC-PHAT fractional lags of each pair in bytes */
+
+  SLocInternal->SRP_Interp=(float32_t *)((uint8_t *)pHandler->pInternalMemory+*byte_offset);
+  *byte_offset+=oversampling*SRP_INTERP_TAPS*sizeof(float32_t);  /* interpolation filters in bytes */
+
+  SLocInternal->SRP_Map=(float32_t *)((uint8_t *)pHandler->pInternalMemory+*byte_offset);
+  *byte_offset+=MAX_NUM_OF_ANGLES*sizeof(float32_t);  /* steered response map in bytes */
+
+  SLocInternal->SRP_Tdoa=(int8_t *)((uint8_t *)pHandler->pInternalMemory+*byte_offset);
+  *byte_offset+=(((MAX_NUM_OF_ANGLES*elevations*(uint32_t)SLocInternal->SRP_Pairs)+3U)/4U)*4U;  /* TDOA lookup grid in bytes */
+
+  /*GEOMETRY*/
+  for(i=0; i<mics; i++)
+  {
+    for(k=0; k<3U; k++)
+    {
+      SLocInternal->mic_coordinates[(3U*i)+k] = (float32_t)pHandler->mic_coordinates[i][k]/10000.0f;
+      if(pHandler->mic_coordinates[i][k] != pHandler->mic_coordinates[0][k])
+      {
+        valid_geometry = 1;
+      }
+    }
+  }
+  if(valid_geometry == 0U)
+  {
+    /*Set default Value: uniform circular array*/
+    for(i=0; i<mics; i++)
+    {
+      float32_t angle = (2.0f*PI*(float32_t)i)/(float32_t)mics;
+      SLocInternal->mic_coordinates[(3U*i)+0U] = arm_cos_f32(angle)*(float32_t)SRP_DEFAULT_RADIUS/10000.0f;
+      SLocInternal->mic_coordinates[(3U*i)+1U] = arm_sin_f32(angle)*(float32_t)SRP_DEFAULT_RADIUS/10000.0f;
+      SLocInternal->mic_coordinates[(3U*i)+2U] = 0.0f;
+    }
+    ret |= ACOUSTIC_SL_DISTANCE_ERROR;
+  }
+
+  /*Init FFt function*/
+  (void)arm_rfft_fast_init_f32(SLocInternal->SFast, (uint16_t)samples);
+
+  /*Init Hann window*/
+  for ( i = 0; i < samples; i++)
+  {
+    SLocInternal->window[i]=0.5f*(1.0f-arm_cos_f32((2.0f*PI*(float32_t)i)/((float32_t)samples-1.0f)));
+  }
+
+  /*Init Hann windowed sinc, one filter per fraction of a lag, taps on the lags from -TAPS/2+1 to TAPS/2 around it.
+    The gain brings the peak of a coherent pair to 1 over the bins in use*/
+  for (i = 0; i < oversampling; i++)
+  {
+    float32_t * filter = &SLocInternal->SRP_Interp[i*SRP_INTERP_TAPS];
+    float32_t sum = 0.0f;
+    for (k = 0; k < SRP_INTERP_TAPS; k++)
+    {
+      float32_t x = ((float32_t)i/(float32_t)oversampling) - ((float32_t)k - ((float32_t)SRP_INTERP_TAPS/2.0f) + 1.0f);
+      float32_t w = 0.5f*(1.0f+arm_cos_f32((2.0f*PI*x)/(float32_t)SRP_INTERP_TAPS));
+      filter[k] = (x == 0.0f) ? 1.0f : (w*arm_sin_f32(PI*x)/(PI*x));
+      sum += filter[k];
+    }
+    sum *= 2.0f*(float32_t)(SRP_BINS(samples) - 1U)/(float32_t)samples;
+    for (k = 0; k < SRP_INTERP_TAPS; k++)
+    {
+      filter[k] /= sum;
+    }
+  }
+
+  return ret;
+}
+
+/* Precompute the TDOA of every mic pair for every direction of the search grid */
+static void SRP_Tdoa_init(libSoundSourceLoc_Handler_Internal * SLocInternal)
+{
+  uint32_t n, e, i, j, p;
+  float32_t samples_per_meter = (float32_t)SLocInternal->sampling_frequency/SOUND_SPEED;
+  uint32_t max_lag = (uint32_t)SLocInternal->SRP_Max_Lag*SLocInternal->SRP_Oversampling;
+  float32_t max_tau = 0.0f;
+
+  SLocInternal->num_of_angles = (uint16_t)(360U/SLocInternal->resolution);
+
+  for(e=0; e<SLocInternal->SRP_Elevations; e++)
+  {
+    float32_t elevation = (PI*(float32_t)(e*SRP_ELEVATION_STEP))/180.0f;
+    for(n=0; n<SLocInternal->num_of_angles; n++)
+    {
+      float32_t azimuth = (PI*(float32_t)(n*SLocInternal->resolution))/180.0f;
+      float32_t u[3];
+      u[0] = arm_cos_f32(elevation)*arm_cos_f32(azimuth);
+      u[1] = arm_cos_f32(elevation)*arm_sin_f32(azimuth);
+      u[2] = arm_sin_f32(elevation);
+
+      p = 0;
+      for(i=0; i<SLocInternal->Mic_Number; i++)
+      {
+        for(j=i+1U; j<SLocInternal->Mic_Number; j++)
+        {
+          /* far field: mic i hears the source (p_j - p_i).u/c after mic j */
+          float32_t tau = 0.0f;
+          int32_t lag;
+          uint32_t k;
+          for(k=0; k<3U; k++)
+          {
+            tau += (SLocInternal->mic_coordinates[(3U*j)+k] - SLocInternal->mic_coordinates[(3U*i)+k])*u[k];
+          }
+          tau *= samples_per_meter*(float32_t)SLocInternal->SRP_Oversampling;
+          if(fabsf(tau) > max_tau)
+          {
+            max_tau = fabsf(tau);
+          }
+          lag = (tau >= 0.0f) ? (int32_t)(tau + 0.5f) : -(int32_t)(0.5f - tau);
+          lag = SaturaLH(lag, -(int32_t)max_lag, (int32_t)max_lag);
+          SLocInternal->SRP_Tdoa[(((e*SLocInternal->num_of_angles)+n)*SLocInternal->SRP_Pairs)+p] = (int8_t)lag;
+          p++;
+        }
+      }
+    }
+  }
+
+  /* a TDOA moves by at most max_tau per radian of azimuth: tolerance of the coarse pass over half a coarse step */
+  SLocInternal->SRP_Coarse_Span = (uint16_t)((max_tau*PI*(float32_t)(SRP_COARSE_STEP*SLocInternal->resolution))/360.0f) + 1U;
+}
+
+/* Normalized steered response of a grid point. The coarse pass takes the maximum of each pair over the lags
+   reached within half a coarse step, so that peaks falling between two coarse directions are not missed */
+static float32_t SRP_Evaluate(libSoundSourceLoc_Handler_Internal * SLocInternal, uint32_t grid_index, uint8_t coarse)
+{
+  const int8_t * tdoa = &SLocInternal->SRP_Tdoa[grid_index*SLocInternal->SRP_Pairs];
+  int32_t max_lag = (int32_t)SLocInternal->SRP_Max_Lag*(int32_t)SLocInternal->SRP_Oversampling;
+  int32_t span = (coarse == 1U) ? (int32_t)SLocInternal->SRP_Coarse_Span : 0;
+  float32_t sum = 0.0f;
+  uint32_t p;
+
+  for(p=0; p<SLocInternal->SRP_Pairs; p++)
+  {
+    const float32_t * corr = &SLocInternal->SRP_Corr[(uint32_t)p*(uint32_t)((2*max_lag)+1)];
+    int32_t first = SaturaLH((int32_t)tdoa[p] - span, -max_lag, max_lag);
+    int32_t last = SaturaLH((int32_t)tdoa[p] + span, -max_lag, max_lag);
+    float32_t value = corr[max_lag + (int32_t)tdoa[p]];
+    int32_t lag;
+
+    for(lag=first; lag<=last; lag++)
+    {
+      if(corr[max_lag + lag] > value)
+      {
+        value = corr[max_lag + lag];
+      }
+    }
+    sum += value;
+  }
+  return sum/(float32_t)SLocInternal->SRP_Pairs;
+}
+
+/* Steered response of every azimuth at the elevation of the last estimate, evaluated once for the map readers:
+   the search of SRPP_GetAngle only visits a coarse grid and the neighbourhood of its best point */
+static void SRP_Map_Update(libSoundSourceLoc_Handler_Internal * SLocInternal)
+{
+  uint32_t base = (uint32_t)SLocInternal->SRP_Elevation_Index*SLocInternal->num_of_angles;
+  uint32_t n;
+
+  for(n=0; n<SLocInternal->num_of_angles; n++)
+  {
+    SLocInternal->SRP_Map[n] = SRP_Evaluate(SLocInternal, base+n, 0);
+  }
+}
+
+/* Estimate azimuth and elevation of the strongest source */
+static float32_t SRPP_GetAngle(libSoundSourceLoc_Handler_Internal * SLocInternal, int32_t * out_angles)
+{
+  uint32_t N = SLocInternal->Sample_Number_To_Process;
+  uint32_t R = SLocInternal->Ring_Size;
+  uint32_t K = SLocInternal->SRP_Oversampling;
+  int32_t max_lag = (int32_t)SLocInternal->SRP_Max_Lag*(int32_t)K;
+  uint32_t width = (uint32_t)((2*max_lag)+1);
+  uint32_t seq = SLocInternal->Frame_Seq;
+  uint32_t ring_index = SLocInternal->Frame_Start;
+  uint32_t i, j, m, e, n, p;
+  float32_t * Data = SLocInternal->SRP_Data;
+  float32_t best_value;
+  int32_t best_n = 0;
+  int32_t best_e = 0;
+  int32_t coarse_n, coarse_e, dn, de;
+
+  /*WINDOWING*/
+  /*all mics are unwrapped from the oldest sample on, the frame is dropped if it was overwritten meanwhile*/
+  for(j=0; j<N; j++)
+  {
+    for(m=0; m<SLocInternal->Mic_Number; m++)
+    {
+      Data[(m*(R + N)) + R + j] = Data[(m*(R + N)) + ring_index] * SLocInternal->window[j];
+    }
+    ring_index++;
+    if(ring_index == R)
+    {
+      ring_index = 0;
+    }
+  }
+  if(SLocInternal->Frame_Seq != seq)
+  {
+    SLocInternal->Frame_Overrun = 1;
+    SLocInternal->Buffer_State = 0;
+    out_angles[0] = -1;
+    out_angles[1] = -1;
+    return -1.0f;
+  }
+
+  /*FFTs, shared by all pairs: PHAT weighting is applied once per channel, on the bins in use*/
+  for(m=0; m<SLocInternal->Mic_Number; m++)
+  {
+    float32_t * Spectrum = &Data[(m*(R + N)) + R];
+    arm_rfft_fast_f32(SLocInternal->SFast, Spectrum, SLocInternal->FFT_Out, 0);
+    Spectrum[0] = 0.0f;
+    Spectrum[1] = 0.0f;
+    for(j=1; j<SRP_BINS(N); j++)
+    {
+      float32_t re = SLocInternal->FFT_Out[2U*j];
+      float32_t im = SLocInternal->FFT_Out[(2U*j)+1U];
+      float32_t mag = sqrtf((re*re) + (im*im));
+      if(mag < 1e-7f)
+      {
+        mag = 1e-7f;
+      }
+      Spectrum[2U*j] = re/mag;
+      Spectrum[(2U*j)+1U] = im/mag;
+    }
+  }
+
+  /*GCC-PHAT OF EACH PAIR, only the lags reachable by the geometry are kept, interpolated to 1/K of a sample*/
+  p = 0;
+  for(i=0; i<SLocInternal->Mic_Number; i++)
+  {
+    float32_t * Wi = &Data[(i*(R + N)) + R];
+    for(j=i+1U; j<SLocInternal->Mic_Number; j++)
+    {
+      float32_t * Wj = &Data[(j*(R + N)) + R];
+      float32_t * corr = &SLocInternal->SRP_Corr[p*width];
+      int32_t lag;
+
+      arm_fill_f32(0.0f, SLocInternal->FFT_Out, N);
+      for(n=1; n<SRP_BINS(N); n++)
+      {
+        SLocInternal->FFT_Out[2U*n] = (Wi[2U*n]*Wj[2U*n]) + (Wi[(2U*n)+1U]*Wj[(2U*n)+1U]);
+        SLocInternal->FFT_Out[(2U*n)+1U] = (Wi[(2U*n)+1U]*Wj[2U*n]) - (Wi[2U*n]*Wj[(2U*n)+1U]);
+      }
+      arm_rfft_fast_f32(SLocInternal->SFast, SLocInternal->FFT_Out, SLocInternal->PowerSpectrum, 1);
+
+      for(lag=-max_lag; lag<=max_lag; lag++)
+      {
+        /*whole lag below (floor) and fraction, the taps wrap around the circular correlation*/
+        int32_t base = (lag >= 0) ? (lag/(int32_t)K) : -((((int32_t)K - 1) - lag)/(int32_t)K);
+        const float32_t * filter = &SLocInternal->SRP_Interp[(uint32_t)(lag - (base*(int32_t)K))*SRP_INTERP_TAPS];
+        uint32_t index = (uint32_t)(base + (int32_t)N + 1 - ((int32_t)SRP_INTERP_TAPS/2)) % N;
+        float32_t value = 0.0f;
+        uint32_t k;
+        for(k=0; k<SRP_INTERP_TAPS; k++)
+        {
+          value += SLocInternal->PowerSpectrum[index]*filter[k];
+          index++;
+          if(index == N)
+          {
+            index = 0;
+          }
+        }
+        corr[lag + max_lag] = value;
+      }
+      p++;
+    }
+  }
+
+  /*COARSE SEARCH*/
+  best_value = -1e7f;
+  for(e=0; e<SLocInternal->SRP_Elevations; e++)
+  {
+    for(n=0; n<SLocInternal->num_of_angles; n+=SRP_COARSE_STEP)
+    {
+      float32_t value = SRP_Evaluate(SLocInternal, (e*SLocInternal->num_of_angles)+n, 1);
+      if(value > best_value)
+      {
+        best_value = value;
+        best_n = (int32_t)n;
+        best_e = (int32_t)e;
+      }
+    }
+  }
+
+  /*LOCAL REFINEMENT*/
+  coarse_n = best_n;
+  coarse_e = best_e;
+  best_value = -1e7f;
+  for(de=-1; de<=1; de++)
+  {
+    e = (uint32_t)(coarse_e + de);
+    if((coarse_e + de >= 0) && (e < SLocInternal->SRP_Elevations))
+    {
+      for(dn=-((int32_t)SRP_COARSE_STEP-1); dn<(int32_t)SRP_COARSE_STEP; dn++)
+      {
+        n = (uint32_t)((coarse_n + dn + (int32_t)SLocInternal->num_of_angles) % (int32_t)SLocInternal->num_of_angles);
+        float32_t value = SRP_Evaluate(SLocInternal, (e*SLocInternal->num_of_angles)+n, 0);
+        if(value > best_value)
+        {
+          best_value = value;
+          best_n = (int32_t)n;
+          best_e = (int32_t)e;
+        }
+      }
+    }
+  }
+
+  SLocInternal->SRP_Elevation_Index = (uint16_t)best_e;
+  SLocInternal->SRP_Map_Valid = 1;
+  SLocInternal->Buffer_State = 0;
+
+  out_angles[0] = best_n*(int32_t)SLocInternal->resolution;
+  out_angles[1] = best_e*(int32_t)SRP_ELEVATION_STEP;
+  return (float32_t)out_angles[0];
+}
+
+#endif /*__SRP_PHAT_H*/
+
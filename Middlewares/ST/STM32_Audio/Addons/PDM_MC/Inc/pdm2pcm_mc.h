@@ -0,0 +1,120 @@
+/**
+  ******************************************************************************
+  * @file    pdm2pcm_mc.h
+  * @author  SRA
+  * @brief   header for pdm2pcm_mc.c file.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file in
+  * the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __PDM2PCM_MC_H
+#define __PDM2PCM_MC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/** @addtogroup X_CUBE_MEMSMIC1_Applications
+  * @{
+  */
+
+/** @addtogroup Microphones_Acquisition
+  * @{
+  */
+
+/** @defgroup PDM2PCM_MC
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+
+#define PDM2PCM_MC_MAX_CHANNELS       4U
+#define PDM2PCM_MC_CIC_ORDER          4U
+#define PDM2PCM_MC_FIR_TAPS           47U     /* droop compensation and decimation by 2 */
+#define PDM2PCM_MC_HP_CUTOFF          20.0f   /* Hz, DC removal on the output */
+
+#define PDM2PCM_MC_ENDIANNESS_LE      0x0000U /* bytes of each microphone in time order */
+#define PDM2PCM_MC_ENDIANNESS_BE      0x0001U /* bytes swapped in 16-bit words, single microphone on I2S */
+
+/* Exported typedef --------------------------------------------------------*/
+
+typedef enum
+{
+  PDM2PCM_MC_ERROR_NONE = 0, PDM2PCM_MC_ERROR_INVALID_PARAMETER
+} PDM2PCM_MC_error_t;
+
+typedef enum
+{
+  PDM2PCM_MC_OUTPUT_INTERLEAVED = 0,  /* sample n of channel c at pOut[n * channels + c] */
+  PDM2PCM_MC_OUTPUT_PLANAR            /* sample n of channel c at pOut[c * samples + n] */
+} PDM2PCM_MC_layout_t;
+
+typedef struct
+{
+  uint32_t integrator[PDM2PCM_MC_CIC_ORDER];  /* modulo 2^32, only the differences of the combs are meaningful */
+  uint32_t comb[PDM2PCM_MC_CIC_ORDER];
+  int32_t delay[2U * PDM2PCM_MC_FIR_TAPS];    /* CIC output written twice, the FIR window is always contiguous */
+  uint32_t pos;
+  int32_t hp_in;
+  int32_t hp_out;
+} PDM2PCM_MC_channel_t;
+
+typedef struct
+{
+  uint32_t channels;              /* microphones byte-interleaved in the input, 1 to PDM2PCM_MC_MAX_CHANNELS */
+  uint32_t decimation;            /* PDM bits per output sample, multiple of 16 from 16 to 256 */
+  uint32_t samples;               /* output samples per channel and per call */
+  uint32_t sample_rate;           /* output rate in Hz, for the high pass filter */
+  uint32_t endianness;            /* PDM2PCM_MC_ENDIANNESS_LE or PDM2PCM_MC_ENDIANNESS_BE, bits MSB first */
+  int32_t mic_gain;               /* dB, -12 to 51, 0 maps a full-scale PDM stream to full-scale PCM */
+  PDM2PCM_MC_layout_t layout;
+} PDM2PCM_MC_init_params_t;
+
+typedef struct
+{
+  PDM2PCM_MC_init_params_t init_params;
+  PDM2PCM_MC_channel_t channel[PDM2PCM_MC_MAX_CHANNELS];
+  uint32_t cic_bytes;             /* input bytes per CIC output */
+  int32_t cic_scale;              /* CIC output to 24 fractional bits: (x * cic_scale) >> cic_shift */
+  uint32_t cic_shift;
+  int32_t hp_pole;                /* Q31 */
+  int32_t gain;                   /* Q16 */
+} PDM2PCM_MC_instance_t;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+PDM2PCM_MC_error_t PDM2PCM_MC_Init(PDM2PCM_MC_instance_t *instance);
+PDM2PCM_MC_error_t PDM2PCM_MC_SetGain(PDM2PCM_MC_instance_t *instance, int32_t mic_gain);
+PDM2PCM_MC_error_t PDM2PCM_MC_Process(PDM2PCM_MC_instance_t *instance, const uint8_t *pIn, int16_t *pOut);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PDM2PCM_MC_H */
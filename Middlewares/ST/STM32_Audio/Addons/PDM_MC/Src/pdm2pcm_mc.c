@@ -0,0 +1,372 @@
+/**
+  ******************************************************************************
+  * @file    pdm2pcm_mc.c
+  * @author  SRA
+  * @brief   Multi-channel PDM to PCM decimator: byte LUT CIC, droop compensating FIR, DC removal and gain,
+  *          all the microphones of a byte-interleaved buffer in one call.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file in
+  * the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "pdm2pcm_mc.h"
+#include <stddef.h>
+
+/** @addtogroup X_CUBE_MEMSMIC1_Applications
+  * @{
+  */
+
+/** @addtogroup Microphones_Acquisition
+  * @{
+  */
+
+/** @defgroup PDM2PCM_MC
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+
+#define PDM2PCM_MC_FIR_HALF       ((PDM2PCM_MC_FIR_TAPS + 1U) / 2U)
+#define PDM2PCM_MC_CIC_BITS       23U     /* fractional bits of the CIC output, full-scale PDM is 1.0 */
+#define PDM2PCM_MC_GAIN_MIN       (-12)
+#define PDM2PCM_MC_GAIN_MAX       51
+#define PDM2PCM_MC_DB_STEP        1.12201845f   /* 1 dB */
+#define PDM2PCM_MC_PI             3.14159265f
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Contribution of 8 PDM bits, MSB first, to the 4 CIC integrators: with the bits x1..x8 as +1/-1, entry k is
+   sum(C(8 - n + k, k) * xn), so that after the byte
+     i4 += 8 * i3 + 36 * i2 + 120 * i1 + lut[3]
+     i3 += 8 * i2 + 36 * i1 + lut[2]
+     i2 += 8 * i1 + lut[1]
+     i1 += lut[0]
+   equals 8 steps of the integrator chain, with the old values on the right */
+static const int16_t PDM2PCM_MC_Cic_Lut[256][PDM2PCM_MC_CIC_ORDER] =
+{
+  {  -8,  -36, -120, -330}, {  -6,  -34, -118, -328}, {  -6,  -32, -114, -322}, {  -4,  -30, -112, -320},
+  {  -6,  -30, -108, -310}, {  -4,  -28, -106, -308}, {  -4,  -26, -102, -302}, {  -2,  -24, -100, -300},
+  {  -6,  -28, -100, -290}, {  -4,  -26,  -98, -288}, {  -4,  -24,  -94, -282}, {  -2,  -22,  -92, -280},
+  {  -4,  -22,  -88, -270}, {  -2,  -20,  -86, -268}, {  -2,  -18,  -82, -262}, {   0,  -16,  -80, -260},
+  {  -6,  -26,  -90, -260}, {  -4,  -24,  -88, -258}, {  -4,  -22,  -84, -252}, {  -2,  -20,  -82, -250},
+  {  -4,  -20,  -78, -240}, {  -2,  -18,  -76, -238}, {  -2,  -16,  -72, -232}, {   0,  -14,  -70, -230},
+  {  -4,  -18,  -70, -220}, {  -2,  -16,  -68, -218}, {  -2,  -14,  -64, -212}, {   0,  -12,  -62, -210},
+  {  -2,  -12,  -58, -200}, {   0,  -10,  -56, -198}, {   0,   -8,  -52, -192}, {   2,   -6,  -50, -190},
+  {  -6,  -24,  -78, -218}, {  -4,  -22,  -76, -216}, {  -4,  -20,  -72, -210}, {  -2,  -18,  -70, -208},
+  {  -4,  -18,  -66, -198}, {  -2,  -16,  -64, -196}, {  -2,  -14,  -60, -190}, {   0,  -12,  -58, -188},
+  {  -4,  -16,  -58, -178}, {  -2,  -14,  -56, -176}, {  -2,  -12,  -52, -170}, {   0,  -10,  -50, -168},
+  {  -2,  -10,  -46, -158}, {   0,   -8,  -44, -156}, {   0,   -6,  -40, -150}, {   2,   -4,  -38, -148},
+  {  -4,  -14,  -48, -148}, {  -2,  -12,  -46, -146}, {  -2,  -10,  -42, -140}, {   0,   -8,  -40, -138},
+  {  -2,   -8,  -36, -128}, {   0,   -6,  -34, -126}, {   0,   -4,  -30, -120}, {   2,   -2,  -28, -118},
+  {  -2,   -6,  -28, -108}, {   0,   -4,  -26, -106}, {   0,   -2,  -22, -100}, {   2,    0,  -20,  -98},
+  {   0,    0,  -16,  -88}, {   2,    2,  -14,  -86}, {   2,    4,  -10,  -80}, {   4,    6,   -8,  -78},
+  {  -6,  -22,  -64, -162}, {  -4,  -20,  -62, -160}, {  -4,  -18,  -58, -154}, {  -2,  -16,  -56, -152},
+  {  -4,  -16,  -52, -142}, {  -2,  -14,  -50, -140}, {  -2,  -12,  -46, -134}, {   0,  -10,  -44, -132},
+  {  -4,  -14,  -44, -122}, {  -2,  -12,  -42, -120}, {  -2,  -10,  -38, -114}, {   0,   -8,  -36, -112},
+  {  -2,   -8,  -32, -102}, {   0,   -6,  -30, -100}, {   0,   -4,  -26,  -94}, {   2,   -2,  -24,  -92},
+  {  -4,  -12,  -34,  -92}, {  -2,  -10,  -32,  -90}, {  -2,   -8,  -28,  -84}, {   0,   -6,  -26,  -82},
+  {  -2,   -6,  -22,  -72}, {   0,   -4,  -20,  -70}, {   0,   -2,  -16,  -64}, {   2,    0,  -14,  -62},
+  {  -2,   -4,  -14,  -52}, {   0,   -2,  -12,  -50}, {   0,    0,   -8,  -44}, {   2,    2,   -6,  -42},
+  {   0,    2,   -2,  -32}, {   2,    4,    0,  -30}, {   2,    6,    4,  -24}, {   4,    8,    6,  -22},
+  {  -4,  -10,  -22,  -50}, {  -2,   -8,  -20,  -48}, {  -2,   -6,  -16,  -42}, {   0,   -4,  -14,  -40},
+  {  -2,   -4,  -10,  -30}, {   0,   -2,   -8,  -28}, {   0,    0,   -4,  -22}, {   2,    2,   -2,  -20},
+  {  -2,   -2,   -2,  -10}, {   0,    0,    0,   -8}, {   0,    2,    4,   -2}, {   2,    4,    6,    0},
+  {   0,    4,   10,   10}, {   2,    6,   12,   12}, {   2,    8,   16,   18}, {   4,   10,   18,   20},
+  {  -2,    0,    8,   20}, {   0,    2,   10,   22}, {   0,    4,   14,   28}, {   2,    6,   16,   30},
+  {   0,    6,   20,   40}, {   2,    8,   22,   42}, {   2,   10,   26,   48}, {   4,   12,   28,   50},
+  {   0,    8,   28,   60}, {   2,   10,   30,   62}, {   2,   12,   34,   68}, {   4,   14,   36,   70},
+  {   2,   14,   40,   80}, {   4,   16,   42,   82}, {   4,   18,   46,   88}, {   6,   20,   48,   90},
+  {  -6,  -20,  -48,  -90}, {  -4,  -18,  -46,  -88}, {  -4,  -16,  -42,  -82}, {  -2,  -14,  -40,  -80},
+  {  -4,  -14,  -36,  -70}, {  -2,  -12,  -34,  -68}, {  -2,  -10,  -30,  -62}, {   0,   -8,  -28,  -60},
+  {  -4,  -12,  -28,  -50}, {  -2,  -10,  -26,  -48}, {  -2,   -8,  -22,  -42}, {   0,   -6,  -20,  -40},
+  {  -2,   -6,  -16,  -30}, {   0,   -4,  -14,  -28}, {   0,   -2,  -10,  -22}, {   2,    0,   -8,  -20},
+  {  -4,  -10,  -18,  -20}, {  -2,   -8,  -16,  -18}, {  -2,   -6,  -12,  -12}, {   0,   -4,  -10,  -10},
+  {  -2,   -4,   -6,    0}, {   0,   -2,   -4,    2}, {   0,    0,    0,    8}, {   2,    2,    2,   10},
+  {  -2,   -2,    2,   20}, {   0,    0,    4,   22}, {   0,    2,    8,   28}, {   2,    4,   10,   30},
+  {   0,    4,   14,   40}, {   2,    6,   16,   42}, {   2,    8,   20,   48}, {   4,   10,   22,   50},
+  {  -4,   -8,   -6,   22}, {  -2,   -6,   -4,   24}, {  -2,   -4,    0,   30}, {   0,   -2,    2,   32},
+  {  -2,   -2,    6,   42}, {   0,    0,    8,   44}, {   0,    2,   12,   50}, {   2,    4,   14,   52},
+  {  -2,    0,   14,   62}, {   0,    2,   16,   64}, {   0,    4,   20,   70}, {   2,    6,   22,   72},
+  {   0,    6,   26,   82}, {   2,    8,   28,   84}, {   2,   10,   32,   90}, {   4,   12,   34,   92},
+  {  -2,    2,   24,   92}, {   0,    4,   26,   94}, {   0,    6,   30,  100}, {   2,    8,   32,  102},
+  {   0,    8,   36,  112}, {   2,   10,   38,  114}, {   2,   12,   42,  120}, {   4,   14,   44,  122},
+  {   0,   10,   44,  132}, {   2,   12,   46,  134}, {   2,   14,   50,  140}, {   4,   16,   52,  142},
+  {   2,   16,   56,  152}, {   4,   18,   58,  154}, {   4,   20,   62,  160}, {   6,   22,   64,  162},
+  {  -4,   -6,    8,   78}, {  -2,   -4,   10,   80}, {  -2,   -2,   14,   86}, {   0,    0,   16,   88},
+  {  -2,    0,   20,   98}, {   0,    2,   22,  100}, {   0,    4,   26,  106}, {   2,    6,   28,  108},
+  {  -2,    2,   28,  118}, {   0,    4,   30,  120}, {   0,    6,   34,  126}, {   2,    8,   36,  128},
+  {   0,    8,   40,  138}, {   2,   10,   42,  140}, {   2,   12,   46,  146}, {   4,   14,   48,  148},
+  {  -2,    4,   38,  148}, {   0,    6,   40,  150}, {   0,    8,   44,  156}, {   2,   10,   46,  158},
+  {   0,   10,   50,  168}, {   2,   12,   52,  170}, {   2,   14,   56,  176}, {   4,   16,   58,  178},
+  {   0,   12,   58,  188}, {   2,   14,   60,  190}, {   2,   16,   64,  196}, {   4,   18,   66,  198},
+  {   2,   18,   70,  208}, {   4,   20,   72,  210}, {   4,   22,   76,  216}, {   6,   24,   78,  218},
+  {  -2,    6,   50,  190}, {   0,    8,   52,  192}, {   0,   10,   56,  198}, {   2,   12,   58,  200},
+  {   0,   12,   62,  210}, {   2,   14,   64,  212}, {   2,   16,   68,  218}, {   4,   18,   70,  220},
+  {   0,   14,   70,  230}, {   2,   16,   72,  232}, {   2,   18,   76,  238}, {   4,   20,   78,  240},
+  {   2,   20,   82,  250}, {   4,   22,   84,  252}, {   4,   24,   88,  258}, {   6,   26,   90,  260},
+  {   0,   16,   80,  260}, {   2,   18,   82,  262}, {   2,   20,   86,  268}, {   4,   22,   88,  270},
+  {   2,   22,   92,  280}, {   4,   24,   94,  282}, {   4,   26,   98,  288}, {   6,   28,  100,  290},
+  {   2,   24,  100,  300}, {   4,   26,  102,  302}, {   4,   28,  106,  308}, {   6,   30,  108,  310},
+  {   4,   30,  112,  320}, {   6,   32,  114,  322}, {   6,   34,  118,  328}, {   8,   36,  120,  330}
+};
+
+/* First half of the symmetric FIR, Q15, the last one is the center tap. Designed at twice the output rate:
+   inverse of the sinc^4 droop up to 0.2 (flat within 0.6 dB up to 0.4 times the output rate), more than
+   80 dB of rejection with the CIC from 0.3, the band folded over the passband by the decimation by 2 */
+static const int16_t PDM2PCM_MC_Fir[PDM2PCM_MC_FIR_HALF] =
+{
+  -1, -1, 0, -2, 3, 16, -5, -56, -5, 138, 56, -276,
+  -195, 470, 496, -698, -1072, 894, 2139, -895, -4332, -67, 11108, 17335
+};
+
+/* Private function prototypes -----------------------------------------------*/
+
+static void PDM2PCM_MC_Channel(PDM2PCM_MC_instance_t *instance, uint32_t ch, const uint8_t *pIn, int16_t *pOut);
+
+/* Exported Functions --------------------------------------------------------*/
+
+/**
+  * @brief  Initialize the decimator and reset the state of all the channels
+  * @param  PDM2PCM_MC_instance_t* instance
+  * @retval PDM2PCM_MC_ERROR_NONE if successful, PDM2PCM_MC_ERROR_INVALID_PARAMETER if not
+  */
+PDM2PCM_MC_error_t PDM2PCM_MC_Init(PDM2PCM_MC_instance_t *instance)
+{
+  PDM2PCM_MC_init_params_t *params = &instance->init_params;
+  uint64_t cic_gain;
+  uint64_t scale;
+  uint32_t ratio;
+  uint32_t ch;
+  uint32_t i;
+
+  if ((params->channels == 0U) || (params->channels > PDM2PCM_MC_MAX_CHANNELS)
+      || (params->decimation < 16U) || (params->decimation > 256U) || ((params->decimation % 16U) != 0U)
+      || (params->samples == 0U) || (params->sample_rate == 0U)
+      || ((params->endianness == PDM2PCM_MC_ENDIANNESS_BE) && (params->channels != 1U))
+      || ((params->endianness != PDM2PCM_MC_ENDIANNESS_LE) && (params->endianness != PDM2PCM_MC_ENDIANNESS_BE))
+      || ((params->layout != PDM2PCM_MC_OUTPUT_INTERLEAVED) && (params->layout != PDM2PCM_MC_OUTPUT_PLANAR)))
+  {
+    return PDM2PCM_MC_ERROR_INVALID_PARAMETER;
+  }
+
+  /* The CIC decimates to twice the output rate, the FIR does the last factor 2 */
+  ratio = params->decimation / 2U;
+  instance->cic_bytes = ratio / 8U;
+
+  /* Full scale of the CIC is ratio^4, brought to 2^PDM2PCM_MC_CIC_BITS with a 31-bit scale */
+  cic_gain = (uint64_t)ratio * ratio * ratio * ratio;
+  instance->cic_shift = 0;
+  do
+  {
+    instance->cic_shift++;
+    scale = ((uint64_t)1 << (PDM2PCM_MC_CIC_BITS + instance->cic_shift)) / cic_gain;
+  } while (scale < ((uint64_t)1 << 30));
+  instance->cic_scale = (int32_t)scale;
+
+  /* One pole DC removal at the output rate */
+  instance->hp_pole = (int32_t)((1.0f - ((2.0f * PDM2PCM_MC_PI * PDM2PCM_MC_HP_CUTOFF) / (float)params->sample_rate))
+                                * 2147483648.0f);
+
+  for (ch = 0; ch < PDM2PCM_MC_MAX_CHANNELS; ch++)
+  {
+    for (i = 0; i < PDM2PCM_MC_CIC_ORDER; i++)
+    {
+      instance->channel[ch].integrator[i] = 0;
+      instance->channel[ch].comb[i] = 0;
+    }
+    for (i = 0; i < (2U * PDM2PCM_MC_FIR_TAPS); i++)
+    {
+      instance->channel[ch].delay[i] = 0;
+    }
+    instance->channel[ch].pos = 0;
+    instance->channel[ch].hp_in = 0;
+    instance->channel[ch].hp_out = 0;
+  }
+
+  return PDM2PCM_MC_SetGain(instance, params->mic_gain);
+}
+
+/**
+  * @brief  Set the gain of all the channels, at any time
+  * @param  PDM2PCM_MC_instance_t* instance
+  * @param  int32_t mic_gain in dB, -12 to 51
+  * @retval PDM2PCM_MC_ERROR_NONE if successful, PDM2PCM_MC_ERROR_INVALID_PARAMETER if not
+  */
+PDM2PCM_MC_error_t PDM2PCM_MC_SetGain(PDM2PCM_MC_instance_t *instance, int32_t mic_gain)
+{
+  float gain = 65536.0f;
+  int32_t db;
+
+  if ((mic_gain < PDM2PCM_MC_GAIN_MIN) || (mic_gain > PDM2PCM_MC_GAIN_MAX))
+  {
+    return PDM2PCM_MC_ERROR_INVALID_PARAMETER;
+  }
+
+  for (db = 0; db < mic_gain; db++)
+  {
+    gain *= PDM2PCM_MC_DB_STEP;
+  }
+  for (db = 0; db > mic_gain; db--)
+  {
+    gain /= PDM2PCM_MC_DB_STEP;
+  }
+  instance->init_params.mic_gain = mic_gain;
+  instance->gain = (int32_t)gain;
+
+  return PDM2PCM_MC_ERROR_NONE;
+}
+
+/**
+  * @brief  Convert one block of every channel: samples * decimation / 8 bytes per channel in, samples per channel
+  *         out, in the layout of the init parameters
+  * @param  PDM2PCM_MC_instance_t* instance
+  * @param  const uint8_t* pIn, byte-interleaved PDM of the channels
+  * @param  int16_t* pOut
+  * @retval PDM2PCM_MC_ERROR_NONE if successful, PDM2PCM_MC_ERROR_INVALID_PARAMETER if not
+  */
+PDM2PCM_MC_error_t PDM2PCM_MC_Process(PDM2PCM_MC_instance_t *instance, const uint8_t *pIn, int16_t *pOut)
+{
+  uint32_t ch;
+
+  if ((pIn == NULL) || (pOut == NULL))
+  {
+    return PDM2PCM_MC_ERROR_INVALID_PARAMETER;
+  }
+
+  for (ch = 0; ch < instance->init_params.channels; ch++)
+  {
+    if (instance->init_params.layout == PDM2PCM_MC_OUTPUT_PLANAR)
+    {
+      PDM2PCM_MC_Channel(instance, ch, pIn, &pOut[ch * instance->init_params.samples]);
+    }
+    else
+    {
+      PDM2PCM_MC_Channel(instance, ch, pIn, &pOut[ch]);
+    }
+  }
+
+  return PDM2PCM_MC_ERROR_NONE;
+}
+
+/* Private Functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Convert one block of a channel. The bytes of the channel are read in place, one every channels
+  *         bytes, so the interleaved input needs no separate deinterleave pass: the LUT consumes one byte at a time
+  *         and the whole chain of the channel stays in registers.
+  * @param  PDM2PCM_MC_instance_t* instance
+  * @param  uint32_t ch, channel
+  * @param  const uint8_t* pIn, byte-interleaved PDM of all the channels
+  * @param  int16_t* pOut, first output sample of the channel
+  * @retval None
+  */
+static void PDM2PCM_MC_Channel(PDM2PCM_MC_instance_t *instance, uint32_t ch, const uint8_t *pIn, int16_t *pOut)
+{
+  PDM2PCM_MC_channel_t *state = &instance->channel[ch];
+  uint32_t stride = instance->init_params.channels;
+  uint32_t out_stride = (instance->init_params.layout == PDM2PCM_MC_OUTPUT_PLANAR) ? 1U : stride;
+  uint32_t swap = (instance->init_params.endianness == PDM2PCM_MC_ENDIANNESS_BE) ? 1U : 0U;
+  uint32_t i1 = state->integrator[0];
+  uint32_t i2 = state->integrator[1];
+  uint32_t i3 = state->integrator[2];
+  uint32_t i4 = state->integrator[3];
+  uint32_t pos = state->pos;
+  uint32_t byte = 0;
+  int32_t hp_in = state->hp_in;
+  int32_t hp_out = state->hp_out;
+  uint32_t n, half, b, k;
+
+  for (n = 0; n < instance->init_params.samples; n++)
+  {
+    const int32_t *window;
+    int64_t acc;
+    int32_t x;
+    int32_t y;
+
+    for (half = 0; half < 2U; half++)
+    {
+      uint32_t v;
+      uint32_t t;
+
+      for (b = 0; b < instance->cic_bytes; b++)
+      {
+        const int16_t *lut = PDM2PCM_MC_Cic_Lut[pIn[((byte ^ swap) * stride) + ch]];
+
+        i4 += (8U * i3) + (36U * i2) + (120U * i1) + (uint32_t)(int32_t)lut[3];
+        i3 += (8U * i2) + (36U * i1) + (uint32_t)(int32_t)lut[2];
+        i2 += (8U * i1) + (uint32_t)(int32_t)lut[1];
+        i1 += (uint32_t)(int32_t)lut[0];
+        byte++;
+      }
+
+      /* Combs at twice the output rate */
+      v = i4;
+      for (k = 0; k < PDM2PCM_MC_CIC_ORDER; k++)
+      {
+        t = v - state->comb[k];
+        state->comb[k] = v;
+        v = t;
+      }
+
+      x = (int32_t)(((int64_t)(int32_t)v * instance->cic_scale) >> instance->cic_shift);
+      state->delay[pos] = x;
+      state->delay[pos + PDM2PCM_MC_FIR_TAPS] = x;
+      pos = ((pos + 1U) == PDM2PCM_MC_FIR_TAPS) ? 0U : (pos + 1U);
+    }
+
+    /* Symmetric FIR on the last PDM2PCM_MC_FIR_TAPS CIC outputs, one output every two */
+    window = &state->delay[pos];
+    acc = (int64_t)window[PDM2PCM_MC_FIR_HALF - 1U] * PDM2PCM_MC_Fir[PDM2PCM_MC_FIR_HALF - 1U];
+    for (k = 0; k < (PDM2PCM_MC_FIR_HALF - 1U); k++)
+    {
+      acc += (int64_t)(window[k] + window[PDM2PCM_MC_FIR_TAPS - 1U - k]) * PDM2PCM_MC_Fir[k];
+    }
+    x = (int32_t)(acc >> 15);
+
+    /* DC removal, then gain and saturation */
+    y = x - hp_in + (int32_t)(((int64_t)hp_out * instance->hp_pole) >> 31);
+    hp_in = x;
+    hp_out = y;
+    acc = ((int64_t)y * instance->gain) >> (16U + PDM2PCM_MC_CIC_BITS - 15U);
+    if (acc > 32767)
+    {
+      acc = 32767;
+    }
+    else if (acc < -32768)
+    {
+      acc = -32768;
+    }
+    pOut[n * out_stride] = (int16_t)acc;
+  }
+
+  state->integrator[0] = i1;
+  state->integrator[1] = i2;
+  state->integrator[2] = i3;
+  state->integrator[3] = i4;
+  state->pos = pos;
+  state->hp_in = hp_in;
+  state->hp_out = hp_out;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -34,8 +34,9 @@
 #define M_PI 3.14159265358979323846f
 #endif
 
+/* Instances without FFT_USER_BUFFER in init_params.user_memory are allocated with FFT_malloc. Comment out to build
+   without heap support, FFT_USER_BUFFER is then mandatory (see FFT_STATIC_INSTANCE) */
 #define FFT_DYNAMIC_ALLOCATION
-//#define FFT_STATIC_ALLOCATION
 
 /** @addtogroup X_CUBE_MEMSMIC1_Applications
   * @{
@@ -50,17 +51,29 @@
   */
 
 /* Exported constants --------------------------------------------------------*/
+
+/* Welch per-bin statistics, to be OR-ed in FFT_welch_init_params_t.stats */
+#define FFT_WELCH_STAT_NONE       0x0U
+#define FFT_WELCH_STAT_MIN        0x1U
+#define FFT_WELCH_STAT_MAX        0x2U
+#define FFT_WELCH_STAT_PEAK_HOLD  0x4U
+
+/* Caller supplied memory, to be OR-ed in FFT_init_params_t.user_memory */
+#define FFT_USER_NONE             0x0U    /* heap instance, userBuffer and userWindow are ignored */
+#define FFT_USER_BUFFER           0x1U    /* userBuffer holds the instance buffers */
+#define FFT_USER_WINDOW           0x2U    /* userWindow holds the window coefficients */
 /* Exported typedef --------------------------------------------------------*/
 
 
 typedef enum
 {
   FFT_RECT_WIN = 0, FFT_HAMMING_WIN, FFT_HANNING_WIN, FFT_BLACKMAN_HARRIS_WIN, FFT_TUKEY_0_25_WIN, FFT_TUKEY_0_75_WIN,
+  FFT_SQRT_HANNING_WIN,
 } FFT_windows_t;
 
 typedef enum
 {
-  COMPLEX = 0, MAGNITUDE,
+  COMPLEX = 0, MAGNITUDE, POWER,
 } FFT_output_type_t;
 
 typedef enum
@@ -78,6 +91,24 @@ typedef enum
   DIRECT_PROCESS_DISABLED = 0, DIRECT_PROCESS_ENABLED
 } FFT_direct_process_t;
 
+typedef enum
+{
+  FFT_PLANAR = 0, FFT_INTERLEAVED
+} FFT_layout_t;
+
+typedef enum
+{
+  FFT_STFT_BUFFERED = 0, FFT_STFT_LOW_LATENCY
+} FFT_stft_latency_t;
+
+/* Called by the STFT for every frame with the rfft packed spectrum, which can be modified in place */
+typedef void (*FFT_Spectrum_Callback)(float32_t *spectrum, uint32_t len, void *param);
+
+typedef enum
+{
+  FFT_WELCH_BLOCK = 0, FFT_WELCH_EXPONENTIAL
+} FFT_welch_averaging_t;
+
 typedef void *(*FFT_Malloc_Function)(size_t);
 typedef void *(*FFT_Calloc_Function)(size_t, size_t);
 typedef void (*FFT_Free_Function)(void *);
@@ -87,13 +118,16 @@ typedef struct
   arm_rfft_fast_instance_f32 S;
   uint32_t new_data_len;
   uint32_t old_data_len; /* New data Idx */
-  uint32_t scratch_idx;
-  float32_t *win;
-  float32_t *scratch;
-  float32_t *dataIn;
+  uint32_t scratch_idx;  /* new samples of the current hop */
+  uint32_t ring_len;     /* dataIn length: FFT_len + new_data_len */
+  uint32_t write_idx;    /* next dataIn position to be written */
+  uint32_t frame_start;  /* dataIn position of the oldest sample of the last complete frame */
+  float32_t *win;        /* computed window, NULL for FFT_RECT_WIN or a user window table */
+  const float32_t *winCoeffs; /* window used by the processing, NULL for FFT_RECT_WIN */
+  float32_t *dataIn;     /* circular analysis buffer */
   float32_t *fftIn;
   float32_t *fftOut;
-  float32_t (*normalizeData)(void *data, uint32_t index);
+  void (*convertData)(void *data, uint32_t offset, float32_t *dest, uint32_t len);
   FFT_error_t status;
 } FFT_context_t;
 
@@ -105,14 +139,15 @@ typedef struct
   FFT_windows_t win_type;
   FFT_data_type_t data_type;
   FFT_output_type_t output_type;
-#ifdef FFT_STATIC
-  float32_t *userBuffer;  /*   used to refer the context buffer pointers, in the follow order:
-                            - dataIn
+  float32_t *userBuffer;  /*   with FFT_USER_BUFFER, arena of FFT_getMemorySize() bytes, split in the follow order:
+                            - dataIn (FFT_len + new data length)
                             - fftIn
-                            - win
-                            - fftOut
-                            - scratch   */
-#endif
+                            - win (if not FFT_RECT_WIN and no FFT_USER_WINDOW)
+                            - fftOut (if not COMPLEX)   */
+  const float32_t *userWindow; /* with FFT_USER_WINDOW, precomputed FFT_len window coefficients, e.g. from fft_windows.h */
+  uint32_t user_memory;   /* FFT_USER_xxx mask, the two pointers above are only read when flagged. Code written before
+                             they existed must zero the instance (static storage or memset) to get FFT_USER_NONE.
+                             Unknown flags and flagged NULL pointers are rejected by FFT_Init */
 } FFT_init_params_t;
 
 typedef struct
@@ -121,11 +156,166 @@ typedef struct
   FFT_context_t context;
 } FFT_instance_t;
 
+typedef struct
+{
+  arm_rfft_fast_instance_f32 S;   /* twiddles shared by all the channels */
+  float32_t *win;                 /* window shared by all the channels */
+  float32_t *frames;              /* channels * FFT_len converted input samples */
+  float32_t *fftIn;
+  float32_t *fftOut;
+  void (*convertData)(void *data, uint32_t offset, float32_t *dest, uint32_t len);
+  FFT_error_t status;
+} FFT_multi_context_t;
+
+typedef struct
+{
+  uint32_t FFT_len;
+  uint32_t channels;
+  FFT_layout_t layout;            /* FFT_PLANAR: channel after channel, FFT_INTERLEAVED: sample after sample */
+  FFT_windows_t win_type;
+  FFT_data_type_t data_type;
+  FFT_output_type_t output_type;
+  float32_t *userBuffer;  /*   NULL or arena of FFT_Multi_getMemorySize() bytes, split in the follow order:
+                            - win
+                            - frames
+                            - fftIn
+                            - fftOut   */
+} FFT_multi_init_params_t;
+
+typedef struct
+{
+  FFT_multi_init_params_t init_params;
+  FFT_multi_context_t context;
+} FFT_multi_instance_t;
+
+typedef struct
+{
+  arm_rfft_fast_instance_f32 S;
+  float32_t *win;        /* analysis window */
+  float32_t *synthWin;   /* synthesis window, including the overlap-add normalization */
+  float32_t *frame;      /* circular analysis buffer, FFT_len samples */
+  float32_t *fftIn;
+  float32_t *spectrum;
+  float32_t *ola;        /* circular overlap-add buffer, FFT_len + hop samples */
+  uint32_t hop_idx;      /* samples of the current hop */
+  uint32_t frame_idx;    /* next frame position to be written */
+  uint32_t ola_start;    /* ola position of the first sample of the next frame */
+  uint32_t read_idx;     /* ola position of the first sample of the hop being output */
+  void (*convertData)(void *data, uint32_t offset, float32_t *dest, uint32_t len);
+  void (*convertOut)(float32_t *src, void *data, uint32_t offset, uint32_t len);
+  FFT_error_t status;
+} FFT_stft_context_t;
+
+typedef struct
+{
+  uint32_t FFT_len;
+  uint32_t hop;                   /* must divide FFT_len */
+  FFT_windows_t win_type;         /* used for analysis and synthesis, the squared window must be COLA for hop */
+  FFT_data_type_t data_type;      /* input and output samples */
+  FFT_stft_latency_t latency;     /* FFT_STFT_LOW_LATENCY requires blocks of a multiple of hop samples */
+  FFT_Spectrum_Callback callback; /* NULL for a plain analysis/synthesis */
+  void *callback_param;
+  float32_t *userBuffer;  /*   NULL or arena of FFT_STFT_getMemorySize() bytes, split in the follow order:
+                            - win
+                            - synthWin
+                            - frame
+                            - fftIn
+                            - spectrum
+                            - ola   */
+} FFT_stft_init_params_t;
+
+typedef struct
+{
+  FFT_stft_init_params_t init_params;
+  FFT_stft_context_t context;
+} FFT_stft_instance_t;
+
+typedef struct
+{
+  FFT_instance_t *fft;   /* source of the power spectra */
+  uint32_t bins;         /* FFT_len / 2 */
+  uint32_t frame_count;  /* frames of the current result period */
+  uint32_t results;      /* results produced since init */
+  float32_t scale;       /* 1 / window energy */
+  float32_t *power;      /* last power spectrum */
+  float32_t *acc;        /* block sum or exponential average */
+  float32_t *psd;        /* averaged power spectrum, updated every init_params.frames frames */
+  float32_t *min;        /* per-bin minimum of the last result period, if FFT_WELCH_STAT_MIN */
+  float32_t *max;        /* per-bin maximum of the last result period, if FFT_WELCH_STAT_MAX */
+  float32_t *peak;       /* per-bin decaying peak, if FFT_WELCH_STAT_PEAK_HOLD */
+  float32_t *bands;      /* psd energy of each band */
+  FFT_error_t status;
+} FFT_welch_context_t;
+
+typedef struct
+{
+  FFT_welch_averaging_t averaging;
+  uint32_t frames;            /* frames per result */
+  float32_t alpha;            /* FFT_WELCH_EXPONENTIAL weight of the new frame, in (0, 1] */
+  uint32_t stats;             /* FFT_WELCH_STAT_xxx mask */
+  float32_t peak_decay;       /* peak-hold factor applied every frame, in [0, 1] */
+  const uint16_t *band_edges; /* num_bands + 1 increasing bin indexes, band b covers [edges[b], edges[b + 1]) */
+  uint32_t num_bands;
+  float32_t *userBuffer;  /*   NULL or arena of FFT_Welch_getMemorySize() bytes, split in the follow order:
+                            - power
+                            - acc
+                            - psd
+                            - min, max, peak (if enabled)
+                            - bands   */
+} FFT_welch_init_params_t;
+
+typedef struct
+{
+  FFT_welch_init_params_t init_params;
+  FFT_welch_context_t context;
+} FFT_welch_instance_t;
+
 /* Exported macro ------------------------------------------------------------*/
 /** @defgroup AUDIO_APPLICATION_Exported_Defines
   * @{
   */
 
+#define FFT_STATIC_ALIGNMENT 32U
+
+/* Floats of the userBuffer of a streaming instance, hop being FFT_len * (1 - overlap) */
+#define FFT_STATIC_BUFFER_LEN(len, hop, has_win, out)  \
+  ((2U * (len)) + (hop) + ((has_win) ? (len) : 0U) + (((out) != COMPLEX) ? (len) : 0U))
+
+/**
+  * @brief  Declare a streaming FFT instance whose storage is one aligned block sized at compile time, no heap is used.
+  *         The window is computed into the block by FFT_Init. hop must divide len.
+  *         Usage: FFT_STATIC_INSTANCE(Spectrum, 1024U, 256U, FFT_HANNING_WIN, INT16, MAGNITUDE);
+  *                FFT_Init(&Spectrum);
+  */
+#define FFT_STATIC_INSTANCE(name, len, hop, win, data, out)                                                 \
+  static float32_t name##_buffer[FFT_STATIC_BUFFER_LEN((len), (hop), ((win) != FFT_RECT_WIN), (out))]      \
+  __ALIGNED(FFT_STATIC_ALIGNMENT);                                                                         \
+  static FFT_instance_t name = { .init_params = { .use_direct_process = DIRECT_PROCESS_DISABLED,            \
+                                                  .FFT_len = (len),                                         \
+                                                  .overlap = 1.0f - ((float32_t)(hop) / (float32_t)(len)),  \
+                                                  .win_type = (win), .data_type = (data),                   \
+                                                  .output_type = (out), .userBuffer = name##_buffer,        \
+                                                  .userWindow = NULL, .user_memory = FFT_USER_BUFFER } }
+
+/**
+  * @brief  Same as FFT_STATIC_INSTANCE, with the window read from a const table (e.g. FFT_Hanning_1024 from
+  *         fft_windows.h): no window storage and no trigonometry at init. The table is the window, win_type is
+  *         not used; it must be an array of len coefficients, not a pointer, checked at compile time.
+  *         Usage: FFT_STATIC_INSTANCE_CONST_WIN(Spectrum, 1024U, 256U, FFT_Hanning_1024, INT16, POWER);
+  */
+#define FFT_STATIC_INSTANCE_CONST_WIN(name, len, hop, table, data, out)                                     \
+  _Static_assert((sizeof(table) / sizeof((table)[0])) == (len),                                             \
+                 "window table of " #name " is not " #len " coefficients long");                            \
+  static float32_t name##_buffer[FFT_STATIC_BUFFER_LEN((len), (hop), 0, (out))]                             \
+  __ALIGNED(FFT_STATIC_ALIGNMENT);                                                                         \
+  static FFT_instance_t name = { .init_params = { .use_direct_process = DIRECT_PROCESS_DISABLED,            \
+                                                  .FFT_len = (len),                                         \
+                                                  .overlap = 1.0f - ((float32_t)(hop) / (float32_t)(len)),  \
+                                                  .data_type = (data),                                      \
+                                                  .output_type = (out), .userBuffer = name##_buffer,        \
+                                                  .userWindow = (table),                                    \
+                                                  .user_memory = FFT_USER_BUFFER | FFT_USER_WINDOW } }
+
 /**
   * @}
   */
@@ -138,7 +328,25 @@ int32_t FFT_Data_Input(void *data, uint32_t len, FFT_instance_t *instance);
 
 FFT_error_t FFT_Process(FFT_instance_t *instance, void *output);
 FFT_error_t FFT_Direct_Process(FFT_instance_t *instance, void *input, float32_t *output);
+
+FFT_error_t FFT_Multi_Init(FFT_multi_instance_t *instance);
+FFT_error_t FFT_Multi_DeInit(FFT_multi_instance_t *instance);
+int32_t FFT_Multi_getMemorySize(FFT_multi_instance_t *instance);
+FFT_error_t FFT_Multi_Process(FFT_multi_instance_t *instance, void *input, float32_t *output);
+
+FFT_error_t FFT_STFT_Init(FFT_stft_instance_t *instance);
+FFT_error_t FFT_STFT_DeInit(FFT_stft_instance_t *instance);
+int32_t FFT_STFT_getMemorySize(FFT_stft_instance_t *instance);
+FFT_error_t FFT_STFT_Process(FFT_stft_instance_t *instance, void *input, void *output, uint32_t len);
+
+FFT_error_t FFT_Welch_Init(FFT_welch_instance_t *instance, FFT_instance_t *fft);
+FFT_error_t FFT_Welch_DeInit(FFT_welch_instance_t *instance);
+int32_t FFT_Welch_getMemorySize(FFT_welch_instance_t *instance, FFT_instance_t *fft);
+int32_t FFT_Welch_Data_Input(void *data, uint32_t len, FFT_welch_instance_t *instance);
+
 void FFT_set_allocation_functions(FFT_Malloc_Function malloc_fun, FFT_Free_Function free_fun);
+void *FFT_Allocate(size_t size);
+void FFT_Release(void *ptr);
 
 /**
   * @}
@@ -0,0 +1,110 @@
+/**
+  ******************************************************************************
+  * @file    fft_mel.h
+  * @author  SRA
+  * @brief   header for fft_mel.c file.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file in
+  * the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __FFT_MEL_H
+#define __FFT_MEL_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "fft.h"
+
+/** @addtogroup X_CUBE_MEMSMIC1_Applications
+  * @{
+  */
+
+/** @addtogroup Microphones_Acquisition
+  * @{
+  */
+
+/** @defgroup AUDIO_APPLICATION
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported typedef --------------------------------------------------------*/
+
+typedef enum
+{
+  FFT_MEL_OUTPUT_FLOAT32 = 0, FFT_MEL_OUTPUT_Q8   /* int16_t with 8 fractional bits, saturated */
+} FFT_mel_output_t;
+
+/* Called for every frame with num_mfcc coefficients, or num_mels log-mel energies if num_mfcc is 0 */
+typedef void (*FFT_Features_Callback)(void *features, uint32_t len, void *param);
+
+typedef struct
+{
+  FFT_instance_t fft;    /* STFT front end, POWER output, carved from the mel arena */
+  uint16_t *band_start;  /* first FFT bin of each mel band */
+  uint16_t *band_len;    /* number of FFT bins of each mel band */
+  float32_t *weights;    /* non-zero filterbank weights, band after band */
+  float32_t *dct;        /* num_mfcc x num_mels DCT-II matrix */
+  float32_t *power;      /* power spectrum of the frame */
+  float32_t *mel;        /* log-mel energies of the frame */
+  void *features;        /* output of the frame, in output_type format */
+  uint32_t frames;       /* frames produced since init */
+  FFT_error_t status;
+} FFT_mel_context_t;
+
+typedef struct
+{
+  uint32_t FFT_len;               /* frame length */
+  uint32_t hop;                   /* new samples per frame */
+  uint32_t sample_rate;           /* Hz */
+  uint32_t num_mels;
+  float32_t f_min;                /* Hz, lower edge of the first band */
+  float32_t f_max;                /* Hz, upper edge of the last band, at most sample_rate / 2 */
+  uint32_t num_mfcc;              /* 0 for log-mel output, else number of DCT-II coefficients, at most num_mels */
+  FFT_windows_t win_type;
+  FFT_data_type_t data_type;      /* input samples */
+  FFT_mel_output_t output_type;
+  FFT_Features_Callback callback;
+  void *callback_param;
+  float32_t *userBuffer;  /*   NULL or arena of FFT_Mel_getMemorySize() bytes, split in the follow order:
+                            - FFT instance (FFT_getMemorySize() bytes)
+                            - power, mel, features
+                            - dct, weights
+                            - band_start, band_len   */
+} FFT_mel_init_params_t;
+
+typedef struct
+{
+  FFT_mel_init_params_t init_params;
+  FFT_mel_context_t context;
+} FFT_mel_instance_t;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+FFT_error_t FFT_Mel_Init(FFT_mel_instance_t *instance);
+FFT_error_t FFT_Mel_DeInit(FFT_mel_instance_t *instance);
+int32_t FFT_Mel_getMemorySize(FFT_mel_instance_t *instance);
+int32_t FFT_Mel_Data_Input(void *data, uint32_t len, FFT_mel_instance_t *instance);
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#endif /* __FFT_MEL_H */
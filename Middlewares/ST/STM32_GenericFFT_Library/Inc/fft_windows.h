@@ -0,0 +1,60 @@
+/**
+  ******************************************************************************
+  * @file    fft_windows.h
+  * @author  SRA
+  * @brief   Precomputed window tables for FFT_STATIC_INSTANCE_CONST_WIN.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file in
+  * the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __FFT_WINDOWS_H
+#define __FFT_WINDOWS_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "fft.h"
+
+/** @addtogroup X_CUBE_MEMSMIC1_Applications
+  * @{
+  */
+
+/** @addtogroup Microphones_Acquisition
+  * @{
+  */
+
+/** @defgroup AUDIO_APPLICATION
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/* Tables match the windows computed at init by FFT_HANNING_WIN and FFT_HAMMING_WIN */
+extern const float32_t FFT_Hanning_256[256];
+extern const float32_t FFT_Hanning_512[512];
+extern const float32_t FFT_Hanning_1024[1024];
+extern const float32_t FFT_Hamming_256[256];
+extern const float32_t FFT_Hamming_512[512];
+extern const float32_t FFT_Hamming_1024[1024];
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#endif /* __FFT_WINDOWS_H */
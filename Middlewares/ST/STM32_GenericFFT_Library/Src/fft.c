@@ -40,18 +40,21 @@ static FFT_Free_Function FFT_free = free;
   */
 
 /* Private typedef -----------------------------------------------------------*/
+
+typedef void (*FFT_Convert_Function)(void *data, uint32_t offset, float32_t *dest, uint32_t len);
+typedef void (*FFT_Convert_Out_Function)(float32_t *src, void *data, uint32_t offset, uint32_t len);
 /* Private define ------------------------------------------------------------*/
 
-#define FLOAT_NORM_FACTOR 1.0f;
-#define INT32_NORM_FACTOR 2147483648.0f;
-#define INT16_NORM_FACTOR 32768.0f;
+#define FFT_COLA_TOLERANCE 1e-3f   /* max relative ripple of the overlapped squared window */
 
 /* Private function prototypes -----------------------------------------------*/
 
 static void TukeyWin(uint32_t len, float32_t ratio, float32_t *dest);
 static void BlackmanHarrisWin(uint32_t len, float32_t *dest);
 static void HammingWin(uint32_t len, float32_t *dest);
+static void SqrtHanningWin(uint32_t len, float32_t *dest);
 static void FFT_create_window(FFT_instance_t *instance);
+static void FFT_Fill_Window(FFT_windows_t win_type, uint32_t len, float32_t *dest);
 
 static int8_t FFT_Memory_Allocation(FFT_instance_t *instance);
 
@@ -59,14 +62,26 @@ static int8_t FFT_Memory_Allocation(FFT_instance_t *instance);
 static int8_t FFT_Dynamic_Allocation(FFT_instance_t *instance);
 #endif
 
-#ifdef FFT_STATIC_ALLOCATION
-static int8_t FFT_Static_Allocation(FFT_instance_t *instance);
-#endif
+static void FFT_Static_Allocation(FFT_instance_t *instance);
+static uint8_t FFT_Window_Storage_Needed(FFT_instance_t *instance);
 
 static void FFT_Set_Normalize_Function(FFT_instance_t *instance);
-static float32_t FFT_NormalizeFloat(void *data, uint32_t index);
-static float32_t FFT_NormalizeInt32(void *data, uint32_t index);
-static float32_t FFT_NormalizeInt16(void *data, uint32_t index);
+static FFT_Convert_Function FFT_Get_Convert_Function(FFT_data_type_t data_type);
+static void FFT_Multi_Memory_Carve(FFT_multi_instance_t *instance, float32_t *arena);
+static void FFT_STFT_Memory_Carve(FFT_stft_instance_t *instance, float32_t *arena);
+static void FFT_Welch_Memory_Carve(FFT_welch_instance_t *instance, float32_t *arena);
+static int32_t FFT_Welch_Accumulate(FFT_welch_instance_t *instance);
+static float32_t FFT_STFT_Cola_Gain(float32_t *win, uint32_t len, uint32_t hop);
+static void FFT_STFT_Frame(FFT_stft_instance_t *instance);
+static void FFT_STFT_Output(FFT_stft_instance_t *instance, void *output, uint32_t offset, uint32_t len);
+static void FFT_OutFloat(float32_t *src, void *data, uint32_t offset, uint32_t len);
+static void FFT_OutInt32(float32_t *src, void *data, uint32_t offset, uint32_t len);
+static void FFT_OutInt16(float32_t *src, void *data, uint32_t offset, uint32_t len);
+static void FFT_ConvertFloat(void *data, uint32_t offset, float32_t *dest, uint32_t len);
+static void FFT_ConvertInt32(void *data, uint32_t offset, float32_t *dest, uint32_t len);
+static void FFT_ConvertInt16(void *data, uint32_t offset, float32_t *dest, uint32_t len);
+static void FFT_Window_Frame(const float32_t *win, float32_t *src, uint32_t start, uint32_t src_len, float32_t *dest,
+                             uint32_t len);
 
 /* Exported Functions --------------------------------------------------------*/
 
@@ -93,6 +108,13 @@ FFT_error_t FFT_Init(FFT_instance_t *instance)
     instance->context.status = FFT_ERROR_INVALID_PARAMETER;
     retVal = FFT_ERROR_INVALID_PARAMETER;
   }
+  else if (((instance->init_params.user_memory & ~(FFT_USER_BUFFER | FFT_USER_WINDOW)) != 0U)
+           || (((instance->init_params.user_memory & FFT_USER_BUFFER) != 0U) && (instance->init_params.userBuffer == NULL))
+           || (((instance->init_params.user_memory & FFT_USER_WINDOW) != 0U) && (instance->init_params.userWindow == NULL)))
+  {
+    instance->context.status = FFT_ERROR_INVALID_PARAMETER;
+    retVal = FFT_ERROR_INVALID_PARAMETER;
+  }
 
   if (retVal == FFT_ERROR_NONE)
   {
@@ -105,19 +127,31 @@ FFT_error_t FFT_Init(FFT_instance_t *instance)
     /* Set scratch memory if needed */
     if (instance->init_params.use_direct_process == DIRECT_PROCESS_DISABLED)
     {
-      if ((instance->init_params.overlap < 0.0f) || (instance->init_params.overlap > 1.0f))
+      /*Compute indexes to be used for overlap */
+      float32_t float_data_len = ((float32_t)(instance->init_params.FFT_len)) * (1.0f - (float32_t)(instance->init_params.overlap));
+      instance->context.new_data_len = (uint32_t) float_data_len;
+      instance->context.old_data_len = instance->init_params.FFT_len - instance->context.new_data_len;
+
+      if ((instance->init_params.overlap < 0.0f) || (instance->init_params.overlap > 1.0f)
+          || (instance->context.new_data_len == 0U))
       {
         instance->context.status = FFT_ERROR_INVALID_PARAMETER;
         retVal = FFT_ERROR_INVALID_PARAMETER;
       }
-      else
-      {
-        /*Compute indexes to be used for overlap */
-        float32_t float_data_len = ((float32_t)(instance->init_params.FFT_len)) * (1.0f - (float32_t)(instance->init_params.overlap));
-        instance->context.new_data_len = (uint32_t) float_data_len;
-        instance->context.old_data_len = instance->init_params.FFT_len - instance->context.new_data_len;
-      }
     }
+    else
+    {
+      instance->context.new_data_len = 0;
+      instance->context.old_data_len = 0;
+    }
+
+    /* The analysis buffer keeps one full frame plus the hop being filled, so that a completed frame is never
+       overwritten by the samples of the next hop before FFT_Process is called */
+    instance->context.ring_len = instance->init_params.FFT_len + instance->context.new_data_len;
+    instance->context.scratch_idx = 0;
+    instance->context.write_idx = 0;
+    instance->context.frame_start = 0;
+
     /* Memory allocation */
     if (FFT_Memory_Allocation(instance) != 0)
     {
@@ -125,8 +159,11 @@ FFT_error_t FFT_Init(FFT_instance_t *instance)
       retVal = FFT_ERROR_MEMORY;
     }
 
-    /* Create window depending on the user choice */
-    FFT_create_window(instance);
+    /* Create window depending on the user choice, unless a precomputed table is used */
+    if (instance->context.win != NULL)
+    {
+      FFT_create_window(instance);
+    }
     FFT_Set_Normalize_Function(instance);
   }
 
@@ -144,15 +181,25 @@ FFT_error_t FFT_DeInit(FFT_instance_t *instance)
   instance->context.new_data_len = 0;
   instance->context.old_data_len = 0;
   instance->context.scratch_idx = 0;
+  instance->context.ring_len = 0;
+  instance->context.write_idx = 0;
+  instance->context.frame_start = 0;
 #ifdef FFT_DYNAMIC_ALLOCATION
   /* Memory deallocation */
-  FFT_free(instance->context.win);
-  FFT_free(instance->context.scratch);
-  FFT_free(instance->context.dataIn);
-  FFT_free(instance->context.fftIn);
-  FFT_free(instance->context.fftOut);
+  if ((instance->init_params.user_memory & FFT_USER_BUFFER) == 0U)
+  {
+    FFT_free(instance->context.win);
+    FFT_free(instance->context.dataIn);
+    FFT_free(instance->context.fftIn);
+    FFT_free(instance->context.fftOut);
+  }
 #endif
-  instance->context.normalizeData = NULL;
+  instance->context.win = NULL;
+  instance->context.winCoeffs = NULL;
+  instance->context.dataIn = NULL;
+  instance->context.fftIn = NULL;
+  instance->context.fftOut = NULL;
+  instance->context.convertData = NULL;
 
   return FFT_ERROR_NONE;
 }
@@ -178,15 +225,16 @@ int32_t FFT_getMemorySize(FFT_instance_t *instance)
     counterBytes += instance->init_params.FFT_len * sizeof(float32_t);
     counterBytes += instance->init_params.FFT_len * sizeof(float32_t);
 
-    if (instance->init_params.win_type != FFT_RECT_WIN)
+    if (FFT_Window_Storage_Needed(instance) != 0U)
     {
       counterBytes += instance->init_params.FFT_len * sizeof(float32_t);
     }
-    if (instance->init_params.output_type == MAGNITUDE)
+    if (instance->init_params.output_type != COMPLEX)
     {
       counterBytes += instance->init_params.FFT_len * sizeof(float32_t);
     }
-    if ((instance->init_params.overlap >= 0.0f) && (instance->init_params.overlap <= 1.0f))
+    if ((instance->init_params.use_direct_process == DIRECT_PROCESS_DISABLED)
+        && (instance->init_params.overlap >= 0.0f) && (instance->init_params.overlap <= 1.0f))
     {
       float32_t new_data_len = ((float32_t)(instance->init_params.FFT_len) * (1.0f - (float32_t)(instance->init_params.overlap)));
       counterBytes += (uint32_t)new_data_len * sizeof(float32_t);
@@ -206,47 +254,49 @@ int32_t FFT_getMemorySize(FFT_instance_t *instance)
 int32_t FFT_Data_Input(void *data, uint32_t len, FFT_instance_t *instance)
 {
   int32_t ret = 0;
-  uint32_t index;
-  FFT_data_type_t dataType = instance->init_params.data_type;
+  uint32_t index = 0;
   uint32_t s_idx = instance->context.scratch_idx;
+  uint32_t w_idx = instance->context.write_idx;
   uint32_t new_data_len = instance->context.new_data_len;
-  float32_t *scratch_ptr = &instance->context.scratch[s_idx];
+  uint32_t ring_len = instance->context.ring_len;
 
-  for (index = 0; index < len; index++)
+  while (index < len)
   {
-    switch (dataType)
+    /* Convert the largest chunk that neither completes more than one hop nor crosses the end of the ring */
+    uint32_t chunk = len - index;
+
+    if (chunk > (new_data_len - s_idx))
+    {
+      chunk = new_data_len - s_idx;
+    }
+    if (chunk > (ring_len - w_idx))
     {
-      case FLOAT32:
-        *scratch_ptr++ = FFT_NormalizeFloat(data, index);
-        break;
-      case INT32:
-        *scratch_ptr++ = FFT_NormalizeInt32(data, index);
-        break;
-      case INT16:
-        *scratch_ptr++ = FFT_NormalizeInt16(data, index);
-        break;
-      default:
-        *scratch_ptr++ = FFT_NormalizeInt16(data, index);
-        break;
+      chunk = ring_len - w_idx;
     }
 
-    s_idx++;
+    instance->context.convertData(data, index, &instance->context.dataIn[w_idx], chunk);
 
-    if (s_idx == new_data_len)
+    index += chunk;
+    s_idx += chunk;
+    w_idx += chunk;
+    if (w_idx == ring_len)
     {
-      float32_t *data_in = instance->context.dataIn;
-      uint32_t old_data_len = instance->context.old_data_len;
-
-      (void)memcpy(data_in, &data_in[instance->init_params.FFT_len - old_data_len], old_data_len * sizeof(float32_t));
-      (void)memcpy(&data_in[old_data_len], instance->context.scratch, new_data_len * sizeof(float32_t));
+      w_idx = 0;
+    }
 
+    if (s_idx == new_data_len)
+    {
+      /* The frame is made of the last FFT_len samples written */
+      instance->context.frame_start = (w_idx >= instance->init_params.FFT_len) ?
+                                      (w_idx - instance->init_params.FFT_len) :
+                                      (w_idx + new_data_len);
       ret = 1;
       s_idx = 0;
-      scratch_ptr = &instance->context.scratch[0];
     }
   }
 
   instance->context.scratch_idx = s_idx;
+  instance->context.write_idx = w_idx;
   return ret;
 }
 
@@ -259,18 +309,10 @@ int32_t FFT_Data_Input(void *data, uint32_t len, FFT_instance_t *instance)
 FFT_error_t FFT_Process(FFT_instance_t *instance, void *output)
 {
   FFT_error_t retVal;
-  float32_t *win = instance->context.win;
-  float32_t *dataIn = instance->context.dataIn;
   float32_t *fftIn = instance->context.fftIn;
 
-  if (instance->init_params.win_type != FFT_RECT_WIN)
-  {
-    arm_mult_f32(dataIn, win, fftIn, instance->init_params.FFT_len);
-  }
-  else
-  {
-    (void)memcpy(fftIn, dataIn, sizeof(float32_t) * instance->init_params.FFT_len);
-  }
+  FFT_Window_Frame(instance->context.winCoeffs, instance->context.dataIn, instance->context.frame_start, instance->context.ring_len,
+                   fftIn, instance->init_params.FFT_len);
 
   if (instance->init_params.output_type == COMPLEX)
   {
@@ -284,6 +326,13 @@ FFT_error_t FFT_Process(FFT_instance_t *instance, void *output)
     arm_cmplx_mag_f32(fftOut, output, instance->init_params.FFT_len / 2U);
   }
 
+  if (instance->init_params.output_type == POWER)
+  {
+    float32_t *fftOut = instance->context.fftOut;
+    arm_rfft_fast_f32(&instance->context.S, fftIn, fftOut, 0);
+    arm_cmplx_mag_squared_f32(fftOut, output, instance->init_params.FFT_len / 2U);
+  }
+
   if ((output == NULL) || (instance == NULL))
   {
     instance->context.status = FFT_ERROR_INVALID_PARAMETER;
@@ -314,23 +363,11 @@ FFT_error_t FFT_Process(FFT_instance_t *instance, void *output)
   */
 FFT_error_t FFT_Direct_Process(FFT_instance_t *instance, void *input, float32_t *output)
 {
-  float32_t *win = instance->context.win;
   float32_t *fftIn = instance->context.fftIn;
   float32_t *dataIn = instance->context.dataIn;
 
-  for (uint32_t i = 0; i < instance->init_params.FFT_len; i++)
-  {
-    dataIn[i] = instance->context.normalizeData(input, i);
-  }
-
-  if (instance->init_params.win_type != FFT_RECT_WIN)
-  {
-    arm_mult_f32(dataIn, win, fftIn, instance->init_params.FFT_len);
-  }
-  else
-  {
-    (void)memcpy(fftIn, dataIn, sizeof(float32_t) * instance->init_params.FFT_len);
-  }
+  instance->context.convertData(input, 0, dataIn, instance->init_params.FFT_len);
+  FFT_Window_Frame(instance->context.winCoeffs, dataIn, 0, instance->init_params.FFT_len, fftIn, instance->init_params.FFT_len);
 
   if (instance->init_params.output_type == COMPLEX)
   {
@@ -344,175 +381,1117 @@ FFT_error_t FFT_Direct_Process(FFT_instance_t *instance, void *input, float32_t
     arm_cmplx_mag_f32(fftOut, output, instance->init_params.FFT_len / 2U);
   }
 
+  if (instance->init_params.output_type == POWER)
+  {
+    float32_t *fftOut = instance->context.fftOut;
+    arm_rfft_fast_f32(&instance->context.S, fftIn, fftOut, 0);
+    arm_cmplx_mag_squared_f32(fftOut, output, instance->init_params.FFT_len / 2U);
+  }
+
   return FFT_ERROR_NONE;
 }
-
-
-static void FFT_create_window(FFT_instance_t *instance)
+/**
+  * @brief  Initialize a multi-channel FFT instance. All the channels share one window, one twiddle set and one
+  *         memory arena holding the converted frames of every channel.
+  * @param  FFT_multi_instance_t* instance
+  * @retval FFT_ERROR_NONE if successful, an FFT_error_t code if not
+  */
+FFT_error_t FFT_Multi_Init(FFT_multi_instance_t *instance)
 {
-  /* Create window depending on the user choice */
-  switch (instance->init_params.win_type)
+  FFT_error_t retVal = FFT_ERROR_NONE;
+
+  if (instance == NULL)
   {
-    case FFT_RECT_WIN:
-      break;
-    case FFT_HAMMING_WIN:
-      HammingWin(instance->init_params.FFT_len, instance->context.win);
-      break;
-    case FFT_HANNING_WIN:
-      TukeyWin(instance->init_params.FFT_len, 1.0f, instance->context.win);
-      break;
-    case FFT_BLACKMAN_HARRIS_WIN:
-      BlackmanHarrisWin(instance->init_params.FFT_len, instance->context.win);
-      break;
-    case FFT_TUKEY_0_25_WIN:
-      TukeyWin(instance->init_params.FFT_len, 0.25f, instance->context.win);
-      break;
-    case FFT_TUKEY_0_75_WIN:
-      TukeyWin(instance->init_params.FFT_len, 0.75f, instance->context.win);
-      break;
-    default:
-      break;
+    retVal = FFT_ERROR_INVALID_PARAMETER;
+  }
+  else if ((instance->init_params.channels == 0U) || (FFT_Get_Convert_Function(instance->init_params.data_type) == NULL)
+           || !((instance->init_params.layout == FFT_PLANAR) || (instance->init_params.layout == FFT_INTERLEAVED)))
+  {
+    instance->context.status = FFT_ERROR_INVALID_PARAMETER;
+    retVal = FFT_ERROR_INVALID_PARAMETER;
+  }
+  else if (arm_rfft_fast_init_f32(&(instance->context.S), (uint16_t)instance->init_params.FFT_len) != ARM_MATH_SUCCESS)
+  {
+    instance->context.status = FFT_ERROR_INVALID_PARAMETER;
+    retVal = FFT_ERROR_INVALID_PARAMETER;
+  }
+  else
+  {
+    float32_t *arena = NULL;
+
+    instance->context.status = FFT_ERROR_NONE;
+
+    arena = instance->init_params.userBuffer;
+#ifdef FFT_DYNAMIC_ALLOCATION
+    if (arena == NULL)
+    {
+      arena = (float32_t *) FFT_malloc((size_t)FFT_Multi_getMemorySize(instance));
+    }
+#endif
+
+    if (arena == NULL)
+    {
+      instance->context.status = FFT_ERROR_MEMORY;
+      retVal = FFT_ERROR_MEMORY;
+    }
+    else
+    {
+      memset((uint8_t *)arena, 0, (size_t)FFT_Multi_getMemorySize(instance));
+      FFT_Multi_Memory_Carve(instance, arena);
+      FFT_Fill_Window(instance->init_params.win_type, instance->init_params.FFT_len, instance->context.win);
+      instance->context.convertData = FFT_Get_Convert_Function(instance->init_params.data_type);
+    }
   }
+
+  return retVal;
 }
 
 /**
-  * @brief  Chck the memory allocation
-  * @param  FFT_instance_t* instance
-  * @retval 0 if ok
+  * @brief  Deinitialize a multi-channel FFT instance
+  * @param  FFT_multi_instance_t* instance
+  * @retval None
   */
-static int8_t FFT_Memory_Allocation(FFT_instance_t *instance)
+FFT_error_t FFT_Multi_DeInit(FFT_multi_instance_t *instance)
 {
-  int8_t retVal = 0;
 #ifdef FFT_DYNAMIC_ALLOCATION
-  /* Memory allocation */
-  if (FFT_Dynamic_Allocation(instance) != 0)
+  /* The arena starts at the first carved buffer */
+  if (instance->init_params.userBuffer == NULL)
   {
-    instance->context.status = FFT_ERROR_MEMORY;
-    retVal = 2;
+    FFT_free((instance->context.win != NULL) ? instance->context.win : instance->context.frames);
   }
 #endif
-#ifdef FFT_STATIC_ALLOCATION
-  FFT_Static_Allocation(instance);
-#endif
+  instance->context.win = NULL;
+  instance->context.frames = NULL;
+  instance->context.fftIn = NULL;
+  instance->context.fftOut = NULL;
+  instance->context.convertData = NULL;
 
-  return retVal;
+  return FFT_ERROR_NONE;
 }
 
-
 /**
-  * @brief  Initialize dynamically the FFT memory
-  * @param  FFT_instance_t* instance
-  * @retval 0 if successful, -1 if not
+  * @brief  Return the size in bytes of the arena needed by a multi-channel instance
+  * @param  FFT_multi_instance_t* instance
+  * @retval arena size in bytes, -1 if instance is NULL
   */
-#ifdef FFT_DYNAMIC_ALLOCATION
-static int8_t FFT_Dynamic_Allocation(FFT_instance_t *instance)
+int32_t FFT_Multi_getMemorySize(FFT_multi_instance_t *instance)
 {
-  int8_t retVal = 0;
+  uint32_t counterBytes = 0;
+  int32_t retVal;
 
-  /* Memory allocation */
-  if (instance->init_params.win_type != FFT_RECT_WIN)
+  if (instance == NULL)
   {
-    instance->context.win = (float32_t *) FFT_malloc(instance->init_params.FFT_len * sizeof(float32_t));
-    memset((uint8_t *)instance->context.win, 0, instance->init_params.FFT_len * sizeof(float32_t));
-    if (!instance->context.win)
-    {
-      instance->context.status = FFT_ERROR_MEMORY;
-    }
+    retVal = -1;
   }
-  if (instance->init_params.output_type == MAGNITUDE)
+  else
   {
-    instance->context.fftOut = (float32_t *) FFT_malloc(instance->init_params.FFT_len * sizeof(float32_t));
-    memset((uint8_t *)instance->context.fftOut, 0, instance->init_params.FFT_len * sizeof(float32_t));
-    if (!instance->context.fftOut)
+    uint32_t len = instance->init_params.FFT_len;
+
+    if (instance->init_params.win_type != FFT_RECT_WIN)
     {
-      instance->context.status = FFT_ERROR_MEMORY;
+      counterBytes += len * sizeof(float32_t);
+    }
+    counterBytes += instance->init_params.channels * len * sizeof(float32_t);
+    counterBytes += len * sizeof(float32_t);
+    if (instance->init_params.output_type != COMPLEX)
+    {
+      counterBytes += len * sizeof(float32_t);
     }
+    retVal = (int32_t)counterBytes;
   }
-  instance->context.dataIn = (float32_t *) FFT_malloc(instance->init_params.FFT_len * sizeof(float32_t));
-  memset((uint8_t *)instance->context.dataIn, 0, instance->init_params.FFT_len * sizeof(float32_t));
-  instance->context.fftIn = (float32_t *) FFT_malloc(instance->init_params.FFT_len * sizeof(float32_t));
-  memset((uint8_t *)instance->context.fftIn, 0, instance->init_params.FFT_len * sizeof(float32_t));
+  return retVal;
+}
 
-  if (!instance->context.fftIn || !instance->context.dataIn)
+/**
+  * @brief  Execute the FFT of one frame of every channel
+  * @param  FFT_multi_instance_t* instance
+  * @param  input: channels * FFT_len samples of data_type, laid out as set by the layout parameter
+  * @param  output: channels spectra one after the other, FFT_len floats each for COMPLEX output
+  *         (arm_rfft_fast_f32 packing) or FFT_len / 2 floats each for MAGNITUDE and POWER output
+  * @retval FFT_ERROR_NONE if successful, an FFT_error_t code if not
+  */
+FFT_error_t FFT_Multi_Process(FFT_multi_instance_t *instance, void *input, float32_t *output)
+{
+  FFT_error_t retVal = FFT_ERROR_NONE;
+
+  if ((instance == NULL) || (input == NULL) || (output == NULL))
   {
-    retVal = -1;
+    retVal = FFT_ERROR_INVALID_PARAMETER;
+  }
+  else if (instance->context.status != FFT_ERROR_NONE)
+  {
+    retVal = FFT_ERROR_INVALID_EXECUTION;
   }
   else
   {
-    if (instance->init_params.use_direct_process == DIRECT_PROCESS_DISABLED)
+    uint32_t len = instance->init_params.FFT_len;
+    uint32_t channels = instance->init_params.channels;
+    uint32_t out_len = (instance->init_params.output_type == COMPLEX) ? len : (len / 2U);
+    float32_t *win = instance->context.win;
+    float32_t *frames = instance->context.frames;
+    float32_t *fftIn = instance->context.fftIn;
+
+    /* One bulk conversion for all the channels, the layout is resolved by the windowing pass */
+    instance->context.convertData(input, 0, frames, channels * len);
+
+    for (uint32_t ch = 0; ch < channels; ch++)
     {
-      instance->context.scratch = (float32_t *) FFT_malloc(instance->context.new_data_len * sizeof(float32_t));
-      memset((uint8_t *)instance->context.scratch, 0, instance->context.new_data_len * sizeof(float32_t));
-      if (!instance->context.scratch)
+      if (instance->init_params.layout == FFT_PLANAR)
+      {
+        float32_t *src = &frames[ch * len];
+
+        if (win != NULL)
+        {
+          arm_mult_f32(src, win, fftIn, len);
+        }
+        else
+        {
+          (void)memcpy(fftIn, src, sizeof(float32_t) * len);
+        }
+      }
+      else
+      {
+        float32_t *src = &frames[ch];
+
+        for (uint32_t i = 0; i < len; i++)
+        {
+          fftIn[i] = (win != NULL) ? (*src * win[i]) : *src;
+          src += channels;
+        }
+      }
+
+      if (instance->init_params.output_type == COMPLEX)
+      {
+        arm_rfft_fast_f32(&instance->context.S, fftIn, &output[ch * out_len], 0);
+      }
+      else if (instance->init_params.output_type == MAGNITUDE)
+      {
+        arm_rfft_fast_f32(&instance->context.S, fftIn, instance->context.fftOut, 0);
+        arm_cmplx_mag_f32(instance->context.fftOut, &output[ch * out_len], out_len);
+      }
+      else
       {
-        retVal = -1;
+        arm_rfft_fast_f32(&instance->context.S, fftIn, instance->context.fftOut, 0);
+        arm_cmplx_mag_squared_f32(instance->context.fftOut, &output[ch * out_len], out_len);
       }
     }
   }
 
   return retVal;
 }
-#endif
 
 /**
-  * @brief  Initialize statically the FFT memory using the buffer passed by the user.
-  * @param  FFT_instance_t* instance
-  * @retval 0 if successful, -1 if not
+  * @brief  Initialize a streaming STFT analysis/synthesis instance (weighted overlap-add). The same window is
+  *         used for analysis and synthesis, so its square must satisfy the COLA condition for the chosen hop:
+  *         e.g. FFT_SQRT_HANNING_WIN with hop = FFT_len / 2, FFT_HANNING_WIN or FFT_HAMMING_WIN with
+  *         hop = FFT_len / 4, FFT_RECT_WIN with hop = FFT_len.
+  * @param  FFT_stft_instance_t* instance
+  * @retval FFT_ERROR_NONE if successful, an FFT_error_t code if not
   */
-#ifdef FFT_STATIC_ALLOCATION
-void FFT_Static_Allocation(FFT_instance_t *instance)
+FFT_error_t FFT_STFT_Init(FFT_stft_instance_t *instance)
 {
-  uint32_t index = 0;
-
-  instance->context.dataIn = instance->init_params.userBuffer;
-  index += instance->init_params.FFT_len;
-
-  instance->context.fftIn = &instance->init_params.userBuffer[index];
-  index += instance->init_params.FFT_len;
+  FFT_error_t retVal = FFT_ERROR_NONE;
+  uint32_t len = instance->init_params.FFT_len;
+  uint32_t hop = instance->init_params.hop;
 
-  if (instance->init_params.win_type != FFT_RECT_WIN)
+  if ((hop == 0U) || (hop > len) || ((len % hop) != 0U)
+      || (FFT_Get_Convert_Function(instance->init_params.data_type) == NULL)
+      || !((instance->init_params.latency == FFT_STFT_BUFFERED) || (instance->init_params.latency == FFT_STFT_LOW_LATENCY)))
   {
-    instance->context.win = &instance->init_params.userBuffer[index];
-    index += instance->init_params.FFT_len;
+    retVal = FFT_ERROR_INVALID_PARAMETER;
   }
-  if (instance->init_params.output_type == MAGNITUDE)
+  else if (arm_rfft_fast_init_f32(&(instance->context.S), (uint16_t)len) != ARM_MATH_SUCCESS)
   {
-    instance->context.fftOut = &instance->init_params.userBuffer[index];
-    index += instance->init_params.FFT_len;
+    retVal = FFT_ERROR_INVALID_PARAMETER;
   }
-  if ((instance->init_params.overlap > 0) && (instance->init_params.use_direct_process == 0))
+  else
   {
-    instance->context.scratch = &instance->init_params.userBuffer[index];
-  }
-}
+    float32_t *arena = NULL;
+
+    arena = instance->init_params.userBuffer;
+#ifdef FFT_DYNAMIC_ALLOCATION
+    if (arena == NULL)
+    {
+      arena = (float32_t *) FFT_malloc((size_t)FFT_STFT_getMemorySize(instance));
+    }
 #endif
 
+    if (arena == NULL)
+    {
+      retVal = FFT_ERROR_MEMORY;
+    }
+    else
+    {
+      float32_t gain;
 
-static void FFT_Set_Normalize_Function(FFT_instance_t *instance)
+      memset((uint8_t *)arena, 0, (size_t)FFT_STFT_getMemorySize(instance));
+      FFT_STFT_Memory_Carve(instance, arena);
+
+      if (instance->init_params.win_type == FFT_RECT_WIN)
+      {
+        arm_fill_f32(1.0f, instance->context.win, len);
+      }
+      else
+      {
+        FFT_Fill_Window(instance->init_params.win_type, len, instance->context.win);
+      }
+
+      /* The inverse rfft is already scaled by 1/FFT_len, only the window overlap gain is left */
+      gain = FFT_STFT_Cola_Gain(instance->context.win, len, hop);
+      if (gain <= 0.0f)
+      {
+        retVal = FFT_ERROR_INVALID_PARAMETER;
+      }
+      else
+      {
+        arm_scale_f32(instance->context.win, 1.0f / gain, instance->context.synthWin, len);
+      }
+
+      instance->context.hop_idx = 0;
+      instance->context.frame_idx = 0;
+      instance->context.ola_start = 0;
+      instance->context.read_idx = len;
+      instance->context.convertData = FFT_Get_Convert_Function(instance->init_params.data_type);
+      switch (instance->init_params.data_type)
+      {
+        case INT32:
+          instance->context.convertOut = FFT_OutInt32;
+          break;
+        case INT16:
+          instance->context.convertOut = FFT_OutInt16;
+          break;
+        default:
+          instance->context.convertOut = FFT_OutFloat;
+          break;
+      }
+
+#ifdef FFT_DYNAMIC_ALLOCATION
+      if ((retVal != FFT_ERROR_NONE) && (instance->init_params.userBuffer == NULL))
+      {
+        FFT_free(arena);
+        instance->context.win = NULL;
+      }
+#endif
+    }
+  }
+
+  instance->context.status = retVal;
+  return retVal;
+}
+
+/**
+  * @brief  Deinitialize a streaming STFT instance
+  * @param  FFT_stft_instance_t* instance
+  * @retval None
+  */
+FFT_error_t FFT_STFT_DeInit(FFT_stft_instance_t *instance)
 {
-  switch (instance->init_params.data_type)
+#ifdef FFT_DYNAMIC_ALLOCATION
+  /* The arena starts with the analysis window */
+  if (instance->init_params.userBuffer == NULL)
   {
-    case FLOAT32:
-      instance->context.normalizeData = FFT_NormalizeFloat;
-      break;
-    case INT32:
-      instance->context.normalizeData = FFT_NormalizeInt32;
-      break;
-    case INT16:
-      instance->context.normalizeData = FFT_NormalizeInt16;
-      break;
-    default:
-      break;
+    FFT_free(instance->context.win);
   }
+#endif
+  instance->context.win = NULL;
+  instance->context.synthWin = NULL;
+  instance->context.frame = NULL;
+  instance->context.fftIn = NULL;
+  instance->context.spectrum = NULL;
+  instance->context.ola = NULL;
+  instance->context.convertData = NULL;
+  instance->context.convertOut = NULL;
+
+  return FFT_ERROR_NONE;
 }
 
 /**
-  * @Brief: Tukey window function
-  *
-  * @Description:
-  *
-  *        /
-  *        |  1/2 * { 1 + cos( 2PI/r * [ x - r/2 ]) },     0 ≤ 1 < r/2
+  * @brief  Return the size in bytes of the arena needed by a streaming STFT instance
+  * @param  FFT_stft_instance_t* instance
+  * @retval arena size in bytes, -1 if instance is NULL
+  */
+int32_t FFT_STFT_getMemorySize(FFT_stft_instance_t *instance)
+{
+  int32_t retVal;
+
+  if (instance == NULL)
+  {
+    retVal = -1;
+  }
+  else
+  {
+    /* win, synthWin, frame, fftIn, spectrum and ola */
+    uint32_t floats = (6U * instance->init_params.FFT_len) + instance->init_params.hop;
+    retVal = (int32_t)(floats * sizeof(float32_t));
+  }
+  return retVal;
+}
+
+/**
+  * @brief  Stream a block of samples through analysis, the spectrum callback and synthesis.
+  *         With FFT_STFT_BUFFERED any block length is accepted and the output is delayed by FFT_len samples.
+  *         With FFT_STFT_LOW_LATENCY len must be a multiple of hop: every hop is output in the same call that
+  *         completes it, so the delay is FFT_len - hop samples, the minimum for the frame length.
+  * @param  FFT_stft_instance_t* instance
+  * @param  input: len samples of data_type
+  * @param  output: len samples of data_type, may be the same buffer as input
+  * @param  len: number of samples
+  * @retval FFT_ERROR_NONE if successful, an FFT_error_t code if not
+  */
+FFT_error_t FFT_STFT_Process(FFT_stft_instance_t *instance, void *input, void *output, uint32_t len)
+{
+  FFT_error_t retVal = FFT_ERROR_NONE;
+  uint32_t index = 0;
+  uint32_t hop = instance->init_params.hop;
+
+  if ((input == NULL) || (output == NULL))
+  {
+    retVal = FFT_ERROR_INVALID_PARAMETER;
+  }
+  else if (instance->context.status != FFT_ERROR_NONE)
+  {
+    retVal = FFT_ERROR_INVALID_EXECUTION;
+  }
+  else if ((instance->init_params.latency == FFT_STFT_LOW_LATENCY) && ((len % hop) != 0U))
+  {
+    retVal = FFT_ERROR_INVALID_PARAMETER;
+  }
+
+  while ((retVal == FFT_ERROR_NONE) && (index < len))
+  {
+    uint32_t chunk = len - index;
+    uint32_t frame_left = instance->init_params.FFT_len - instance->context.frame_idx;
+
+    if (chunk > (hop - instance->context.hop_idx))
+    {
+      chunk = hop - instance->context.hop_idx;
+    }
+    if (chunk > frame_left)
+    {
+      chunk = frame_left;
+    }
+
+    instance->context.convertData(input, index, &instance->context.frame[instance->context.frame_idx], chunk);
+
+    /* Buffered mode outputs the hop synthesized by the previous frame while the next one is collected */
+    if (instance->init_params.latency == FFT_STFT_BUFFERED)
+    {
+      FFT_STFT_Output(instance, output, index, chunk);
+    }
+
+    instance->context.frame_idx += chunk;
+    if (instance->context.frame_idx == instance->init_params.FFT_len)
+    {
+      instance->context.frame_idx = 0;
+    }
+    instance->context.hop_idx += chunk;
+
+    if (instance->context.hop_idx == hop)
+    {
+      instance->context.hop_idx = 0;
+      FFT_STFT_Frame(instance);
+
+      if (instance->init_params.latency == FFT_STFT_LOW_LATENCY)
+      {
+        FFT_STFT_Output(instance, output, index + chunk - hop, hop);
+      }
+    }
+
+    index += chunk;
+  }
+
+  return retVal;
+}
+
+/**
+  * @brief  Initialize a Welch power spectrum accumulator on top of an FFT instance. The FFT instance must be
+  *         initialized with POWER output and DIRECT_PROCESS_DISABLED; its overlap sets the Welch segment overlap.
+  * @param  FFT_welch_instance_t* instance
+  * @param  FFT_instance_t* fft
+  * @retval FFT_ERROR_NONE if successful, an FFT_error_t code if not
+  */
+FFT_error_t FFT_Welch_Init(FFT_welch_instance_t *instance, FFT_instance_t *fft)
+{
+  FFT_error_t retVal = FFT_ERROR_NONE;
+  float32_t *arena = NULL;
+
+  if ((fft == NULL) || (fft->context.status != FFT_ERROR_NONE) || (fft->init_params.output_type != POWER)
+      || (fft->init_params.use_direct_process != DIRECT_PROCESS_DISABLED))
+  {
+    retVal = FFT_ERROR_INVALID_PARAMETER;
+  }
+  else if ((instance->init_params.frames == 0U)
+           || !((instance->init_params.averaging == FFT_WELCH_BLOCK) || (instance->init_params.averaging == FFT_WELCH_EXPONENTIAL))
+           || ((instance->init_params.averaging == FFT_WELCH_EXPONENTIAL)
+               && ((instance->init_params.alpha <= 0.0f) || (instance->init_params.alpha > 1.0f)))
+           || (((instance->init_params.stats & FFT_WELCH_STAT_PEAK_HOLD) != 0U)
+               && ((instance->init_params.peak_decay < 0.0f) || (instance->init_params.peak_decay > 1.0f)))
+           || ((instance->init_params.num_bands > 0U) && (instance->init_params.band_edges == NULL)))
+  {
+    retVal = FFT_ERROR_INVALID_PARAMETER;
+  }
+  else
+  {
+    for (uint32_t b = 0; b < instance->init_params.num_bands; b++)
+    {
+      if ((instance->init_params.band_edges[b] >= instance->init_params.band_edges[b + 1U])
+          || (instance->init_params.band_edges[b + 1U] > (fft->init_params.FFT_len / 2U)))
+      {
+        retVal = FFT_ERROR_INVALID_PARAMETER;
+      }
+    }
+  }
+
+  if (retVal == FFT_ERROR_NONE)
+  {
+    arena = instance->init_params.userBuffer;
+#ifdef FFT_DYNAMIC_ALLOCATION
+    if (arena == NULL)
+    {
+      arena = (float32_t *) FFT_malloc((size_t)FFT_Welch_getMemorySize(instance, fft));
+    }
+#endif
+    if (arena == NULL)
+    {
+      retVal = FFT_ERROR_MEMORY;
+    }
+  }
+
+  if (retVal == FFT_ERROR_NONE)
+  {
+    float32_t energy = (float32_t)fft->init_params.FFT_len;
+
+    instance->context.fft = fft;
+    instance->context.bins = fft->init_params.FFT_len / 2U;
+    instance->context.frame_count = 0;
+    instance->context.results = 0;
+    memset((uint8_t *)arena, 0, (size_t)FFT_Welch_getMemorySize(instance, fft));
+    FFT_Welch_Memory_Carve(instance, arena);
+
+    /* Normalize by the window energy, so that results do not depend on the window choice */
+    if (fft->context.winCoeffs != NULL)
+    {
+      arm_power_f32(fft->context.winCoeffs, fft->init_params.FFT_len, &energy);
+    }
+    instance->context.scale = 1.0f / energy;
+  }
+
+  instance->context.status = retVal;
+  return retVal;
+}
+
+/**
+  * @brief  Deinitialize a Welch accumulator
+  * @param  FFT_welch_instance_t* instance
+  * @retval None
+  */
+FFT_error_t FFT_Welch_DeInit(FFT_welch_instance_t *instance)
+{
+#ifdef FFT_DYNAMIC_ALLOCATION
+  /* The arena starts with the power buffer */
+  if (instance->init_params.userBuffer == NULL)
+  {
+    FFT_free(instance->context.power);
+  }
+#endif
+  instance->context.fft = NULL;
+  instance->context.power = NULL;
+  instance->context.acc = NULL;
+  instance->context.psd = NULL;
+  instance->context.min = NULL;
+  instance->context.max = NULL;
+  instance->context.peak = NULL;
+  instance->context.bands = NULL;
+
+  return FFT_ERROR_NONE;
+}
+
+/**
+  * @brief  Return the size in bytes of the arena needed by a Welch accumulator
+  * @param  FFT_welch_instance_t* instance
+  * @param  FFT_instance_t* fft: FFT instance the accumulator will be attached to
+  * @retval arena size in bytes, -1 if a parameter is NULL
+  */
+int32_t FFT_Welch_getMemorySize(FFT_welch_instance_t *instance, FFT_instance_t *fft)
+{
+  int32_t retVal;
+
+  if ((instance == NULL) || (fft == NULL))
+  {
+    retVal = -1;
+  }
+  else
+  {
+    uint32_t bins = fft->init_params.FFT_len / 2U;
+    uint32_t floats = 3U * bins;
+
+    if ((instance->init_params.stats & FFT_WELCH_STAT_MIN) != 0U)
+    {
+      floats += bins;
+    }
+    if ((instance->init_params.stats & FFT_WELCH_STAT_MAX) != 0U)
+    {
+      floats += bins;
+    }
+    if ((instance->init_params.stats & FFT_WELCH_STAT_PEAK_HOLD) != 0U)
+    {
+      floats += bins;
+    }
+    floats += instance->init_params.num_bands;
+    retVal = (int32_t)(floats * sizeof(float32_t));
+  }
+  return retVal;
+}
+
+/**
+  * @brief  Pass input samples to the attached FFT instance and accumulate every completed segment.
+  *         Results (psd, min, max, peak and bands in the context) are refreshed every init_params.frames
+  *         segments; min and max stay valid until the next segment is accumulated.
+  * @param  data: input data buffer, of the FFT instance data type
+  * @param  len: length of input data buffer
+  * @param  FFT_welch_instance_t* instance
+  * @retval 1 if new results are available, 0 if not, -1 on error
+  */
+int32_t FFT_Welch_Data_Input(void *data, uint32_t len, FFT_welch_instance_t *instance)
+{
+  int32_t ret = 0;
+  uint32_t index = 0;
+  FFT_instance_t *fft = instance->context.fft;
+  uint32_t sample_size = (fft->init_params.data_type == INT16) ? sizeof(int16_t) : sizeof(float32_t);
+
+  if ((data == NULL) || (instance->context.status != FFT_ERROR_NONE))
+  {
+    ret = -1;
+  }
+
+  /* Feed at most one hop at a time, so that every segment is accumulated */
+  while ((ret >= 0) && (index < len))
+  {
+    uint32_t chunk = fft->context.new_data_len - fft->context.scratch_idx;
+
+    if (chunk > (len - index))
+    {
+      chunk = len - index;
+    }
+
+    if (FFT_Data_Input(&((uint8_t *)data)[index * sample_size], chunk, fft) == 1)
+    {
+      (void)FFT_Process(fft, instance->context.power);
+      if (FFT_Welch_Accumulate(instance) == 1)
+      {
+        ret = 1;
+      }
+    }
+    index += chunk;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Copy one frame from the analysis buffer into dest, applying the window. The frame starts at
+  *         src[start] and wraps around src_len, so the circular buffer is unwrapped by the same pass.
+  * @param  win: window, NULL for the rectangular window
+  * @param  src: analysis buffer
+  * @param  start: index of the oldest frame sample in src
+  * @param  src_len: length of src
+  * @param  dest: windowed frame
+  * @param  len: frame length
+  * @retval None
+  */
+static void FFT_Window_Frame(const float32_t *win, float32_t *src, uint32_t start, uint32_t src_len, float32_t *dest,
+                             uint32_t len)
+{
+  uint32_t first = src_len - start;
+
+  if (first > len)
+  {
+    first = len;
+  }
+
+  if (win != NULL)
+  {
+    arm_mult_f32(&src[start], win, dest, first);
+    if (first < len)
+    {
+      arm_mult_f32(src, &win[first], &dest[first], len - first);
+    }
+  }
+  else
+  {
+    (void)memcpy(dest, &src[start], sizeof(float32_t) * first);
+    if (first < len)
+    {
+      (void)memcpy(&dest[first], src, sizeof(float32_t) * (len - first));
+    }
+  }
+}
+
+static void FFT_create_window(FFT_instance_t *instance)
+{
+  FFT_Fill_Window(instance->init_params.win_type, instance->init_params.FFT_len, instance->context.win);
+}
+
+static void FFT_Fill_Window(FFT_windows_t win_type, uint32_t len, float32_t *dest)
+{
+  /* Create window depending on the user choice */
+  switch (win_type)
+  {
+    case FFT_RECT_WIN:
+      break;
+    case FFT_HAMMING_WIN:
+      HammingWin(len, dest);
+      break;
+    case FFT_HANNING_WIN:
+      TukeyWin(len, 1.0f, dest);
+      break;
+    case FFT_BLACKMAN_HARRIS_WIN:
+      BlackmanHarrisWin(len, dest);
+      break;
+    case FFT_TUKEY_0_25_WIN:
+      TukeyWin(len, 0.25f, dest);
+      break;
+    case FFT_TUKEY_0_75_WIN:
+      TukeyWin(len, 0.75f, dest);
+      break;
+    case FFT_SQRT_HANNING_WIN:
+      SqrtHanningWin(len, dest);
+      break;
+    default:
+      break;
+  }
+}
+
+/**
+  * @brief  Chck the memory allocation
+  * @param  FFT_instance_t* instance
+  * @retval 0 if ok
+  */
+static int8_t FFT_Memory_Allocation(FFT_instance_t *instance)
+{
+  int8_t retVal = 0;
+
+  instance->context.win = NULL;
+  instance->context.fftOut = NULL;
+
+  if ((instance->init_params.user_memory & FFT_USER_BUFFER) != 0U)
+  {
+    FFT_Static_Allocation(instance);
+  }
+  else
+  {
+#ifdef FFT_DYNAMIC_ALLOCATION
+    /* Memory allocation */
+    if (FFT_Dynamic_Allocation(instance) != 0)
+    {
+      instance->context.status = FFT_ERROR_MEMORY;
+      retVal = 2;
+    }
+#else
+    retVal = 2;
+#endif
+  }
+
+  /* Window coefficients used by the processing */
+  if ((instance->init_params.user_memory & FFT_USER_WINDOW) != 0U)
+  {
+    instance->context.winCoeffs = instance->init_params.userWindow;
+  }
+  else if (instance->init_params.win_type != FFT_RECT_WIN)
+  {
+    instance->context.winCoeffs = instance->context.win;
+  }
+  else
+  {
+    instance->context.winCoeffs = NULL;
+  }
+
+  return retVal;
+}
+
+/**
+  * @brief  Check if the window has to be computed into the instance memory
+  * @param  FFT_instance_t* instance
+  * @retval 1 if a window buffer is needed, 0 for the rectangular window or a user window table
+  */
+static uint8_t FFT_Window_Storage_Needed(FFT_instance_t *instance)
+{
+  return ((instance->init_params.win_type != FFT_RECT_WIN) && ((instance->init_params.user_memory & FFT_USER_WINDOW) == 0U)) ? 1U : 0U;
+}
+
+
+/**
+  * @brief  Initialize dynamically the FFT memory
+  * @param  FFT_instance_t* instance
+  * @retval 0 if successful, -1 if not
+  */
+#ifdef FFT_DYNAMIC_ALLOCATION
+static int8_t FFT_Dynamic_Allocation(FFT_instance_t *instance)
+{
+  int8_t retVal = 0;
+
+  /* Memory allocation */
+  if (FFT_Window_Storage_Needed(instance) != 0U)
+  {
+    instance->context.win = (float32_t *) FFT_malloc(instance->init_params.FFT_len * sizeof(float32_t));
+    memset((uint8_t *)instance->context.win, 0, instance->init_params.FFT_len * sizeof(float32_t));
+    if (!instance->context.win)
+    {
+      instance->context.status = FFT_ERROR_MEMORY;
+    }
+  }
+  if (instance->init_params.output_type != COMPLEX)
+  {
+    instance->context.fftOut = (float32_t *) FFT_malloc(instance->init_params.FFT_len * sizeof(float32_t));
+    memset((uint8_t *)instance->context.fftOut, 0, instance->init_params.FFT_len * sizeof(float32_t));
+    if (!instance->context.fftOut)
+    {
+      instance->context.status = FFT_ERROR_MEMORY;
+    }
+  }
+  instance->context.dataIn = (float32_t *) FFT_malloc(instance->context.ring_len * sizeof(float32_t));
+  instance->context.fftIn = (float32_t *) FFT_malloc(instance->init_params.FFT_len * sizeof(float32_t));
+
+  if (!instance->context.fftIn || !instance->context.dataIn)
+  {
+    retVal = -1;
+  }
+  else
+  {
+    memset((uint8_t *)instance->context.dataIn, 0, instance->context.ring_len * sizeof(float32_t));
+    memset((uint8_t *)instance->context.fftIn, 0, instance->init_params.FFT_len * sizeof(float32_t));
+  }
+
+  return retVal;
+}
+#endif
+
+/**
+  * @brief  Initialize statically the FFT memory using the buffer passed by the user.
+  * @param  FFT_instance_t* instance
+  * @retval None
+  */
+static void FFT_Static_Allocation(FFT_instance_t *instance)
+{
+  uint32_t index = 0;
+
+  instance->context.dataIn = instance->init_params.userBuffer;
+  index += instance->context.ring_len;
+
+  instance->context.fftIn = &instance->init_params.userBuffer[index];
+  index += instance->init_params.FFT_len;
+
+  if (FFT_Window_Storage_Needed(instance) != 0U)
+  {
+    instance->context.win = &instance->init_params.userBuffer[index];
+    index += instance->init_params.FFT_len;
+  }
+  if (instance->init_params.output_type != COMPLEX)
+  {
+    instance->context.fftOut = &instance->init_params.userBuffer[index];
+    index += instance->init_params.FFT_len;
+  }
+  memset((uint8_t *)instance->init_params.userBuffer, 0, index * sizeof(float32_t));
+}
+
+
+static void FFT_Set_Normalize_Function(FFT_instance_t *instance)
+{
+  instance->context.convertData = FFT_Get_Convert_Function(instance->init_params.data_type);
+}
+
+static FFT_Convert_Function FFT_Get_Convert_Function(FFT_data_type_t data_type)
+{
+  FFT_Convert_Function convert = NULL;
+
+  switch (data_type)
+  {
+    case FLOAT32:
+      convert = FFT_ConvertFloat;
+      break;
+    case INT32:
+      convert = FFT_ConvertInt32;
+      break;
+    case INT16:
+      convert = FFT_ConvertInt16;
+      break;
+    default:
+      break;
+  }
+  return convert;
+}
+
+/**
+  * @brief  Split the multi-channel arena, in the order documented in FFT_multi_init_params_t
+  * @param  FFT_multi_instance_t* instance
+  * @param  arena: FFT_Multi_getMemorySize() bytes
+  * @retval None
+  */
+static void FFT_Multi_Memory_Carve(FFT_multi_instance_t *instance, float32_t *arena)
+{
+  uint32_t index = 0;
+  uint32_t len = instance->init_params.FFT_len;
+
+  instance->context.win = NULL;
+  instance->context.fftOut = NULL;
+
+  if (instance->init_params.win_type != FFT_RECT_WIN)
+  {
+    instance->context.win = &arena[index];
+    index += len;
+  }
+  instance->context.frames = &arena[index];
+  index += instance->init_params.channels * len;
+
+  instance->context.fftIn = &arena[index];
+  index += len;
+
+  if (instance->init_params.output_type != COMPLEX)
+  {
+    instance->context.fftOut = &arena[index];
+  }
+}
+
+/**
+  * @brief  Split the STFT arena, in the order documented in FFT_stft_init_params_t
+  * @param  FFT_stft_instance_t* instance
+  * @param  arena: FFT_STFT_getMemorySize() bytes
+  * @retval None
+  */
+static void FFT_STFT_Memory_Carve(FFT_stft_instance_t *instance, float32_t *arena)
+{
+  uint32_t len = instance->init_params.FFT_len;
+
+  instance->context.win = arena;
+  instance->context.synthWin = &arena[len];
+  instance->context.frame = &arena[2U * len];
+  instance->context.fftIn = &arena[3U * len];
+  instance->context.spectrum = &arena[4U * len];
+  instance->context.ola = &arena[5U * len];
+}
+
+/**
+  * @brief  Split the Welch arena, in the order documented in FFT_welch_init_params_t
+  * @param  FFT_welch_instance_t* instance
+  * @param  arena: FFT_Welch_getMemorySize() bytes
+  * @retval None
+  */
+static void FFT_Welch_Memory_Carve(FFT_welch_instance_t *instance, float32_t *arena)
+{
+  uint32_t bins = instance->context.bins;
+  uint32_t index = 0;
+
+  instance->context.power = &arena[index];
+  index += bins;
+  instance->context.acc = &arena[index];
+  index += bins;
+  instance->context.psd = &arena[index];
+  index += bins;
+
+  instance->context.min = NULL;
+  instance->context.max = NULL;
+  instance->context.peak = NULL;
+
+  if ((instance->init_params.stats & FFT_WELCH_STAT_MIN) != 0U)
+  {
+    instance->context.min = &arena[index];
+    index += bins;
+  }
+  if ((instance->init_params.stats & FFT_WELCH_STAT_MAX) != 0U)
+  {
+    instance->context.max = &arena[index];
+    index += bins;
+  }
+  if ((instance->init_params.stats & FFT_WELCH_STAT_PEAK_HOLD) != 0U)
+  {
+    instance->context.peak = &arena[index];
+    index += bins;
+  }
+  instance->context.bands = &arena[index];
+}
+
+/**
+  * @brief  Accumulate the power spectrum of the last segment
+  * @param  FFT_welch_instance_t* instance
+  * @retval 1 if a result period has been completed, 0 if not
+  */
+static int32_t FFT_Welch_Accumulate(FFT_welch_instance_t *instance)
+{
+  int32_t ret = 0;
+  uint32_t bins = instance->context.bins;
+  float32_t *power = instance->context.power;
+  float32_t *acc = instance->context.acc;
+  uint32_t first = (instance->context.frame_count == 0U) ? 1U : 0U;
+
+  arm_scale_f32(power, instance->context.scale, power, bins);
+
+  for (uint32_t k = 0; k < bins; k++)
+  {
+    if ((instance->context.min != NULL) && ((first == 1U) || (power[k] < instance->context.min[k])))
+    {
+      instance->context.min[k] = power[k];
+    }
+    if ((instance->context.max != NULL) && ((first == 1U) || (power[k] > instance->context.max[k])))
+    {
+      instance->context.max[k] = power[k];
+    }
+    if (instance->context.peak != NULL)
+    {
+      float32_t held = instance->context.peak[k] * instance->init_params.peak_decay;
+      instance->context.peak[k] = (power[k] > held) ? power[k] : held;
+    }
+  }
+
+  if ((instance->init_params.averaging == FFT_WELCH_BLOCK) && (first == 0U))
+  {
+    arm_add_f32(acc, power, acc, bins);
+  }
+  else if ((instance->init_params.averaging == FFT_WELCH_EXPONENTIAL)
+           && ((instance->context.results != 0U) || (first == 0U)))
+  {
+    /* acc += alpha * (power - acc) */
+    arm_sub_f32(power, acc, power, bins);
+    arm_scale_f32(power, instance->init_params.alpha, power, bins);
+    arm_add_f32(acc, power, acc, bins);
+  }
+  else
+  {
+    /* First segment of a block, or first segment ever for the exponential average */
+    (void)memcpy(acc, power, bins * sizeof(float32_t));
+  }
+
+  instance->context.frame_count++;
+  if (instance->context.frame_count == instance->init_params.frames)
+  {
+    if (instance->init_params.averaging == FFT_WELCH_BLOCK)
+    {
+      arm_scale_f32(acc, 1.0f / (float32_t)instance->init_params.frames, instance->context.psd, bins);
+    }
+    else
+    {
+      (void)memcpy(instance->context.psd, acc, bins * sizeof(float32_t));
+    }
+
+    for (uint32_t b = 0; b < instance->init_params.num_bands; b++)
+    {
+      float32_t energy = 0.0f;
+
+      for (uint32_t k = instance->init_params.band_edges[b]; k < instance->init_params.band_edges[b + 1U]; k++)
+      {
+        energy += instance->context.psd[k];
+      }
+      instance->context.bands[b] = energy;
+    }
+
+    instance->context.frame_count = 0;
+    instance->context.results++;
+    ret = 1;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Check the COLA condition of the squared window for the given hop
+  * @param  win: window
+  * @param  len: window length
+  * @param  hop: hop size, dividing len
+  * @retval overlap gain of the squared window, 0 if it is not constant over time
+  */
+static float32_t FFT_STFT_Cola_Gain(float32_t *win, uint32_t len, uint32_t hop)
+{
+  float32_t min_sum = 0.0f;
+  float32_t max_sum = 0.0f;
+
+  for (uint32_t n = 0; n < hop; n++)
+  {
+    float32_t sum = 0.0f;
+
+    for (uint32_t i = n; i < len; i += hop)
+    {
+      sum += win[i] * win[i];
+    }
+    if ((n == 0U) || (sum < min_sum))
+    {
+      min_sum = sum;
+    }
+    if ((n == 0U) || (sum > max_sum))
+    {
+      max_sum = sum;
+    }
+  }
+
+  return ((max_sum > 0.0f) && ((max_sum - min_sum) <= (FFT_COLA_TOLERANCE * max_sum))) ? (0.5f * (max_sum + min_sum)) : 0.0f;
+}
+
+/**
+  * @brief  Analyse the last FFT_len samples, run the spectrum callback and overlap-add the synthesized frame
+  * @param  FFT_stft_instance_t* instance
+  * @retval None
+  */
+static void FFT_STFT_Frame(FFT_stft_instance_t *instance)
+{
+  uint32_t len = instance->init_params.FFT_len;
+  uint32_t hop = instance->init_params.hop;
+  uint32_t ola_len = len + hop;
+  uint32_t start = instance->context.ola_start;
+  uint32_t first = ola_len - start;
+  float32_t *fftIn = instance->context.fftIn;
+  float32_t *spectrum = instance->context.spectrum;
+  float32_t *ola = instance->context.ola;
+
+  /* The analysis buffer is full, its oldest sample is the next one to be written */
+  FFT_Window_Frame(instance->context.win, instance->context.frame, instance->context.frame_idx, len, fftIn, len);
+  arm_rfft_fast_f32(&instance->context.S, fftIn, spectrum, 0);
+
+  if (instance->init_params.callback != NULL)
+  {
+    instance->init_params.callback(spectrum, len, instance->init_params.callback_param);
+  }
+
+  arm_rfft_fast_f32(&instance->context.S, spectrum, fftIn, 1);
+  arm_mult_f32(fftIn, instance->context.synthWin, fftIn, len);
+
+  /* Overlap-add in place: the ola ring is one hop longer than a frame, so the hop being output is never
+     touched by the next frame */
+  if (first > len)
+  {
+    first = len;
+  }
+  arm_add_f32(&ola[start], fftIn, &ola[start], first);
+  if (first < len)
+  {
+    arm_add_f32(ola, &fftIn[first], ola, len - first);
+  }
+
+  instance->context.read_idx = start;
+  instance->context.ola_start = (start + hop) % ola_len;
+}
+
+/**
+  * @brief  Output samples of the completed hop, clearing them for the next overlap-add
+  * @param  FFT_stft_instance_t* instance
+  * @param  output: output buffer
+  * @param  offset: first output sample to be written
+  * @param  len: number of samples, not crossing the end of the hop
+  * @retval None
+  */
+static void FFT_STFT_Output(FFT_stft_instance_t *instance, void *output, uint32_t offset, uint32_t len)
+{
+  float32_t *src = &instance->context.ola[instance->context.read_idx];
+
+  instance->context.convertOut(src, output, offset, len);
+  memset((uint8_t *)src, 0, len * sizeof(float32_t));
+  instance->context.read_idx += len;
+}
+
+/**
+  * @Brief: Tukey window function
+  *
+  * @Description:
+  *
+  *        /
+  *        |  1/2 * { 1 + cos( 2PI/r * [ x - r/2 ]) },     0 ≤ 1 < r/2
   *          |
   *    f(x) = <   1,                     r/2 ≤ x < 1 - r/2
   *        |
@@ -584,6 +1563,16 @@ static void HammingWin(uint32_t len, float32_t *dest)
   }
 }
 
+static void SqrtHanningWin(uint32_t len, float32_t *dest)
+{
+  TukeyWin(len, 1.0f, dest);
+
+  for (uint32_t x = 0; x < len; x++)
+  {
+    (void)arm_sqrt_f32(dest[x], &dest[x]);
+  }
+}
+
 static void BlackmanHarrisWin(uint32_t len, float32_t *dest)
 {
   uint32_t x = 0;
@@ -597,24 +1586,36 @@ static void BlackmanHarrisWin(uint32_t len, float32_t *dest)
   }
 }
 
-static float32_t FFT_NormalizeFloat(void *data, uint32_t index)
+/* Bulk converters: float input is already normalized, fixed point input is scaled to [-1, 1) by CMSIS-DSP */
+static void FFT_ConvertFloat(void *data, uint32_t offset, float32_t *dest, uint32_t len)
 {
-  float32_t normData = ((float32_t *)(data))[index] / FLOAT_NORM_FACTOR;
-  return normData;
+  (void)memcpy(dest, &((float32_t *)(data))[offset], len * sizeof(float32_t));
 }
 
-static float32_t FFT_NormalizeInt32(void *data, uint32_t index)
+static void FFT_ConvertInt32(void *data, uint32_t offset, float32_t *dest, uint32_t len)
 {
-  float32_t normData = (float32_t)((int32_t *)(data))[index] / INT32_NORM_FACTOR;
-  return normData;
+  arm_q31_to_float(&((q31_t *)(data))[offset], dest, len);
 }
 
-static float32_t FFT_NormalizeInt16(void *data, uint32_t index)
+static void FFT_ConvertInt16(void *data, uint32_t offset, float32_t *dest, uint32_t len)
 {
-  float32_t normData = (float32_t)((int16_t *)(data))[index] / INT16_NORM_FACTOR;
-  return normData;
+  arm_q15_to_float(&((q15_t *)(data))[offset], dest, len);
 }
 
+static void FFT_OutFloat(float32_t *src, void *data, uint32_t offset, uint32_t len)
+{
+  (void)memcpy(&((float32_t *)(data))[offset], src, len * sizeof(float32_t));
+}
+
+static void FFT_OutInt32(float32_t *src, void *data, uint32_t offset, uint32_t len)
+{
+  arm_float_to_q31(src, &((q31_t *)(data))[offset], len);
+}
+
+static void FFT_OutInt16(float32_t *src, void *data, uint32_t offset, uint32_t len)
+{
+  arm_float_to_q15(src, &((q15_t *)(data))[offset], len);
+}
 
 #ifdef FFT_DYNAMIC_ALLOCATION
 void FFT_set_allocation_functions(FFT_Malloc_Function malloc_fun, FFT_Free_Function free_fun)
@@ -622,6 +1623,26 @@ void FFT_set_allocation_functions(FFT_Malloc_Function malloc_fun, FFT_Free_Funct
   FFT_malloc = malloc_fun;
   FFT_free = free_fun;
 }
+
+/**
+  * @brief  Allocate memory with the functions set by FFT_set_allocation_functions, for the modules built on the FFT
+  * @param  size: bytes
+  * @retval Pointer to the memory, NULL if not available
+  */
+void *FFT_Allocate(size_t size)
+{
+  return FFT_malloc(size);
+}
+
+/**
+  * @brief  Release memory obtained with FFT_Allocate
+  * @param  ptr: memory to be released
+  * @retval None
+  */
+void FFT_Release(void *ptr)
+{
+  FFT_free(ptr);
+}
 #endif
 
 /**
@@ -0,0 +1,460 @@
+/**
+  ******************************************************************************
+  * @file    fft_mel.c
+  * @author  SRA
+  * @brief   Log-mel and MFCC feature extraction on top of the FFT helper functions.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file in
+  * the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "fft_mel.h"
+
+/** @addtogroup X_CUBE_MEMSMIC1_Applications
+  * @{
+  */
+
+/** @addtogroup Microphones_Acquisition
+  * @{
+  */
+
+/** @defgroup AUDIO_APPLICATION
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+
+#define FFT_MEL_LOG_FLOOR   1e-10f  /* power floor before the log, about -230 dB */
+#define FFT_MEL_Q8_SCALE    256.0f
+
+/* Private function prototypes -----------------------------------------------*/
+
+static void FFT_Mel_Fft_Params(FFT_mel_instance_t *instance, FFT_instance_t *fft);
+static uint32_t FFT_Mel_Arena_Floats(FFT_mel_instance_t *instance, uint32_t *weights_len);
+static void FFT_Mel_Band(FFT_mel_instance_t *instance, uint32_t band, uint32_t *start, uint32_t *len, float32_t *edges);
+static float32_t FFT_Mel_From_Hz(float32_t hz);
+static float32_t FFT_Mel_To_Hz(float32_t mel);
+static float32_t FFT_Mel_Fast_Log(float32_t x);
+static void FFT_Mel_Frame(FFT_mel_instance_t *instance);
+
+/* Exported Functions --------------------------------------------------------*/
+
+/**
+  * @brief  Initialize the log-mel / MFCC extractor: STFT front end, sparse filterbank and DCT table
+  * @param  FFT_mel_instance_t* instance
+  * @retval FFT_ERROR_NONE if successful, an FFT_error_t code if not
+  */
+FFT_error_t FFT_Mel_Init(FFT_mel_instance_t *instance)
+{
+  FFT_error_t retVal = FFT_ERROR_NONE;
+  float32_t *arena = NULL;
+  uint32_t weights_len = 0;
+
+  if ((instance->init_params.num_mels == 0U) || (instance->init_params.num_mfcc > instance->init_params.num_mels)
+      || (instance->init_params.sample_rate == 0U) || (instance->init_params.f_min < 0.0f)
+      || (instance->init_params.f_max <= instance->init_params.f_min)
+      || (instance->init_params.f_max > (0.5f * (float32_t)instance->init_params.sample_rate))
+      || (instance->init_params.hop == 0U) || (instance->init_params.hop > instance->init_params.FFT_len)
+      || !((instance->init_params.output_type == FFT_MEL_OUTPUT_FLOAT32) || (instance->init_params.output_type == FFT_MEL_OUTPUT_Q8)))
+  {
+    retVal = FFT_ERROR_INVALID_PARAMETER;
+  }
+
+  if (retVal == FFT_ERROR_NONE)
+  {
+    uint32_t floats = FFT_Mel_Arena_Floats(instance, &weights_len);
+
+    arena = instance->init_params.userBuffer;
+#ifdef FFT_DYNAMIC_ALLOCATION
+    if (arena == NULL)
+    {
+      arena = (float32_t *) FFT_Allocate(floats * sizeof(float32_t));
+    }
+#endif
+    if (arena == NULL)
+    {
+      retVal = FFT_ERROR_MEMORY;
+    }
+    else
+    {
+      memset((uint8_t *)arena, 0, floats * sizeof(float32_t));
+    }
+  }
+
+  if (retVal == FFT_ERROR_NONE)
+  {
+    uint32_t bins = instance->init_params.FFT_len / 2U;
+    uint32_t num_mels = instance->init_params.num_mels;
+    uint32_t index;
+    uint32_t w_idx = 0;
+
+    /* STFT front end in the first part of the arena */
+    FFT_Mel_Fft_Params(instance, &instance->context.fft);
+    instance->context.fft.init_params.userBuffer = arena;
+    instance->context.fft.init_params.user_memory = FFT_USER_BUFFER;
+    if ((FFT_Init(&instance->context.fft) != FFT_ERROR_NONE)
+        || (instance->context.fft.context.new_data_len != instance->init_params.hop))
+    {
+      retVal = FFT_ERROR_INVALID_PARAMETER;
+    }
+    index = (uint32_t)FFT_getMemorySize(&instance->context.fft) / sizeof(float32_t);
+
+    instance->context.power = &arena[index];
+    index += bins;
+    instance->context.mel = &arena[index];
+    index += num_mels;
+    instance->context.features = &arena[index];
+    index += num_mels;
+    instance->context.dct = &arena[index];
+    index += instance->init_params.num_mfcc * num_mels;
+    instance->context.weights = &arena[index];
+    index += weights_len;
+    instance->context.band_start = (uint16_t *)&arena[index];
+    instance->context.band_len = &instance->context.band_start[num_mels];
+
+    /* Sparse triangular filterbank, evaluated at the bin frequencies */
+    for (uint32_t m = 0; m < num_mels; m++)
+    {
+      uint32_t start;
+      uint32_t len;
+      float32_t edges[3];
+
+      FFT_Mel_Band(instance, m, &start, &len, edges);
+      instance->context.band_start[m] = (uint16_t)start;
+      instance->context.band_len[m] = (uint16_t)len;
+
+      for (uint32_t k = start; k < (start + len); k++)
+      {
+        float32_t f = ((float32_t)k * (float32_t)instance->init_params.sample_rate) / (float32_t)instance->init_params.FFT_len;
+        instance->context.weights[w_idx] = (f <= edges[1]) ? ((f - edges[0]) / (edges[1] - edges[0]))
+                                           : ((edges[2] - f) / (edges[2] - edges[1]));
+        w_idx++;
+      }
+    }
+
+    /* Orthonormal DCT-II */
+    for (uint32_t k = 0; k < instance->init_params.num_mfcc; k++)
+    {
+      float32_t scale = (k == 0U) ? sqrtf(1.0f / (float32_t)num_mels) : sqrtf(2.0f / (float32_t)num_mels);
+
+      for (uint32_t m = 0; m < num_mels; m++)
+      {
+        instance->context.dct[(k * num_mels) + m] = scale * cosf((M_PI * (float32_t)k * ((float32_t)m + 0.5f)) / (float32_t)num_mels);
+      }
+    }
+
+    instance->context.frames = 0;
+  }
+
+  instance->context.status = retVal;
+  return retVal;
+}
+
+/**
+  * @brief  Deinitialize the feature extractor
+  * @param  FFT_mel_instance_t* instance
+  * @retval None
+  */
+FFT_error_t FFT_Mel_DeInit(FFT_mel_instance_t *instance)
+{
+  /* The FFT instance runs on the mel arena, FFT_DeInit does not release it */
+  float32_t *arena = instance->context.fft.init_params.userBuffer;
+
+  (void)FFT_DeInit(&instance->context.fft);
+#ifdef FFT_DYNAMIC_ALLOCATION
+  if (instance->init_params.userBuffer == NULL)
+  {
+    FFT_Release(arena);
+  }
+#else
+  (void)arena;
+#endif
+  instance->context.power = NULL;
+  instance->context.mel = NULL;
+  instance->context.features = NULL;
+  instance->context.dct = NULL;
+  instance->context.weights = NULL;
+  instance->context.band_start = NULL;
+  instance->context.band_len = NULL;
+
+  return FFT_ERROR_NONE;
+}
+
+/**
+  * @brief  Return the size in bytes of the arena needed by the feature extractor
+  * @param  FFT_mel_instance_t* instance
+  * @retval arena size in bytes, -1 if instance is NULL
+  */
+int32_t FFT_Mel_getMemorySize(FFT_mel_instance_t *instance)
+{
+  int32_t retVal;
+  uint32_t weights_len;
+
+  if (instance == NULL)
+  {
+    retVal = -1;
+  }
+  else
+  {
+    retVal = (int32_t)(FFT_Mel_Arena_Floats(instance, &weights_len) * sizeof(float32_t));
+  }
+  return retVal;
+}
+
+/**
+  * @brief  Pass input samples to the extractor. The callback is called once per completed frame.
+  * @param  data: input data buffer, of data_type
+  * @param  len: length of input data buffer
+  * @param  FFT_mel_instance_t* instance
+  * @retval number of frames produced, -1 on error
+  */
+int32_t FFT_Mel_Data_Input(void *data, uint32_t len, FFT_mel_instance_t *instance)
+{
+  int32_t ret = 0;
+  uint32_t index = 0;
+  FFT_instance_t *fft = &instance->context.fft;
+  uint32_t sample_size = (instance->init_params.data_type == INT16) ? sizeof(int16_t) : sizeof(float32_t);
+
+  if ((data == NULL) || (instance->context.status != FFT_ERROR_NONE))
+  {
+    ret = -1;
+  }
+
+  /* Feed at most one hop at a time, so that every frame is extracted */
+  while ((ret >= 0) && (index < len))
+  {
+    uint32_t chunk = fft->context.new_data_len - fft->context.scratch_idx;
+
+    if (chunk > (len - index))
+    {
+      chunk = len - index;
+    }
+
+    if (FFT_Data_Input(&((uint8_t *)data)[index * sample_size], chunk, fft) == 1)
+    {
+      (void)FFT_Process(fft, instance->context.power);
+      FFT_Mel_Frame(instance);
+      ret++;
+    }
+    index += chunk;
+  }
+
+  return ret;
+}
+
+/* Private Functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Fill the init parameters of the STFT front end
+  * @param  FFT_mel_instance_t* instance
+  * @param  FFT_instance_t* fft: instance to be filled
+  * @retval None
+  */
+static void FFT_Mel_Fft_Params(FFT_mel_instance_t *instance, FFT_instance_t *fft)
+{
+  FFT_init_params_t *params = &fft->init_params;
+
+  memset((uint8_t *)fft, 0, sizeof(FFT_instance_t));
+  params->use_direct_process = DIRECT_PROCESS_DISABLED;
+  params->FFT_len = instance->init_params.FFT_len;
+  params->overlap = 1.0f - ((float32_t)instance->init_params.hop / (float32_t)instance->init_params.FFT_len);
+  params->win_type = instance->init_params.win_type;
+  params->data_type = instance->init_params.data_type;
+  params->output_type = POWER;
+}
+
+/**
+  * @brief  Compute the arena length, mirroring the carving done by FFT_Mel_Init
+  * @param  FFT_mel_instance_t* instance
+  * @param  weights_len: number of non-zero filterbank weights
+  * @retval arena length in floats
+  */
+static uint32_t FFT_Mel_Arena_Floats(FFT_mel_instance_t *instance, uint32_t *weights_len)
+{
+  uint32_t num_mels = instance->init_params.num_mels;
+  uint32_t floats;
+  FFT_instance_t fft;
+
+  *weights_len = 0;
+  for (uint32_t m = 0; m < num_mels; m++)
+  {
+    uint32_t start;
+    uint32_t len;
+    float32_t edges[3];
+
+    FFT_Mel_Band(instance, m, &start, &len, edges);
+    *weights_len += len;
+  }
+
+  FFT_Mel_Fft_Params(instance, &fft);
+  floats = (uint32_t)FFT_getMemorySize(&fft) / sizeof(float32_t);
+  floats += instance->init_params.FFT_len / 2U;             /* power */
+  floats += 2U * num_mels;                                  /* mel, features */
+  floats += instance->init_params.num_mfcc * num_mels;      /* dct */
+  floats += *weights_len;                                   /* weights */
+  floats += num_mels;                                       /* band_start and band_len, 2 x uint16_t */
+
+  return floats;
+}
+
+/**
+  * @brief  Bins covered by a mel band: triangle from edges[0] to edges[2] Hz, peaking at edges[1].
+  *         Bin 0 is skipped as it also holds the Nyquist term of the packed rfft.
+  * @param  FFT_mel_instance_t* instance
+  * @param  band: mel band index
+  * @param  start: first bin with a non-zero weight
+  * @param  len: number of bins with a non-zero weight
+  * @param  edges: lower, center and upper frequencies of the band, in Hz
+  * @retval None
+  */
+static void FFT_Mel_Band(FFT_mel_instance_t *instance, uint32_t band, uint32_t *start, uint32_t *len, float32_t *edges)
+{
+  float32_t mel_min = FFT_Mel_From_Hz(instance->init_params.f_min);
+  float32_t mel_step = (FFT_Mel_From_Hz(instance->init_params.f_max) - mel_min) / (float32_t)(instance->init_params.num_mels + 1U);
+  float32_t bin_hz = (float32_t)instance->init_params.sample_rate / (float32_t)instance->init_params.FFT_len;
+  uint32_t last = (instance->init_params.FFT_len / 2U) - 1U;
+  uint32_t first = 0;
+  uint32_t end = 0;
+
+  for (uint32_t i = 0; i < 3U; i++)
+  {
+    edges[i] = FFT_Mel_To_Hz(mel_min + (mel_step * (float32_t)(band + i)));
+  }
+
+  /* bins strictly inside the triangle */
+  for (uint32_t k = 1; k <= last; k++)
+  {
+    float32_t f = (float32_t)k * bin_hz;
+
+    if ((f > edges[0]) && (f < edges[2]))
+    {
+      if (first == 0U)
+      {
+        first = k;
+      }
+      end = k + 1U;
+    }
+  }
+
+  *start = (first == 0U) ? 1U : first;
+  *len = (first == 0U) ? 0U : (end - first);
+}
+
+static float32_t FFT_Mel_From_Hz(float32_t hz)
+{
+  return 2595.0f * log10f(1.0f + (hz / 700.0f));
+}
+
+static float32_t FFT_Mel_To_Hz(float32_t mel)
+{
+  return 700.0f * (powf(10.0f, mel / 2595.0f) - 1.0f);
+}
+
+/**
+  * @brief  Natural logarithm: exponent from the float encoding, mantissa m in [1, 2) through
+  *         ln(m) = 2 * atanh((m - 1) / (m + 1)), truncated after the t^7 term (error below 2e-5)
+  * @param  x: positive value
+  * @retval ln(x)
+  */
+static float32_t FFT_Mel_Fast_Log(float32_t x)
+{
+  union
+  {
+    float32_t f;
+    uint32_t u;
+  } v;
+  float32_t exponent;
+  float32_t t;
+  float32_t t2;
+
+  v.f = x;
+  exponent = (float32_t)((int32_t)((v.u >> 23) & 0xFFU) - 127);
+  v.u = (v.u & 0x007FFFFFU) | 0x3F800000U;
+
+  t = (v.f - 1.0f) / (v.f + 1.0f);
+  t2 = t * t;
+
+  return (exponent * 0.69314718f) + (2.0f * t * (1.0f + (t2 * ((1.0f / 3.0f) + (t2 * ((1.0f / 5.0f) + (t2 * (1.0f / 7.0f))))))));
+}
+
+/**
+  * @brief  Filterbank, log, optional DCT and output conversion of the power spectrum of the last frame
+  * @param  FFT_mel_instance_t* instance
+  * @retval None
+  */
+static void FFT_Mel_Frame(FFT_mel_instance_t *instance)
+{
+  uint32_t num_mels = instance->init_params.num_mels;
+  uint32_t num_out = (instance->init_params.num_mfcc != 0U) ? instance->init_params.num_mfcc : num_mels;
+  float32_t *weights = instance->context.weights;
+  float32_t *mel = instance->context.mel;
+  float32_t *out = mel;
+
+  for (uint32_t m = 0; m < num_mels; m++)
+  {
+    float32_t energy = 0.0f;
+    uint32_t len = instance->context.band_len[m];
+
+    if (len != 0U)
+    {
+      arm_dot_prod_f32(&instance->context.power[instance->context.band_start[m]], weights, len, &energy);
+      weights = &weights[len];
+    }
+    mel[m] = FFT_Mel_Fast_Log((energy > FFT_MEL_LOG_FLOOR) ? energy : FFT_MEL_LOG_FLOOR);
+  }
+
+  if (instance->init_params.num_mfcc != 0U)
+  {
+    /* The features buffer holds the float coefficients, converted in place for Q8 output */
+    out = (float32_t *)instance->context.features;
+    for (uint32_t k = 0; k < num_out; k++)
+    {
+      arm_dot_prod_f32(&instance->context.dct[k * num_mels], mel, num_mels, &out[k]);
+    }
+  }
+
+  if (instance->init_params.output_type == FFT_MEL_OUTPUT_Q8)
+  {
+    int16_t *q8 = (int16_t *)instance->context.features;
+
+    for (uint32_t k = 0; k < num_out; k++)
+    {
+      float32_t v = out[k] * FFT_MEL_Q8_SCALE;
+      v = (v >= 0.0f) ? (v + 0.5f) : (v - 0.5f);
+      q8[k] = (v >= 32767.0f) ? (int16_t)32767 : ((v <= -32768.0f) ? (int16_t)(-32768) : (int16_t)v);
+    }
+  }
+  else if (out != (float32_t *)instance->context.features)
+  {
+    (void)memcpy(instance->context.features, out, num_out * sizeof(float32_t));
+  }
+
+  instance->context.frames++;
+  if (instance->init_params.callback != NULL)
+  {
+    instance->init_params.callback(instance->context.features, num_out, instance->init_params.callback_param);
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
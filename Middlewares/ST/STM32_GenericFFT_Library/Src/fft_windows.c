@@ -0,0 +1,671 @@
+/**
+  ******************************************************************************
+  * @file    fft_windows.c
+  * @author  SRA
+  * @brief   Precomputed window tables, placed in flash.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file in
+  * the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "fft_windows.h"
+
+/** @addtogroup X_CUBE_MEMSMIC1_Applications
+  * @{
+  */
+
+/** @addtogroup Microphones_Acquisition
+  * @{
+  */
+
+/** @defgroup AUDIO_APPLICATION
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+
+const float32_t FFT_Hanning_256[256] __ALIGNED(FFT_STATIC_ALIGNMENT) =
+{
+  0.000000000e+00f, 1.505911350e-04f, 6.022751331e-04f, 1.354753971e-03f, 2.407640219e-03f, 3.760248423e-03f,
+  5.411744118e-03f, 7.361173630e-03f, 9.607344866e-03f, 1.214894652e-02f, 1.498436928e-02f, 1.811197400e-02f,
+  2.152982354e-02f, 2.523592114e-02f, 2.922794223e-02f, 3.350359201e-02f, 3.806024790e-02f, 4.289510846e-02f,
+  4.800534248e-02f, 5.338785052e-02f, 5.903938413e-02f, 6.495648623e-02f, 7.113569975e-02f, 7.757323980e-02f,
+  8.426517248e-02f, 9.120759368e-02f, 9.839624166e-02f, 1.058267653e-01f, 1.134947538e-01f, 1.213955879e-01f,
+  1.295244694e-01f, 1.378764212e-01f, 1.464466155e-01f, 1.552297473e-01f, 1.642204821e-01f, 1.734135747e-01f,
+  1.828033626e-01f, 1.923842430e-01f, 2.021503150e-01f, 2.120959163e-01f, 2.222149074e-01f, 2.325011492e-01f,
+  2.429486215e-01f, 2.535509169e-01f, 2.643016875e-01f, 2.751943171e-01f, 2.862224579e-01f, 2.973793149e-01f,
+  3.086583018e-01f, 3.200524747e-01f, 3.315550983e-01f, 3.431591392e-01f, 3.548576236e-01f, 3.666436374e-01f,
+  3.785099089e-01f, 3.904494047e-01f, 4.024548531e-01f, 4.145190120e-01f, 4.266347885e-01f, 4.387946427e-01f,
+  4.509914517e-01f, 4.632177055e-01f, 4.754661918e-01f, 4.877294004e-01f, 4.999999702e-01f, 5.122706294e-01f,
+  5.245338082e-01f, 5.367823243e-01f, 5.490085483e-01f, 5.612053275e-01f, 5.733652711e-01f, 5.854809284e-01f,
+  5.975451469e-01f, 6.095505953e-01f, 6.214901209e-01f, 6.333563924e-01f, 6.451423168e-01f, 6.568409204e-01f,
+  6.684449315e-01f, 6.799475551e-01f, 6.913416982e-01f, 7.026206255e-01f, 7.137775421e-01f, 7.248056531e-01f,
+  7.356984019e-01f, 7.464491129e-01f, 7.570514083e-01f, 7.674988508e-01f, 7.777851224e-01f, 7.879041433e-01f,
+  7.978496552e-01f, 8.076157570e-01f, 8.171966076e-01f, 8.265864253e-01f, 8.357794881e-01f, 8.447703123e-01f,
+  8.535534143e-01f, 8.621235490e-01f, 8.704755306e-01f, 8.786044121e-01f, 8.865052462e-01f, 8.941732645e-01f,
+  9.016037583e-01f, 9.087923765e-01f, 9.157347679e-01f, 9.224268198e-01f, 9.288643003e-01f, 9.350435138e-01f,
+  9.409606457e-01f, 9.466121197e-01f, 9.519946575e-01f, 9.571049213e-01f, 9.619397521e-01f, 9.664964080e-01f,
+  9.707720280e-01f, 9.747641087e-01f, 9.784702063e-01f, 9.818880558e-01f, 9.850156307e-01f, 9.878510237e-01f,
+  9.903926253e-01f, 9.926388264e-01f, 9.945882559e-01f, 9.962397814e-01f, 9.975923300e-01f, 9.986451864e-01f,
+  9.993977547e-01f, 9.998494387e-01f, 1.000000000e+00f, 9.998494387e-01f, 9.993977547e-01f, 9.986451864e-01f,
+  9.975923300e-01f, 9.962397814e-01f, 9.945882559e-01f, 9.926388264e-01f, 9.903926253e-01f, 9.878510237e-01f,
+  9.850156307e-01f, 9.818880558e-01f, 9.784702063e-01f, 9.747641087e-01f, 9.707720280e-01f, 9.664964080e-01f,
+  9.619397521e-01f, 9.571049213e-01f, 9.519946575e-01f, 9.466121197e-01f, 9.409606457e-01f, 9.350435138e-01f,
+  9.288643003e-01f, 9.224268198e-01f, 9.157347679e-01f, 9.087923765e-01f, 9.016037583e-01f, 8.941732645e-01f,
+  8.865052462e-01f, 8.786044121e-01f, 8.704755306e-01f, 8.621235490e-01f, 8.535534143e-01f, 8.447703123e-01f,
+  8.357794881e-01f, 8.265864253e-01f, 8.171966076e-01f, 8.076157570e-01f, 7.978496552e-01f, 7.879041433e-01f,
+  7.777851224e-01f, 7.674988508e-01f, 7.570514083e-01f, 7.464491129e-01f, 7.356984019e-01f, 7.248056531e-01f,
+  7.137775421e-01f, 7.026206255e-01f, 6.913416982e-01f, 6.799475551e-01f, 6.684449315e-01f, 6.568409204e-01f,
+  6.451423168e-01f, 6.333563924e-01f, 6.214901209e-01f, 6.095505953e-01f, 5.975451469e-01f, 5.854809284e-01f,
+  5.733652711e-01f, 5.612053275e-01f, 5.490085483e-01f, 5.367823243e-01f, 5.245338082e-01f, 5.122706294e-01f,
+  4.999999702e-01f, 4.877294004e-01f, 4.754661918e-01f, 4.632177055e-01f, 4.509914517e-01f, 4.387946427e-01f,
+  4.266347885e-01f, 4.145190120e-01f, 4.024548531e-01f, 3.904494047e-01f, 3.785099089e-01f, 3.666436374e-01f,
+  3.548576236e-01f, 3.431591392e-01f, 3.315550983e-01f, 3.200524747e-01f, 3.086583018e-01f, 2.973793149e-01f,
+  2.862224579e-01f, 2.751943171e-01f, 2.643016875e-01f, 2.535509169e-01f, 2.429486215e-01f, 2.325011492e-01f,
+  2.222149074e-01f, 2.120959163e-01f, 2.021503150e-01f, 1.923842430e-01f, 1.828033626e-01f, 1.734135747e-01f,
+  1.642204821e-01f, 1.552297473e-01f, 1.464466155e-01f, 1.378764212e-01f, 1.295244694e-01f, 1.213955879e-01f,
+  1.134947538e-01f, 1.058267653e-01f, 9.839624166e-02f, 9.120759368e-02f, 8.426517248e-02f, 7.757323980e-02f,
+  7.113569975e-02f, 6.495648623e-02f, 5.903938413e-02f, 5.338785052e-02f, 4.800534248e-02f, 4.289510846e-02f,
+  3.806024790e-02f, 3.350359201e-02f, 2.922794223e-02f, 2.523592114e-02f, 2.152982354e-02f, 1.811197400e-02f,
+  1.498436928e-02f, 1.214894652e-02f, 9.607344866e-03f, 7.361173630e-03f, 5.411744118e-03f, 3.760248423e-03f,
+  2.407640219e-03f, 1.354753971e-03f, 6.022751331e-04f, 1.505911350e-04f
+};
+
+const float32_t FFT_Hanning_512[512] __ALIGNED(FFT_STATIC_ALIGNMENT) =
+{
+  0.000000000e+00f, 3.764033318e-05f, 1.505911350e-04f, 3.388226032e-04f, 6.022751331e-04f, 9.409487247e-04f,
+  1.354753971e-03f, 1.843690872e-03f, 2.407640219e-03f, 3.046512604e-03f, 3.760248423e-03f, 4.548698664e-03f,
+  5.411744118e-03f, 6.349295378e-03f, 7.361173630e-03f, 8.447259665e-03f, 9.607344866e-03f, 1.084131002e-02f,
+  1.214894652e-02f, 1.353004575e-02f, 1.498436928e-02f, 1.651176810e-02f, 1.811197400e-02f, 1.978474855e-02f,
+  2.152982354e-02f, 2.334699035e-02f, 2.523592114e-02f, 2.719631791e-02f, 2.922794223e-02f, 3.133049607e-02f,
+  3.350359201e-02f, 3.574696183e-02f, 3.806024790e-02f, 4.044309258e-02f, 4.289510846e-02f, 4.541599751e-02f,
+  4.800534248e-02f, 5.066275597e-02f, 5.338785052e-02f, 5.618020892e-02f, 5.903938413e-02f, 6.196492910e-02f,
+  6.495648623e-02f, 6.801357865e-02f, 7.113569975e-02f, 7.432240248e-02f, 7.757323980e-02f, 8.088767529e-02f,
+  8.426517248e-02f, 8.770534396e-02f, 9.120759368e-02f, 9.477141500e-02f, 9.839624166e-02f, 1.020815670e-01f,
+  1.058267653e-01f, 1.096313596e-01f, 1.134947538e-01f, 1.174163520e-01f, 1.213955879e-01f, 1.254318357e-01f,
+  1.295244694e-01f, 1.336728334e-01f, 1.378764212e-01f, 1.421345770e-01f, 1.464466155e-01f, 1.508118808e-01f,
+  1.552297473e-01f, 1.596995294e-01f, 1.642204821e-01f, 1.687920690e-01f, 1.734135747e-01f, 1.780842245e-01f,
+  1.828033626e-01f, 1.875702739e-01f, 1.923842430e-01f, 1.972444355e-01f, 2.021503150e-01f, 2.071010470e-01f,
+  2.120959163e-01f, 2.171341181e-01f, 2.222149074e-01f, 2.273375392e-01f, 2.325011492e-01f, 2.377051413e-01f,
+  2.429486215e-01f, 2.482308149e-01f, 2.535509169e-01f, 2.589081526e-01f, 2.643016875e-01f, 2.697306275e-01f,
+  2.751943171e-01f, 2.806918621e-01f, 2.862224579e-01f, 2.917852402e-01f, 2.973793149e-01f, 3.030039668e-01f,
+  3.086583018e-01f, 3.143413663e-01f, 3.200524747e-01f, 3.257906735e-01f, 3.315550983e-01f, 3.373448253e-01f,
+  3.431591392e-01f, 3.489970565e-01f, 3.548576236e-01f, 3.607401550e-01f, 3.666436374e-01f, 3.725671470e-01f,
+  3.785099089e-01f, 3.844709396e-01f, 3.904494047e-01f, 3.964442909e-01f, 4.024548531e-01f, 4.084800780e-01f,
+  4.145190120e-01f, 4.205709100e-01f, 4.266347885e-01f, 4.327096641e-01f, 4.387946427e-01f, 4.448888898e-01f,
+  4.509914517e-01f, 4.571013153e-01f, 4.632177055e-01f, 4.693396389e-01f, 4.754661918e-01f, 4.815963805e-01f,
+  4.877294004e-01f, 4.938642383e-01f, 4.999999702e-01f, 5.061357617e-01f, 5.122706294e-01f, 5.184035897e-01f,
+  5.245338082e-01f, 5.306603909e-01f, 5.367823243e-01f, 5.428986549e-01f, 5.490085483e-01f, 5.551111102e-01f,
+  5.612053275e-01f, 5.672903657e-01f, 5.733652711e-01f, 5.794290900e-01f, 5.854809284e-01f, 5.915199518e-01f,
+  5.975451469e-01f, 6.035556793e-01f, 6.095505953e-01f, 6.155290604e-01f, 6.214901209e-01f, 6.274328232e-01f,
+  6.333563924e-01f, 6.392598748e-01f, 6.451423168e-01f, 6.510030031e-01f, 6.568409204e-01f, 6.626551151e-01f,
+  6.684449315e-01f, 6.742093563e-01f, 6.799475551e-01f, 6.856585741e-01f, 6.913416982e-01f, 6.969960332e-01f,
+  7.026206255e-01f, 7.082147598e-01f, 7.137775421e-01f, 7.193081379e-01f, 7.248056531e-01f, 7.302693725e-01f,
+  7.356984019e-01f, 7.410918474e-01f, 7.464491129e-01f, 7.517691851e-01f, 7.570514083e-01f, 7.622948289e-01f,
+  7.674988508e-01f, 7.726625204e-01f, 7.777851224e-01f, 7.828658819e-01f, 7.879041433e-01f, 7.928988934e-01f,
+  7.978496552e-01f, 8.027555346e-01f, 8.076157570e-01f, 8.124297857e-01f, 8.171966076e-01f, 8.219157457e-01f,
+  8.265864253e-01f, 8.312078714e-01f, 8.357794881e-01f, 8.403005004e-01f, 8.447703123e-01f, 8.491880894e-01f,
+  8.535534143e-01f, 8.578654528e-01f, 8.621235490e-01f, 8.663271666e-01f, 8.704755306e-01f, 8.745682240e-01f,
+  8.786044121e-01f, 8.825836182e-01f, 8.865052462e-01f, 8.903685808e-01f, 8.941732645e-01f, 8.979184628e-01f,
+  9.016037583e-01f, 9.052286148e-01f, 9.087923765e-01f, 9.122946262e-01f, 9.157347679e-01f, 9.191123247e-01f,
+  9.224268198e-01f, 9.256775975e-01f, 9.288643003e-01f, 9.319864511e-01f, 9.350435138e-01f, 9.380350113e-01f,
+  9.409606457e-01f, 9.438198209e-01f, 9.466121197e-01f, 9.493372440e-01f, 9.519946575e-01f, 9.545840025e-01f,
+  9.571049213e-01f, 9.595569372e-01f, 9.619397521e-01f, 9.642530680e-01f, 9.664964080e-01f, 9.686695337e-01f,
+  9.707720280e-01f, 9.728036523e-01f, 9.747641087e-01f, 9.766529799e-01f, 9.784702063e-01f, 9.802152514e-01f,
+  9.818880558e-01f, 9.834882021e-01f, 9.850156307e-01f, 9.864699841e-01f, 9.878510237e-01f, 9.891586900e-01f,
+  9.903926253e-01f, 9.915527105e-01f, 9.926388264e-01f, 9.936506748e-01f, 9.945882559e-01f, 9.954513311e-01f,
+  9.962397814e-01f, 9.969534874e-01f, 9.975923300e-01f, 9.981563091e-01f, 9.986451864e-01f, 9.990590811e-01f,
+  9.993977547e-01f, 9.996612072e-01f, 9.998494387e-01f, 9.999623299e-01f, 1.000000000e+00f, 9.999623299e-01f,
+  9.998494387e-01f, 9.996612072e-01f, 9.993977547e-01f, 9.990590811e-01f, 9.986451864e-01f, 9.981563091e-01f,
+  9.975923300e-01f, 9.969534874e-01f, 9.962397814e-01f, 9.954513311e-01f, 9.945882559e-01f, 9.936506748e-01f,
+  9.926388264e-01f, 9.915527105e-01f, 9.903926253e-01f, 9.891586900e-01f, 9.878510237e-01f, 9.864699841e-01f,
+  9.850156307e-01f, 9.834882021e-01f, 9.818880558e-01f, 9.802152514e-01f, 9.784702063e-01f, 9.766529799e-01f,
+  9.747641087e-01f, 9.728036523e-01f, 9.707720280e-01f, 9.686695337e-01f, 9.664964080e-01f, 9.642530680e-01f,
+  9.619397521e-01f, 9.595569372e-01f, 9.571049213e-01f, 9.545840025e-01f, 9.519946575e-01f, 9.493372440e-01f,
+  9.466121197e-01f, 9.438198209e-01f, 9.409606457e-01f, 9.380350113e-01f, 9.350435138e-01f, 9.319864511e-01f,
+  9.288643003e-01f, 9.256775975e-01f, 9.224268198e-01f, 9.191123247e-01f, 9.157347679e-01f, 9.122946262e-01f,
+  9.087923765e-01f, 9.052286148e-01f, 9.016037583e-01f, 8.979184628e-01f, 8.941732645e-01f, 8.903685808e-01f,
+  8.865052462e-01f, 8.825836182e-01f, 8.786044121e-01f, 8.745682240e-01f, 8.704755306e-01f, 8.663271666e-01f,
+  8.621235490e-01f, 8.578654528e-01f, 8.535534143e-01f, 8.491880894e-01f, 8.447703123e-01f, 8.403005004e-01f,
+  8.357794881e-01f, 8.312078714e-01f, 8.265864253e-01f, 8.219157457e-01f, 8.171966076e-01f, 8.124297857e-01f,
+  8.076157570e-01f, 8.027555346e-01f, 7.978496552e-01f, 7.928988934e-01f, 7.879041433e-01f, 7.828658819e-01f,
+  7.777851224e-01f, 7.726625204e-01f, 7.674988508e-01f, 7.622948289e-01f, 7.570514083e-01f, 7.517691851e-01f,
+  7.464491129e-01f, 7.410918474e-01f, 7.356984019e-01f, 7.302693725e-01f, 7.248056531e-01f, 7.193081379e-01f,
+  7.137775421e-01f, 7.082147598e-01f, 7.026206255e-01f, 6.969960332e-01f, 6.913416982e-01f, 6.856585741e-01f,
+  6.799475551e-01f, 6.742093563e-01f, 6.684449315e-01f, 6.626551151e-01f, 6.568409204e-01f, 6.510030031e-01f,
+  6.451423168e-01f, 6.392598748e-01f, 6.333563924e-01f, 6.274328232e-01f, 6.214901209e-01f, 6.155290604e-01f,
+  6.095505953e-01f, 6.035556793e-01f, 5.975451469e-01f, 5.915199518e-01f, 5.854809284e-01f, 5.794290900e-01f,
+  5.733652711e-01f, 5.672903657e-01f, 5.612053275e-01f, 5.551111102e-01f, 5.490085483e-01f, 5.428986549e-01f,
+  5.367823243e-01f, 5.306603909e-01f, 5.245338082e-01f, 5.184035897e-01f, 5.122706294e-01f, 5.061357617e-01f,
+  4.999999702e-01f, 4.938642383e-01f, 4.877294004e-01f, 4.815963805e-01f, 4.754661918e-01f, 4.693396389e-01f,
+  4.632177055e-01f, 4.571013153e-01f, 4.509914517e-01f, 4.448888898e-01f, 4.387946427e-01f, 4.327096641e-01f,
+  4.266347885e-01f, 4.205709100e-01f, 4.145190120e-01f, 4.084800780e-01f, 4.024548531e-01f, 3.964442909e-01f,
+  3.904494047e-01f, 3.844709396e-01f, 3.785099089e-01f, 3.725671470e-01f, 3.666436374e-01f, 3.607401550e-01f,
+  3.548576236e-01f, 3.489970565e-01f, 3.431591392e-01f, 3.373448253e-01f, 3.315550983e-01f, 3.257906735e-01f,
+  3.200524747e-01f, 3.143413663e-01f, 3.086583018e-01f, 3.030039668e-01f, 2.973793149e-01f, 2.917852402e-01f,
+  2.862224579e-01f, 2.806918621e-01f, 2.751943171e-01f, 2.697306275e-01f, 2.643016875e-01f, 2.589081526e-01f,
+  2.535509169e-01f, 2.482308149e-01f, 2.429486215e-01f, 2.377051413e-01f, 2.325011492e-01f, 2.273375392e-01f,
+  2.222149074e-01f, 2.171341181e-01f, 2.120959163e-01f, 2.071010470e-01f, 2.021503150e-01f, 1.972444355e-01f,
+  1.923842430e-01f, 1.875702739e-01f, 1.828033626e-01f, 1.780842245e-01f, 1.734135747e-01f, 1.687920690e-01f,
+  1.642204821e-01f, 1.596995294e-01f, 1.552297473e-01f, 1.508118808e-01f, 1.464466155e-01f, 1.421345770e-01f,
+  1.378764212e-01f, 1.336728334e-01f, 1.295244694e-01f, 1.254318357e-01f, 1.213955879e-01f, 1.174163520e-01f,
+  1.134947538e-01f, 1.096313596e-01f, 1.058267653e-01f, 1.020815670e-01f, 9.839624166e-02f, 9.477141500e-02f,
+  9.120759368e-02f, 8.770534396e-02f, 8.426517248e-02f, 8.088767529e-02f, 7.757323980e-02f, 7.432240248e-02f,
+  7.113569975e-02f, 6.801357865e-02f, 6.495648623e-02f, 6.196492910e-02f, 5.903938413e-02f, 5.618020892e-02f,
+  5.338785052e-02f, 5.066275597e-02f, 4.800534248e-02f, 4.541599751e-02f, 4.289510846e-02f, 4.044309258e-02f,
+  3.806024790e-02f, 3.574696183e-02f, 3.350359201e-02f, 3.133049607e-02f, 2.922794223e-02f, 2.719631791e-02f,
+  2.523592114e-02f, 2.334699035e-02f, 2.152982354e-02f, 1.978474855e-02f, 1.811197400e-02f, 1.651176810e-02f,
+  1.498436928e-02f, 1.353004575e-02f, 1.214894652e-02f, 1.084131002e-02f, 9.607344866e-03f, 8.447259665e-03f,
+  7.361173630e-03f, 6.349295378e-03f, 5.411744118e-03f, 4.548698664e-03f, 3.760248423e-03f, 3.046512604e-03f,
+  2.407640219e-03f, 1.843690872e-03f, 1.354753971e-03f, 9.409487247e-04f, 6.022751331e-04f, 3.388226032e-04f,
+  1.505911350e-04f, 3.764033318e-05f
+};
+
+const float32_t FFT_Hanning_1024[1024] __ALIGNED(FFT_STATIC_ALIGNMENT) =
+{
+  0.000000000e+00f, 9.417533875e-06f, 3.764033318e-05f, 8.469820023e-05f, 1.505911350e-04f, 2.352893353e-04f,
+  3.388226032e-04f, 4.611313343e-04f, 6.022751331e-04f, 7.622241974e-04f, 9.409487247e-04f, 1.138478518e-03f,
+  1.354753971e-03f, 1.589834690e-03f, 1.843690872e-03f, 2.116292715e-03f, 2.407640219e-03f, 2.717703581e-03f,
+  3.046512604e-03f, 3.394037485e-03f, 3.760248423e-03f, 4.145115614e-03f, 4.548698664e-03f, 4.970908165e-03f,
+  5.411744118e-03f, 5.871236324e-03f, 6.349295378e-03f, 6.845951080e-03f, 7.361173630e-03f, 7.894963026e-03f,
+  8.447259665e-03f, 9.018063545e-03f, 9.607344866e-03f, 1.021510363e-02f, 1.084131002e-02f, 1.148593426e-02f,
+  1.214894652e-02f, 1.283031702e-02f, 1.353004575e-02f, 1.424807310e-02f, 1.498436928e-02f, 1.573893428e-02f,
+  1.651176810e-02f, 1.730278134e-02f, 1.811197400e-02f, 1.893928647e-02f, 1.978474855e-02f, 2.064827085e-02f,
+  2.152982354e-02f, 2.242943645e-02f, 2.334699035e-02f, 2.428251505e-02f, 2.523592114e-02f, 2.620717883e-02f,
+  2.719631791e-02f, 2.820324898e-02f, 2.922794223e-02f, 3.027036786e-02f, 3.133049607e-02f, 3.240823746e-02f,
+  3.350359201e-02f, 3.461652994e-02f, 3.574696183e-02f, 3.689488769e-02f, 3.806024790e-02f, 3.924301267e-02f,
+  4.044309258e-02f, 4.166045785e-02f, 4.289510846e-02f, 4.414695501e-02f, 4.541599751e-02f, 4.670214653e-02f,
+  4.800534248e-02f, 4.932558537e-02f, 5.066275597e-02f, 5.201688409e-02f, 5.338785052e-02f, 5.477565527e-02f,
+  5.618020892e-02f, 5.760148168e-02f, 5.903938413e-02f, 6.049385667e-02f, 6.196492910e-02f, 6.345248222e-02f,
+  6.495648623e-02f, 6.647688150e-02f, 6.801357865e-02f, 6.956651807e-02f, 7.113569975e-02f, 7.272100449e-02f,
+  7.432240248e-02f, 7.593983412e-02f, 7.757323980e-02f, 7.922253013e-02f, 8.088767529e-02f, 8.256852627e-02f,
+  8.426517248e-02f, 8.597746491e-02f, 8.770534396e-02f, 8.944872022e-02f, 9.120759368e-02f, 9.298184514e-02f,
+  9.477141500e-02f, 9.657624364e-02f, 9.839624166e-02f, 1.002313793e-01f, 1.020815670e-01f, 1.039467454e-01f,
+  1.058267653e-01f, 1.077216566e-01f, 1.096313596e-01f, 1.115557551e-01f, 1.134947538e-01f, 1.154483259e-01f,
+  1.174163520e-01f, 1.193988025e-01f, 1.213955879e-01f, 1.234066188e-01f, 1.254318357e-01f, 1.274711192e-01f,
+  1.295244694e-01f, 1.315917671e-01f, 1.336728334e-01f, 1.357677877e-01f, 1.378764212e-01f, 1.399987340e-01f,
+  1.421345770e-01f, 1.442838907e-01f, 1.464466155e-01f, 1.486226320e-01f, 1.508118808e-01f, 1.530142725e-01f,
+  1.552297473e-01f, 1.574581861e-01f, 1.596995294e-01f, 1.619536877e-01f, 1.642204821e-01f, 1.665000021e-01f,
+  1.687920690e-01f, 1.710966229e-01f, 1.734135747e-01f, 1.757428050e-01f, 1.780842245e-01f, 1.804377735e-01f,
+  1.828033626e-01f, 1.851809025e-01f, 1.875702739e-01f, 1.899714172e-01f, 1.923842430e-01f, 1.948085427e-01f,
+  1.972444355e-01f, 1.996917129e-01f, 2.021503150e-01f, 2.046201229e-01f, 2.071010470e-01f, 2.095930278e-01f,
+  2.120959163e-01f, 2.146096230e-01f, 2.171341181e-01f, 2.196692228e-01f, 2.222149074e-01f, 2.247710526e-01f,
+  2.273375392e-01f, 2.299142182e-01f, 2.325011492e-01f, 2.350981534e-01f, 2.377051413e-01f, 2.403219938e-01f,
+  2.429486215e-01f, 2.455849349e-01f, 2.482308149e-01f, 2.508861721e-01f, 2.535509169e-01f, 2.562249303e-01f,
+  2.589081526e-01f, 2.616004348e-01f, 2.643016875e-01f, 2.670117021e-01f, 2.697306275e-01f, 2.724581957e-01f,
+  2.751943171e-01f, 2.779389024e-01f, 2.806918621e-01f, 2.834531069e-01f, 2.862224579e-01f, 2.889998853e-01f,
+  2.917852402e-01f, 2.945783734e-01f, 2.973793149e-01f, 3.001878858e-01f, 3.030039668e-01f, 3.058274984e-01f,
+  3.086583018e-01f, 3.114963174e-01f, 3.143413663e-01f, 3.171934783e-01f, 3.200524747e-01f, 3.229182363e-01f,
+  3.257906735e-01f, 3.286696672e-01f, 3.315550983e-01f, 3.344468176e-01f, 3.373448253e-01f, 3.402489722e-01f,
+  3.431591392e-01f, 3.460751772e-01f, 3.489970565e-01f, 3.519245982e-01f, 3.548576236e-01f, 3.577962220e-01f,
+  3.607401550e-01f, 3.636893034e-01f, 3.666436374e-01f, 3.696029782e-01f, 3.725671470e-01f, 3.755361736e-01f,
+  3.785099089e-01f, 3.814882040e-01f, 3.844709396e-01f, 3.874580562e-01f, 3.904494047e-01f, 3.934448063e-01f,
+  3.964442909e-01f, 3.994476795e-01f, 4.024548531e-01f, 4.054656625e-01f, 4.084800780e-01f, 4.114979208e-01f,
+  4.145190120e-01f, 4.175434113e-01f, 4.205709100e-01f, 4.236013889e-01f, 4.266347885e-01f, 4.296709001e-01f,
+  4.327096641e-01f, 4.357509017e-01f, 4.387946427e-01f, 4.418406785e-01f, 4.448888898e-01f, 4.479391873e-01f,
+  4.509914517e-01f, 4.540455341e-01f, 4.571013153e-01f, 4.601587653e-01f, 4.632177055e-01f, 4.662780464e-01f,
+  4.693396389e-01f, 4.724023938e-01f, 4.754661918e-01f, 4.785308540e-01f, 4.815963805e-01f, 4.846625924e-01f,
+  4.877294004e-01f, 4.907966554e-01f, 4.938642383e-01f, 4.969320893e-01f, 4.999999702e-01f, 5.030679107e-01f,
+  5.061357617e-01f, 5.092033744e-01f, 5.122706294e-01f, 5.153374076e-01f, 5.184035897e-01f, 5.214691162e-01f,
+  5.245338082e-01f, 5.275976062e-01f, 5.306603909e-01f, 5.337219834e-01f, 5.367823243e-01f, 5.398411751e-01f,
+  5.428986549e-01f, 5.459544659e-01f, 5.490085483e-01f, 5.520608425e-01f, 5.551111102e-01f, 5.581593513e-01f,
+  5.612053275e-01f, 5.642490387e-01f, 5.672903657e-01f, 5.703291297e-01f, 5.733652711e-01f, 5.763986111e-01f,
+  5.794290900e-01f, 5.824565291e-01f, 5.854809284e-01f, 5.885021091e-01f, 5.915199518e-01f, 5.945343375e-01f,
+  5.975451469e-01f, 6.005523205e-01f, 6.035556793e-01f, 6.065551639e-01f, 6.095505953e-01f, 6.125419736e-01f,
+  6.155290604e-01f, 6.185117960e-01f, 6.214901209e-01f, 6.244637966e-01f, 6.274328232e-01f, 6.303970814e-01f,
+  6.333563924e-01f, 6.363106966e-01f, 6.392598748e-01f, 6.422038078e-01f, 6.451423168e-01f, 6.480754614e-01f,
+  6.510030031e-01f, 6.539248228e-01f, 6.568409204e-01f, 6.597510576e-01f, 6.626551151e-01f, 6.655531526e-01f,
+  6.684449315e-01f, 6.713303328e-01f, 6.742093563e-01f, 6.770817637e-01f, 6.799475551e-01f, 6.828064919e-01f,
+  6.856585741e-01f, 6.885036826e-01f, 6.913416982e-01f, 6.941725016e-01f, 6.969960332e-01f, 6.998121142e-01f,
+  7.026206255e-01f, 7.054215670e-01f, 7.082147598e-01f, 7.110001445e-01f, 7.137775421e-01f, 7.165468931e-01f,
+  7.193081379e-01f, 7.220610380e-01f, 7.248056531e-01f, 7.275418043e-01f, 7.302693725e-01f, 7.329882383e-01f,
+  7.356984019e-01f, 7.383996248e-01f, 7.410918474e-01f, 7.437750697e-01f, 7.464491129e-01f, 7.491137981e-01f,
+  7.517691851e-01f, 7.544150949e-01f, 7.570514083e-01f, 7.596780062e-01f, 7.622948289e-01f, 7.649018168e-01f,
+  7.674988508e-01f, 7.700857520e-01f, 7.726625204e-01f, 7.752289772e-01f, 7.777851224e-01f, 7.803307772e-01f,
+  7.828658819e-01f, 7.853903770e-01f, 7.879041433e-01f, 7.904069424e-01f, 7.928988934e-01f, 7.953798771e-01f,
+  7.978496552e-01f, 8.003082275e-01f, 8.027555346e-01f, 8.051913977e-01f, 8.076157570e-01f, 8.100286126e-01f,
+  8.124297857e-01f, 8.148190975e-01f, 8.171966076e-01f, 8.195621967e-01f, 8.219157457e-01f, 8.242571950e-01f,
+  8.265864253e-01f, 8.289033175e-01f, 8.312078714e-01f, 8.334999681e-01f, 8.357794881e-01f, 8.380463123e-01f,
+  8.403005004e-01f, 8.425418139e-01f, 8.447703123e-01f, 8.469856977e-01f, 8.491880894e-01f, 8.513773680e-01f,
+  8.535534143e-01f, 8.557161093e-01f, 8.578654528e-01f, 8.600012064e-01f, 8.621235490e-01f, 8.642321825e-01f,
+  8.663271666e-01f, 8.684083223e-01f, 8.704755306e-01f, 8.725289106e-01f, 8.745682240e-01f, 8.765934110e-01f,
+  8.786044121e-01f, 8.806011677e-01f, 8.825836182e-01f, 8.845516443e-01f, 8.865052462e-01f, 8.884441853e-01f,
+  8.903685808e-01f, 8.922783136e-01f, 8.941732645e-01f, 8.960533142e-01f, 8.979184628e-01f, 8.997686505e-01f,
+  9.016037583e-01f, 9.034237862e-01f, 9.052286148e-01f, 9.070181847e-01f, 9.087923765e-01f, 9.105512500e-01f,
+  9.122946262e-01f, 9.140225053e-01f, 9.157347679e-01f, 9.174314737e-01f, 9.191123247e-01f, 9.207774997e-01f,
+  9.224268198e-01f, 9.240601659e-01f, 9.256775975e-01f, 9.272789955e-01f, 9.288643003e-01f, 9.304334521e-01f,
+  9.319864511e-01f, 9.335231185e-01f, 9.350435138e-01f, 9.365475178e-01f, 9.380350113e-01f, 9.395061135e-01f,
+  9.409606457e-01f, 9.423985481e-01f, 9.438198209e-01f, 9.452244043e-01f, 9.466121197e-01f, 9.479831457e-01f,
+  9.493372440e-01f, 9.506744146e-01f, 9.519946575e-01f, 9.532978535e-01f, 9.545840025e-01f, 9.558529854e-01f,
+  9.571049213e-01f, 9.583395720e-01f, 9.595569372e-01f, 9.607570171e-01f, 9.619397521e-01f, 9.631050825e-01f,
+  9.642530680e-01f, 9.653834701e-01f, 9.664964080e-01f, 9.675917625e-01f, 9.686695337e-01f, 9.697296023e-01f,
+  9.707720280e-01f, 9.717967510e-01f, 9.728036523e-01f, 9.737927914e-01f, 9.747641087e-01f, 9.757175446e-01f,
+  9.766529799e-01f, 9.775705934e-01f, 9.784702063e-01f, 9.793517590e-01f, 9.802152514e-01f, 9.810607433e-01f,
+  9.818880558e-01f, 9.826972485e-01f, 9.834882021e-01f, 9.842610359e-01f, 9.850156307e-01f, 9.857519865e-01f,
+  9.864699841e-01f, 9.871696830e-01f, 9.878510237e-01f, 9.885140657e-01f, 9.891586900e-01f, 9.897848964e-01f,
+  9.903926253e-01f, 9.909819365e-01f, 9.915527105e-01f, 9.921050072e-01f, 9.926388264e-01f, 9.931540489e-01f,
+  9.936506748e-01f, 9.941288233e-01f, 9.945882559e-01f, 9.950290918e-01f, 9.954513311e-01f, 9.958548546e-01f,
+  9.962397814e-01f, 9.966059923e-01f, 9.969534874e-01f, 9.972822666e-01f, 9.975923300e-01f, 9.978836775e-01f,
+  9.981563091e-01f, 9.984101057e-01f, 9.986451864e-01f, 9.988615513e-01f, 9.990590811e-01f, 9.992377758e-01f,
+  9.993977547e-01f, 9.995388985e-01f, 9.996612072e-01f, 9.997646809e-01f, 9.998494387e-01f, 9.999153018e-01f,
+  9.999623299e-01f, 9.999905825e-01f, 1.000000000e+00f, 9.999905825e-01f, 9.999623299e-01f, 9.999153018e-01f,
+  9.998494387e-01f, 9.997646809e-01f, 9.996612072e-01f, 9.995388985e-01f, 9.993977547e-01f, 9.992377758e-01f,
+  9.990590811e-01f, 9.988615513e-01f, 9.986451864e-01f, 9.984101057e-01f, 9.981563091e-01f, 9.978836775e-01f,
+  9.975923300e-01f, 9.972822666e-01f, 9.969534874e-01f, 9.966059923e-01f, 9.962397814e-01f, 9.958548546e-01f,
+  9.954513311e-01f, 9.950290918e-01f, 9.945882559e-01f, 9.941288233e-01f, 9.936506748e-01f, 9.931540489e-01f,
+  9.926388264e-01f, 9.921050072e-01f, 9.915527105e-01f, 9.909819365e-01f, 9.903926253e-01f, 9.897848964e-01f,
+  9.891586900e-01f, 9.885140657e-01f, 9.878510237e-01f, 9.871696830e-01f, 9.864699841e-01f, 9.857519865e-01f,
+  9.850156307e-01f, 9.842610359e-01f, 9.834882021e-01f, 9.826972485e-01f, 9.818880558e-01f, 9.810607433e-01f,
+  9.802152514e-01f, 9.793517590e-01f, 9.784702063e-01f, 9.775705934e-01f, 9.766529799e-01f, 9.757175446e-01f,
+  9.747641087e-01f, 9.737927914e-01f, 9.728036523e-01f, 9.717967510e-01f, 9.707720280e-01f, 9.697296023e-01f,
+  9.686695337e-01f, 9.675917625e-01f, 9.664964080e-01f, 9.653834701e-01f, 9.642530680e-01f, 9.631050825e-01f,
+  9.619397521e-01f, 9.607570171e-01f, 9.595569372e-01f, 9.583395720e-01f, 9.571049213e-01f, 9.558529854e-01f,
+  9.545840025e-01f, 9.532978535e-01f, 9.519946575e-01f, 9.506744146e-01f, 9.493372440e-01f, 9.479831457e-01f,
+  9.466121197e-01f, 9.452244043e-01f, 9.438198209e-01f, 9.423985481e-01f, 9.409606457e-01f, 9.395061135e-01f,
+  9.380350113e-01f, 9.365475178e-01f, 9.350435138e-01f, 9.335231185e-01f, 9.319864511e-01f, 9.304334521e-01f,
+  9.288643003e-01f, 9.272789955e-01f, 9.256775975e-01f, 9.240601659e-01f, 9.224268198e-01f, 9.207774997e-01f,
+  9.191123247e-01f, 9.174314737e-01f, 9.157347679e-01f, 9.140225053e-01f, 9.122946262e-01f, 9.105512500e-01f,
+  9.087923765e-01f, 9.070181847e-01f, 9.052286148e-01f, 9.034237862e-01f, 9.016037583e-01f, 8.997686505e-01f,
+  8.979184628e-01f, 8.960533142e-01f, 8.941732645e-01f, 8.922783136e-01f, 8.903685808e-01f, 8.884441853e-01f,
+  8.865052462e-01f, 8.845516443e-01f, 8.825836182e-01f, 8.806011677e-01f, 8.786044121e-01f, 8.765934110e-01f,
+  8.745682240e-01f, 8.725289106e-01f, 8.704755306e-01f, 8.684083223e-01f, 8.663271666e-01f, 8.642321825e-01f,
+  8.621235490e-01f, 8.600012064e-01f, 8.578654528e-01f, 8.557161093e-01f, 8.535534143e-01f, 8.513773680e-01f,
+  8.491880894e-01f, 8.469856977e-01f, 8.447703123e-01f, 8.425418139e-01f, 8.403005004e-01f, 8.380463123e-01f,
+  8.357794881e-01f, 8.334999681e-01f, 8.312078714e-01f, 8.289033175e-01f, 8.265864253e-01f, 8.242571950e-01f,
+  8.219157457e-01f, 8.195621967e-01f, 8.171966076e-01f, 8.148190975e-01f, 8.124297857e-01f, 8.100286126e-01f,
+  8.076157570e-01f, 8.051913977e-01f, 8.027555346e-01f, 8.003082275e-01f, 7.978496552e-01f, 7.953798771e-01f,
+  7.928988934e-01f, 7.904069424e-01f, 7.879041433e-01f, 7.853903770e-01f, 7.828658819e-01f, 7.803307772e-01f,
+  7.777851224e-01f, 7.752289772e-01f, 7.726625204e-01f, 7.700857520e-01f, 7.674988508e-01f, 7.649018168e-01f,
+  7.622948289e-01f, 7.596780062e-01f, 7.570514083e-01f, 7.544150949e-01f, 7.517691851e-01f, 7.491137981e-01f,
+  7.464491129e-01f, 7.437750697e-01f, 7.410918474e-01f, 7.383996248e-01f, 7.356984019e-01f, 7.329882383e-01f,
+  7.302693725e-01f, 7.275418043e-01f, 7.248056531e-01f, 7.220610380e-01f, 7.193081379e-01f, 7.165468931e-01f,
+  7.137775421e-01f, 7.110001445e-01f, 7.082147598e-01f, 7.054215670e-01f, 7.026206255e-01f, 6.998121142e-01f,
+  6.969960332e-01f, 6.941725016e-01f, 6.913416982e-01f, 6.885036826e-01f, 6.856585741e-01f, 6.828064919e-01f,
+  6.799475551e-01f, 6.770817637e-01f, 6.742093563e-01f, 6.713303328e-01f, 6.684449315e-01f, 6.655531526e-01f,
+  6.626551151e-01f, 6.597510576e-01f, 6.568409204e-01f, 6.539248228e-01f, 6.510030031e-01f, 6.480754614e-01f,
+  6.451423168e-01f, 6.422038078e-01f, 6.392598748e-01f, 6.363106966e-01f, 6.333563924e-01f, 6.303970814e-01f,
+  6.274328232e-01f, 6.244637966e-01f, 6.214901209e-01f, 6.185117960e-01f, 6.155290604e-01f, 6.125419736e-01f,
+  6.095505953e-01f, 6.065551639e-01f, 6.035556793e-01f, 6.005523205e-01f, 5.975451469e-01f, 5.945343375e-01f,
+  5.915199518e-01f, 5.885021091e-01f, 5.854809284e-01f, 5.824565291e-01f, 5.794290900e-01f, 5.763986111e-01f,
+  5.733652711e-01f, 5.703291297e-01f, 5.672903657e-01f, 5.642490387e-01f, 5.612053275e-01f, 5.581593513e-01f,
+  5.551111102e-01f, 5.520608425e-01f, 5.490085483e-01f, 5.459544659e-01f, 5.428986549e-01f, 5.398411751e-01f,
+  5.367823243e-01f, 5.337219834e-01f, 5.306603909e-01f, 5.275976062e-01f, 5.245338082e-01f, 5.214691162e-01f,
+  5.184035897e-01f, 5.153374076e-01f, 5.122706294e-01f, 5.092033744e-01f, 5.061357617e-01f, 5.030679107e-01f,
+  4.999999702e-01f, 4.969320893e-01f, 4.938642383e-01f, 4.907966554e-01f, 4.877294004e-01f, 4.846625924e-01f,
+  4.815963805e-01f, 4.785308540e-01f, 4.754661918e-01f, 4.724023938e-01f, 4.693396389e-01f, 4.662780464e-01f,
+  4.632177055e-01f, 4.601587653e-01f, 4.571013153e-01f, 4.540455341e-01f, 4.509914517e-01f, 4.479391873e-01f,
+  4.448888898e-01f, 4.418406785e-01f, 4.387946427e-01f, 4.357509017e-01f, 4.327096641e-01f, 4.296709001e-01f,
+  4.266347885e-01f, 4.236013889e-01f, 4.205709100e-01f, 4.175434113e-01f, 4.145190120e-01f, 4.114979208e-01f,
+  4.084800780e-01f, 4.054656625e-01f, 4.024548531e-01f, 3.994476795e-01f, 3.964442909e-01f, 3.934448063e-01f,
+  3.904494047e-01f, 3.874580562e-01f, 3.844709396e-01f, 3.814882040e-01f, 3.785099089e-01f, 3.755361736e-01f,
+  3.725671470e-01f, 3.696029782e-01f, 3.666436374e-01f, 3.636893034e-01f, 3.607401550e-01f, 3.577962220e-01f,
+  3.548576236e-01f, 3.519245982e-01f, 3.489970565e-01f, 3.460751772e-01f, 3.431591392e-01f, 3.402489722e-01f,
+  3.373448253e-01f, 3.344468176e-01f, 3.315550983e-01f, 3.286696672e-01f, 3.257906735e-01f, 3.229182363e-01f,
+  3.200524747e-01f, 3.171934783e-01f, 3.143413663e-01f, 3.114963174e-01f, 3.086583018e-01f, 3.058274984e-01f,
+  3.030039668e-01f, 3.001878858e-01f, 2.973793149e-01f, 2.945783734e-01f, 2.917852402e-01f, 2.889998853e-01f,
+  2.862224579e-01f, 2.834531069e-01f, 2.806918621e-01f, 2.779389024e-01f, 2.751943171e-01f, 2.724581957e-01f,
+  2.697306275e-01f, 2.670117021e-01f, 2.643016875e-01f, 2.616004348e-01f, 2.589081526e-01f, 2.562249303e-01f,
+  2.535509169e-01f, 2.508861721e-01f, 2.482308149e-01f, 2.455849349e-01f, 2.429486215e-01f, 2.403219938e-01f,
+  2.377051413e-01f, 2.350981534e-01f, 2.325011492e-01f, 2.299142182e-01f, 2.273375392e-01f, 2.247710526e-01f,
+  2.222149074e-01f, 2.196692228e-01f, 2.171341181e-01f, 2.146096230e-01f, 2.120959163e-01f, 2.095930278e-01f,
+  2.071010470e-01f, 2.046201229e-01f, 2.021503150e-01f, 1.996917129e-01f, 1.972444355e-01f, 1.948085427e-01f,
+  1.923842430e-01f, 1.899714172e-01f, 1.875702739e-01f, 1.851809025e-01f, 1.828033626e-01f, 1.804377735e-01f,
+  1.780842245e-01f, 1.757428050e-01f, 1.734135747e-01f, 1.710966229e-01f, 1.687920690e-01f, 1.665000021e-01f,
+  1.642204821e-01f, 1.619536877e-01f, 1.596995294e-01f, 1.574581861e-01f, 1.552297473e-01f, 1.530142725e-01f,
+  1.508118808e-01f, 1.486226320e-01f, 1.464466155e-01f, 1.442838907e-01f, 1.421345770e-01f, 1.399987340e-01f,
+  1.378764212e-01f, 1.357677877e-01f, 1.336728334e-01f, 1.315917671e-01f, 1.295244694e-01f, 1.274711192e-01f,
+  1.254318357e-01f, 1.234066188e-01f, 1.213955879e-01f, 1.193988025e-01f, 1.174163520e-01f, 1.154483259e-01f,
+  1.134947538e-01f, 1.115557551e-01f, 1.096313596e-01f, 1.077216566e-01f, 1.058267653e-01f, 1.039467454e-01f,
+  1.020815670e-01f, 1.002313793e-01f, 9.839624166e-02f, 9.657624364e-02f, 9.477141500e-02f, 9.298184514e-02f,
+  9.120759368e-02f, 8.944872022e-02f, 8.770534396e-02f, 8.597746491e-02f, 8.426517248e-02f, 8.256852627e-02f,
+  8.088767529e-02f, 7.922253013e-02f, 7.757323980e-02f, 7.593983412e-02f, 7.432240248e-02f, 7.272100449e-02f,
+  7.113569975e-02f, 6.956651807e-02f, 6.801357865e-02f, 6.647688150e-02f, 6.495648623e-02f, 6.345248222e-02f,
+  6.196492910e-02f, 6.049385667e-02f, 5.903938413e-02f, 5.760148168e-02f, 5.618020892e-02f, 5.477565527e-02f,
+  5.338785052e-02f, 5.201688409e-02f, 5.066275597e-02f, 4.932558537e-02f, 4.800534248e-02f, 4.670214653e-02f,
+  4.541599751e-02f, 4.414695501e-02f, 4.289510846e-02f, 4.166045785e-02f, 4.044309258e-02f, 3.924301267e-02f,
+  3.806024790e-02f, 3.689488769e-02f, 3.574696183e-02f, 3.461652994e-02f, 3.350359201e-02f, 3.240823746e-02f,
+  3.133049607e-02f, 3.027036786e-02f, 2.922794223e-02f, 2.820324898e-02f, 2.719631791e-02f, 2.620717883e-02f,
+  2.523592114e-02f, 2.428251505e-02f, 2.334699035e-02f, 2.242943645e-02f, 2.152982354e-02f, 2.064827085e-02f,
+  1.978474855e-02f, 1.893928647e-02f, 1.811197400e-02f, 1.730278134e-02f, 1.651176810e-02f, 1.573893428e-02f,
+  1.498436928e-02f, 1.424807310e-02f, 1.353004575e-02f, 1.283031702e-02f, 1.214894652e-02f, 1.148593426e-02f,
+  1.084131002e-02f, 1.021510363e-02f, 9.607344866e-03f, 9.018063545e-03f, 8.447259665e-03f, 7.894963026e-03f,
+  7.361173630e-03f, 6.845951080e-03f, 6.349295378e-03f, 5.871236324e-03f, 5.411744118e-03f, 4.970908165e-03f,
+  4.548698664e-03f, 4.145115614e-03f, 3.760248423e-03f, 3.394037485e-03f, 3.046512604e-03f, 2.717703581e-03f,
+  2.407640219e-03f, 2.116292715e-03f, 1.843690872e-03f, 1.589834690e-03f, 1.354753971e-03f, 1.138478518e-03f,
+  9.409487247e-04f, 7.622241974e-04f, 6.022751331e-04f, 4.611313343e-04f, 3.388226032e-04f, 2.352893353e-04f,
+  1.505911350e-04f, 8.469820023e-05f, 3.764033318e-05f, 9.417533875e-06f
+};
+
+const float32_t FFT_Hamming_256[256] __ALIGNED(FFT_STATIC_ALIGNMENT) =
+{
+  7.671999931e-02f, 7.685902715e-02f, 7.727608085e-02f, 7.797083259e-02f, 7.894292474e-02f, 8.019173145e-02f,
+  8.171656728e-02f, 8.351641893e-02f, 8.559030294e-02f, 8.793687820e-02f, 9.055477381e-02f, 9.344241023e-02f,
+  9.659805894e-02f, 1.000198126e-01f, 1.037056148e-01f, 1.076532006e-01f, 1.118602753e-01f, 1.163241863e-01f,
+  1.210423708e-01f, 1.260119379e-01f, 1.312298477e-01f, 1.366930306e-01f, 1.423981786e-01f, 1.483418047e-01f,
+  1.545203626e-01f, 1.609301567e-01f, 1.675672829e-01f, 1.744277477e-01f, 1.815074384e-01f, 1.888021231e-01f,
+  1.963073313e-01f, 2.040185630e-01f, 2.119312286e-01f, 2.200405002e-01f, 2.283415198e-01f, 2.368292809e-01f,
+  2.454986870e-01f, 2.543444932e-01f, 2.633613646e-01f, 2.725438774e-01f, 2.818865478e-01f, 2.913836837e-01f,
+  3.010295630e-01f, 3.108184934e-01f, 3.207443953e-01f, 3.308014274e-01f, 3.409834504e-01f, 3.512844145e-01f,
+  3.616980314e-01f, 3.722180128e-01f, 3.828381896e-01f, 3.935519457e-01f, 4.043530226e-01f, 4.152347147e-01f,
+  4.261906147e-01f, 4.372141063e-01f, 4.482984841e-01f, 4.594371617e-01f, 4.706233144e-01f, 4.818503559e-01f,
+  4.931113720e-01f, 5.043996572e-01f, 5.157083869e-01f, 5.270307660e-01f, 5.383599997e-01f, 5.496892333e-01f,
+  5.610115528e-01f, 5.723203421e-01f, 5.836086273e-01f, 5.948696733e-01f, 6.060966253e-01f, 6.172828674e-01f,
+  6.284214854e-01f, 6.395058632e-01f, 6.505293846e-01f, 6.614852548e-01f, 6.723670363e-01f, 6.831680536e-01f,
+  6.938818097e-01f, 7.045019865e-01f, 7.150219679e-01f, 7.254356146e-01f, 7.357365489e-01f, 7.459185719e-01f,
+  7.559755445e-01f, 7.659015059e-01f, 7.756903768e-01f, 7.853363752e-01f, 7.948334217e-01f, 8.041760921e-01f,
+  8.133586645e-01f, 8.223754764e-01f, 8.312213421e-01f, 8.398907185e-01f, 8.483785391e-01f, 8.566794395e-01f,
+  8.647887707e-01f, 8.727014661e-01f, 8.804126382e-01f, 8.879178762e-01f, 8.952125311e-01f, 9.022922516e-01f,
+  9.091527462e-01f, 9.157898426e-01f, 9.221996069e-01f, 9.283781648e-01f, 9.343218207e-01f, 9.400269985e-01f,
+  9.454901218e-01f, 9.507080317e-01f, 9.556776285e-01f, 9.603958130e-01f, 9.648597240e-01f, 9.690667987e-01f,
+  9.730144143e-01f, 9.767001867e-01f, 9.801219702e-01f, 9.832775593e-01f, 9.861652255e-01f, 9.887831211e-01f,
+  9.911297560e-01f, 9.932035804e-01f, 9.950034618e-01f, 9.965282679e-01f, 9.977771044e-01f, 9.987491965e-01f,
+  9.994438887e-01f, 9.998610020e-01f, 1.000000000e+00f, 9.998610020e-01f, 9.994438887e-01f, 9.987491369e-01f,
+  9.977771044e-01f, 9.965282679e-01f, 9.950034618e-01f, 9.932035804e-01f, 9.911297560e-01f, 9.887831211e-01f,
+  9.861652255e-01f, 9.832776189e-01f, 9.801219702e-01f, 9.767001867e-01f, 9.730143547e-01f, 9.690667987e-01f,
+  9.648597240e-01f, 9.603958130e-01f, 9.556776285e-01f, 9.507080317e-01f, 9.454901218e-01f, 9.400268793e-01f,
+  9.343218803e-01f, 9.283782244e-01f, 9.221996069e-01f, 9.157898426e-01f, 9.091527462e-01f, 9.022922516e-01f,
+  8.952125907e-01f, 8.879178762e-01f, 8.804126978e-01f, 8.727014065e-01f, 8.647887707e-01f, 8.566794991e-01f,
+  8.483784199e-01f, 8.398907185e-01f, 8.312213421e-01f, 8.223755360e-01f, 8.133585453e-01f, 8.041760325e-01f,
+  7.948335409e-01f, 7.853363752e-01f, 7.756904364e-01f, 7.659015059e-01f, 7.559755445e-01f, 7.459185123e-01f,
+  7.357364893e-01f, 7.254356742e-01f, 7.150220275e-01f, 7.045019865e-01f, 6.938818693e-01f, 6.831679940e-01f,
+  6.723669767e-01f, 6.614851952e-01f, 6.505294442e-01f, 6.395059824e-01f, 6.284215450e-01f, 6.172828674e-01f,
+  6.060966253e-01f, 5.948696136e-01f, 5.836085081e-01f, 5.723204613e-01f, 5.610116720e-01f, 5.496892333e-01f,
+  5.383599997e-01f, 5.270307660e-01f, 5.157083273e-01f, 5.043995380e-01f, 4.931114614e-01f, 4.818503857e-01f,
+  4.706233740e-01f, 4.594371319e-01f, 4.482984543e-01f, 4.372140169e-01f, 4.261905253e-01f, 4.152348042e-01f,
+  4.043530226e-01f, 3.935520053e-01f, 3.828381300e-01f, 3.722180128e-01f, 3.616979420e-01f, 3.512845039e-01f,
+  3.409835398e-01f, 3.308014572e-01f, 3.207444251e-01f, 3.108184636e-01f, 3.010295630e-01f, 2.913836241e-01f,
+  2.818866372e-01f, 2.725439668e-01f, 2.633613944e-01f, 2.543444932e-01f, 2.454986572e-01f, 2.368292511e-01f,
+  2.283414602e-01f, 2.200405896e-01f, 2.119312882e-01f, 2.040185928e-01f, 1.963073313e-01f, 1.888020933e-01f,
+  1.815074086e-01f, 1.744277179e-01f, 1.675673425e-01f, 1.609301865e-01f, 1.545203626e-01f, 1.483418047e-01f,
+  1.423981488e-01f, 1.366930008e-01f, 1.312298179e-01f, 1.260119677e-01f, 1.210424006e-01f, 1.163242161e-01f,
+  1.118602455e-01f, 1.076532006e-01f, 1.037055850e-01f, 1.000197530e-01f, 9.659808874e-02f, 9.344241023e-02f,
+  9.055477381e-02f, 8.793687820e-02f, 8.559027314e-02f, 8.351641893e-02f, 8.171653748e-02f, 8.019176126e-02f,
+  7.894292474e-02f, 7.797083259e-02f, 7.727608085e-02f, 7.685902715e-02f
+};
+
+const float32_t FFT_Hamming_512[512] __ALIGNED(FFT_STATIC_ALIGNMENT) =
+{
+  7.671999931e-02f, 7.675474882e-02f, 7.685902715e-02f, 7.703283429e-02f, 7.727608085e-02f, 7.758876681e-02f,
+  7.797083259e-02f, 7.842224836e-02f, 7.894292474e-02f, 7.953277230e-02f, 8.019173145e-02f, 8.091968298e-02f,
+  8.171656728e-02f, 8.258217573e-02f, 8.351641893e-02f, 8.451917768e-02f, 8.559030294e-02f, 8.672955632e-02f,
+  8.793687820e-02f, 8.921200037e-02f, 9.055477381e-02f, 9.196498990e-02f, 9.344241023e-02f, 9.498685598e-02f,
+  9.659805894e-02f, 9.827581048e-02f, 1.000198126e-01f, 1.018298566e-01f, 1.037056148e-01f, 1.056468189e-01f,
+  1.076532006e-01f, 1.097244620e-01f, 1.118602753e-01f, 1.140602827e-01f, 1.163241863e-01f, 1.186516881e-01f,
+  1.210423708e-01f, 1.234959066e-01f, 1.260119379e-01f, 1.285900474e-01f, 1.312298477e-01f, 1.339310110e-01f,
+  1.366930306e-01f, 1.395155787e-01f, 1.423981786e-01f, 1.453403831e-01f, 1.483418047e-01f, 1.514019370e-01f,
+  1.545203626e-01f, 1.576965749e-01f, 1.609301567e-01f, 1.642205119e-01f, 1.675672829e-01f, 1.709698439e-01f,
+  1.744277477e-01f, 1.779404581e-01f, 1.815074384e-01f, 1.851281822e-01f, 1.888021231e-01f, 1.925286651e-01f,
+  1.963073313e-01f, 2.001374662e-01f, 2.040185630e-01f, 2.079500258e-01f, 2.119312286e-01f, 2.159616053e-01f,
+  2.200405002e-01f, 2.241673470e-01f, 2.283415198e-01f, 2.325623930e-01f, 2.368292809e-01f, 2.411415875e-01f,
+  2.454986870e-01f, 2.498998642e-01f, 2.543444932e-01f, 2.588318586e-01f, 2.633613646e-01f, 2.679322958e-01f,
+  2.725438774e-01f, 2.771955729e-01f, 2.818865478e-01f, 2.866161764e-01f, 2.913836837e-01f, 2.961884141e-01f,
+  3.010295630e-01f, 3.059065342e-01f, 3.108184934e-01f, 3.157647252e-01f, 3.207443953e-01f, 3.257569075e-01f,
+  3.308014274e-01f, 3.358771801e-01f, 3.409834504e-01f, 3.461194634e-01f, 3.512844145e-01f, 3.564774990e-01f,
+  3.616980314e-01f, 3.669451475e-01f, 3.722180128e-01f, 3.775160015e-01f, 3.828381896e-01f, 3.881837726e-01f,
+  3.935519457e-01f, 3.989419937e-01f, 4.043530226e-01f, 4.097841382e-01f, 4.152347147e-01f, 4.207038283e-01f,
+  4.261906147e-01f, 4.316943288e-01f, 4.372141063e-01f, 4.427491426e-01f, 4.482984841e-01f, 4.538614750e-01f,
+  4.594371617e-01f, 4.650247097e-01f, 4.706233144e-01f, 4.762321711e-01f, 4.818503559e-01f, 4.874770045e-01f,
+  4.931113720e-01f, 4.987525344e-01f, 5.043996572e-01f, 5.100519061e-01f, 5.157083869e-01f, 5.213683248e-01f,
+  5.270307660e-01f, 5.326949954e-01f, 5.383599997e-01f, 5.440250039e-01f, 5.496892333e-01f, 5.553516746e-01f,
+  5.610115528e-01f, 5.666680932e-01f, 5.723203421e-01f, 5.779675245e-01f, 5.836086273e-01f, 5.892429948e-01f,
+  5.948696733e-01f, 6.004878283e-01f, 6.060966253e-01f, 6.116952896e-01f, 6.172828674e-01f, 6.228585243e-01f,
+  6.284214854e-01f, 6.339709163e-01f, 6.395058632e-01f, 6.450256705e-01f, 6.505293846e-01f, 6.560162306e-01f,
+  6.614852548e-01f, 6.669358015e-01f, 6.723670363e-01f, 6.777780056e-01f, 6.831680536e-01f, 6.885362864e-01f,
+  6.938818097e-01f, 6.992039680e-01f, 7.045019865e-01f, 7.097749114e-01f, 7.150219679e-01f, 7.202425003e-01f,
+  7.254356146e-01f, 7.306005359e-01f, 7.357365489e-01f, 7.408428192e-01f, 7.459185719e-01f, 7.509630919e-01f,
+  7.559755445e-01f, 7.609552741e-01f, 7.659015059e-01f, 7.708134651e-01f, 7.756903768e-01f, 7.805315852e-01f,
+  7.853363752e-01f, 7.901037931e-01f, 7.948334217e-01f, 7.995244265e-01f, 8.041760921e-01f, 8.087877035e-01f,
+  8.133586645e-01f, 8.178881407e-01f, 8.223754764e-01f, 8.268201351e-01f, 8.312213421e-01f, 8.355784416e-01f,
+  8.398907185e-01f, 8.441576958e-01f, 8.483785391e-01f, 8.525526524e-01f, 8.566794395e-01f, 8.607584238e-01f,
+  8.647887707e-01f, 8.687700033e-01f, 8.727014661e-01f, 8.765825033e-01f, 8.804126382e-01f, 8.841912746e-01f,
+  8.879178762e-01f, 8.915917873e-01f, 8.952125311e-01f, 8.987795711e-01f, 9.022922516e-01f, 9.057501554e-01f,
+  9.091527462e-01f, 9.124994278e-01f, 9.157898426e-01f, 9.190233946e-01f, 9.221996069e-01f, 9.253180027e-01f,
+  9.283781648e-01f, 9.313796163e-01f, 9.343218207e-01f, 9.372044206e-01f, 9.400269985e-01f, 9.427890182e-01f,
+  9.454901218e-01f, 9.481298923e-01f, 9.507080317e-01f, 9.532240629e-01f, 9.556776285e-01f, 9.580683112e-01f,
+  9.603958130e-01f, 9.626597166e-01f, 9.648597240e-01f, 9.669955373e-01f, 9.690667987e-01f, 9.710731506e-01f,
+  9.730144143e-01f, 9.748901725e-01f, 9.767001867e-01f, 9.784442186e-01f, 9.801219702e-01f, 9.817331433e-01f,
+  9.832775593e-01f, 9.847550392e-01f, 9.861652255e-01f, 9.875079393e-01f, 9.887831211e-01f, 9.899904728e-01f,
+  9.911297560e-01f, 9.922008514e-01f, 9.932035804e-01f, 9.941378236e-01f, 9.950034618e-01f, 9.958002567e-01f,
+  9.965282679e-01f, 9.971872568e-01f, 9.977771044e-01f, 9.982977509e-01f, 9.987491965e-01f, 9.991312027e-01f,
+  9.994438887e-01f, 9.996871948e-01f, 9.998610020e-01f, 9.999652505e-01f, 1.000000000e+00f, 9.999652505e-01f,
+  9.998610020e-01f, 9.996871948e-01f, 9.994438887e-01f, 9.991312027e-01f, 9.987491369e-01f, 9.982977509e-01f,
+  9.977771044e-01f, 9.971872568e-01f, 9.965282679e-01f, 9.958003163e-01f, 9.950034618e-01f, 9.941378236e-01f,
+  9.932035804e-01f, 9.922008514e-01f, 9.911297560e-01f, 9.899904728e-01f, 9.887831211e-01f, 9.875079989e-01f,
+  9.861652255e-01f, 9.847550392e-01f, 9.832776189e-01f, 9.817332029e-01f, 9.801219702e-01f, 9.784442186e-01f,
+  9.767001867e-01f, 9.748901129e-01f, 9.730143547e-01f, 9.710732102e-01f, 9.690667987e-01f, 9.669955373e-01f,
+  9.648597240e-01f, 9.626597166e-01f, 9.603958130e-01f, 9.580682516e-01f, 9.556776285e-01f, 9.532240629e-01f,
+  9.507080317e-01f, 9.481299520e-01f, 9.454901218e-01f, 9.427889585e-01f, 9.400268793e-01f, 9.372044802e-01f,
+  9.343218803e-01f, 9.313796163e-01f, 9.283782244e-01f, 9.253180027e-01f, 9.221996069e-01f, 9.190233946e-01f,
+  9.157898426e-01f, 9.124994874e-01f, 9.091527462e-01f, 9.057501554e-01f, 9.022922516e-01f, 8.987795115e-01f,
+  8.952125907e-01f, 8.915917873e-01f, 8.879178762e-01f, 8.841913342e-01f, 8.804126978e-01f, 8.765825033e-01f,
+  8.727014065e-01f, 8.687700033e-01f, 8.647887707e-01f, 8.607584238e-01f, 8.566794991e-01f, 8.525526524e-01f,
+  8.483784199e-01f, 8.441575766e-01f, 8.398907185e-01f, 8.355784416e-01f, 8.312213421e-01f, 8.268201351e-01f,
+  8.223755360e-01f, 8.178881407e-01f, 8.133585453e-01f, 8.087877035e-01f, 8.041760325e-01f, 7.995243669e-01f,
+  7.948335409e-01f, 7.901039124e-01f, 7.853363752e-01f, 7.805316448e-01f, 7.756904364e-01f, 7.708134651e-01f,
+  7.659015059e-01f, 7.609553337e-01f, 7.559755445e-01f, 7.509630322e-01f, 7.459185123e-01f, 7.408427000e-01f,
+  7.357364893e-01f, 7.306004763e-01f, 7.254356742e-01f, 7.202425599e-01f, 7.150220275e-01f, 7.097749114e-01f,
+  7.045019865e-01f, 6.992040277e-01f, 6.938818693e-01f, 6.885362267e-01f, 6.831679940e-01f, 6.777780056e-01f,
+  6.723669767e-01f, 6.669357419e-01f, 6.614851952e-01f, 6.560161114e-01f, 6.505294442e-01f, 6.450257301e-01f,
+  6.395059824e-01f, 6.339709759e-01f, 6.284215450e-01f, 6.228585243e-01f, 6.172828674e-01f, 6.116952300e-01f,
+  6.060966253e-01f, 6.004877687e-01f, 5.948696136e-01f, 5.892428756e-01f, 5.836085081e-01f, 5.779675841e-01f,
+  5.723204613e-01f, 5.666681528e-01f, 5.610116720e-01f, 5.553517342e-01f, 5.496892333e-01f, 5.440250635e-01f,
+  5.383599997e-01f, 5.326949358e-01f, 5.270307660e-01f, 5.213682652e-01f, 5.157083273e-01f, 5.100517869e-01f,
+  5.043995380e-01f, 4.987526238e-01f, 4.931114614e-01f, 4.874770939e-01f, 4.818503857e-01f, 4.762322009e-01f,
+  4.706233740e-01f, 4.650247395e-01f, 4.594371319e-01f, 4.538614452e-01f, 4.482984543e-01f, 4.427490532e-01f,
+  4.372140169e-01f, 4.316942394e-01f, 4.261905253e-01f, 4.207038879e-01f, 4.152348042e-01f, 4.097842574e-01f,
+  4.043530226e-01f, 3.989419937e-01f, 3.935520053e-01f, 3.881837726e-01f, 3.828381300e-01f, 3.775159717e-01f,
+  3.722180128e-01f, 3.669450879e-01f, 3.616979420e-01f, 3.564774394e-01f, 3.512845039e-01f, 3.461195230e-01f,
+  3.409835398e-01f, 3.358772397e-01f, 3.308014572e-01f, 3.257569373e-01f, 3.207444251e-01f, 3.157646656e-01f,
+  3.108184636e-01f, 3.059065342e-01f, 3.010295630e-01f, 2.961883545e-01f, 2.913836241e-01f, 2.866160870e-01f,
+  2.818866372e-01f, 2.771956325e-01f, 2.725439668e-01f, 2.679322958e-01f, 2.633613944e-01f, 2.588318884e-01f,
+  2.543444932e-01f, 2.498998642e-01f, 2.454986572e-01f, 2.411415875e-01f, 2.368292511e-01f, 2.325623035e-01f,
+  2.283414602e-01f, 2.241672575e-01f, 2.200405896e-01f, 2.159616351e-01f, 2.119312882e-01f, 2.079500556e-01f,
+  2.040185928e-01f, 2.001374662e-01f, 1.963073313e-01f, 1.925286651e-01f, 1.888020933e-01f, 1.851281524e-01f,
+  1.815074086e-01f, 1.779404283e-01f, 1.744277179e-01f, 1.709697843e-01f, 1.675673425e-01f, 1.642205715e-01f,
+  1.609301865e-01f, 1.576966047e-01f, 1.545203626e-01f, 1.514019370e-01f, 1.483418047e-01f, 1.453403831e-01f,
+  1.423981488e-01f, 1.395155489e-01f, 1.366930008e-01f, 1.339309514e-01f, 1.312298179e-01f, 1.285900772e-01f,
+  1.260119677e-01f, 1.234959662e-01f, 1.210424006e-01f, 1.186517179e-01f, 1.163242161e-01f, 1.140603125e-01f,
+  1.118602455e-01f, 1.097244620e-01f, 1.076532006e-01f, 1.056467891e-01f, 1.037055850e-01f, 1.018298268e-01f,
+  1.000197530e-01f, 9.827584028e-02f, 9.659808874e-02f, 9.498685598e-02f, 9.344241023e-02f, 9.196498990e-02f,
+  9.055477381e-02f, 8.921200037e-02f, 8.793687820e-02f, 8.672955632e-02f, 8.559027314e-02f, 8.451914787e-02f,
+  8.351641893e-02f, 8.258214593e-02f, 8.171653748e-02f, 8.091971278e-02f, 8.019176126e-02f, 7.953277230e-02f,
+  7.894292474e-02f, 7.842224836e-02f, 7.797083259e-02f, 7.758876681e-02f, 7.727608085e-02f, 7.703280449e-02f,
+  7.685902715e-02f, 7.675474882e-02f
+};
+
+const float32_t FFT_Hamming_1024[1024] __ALIGNED(FFT_STATIC_ALIGNMENT) =
+{
+  7.671999931e-02f, 7.672870159e-02f, 7.675474882e-02f, 7.679820061e-02f, 7.685902715e-02f, 7.693722844e-02f,
+  7.703283429e-02f, 7.714575529e-02f, 7.727608085e-02f, 7.742375135e-02f, 7.758876681e-02f, 7.777112722e-02f,
+  7.797083259e-02f, 7.818788290e-02f, 7.842224836e-02f, 7.867392898e-02f, 7.894292474e-02f, 7.922920585e-02f,
+  7.953277230e-02f, 7.985365391e-02f, 8.019173145e-02f, 8.054709435e-02f, 8.091968298e-02f, 8.130952716e-02f,
+  8.171656728e-02f, 8.214077353e-02f, 8.258217573e-02f, 8.304071426e-02f, 8.351641893e-02f, 8.400925994e-02f,
+  8.451917768e-02f, 8.504620194e-02f, 8.559030294e-02f, 8.615139127e-02f, 8.672955632e-02f, 8.732473850e-02f,
+  8.793687820e-02f, 8.856597543e-02f, 8.921200037e-02f, 8.987492323e-02f, 9.055477381e-02f, 9.125146270e-02f,
+  9.196498990e-02f, 9.269532561e-02f, 9.344241023e-02f, 9.420627356e-02f, 9.498685598e-02f, 9.578412771e-02f,
+  9.659805894e-02f, 9.742861986e-02f, 9.827581048e-02f, 9.913954139e-02f, 1.000198126e-01f, 1.009165943e-01f,
+  1.018298566e-01f, 1.027595103e-01f, 1.037056148e-01f, 1.046680510e-01f, 1.056468189e-01f, 1.066418886e-01f,
+  1.076532006e-01f, 1.086807549e-01f, 1.097244620e-01f, 1.107843220e-01f, 1.118602753e-01f, 1.129522622e-01f,
+  1.140602827e-01f, 1.151842773e-01f, 1.163241863e-01f, 1.174800396e-01f, 1.186516881e-01f, 1.198391616e-01f,
+  1.210423708e-01f, 1.222613156e-01f, 1.234959066e-01f, 1.247461438e-01f, 1.260119379e-01f, 1.272932291e-01f,
+  1.285900474e-01f, 1.299022734e-01f, 1.312298477e-01f, 1.325727999e-01f, 1.339310110e-01f, 1.353044212e-01f,
+  1.366930306e-01f, 1.380967796e-01f, 1.395155787e-01f, 1.409493983e-01f, 1.423981786e-01f, 1.438618600e-01f,
+  1.453403831e-01f, 1.468337178e-01f, 1.483418047e-01f, 1.498645544e-01f, 1.514019370e-01f, 1.529538929e-01f,
+  1.545203626e-01f, 1.561012864e-01f, 1.576965749e-01f, 1.593062282e-01f, 1.609301567e-01f, 1.625682712e-01f,
+  1.642205119e-01f, 1.658868790e-01f, 1.675672829e-01f, 1.692616045e-01f, 1.709698439e-01f, 1.726919115e-01f,
+  1.744277477e-01f, 1.761772633e-01f, 1.779404581e-01f, 1.797172129e-01f, 1.815074384e-01f, 1.833111346e-01f,
+  1.851281822e-01f, 1.869585216e-01f, 1.888021231e-01f, 1.906588376e-01f, 1.925286651e-01f, 1.944115162e-01f,
+  1.963073313e-01f, 1.982159913e-01f, 2.001374662e-01f, 2.020716965e-01f, 2.040185630e-01f, 2.059780657e-01f,
+  2.079500258e-01f, 2.099344432e-01f, 2.119312286e-01f, 2.139402926e-01f, 2.159616053e-01f, 2.179950178e-01f,
+  2.200405002e-01f, 2.220979631e-01f, 2.241673470e-01f, 2.262485623e-01f, 2.283415198e-01f, 2.304461598e-01f,
+  2.325623930e-01f, 2.346901298e-01f, 2.368292809e-01f, 2.389798164e-01f, 2.411415875e-01f, 2.433145940e-01f,
+  2.454986870e-01f, 2.476938069e-01f, 2.498998642e-01f, 2.521167696e-01f, 2.543444932e-01f, 2.565828860e-01f,
+  2.588318586e-01f, 2.610914111e-01f, 2.633613646e-01f, 2.656416893e-01f, 2.679322958e-01f, 2.702330649e-01f,
+  2.725438774e-01f, 2.748647630e-01f, 2.771955729e-01f, 2.795361876e-01f, 2.818865478e-01f, 2.842465937e-01f,
+  2.866161764e-01f, 2.889952064e-01f, 2.913836837e-01f, 2.937814593e-01f, 2.961884141e-01f, 2.986045182e-01f,
+  3.010295630e-01f, 3.034636378e-01f, 3.059065342e-01f, 3.083581924e-01f, 3.108184934e-01f, 3.132873476e-01f,
+  3.157647252e-01f, 3.182503581e-01f, 3.207443953e-01f, 3.232465982e-01f, 3.257569075e-01f, 3.282752037e-01f,
+  3.308014274e-01f, 3.333354592e-01f, 3.358771801e-01f, 3.384265602e-01f, 3.409834504e-01f, 3.435478210e-01f,
+  3.461194634e-01f, 3.486983776e-01f, 3.512844145e-01f, 3.538774550e-01f, 3.564774990e-01f, 3.590843678e-01f,
+  3.616980314e-01f, 3.643183112e-01f, 3.669451475e-01f, 3.695784211e-01f, 3.722180128e-01f, 3.748639226e-01f,
+  3.775160015e-01f, 3.801741004e-01f, 3.828381896e-01f, 3.855081201e-01f, 3.881837726e-01f, 3.908650577e-01f,
+  3.935519457e-01f, 3.962442875e-01f, 3.989419937e-01f, 4.016449153e-01f, 4.043530226e-01f, 4.070660770e-01f,
+  4.097841382e-01f, 4.125070572e-01f, 4.152347147e-01f, 4.179670215e-01f, 4.207038283e-01f, 4.234450758e-01f,
+  4.261906147e-01f, 4.289404154e-01f, 4.316943288e-01f, 4.344522655e-01f, 4.372141063e-01f, 4.399797618e-01f,
+  4.427491426e-01f, 4.455220401e-01f, 4.482984841e-01f, 4.510783255e-01f, 4.538614750e-01f, 4.566477835e-01f,
+  4.594371617e-01f, 4.622295201e-01f, 4.650247097e-01f, 4.678227007e-01f, 4.706233144e-01f, 4.734265208e-01f,
+  4.762321711e-01f, 4.790401459e-01f, 4.818503559e-01f, 4.846626520e-01f, 4.874770045e-01f, 4.902932942e-01f,
+  4.931113720e-01f, 4.959311485e-01f, 4.987525344e-01f, 5.015754104e-01f, 5.043996572e-01f, 5.072251558e-01f,
+  5.100519061e-01f, 5.128796697e-01f, 5.157083869e-01f, 5.185379982e-01f, 5.213683248e-01f, 5.241992474e-01f,
+  5.270307660e-01f, 5.298627019e-01f, 5.326949954e-01f, 5.355274677e-01f, 5.383599997e-01f, 5.411925316e-01f,
+  5.440250039e-01f, 5.468572974e-01f, 5.496892333e-01f, 5.525206923e-01f, 5.553516746e-01f, 5.581820607e-01f,
+  5.610115528e-01f, 5.638403296e-01f, 5.666680932e-01f, 5.694947839e-01f, 5.723203421e-01f, 5.751445889e-01f,
+  5.779675245e-01f, 5.807888508e-01f, 5.836086273e-01f, 5.864267349e-01f, 5.892429948e-01f, 5.920573473e-01f,
+  5.948696733e-01f, 5.976799130e-01f, 6.004878283e-01f, 6.032934189e-01f, 6.060966253e-01f, 6.088973284e-01f,
+  6.116952896e-01f, 6.144905090e-01f, 6.172828674e-01f, 6.200721860e-01f, 6.228585243e-01f, 6.256416440e-01f,
+  6.284214854e-01f, 6.311979294e-01f, 6.339709163e-01f, 6.367402673e-01f, 6.395058632e-01f, 6.422677040e-01f,
+  6.450256705e-01f, 6.477795839e-01f, 6.505293846e-01f, 6.532749534e-01f, 6.560162306e-01f, 6.587529778e-01f,
+  6.614852548e-01f, 6.642129421e-01f, 6.669358015e-01f, 6.696538925e-01f, 6.723670363e-01f, 6.750750542e-01f,
+  6.777780056e-01f, 6.804757118e-01f, 6.831680536e-01f, 6.858549118e-01f, 6.885362864e-01f, 6.912119389e-01f,
+  6.938818097e-01f, 6.965458989e-01f, 6.992039680e-01f, 7.018560171e-01f, 7.045019865e-01f, 7.071416378e-01f,
+  7.097749114e-01f, 7.124016881e-01f, 7.150219679e-01f, 7.176356316e-01f, 7.202425003e-01f, 7.228425145e-01f,
+  7.254356146e-01f, 7.280216813e-01f, 7.306005359e-01f, 7.331721783e-01f, 7.357365489e-01f, 7.382934093e-01f,
+  7.408428192e-01f, 7.433845401e-01f, 7.459185719e-01f, 7.484447956e-01f, 7.509630919e-01f, 7.534734011e-01f,
+  7.559755445e-01f, 7.584695816e-01f, 7.609552741e-01f, 7.634326220e-01f, 7.659015059e-01f, 7.683618069e-01f,
+  7.708134651e-01f, 7.732563615e-01f, 7.756903768e-01f, 7.781155109e-01f, 7.805315852e-01f, 7.829385996e-01f,
+  7.853363752e-01f, 7.877247930e-01f, 7.901037931e-01f, 7.924733758e-01f, 7.948334217e-01f, 7.971838117e-01f,
+  7.995244265e-01f, 8.018552065e-01f, 8.041760921e-01f, 8.064869642e-01f, 8.087877035e-01f, 8.110783100e-01f,
+  8.133586645e-01f, 8.156286478e-01f, 8.178881407e-01f, 8.201371431e-01f, 8.223754764e-01f, 8.246032000e-01f,
+  8.268201351e-01f, 8.290261626e-01f, 8.312213421e-01f, 8.334053755e-01f, 8.355784416e-01f, 8.377401829e-01f,
+  8.398907185e-01f, 8.420299292e-01f, 8.441576958e-01f, 8.462738991e-01f, 8.483785391e-01f, 8.504713774e-01f,
+  8.525526524e-01f, 8.546220064e-01f, 8.566794395e-01f, 8.587249517e-01f, 8.607584238e-01f, 8.627797365e-01f,
+  8.647887707e-01f, 8.667855263e-01f, 8.687700033e-01f, 8.707419634e-01f, 8.727014661e-01f, 8.746483326e-01f,
+  8.765825033e-01f, 8.785039186e-01f, 8.804126382e-01f, 8.823084831e-01f, 8.841912746e-01f, 8.860611320e-01f,
+  8.879178762e-01f, 8.897614479e-01f, 8.915917873e-01f, 8.934088945e-01f, 8.952125311e-01f, 8.970028162e-01f,
+  8.987795711e-01f, 9.005427361e-01f, 9.022922516e-01f, 9.040280581e-01f, 9.057501554e-01f, 9.074583650e-01f,
+  9.091527462e-01f, 9.108331203e-01f, 9.124994278e-01f, 9.141517282e-01f, 9.157898426e-01f, 9.174137712e-01f,
+  9.190233946e-01f, 9.206187129e-01f, 9.221996069e-01f, 9.237661362e-01f, 9.253180027e-01f, 9.268554449e-01f,
+  9.283781648e-01f, 9.298862815e-01f, 9.313796163e-01f, 9.328581095e-01f, 9.343218207e-01f, 9.357706308e-01f,
+  9.372044206e-01f, 9.386231899e-01f, 9.400269985e-01f, 9.414155483e-01f, 9.427890182e-01f, 9.441472292e-01f,
+  9.454901218e-01f, 9.468176961e-01f, 9.481298923e-01f, 9.494267702e-01f, 9.507080317e-01f, 9.519738555e-01f,
+  9.532240629e-01f, 9.544587135e-01f, 9.556776285e-01f, 9.568808079e-01f, 9.580683112e-01f, 9.592399597e-01f,
+  9.603958130e-01f, 9.615356922e-01f, 9.626597166e-01f, 9.637677073e-01f, 9.648597240e-01f, 9.659357071e-01f,
+  9.669955373e-01f, 9.680392742e-01f, 9.690667987e-01f, 9.700781107e-01f, 9.710731506e-01f, 9.720519781e-01f,
+  9.730144143e-01f, 9.739605188e-01f, 9.748901725e-01f, 9.758034348e-01f, 9.767001867e-01f, 9.775804281e-01f,
+  9.784442186e-01f, 9.792913198e-01f, 9.801219702e-01f, 9.809358716e-01f, 9.817331433e-01f, 9.825137258e-01f,
+  9.832775593e-01f, 9.840246439e-01f, 9.847550392e-01f, 9.854685664e-01f, 9.861652255e-01f, 9.868450165e-01f,
+  9.875079393e-01f, 9.881540537e-01f, 9.887831211e-01f, 9.893952608e-01f, 9.899904728e-01f, 9.905686378e-01f,
+  9.911297560e-01f, 9.916738272e-01f, 9.922008514e-01f, 9.927107096e-01f, 9.932035804e-01f, 9.936792850e-01f,
+  9.941378236e-01f, 9.945791960e-01f, 9.950034618e-01f, 9.954104424e-01f, 9.958002567e-01f, 9.961729050e-01f,
+  9.965282679e-01f, 9.968663454e-01f, 9.971872568e-01f, 9.974907637e-01f, 9.977771044e-01f, 9.980460405e-01f,
+  9.982977509e-01f, 9.985321760e-01f, 9.987491965e-01f, 9.989488721e-01f, 9.991312027e-01f, 9.992962480e-01f,
+  9.994438887e-01f, 9.995742440e-01f, 9.996871948e-01f, 9.997828007e-01f, 9.998610020e-01f, 9.999217987e-01f,
+  9.999652505e-01f, 9.999912977e-01f, 1.000000000e+00f, 9.999912977e-01f, 9.999652505e-01f, 9.999217987e-01f,
+  9.998610020e-01f, 9.997828007e-01f, 9.996871948e-01f, 9.995742440e-01f, 9.994438887e-01f, 9.992962480e-01f,
+  9.991312027e-01f, 9.989488721e-01f, 9.987491369e-01f, 9.985321164e-01f, 9.982977509e-01f, 9.980460405e-01f,
+  9.977771044e-01f, 9.974907637e-01f, 9.971872568e-01f, 9.968663454e-01f, 9.965282679e-01f, 9.961729050e-01f,
+  9.958003163e-01f, 9.954104424e-01f, 9.950034618e-01f, 9.945791960e-01f, 9.941378236e-01f, 9.936792850e-01f,
+  9.932035804e-01f, 9.927107096e-01f, 9.922008514e-01f, 9.916738272e-01f, 9.911297560e-01f, 9.905686378e-01f,
+  9.899904728e-01f, 9.893952608e-01f, 9.887831211e-01f, 9.881540537e-01f, 9.875079989e-01f, 9.868450165e-01f,
+  9.861652255e-01f, 9.854685068e-01f, 9.847550392e-01f, 9.840247035e-01f, 9.832776189e-01f, 9.825137258e-01f,
+  9.817332029e-01f, 9.809359312e-01f, 9.801219702e-01f, 9.792913795e-01f, 9.784442186e-01f, 9.775804281e-01f,
+  9.767001867e-01f, 9.758033752e-01f, 9.748901129e-01f, 9.739605188e-01f, 9.730143547e-01f, 9.720519781e-01f,
+  9.710732102e-01f, 9.700781107e-01f, 9.690667987e-01f, 9.680392742e-01f, 9.669955373e-01f, 9.659357071e-01f,
+  9.648597240e-01f, 9.637677670e-01f, 9.626597166e-01f, 9.615356922e-01f, 9.603958130e-01f, 9.592399597e-01f,
+  9.580682516e-01f, 9.568808675e-01f, 9.556776285e-01f, 9.544587135e-01f, 9.532240629e-01f, 9.519739151e-01f,
+  9.507080317e-01f, 9.494267702e-01f, 9.481299520e-01f, 9.468177557e-01f, 9.454901218e-01f, 9.441471696e-01f,
+  9.427889585e-01f, 9.414155483e-01f, 9.400268793e-01f, 9.386232495e-01f, 9.372044802e-01f, 9.357706308e-01f,
+  9.343218803e-01f, 9.328581095e-01f, 9.313796163e-01f, 9.298862815e-01f, 9.283782244e-01f, 9.268554449e-01f,
+  9.253180027e-01f, 9.237660766e-01f, 9.221996069e-01f, 9.206187129e-01f, 9.190233946e-01f, 9.174137712e-01f,
+  9.157898426e-01f, 9.141517878e-01f, 9.124994874e-01f, 9.108331203e-01f, 9.091527462e-01f, 9.074583650e-01f,
+  9.057501554e-01f, 9.040280581e-01f, 9.022922516e-01f, 9.005427361e-01f, 8.987795115e-01f, 8.970027566e-01f,
+  8.952125907e-01f, 8.934088945e-01f, 8.915917873e-01f, 8.897614479e-01f, 8.879178762e-01f, 8.860611916e-01f,
+  8.841913342e-01f, 8.823084831e-01f, 8.804126978e-01f, 8.785039783e-01f, 8.765825033e-01f, 8.746482730e-01f,
+  8.727014065e-01f, 8.707419038e-01f, 8.687700033e-01f, 8.667855859e-01f, 8.647887707e-01f, 8.627797365e-01f,
+  8.607584238e-01f, 8.587249517e-01f, 8.566794991e-01f, 8.546220064e-01f, 8.525526524e-01f, 8.504714370e-01f,
+  8.483784199e-01f, 8.462737799e-01f, 8.441575766e-01f, 8.420299292e-01f, 8.398907185e-01f, 8.377401829e-01f,
+  8.355784416e-01f, 8.334054351e-01f, 8.312213421e-01f, 8.290262222e-01f, 8.268201351e-01f, 8.246032000e-01f,
+  8.223755360e-01f, 8.201370835e-01f, 8.178881407e-01f, 8.156285286e-01f, 8.133585453e-01f, 8.110782504e-01f,
+  8.087877035e-01f, 8.064869046e-01f, 8.041760325e-01f, 8.018551469e-01f, 7.995243669e-01f, 7.971837521e-01f,
+  7.948335409e-01f, 7.924734950e-01f, 7.901039124e-01f, 7.877248526e-01f, 7.853363752e-01f, 7.829385996e-01f,
+  7.805316448e-01f, 7.781155109e-01f, 7.756904364e-01f, 7.732563615e-01f, 7.708134651e-01f, 7.683618069e-01f,
+  7.659015059e-01f, 7.634326816e-01f, 7.609553337e-01f, 7.584695816e-01f, 7.559755445e-01f, 7.534734011e-01f,
+  7.509630322e-01f, 7.484447360e-01f, 7.459185123e-01f, 7.433844805e-01f, 7.408427000e-01f, 7.382933497e-01f,
+  7.357364893e-01f, 7.331721187e-01f, 7.306004763e-01f, 7.280217409e-01f, 7.254356742e-01f, 7.228425741e-01f,
+  7.202425599e-01f, 7.176356912e-01f, 7.150220275e-01f, 7.124017477e-01f, 7.097749114e-01f, 7.071416378e-01f,
+  7.045019865e-01f, 7.018560767e-01f, 6.992040277e-01f, 6.965458989e-01f, 6.938818693e-01f, 6.912119389e-01f,
+  6.885362267e-01f, 6.858549118e-01f, 6.831679940e-01f, 6.804756522e-01f, 6.777780056e-01f, 6.750750542e-01f,
+  6.723669767e-01f, 6.696538329e-01f, 6.669357419e-01f, 6.642128229e-01f, 6.614851952e-01f, 6.587529182e-01f,
+  6.560161114e-01f, 6.532750130e-01f, 6.505294442e-01f, 6.477796435e-01f, 6.450257301e-01f, 6.422678232e-01f,
+  6.395059824e-01f, 6.367403269e-01f, 6.339709759e-01f, 6.311979890e-01f, 6.284215450e-01f, 6.256417036e-01f,
+  6.228585243e-01f, 6.200722456e-01f, 6.172828674e-01f, 6.144905090e-01f, 6.116952300e-01f, 6.088972688e-01f,
+  6.060966253e-01f, 6.032934189e-01f, 6.004877687e-01f, 5.976797938e-01f, 5.948696136e-01f, 5.920572281e-01f,
+  5.892428756e-01f, 5.864266157e-01f, 5.836085081e-01f, 5.807887316e-01f, 5.779675841e-01f, 5.751447082e-01f,
+  5.723204613e-01f, 5.694949031e-01f, 5.666681528e-01f, 5.638403893e-01f, 5.610116720e-01f, 5.581820607e-01f,
+  5.553517342e-01f, 5.525207520e-01f, 5.496892333e-01f, 5.468572974e-01f, 5.440250635e-01f, 5.411925912e-01f,
+  5.383599997e-01f, 5.355274081e-01f, 5.326949358e-01f, 5.298627019e-01f, 5.270307660e-01f, 5.241992474e-01f,
+  5.213682652e-01f, 5.185379386e-01f, 5.157083273e-01f, 5.128796101e-01f, 5.100517869e-01f, 5.072250962e-01f,
+  5.043995380e-01f, 5.015752912e-01f, 4.987526238e-01f, 4.959312379e-01f, 4.931114614e-01f, 4.902933538e-01f,
+  4.874770939e-01f, 4.846627414e-01f, 4.818503857e-01f, 4.790401757e-01f, 4.762322009e-01f, 4.734265804e-01f,
+  4.706233740e-01f, 4.678227305e-01f, 4.650247395e-01f, 4.622294903e-01f, 4.594371319e-01f, 4.566477537e-01f,
+  4.538614452e-01f, 4.510782957e-01f, 4.482984543e-01f, 4.455220103e-01f, 4.427490532e-01f, 4.399796724e-01f,
+  4.372140169e-01f, 4.344521761e-01f, 4.316942394e-01f, 4.289403260e-01f, 4.261905253e-01f, 4.234451652e-01f,
+  4.207038879e-01f, 4.179670811e-01f, 4.152348042e-01f, 4.125071466e-01f, 4.097842574e-01f, 4.070661664e-01f,
+  4.043530226e-01f, 4.016449451e-01f, 3.989419937e-01f, 3.962443173e-01f, 3.935520053e-01f, 3.908650875e-01f,
+  3.881837726e-01f, 3.855080605e-01f, 3.828381300e-01f, 3.801741004e-01f, 3.775159717e-01f, 3.748639226e-01f,
+  3.722180128e-01f, 3.695783615e-01f, 3.669450879e-01f, 3.643182516e-01f, 3.616979420e-01f, 3.590843081e-01f,
+  3.564774394e-01f, 3.538773954e-01f, 3.512845039e-01f, 3.486984372e-01f, 3.461195230e-01f, 3.435478806e-01f,
+  3.409835398e-01f, 3.384266198e-01f, 3.358772397e-01f, 3.333355188e-01f, 3.308014572e-01f, 3.282752633e-01f,
+  3.257569373e-01f, 3.232466280e-01f, 3.207444251e-01f, 3.182504177e-01f, 3.157646656e-01f, 3.132873178e-01f,
+  3.108184636e-01f, 3.083581626e-01f, 3.059065342e-01f, 3.034636080e-01f, 3.010295630e-01f, 2.986044586e-01f,
+  2.961883545e-01f, 2.937813997e-01f, 2.913836241e-01f, 2.889951766e-01f, 2.866160870e-01f, 2.842464745e-01f,
+  2.818866372e-01f, 2.795362771e-01f, 2.771956325e-01f, 2.748648524e-01f, 2.725439668e-01f, 2.702330947e-01f,
+  2.679322958e-01f, 2.656417191e-01f, 2.633613944e-01f, 2.610914409e-01f, 2.588318884e-01f, 2.565828860e-01f,
+  2.543444932e-01f, 2.521167696e-01f, 2.498998642e-01f, 2.476938069e-01f, 2.454986572e-01f, 2.433145642e-01f,
+  2.411415875e-01f, 2.389797568e-01f, 2.368292511e-01f, 2.346900702e-01f, 2.325623035e-01f, 2.304461002e-01f,
+  2.283414602e-01f, 2.262485027e-01f, 2.241672575e-01f, 2.220980525e-01f, 2.200405896e-01f, 2.179950774e-01f,
+  2.159616351e-01f, 2.139403522e-01f, 2.119312882e-01f, 2.099344730e-01f, 2.079500556e-01f, 2.059780657e-01f,
+  2.040185928e-01f, 2.020716965e-01f, 2.001374662e-01f, 1.982160211e-01f, 1.963073313e-01f, 1.944115162e-01f,
+  1.925286651e-01f, 1.906588376e-01f, 1.888020933e-01f, 1.869584918e-01f, 1.851281524e-01f, 1.833111048e-01f,
+  1.815074086e-01f, 1.797171831e-01f, 1.779404283e-01f, 1.761772633e-01f, 1.744277179e-01f, 1.726918817e-01f,
+  1.709697843e-01f, 1.692616940e-01f, 1.675673425e-01f, 1.658869386e-01f, 1.642205715e-01f, 1.625683010e-01f,
+  1.609301865e-01f, 1.593062580e-01f, 1.576966047e-01f, 1.561012864e-01f, 1.545203626e-01f, 1.529539227e-01f,
+  1.514019370e-01f, 1.498645544e-01f, 1.483418047e-01f, 1.468337178e-01f, 1.453403831e-01f, 1.438618600e-01f,
+  1.423981488e-01f, 1.409493685e-01f, 1.395155489e-01f, 1.380967498e-01f, 1.366930008e-01f, 1.353044212e-01f,
+  1.339309514e-01f, 1.325727403e-01f, 1.312298179e-01f, 1.299022138e-01f, 1.285900772e-01f, 1.272932887e-01f,
+  1.260119677e-01f, 1.247461736e-01f, 1.234959662e-01f, 1.222613454e-01f, 1.210424006e-01f, 1.198391914e-01f,
+  1.186517179e-01f, 1.174800396e-01f, 1.163242161e-01f, 1.151843071e-01f, 1.140603125e-01f, 1.129522622e-01f,
+  1.118602455e-01f, 1.107843220e-01f, 1.097244620e-01f, 1.086807251e-01f, 1.076532006e-01f, 1.066418886e-01f,
+  1.056467891e-01f, 1.046680212e-01f, 1.037055850e-01f, 1.027594805e-01f, 1.018298268e-01f, 1.009165645e-01f,
+  1.000197530e-01f, 9.913957119e-02f, 9.827584028e-02f, 9.742864966e-02f, 9.659808874e-02f, 9.578415751e-02f,
+  9.498685598e-02f, 9.420630336e-02f, 9.344241023e-02f, 9.269532561e-02f, 9.196498990e-02f, 9.125146270e-02f,
+  9.055477381e-02f, 8.987492323e-02f, 8.921200037e-02f, 8.856597543e-02f, 8.793687820e-02f, 8.732473850e-02f,
+  8.672955632e-02f, 8.615139127e-02f, 8.559027314e-02f, 8.504620194e-02f, 8.451914787e-02f, 8.400923014e-02f,
+  8.351641893e-02f, 8.304071426e-02f, 8.258214593e-02f, 8.214077353e-02f, 8.171653748e-02f, 8.130952716e-02f,
+  8.091971278e-02f, 8.054712415e-02f, 8.019176126e-02f, 7.985365391e-02f, 7.953277230e-02f, 7.922923565e-02f,
+  7.894292474e-02f, 7.867392898e-02f, 7.842224836e-02f, 7.818788290e-02f, 7.797083259e-02f, 7.777112722e-02f,
+  7.758876681e-02f, 7.742372155e-02f, 7.727608085e-02f, 7.714575529e-02f, 7.703280449e-02f, 7.693722844e-02f,
+  7.685902715e-02f, 7.679820061e-02f, 7.675474882e-02f, 7.672870159e-02f
+};
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -72,7 +72,9 @@
 #define VOL_MIN                                       0xDBE0 
 #define VOL_RES                                       0x0023
 #define VOL_MAX                                       0x0000 
-#define AUDIO_IN_PACKET                  (uint32_t)((((48000/1000)+2)*8)*2) 
+/* Largest packet, in bytes: 48 KHz with 8 channels of 16 bits, 4 channels of 32 bits or 5 of 24 bits */
+#define AUDIO_IN_PACKET_BYTES            ((((48000/1000)+2)*8)*2)   /* without the cast, for the #if checks of the application */
+#define AUDIO_IN_PACKET                  (uint32_t)AUDIO_IN_PACKET_BYTES
 #define MIC_IN_TERMINAL_ID                            1
 #define MIC_FU_ID                                     2
 #define MIC_OUT_TERMINAL_ID                           3
@@ -92,6 +94,27 @@ AUDIO_StatesTypeDef;
 
 /* Number of sub-packets in the audio transfer buffer.*/
 #define AUDIO_IN_PACKET_NUM                            6
+/* Blocks tiling the ring: AUDIO_IN_PACKET_NUM around the fill level set point, and one
+   for the packet in flight, already past the read pointer, that a block must not overwrite */
+#define AUDIO_IN_RING_BLOCKS                           (AUDIO_IN_PACKET_NUM + 1)
+
+/* Size in bytes of the statically allocated packet ring: AUDIO_IN_RING_BLOCKS blocks
+   of the largest block passed by the application (default: 1 ms at 48 KHz, 8 channels).
+   It can be overridden at compile time. */
+#ifndef AUDIO_IN_RING_SIZE
+#define AUDIO_IN_RING_SIZE                             (AUDIO_IN_RING_BLOCKS * 48 * 8 * 2)
+#endif
+
+/* Clock drift compensation: the outgoing stream is resampled by a cubic Farrow
+   interpolator, whose ratio is set by a PI controller on the fill level sampled
+   at each SOF, so that packets keep the nominal size. Comment this define to add
+   or drop one sample per packet when the fill level crosses the thresholds. */
+#define AUDIO_IN_RESAMPLING
+
+#define AUDIO_IN_SYNC_PERIOD                           16        /* SOFs the fill level is averaged over */
+#define AUDIO_IN_SYNC_KP                               0.008f    /* per ms of fill level error */
+#define AUDIO_IN_SYNC_KI                               0.000256f /* per ms of error and per sync period */
+#define AUDIO_IN_SYNC_MAX_DEVIATION                    0.005f    /* resampling ratio bound, 5000 ppm */
 
 #define TIMEOUT_VALUE                                   200
 
@@ -133,12 +156,32 @@ typedef struct
 USBD_AUDIO_ControlTypeDef; 
 
 
+/* Statistics of the isochronous stream, kept by the class on the device */
+typedef struct
+{
+  uint32_t packets;         /* packets sent from the ring */
+  uint32_t dummy_packets;   /* packets of zeros sent while the stream is not started */
+  uint32_t long_packets;    /* packets of one frame more than nominal */
+  uint32_t short_packets;   /* packets of one frame less than nominal */
+  uint32_t underruns;       /* ring drained by the host, the stream is restarted */
+  uint32_t overruns;        /* blocks dropped, the ring holding frames not sent yet */
+  uint32_t timeouts;        /* stream stopped by the application writes, the host not reading */
+  uint16_t fill_min;        /* ring fill level before a packet, in frames: latency */
+  uint16_t fill_max;
+  uint32_t cycles_max;      /* longest packet preparation, in core clock cycles */
+}
+USBD_AUDIO_StatsTypeDef;
+
+
 typedef struct
 {
   __IO uint32_t              alt_setting;  
   uint8_t                    channels;
+  uint8_t                    subframe;     /* bytes per sample: 2, 3 or 4 */
+  uint8_t                    resolution;   /* bits per sample of the stream: 16, 24 or 32 */
   uint32_t                   frequency;
   __IO int16_t                   timeout;
+  uint8_t                    dropping;     /* blocks dropped until the ring is back to the set point */
   uint16_t                   buffer_length;    
   uint16_t                   dataAmount;
   uint16_t                   paketDimension;   
@@ -149,6 +192,14 @@ typedef struct
   uint8_t                    lower_treshold;
   USBD_AUDIO_ControlTypeDef control;   
   uint8_t  *                 buffer;
+#ifdef AUDIO_IN_RESAMPLING
+  float                      ratio;        /* input frames consumed per output frame */
+  float                      phase;        /* fractional read position after rd_ptr */
+  float                      integrator;   /* integral term: measured producer rate offset */
+  float                      fill_acc;     /* fill level accumulated over the sync period */
+  uint16_t                   sof_count;
+#endif
+  USBD_AUDIO_StatsTypeDef    stats;
 }
 USBD_AUDIO_HandleTypeDef; 
 
@@ -164,6 +215,7 @@ typedef struct
   int8_t  (*Pause)   		(void);
   int8_t  (*Resume)   		(void);
   int8_t  (*CommandMgr)     (uint8_t cmd);
+  int8_t  (*GetPosition)    (uint32_t *frames);   /* frames captured and not passed yet, may be NULL */
 }USBD_AUDIO_ItfTypeDef;
 /**
 * @}
@@ -191,7 +243,11 @@ extern USBD_ClassTypeDef  USBD_AUDIO;
 */ 
 uint8_t  USBD_AUDIO_RegisterInterface  (USBD_HandleTypeDef   *pdev, USBD_AUDIO_ItfTypeDef *fops);
 void USBD_AUDIO_Init_Microphone_Descriptor(USBD_HandleTypeDef   *pdev, uint32_t samplingFrequency, uint8_t Channels);
+void USBD_AUDIO_Init_Microphone_Descriptor_Config(USBD_HandleTypeDef   *pdev, uint32_t samplingFrequency, uint8_t Channels, uint16_t ChannelConfig, uint8_t BitsPerSample);
 uint8_t  USBD_AUDIO_Data_Transfer (USBD_HandleTypeDef *pdev, int16_t * audioData, uint16_t dataAmount);
+uint8_t  USBD_AUDIO_Reserve (USBD_HandleTypeDef *pdev, uint16_t PCMSamples, int16_t **audioData);
+uint8_t  USBD_AUDIO_Commit (USBD_HandleTypeDef *pdev, uint16_t PCMSamples);
+uint8_t  USBD_AUDIO_Get_Stats (USBD_HandleTypeDef *pdev, USBD_AUDIO_StatsTypeDef *stats, uint8_t ResetPeaks);
 
 
 /**
@@ -27,6 +27,8 @@
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
 void Send_Audio_to_USB(int16_t * audioData, uint16_t PCMSamples);
+int16_t *Reserve_Audio_to_USB(uint16_t PCMSamples);
+void Commit_Audio_to_USB(uint16_t PCMSamples);
 
 
 #endif /* __USBD_AUDIO_IN_IF_TEMPLATE_H */
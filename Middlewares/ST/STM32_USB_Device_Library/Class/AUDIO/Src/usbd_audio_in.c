@@ -21,6 +21,12 @@
 #include "usbd_audio_in.h"
 #include "usbd_desc.h"
 #include "usbd_ctlreq.h"
+#ifdef USE_USB_TELEMETRY
+#include "usbd_telemetry.h"
+#endif
+
+#ifndef USE_USB_AUDIO_CLASS_2
+/* The UAC2 class of Class/AUDIO2 replaces this one when usbd_conf.h selects it */
 
 /** @addtogroup STM32_USB_OTG_DEVICE_LIBRARY
 * @{
@@ -69,6 +75,16 @@
 * @{
 */ 
 
+#ifdef USE_USB_TELEMETRY
+/* The telemetry interface follows the audio control and streaming interfaces */
+#define AUDIO_TELEMETRY_INTERFACE                     0x02
+#define AUDIO_TELEMETRY_DESC_SIZ                      TELEMETRY_DESC_SIZ
+#define AUDIO_NUM_INTERFACES                          0x03
+#else
+#define AUDIO_TELEMETRY_DESC_SIZ                      0
+#define AUDIO_NUM_INTERFACES                          0x02
+#endif
+
 /**
 * @}
 */ 
@@ -100,6 +116,15 @@ static void AUDIO_REQ_SetCurrent(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef
 static void AUDIO_REQ_GetMaximum(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *req);
 static void AUDIO_REQ_GetMinimum(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *req);
 static void AUDIO_REQ_GetResolution(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *req);
+static uint8_t AUDIO_Ring_Setup(USBD_AUDIO_HandleTypeDef *haudio, uint16_t dataAmount);
+static uint16_t AUDIO_Ring_Fill(USBD_AUDIO_HandleTypeDef *haudio);
+static void AUDIO_Timeout(USBD_HandleTypeDef *pdev, USBD_AUDIO_HandleTypeDef *haudio);
+#ifdef AUDIO_IN_RESAMPLING
+static float AUDIO_Fill_Level(USBD_AUDIO_HandleTypeDef *haudio);
+static void AUDIO_Resample(USBD_AUDIO_HandleTypeDef *haudio, uint8_t *pOut, uint16_t frames);
+static int32_t AUDIO_Sample_Get(const uint8_t *pSample, uint8_t subframe);
+static void AUDIO_Sample_Put(uint8_t *pSample, int32_t sample, uint8_t subframe);
+#endif
 
 /**
 * @}
@@ -109,9 +134,18 @@ static void AUDIO_REQ_GetResolution(USBD_HandleTypeDef *pdev, USBD_SetupReqTyped
 * @{
 */ 
 /* This dummy buffer with 0 values will be sent when there is no availble data */
-static uint8_t IsocInBuffDummy[48*4*2]; 
+static uint8_t IsocInBuffDummy[AUDIO_IN_PACKET]; 
 static  int16_t VOL_CUR;
 static USBD_AUDIO_HandleTypeDef haudioInstance;
+/* Packet ring written in place by the application, followed by room for the
+   part of a packet straddling the end of the ring */
+__ALIGN_BEGIN static uint8_t IsocInRing[AUDIO_IN_RING_SIZE + AUDIO_IN_PACKET] __ALIGN_END;
+#ifdef AUDIO_IN_RESAMPLING
+/* Resampled packets, the one being sent is left untouched until its DataIn. 
+   The extra word takes the spill of the 32-bit reads and writes of 24-bit samples */
+static int16_t IsocInPacket[2][(AUDIO_IN_PACKET/2) + 2];
+static uint8_t IsocInPacketIdx;
+#endif
 
 USBD_ClassTypeDef  USBD_AUDIO = 
 {
@@ -133,7 +167,7 @@ USBD_ClassTypeDef  USBD_AUDIO =
 
 /* USB AUDIO device Configuration Descriptor */
 /* NOTE: This descriptor has to be filled using the Descriptor Initialization function */
-__ALIGN_BEGIN static uint8_t USBD_AUDIO_CfgDesc[USB_AUDIO_CONFIG_DESC_SIZ + 9] __ALIGN_END;
+__ALIGN_BEGIN static uint8_t USBD_AUDIO_CfgDesc[USB_AUDIO_CONFIG_DESC_SIZ + 9 + AUDIO_TELEMETRY_DESC_SIZ] __ALIGN_END;
 
 /* USB Standard Device Descriptor */
 __ALIGN_BEGIN static uint8_t USBD_AUDIO_DeviceQualifierDesc[USB_LEN_DEV_QUALIFIER_DESC] __ALIGN_END=
@@ -183,7 +217,7 @@ static uint8_t  USBD_AUDIO_Init (USBD_HandleTypeDef *pdev,
   haudio->rd_ptr = 0;
   haudio->timeout = 0;
   
-  ((USBD_AUDIO_ItfTypeDef *)pdev->pUserData[pdev->classId])->Init(haudio->frequency,0,haudio->channels);
+  ((USBD_AUDIO_ItfTypeDef *)pdev->pUserData[pdev->classId])->Init(haudio->frequency,haudio->resolution,haudio->channels);
   
   USBD_LL_OpenEP(pdev,
                  AUDIO_IN_EP,
@@ -197,6 +231,9 @@ static uint8_t  USBD_AUDIO_Init (USBD_HandleTypeDef *pdev,
                    IsocInBuffDummy,                        
                    packet_dim);      
   
+#ifdef USE_USB_TELEMETRY
+  USBD_TELEMETRY_Init(pdev);
+#endif
   haudio->state=STATE_USB_IDLE;
   return USBD_OK;
 }
@@ -213,6 +250,9 @@ static uint8_t  USBD_AUDIO_DeInit (USBD_HandleTypeDef *pdev,
 {
   /* Close EP IN */
   USBD_LL_CloseEP(pdev,AUDIO_IN_EP);  
+#ifdef USE_USB_TELEMETRY
+  USBD_TELEMETRY_DeInit(pdev);
+#endif
   /* DeInit  physical Interface components */
   if(pdev->pClassData != NULL)
   {
@@ -294,6 +334,13 @@ static uint8_t  USBD_AUDIO_Setup (USBD_HandleTypeDef *pdev,
       break;
       
     case USB_REQ_SET_INTERFACE :
+#ifdef USE_USB_TELEMETRY
+      if (LOBYTE(req->wIndex) == AUDIO_TELEMETRY_INTERFACE)
+      {
+        /* Single alternate setting, nothing to switch */
+      }
+      else
+#endif
       if ((uint8_t)(req->wValue) < USBD_MAX_NUM_INTERFACES)
       {
         haudio->alt_setting = (uint8_t)(req->wValue);
@@ -336,11 +383,23 @@ static uint8_t USBD_AUDIO_DataIn (USBD_HandleTypeDef *pdev,
   haudio = pdev->pClassData;
   uint32_t length_usb_pck;
   uint16_t app;
+  uint8_t underrun;
+#ifndef AUDIO_IN_RESAMPLING
+  uint16_t wrap;
+#endif
   uint16_t IsocInWr_app = haudio->wr_ptr;
   uint16_t true_dim = haudio->buffer_length;
   uint16_t packet_dim = haudio->paketDimension;
-  uint16_t channels = haudio->channels;
+  uint16_t frame_dim = haudio->channels * haudio->subframe;
+  uint32_t start = DWT->CYCCNT;
   length_usb_pck = packet_dim;  
+#ifdef USE_USB_TELEMETRY
+  if (epnum == (TELEMETRY_IN_EP & 0x7F))
+  {
+    USBD_TELEMETRY_DataIn(pdev);
+    return USBD_OK;
+  }
+#endif
   haudio->timeout=0;
   if (epnum == (AUDIO_IN_EP & 0x7F))
   {    
@@ -351,36 +410,87 @@ static uint8_t USBD_AUDIO_DataIn (USBD_HandleTypeDef *pdev,
     }    
     if (haudio->state == STATE_USB_BUFFER_WRITE_STARTED)   
     {      
-      haudio->rd_ptr = haudio->rd_ptr % (true_dim);              
       if(IsocInWr_app<haudio->rd_ptr){
         app = ((true_dim) - haudio->rd_ptr) +  IsocInWr_app;
       }else{
         app = IsocInWr_app - haudio->rd_ptr;
       }        
+      haudio->stats.packets++;
+      if((app / frame_dim) < haudio->stats.fill_min){
+        haudio->stats.fill_min = app / frame_dim;
+      }
+      if((app / frame_dim) > haudio->stats.fill_max){
+        haudio->stats.fill_max = app / frame_dim;
+      }
+      underrun = (app < haudio->buffer_length/10);
+#ifdef AUDIO_IN_RESAMPLING
+      /* The interpolator reads two frames past the ones it consumes: without them 
+         the read position would pass the write pointer and the fill level wrap */
+      if((float)(app / frame_dim) < (((float)(packet_dim / frame_dim) * haudio->ratio) + haudio->phase + 3.0f)){
+        underrun = 1;
+      }
+      if(underrun){
+        USBD_LL_Transmit (pdev,AUDIO_IN_EP,
+                          IsocInBuffDummy,
+                          length_usb_pck);      
+      }else{
+        /* Nominal packet resampled from the ring at the ratio set on SOF */
+        IsocInPacketIdx ^= 1;
+        AUDIO_Resample(haudio, (uint8_t *)IsocInPacket[IsocInPacketIdx], packet_dim/frame_dim);
+        USBD_LL_Transmit (pdev,AUDIO_IN_EP,
+                          (uint8_t*)IsocInPacket[IsocInPacketIdx],
+                          length_usb_pck);      
+      }
+#else
       if(app >= (packet_dim*haudio->upper_treshold)){       
-        length_usb_pck += channels*2;
+        length_usb_pck += frame_dim;
+        haudio->stats.long_packets++;
       }else if(app <= (packet_dim*haudio->lower_treshold)){
-        length_usb_pck -= channels*2;
+        length_usb_pck -= frame_dim;
+        haudio->stats.short_packets++;
       }     
-      USBD_LL_Transmit (pdev,AUDIO_IN_EP,
-                        (uint8_t*)(&haudio->buffer[haudio->rd_ptr]),
-                        length_usb_pck);      
-      haudio->rd_ptr += length_usb_pck;      
+      if(app < length_usb_pck){
+        /* Less than a packet left: the slice would pass the write pointer */
+        underrun = 1;
+        USBD_LL_Transmit (pdev,AUDIO_IN_EP,
+                          IsocInBuffDummy,
+                          length_usb_pck);      
+      }else{
+        /* Packets are slices of the ring: only the bytes of a packet crossing the 
+           end of the ring, once per ring cycle at most, are copied after it */
+        if((haudio->rd_ptr + length_usb_pck) > true_dim){
+          wrap = (haudio->rd_ptr + length_usb_pck) - true_dim;
+          memcpy(&haudio->buffer[true_dim], haudio->buffer, wrap);
+        }
+        USBD_LL_Transmit (pdev,AUDIO_IN_EP,
+                          (uint8_t*)(&haudio->buffer[haudio->rd_ptr]),
+                          length_usb_pck);      
+        haudio->rd_ptr += length_usb_pck;      
+        if(haudio->rd_ptr >= true_dim){
+          haudio->rd_ptr -= true_dim;
+        }
+      }
+#endif
 
-      if(app < haudio->buffer_length/10)
+      if(underrun)
       {
+        haudio->stats.underruns++;
         ((USBD_AUDIO_ItfTypeDef *)pdev->pUserData[pdev->classId])->Stop();
         haudio->state = STATE_USB_IDLE; 
         haudio->timeout=0;
-        memset(haudio->buffer,0,(haudio->buffer_length + haudio->dataAmount));
+        memset(haudio->buffer,0,haudio->buffer_length);
       }       
     }
     else 
     {      
+      haudio->stats.dummy_packets++;
       USBD_LL_Transmit (pdev,AUDIO_IN_EP,
                         IsocInBuffDummy,
                         length_usb_pck);      
     }    
+    if((DWT->CYCCNT - start) > haudio->stats.cycles_max){
+      haudio->stats.cycles_max = DWT->CYCCNT - start;
+    }
   }
   return USBD_OK;
 }
@@ -430,6 +540,59 @@ static uint8_t  USBD_AUDIO_EP0_TxReady (USBD_HandleTypeDef *pdev)
 */
 static uint8_t  USBD_AUDIO_SOF (USBD_HandleTypeDef *pdev)
 {  
+#ifdef AUDIO_IN_RESAMPLING
+  USBD_AUDIO_HandleTypeDef   *haudio;
+  USBD_AUDIO_ItfTypeDef      *itf;
+  haudio = pdev->pClassData;
+  itf = (USBD_AUDIO_ItfTypeDef *)pdev->pUserData[pdev->classId];
+  uint32_t pending = 0;
+  float nominal;
+  float error;
+  float deviation;
+  
+  if((haudio != NULL) && (haudio->state == STATE_USB_BUFFER_WRITE_STARTED))
+  {
+    /* The fill level seen at each SOF, plus the frames already captured for the 
+       next block, measures the producer rate against the host frame clock */
+    if((itf->GetPosition != NULL) && (itf->GetPosition(&pending) != 0))
+    {
+      pending = 0;
+    }
+    haudio->fill_acc += AUDIO_Fill_Level(haudio) + (float)pending;
+    if(++haudio->sof_count == AUDIO_IN_SYNC_PERIOD)
+    {
+      /* Set point: half a ring, where the writer starts, plus the block being 
+         captured. The ring alone then holds half a ring to one block more, 
+         less the interrupt latency, with blocks of headroom on either side */
+      nominal = (float)(haudio->paketDimension / (haudio->channels * haudio->subframe));
+      error = ((haudio->fill_acc / AUDIO_IN_SYNC_PERIOD) - (float)(((AUDIO_IN_PACKET_NUM/2) + 1) * haudio->dataAmount / (haudio->channels * haudio->subframe))) / nominal;
+      haudio->integrator += AUDIO_IN_SYNC_KI * error;
+      if(haudio->integrator > AUDIO_IN_SYNC_MAX_DEVIATION)
+      {
+        haudio->integrator = AUDIO_IN_SYNC_MAX_DEVIATION;
+      }
+      else if(haudio->integrator < -AUDIO_IN_SYNC_MAX_DEVIATION)
+      {
+        haudio->integrator = -AUDIO_IN_SYNC_MAX_DEVIATION;
+      }
+      deviation = haudio->integrator + (AUDIO_IN_SYNC_KP * error);
+      if(deviation > AUDIO_IN_SYNC_MAX_DEVIATION)
+      {
+        deviation = AUDIO_IN_SYNC_MAX_DEVIATION;
+      }
+      else if(deviation < -AUDIO_IN_SYNC_MAX_DEVIATION)
+      {
+        deviation = -AUDIO_IN_SYNC_MAX_DEVIATION;
+      }
+      haudio->ratio = 1.0f + deviation;
+      haudio->fill_acc = 0.0f;
+      haudio->sof_count = 0;
+    }
+  }
+#endif
+#ifdef USE_USB_TELEMETRY
+  USBD_TELEMETRY_SOF(pdev);
+#endif
   return USBD_OK;
 }
 
@@ -466,6 +629,12 @@ static uint8_t  USBD_AUDIO_IsoOutIncomplete (USBD_HandleTypeDef *pdev, uint8_t e
 static uint8_t  USBD_AUDIO_DataOut (USBD_HandleTypeDef *pdev, 
                                     uint8_t epnum)
 {  
+#ifdef USE_USB_TELEMETRY
+  if (epnum == (TELEMETRY_OUT_EP & 0x7F))
+  {
+    USBD_TELEMETRY_DataOut(pdev);
+  }
+#endif
   return USBD_OK;
 }
 
@@ -583,6 +752,205 @@ static void AUDIO_REQ_SetCurrent(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef
 }
 
 
+/**
+* @brief  AUDIO_Ring_Setup
+*         Lays out the static packet ring for the block size passed by the 
+*         application. The ring is never reallocated: a block size that does not
+*         fit in AUDIO_IN_RING_SIZE is rejected.
+* @param  haudio: audio handle
+* @param  dataAmount: block size in bytes
+* @retval status
+*/
+static uint8_t AUDIO_Ring_Setup(USBD_AUDIO_HandleTypeDef *haudio, uint16_t dataAmount)
+{
+  uint16_t packet_dim = haudio->paketDimension;
+  uint16_t wr_rd_offset = (AUDIO_IN_PACKET_NUM/2) * dataAmount / packet_dim;
+  
+  if((dataAmount == 0) || (((uint32_t)dataAmount * AUDIO_IN_RING_BLOCKS) > AUDIO_IN_RING_SIZE))
+  {
+    return USBD_FAIL;
+  }
+  
+  /* Blocks tile the ring, the writer starts half a ring ahead of the reader */
+  haudio->dataAmount = dataAmount;
+  haudio->buffer_length = dataAmount * AUDIO_IN_RING_BLOCKS;
+  haudio->wr_ptr = (AUDIO_IN_PACKET_NUM/2) * dataAmount;
+  haudio->dropping = 0;
+  haudio->rd_ptr = 0;
+  haudio->upper_treshold = wr_rd_offset + 1;
+  haudio->lower_treshold = wr_rd_offset - 1;
+  haudio->buffer = IsocInRing;
+  memset(haudio->buffer,0,haudio->buffer_length);
+#ifdef AUDIO_IN_RESAMPLING
+  haudio->ratio = 1.0f;
+  haudio->phase = 0.0f;
+  haudio->integrator = 0.0f;
+  haudio->fill_acc = 0.0f;
+  haudio->sof_count = 0;
+#endif
+  
+  return USBD_OK;
+}
+
+/**
+* @brief  AUDIO_Ring_Fill
+*         Bytes written in the ring and not read yet
+* @param  haudio: audio handle
+* @retval fill level, in bytes
+*/
+static uint16_t AUDIO_Ring_Fill(USBD_AUDIO_HandleTypeDef *haudio)
+{
+  uint16_t wr_ptr = haudio->wr_ptr;
+  uint16_t rd_ptr = haudio->rd_ptr;
+  
+  return (wr_ptr < rd_ptr) ? ((haudio->buffer_length - rd_ptr) + wr_ptr) : (wr_ptr - rd_ptr);
+}
+
+/**
+* @brief  AUDIO_Timeout
+*         Counts the blocks passed by the application since the host last read
+*         a packet and stops the stream when the host no longer reads
+* @param  pdev: device instance
+* @param  haudio: audio handle
+* @retval None
+*/
+static void AUDIO_Timeout(USBD_HandleTypeDef *pdev, USBD_AUDIO_HandleTypeDef *haudio)
+{
+  if(haudio->timeout++==TIMEOUT_VALUE){
+    haudio->stats.timeouts++;
+    haudio->state=STATE_USB_IDLE;
+    ((USBD_AUDIO_ItfTypeDef *)pdev->pUserData[pdev->classId])->Stop();
+    haudio->timeout=0;
+  }
+}
+
+#ifdef AUDIO_IN_RESAMPLING
+/**
+* @brief  AUDIO_Fill_Level
+*         Frames written in the ring and not read yet
+* @param  haudio: audio handle
+* @retval fill level, in frames
+*/
+static float AUDIO_Fill_Level(USBD_AUDIO_HandleTypeDef *haudio)
+{
+  uint16_t frame_dim = haudio->channels * haudio->subframe;
+  
+  return (float)(AUDIO_Ring_Fill(haudio) / frame_dim) - haudio->phase;
+}
+
+/**
+* @brief  AUDIO_Resample
+*         Produces frames from the ring with a 4 points, 3rd order Lagrange 
+*         interpolator in Farrow form, stepping the read position by ratio
+* @param  haudio: audio handle
+* @param  pOut: interleaved output frames
+* @param  frames: number of frames to produce
+* @retval None
+*/
+static void AUDIO_Resample(USBD_AUDIO_HandleTypeDef *haudio, uint8_t *pOut, uint16_t frames)
+{
+  uint8_t *ring = haudio->buffer;
+  uint8_t subframe = haudio->subframe;
+  uint16_t channels = haudio->channels;
+  uint16_t frame_dim = channels * subframe;
+  uint16_t ring_frames = haudio->buffer_length / frame_dim;
+  uint16_t n = haudio->rd_ptr / frame_dim;
+  uint16_t m1, p1, p2;
+  uint16_t i, ch;
+  float full = (subframe == 2) ? 32767.0f : 8388607.0f;
+  float mu = haudio->phase;
+  float xm1, x0, x1, x2;
+  float c1, c2, c3, y;
+  
+  for(i = 0; i < frames; i++)
+  {
+    m1 = (n == 0) ? (ring_frames - 1) : (n - 1);
+    p1 = (n + 1 == ring_frames) ? 0 : (n + 1);
+    p2 = (p1 + 1 == ring_frames) ? 0 : (p1 + 1);
+    for(ch = 0; ch < channels; ch++)
+    {
+      xm1 = (float)AUDIO_Sample_Get(&ring[(m1 * frame_dim) + (ch * subframe)], subframe);
+      x0 = (float)AUDIO_Sample_Get(&ring[(n * frame_dim) + (ch * subframe)], subframe);
+      x1 = (float)AUDIO_Sample_Get(&ring[(p1 * frame_dim) + (ch * subframe)], subframe);
+      x2 = (float)AUDIO_Sample_Get(&ring[(p2 * frame_dim) + (ch * subframe)], subframe);
+      c1 = x1 - (xm1 / 3.0f) - (x0 / 2.0f) - (x2 / 6.0f);
+      c2 = ((xm1 + x1) / 2.0f) - x0;
+      c3 = ((x2 - xm1) / 6.0f) + ((x0 - x1) / 2.0f);
+      y = (((((c3 * mu) + c2) * mu) + c1) * mu) + x0;
+      if(y > full){
+        y = full;
+      }else if(y < -full){
+        y = -full;
+      }
+      AUDIO_Sample_Put(pOut, (int32_t)((y >= 0.0f) ? (y + 0.5f) : (y - 0.5f)), subframe);
+      pOut += subframe;
+    }
+    mu += haudio->ratio;
+    while(mu >= 1.0f)
+    {
+      mu -= 1.0f;
+      n = (n + 1 == ring_frames) ? 0 : (n + 1);
+    }
+  }
+  haudio->phase = mu;
+  haudio->rd_ptr = n * frame_dim;
+}
+
+/**
+* @brief  AUDIO_Sample_Get
+*         Reads one sample of the stream format: 16 bits, 24 bits packed or 
+*         32 bits left-justified with 24 significant bits
+* @param  pSample: sample address
+* @param  subframe: bytes per sample
+* @retval sample, right-justified
+*/
+static int32_t AUDIO_Sample_Get(const uint8_t *pSample, uint8_t subframe)
+{
+  uint32_t word;
+  
+  if(subframe == 2)
+  {
+    return *(const int16_t *)pSample;
+  }
+  /* A 24-bit sample is read as one word: the ring and the packets have room for the extra byte */
+  memcpy(&word, pSample, 4);
+  if(subframe == 3)
+  {
+    return ((int32_t)(word << 8)) >> 8;
+  }
+  return ((int32_t)word) >> 8;
+}
+
+/**
+* @brief  AUDIO_Sample_Put
+*         Writes one sample in the stream format, see AUDIO_Sample_Get
+* @param  pSample: sample address
+* @param  sample: right-justified sample
+* @param  subframe: bytes per sample
+* @retval None
+*/
+static void AUDIO_Sample_Put(uint8_t *pSample, int32_t sample, uint8_t subframe)
+{
+  uint32_t word;
+  
+  if(subframe == 2)
+  {
+    *(int16_t *)pSample = (int16_t)sample;
+  }
+  else if(subframe == 3)
+  {
+    /* One word written, the extra byte is overwritten by the next sample */
+    word = (uint32_t)sample;
+    memcpy(pSample, &word, 4);
+  }
+  else
+  {
+    word = (uint32_t)sample << 8;
+    memcpy(pSample, &word, 4);
+  }
+}
+#endif
+
 /**
 * @}
 */ 
@@ -601,64 +969,140 @@ static void AUDIO_REQ_SetCurrent(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef
 *       the function. E.g.: assuming a Sampling frequency of 16 KHz and 1 channel, 
 *       you can pass 16 PCM samples if the function is called each millisecond, 
 *       32 samples if called every 2 milliseconds and so on. 
+*       The block is copied in the packet ring: use USBD_AUDIO_Reserve and 
+*       USBD_AUDIO_Commit to produce the samples directly in it.
 * @retval status
 */
 uint8_t  USBD_AUDIO_Data_Transfer(USBD_HandleTypeDef *pdev, int16_t * audioData, uint16_t PCMSamples)
+{
+  int16_t *pRing = NULL;
+  uint8_t ret = USBD_AUDIO_Reserve(pdev, PCMSamples, &pRing);
+  
+  if(pRing != NULL){
+    memcpy((uint8_t *)pRing, (uint8_t *)(audioData), PCMSamples * haudioInstance.subframe);
+    ret = USBD_AUDIO_Commit(pdev, PCMSamples);
+  }
+  return ret;  
+}
+
+/**
+* @brief  USBD_AUDIO_Reserve
+*         Hands out the next block of the packet ring, to be written in place
+*         by the application and then released with USBD_AUDIO_Commit
+* @param pdev: device instance
+* @param PCMSamples: number of PCM samples of the block
+* @param audioData: returns the block, NULL when the host is not streaming or the
+*       ring has no room for it. Samples are in the stream format: 16 bits, 24 bits
+*       packed in 3 bytes or 32 bits.
+* @note The block size is the one passed to USBD_AUDIO_Data_Transfer: the ring
+*       is laid out again, not reallocated, when it changes.
+* @retval status: USBD_BUSY when the block is dropped on an overrun
+*/
+uint8_t  USBD_AUDIO_Reserve(USBD_HandleTypeDef *pdev, uint16_t PCMSamples, int16_t **audioData)
 {
   
   USBD_AUDIO_HandleTypeDef   *haudio;
   haudio = (USBD_AUDIO_HandleTypeDef *)pdev->pClassData;
+  uint16_t dataAmount = PCMSamples * haudioInstance.subframe; /*Bytes*/
   
+  *audioData = NULL;
   if(haudioInstance.state==STATE_USB_WAITING_FOR_INIT){    
     return USBD_BUSY;    
   }  
-  uint16_t dataAmount = PCMSamples * 2; /*Bytes*/
-  uint16_t true_dim = haudio->buffer_length;
-  uint16_t current_data_Amount = haudio->dataAmount;
-  uint16_t packet_dim = haudio->paketDimension;
   
-  if(haudio->state==STATE_USB_REQUESTS_STARTED  || current_data_Amount!=dataAmount){   
-    
-    /*USB parameters definition, based on the amount of data passed*/
-    haudio->dataAmount=dataAmount;                  
-    uint16_t wr_rd_offset = (AUDIO_IN_PACKET_NUM/2) * dataAmount / packet_dim; 
-    haudio->wr_ptr=wr_rd_offset * packet_dim;
-    haudio->rd_ptr = 0;
-    haudio->upper_treshold = wr_rd_offset + 1;
-    haudio->lower_treshold = wr_rd_offset - 1;
-    haudio->buffer_length = (packet_dim * (dataAmount / packet_dim) * AUDIO_IN_PACKET_NUM);
-    
-    /*Memory allocation for data buffer, depending (also) on data amount passed to the transfer function*/
-    if(haudio->buffer != NULL)
-    {
-      USBD_free(haudio->buffer);      
-    }
-    haudio->buffer = USBD_malloc(haudio->buffer_length + haudio->dataAmount);
-    if(haudio->buffer == NULL)
+  if(haudio->state==STATE_USB_REQUESTS_STARTED  || 
+     (haudio->state==STATE_USB_BUFFER_WRITE_STARTED && haudio->dataAmount!=dataAmount)){   
+    if(AUDIO_Ring_Setup(haudio, dataAmount) != USBD_OK)
     {
       return USBD_FAIL;       
     }
-    memset(haudio->buffer,0,(haudio->buffer_length + haudio->dataAmount));
     haudio->state=STATE_USB_BUFFER_WRITE_STARTED;
+  }
+  
+  if(haudio->state==STATE_USB_BUFFER_WRITE_STARTED){
+    /* The block would overwrite frames not sent yet when the host reads slower than the application
+       writes. The packet in flight, one frame longer than nominal at most, is kept too, and one frame
+       more: a ring filled up to the read pointer would read as empty */
+    uint16_t fill = AUDIO_Ring_Fill(haudio);
+    uint16_t free_space = haudio->buffer_length - fill - haudio->paketDimension
+                          - (2U * haudio->channels * haudio->subframe);
     
-    
-  }else if(haudio->state==STATE_USB_BUFFER_WRITE_STARTED){
-    if(haudio->timeout++==TIMEOUT_VALUE){
-      haudio->state=STATE_USB_IDLE;
-      ((USBD_AUDIO_ItfTypeDef *)pdev->pUserData[pdev->classId])->Stop();   
-     haudio->timeout=0;
+    /* The block is dropped rather than written over frames not sent yet. Blocks are
+       dropped until the ring is back to the set point, half a ring, so that the stream
+       resumes with a single gap and its nominal latency */
+    if(free_space < dataAmount){
+      haudio->dropping = 1;
+    }else if(fill <= ((AUDIO_IN_PACKET_NUM/2) * dataAmount)){
+      haudio->dropping = 0;
     }
-    memcpy((uint8_t * )&haudio->buffer[haudio->wr_ptr], (uint8_t *)(audioData), dataAmount);    
-    haudio->wr_ptr += dataAmount;
-    haudio->wr_ptr = haudio->wr_ptr % (true_dim);    
-    if((haudio->wr_ptr-dataAmount) == 0){
-      memcpy((uint8_t *)(((uint8_t *)haudio->buffer)+true_dim),(uint8_t *)haudio->buffer, dataAmount);
+    if(haudio->dropping){
+      haudio->stats.overruns++;
+      AUDIO_Timeout(pdev, haudio);
+      return USBD_BUSY;
     }
+    *audioData = (int16_t *)&haudio->buffer[haudio->wr_ptr];
+  }
+  return USBD_OK;  
+}
+
+/**
+* @brief  USBD_AUDIO_Commit
+*         Releases to USB the block returned by USBD_AUDIO_Reserve
+* @param pdev: device instance
+* @param PCMSamples: number of PCM samples of the block
+* @retval status
+*/
+uint8_t  USBD_AUDIO_Commit(USBD_HandleTypeDef *pdev, uint16_t PCMSamples)
+{
+  
+  USBD_AUDIO_HandleTypeDef   *haudio;
+  haudio = (USBD_AUDIO_HandleTypeDef *)pdev->pClassData;
+  uint16_t dataAmount = PCMSamples * haudioInstance.subframe; /*Bytes*/
+  
+  if(haudioInstance.state!=STATE_USB_BUFFER_WRITE_STARTED){    
+    return USBD_BUSY;    
+  }  
+  if(haudio->dataAmount!=dataAmount){
+    return USBD_FAIL;
+  }
+  
+  AUDIO_Timeout(pdev, haudio);
+  haudio->wr_ptr += dataAmount;
+  if(haudio->wr_ptr >= haudio->buffer_length){
+    haudio->wr_ptr = 0;
   }
   return USBD_OK;  
 }
 
 
+/**
+* @brief  USBD_AUDIO_Get_Stats
+*         Returns the statistics of the stream. The counters run from the 
+*         descriptor initialization, the peaks from the last reset.
+* @param pdev: device instance
+* @param stats: filled with the statistics
+* @param ResetPeaks: non-zero to restart the fill level and cycles peaks
+* @retval status
+* @note   The statistics are updated by the USB and the audio interrupts: they
+*         are copied, and the peaks reset, with the interrupts masked so that
+*         the copy is consistent and no peak is lost between copy and reset.
+*/
+uint8_t  USBD_AUDIO_Get_Stats(USBD_HandleTypeDef *pdev, USBD_AUDIO_StatsTypeDef *stats, uint8_t ResetPeaks)
+{
+  uint32_t primask;
+  
+  primask = __get_PRIMASK();
+  __disable_irq();
+  *stats = haudioInstance.stats;
+  if(ResetPeaks != 0){
+    haudioInstance.stats.fill_min = 0xFFFF;
+    haudioInstance.stats.fill_max = 0;
+    haudioInstance.stats.cycles_max = 0;
+  }
+  __set_PRIMASK(primask);
+  return USBD_OK;
+}
+
 /**
 * @brief  USBD_AUDIO_RegisterInterface
 * @param  fops: Audio interface callback
@@ -682,14 +1126,31 @@ uint8_t  USBD_AUDIO_RegisterInterface  (USBD_HandleTypeDef   *pdev,
 * @retval status
 */
 void USBD_AUDIO_Init_Microphone_Descriptor(USBD_HandleTypeDef   *pdev, uint32_t samplingFrequency, uint8_t Channels)
+{
+  USBD_AUDIO_Init_Microphone_Descriptor_Config(pdev, samplingFrequency, Channels, (Channels == 2) ? 0x0003 : 0x0000, 16);
+}
+
+/**
+* @brief  Configures the microphone descriptor as USBD_AUDIO_Init_Microphone_Descriptor,
+*         with the spatial locations of the channels given by the application.
+* @param  samplingFrequency: sampling frequency
+* @param  Channels: number of channels, up to 8
+* @param  ChannelConfig: wChannelConfig of the input terminal, 0x0000 for channels
+*         without a spatial location (raw microphones, beams)
+* @param  BitsPerSample: 16, 24 (packed in 3 bytes) or 32 (24 significant bits,
+*         left-justified)
+* @retval status
+*/
+void USBD_AUDIO_Init_Microphone_Descriptor_Config(USBD_HandleTypeDef   *pdev, uint32_t samplingFrequency, uint8_t Channels, uint16_t ChannelConfig, uint8_t BitsPerSample)
 {
   uint16_t index;
+  uint8_t subframe = BitsPerSample / 8;
   uint8_t AUDIO_CONTROLS;   
   USBD_AUDIO_CfgDesc[0] = 0x09;                                                /* bLength */
   USBD_AUDIO_CfgDesc[1] = 0x02;                                                /* bDescriptorType */
-  USBD_AUDIO_CfgDesc[2] = ((USB_AUDIO_CONFIG_DESC_SIZ+Channels-1)&0xff);       /* wTotalLength */
-  USBD_AUDIO_CfgDesc[3] = ((USB_AUDIO_CONFIG_DESC_SIZ+Channels-1)>>8);
-  USBD_AUDIO_CfgDesc[4] = 0x02;                                                /* bNumInterfaces */
+  USBD_AUDIO_CfgDesc[2] = ((USB_AUDIO_CONFIG_DESC_SIZ+Channels-1+AUDIO_TELEMETRY_DESC_SIZ)&0xff); /* wTotalLength */
+  USBD_AUDIO_CfgDesc[3] = ((USB_AUDIO_CONFIG_DESC_SIZ+Channels-1+AUDIO_TELEMETRY_DESC_SIZ)>>8);
+  USBD_AUDIO_CfgDesc[4] = AUDIO_NUM_INTERFACES;                                /* bNumInterfaces */
   USBD_AUDIO_CfgDesc[5] = 0x01;                                                /* bConfigurationValue */
   USBD_AUDIO_CfgDesc[6] = 0x00;                                                /* iConfiguration */
   USBD_AUDIO_CfgDesc[7] = 0x80;                                                /* bmAttributes  BUS Powered*/
@@ -723,16 +1184,8 @@ void USBD_AUDIO_Init_Microphone_Descriptor(USBD_HandleTypeDef   *pdev, uint32_t
   USBD_AUDIO_CfgDesc[32] = 0x02;
   USBD_AUDIO_CfgDesc[33] = 0x00;                                               /* bAssocTerminal */
   USBD_AUDIO_CfgDesc[34] = Channels;                                           /* bNrChannels */   
-  if(Channels != 2)
-  {
-    USBD_AUDIO_CfgDesc[35] = 0x00;                                             /* wChannelConfig 0x0000  Mono */
-    USBD_AUDIO_CfgDesc[36] = 0x00;
-  }
-  else
-  {
-    USBD_AUDIO_CfgDesc[35] = 0x03;                                             /* wChannelConfig 0x0003  Stereo */
-    USBD_AUDIO_CfgDesc[36] = 0x00;
-  }   
+  USBD_AUDIO_CfgDesc[35] = ChannelConfig&0xff;                                 /* wChannelConfig */
+  USBD_AUDIO_CfgDesc[36] = ChannelConfig>>8;
   USBD_AUDIO_CfgDesc[37] = 0x00;                                               /* iChannelNames */
   USBD_AUDIO_CfgDesc[38] = 0x00;                                               /* iTerminal */   
   /* USB Microphone Audio Feature Unit Descriptor */
@@ -835,8 +1288,8 @@ void USBD_AUDIO_Init_Microphone_Descriptor(USBD_HandleTypeDef   *pdev, uint32_t
   USBD_AUDIO_CfgDesc[index++] = AUDIO_STREAMING_FORMAT_TYPE;                   /* bDescriptorSubtype */
   USBD_AUDIO_CfgDesc[index++] = AUDIO_FORMAT_TYPE_I;                           /* bFormatType */
   USBD_AUDIO_CfgDesc[index++] = Channels;                                      /* bNrChannels */
-  USBD_AUDIO_CfgDesc[index++] = 0x02;                                          /* bSubFrameSize */
-  USBD_AUDIO_CfgDesc[index++] = 16;                                            /* bBitResolution */
+  USBD_AUDIO_CfgDesc[index++] = subframe;                                      /* bSubFrameSize */
+  USBD_AUDIO_CfgDesc[index++] = (BitsPerSample == 16) ? 16 : 24;               /* bBitResolution */
   USBD_AUDIO_CfgDesc[index++] = 0x01;                                           /* bSamFreqType */
   USBD_AUDIO_CfgDesc[index++] = samplingFrequency&0xff;                        /* tSamFreq 8000 = 0x1F40 */
   USBD_AUDIO_CfgDesc[index++] = (samplingFrequency>>8)&0xff;
@@ -846,8 +1299,8 @@ void USBD_AUDIO_Init_Microphone_Descriptor(USBD_HandleTypeDef   *pdev, uint32_t
   USBD_AUDIO_CfgDesc[index++] = 0x05;                                          /* bDescriptorType */
   USBD_AUDIO_CfgDesc[index++] = AUDIO_IN_EP;                                   /* bEndpointAddress 1 in endpoint*/
   USBD_AUDIO_CfgDesc[index++] = 0x05;                                          /* bmAttributes */
-  USBD_AUDIO_CfgDesc[index++] = ((samplingFrequency/1000+2)*Channels*2)&0xFF;  /* wMaxPacketSize */ 
-  USBD_AUDIO_CfgDesc[index++] = ((samplingFrequency/1000+2)*Channels*2)>>8; 
+  USBD_AUDIO_CfgDesc[index++] = ((samplingFrequency/1000+2)*Channels*subframe)&0xFF;  /* wMaxPacketSize */ 
+  USBD_AUDIO_CfgDesc[index++] = ((samplingFrequency/1000+2)*Channels*subframe)>>8; 
   USBD_AUDIO_CfgDesc[index++] = 0x01;                                          /* bInterval */
   USBD_AUDIO_CfgDesc[index++] = 0x00;                                          /* bRefresh */
   USBD_AUDIO_CfgDesc[index++] = 0x00;                                          /* bSynchAddress */   
@@ -859,10 +1312,16 @@ void USBD_AUDIO_Init_Microphone_Descriptor(USBD_HandleTypeDef   *pdev, uint32_t
   USBD_AUDIO_CfgDesc[index++] = 0x00;                                          /* bLockDelayUnits */
   USBD_AUDIO_CfgDesc[index++] = 0x00;                                          /* wLockDelay */
   USBD_AUDIO_CfgDesc[index++] = 0x00;    
+#ifdef USE_USB_TELEMETRY
+  /* Telemetry interface */
+  index += USBD_TELEMETRY_Desc(&USBD_AUDIO_CfgDesc[index], AUDIO_TELEMETRY_INTERFACE);
+#endif
     
-  haudioInstance.paketDimension = (samplingFrequency/1000*Channels*2);
+  haudioInstance.paketDimension = (samplingFrequency/1000*Channels*subframe);
   haudioInstance.frequency=samplingFrequency;
-  haudioInstance.buffer_length = haudioInstance.paketDimension * AUDIO_IN_PACKET_NUM;
+  haudioInstance.subframe=subframe;
+  haudioInstance.resolution=BitsPerSample;
+  haudioInstance.buffer_length = haudioInstance.paketDimension * AUDIO_IN_RING_BLOCKS;
   haudioInstance.channels=Channels;  
   haudioInstance.upper_treshold = 5;
   haudioInstance.lower_treshold = 2;
@@ -870,7 +1329,9 @@ void USBD_AUDIO_Init_Microphone_Descriptor(USBD_HandleTypeDef   *pdev, uint32_t
   haudioInstance.wr_ptr = 3 * haudioInstance.paketDimension;
   haudioInstance.rd_ptr = 0;  
   haudioInstance.dataAmount=0;
-  haudioInstance.buffer = 0;
+  haudioInstance.buffer = IsocInRing;
+  memset(&haudioInstance.stats, 0, sizeof(haudioInstance.stats));
+  haudioInstance.stats.fill_min = 0xFFFF;
 }
 
 /**
@@ -887,3 +1348,4 @@ void USBD_AUDIO_Init_Microphone_Descriptor(USBD_HandleTypeDef   *pdev, uint32_t
 * @}
 */ 
 
+#endif /* USE_USB_AUDIO_CLASS_2 */
@@ -179,3 +179,24 @@ void Send_Audio_to_USB(int16_t * audioData, uint16_t PCMSamples){
   USBD_AUDIO_Data_Transfer(&hUSBDDevice, (int16_t *)audioData, PCMSamples);
 }
 
+/**
+* @brief  Returns the block of the USB packet ring to be filled in place
+* @param  PCMSamples: number of PCM samples of the block
+* @retval Pointer to the block, NULL when the host is not streaming
+*/
+int16_t *Reserve_Audio_to_USB(uint16_t PCMSamples){
+  int16_t *audioData;
+  
+  USBD_AUDIO_Reserve(&hUSBDDevice, PCMSamples, &audioData);
+  return audioData;
+}
+
+/**
+* @brief  Releases to the USB engine the block returned by Reserve_Audio_to_USB
+* @param  PCMSamples: number of PCM samples of the block
+*/
+void Commit_Audio_to_USB(uint16_t PCMSamples){
+  
+  USBD_AUDIO_Commit(&hUSBDDevice, PCMSamples);
+}
+
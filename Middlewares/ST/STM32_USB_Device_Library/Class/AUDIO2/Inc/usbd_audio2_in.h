@@ -0,0 +1,270 @@
+/**
+  ******************************************************************************
+  * @file    usbd_audio2_in.h
+  * @author  SRA
+  * @brief   header file for the usbd_audio2_in.c file.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+
+#ifndef __USBD_AUDIO2_IN_H_
+#define __USBD_AUDIO2_IN_H_
+
+#include "usbd_ioreq.h"
+
+/** @addtogroup STM32_USB_OTG_DEVICE_LIBRARY
+* @{
+*/
+
+/** @defgroup USBD_AUDIO2_IN
+* @{
+*/
+
+/** @defgroup USBD_AUDIO2_IN_Exported_Defines
+* @{
+*/
+
+/* Configuration descriptor size without the per channel controls of the feature unit */
+#define USB_AUDIO_CONFIG_DESC_SIZ                     137
+#define USB_AUDIO_AC_DESC_SIZ                         56
+#define USB_INTERFACE_DESCRIPTOR_TYPE                 0x04
+#define USB_INTERFACE_ASSOCIATION_DESCRIPTOR_TYPE     0x0B
+#define USB_DEVICE_CLASS_AUDIO                        0x01
+#define AUDIO_SUBCLASS_UNDEFINED                      0x00
+#define AUDIO_SUBCLASS_AUDIOCONTROL                   0x01
+#define AUDIO_SUBCLASS_AUDIOSTREAMING                 0x02
+#define AUDIO_FUNCTION_PROTOCOL_UNDEFINED             0x00
+#define AUDIO_PROTOCOL_IP_VERSION_02_00               0x20
+#define AUDIO_FUNCTION_CATEGORY_MICROPHONE            0x03
+/* Audio Descriptor Types */
+#define AUDIO_INTERFACE_DESCRIPTOR_TYPE               0x24
+#define AUDIO_ENDPOINT_DESCRIPTOR_TYPE                0x25
+/* Audio Control Interface Descriptor Subtypes */
+#define AUDIO_CONTROL_HEADER                          0x01
+#define AUDIO_CONTROL_INPUT_TERMINAL                  0x02
+#define AUDIO_CONTROL_OUTPUT_TERMINAL                 0x03
+#define AUDIO_CONTROL_FEATURE_UNIT                    0x06
+#define AUDIO_CONTROL_CLOCK_SOURCE                    0x0A
+/* Audio Streaming Interface Descriptor Subtypes */
+#define AUDIO_STREAMING_GENERAL                       0x01
+#define AUDIO_STREAMING_FORMAT_TYPE                   0x02
+#define AUDIO_FORMAT_TYPE_I                           0x01
+#define AUDIO_FORMAT_PCM                              0x00000001
+#define AUDIO_ENDPOINT_GENERAL                        0x01
+/* Class-specific requests, the direction is given by bmRequest */
+#define AUDIO_REQ_CUR                                 0x01
+#define AUDIO_REQ_RANGE                               0x02
+/* Clock source control selectors */
+#define AUDIO_CS_SAM_FREQ_CONTROL                     0x01
+#define AUDIO_CS_CLOCK_VALID_CONTROL                  0x02
+/* Feature unit control selectors */
+#define AUDIO_FU_MUTE_CONTROL                         0x01
+#define AUDIO_FU_VOLUME_CONTROL                       0x02
+/* Volume range, in 1/256 dB */
+#define VOL_MIN                                       0xDBE0
+#define VOL_RES                                       0x0023
+#define VOL_MAX                                       0x0000
+/* Largest packet, in bytes: 48 KHz with 8 channels of 16 bits, 4 channels of 32 bits or 5 of 24 bits */
+#define AUDIO_IN_PACKET_BYTES            ((((48000/1000)+2)*8)*2)   /* without the cast, for the #if checks of the application */
+#define AUDIO_IN_PACKET                  (uint32_t)AUDIO_IN_PACKET_BYTES
+/* Largest wMaxPacketSize of the endpoint: the packet buffers hold AUDIO_IN_PACKET bytes and a full speed
+   isochronous endpoint carries 1023 bytes at most. Formats with larger packets are rejected */
+#define AUDIO_IN_PACKET_MAX              ((AUDIO_IN_PACKET < 1023U) ? AUDIO_IN_PACKET : 1023U)
+#define MIC_IN_TERMINAL_ID                            1
+#define MIC_FU_ID                                     2
+#define MIC_OUT_TERMINAL_ID                           3
+#define MIC_CLOCK_SOURCE_ID                           0x10
+/* Audio Data in endpoint */
+#define AUDIO_IN_EP                                   0x81
+
+/* Sampling frequencies the clock source can be switched to by the host, in
+   ascending order. Only the ones below the frequency passed to
+   USBD_AUDIO_Init_Microphone_Descriptor are offered, with it: the packets
+   and the application buffers are sized for the start up frequency. */
+#ifndef AUDIO2_IN_FREQUENCIES
+#define AUDIO2_IN_FREQUENCIES                         {16000, 32000, 48000, 96000}
+#endif
+#define AUDIO2_IN_MAX_FREQUENCIES                     4
+
+/* Buffering state definitions */
+typedef enum
+{
+  STATE_USB_WAITING_FOR_INIT = 0,
+  STATE_USB_IDLE = 1,
+  STATE_USB_REQUESTS_STARTED = 2,
+  STATE_USB_BUFFER_WRITE_STARTED = 3,
+  STATE_USB_FORMAT_REJECTED = 4,   /* the descriptor was not built, the class does not start */
+}
+AUDIO_StatesTypeDef;
+
+/* Number of sub-packets in the audio transfer buffer.*/
+#define AUDIO_IN_PACKET_NUM                            6
+/* Blocks tiling the ring: AUDIO_IN_PACKET_NUM around the fill level set point, and one
+   for the packet in flight, already past the read pointer, that a block must not overwrite */
+#define AUDIO_IN_RING_BLOCKS                           (AUDIO_IN_PACKET_NUM + 1)
+
+/* Size in bytes of the statically allocated packet ring: AUDIO_IN_RING_BLOCKS blocks
+   of the largest block passed by the application (default: 1 ms at 48 KHz, 8 channels).
+   It can be overridden at compile time. */
+#ifndef AUDIO_IN_RING_SIZE
+#define AUDIO_IN_RING_SIZE                             (AUDIO_IN_RING_BLOCKS * 48 * 8 * 2)
+#endif
+
+/* Asynchronous endpoint: the number of frames of each packet follows the
+   producer rate measured against the host frame clock, a PI controller on the
+   fill level sampled at each SOF sets it within one frame of the nominal size */
+#define AUDIO_IN_SYNC_PERIOD                           16        /* SOFs the fill level is averaged over */
+#define AUDIO_IN_SYNC_KP                               0.008f    /* per ms of fill level error */
+#define AUDIO_IN_SYNC_KI                               0.000256f /* per ms of error and per sync period */
+#define AUDIO_IN_SYNC_MAX_DEVIATION                    0.005f    /* packet rate bound, 5000 ppm */
+
+#define TIMEOUT_VALUE                                   200
+
+
+/* Audio Commands enmueration */
+typedef enum
+{
+  AUDIO_CMD_START = 1,
+  AUDIO_CMD_PLAY,
+  AUDIO_CMD_STOP,
+}AUDIO_CMD_TypeDef;
+
+
+/**
+* @}
+*/
+
+
+/** @defgroup USBD_AUDIO2_IN_Exported_TypesDefinitions
+* @{
+*/
+typedef struct
+{
+  uint8_t cmd;
+  uint8_t data[USB_MAX_EP0_SIZE];
+  uint8_t len;
+  uint8_t unit;
+  uint8_t selector;   /* control selector of the pending SET CUR */
+}
+USBD_AUDIO_ControlTypeDef;
+
+
+/* Statistics of the isochronous stream, kept by the class on the device */
+typedef struct
+{
+  uint32_t packets;         /* packets sent from the ring */
+  uint32_t dummy_packets;   /* packets of zeros sent while the stream is not started */
+  uint32_t long_packets;    /* packets of one frame more than nominal */
+  uint32_t short_packets;   /* packets of one frame less than nominal */
+  uint32_t underruns;       /* ring drained by the host, the stream is restarted */
+  uint32_t overruns;        /* blocks dropped, the ring holding frames not sent yet */
+  uint32_t timeouts;        /* stream stopped by the application writes, the host not reading */
+  uint16_t fill_min;        /* ring fill level before a packet, in frames: latency */
+  uint16_t fill_max;
+  uint32_t cycles_max;      /* longest packet preparation, in core clock cycles */
+}
+USBD_AUDIO_StatsTypeDef;
+
+
+typedef struct
+{
+  __IO uint32_t              alt_setting;
+  uint8_t                    channels;
+  uint8_t                    subframe;     /* bytes per sample: 2, 3 or 4 */
+  uint8_t                    resolution;   /* bits per sample of the stream: 16, 24 or 32 */
+  uint32_t                   frequency;
+  uint32_t                   freq_list[AUDIO2_IN_MAX_FREQUENCIES];
+  uint8_t                    freq_num;
+  uint8_t                    mute;
+  __IO int16_t                   timeout;
+  uint8_t                    dropping;     /* blocks dropped until the ring is back to the set point */
+  uint16_t                   buffer_length;
+  uint16_t                   dataAmount;
+  uint16_t                   paketDimension;
+  uint16_t                   max_packet;   /* wMaxPacketSize: one frame more than the nominal packet */
+  uint8_t                    state;
+  uint16_t                   rd_ptr;
+  uint16_t                   wr_ptr;
+  USBD_AUDIO_ControlTypeDef control;
+  uint8_t  *                 buffer;
+  float                      rate;         /* frames per packet */
+  float                      frac;         /* fraction of frame carried to the next packet */
+  float                      integrator;   /* integral term: measured producer rate offset */
+  float                      fill_acc;     /* fill level accumulated over the sync period */
+  uint16_t                   sof_count;
+  USBD_AUDIO_StatsTypeDef    stats;
+}
+USBD_AUDIO_HandleTypeDef;
+
+
+typedef struct
+{
+  int8_t  (*Init)         	(uint32_t  AudioFreq, uint32_t BitRes, uint32_t ChnlNbr);
+  int8_t  (*DeInit)       	(uint32_t options);
+  int8_t  (*Record)     	(void);
+  int8_t  (*VolumeCtl)    	(int16_t Volume);
+  int8_t  (*MuteCtl)      	(uint8_t cmd);
+  int8_t  (*Stop)   		(void);
+  int8_t  (*Pause)   		(void);
+  int8_t  (*Resume)   		(void);
+  int8_t  (*CommandMgr)     (uint8_t cmd);
+  int8_t  (*GetPosition)    (uint32_t *frames);   /* frames captured and not passed yet, may be NULL */
+  int8_t  (*SetFrequency)   (uint32_t AudioFreq); /* sampling frequency set by the host, with the stream stopped */
+}USBD_AUDIO_ItfTypeDef;
+/**
+* @}
+*/
+
+/** @defgroup USBD_AUDIO2_IN_Exported_Macros
+* @{
+*/
+
+/**
+* @}
+*/
+
+/** @defgroup USBD_AUDIO2_IN_Exported_Variables
+* @{
+*/
+
+extern USBD_ClassTypeDef  USBD_AUDIO;
+/**
+* @}
+*/
+
+/** @defgroup USBD_AUDIO2_IN_Exported_Functions
+* @{
+*/
+uint8_t  USBD_AUDIO_RegisterInterface  (USBD_HandleTypeDef   *pdev, USBD_AUDIO_ItfTypeDef *fops);
+uint8_t USBD_AUDIO_Init_Microphone_Descriptor(USBD_HandleTypeDef   *pdev, uint32_t samplingFrequency, uint8_t Channels);
+uint8_t USBD_AUDIO_Init_Microphone_Descriptor_Config(USBD_HandleTypeDef   *pdev, uint32_t samplingFrequency, uint8_t Channels, uint16_t ChannelConfig, uint8_t BitsPerSample);
+uint8_t  USBD_AUDIO_Data_Transfer (USBD_HandleTypeDef *pdev, int16_t * audioData, uint16_t dataAmount);
+uint8_t  USBD_AUDIO_Reserve (USBD_HandleTypeDef *pdev, uint16_t PCMSamples, int16_t **audioData);
+uint8_t  USBD_AUDIO_Commit (USBD_HandleTypeDef *pdev, uint16_t PCMSamples);
+uint8_t  USBD_AUDIO_Get_Stats (USBD_HandleTypeDef *pdev, USBD_AUDIO_StatsTypeDef *stats, uint8_t ResetPeaks);
+
+
+/**
+* @}
+*/
+
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+#endif  // __USBD_AUDIO2_IN_H_
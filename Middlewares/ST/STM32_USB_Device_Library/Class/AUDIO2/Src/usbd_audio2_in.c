@@ -0,0 +1,1349 @@
+/**
+  ******************************************************************************
+  * @file    usbd_audio2_in.c
+  * @author  SRA
+  * @brief   This file provides the Audio Class 2.0 Input core functions.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "usbd_audio2_in.h"
+#include "usbd_desc.h"
+#include "usbd_ctlreq.h"
+#ifdef USE_USB_TELEMETRY
+#include "usbd_telemetry.h"
+#endif
+
+#ifdef USE_USB_AUDIO_CLASS_2
+/* Built when usbd_conf.h selects it over the UAC1 class of Class/AUDIO */
+
+/** @addtogroup STM32_USB_OTG_DEVICE_LIBRARY
+* @{
+*/
+
+/** @defgroup USBD_AUDIO2_IN
+*
+* 	This file provides the Audio Class 2.0 Input core functions.
+*
+*           This driver implements the following aspects:
+*             - Configuration descriptor management, with an Interface
+*               Association Descriptor
+*             - Standard AC Interface Descriptor management
+*             - 1 Clock Source, programmable by the host
+*             - 1 Audio Streaming Interface
+*             - 1 Audio Streaming Endpoint
+*             - 1 Audio Terminal Input
+*             - Audio Class-Specific AC Interfaces
+*             - Audio Class-Specific AS Interfaces
+*             - AudioControl Requests: sampling frequency, clock validity,
+*               mute and volume, CUR and RANGE attributes
+*             - Audio Synchronization type: Asynchronous
+*             - Multiple frequencies and channel number configurable using ad hoc
+*               init function
+*
+*          The current audio class version supports the following audio features:
+*             - Pulse Coded Modulation (PCM) format
+*             - Sampling rate switched by the host among AUDIO2_IN_FREQUENCIES
+*             - Bit resolution: 16, 24 or 32
+*             - Configurable Number of channels, up to 8
+*             - Volume control
+*             - Mute/Unmute capability
+*             - Asynchronous Endpoints
+*
+* @note     This driver has been developed starting from the usbd_audio_in.c file
+*           and exports the same functions: only one of the two is built.
+*           The device runs at full speed, the packet size follows the 1 ms frame.
+* @{
+*/
+
+/** @defgroup USBD_AUDIO2_IN_Private_TypesDefinitions
+* @{
+*/
+/**
+* @}
+*/
+
+/** @defgroup USBD_AUDIO2_IN_Private_Defines
+* @{
+*/
+
+#ifdef USE_USB_TELEMETRY
+/* The telemetry interface follows the audio control and streaming interfaces */
+#define AUDIO_TELEMETRY_INTERFACE                     0x02
+#define AUDIO_TELEMETRY_DESC_SIZ                      TELEMETRY_DESC_SIZ
+#define AUDIO_NUM_INTERFACES                          0x03
+#else
+#define AUDIO_TELEMETRY_DESC_SIZ                      0
+#define AUDIO_NUM_INTERFACES                          0x02
+#endif
+
+/**
+* @}
+*/
+
+/** @defgroup USBD_AUDIO2_IN_Private_Macros
+* @{
+*/
+/**
+* @}
+*/
+
+/** @defgroup USBD_AUDIO2_IN_Private_FunctionPrototypes
+* @{
+*/
+static uint8_t  USBD_AUDIO_Init (USBD_HandleTypeDef *pdev, uint8_t cfgidx);
+static uint8_t  USBD_AUDIO_DeInit (USBD_HandleTypeDef *pdev, uint8_t cfgidx);
+static uint8_t  USBD_AUDIO_Setup (USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *req);
+static uint8_t  *USBD_AUDIO_GetCfgDesc (uint16_t *length);
+static uint8_t  *USBD_AUDIO_GetDeviceQualifierDesc (uint16_t *length);
+static uint8_t  USBD_AUDIO_DataIn (USBD_HandleTypeDef *pdev, uint8_t epnum);
+static uint8_t  USBD_AUDIO_DataOut (USBD_HandleTypeDef *pdev, uint8_t epnum);
+static uint8_t  USBD_AUDIO_EP0_RxReady (USBD_HandleTypeDef *pdev);
+static uint8_t  USBD_AUDIO_EP0_TxReady (USBD_HandleTypeDef *pdev);
+static uint8_t  USBD_AUDIO_SOF (USBD_HandleTypeDef *pdev);
+static uint8_t  USBD_AUDIO_IsoINIncomplete (USBD_HandleTypeDef *pdev, uint8_t epnum);
+static uint8_t  USBD_AUDIO_IsoOutIncomplete (USBD_HandleTypeDef *pdev, uint8_t epnum);
+static uint8_t AUDIO_REQ_Clock(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *req);
+static uint8_t AUDIO_REQ_FeatureUnit(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *req);
+static void AUDIO_REQ_SetCurrent(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *req);
+static uint8_t AUDIO_Set_Frequency(USBD_HandleTypeDef *pdev, uint32_t frequency);
+static uint8_t AUDIO_Ring_Setup(USBD_AUDIO_HandleTypeDef *haudio, uint16_t dataAmount);
+static uint16_t AUDIO_Fill_Level(USBD_AUDIO_HandleTypeDef *haudio);
+static void AUDIO_Timeout(USBD_HandleTypeDef *pdev, USBD_AUDIO_HandleTypeDef *haudio);
+static uint32_t AUDIO_Max_Packet(uint32_t frequency, uint8_t channels, uint8_t subframe);
+static void AUDIO_Put_Le32(uint8_t *pbuf, uint32_t value);
+
+/**
+* @}
+*/
+
+/** @defgroup USBD_AUDIO2_IN_Private_Variables
+* @{
+*/
+/* This dummy buffer with 0 values will be sent when there is no availble data */
+static uint8_t IsocInBuffDummy[AUDIO_IN_PACKET];
+static  int16_t VOL_CUR;
+static USBD_AUDIO_HandleTypeDef haudioInstance;
+/* Packet ring written in place by the application, followed by room for the
+   part of a packet straddling the end of the ring */
+__ALIGN_BEGIN static uint8_t IsocInRing[AUDIO_IN_RING_SIZE + AUDIO_IN_PACKET] __ALIGN_END;
+static const uint32_t AUDIO_Frequencies[] = AUDIO2_IN_FREQUENCIES;
+
+USBD_ClassTypeDef  USBD_AUDIO =
+{
+  USBD_AUDIO_Init,
+  USBD_AUDIO_DeInit,
+  USBD_AUDIO_Setup,
+  USBD_AUDIO_EP0_TxReady,
+  USBD_AUDIO_EP0_RxReady,
+  USBD_AUDIO_DataIn,
+  USBD_AUDIO_DataOut,
+  USBD_AUDIO_SOF,
+  USBD_AUDIO_IsoINIncomplete,
+  USBD_AUDIO_IsoOutIncomplete,
+  USBD_AUDIO_GetCfgDesc,
+  USBD_AUDIO_GetCfgDesc,
+  USBD_AUDIO_GetCfgDesc,
+  USBD_AUDIO_GetDeviceQualifierDesc,
+};
+
+/* USB AUDIO device Configuration Descriptor */
+/* NOTE: This descriptor has to be filled using the Descriptor Initialization function */
+__ALIGN_BEGIN static uint8_t USBD_AUDIO_CfgDesc[USB_AUDIO_CONFIG_DESC_SIZ + (8 * 4) + AUDIO_TELEMETRY_DESC_SIZ] __ALIGN_END;
+static uint16_t USBD_AUDIO_CfgDescLen;
+
+/* USB Standard Device Descriptor */
+__ALIGN_BEGIN static uint8_t USBD_AUDIO_DeviceQualifierDesc[USB_LEN_DEV_QUALIFIER_DESC] __ALIGN_END=
+{
+  USB_LEN_DEV_QUALIFIER_DESC,
+  USB_DESC_TYPE_DEVICE_QUALIFIER,
+  0x00,
+  0x02,
+  0xEF,
+  0x02,
+  0x01,
+  0x40,
+  0x01,
+  0x00,
+};
+
+/**
+* @}
+*/
+
+/** @defgroup USBD_AUDIO2_IN_Private_Functions
+* @{
+*/
+
+/**
+* @brief  USBD_AUDIO_Init
+*         Initialize the AUDIO interface
+* @param  pdev: device instance
+* @param  cfgidx: Configuration index
+* @retval status
+*/
+
+static uint8_t  USBD_AUDIO_Init (USBD_HandleTypeDef *pdev,
+                                 uint8_t cfgidx)
+{
+  if(haudioInstance.state!=STATE_USB_WAITING_FOR_INIT)
+  {
+    return USBD_FAIL;
+  }
+
+  USBD_AUDIO_HandleTypeDef   *haudio;
+  pdev->pClassData = &haudioInstance;
+  haudio = (USBD_AUDIO_HandleTypeDef *)pdev->pClassData;
+  haudio->rd_ptr = 0;
+  haudio->timeout = 0;
+
+  ((USBD_AUDIO_ItfTypeDef *)pdev->pUserData[pdev->classId])->Init(haudio->frequency,haudio->resolution,haudio->channels);
+
+  USBD_LL_OpenEP(pdev,
+                 AUDIO_IN_EP,
+                 USBD_EP_TYPE_ISOC,
+                 haudio->max_packet);
+
+  USBD_LL_FlushEP(pdev, AUDIO_IN_EP);
+
+
+  USBD_LL_Transmit(pdev, AUDIO_IN_EP,
+                   IsocInBuffDummy,
+                   haudio->paketDimension);
+
+#ifdef USE_USB_TELEMETRY
+  USBD_TELEMETRY_Init(pdev);
+#endif
+  haudio->state=STATE_USB_IDLE;
+  return USBD_OK;
+}
+
+/**
+* @brief  USBD_AUDIO_Init
+*         DeInitialize the AUDIO layer
+* @param  pdev: device instance
+* @param  cfgidx: Configuration index
+* @retval status
+*/
+static uint8_t  USBD_AUDIO_DeInit (USBD_HandleTypeDef *pdev,
+                                   uint8_t cfgidx)
+{
+  /* Close EP IN */
+  USBD_LL_CloseEP(pdev,AUDIO_IN_EP);
+#ifdef USE_USB_TELEMETRY
+  USBD_TELEMETRY_DeInit(pdev);
+#endif
+  /* DeInit  physical Interface components */
+  if(pdev->pClassData != NULL)
+  {
+    ((USBD_AUDIO_ItfTypeDef *)pdev->pUserData[pdev->classId])->DeInit(0);
+    haudioInstance.state = STATE_USB_WAITING_FOR_INIT;
+  }
+  return USBD_OK;
+}
+
+/**
+* @brief  USBD_AUDIO_Setup
+*         Handle the AUDIO specific requests
+* @param  pdev: instance
+* @param  req: usb requests
+* @retval status
+*/
+static uint8_t  USBD_AUDIO_Setup (USBD_HandleTypeDef *pdev,
+                                  USBD_SetupReqTypedef *req)
+{
+  USBD_AUDIO_HandleTypeDef   *haudio;
+  uint8_t ret = USBD_OK;
+  haudio = pdev->pClassData;
+
+  switch (req->bmRequest & USB_REQ_TYPE_MASK)
+  {
+    /* AUDIO Class Requests -------------------------------*/
+  case USB_REQ_TYPE_CLASS :
+    /* Requests are addressed to the entity in the high byte of wIndex */
+    switch (HIBYTE(req->wIndex))
+    {
+    case MIC_CLOCK_SOURCE_ID:
+      ret = AUDIO_REQ_Clock(pdev, req);
+      break;
+
+    case MIC_FU_ID:
+      ret = AUDIO_REQ_FeatureUnit(pdev, req);
+      break;
+
+    default:
+      ret = USBD_FAIL;
+      break;
+    }
+    if (ret != USBD_OK)
+    {
+      USBD_CtlError (pdev, req);
+    }
+    break;
+
+    /* Standard Requests -------------------------------*/
+  case USB_REQ_TYPE_STANDARD:
+    switch (req->bRequest)
+    {
+    case USB_REQ_GET_INTERFACE :
+      USBD_CtlSendData (pdev,
+                        (uint8_t *)&haudio->alt_setting,
+                        1);
+      break;
+
+    case USB_REQ_SET_INTERFACE :
+#ifdef USE_USB_TELEMETRY
+      if (LOBYTE(req->wIndex) == AUDIO_TELEMETRY_INTERFACE)
+      {
+        /* Single alternate setting, nothing to switch */
+      }
+      else
+#endif
+      if ((uint8_t)(req->wValue) < USBD_MAX_NUM_INTERFACES)
+      {
+        haudio->alt_setting = (uint8_t)(req->wValue);
+      }
+      else
+      {
+        /* Call the error management function (command will be nacked */
+        USBD_CtlError (pdev, req);
+      }
+      break;
+    }
+  }
+  return ret;
+}
+
+/**
+* @brief  USBD_AUDIO_GetCfgDesc
+*         return configuration descriptor
+* @param  length : pointer data length
+* @retval pointer to descriptor buffer
+*/
+static uint8_t  *USBD_AUDIO_GetCfgDesc (uint16_t *length)
+{
+  *length = USBD_AUDIO_CfgDescLen;
+  return USBD_AUDIO_CfgDesc;
+}
+
+/**
+* @brief  USBD_AUDIO_DataIn
+*         handle data IN Stage
+* @param  pdev: device instance
+* @param  epnum: endpoint index
+* @retval status
+*/
+static uint8_t USBD_AUDIO_DataIn (USBD_HandleTypeDef *pdev,
+                                  uint8_t epnum)
+{
+
+  USBD_AUDIO_HandleTypeDef   *haudio;
+  haudio = pdev->pClassData;
+  uint32_t length_usb_pck;
+  uint16_t app;
+  uint16_t wrap;
+  uint16_t frames;
+  uint16_t nominal;
+  uint8_t underrun;
+  uint16_t true_dim = haudio->buffer_length;
+  uint16_t frame_dim = haudio->channels * haudio->subframe;
+  uint32_t start = DWT->CYCCNT;
+  length_usb_pck = haudio->paketDimension;
+#ifdef USE_USB_TELEMETRY
+  if (epnum == (TELEMETRY_IN_EP & 0x7F))
+  {
+    USBD_TELEMETRY_DataIn(pdev);
+    return USBD_OK;
+  }
+#endif
+  haudio->timeout=0;
+  if (epnum == (AUDIO_IN_EP & 0x7F))
+  {
+    if (haudio->state == STATE_USB_IDLE)
+    {
+      haudio->state=STATE_USB_REQUESTS_STARTED;
+      ((USBD_AUDIO_ItfTypeDef *)pdev->pUserData[pdev->classId])->Record();
+    }
+    if (haudio->state == STATE_USB_BUFFER_WRITE_STARTED)
+    {
+      app = AUDIO_Fill_Level(haudio);
+      haudio->stats.packets++;
+      if((app / frame_dim) < haudio->stats.fill_min){
+        haudio->stats.fill_min = app / frame_dim;
+      }
+      if((app / frame_dim) > haudio->stats.fill_max){
+        haudio->stats.fill_max = app / frame_dim;
+      }
+      /* Asynchronous endpoint: the packet carries the frames produced in the
+         last frame period, as measured on SOF, the fraction is carried over */
+      nominal = haudio->paketDimension / frame_dim;
+      haudio->frac += haudio->rate;
+      frames = (uint16_t)haudio->frac;
+      if(frames > nominal + 1){
+        frames = nominal + 1;
+      }else if(frames + 1 < nominal){
+        frames = nominal - 1;
+      }
+      haudio->frac -= (float)frames;
+      if(frames > nominal){
+        haudio->stats.long_packets++;
+      }else if(frames < nominal){
+        haudio->stats.short_packets++;
+      }
+      length_usb_pck = frames * frame_dim;
+      underrun = (app < haudio->buffer_length/10);
+      if(app < length_usb_pck){
+        /* Less than a packet left: the slice would pass the write pointer */
+        underrun = 1;
+        USBD_LL_Transmit (pdev,AUDIO_IN_EP,
+                          IsocInBuffDummy,
+                          length_usb_pck);
+      }else{
+        /* Packets are slices of the ring: only the bytes of a packet crossing the
+           end of the ring, once per ring cycle at most, are copied after it */
+        if((haudio->rd_ptr + length_usb_pck) > true_dim){
+          wrap = (haudio->rd_ptr + length_usb_pck) - true_dim;
+          memcpy(&haudio->buffer[true_dim], haudio->buffer, wrap);
+        }
+        USBD_LL_Transmit (pdev,AUDIO_IN_EP,
+                          (uint8_t*)(&haudio->buffer[haudio->rd_ptr]),
+                          length_usb_pck);
+        haudio->rd_ptr += length_usb_pck;
+        if(haudio->rd_ptr >= true_dim){
+          haudio->rd_ptr -= true_dim;
+        }
+      }
+
+      if(underrun)
+      {
+        haudio->stats.underruns++;
+        ((USBD_AUDIO_ItfTypeDef *)pdev->pUserData[pdev->classId])->Stop();
+        haudio->state = STATE_USB_IDLE;
+        haudio->timeout=0;
+        memset(haudio->buffer,0,haudio->buffer_length);
+      }
+    }
+    else
+    {
+      haudio->stats.dummy_packets++;
+      USBD_LL_Transmit (pdev,AUDIO_IN_EP,
+                        IsocInBuffDummy,
+                        length_usb_pck);
+    }
+    if((DWT->CYCCNT - start) > haudio->stats.cycles_max){
+      haudio->stats.cycles_max = DWT->CYCCNT - start;
+    }
+  }
+  return USBD_OK;
+}
+
+/**
+* @brief  USBD_AUDIO_EP0_RxReady
+*         handle EP0 Rx Ready event
+* @param  pdev: device instance
+* @retval status
+*/
+
+static uint8_t  USBD_AUDIO_EP0_RxReady (USBD_HandleTypeDef *pdev)
+{
+  USBD_AUDIO_HandleTypeDef   *haudio;
+  USBD_AUDIO_ItfTypeDef      *itf;
+  haudio = pdev->pClassData;
+  itf = (USBD_AUDIO_ItfTypeDef *)pdev->pUserData[pdev->classId];
+  uint32_t frequency;
+
+  if (haudio->control.cmd == AUDIO_REQ_CUR)
+  {
+    if (haudio->control.unit == MIC_CLOCK_SOURCE_ID)
+    {
+      frequency = (uint32_t)haudio->control.data[0] | ((uint32_t)haudio->control.data[1] << 8) |
+                  ((uint32_t)haudio->control.data[2] << 16) | ((uint32_t)haudio->control.data[3] << 24);
+      (void)AUDIO_Set_Frequency(pdev, frequency);
+    }
+    else if (haudio->control.selector == AUDIO_FU_MUTE_CONTROL)
+    {
+      haudio->mute = haudio->control.data[0];
+      itf->MuteCtl(haudio->mute);
+    }
+    else
+    {
+      VOL_CUR = (int16_t)((uint16_t)haudio->control.data[0] | ((uint16_t)haudio->control.data[1] << 8));
+      itf->VolumeCtl(VOL_CUR);
+    }
+    haudio->control.cmd = 0;
+    haudio->control.len = 0;
+    haudio->control.unit = 0;
+    haudio->control.selector = 0;
+  }
+  return USBD_OK;
+}
+/**
+* @brief  USBD_AUDIO_EP0_TxReady
+*         handle EP0 TRx Ready event
+* @param  pdev: device instance
+* @retval status
+*/
+static uint8_t  USBD_AUDIO_EP0_TxReady (USBD_HandleTypeDef *pdev)
+{
+  /* Only OUT control data are processed */
+  return USBD_OK;
+}
+/**
+* @brief  USBD_AUDIO_SOF
+*         handle SOF event
+* @param  pdev: device instance
+* @retval status
+*/
+static uint8_t  USBD_AUDIO_SOF (USBD_HandleTypeDef *pdev)
+{
+  USBD_AUDIO_HandleTypeDef   *haudio;
+  USBD_AUDIO_ItfTypeDef      *itf;
+  haudio = pdev->pClassData;
+  itf = (USBD_AUDIO_ItfTypeDef *)pdev->pUserData[pdev->classId];
+  uint32_t pending = 0;
+  float nominal;
+  float error;
+  float deviation;
+
+  if((haudio != NULL) && (haudio->state == STATE_USB_BUFFER_WRITE_STARTED))
+  {
+    /* The fill level seen at each SOF, plus the frames already captured for the
+       next block, measures the producer rate against the host frame clock */
+    if((itf->GetPosition != NULL) && (itf->GetPosition(&pending) != 0))
+    {
+      pending = 0;
+    }
+    haudio->fill_acc += (float)(AUDIO_Fill_Level(haudio) / (haudio->channels * haudio->subframe)) + (float)pending;
+    if(++haudio->sof_count == AUDIO_IN_SYNC_PERIOD)
+    {
+      /* Set point: half a ring, where the writer starts, plus the block being
+         captured. The ring alone then holds half a ring to one block more,
+         less the interrupt latency, with blocks of headroom on either side */
+      nominal = (float)(haudio->paketDimension / (haudio->channels * haudio->subframe));
+      error = ((haudio->fill_acc / AUDIO_IN_SYNC_PERIOD) - (float)(((AUDIO_IN_PACKET_NUM/2) + 1) * haudio->dataAmount / (haudio->channels * haudio->subframe))) / nominal;
+      haudio->integrator += AUDIO_IN_SYNC_KI * error;
+      if(haudio->integrator > AUDIO_IN_SYNC_MAX_DEVIATION)
+      {
+        haudio->integrator = AUDIO_IN_SYNC_MAX_DEVIATION;
+      }
+      else if(haudio->integrator < -AUDIO_IN_SYNC_MAX_DEVIATION)
+      {
+        haudio->integrator = -AUDIO_IN_SYNC_MAX_DEVIATION;
+      }
+      deviation = haudio->integrator + (AUDIO_IN_SYNC_KP * error);
+      if(deviation > AUDIO_IN_SYNC_MAX_DEVIATION)
+      {
+        deviation = AUDIO_IN_SYNC_MAX_DEVIATION;
+      }
+      else if(deviation < -AUDIO_IN_SYNC_MAX_DEVIATION)
+      {
+        deviation = -AUDIO_IN_SYNC_MAX_DEVIATION;
+      }
+      haudio->rate = nominal * (1.0f + deviation);
+      haudio->fill_acc = 0.0f;
+      haudio->sof_count = 0;
+    }
+  }
+#ifdef USE_USB_TELEMETRY
+  USBD_TELEMETRY_SOF(pdev);
+#endif
+  return USBD_OK;
+}
+
+
+/**
+* @brief  USBD_AUDIO_IsoINIncomplete
+*         handle data ISO IN Incomplete event
+* @param  pdev: device instance
+* @param  epnum: endpoint index
+* @retval status
+*/
+static uint8_t  USBD_AUDIO_IsoINIncomplete (USBD_HandleTypeDef *pdev, uint8_t epnum)
+{
+  return USBD_OK;
+}
+/**
+* @brief  USBD_AUDIO_IsoOutIncomplete
+*         handle data ISO OUT Incomplete event
+* @param  pdev: device instance
+* @param  epnum: endpoint index
+* @retval status
+*/
+static uint8_t  USBD_AUDIO_IsoOutIncomplete (USBD_HandleTypeDef *pdev, uint8_t epnum)
+{
+  return USBD_OK;
+}
+/**
+* @brief  USBD_AUDIO_DataOut
+*         handle data OUT Stage
+* @param  pdev: device instance
+* @param  epnum: endpoint index
+* @retval status
+*/
+static uint8_t  USBD_AUDIO_DataOut (USBD_HandleTypeDef *pdev,
+                                    uint8_t epnum)
+{
+#ifdef USE_USB_TELEMETRY
+  if (epnum == (TELEMETRY_OUT_EP & 0x7F))
+  {
+    USBD_TELEMETRY_DataOut(pdev);
+  }
+#endif
+  return USBD_OK;
+}
+
+/**
+* @brief  DeviceQualifierDescriptor
+*         return Device Qualifier descriptor
+* @param  length : pointer data length
+* @retval pointer to descriptor buffer
+*/
+static uint8_t  *USBD_AUDIO_GetDeviceQualifierDesc (uint16_t *length)
+{
+  *length = sizeof (USBD_AUDIO_DeviceQualifierDesc);
+  return USBD_AUDIO_DeviceQualifierDesc;
+}
+
+/**
+* @brief  AUDIO_REQ_Clock
+*         Handles the requests to the clock source: sampling frequency
+*         (CUR and RANGE) and clock validity (CUR).
+* @param  pdev: instance
+* @param  req: setup class request
+* @retval status
+*/
+static uint8_t AUDIO_REQ_Clock(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *req)
+{
+  USBD_AUDIO_HandleTypeDef   *haudio;
+  haudio = pdev->pClassData;
+  uint8_t *pbuf = haudio->control.data;
+  uint16_t len = 0;
+  uint8_t i;
+
+  if((req->bmRequest & 0x80U) == 0U)
+  {
+    if((req->bRequest != AUDIO_REQ_CUR) || (HIBYTE(req->wValue) != AUDIO_CS_SAM_FREQ_CONTROL) || (req->wLength != 4U))
+    {
+      return USBD_FAIL;
+    }
+    AUDIO_REQ_SetCurrent(pdev, req);
+    return USBD_OK;
+  }
+
+  switch (HIBYTE(req->wValue))
+  {
+  case AUDIO_CS_SAM_FREQ_CONTROL:
+    if(req->bRequest == AUDIO_REQ_CUR)
+    {
+      AUDIO_Put_Le32(pbuf, haudio->frequency);
+      len = 4;
+    }
+    else if(req->bRequest == AUDIO_REQ_RANGE)
+    {
+      /* One discrete subrange, MIN = MAX and RES = 0, per frequency */
+      pbuf[0] = haudio->freq_num;
+      pbuf[1] = 0;
+      len = 2;
+      for(i = 0; i < haudio->freq_num; i++)
+      {
+        AUDIO_Put_Le32(&pbuf[len], haudio->freq_list[i]);
+        AUDIO_Put_Le32(&pbuf[len + 4], haudio->freq_list[i]);
+        AUDIO_Put_Le32(&pbuf[len + 8], 0);
+        len += 12;
+      }
+    }
+    break;
+
+  case AUDIO_CS_CLOCK_VALID_CONTROL:
+    if(req->bRequest == AUDIO_REQ_CUR)
+    {
+      pbuf[0] = 1;
+      len = 1;
+    }
+    break;
+
+  default:
+    break;
+  }
+
+  if(len == 0)
+  {
+    return USBD_FAIL;
+  }
+  USBD_CtlSendData (pdev,
+                    pbuf,
+                    MIN(len, req->wLength));
+  return USBD_OK;
+}
+
+/**
+* @brief  AUDIO_REQ_FeatureUnit
+*         Handles the requests to the feature unit: mute (CUR) and volume
+*         (CUR and RANGE) of the master channel.
+* @param  pdev: instance
+* @param  req: setup class request
+* @retval status
+*/
+static uint8_t AUDIO_REQ_FeatureUnit(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *req)
+{
+  USBD_AUDIO_HandleTypeDef   *haudio;
+  haudio = pdev->pClassData;
+  uint8_t *pbuf = haudio->control.data;
+  uint8_t selector = HIBYTE(req->wValue);
+  uint16_t len = 0;
+
+  if(((selector != AUDIO_FU_MUTE_CONTROL) && (selector != AUDIO_FU_VOLUME_CONTROL)) || (LOBYTE(req->wValue) != 0U))
+  {
+    return USBD_FAIL;
+  }
+
+  if((req->bmRequest & 0x80U) == 0U)
+  {
+    if((req->bRequest != AUDIO_REQ_CUR) || (req->wLength != ((selector == AUDIO_FU_MUTE_CONTROL) ? 1U : 2U)))
+    {
+      return USBD_FAIL;
+    }
+    AUDIO_REQ_SetCurrent(pdev, req);
+    return USBD_OK;
+  }
+
+  if(req->bRequest == AUDIO_REQ_CUR)
+  {
+    if(selector == AUDIO_FU_MUTE_CONTROL)
+    {
+      pbuf[0] = haudio->mute;
+      len = 1;
+    }
+    else
+    {
+      pbuf[0] = (uint16_t)VOL_CUR & 0xFF;
+      pbuf[1] = ((uint16_t)VOL_CUR & 0xFF00 ) >> 8;
+      len = 2;
+    }
+  }
+  else if((req->bRequest == AUDIO_REQ_RANGE) && (selector == AUDIO_FU_VOLUME_CONTROL))
+  {
+    pbuf[0] = 1;
+    pbuf[1] = 0;
+    pbuf[2] = (uint16_t)VOL_MIN & 0xFF;
+    pbuf[3] = ((uint16_t)VOL_MIN & 0xFF00 ) >> 8;
+    pbuf[4] = (uint16_t)VOL_MAX & 0xFF;
+    pbuf[5] = ((uint16_t)VOL_MAX & 0xFF00 ) >> 8;
+    pbuf[6] = (uint16_t)VOL_RES & 0xFF;
+    pbuf[7] = ((uint16_t)VOL_RES & 0xFF00 ) >> 8;
+    len = 8;
+  }
+
+  if(len == 0)
+  {
+    return USBD_FAIL;
+  }
+  USBD_CtlSendData (pdev,
+                    pbuf,
+                    MIN(len, req->wLength));
+  return USBD_OK;
+}
+
+/**
+* @brief  AUDIO_Req_SetCurrent
+*         Handles the SET CUR Audio control request, the value is applied
+*         on EP0 Rx Ready.
+* @param  pdev: instance
+* @param  req: setup class request
+* @retval status
+*/
+static void AUDIO_REQ_SetCurrent(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *req)
+{
+  USBD_AUDIO_HandleTypeDef   *haudio;
+  haudio = pdev->pClassData;
+  if (req->wLength)
+  {
+    /* Prepare the reception of the buffer over EP0 */
+    USBD_CtlPrepareRx (pdev,
+                       haudio->control.data,
+                       req->wLength);
+
+    haudio->control.cmd = AUDIO_REQ_CUR;           /* Set the request value */
+    haudio->control.len = req->wLength;            /* Set the request data length */
+    haudio->control.unit = HIBYTE(req->wIndex);    /* Set the request target unit */
+    haudio->control.selector = HIBYTE(req->wValue);/* Set the request control selector */
+  }
+}
+
+/**
+* @brief  AUDIO_Set_Frequency
+*         Switches the stream to a sampling frequency offered by the clock
+*         source. The stream is stopped, it restarts with the next block
+*         passed by the application at the new frequency.
+* @param  pdev: instance
+* @param  frequency: sampling frequency, in Hz
+* @retval status
+*/
+static uint8_t AUDIO_Set_Frequency(USBD_HandleTypeDef *pdev, uint32_t frequency)
+{
+  USBD_AUDIO_HandleTypeDef   *haudio;
+  USBD_AUDIO_ItfTypeDef      *itf;
+  haudio = pdev->pClassData;
+  itf = (USBD_AUDIO_ItfTypeDef *)pdev->pUserData[pdev->classId];
+  uint8_t i;
+
+  if(frequency == haudio->frequency)
+  {
+    return USBD_OK;
+  }
+  for(i = 0; i < haudio->freq_num; i++)
+  {
+    if(haudio->freq_list[i] == frequency)
+    {
+      break;
+    }
+  }
+  /* The list only holds frequencies whose packets fit the endpoint, the check
+     keeps a request from ever opening a larger one */
+  if((i == haudio->freq_num) || (itf->SetFrequency == NULL) ||
+     (AUDIO_Max_Packet(frequency, haudio->channels, haudio->subframe) > haudio->max_packet))
+  {
+    return USBD_FAIL;
+  }
+
+  if(haudio->state > STATE_USB_IDLE)
+  {
+    itf->Stop();
+    haudio->state = STATE_USB_IDLE;
+    haudio->timeout = 0;
+  }
+  if(itf->SetFrequency(frequency) != 0)
+  {
+    return USBD_FAIL;
+  }
+  haudio->frequency = frequency;
+  haudio->paketDimension = (frequency/1000*haudio->channels*haudio->subframe);
+  haudio->dataAmount = 0;
+  return USBD_OK;
+}
+
+/**
+* @brief  AUDIO_Ring_Setup
+*         Lays out the static packet ring for the block size passed by the
+*         application. The ring is never reallocated: a block size that does not
+*         fit in AUDIO_IN_RING_SIZE is rejected.
+* @param  haudio: audio handle
+* @param  dataAmount: block size in bytes
+* @retval status
+*/
+static uint8_t AUDIO_Ring_Setup(USBD_AUDIO_HandleTypeDef *haudio, uint16_t dataAmount)
+{
+  if((dataAmount == 0) || (((uint32_t)dataAmount * AUDIO_IN_RING_BLOCKS) > AUDIO_IN_RING_SIZE))
+  {
+    return USBD_FAIL;
+  }
+
+  /* Blocks tile the ring, the writer starts half a ring ahead of the reader */
+  haudio->dataAmount = dataAmount;
+  haudio->buffer_length = dataAmount * AUDIO_IN_RING_BLOCKS;
+  haudio->wr_ptr = (AUDIO_IN_PACKET_NUM/2) * dataAmount;
+  haudio->dropping = 0;
+  haudio->rd_ptr = 0;
+  haudio->buffer = IsocInRing;
+  memset(haudio->buffer,0,haudio->buffer_length);
+  haudio->rate = (float)(haudio->paketDimension / (haudio->channels * haudio->subframe));
+  haudio->frac = 0.0f;
+  haudio->integrator = 0.0f;
+  haudio->fill_acc = 0.0f;
+  haudio->sof_count = 0;
+
+  return USBD_OK;
+}
+
+/**
+* @brief  AUDIO_Fill_Level
+*         Bytes written in the ring and not read yet
+* @param  haudio: audio handle
+* @retval fill level, in bytes
+*/
+static uint16_t AUDIO_Fill_Level(USBD_AUDIO_HandleTypeDef *haudio)
+{
+  if(haudio->wr_ptr < haudio->rd_ptr){
+    return (haudio->buffer_length - haudio->rd_ptr) + haudio->wr_ptr;
+  }
+  return haudio->wr_ptr - haudio->rd_ptr;
+}
+
+/**
+* @brief  AUDIO_Timeout
+*         Counts the blocks passed by the application since the host last read
+*         a packet and stops the stream when the host no longer reads
+* @param  pdev: device instance
+* @param  haudio: audio handle
+* @retval None
+*/
+static void AUDIO_Timeout(USBD_HandleTypeDef *pdev, USBD_AUDIO_HandleTypeDef *haudio)
+{
+  if(haudio->timeout++==TIMEOUT_VALUE){
+    haudio->stats.timeouts++;
+    haudio->state=STATE_USB_IDLE;
+    ((USBD_AUDIO_ItfTypeDef *)pdev->pUserData[pdev->classId])->Stop();
+    haudio->timeout=0;
+  }
+}
+
+/**
+* @brief  AUDIO_Max_Packet
+*         Largest packet of a format: the asynchronous endpoint sends one frame
+*         more than nominal to follow a faster capture clock
+* @param  frequency: sampling frequency, in Hz
+* @param  channels: number of channels
+* @param  subframe: bytes per sample
+* @retval packet size, in bytes
+*/
+static uint32_t AUDIO_Max_Packet(uint32_t frequency, uint8_t channels, uint8_t subframe)
+{
+  return ((frequency / 1000U) + 1U) * channels * subframe;
+}
+
+/**
+* @brief  AUDIO_Put_Le32
+*         Writes a 32 bits request parameter, little endian
+* @param  pbuf: destination
+* @param  value: parameter
+* @retval None
+*/
+static void AUDIO_Put_Le32(uint8_t *pbuf, uint32_t value)
+{
+  pbuf[0] = (uint8_t)value;
+  pbuf[1] = (uint8_t)(value >> 8);
+  pbuf[2] = (uint8_t)(value >> 16);
+  pbuf[3] = (uint8_t)(value >> 24);
+}
+
+/**
+* @}
+*/
+
+/** @defgroup USBD_AUDIO2_IN_Exported_Functions
+* @{
+*/
+
+/**
+* @brief  USBD_AUDIO_Data_Transfer
+*         Fills the USB internal buffer with audio data from user
+* @param pdev: device instance
+* @param audioData: audio data to be sent via USB
+* @param dataAmount: number of PCM samples to be copyed
+* @note Depending on the calling frequency, a coherent amount of samples must be passed to
+*       the function. E.g.: assuming a Sampling frequency of 16 KHz and 1 channel,
+*       you can pass 16 PCM samples if the function is called each millisecond,
+*       32 samples if called every 2 milliseconds and so on. The sampling
+*       frequency is the one last set by the host.
+* @retval status
+*/
+uint8_t  USBD_AUDIO_Data_Transfer(USBD_HandleTypeDef *pdev, int16_t * audioData, uint16_t PCMSamples)
+{
+  int16_t *pRing = NULL;
+  uint8_t ret = USBD_AUDIO_Reserve(pdev, PCMSamples, &pRing);
+
+  if(pRing != NULL){
+    memcpy((uint8_t *)pRing, (uint8_t *)(audioData), PCMSamples * haudioInstance.subframe);
+    ret = USBD_AUDIO_Commit(pdev, PCMSamples);
+  }
+  return ret;
+}
+
+/**
+* @brief  USBD_AUDIO_Reserve
+*         Hands out the next block of the packet ring, to be written in place
+*         by the application and then released with USBD_AUDIO_Commit
+* @param pdev: device instance
+* @param PCMSamples: number of PCM samples of the block
+* @param audioData: returns the block, NULL when the host is not streaming or the
+*       ring has no room for it. Samples are in the stream format: 16 bits, 24 bits
+*       packed in 3 bytes or 32 bits.
+* @note The block size is the one passed to USBD_AUDIO_Data_Transfer: the ring
+*       is laid out again, not reallocated, when it changes.
+* @retval status: USBD_BUSY when the block is dropped on an overrun
+*/
+uint8_t  USBD_AUDIO_Reserve(USBD_HandleTypeDef *pdev, uint16_t PCMSamples, int16_t **audioData)
+{
+
+  USBD_AUDIO_HandleTypeDef   *haudio;
+  haudio = (USBD_AUDIO_HandleTypeDef *)pdev->pClassData;
+  uint16_t dataAmount = PCMSamples * haudioInstance.subframe; /*Bytes*/
+
+  *audioData = NULL;
+  if(haudioInstance.state==STATE_USB_WAITING_FOR_INIT){
+    return USBD_BUSY;
+  }
+
+  if(haudio->state==STATE_USB_REQUESTS_STARTED  ||
+     (haudio->state==STATE_USB_BUFFER_WRITE_STARTED && haudio->dataAmount!=dataAmount)){
+    if(AUDIO_Ring_Setup(haudio, dataAmount) != USBD_OK)
+    {
+      return USBD_FAIL;
+    }
+    haudio->state=STATE_USB_BUFFER_WRITE_STARTED;
+  }
+
+  if(haudio->state==STATE_USB_BUFFER_WRITE_STARTED){
+    /* The block would overwrite frames not sent yet when the host reads slower than the application
+       writes. The packet in flight, one frame longer than nominal at most, is kept too, and one frame
+       more: a ring filled up to the read pointer would read as empty */
+    uint16_t fill = AUDIO_Fill_Level(haudio);
+    uint16_t free_space = haudio->buffer_length - fill - haudio->paketDimension
+                          - (2U * haudio->channels * haudio->subframe);
+
+    /* The block is dropped rather than written over frames not sent yet. Blocks are
+       dropped until the ring is back to the set point, half a ring, so that the stream
+       resumes with a single gap and its nominal latency */
+    if(free_space < dataAmount){
+      haudio->dropping = 1;
+    }else if(fill <= ((AUDIO_IN_PACKET_NUM/2) * dataAmount)){
+      haudio->dropping = 0;
+    }
+    if(haudio->dropping){
+      haudio->stats.overruns++;
+      AUDIO_Timeout(pdev, haudio);
+      return USBD_BUSY;
+    }
+    *audioData = (int16_t *)&haudio->buffer[haudio->wr_ptr];
+  }
+  return USBD_OK;
+}
+
+/**
+* @brief  USBD_AUDIO_Commit
+*         Releases to USB the block returned by USBD_AUDIO_Reserve
+* @param pdev: device instance
+* @param PCMSamples: number of PCM samples of the block
+* @retval status
+*/
+uint8_t  USBD_AUDIO_Commit(USBD_HandleTypeDef *pdev, uint16_t PCMSamples)
+{
+
+  USBD_AUDIO_HandleTypeDef   *haudio;
+  haudio = (USBD_AUDIO_HandleTypeDef *)pdev->pClassData;
+  uint16_t dataAmount = PCMSamples * haudioInstance.subframe; /*Bytes*/
+
+  if(haudioInstance.state!=STATE_USB_BUFFER_WRITE_STARTED){
+    return USBD_BUSY;
+  }
+  if(haudio->dataAmount!=dataAmount){
+    return USBD_FAIL;
+  }
+
+  AUDIO_Timeout(pdev, haudio);
+  haudio->wr_ptr += dataAmount;
+  if(haudio->wr_ptr >= haudio->buffer_length){
+    haudio->wr_ptr = 0;
+  }
+  return USBD_OK;
+}
+
+
+/**
+* @brief  USBD_AUDIO_Get_Stats
+*         Returns the statistics of the stream. The counters run from the
+*         descriptor initialization, the peaks from the last reset.
+* @param pdev: device instance
+* @param stats: filled with the statistics
+* @param ResetPeaks: non-zero to restart the fill level and cycles peaks
+* @retval status
+* @note   The statistics are updated by the USB and the audio interrupts: they
+*         are copied, and the peaks reset, with the interrupts masked so that
+*         the copy is consistent and no peak is lost between copy and reset.
+*/
+uint8_t  USBD_AUDIO_Get_Stats(USBD_HandleTypeDef *pdev, USBD_AUDIO_StatsTypeDef *stats, uint8_t ResetPeaks)
+{
+  uint32_t primask;
+  
+  primask = __get_PRIMASK();
+  __disable_irq();
+  *stats = haudioInstance.stats;
+  if(ResetPeaks != 0){
+    haudioInstance.stats.fill_min = 0xFFFF;
+    haudioInstance.stats.fill_max = 0;
+    haudioInstance.stats.cycles_max = 0;
+  }
+  __set_PRIMASK(primask);
+  return USBD_OK;
+}
+
+/**
+* @brief  USBD_AUDIO_RegisterInterface
+* @param  fops: Audio interface callback
+* @retval status
+*/
+uint8_t  USBD_AUDIO_RegisterInterface  (USBD_HandleTypeDef   *pdev,
+                                        USBD_AUDIO_ItfTypeDef *fops)
+{
+  if(fops != NULL)
+  {
+    pdev->pUserData[0]= fops;
+  }
+  return 0;}
+
+/**
+* @brief  Configures the microphone descriptor on the base of the frequency
+*         and channels number informations. These parameters will be used to
+*         init the audio engine, trough the USB interface functions.
+* @param  samplingFrequency: sampling frequency
+* @param  Channels: number of channels
+* @retval status
+*/
+uint8_t USBD_AUDIO_Init_Microphone_Descriptor(USBD_HandleTypeDef   *pdev, uint32_t samplingFrequency, uint8_t Channels)
+{
+  return USBD_AUDIO_Init_Microphone_Descriptor_Config(pdev, samplingFrequency, Channels, (Channels == 2) ? 0x0003 : 0x0000, 16);
+}
+
+/**
+* @brief  Configures the microphone descriptor as USBD_AUDIO_Init_Microphone_Descriptor,
+*         with the spatial locations of the channels given by the application.
+* @param  samplingFrequency: sampling frequency at start up, the highest one
+*         offered to the host
+* @param  Channels: number of channels, up to 8
+* @param  ChannelConfig: bmChannelConfig of the input terminal, 0x0000 for channels
+*         without a spatial location (raw microphones, beams)
+* @param  BitsPerSample: 16, 24 (packed in 3 bytes) or 32 (24 significant bits,
+*         left-justified)
+* @retval status: USBD_FAIL when a packet of the format exceeds AUDIO_IN_PACKET_MAX,
+*         the class then refuses to start
+*/
+uint8_t USBD_AUDIO_Init_Microphone_Descriptor_Config(USBD_HandleTypeDef   *pdev, uint32_t samplingFrequency, uint8_t Channels, uint16_t ChannelConfig, uint8_t BitsPerSample)
+{
+  uint16_t index;
+  uint16_t max_packet;
+  uint8_t subframe = BitsPerSample / 8;
+  uint8_t ch;
+  uint8_t i;
+
+  haudioInstance.freq_num = 0;
+  if((Channels == 0) || (Channels > 8) ||
+     (AUDIO_Max_Packet(samplingFrequency, Channels, subframe) > AUDIO_IN_PACKET_MAX))
+  {
+    haudioInstance.state = STATE_USB_FORMAT_REJECTED;
+    return USBD_FAIL;
+  }
+
+  /* Frequencies offered by the clock source, in ascending order: the ones
+     below the start up frequency whose packets fit the endpoint, then the start
+     up frequency itself */
+  for(i = 0; i < (sizeof(AUDIO_Frequencies) / sizeof(AUDIO_Frequencies[0])); i++)
+  {
+    if((AUDIO_Frequencies[i] < samplingFrequency) && (haudioInstance.freq_num < (AUDIO2_IN_MAX_FREQUENCIES - 1)) &&
+       (AUDIO_Max_Packet(AUDIO_Frequencies[i], Channels, subframe) <= AUDIO_IN_PACKET_MAX))
+    {
+      haudioInstance.freq_list[haudioInstance.freq_num++] = AUDIO_Frequencies[i];
+    }
+  }
+  haudioInstance.freq_list[haudioInstance.freq_num++] = samplingFrequency;
+  max_packet = (uint16_t)AUDIO_Max_Packet(samplingFrequency, Channels, subframe);
+  USBD_AUDIO_CfgDescLen = USB_AUDIO_CONFIG_DESC_SIZ + (Channels * 4) + AUDIO_TELEMETRY_DESC_SIZ;
+
+  USBD_AUDIO_CfgDesc[0] = 0x09;                                                /* bLength */
+  USBD_AUDIO_CfgDesc[1] = 0x02;                                                /* bDescriptorType */
+  USBD_AUDIO_CfgDesc[2] = USBD_AUDIO_CfgDescLen&0xff;                          /* wTotalLength */
+  USBD_AUDIO_CfgDesc[3] = USBD_AUDIO_CfgDescLen>>8;
+  USBD_AUDIO_CfgDesc[4] = AUDIO_NUM_INTERFACES;                                /* bNumInterfaces */
+  USBD_AUDIO_CfgDesc[5] = 0x01;                                                /* bConfigurationValue */
+  USBD_AUDIO_CfgDesc[6] = 0x00;                                                /* iConfiguration */
+  USBD_AUDIO_CfgDesc[7] = 0x80;                                                /* bmAttributes  BUS Powered*/
+  USBD_AUDIO_CfgDesc[8] = 0x32;                                                /* bMaxPower = 100 mA*/
+  /* Interface Association Descriptor */
+  USBD_AUDIO_CfgDesc[9] = 0x08;                                                /* bLength */
+  USBD_AUDIO_CfgDesc[10] = USB_INTERFACE_ASSOCIATION_DESCRIPTOR_TYPE;          /* bDescriptorType */
+  USBD_AUDIO_CfgDesc[11] = 0x00;                                               /* bFirstInterface */
+  USBD_AUDIO_CfgDesc[12] = 0x02;                                               /* bInterfaceCount */
+  USBD_AUDIO_CfgDesc[13] = USB_DEVICE_CLASS_AUDIO;                             /* bFunctionClass */
+  USBD_AUDIO_CfgDesc[14] = AUDIO_SUBCLASS_UNDEFINED;                           /* bFunctionSubClass */
+  USBD_AUDIO_CfgDesc[15] = AUDIO_PROTOCOL_IP_VERSION_02_00;                    /* bFunctionProtocol */
+  USBD_AUDIO_CfgDesc[16] = 0x00;                                               /* iFunction */
+  /* USB Microphone Standard interface descriptor */
+  USBD_AUDIO_CfgDesc[17] = 9;                                                  /* bLength */
+  USBD_AUDIO_CfgDesc[18] = USB_INTERFACE_DESCRIPTOR_TYPE;                      /* bDescriptorType */
+  USBD_AUDIO_CfgDesc[19] = 0x00;                                               /* bInterfaceNumber */
+  USBD_AUDIO_CfgDesc[20] = 0x00;                                               /* bAlternateSetting */
+  USBD_AUDIO_CfgDesc[21] = 0x00;                                               /* bNumEndpoints */
+  USBD_AUDIO_CfgDesc[22] = USB_DEVICE_CLASS_AUDIO;                             /* bInterfaceClass */
+  USBD_AUDIO_CfgDesc[23] = AUDIO_SUBCLASS_AUDIOCONTROL;                        /* bInterfaceSubClass */
+  USBD_AUDIO_CfgDesc[24] = AUDIO_PROTOCOL_IP_VERSION_02_00;                    /* bInterfaceProtocol */
+  USBD_AUDIO_CfgDesc[25] = 0x00;                                               /* iInterface */
+  /* USB Microphone Class-specific AC Interface Descriptor */
+  USBD_AUDIO_CfgDesc[26] = 9;                                                  /* bLength */
+  USBD_AUDIO_CfgDesc[27] = AUDIO_INTERFACE_DESCRIPTOR_TYPE;                    /* bDescriptorType */
+  USBD_AUDIO_CfgDesc[28] = AUDIO_CONTROL_HEADER;                               /* bDescriptorSubtype */
+  USBD_AUDIO_CfgDesc[29] = 0x00;       /* 2.00 */                              /* bcdADC */
+  USBD_AUDIO_CfgDesc[30] = 0x02;
+  USBD_AUDIO_CfgDesc[31] = AUDIO_FUNCTION_CATEGORY_MICROPHONE;                 /* bCategory */
+  USBD_AUDIO_CfgDesc[32] = (USB_AUDIO_AC_DESC_SIZ+(Channels*4))&0xff;          /* wTotalLength = 56+4*AUDIO_CHANNELS */
+  USBD_AUDIO_CfgDesc[33] = (USB_AUDIO_AC_DESC_SIZ+(Channels*4))>>8;
+  USBD_AUDIO_CfgDesc[34] = 0x00;                                               /* bmControls */
+  /* USB Microphone Clock Source Descriptor */
+  USBD_AUDIO_CfgDesc[35] = 0x08;                                               /* bLength */
+  USBD_AUDIO_CfgDesc[36] = AUDIO_INTERFACE_DESCRIPTOR_TYPE;                    /* bDescriptorType */
+  USBD_AUDIO_CfgDesc[37] = AUDIO_CONTROL_CLOCK_SOURCE;                         /* bDescriptorSubtype */
+  USBD_AUDIO_CfgDesc[38] = MIC_CLOCK_SOURCE_ID;                                /* bClockID */
+  USBD_AUDIO_CfgDesc[39] = 0x03;                                               /* bmAttributes: internal programmable clock */
+  USBD_AUDIO_CfgDesc[40] = 0x07;                                               /* bmControls: frequency read/write, validity read */
+  USBD_AUDIO_CfgDesc[41] = 0x00;                                               /* bAssocTerminal */
+  USBD_AUDIO_CfgDesc[42] = 0x00;                                               /* iClockSource */
+  /* USB Microphone Input Terminal Descriptor */
+  USBD_AUDIO_CfgDesc[43] = 0x11;                                               /* bLength */
+  USBD_AUDIO_CfgDesc[44] = AUDIO_INTERFACE_DESCRIPTOR_TYPE;                    /* bDescriptorType */
+  USBD_AUDIO_CfgDesc[45] = AUDIO_CONTROL_INPUT_TERMINAL;                       /* bDescriptorSubtype */
+  USBD_AUDIO_CfgDesc[46] = MIC_IN_TERMINAL_ID;                                 /* bTerminalID */
+  USBD_AUDIO_CfgDesc[47] = 0x01;                                               /* wTerminalType AUDIO_TERMINAL_USB_MICROPHONE   0x0201 */
+  USBD_AUDIO_CfgDesc[48] = 0x02;
+  USBD_AUDIO_CfgDesc[49] = 0x00;                                               /* bAssocTerminal */
+  USBD_AUDIO_CfgDesc[50] = MIC_CLOCK_SOURCE_ID;                                /* bCSourceID */
+  USBD_AUDIO_CfgDesc[51] = Channels;                                           /* bNrChannels */
+  USBD_AUDIO_CfgDesc[52] = ChannelConfig&0xff;                                 /* bmChannelConfig */
+  USBD_AUDIO_CfgDesc[53] = ChannelConfig>>8;
+  USBD_AUDIO_CfgDesc[54] = 0x00;
+  USBD_AUDIO_CfgDesc[55] = 0x00;
+  USBD_AUDIO_CfgDesc[56] = 0x00;                                               /* iChannelNames */
+  USBD_AUDIO_CfgDesc[57] = 0x00;                                               /* bmControls */
+  USBD_AUDIO_CfgDesc[58] = 0x00;
+  USBD_AUDIO_CfgDesc[59] = 0x00;                                               /* iTerminal */
+  /* USB Microphone Audio Feature Unit Descriptor */
+  USBD_AUDIO_CfgDesc[60] = 6+((Channels+1)*4);                                 /* bLength */
+  USBD_AUDIO_CfgDesc[61] = AUDIO_INTERFACE_DESCRIPTOR_TYPE;                    /* bDescriptorType */
+  USBD_AUDIO_CfgDesc[62] = AUDIO_CONTROL_FEATURE_UNIT;                         /* bDescriptorSubtype */
+  USBD_AUDIO_CfgDesc[63] = MIC_FU_ID;                                          /* bUnitID */
+  USBD_AUDIO_CfgDesc[64] = MIC_IN_TERMINAL_ID;                                 /* bSourceID */
+  USBD_AUDIO_CfgDesc[65] = 0x0F;                                               /* bmaControls(0): mute and volume read/write */
+  USBD_AUDIO_CfgDesc[66] = 0x00;
+  USBD_AUDIO_CfgDesc[67] = 0x00;
+  USBD_AUDIO_CfgDesc[68] = 0x00;
+  index = 69;
+  for(ch = 0; ch < Channels; ch++)
+  {
+    USBD_AUDIO_CfgDesc[index++] = 0x00;                                        /* bmaControls(ch) */
+    USBD_AUDIO_CfgDesc[index++] = 0x00;
+    USBD_AUDIO_CfgDesc[index++] = 0x00;
+    USBD_AUDIO_CfgDesc[index++] = 0x00;
+  }
+  USBD_AUDIO_CfgDesc[index++] = 0x00;                                          /* iFeature */
+  /*USB Microphone Output Terminal Descriptor */
+  USBD_AUDIO_CfgDesc[index++] = 0x0C;                                          /* bLength */
+  USBD_AUDIO_CfgDesc[index++] = AUDIO_INTERFACE_DESCRIPTOR_TYPE;               /* bDescriptorType */
+  USBD_AUDIO_CfgDesc[index++] = AUDIO_CONTROL_OUTPUT_TERMINAL;                 /* bDescriptorSubtype */
+  USBD_AUDIO_CfgDesc[index++] = MIC_OUT_TERMINAL_ID;                           /* bTerminalID */
+  USBD_AUDIO_CfgDesc[index++] = 0x01;                                          /* wTerminalType AUDIO_TERMINAL_USB_STREAMING 0x0101*/
+  USBD_AUDIO_CfgDesc[index++] = 0x01;
+  USBD_AUDIO_CfgDesc[index++] = 0x00;                                          /* bAssocTerminal */
+  USBD_AUDIO_CfgDesc[index++] = MIC_FU_ID;                                     /* bSourceID */
+  USBD_AUDIO_CfgDesc[index++] = MIC_CLOCK_SOURCE_ID;                           /* bCSourceID */
+  USBD_AUDIO_CfgDesc[index++] = 0x00;                                          /* bmControls */
+  USBD_AUDIO_CfgDesc[index++] = 0x00;
+  USBD_AUDIO_CfgDesc[index++] = 0x00;                                          /* iTerminal */
+  /* USB Microphone Standard AS Interface Descriptor - Audio Streaming Zero Bandwith */
+  /* Interface 1, Alternate Setting 0                                             */
+  USBD_AUDIO_CfgDesc[index++] = 9;                                             /* bLength */
+  USBD_AUDIO_CfgDesc[index++] = USB_INTERFACE_DESCRIPTOR_TYPE;                 /* bDescriptorType */
+  USBD_AUDIO_CfgDesc[index++] = 0x01;                                          /* bInterfaceNumber */
+  USBD_AUDIO_CfgDesc[index++] = 0x00;                                          /* bAlternateSetting */
+  USBD_AUDIO_CfgDesc[index++] = 0x00;                                          /* bNumEndpoints */
+  USBD_AUDIO_CfgDesc[index++] = USB_DEVICE_CLASS_AUDIO;                        /* bInterfaceClass */
+  USBD_AUDIO_CfgDesc[index++] = AUDIO_SUBCLASS_AUDIOSTREAMING;                 /* bInterfaceSubClass */
+  USBD_AUDIO_CfgDesc[index++] = AUDIO_PROTOCOL_IP_VERSION_02_00;               /* bInterfaceProtocol */
+  USBD_AUDIO_CfgDesc[index++] = 0x00;                                          /* iInterface */
+  /* USB Microphone Standard AS Interface Descriptor - Audio Streaming Operational */
+  /* Interface 1, Alternate Setting 1                                           */
+  USBD_AUDIO_CfgDesc[index++] = 9;                                             /* bLength */
+  USBD_AUDIO_CfgDesc[index++] = USB_INTERFACE_DESCRIPTOR_TYPE;                 /* bDescriptorType */
+  USBD_AUDIO_CfgDesc[index++] = 0x01;                                          /* bInterfaceNumber */
+  USBD_AUDIO_CfgDesc[index++] = 0x01;                                          /* bAlternateSetting */
+  USBD_AUDIO_CfgDesc[index++] = 0x01;                                          /* bNumEndpoints */
+  USBD_AUDIO_CfgDesc[index++] = USB_DEVICE_CLASS_AUDIO;                        /* bInterfaceClass */
+  USBD_AUDIO_CfgDesc[index++] = AUDIO_SUBCLASS_AUDIOSTREAMING;                 /* bInterfaceSubClass */
+  USBD_AUDIO_CfgDesc[index++] = AUDIO_PROTOCOL_IP_VERSION_02_00;               /* bInterfaceProtocol */
+  USBD_AUDIO_CfgDesc[index++] = 0x00;                                          /* iInterface */
+  /* USB Microphone Audio Streaming Interface Descriptor */
+  USBD_AUDIO_CfgDesc[index++] = 0x10;                                          /* bLength */
+  USBD_AUDIO_CfgDesc[index++] = AUDIO_INTERFACE_DESCRIPTOR_TYPE;               /* bDescriptorType */
+  USBD_AUDIO_CfgDesc[index++] = AUDIO_STREAMING_GENERAL;                       /* bDescriptorSubtype */
+  USBD_AUDIO_CfgDesc[index++] = MIC_OUT_TERMINAL_ID;                           /* bTerminalLink */
+  USBD_AUDIO_CfgDesc[index++] = 0x00;                                          /* bmControls */
+  USBD_AUDIO_CfgDesc[index++] = AUDIO_FORMAT_TYPE_I;                           /* bFormatType */
+  USBD_AUDIO_CfgDesc[index++] = AUDIO_FORMAT_PCM & 0xff;                       /* bmFormats PCM */
+  USBD_AUDIO_CfgDesc[index++] = 0x00;
+  USBD_AUDIO_CfgDesc[index++] = 0x00;
+  USBD_AUDIO_CfgDesc[index++] = 0x00;
+  USBD_AUDIO_CfgDesc[index++] = Channels;                                      /* bNrChannels */
+  USBD_AUDIO_CfgDesc[index++] = ChannelConfig&0xff;                            /* bmChannelConfig */
+  USBD_AUDIO_CfgDesc[index++] = ChannelConfig>>8;
+  USBD_AUDIO_CfgDesc[index++] = 0x00;
+  USBD_AUDIO_CfgDesc[index++] = 0x00;
+  USBD_AUDIO_CfgDesc[index++] = 0x00;                                          /* iChannelNames */
+  /* USB Microphone Audio Type I Format Type Descriptor */
+  USBD_AUDIO_CfgDesc[index++] = 0x06;                                          /* bLength */
+  USBD_AUDIO_CfgDesc[index++] = AUDIO_INTERFACE_DESCRIPTOR_TYPE;               /* bDescriptorType */
+  USBD_AUDIO_CfgDesc[index++] = AUDIO_STREAMING_FORMAT_TYPE;                   /* bDescriptorSubtype */
+  USBD_AUDIO_CfgDesc[index++] = AUDIO_FORMAT_TYPE_I;                           /* bFormatType */
+  USBD_AUDIO_CfgDesc[index++] = subframe;                                      /* bSubslotSize */
+  USBD_AUDIO_CfgDesc[index++] = (BitsPerSample == 16) ? 16 : 24;               /* bBitResolution */
+  /* Endpoint 1 - Standard Descriptor */
+  USBD_AUDIO_CfgDesc[index++] = 0x07;                                          /* bLength */
+  USBD_AUDIO_CfgDesc[index++] = 0x05;                                          /* bDescriptorType */
+  USBD_AUDIO_CfgDesc[index++] = AUDIO_IN_EP;                                   /* bEndpointAddress 1 in endpoint*/
+  USBD_AUDIO_CfgDesc[index++] = 0x05;                                          /* bmAttributes: isochronous, asynchronous */
+  USBD_AUDIO_CfgDesc[index++] = max_packet&0xFF;                               /* wMaxPacketSize */
+  USBD_AUDIO_CfgDesc[index++] = max_packet>>8;
+  USBD_AUDIO_CfgDesc[index++] = 0x01;                                          /* bInterval */
+  /* Endpoint - Audio Streaming Descriptor*/
+  USBD_AUDIO_CfgDesc[index++] = 0x08;                                          /* bLength */
+  USBD_AUDIO_CfgDesc[index++] = AUDIO_ENDPOINT_DESCRIPTOR_TYPE;                /* bDescriptorType */
+  USBD_AUDIO_CfgDesc[index++] = AUDIO_ENDPOINT_GENERAL;                        /* bDescriptor */
+  USBD_AUDIO_CfgDesc[index++] = 0x00;                                          /* bmAttributes */
+  USBD_AUDIO_CfgDesc[index++] = 0x00;                                          /* bmControls */
+  USBD_AUDIO_CfgDesc[index++] = 0x00;                                          /* bLockDelayUnits */
+  USBD_AUDIO_CfgDesc[index++] = 0x00;                                          /* wLockDelay */
+  USBD_AUDIO_CfgDesc[index++] = 0x00;
+#ifdef USE_USB_TELEMETRY
+  /* Telemetry interface */
+  index += USBD_TELEMETRY_Desc(&USBD_AUDIO_CfgDesc[index], AUDIO_TELEMETRY_INTERFACE);
+#endif
+
+  haudioInstance.paketDimension = (samplingFrequency/1000*Channels*subframe);
+  haudioInstance.max_packet = max_packet;
+  haudioInstance.frequency=samplingFrequency;
+  haudioInstance.subframe=subframe;
+  haudioInstance.resolution=BitsPerSample;
+  haudioInstance.buffer_length = haudioInstance.paketDimension * AUDIO_IN_RING_BLOCKS;
+  haudioInstance.channels=Channels;
+  haudioInstance.mute = 0;
+  haudioInstance.state = STATE_USB_WAITING_FOR_INIT;
+  haudioInstance.wr_ptr = 3 * haudioInstance.paketDimension;
+  haudioInstance.rd_ptr = 0;
+  haudioInstance.dataAmount=0;
+  haudioInstance.buffer = IsocInRing;
+  memset(&haudioInstance.stats, 0, sizeof(haudioInstance.stats));
+  haudioInstance.stats.fill_min = 0xFFFF;
+  return USBD_OK;
+}
+
+/**
+* @}
+*/
+
+
+/**
+* @}
+*/
+
+
+/**
+* @}
+*/
+
+#endif /* USE_USB_AUDIO_CLASS_2 */
@@ -0,0 +1,122 @@
+/**
+  ******************************************************************************
+  * @file    usbd_telemetry.h
+  * @author  SRA
+  * @brief   header file for the usbd_telemetry.c file.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+
+#ifndef __USBD_TELEMETRY_H_
+#define __USBD_TELEMETRY_H_
+
+#include "usbd_ioreq.h"
+
+/** @addtogroup STM32_USB_OTG_DEVICE_LIBRARY
+* @{
+*/
+
+/** @defgroup USBD_TELEMETRY
+* @{
+*/
+
+/** @defgroup USBD_TELEMETRY_Exported_Defines
+* @{
+*/
+
+/* Vendor specific interface with one bulk endpoint per direction */
+#define TELEMETRY_DESC_SIZ                            (9 + 7 + 7)
+#define TELEMETRY_IN_EP                               0x82
+#define TELEMETRY_OUT_EP                              0x02
+#define TELEMETRY_PACKET                              64    /* full speed bulk */
+#define USB_DEVICE_CLASS_VENDOR_SPECIFIC              0xFF
+
+/* A record is a header followed by its payload and travels in one short packet,
+   so that every record is a transfer of its own for the host */
+#define TELEMETRY_RECORD_HEADER                       4
+#define TELEMETRY_MAX_PAYLOAD                         (TELEMETRY_PACKET - TELEMETRY_RECORD_HEADER - 4)
+
+/* Records queued for the host, a power of two. It can be overridden at compile time. */
+#ifndef TELEMETRY_QUEUE_SIZE
+#define TELEMETRY_QUEUE_SIZE                          32
+#endif
+
+/* A stream frame is a header, copied and sent in a short packet, followed by parts sent
+   from the memory of the producer, each as a transfer of its own */
+#define TELEMETRY_STREAM_MAX_HEADER                   32
+#define TELEMETRY_STREAM_MAX_PARTS                    4
+
+/**
+* @}
+*/
+
+
+/** @defgroup USBD_TELEMETRY_Exported_TypesDefinitions
+* @{
+*/
+
+/* Record as sent on the IN endpoint, little endian */
+typedef struct
+{
+  uint8_t  type;
+  uint8_t  length;       /* bytes of payload */
+  uint16_t sequence;     /* queue position, wraps */
+  uint8_t  payload[TELEMETRY_MAX_PAYLOAD];
+}
+USBD_TELEMETRY_RecordTypeDef;
+
+/* Part of a stream frame, left in place until the frame is sent */
+typedef struct
+{
+  uint8_t  *pBuf;
+  uint16_t Size;
+}
+USBD_TELEMETRY_PartTypeDef;
+
+typedef struct
+{
+  int8_t  (*Receive)        (uint8_t *Buf, uint32_t Len);   /* OUT packet, called from the USB interrupt */
+}USBD_TELEMETRY_ItfTypeDef;
+/**
+* @}
+*/
+
+/** @defgroup USBD_TELEMETRY_Exported_Functions
+* @{
+*/
+uint8_t  USBD_TELEMETRY_RegisterInterface (USBD_TELEMETRY_ItfTypeDef *fops);
+uint16_t USBD_TELEMETRY_Desc (uint8_t *pDesc, uint8_t InterfaceNr);
+void     USBD_TELEMETRY_Init (USBD_HandleTypeDef *pdev);
+void     USBD_TELEMETRY_DeInit (USBD_HandleTypeDef *pdev);
+void     USBD_TELEMETRY_DataIn (USBD_HandleTypeDef *pdev);
+void     USBD_TELEMETRY_DataOut (USBD_HandleTypeDef *pdev);
+void     USBD_TELEMETRY_SOF (USBD_HandleTypeDef *pdev);
+uint8_t  USBD_TELEMETRY_Post (uint8_t Type, const void *pData, uint8_t Size);
+uint32_t USBD_TELEMETRY_Get_Dropped (void);
+uint8_t  USBD_TELEMETRY_Stream (const void *pHeader, uint8_t HeaderSize,
+                                const USBD_TELEMETRY_PartTypeDef *pParts, uint8_t Parts);
+
+/**
+* @}
+*/
+
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+#endif  // __USBD_TELEMETRY_H_
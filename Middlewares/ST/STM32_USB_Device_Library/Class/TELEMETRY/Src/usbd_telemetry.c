@@ -0,0 +1,423 @@
+/**
+  ******************************************************************************
+  * @file    usbd_telemetry.c
+  * @author  SRA
+  * @brief   This file provides the telemetry and control bulk interface.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "usbd_telemetry.h"
+#include "usbd_ctlreq.h"
+
+/** @addtogroup STM32_USB_OTG_DEVICE_LIBRARY
+* @{
+*/
+
+/** @defgroup USBD_TELEMETRY
+*
+* 	This file provides a vendor specific interface added to the configuration
+*   of the audio class, making the device composite.
+*
+*           This driver implements the following aspects:
+*             - Vendor specific interface descriptor, appended by the audio class
+*             - 1 bulk IN endpoint carrying binary records
+*             - 1 bulk OUT endpoint carrying configuration writes
+*             - Record queue shared by producers of any priority
+*             - Stream frames sent without copy, ahead of the records
+*
+* @note     Records are posted without locks: a slot is reserved with an
+*           exclusive access on the queue head, filled, then committed. The
+*           queue is emptied from the USB interrupt only, on SOF and on the
+*           completion of the previous record, so producers never call the
+*           USB driver. A record posted when the queue is full is dropped.
+* @note     A stream frame has a single producer and is sent in place: the
+*           producer passes its buffers, the interrupt sends the header and
+*           the parts one after the other, records only go in between frames.
+*           A frame passed while the previous one is still being sent is
+*           dropped, the producer numbers its frames to report the gap.
+* @{
+*/
+
+/** @defgroup USBD_TELEMETRY_Private_Defines
+* @{
+*/
+#define TELEMETRY_BUSY_RECORD                         1U
+#define TELEMETRY_BUSY_STREAM                         2U
+/**
+* @}
+*/
+
+/** @defgroup USBD_TELEMETRY_Private_TypesDefinitions
+* @{
+*/
+typedef struct
+{
+  USBD_TELEMETRY_RecordTypeDef record;
+  __IO uint8_t                 size;     /* bytes to send, 0 while the slot is free or being written */
+}
+TELEMETRY_SlotTypeDef;
+/**
+* @}
+*/
+
+/** @defgroup USBD_TELEMETRY_Private_FunctionPrototypes
+* @{
+*/
+static void TELEMETRY_Send_Next(USBD_HandleTypeDef *pdev);
+static void TELEMETRY_Release(void);
+/**
+* @}
+*/
+
+/** @defgroup USBD_TELEMETRY_Private_Variables
+* @{
+*/
+static TELEMETRY_SlotTypeDef TelemetryQueue[TELEMETRY_QUEUE_SIZE];
+static __IO uint32_t TelemetryHead;      /* next slot to reserve, written by the producers */
+static __IO uint32_t TelemetryTail;      /* slot being sent or next one, written by the USB interrupt */
+static __IO uint32_t TelemetryDropped;
+static uint8_t TelemetryBusy;           /* transfer in flight: TELEMETRY_BUSY_RECORD or TELEMETRY_BUSY_STREAM */
+static uint8_t TelemetryActive;
+__ALIGN_BEGIN static uint8_t TelemetryRxBuffer[TELEMETRY_PACKET] __ALIGN_END;
+__ALIGN_BEGIN static uint8_t TelemetryStreamHeader[TELEMETRY_STREAM_MAX_HEADER] __ALIGN_END;
+static uint8_t TelemetryStreamHeaderSize;
+static USBD_TELEMETRY_PartTypeDef TelemetryStreamParts[TELEMETRY_STREAM_MAX_PARTS];
+static uint8_t TelemetryStreamCount;
+static uint8_t TelemetryStreamNext;     /* 0 for the header, then part + 1 */
+static __IO uint8_t TelemetryStreamPending;  /* set by the producer, cleared once the frame is sent */
+static USBD_TELEMETRY_ItfTypeDef *TelemetryItf;
+/**
+* @}
+*/
+
+/** @defgroup USBD_TELEMETRY_Private_Functions
+* @{
+*/
+
+/**
+* @brief  TELEMETRY_Send_Next
+*         Sends the next part of the pending stream frame, otherwise the record
+*         at the tail of the queue once it is committed
+* @param  pdev: device instance
+* @retval None
+*/
+static void TELEMETRY_Send_Next(USBD_HandleTypeDef *pdev)
+{
+  TELEMETRY_SlotTypeDef *pSlot = &TelemetryQueue[TelemetryTail & (TELEMETRY_QUEUE_SIZE - 1)];
+
+  if((TelemetryActive == 0U) || (TelemetryBusy != 0U))
+  {
+    return;
+  }
+
+  if(TelemetryStreamPending != 0U)
+  {
+    TelemetryBusy = TELEMETRY_BUSY_STREAM;
+    if(TelemetryStreamNext == 0U)
+    {
+      USBD_LL_Transmit(pdev, TELEMETRY_IN_EP,
+                       TelemetryStreamHeader,
+                       TelemetryStreamHeaderSize);
+    }
+    else
+    {
+      USBD_LL_Transmit(pdev, TELEMETRY_IN_EP,
+                       TelemetryStreamParts[TelemetryStreamNext - 1U].pBuf,
+                       TelemetryStreamParts[TelemetryStreamNext - 1U].Size);
+    }
+  }
+  else if(pSlot->size != 0U)
+  {
+    TelemetryBusy = TELEMETRY_BUSY_RECORD;
+    USBD_LL_Transmit(pdev, TELEMETRY_IN_EP,
+                     (uint8_t *)&pSlot->record,
+                     pSlot->size);
+  }
+}
+
+/**
+* @brief  TELEMETRY_Release
+*         Releases the record or the stream part sent
+* @param  None
+* @retval None
+*/
+static void TELEMETRY_Release(void)
+{
+  if(TelemetryBusy == TELEMETRY_BUSY_RECORD)
+  {
+    TelemetryQueue[TelemetryTail & (TELEMETRY_QUEUE_SIZE - 1)].size = 0;
+    __DMB();
+    TelemetryTail++;
+  }
+  else if(TelemetryBusy == TELEMETRY_BUSY_STREAM)
+  {
+    TelemetryStreamNext++;
+    if(TelemetryStreamNext > TelemetryStreamCount)
+    {
+      TelemetryStreamNext = 0;
+      __DMB();
+      TelemetryStreamPending = 0;
+    }
+  }
+  TelemetryBusy = 0;
+}
+
+/**
+* @}
+*/
+
+/** @defgroup USBD_TELEMETRY_Exported_Functions
+* @{
+*/
+
+/**
+* @brief  USBD_TELEMETRY_RegisterInterface
+* @param  fops: telemetry interface callback
+* @retval status
+*/
+uint8_t  USBD_TELEMETRY_RegisterInterface (USBD_TELEMETRY_ItfTypeDef *fops)
+{
+  if(fops == NULL)
+  {
+    return USBD_FAIL;
+  }
+  TelemetryItf = fops;
+  return USBD_OK;
+}
+
+/**
+* @brief  USBD_TELEMETRY_Desc
+*         Writes the interface and endpoint descriptors in the configuration
+*         descriptor of the audio class
+* @param  pDesc: destination in the configuration descriptor
+* @param  InterfaceNr: interface number
+* @retval bytes written, TELEMETRY_DESC_SIZ
+*/
+uint16_t USBD_TELEMETRY_Desc (uint8_t *pDesc, uint8_t InterfaceNr)
+{
+  uint16_t index = 0;
+
+  /* Telemetry Standard Interface Descriptor */
+  pDesc[index++] = 9;                                                 /* bLength */
+  pDesc[index++] = USB_DESC_TYPE_INTERFACE;                           /* bDescriptorType */
+  pDesc[index++] = InterfaceNr;                                       /* bInterfaceNumber */
+  pDesc[index++] = 0x00;                                              /* bAlternateSetting */
+  pDesc[index++] = 0x02;                                              /* bNumEndpoints */
+  pDesc[index++] = USB_DEVICE_CLASS_VENDOR_SPECIFIC;                  /* bInterfaceClass */
+  pDesc[index++] = 0x00;                                              /* bInterfaceSubClass */
+  pDesc[index++] = 0x00;                                              /* bInterfaceProtocol */
+  pDesc[index++] = 0x00;                                              /* iInterface */
+  /* Bulk IN Endpoint Descriptor */
+  pDesc[index++] = 7;                                                 /* bLength */
+  pDesc[index++] = USB_DESC_TYPE_ENDPOINT;                            /* bDescriptorType */
+  pDesc[index++] = TELEMETRY_IN_EP;                                   /* bEndpointAddress */
+  pDesc[index++] = USBD_EP_TYPE_BULK;                                 /* bmAttributes */
+  pDesc[index++] = LOBYTE(TELEMETRY_PACKET);                          /* wMaxPacketSize */
+  pDesc[index++] = HIBYTE(TELEMETRY_PACKET);
+  pDesc[index++] = 0x00;                                              /* bInterval */
+  /* Bulk OUT Endpoint Descriptor */
+  pDesc[index++] = 7;                                                 /* bLength */
+  pDesc[index++] = USB_DESC_TYPE_ENDPOINT;                            /* bDescriptorType */
+  pDesc[index++] = TELEMETRY_OUT_EP;                                  /* bEndpointAddress */
+  pDesc[index++] = USBD_EP_TYPE_BULK;                                 /* bmAttributes */
+  pDesc[index++] = LOBYTE(TELEMETRY_PACKET);                          /* wMaxPacketSize */
+  pDesc[index++] = HIBYTE(TELEMETRY_PACKET);
+  pDesc[index++] = 0x00;                                              /* bInterval */
+
+  return index;
+}
+
+/**
+* @brief  USBD_TELEMETRY_Init
+*         Opens the endpoints, records queued before are kept
+* @param  pdev: device instance
+* @retval None
+*/
+void USBD_TELEMETRY_Init (USBD_HandleTypeDef *pdev)
+{
+  USBD_LL_OpenEP(pdev, TELEMETRY_IN_EP, USBD_EP_TYPE_BULK, TELEMETRY_PACKET);
+  pdev->ep_in[TELEMETRY_IN_EP & 0xFU].is_used = 1U;
+  USBD_LL_OpenEP(pdev, TELEMETRY_OUT_EP, USBD_EP_TYPE_BULK, TELEMETRY_PACKET);
+  pdev->ep_out[TELEMETRY_OUT_EP & 0xFU].is_used = 1U;
+
+  TelemetryBusy = 0;
+  TelemetryActive = 1;
+  USBD_LL_PrepareReceive(pdev, TELEMETRY_OUT_EP, TelemetryRxBuffer, TELEMETRY_PACKET);
+}
+
+/**
+* @brief  USBD_TELEMETRY_DeInit
+*         Closes the endpoints
+* @param  pdev: device instance
+* @retval None
+*/
+void USBD_TELEMETRY_DeInit (USBD_HandleTypeDef *pdev)
+{
+  TelemetryActive = 0;
+  USBD_LL_CloseEP(pdev, TELEMETRY_IN_EP);
+  pdev->ep_in[TELEMETRY_IN_EP & 0xFU].is_used = 0U;
+  USBD_LL_CloseEP(pdev, TELEMETRY_OUT_EP);
+  pdev->ep_out[TELEMETRY_OUT_EP & 0xFU].is_used = 0U;
+  if(TelemetryBusy == TELEMETRY_BUSY_STREAM)
+  {
+    /* The stream frame in flight is lost with the endpoint */
+    TelemetryStreamNext = TelemetryStreamCount;
+  }
+  /* The record in flight is lost with the endpoint */
+  TELEMETRY_Release();
+}
+
+/**
+* @brief  USBD_TELEMETRY_DataIn
+*         Releases the record sent and sends the next one
+* @param  pdev: device instance
+* @retval None
+*/
+void USBD_TELEMETRY_DataIn (USBD_HandleTypeDef *pdev)
+{
+  TELEMETRY_Release();
+  TELEMETRY_Send_Next(pdev);
+}
+
+/**
+* @brief  USBD_TELEMETRY_DataOut
+*         Passes the configuration write to the application and rearms the endpoint
+* @param  pdev: device instance
+* @retval None
+*/
+void USBD_TELEMETRY_DataOut (USBD_HandleTypeDef *pdev)
+{
+  uint32_t len = USBD_LL_GetRxDataSize(pdev, TELEMETRY_OUT_EP);
+
+  if((TelemetryItf != NULL) && (len != 0U))
+  {
+    TelemetryItf->Receive(TelemetryRxBuffer, len);
+  }
+  USBD_LL_PrepareReceive(pdev, TELEMETRY_OUT_EP, TelemetryRxBuffer, TELEMETRY_PACKET);
+}
+
+/**
+* @brief  USBD_TELEMETRY_SOF
+*         Starts sending when records were posted while the endpoint was idle
+* @param  pdev: device instance
+* @retval None
+*/
+void USBD_TELEMETRY_SOF (USBD_HandleTypeDef *pdev)
+{
+  TELEMETRY_Send_Next(pdev);
+}
+
+/**
+* @brief  USBD_TELEMETRY_Post
+*         Queues a record for the host. It never waits and can be called from
+*         any interrupt priority, also while the host is not reading.
+* @param  Type: record type, defined by the application
+* @param  pData: payload
+* @param  Size: payload size in bytes, up to TELEMETRY_MAX_PAYLOAD
+* @retval USBD_OK, USBD_BUSY when the queue is full (the record is dropped)
+*         or USBD_FAIL when the record is too long
+*/
+uint8_t  USBD_TELEMETRY_Post (uint8_t Type, const void *pData, uint8_t Size)
+{
+  TELEMETRY_SlotTypeDef *pSlot;
+  uint32_t head;
+
+  if(Size > TELEMETRY_MAX_PAYLOAD)
+  {
+    return USBD_FAIL;
+  }
+
+  /* Reserve the slot at the head, retried if another producer got in between */
+  do
+  {
+    head = __LDREXW((uint32_t *)&TelemetryHead);
+    if((head - TelemetryTail) >= TELEMETRY_QUEUE_SIZE)
+    {
+      __CLREX();
+      TelemetryDropped++;
+      return USBD_BUSY;
+    }
+  }
+  while(__STREXW(head + 1U, (uint32_t *)&TelemetryHead) != 0U);
+
+  pSlot = &TelemetryQueue[head & (TELEMETRY_QUEUE_SIZE - 1)];
+  pSlot->record.type = Type;
+  pSlot->record.length = Size;
+  pSlot->record.sequence = (uint16_t)head;
+  memcpy(pSlot->record.payload, pData, Size);
+  /* Commit: the USB interrupt sends the slot once its size is set */
+  __DMB();
+  pSlot->size = TELEMETRY_RECORD_HEADER + Size;
+  return USBD_OK;
+}
+
+/**
+* @brief  USBD_TELEMETRY_Get_Dropped
+*         Records dropped because the queue was full
+* @retval number of records
+*/
+uint32_t USBD_TELEMETRY_Get_Dropped (void)
+{
+  return TelemetryDropped;
+}
+
+/**
+* @brief  USBD_TELEMETRY_Stream
+*         Passes a stream frame to the host: the header is copied, the parts are
+*         sent from their buffers, which the producer must not reuse before the
+*         frame is sent. Single producer, it never waits.
+* @param  pHeader: frame header, sent in a short packet
+* @param  HeaderSize: header size in bytes, up to TELEMETRY_STREAM_MAX_HEADER
+* @param  pParts: parts following the header, of non-zero size
+* @param  Parts: number of parts, up to TELEMETRY_STREAM_MAX_PARTS
+* @retval USBD_OK, USBD_BUSY when the previous frame is still being sent or the
+*         interface is not configured (the frame is dropped) or USBD_FAIL
+*/
+uint8_t  USBD_TELEMETRY_Stream (const void *pHeader, uint8_t HeaderSize,
+                                const USBD_TELEMETRY_PartTypeDef *pParts, uint8_t Parts)
+{
+  if((HeaderSize > TELEMETRY_STREAM_MAX_HEADER) || (Parts > TELEMETRY_STREAM_MAX_PARTS))
+  {
+    return USBD_FAIL;
+  }
+  if((TelemetryActive == 0U) || (TelemetryStreamPending != 0U))
+  {
+    return USBD_BUSY;
+  }
+
+  memcpy(TelemetryStreamHeader, pHeader, HeaderSize);
+  TelemetryStreamHeaderSize = HeaderSize;
+  memcpy(TelemetryStreamParts, pParts, Parts * sizeof(USBD_TELEMETRY_PartTypeDef));
+  TelemetryStreamCount = Parts;
+  TelemetryStreamNext = 0;
+  /* Commit: the USB interrupt sends the frame once it is pending */
+  __DMB();
+  TelemetryStreamPending = 1;
+  return USBD_OK;
+}
+
+/**
+* @}
+*/
+
+
+/**
+* @}
+*/
+
+
+/**
+* @}
+*/
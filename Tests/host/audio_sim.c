@@ -0,0 +1,448 @@
+/**
+  ******************************************************************************
+  * @file    audio_sim.c
+  * @author  SRA
+  * @brief   USB microphone streaming on the simulated bus. The application is
+  *          the one of main.c with DISABLE_USB_DRIVEN_ACQUISITION: the capture
+  *          runs on its own clock and hands each block to Send_Audio_to_USB
+  *          from its interrupt, the host reads a packet per 1 ms frame.
+  *          Both run on one virtual time line, in ms.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "audio_sim.h"
+#include "audio_application.h"
+#include "usbd_desc.h"
+#include "usb_sim.h"
+
+/* Private define ------------------------------------------------------------*/
+#define SIM_TONE_HZ          50.0   /* channel c carries (c + 1) * SIM_TONE_HZ */
+#define SIM_TONE_AMPLITUDE   8000.0 /* in 16 bit units, whatever the stream resolution */
+#define SIM_MAX_BLOCK        (AUDIO_IN_RING_SIZE / 2U)
+#define SIM_SEED             0x2545F491U
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  const AudioSim_Config_t *Config;
+  AudioSim_Result_t *Result;
+  double Now;                 /* virtual time, ms */
+  double FramesPerMs;         /* microphone frames per host ms */
+  uint64_t Handed;            /* frames passed to USB or lost, the capture position */
+  uint32_t Nominal;           /* frames of a packet */
+  uint32_t Settle;            /* host frame the checks start at */
+  uint32_t Tail;              /* first frame of the last quarter */
+  uint32_t Frame;             /* host frame */
+  double LatencySum;
+  float GlitchBound;          /* largest second difference of the tones, 16 bit units */
+  float History[8][2];
+  uint8_t HistoryValid;
+} Sim_Stream_t;
+
+/* Private variables ---------------------------------------------------------*/
+USBD_HandleTypeDef hUSBDDevice;
+CCA02M2_AUDIO_Init_t MicParams;
+uint16_t PCM_Buffer[1];
+
+extern USBD_AUDIO_ItfTypeDef USBD_AUDIO_fops;
+extern USBD_TELEMETRY_ItfTypeDef USBD_TELEMETRY_fops;
+
+static Sim_Stream_t Stream;
+static AudioSim_Trace_Callback Trace;
+
+/* Private functions ---------------------------------------------------------*/
+static double Sim_Time(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+/* Uniform in [-1, 1), the xorshift32 of host_test.h */
+static double Sim_Noise(uint32_t *state)
+{
+  uint32_t x = *state;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return ((double)(x >> 8) / 8388608.0) - 1.0;
+}
+
+static int32_t Sim_Sample_Get(const uint8_t *p, uint8_t bits)
+{
+  switch (bits)
+  {
+    case 24:
+      return ((int32_t)(((uint32_t)p[0] << 8) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 24))) >> 16;
+    case 32:
+      return ((int32_t)((uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24))) >> 16;
+    default:
+      return (int16_t)(p[0] | (p[1] << 8));
+  }
+}
+
+static void Sim_Sample_Put(uint8_t *p, double value, uint8_t bits)
+{
+  int32_t s = (int32_t)lrint(value * ((bits == 16U) ? 1.0 : ((bits == 24U) ? 256.0 : 65536.0)));
+  uint8_t i;
+
+  for (i = 0; i < (bits / 8U); i++)
+  {
+    p[i] = (uint8_t)(s >> (8U * i));
+  }
+}
+
+/**
+  * @brief  Test tones on the host side: the second difference of a tone is
+  *         bounded, a lost, repeated or misaligned block is not
+  */
+static void Sim_Check_Tones(const uint8_t *pData, uint32_t frames, uint8_t tail)
+{
+  const AudioSim_Config_t *cfg = Stream.Config;
+  uint32_t subframe = cfg->Bits / 8U;
+  uint32_t i, c;
+
+  for (i = 0; i < frames; i++)
+  {
+    uint8_t glitch = 0;
+
+    for (c = 0; c < cfg->Channels; c++)
+    {
+      float x = (float)Sim_Sample_Get(&pData[((i * cfg->Channels) + c) * subframe], cfg->Bits);
+
+      if ((Stream.HistoryValid >= 2U) && (fabsf(x - (2.0f * Stream.History[c][1]) + Stream.History[c][0]) > Stream.GlitchBound))
+      {
+        glitch = 1;
+      }
+      Stream.History[c][0] = Stream.History[c][1];
+      Stream.History[c][1] = x;
+    }
+    Stream.HistoryValid = (Stream.HistoryValid < 2U) ? (Stream.HistoryValid + 1U) : 2U;
+    Stream.Result->Glitches += glitch;
+    Stream.Result->TailGlitches += (tail != 0U) ? glitch : 0U;
+  }
+}
+
+/**
+  * @brief  Packet read by the simulated host
+  */
+static void Sim_Packet(uint8_t ep_addr, const uint8_t *pData, uint32_t Len)
+{
+  const AudioSim_Config_t *cfg = Stream.Config;
+  AudioSim_Result_t *res = Stream.Result;
+  uint32_t frame_bytes = cfg->Channels * (cfg->Bits / 8U);
+  uint32_t frames = Len / frame_bytes;
+  uint8_t tail = (Stream.Frame >= Stream.Tail) ? 1U : 0U;
+  uint32_t i;
+
+  if ((ep_addr != AUDIO_IN_EP) || (Stream.Frame < Stream.Settle))
+  {
+    return;
+  }
+  res->Packets++;
+  if (((Len % frame_bytes) != 0U) || (frames > (Stream.Nominal + 1U)) || ((frames + 1U) < Stream.Nominal))
+  {
+    res->BadSize++;
+    Stream.HistoryValid = 0;
+    return;
+  }
+  for (i = 0; (i < Len) && (pData[i] == 0U); i++)
+  {
+  }
+  if (i == Len)
+  {
+    res->Silent++;
+    res->TailSilent += tail;
+    Stream.HistoryValid = 0;
+    return;
+  }
+  Sim_Check_Tones(pData, frames, tail);
+}
+
+/**
+  * @brief  Capture to host latency of the packet just read: frames captured
+  *         and not passed to USB yet, plus the frames left in the ring
+  */
+static void Sim_Latency(uint32_t packets_before)
+{
+  AudioSim_Result_t *res = Stream.Result;
+  USBD_AUDIO_StatsTypeDef stats;
+  uint32_t pending;
+  float ms;
+  uint32_t bin;
+
+  Get_USB_Audio_Stats(&stats, 1);
+  if ((stats.packets == packets_before) || (Stream.Frame < Stream.Settle))
+  {
+    return;
+  }
+  (void)CCA02M2_AUDIO_IN_GetPosition(CCA02M2_AUDIO_INSTANCE, &pending);
+  ms = (float)((double)pending + (double)stats.fill_min - (double)Stream.Nominal) / (float)Stream.FramesPerMs;
+  ms = (ms < 0.0f) ? 0.0f : ms;
+  bin = (uint32_t)(ms / AUDIO_SIM_BIN_MS);
+  res->Histogram[(bin < AUDIO_SIM_BINS) ? bin : (AUDIO_SIM_BINS - 1U)]++;
+  res->LatencyMin = (ms < res->LatencyMin) ? ms : res->LatencyMin;
+  res->LatencyMax = (ms > res->LatencyMax) ? ms : res->LatencyMax;
+  Stream.LatencySum += ms;
+}
+
+/* Board and application stand-ins -------------------------------------------*/
+int32_t CCA02M2_AUDIO_IN_Init(uint32_t Instance, CCA02M2_AUDIO_Init_t *AudioInit)
+{
+  return BSP_ERROR_NONE;
+}
+
+int32_t CCA02M2_AUDIO_IN_Stop(uint32_t Instance)
+{
+  return BSP_ERROR_NONE;
+}
+
+int32_t CCA02M2_AUDIO_IN_SetSampleRate(uint32_t Instance, uint32_t SampleRate)
+{
+  return BSP_ERROR_NONE;
+}
+
+int32_t CCA02M2_AUDIO_IN_SetVolume(uint32_t Instance, uint32_t Volume)
+{
+  return BSP_ERROR_NONE;
+}
+
+/* Frames of the microphone clock not handed to USB at the current virtual time */
+int32_t CCA02M2_AUDIO_IN_GetPosition(uint32_t Instance, uint32_t *Position)
+{
+  uint64_t captured = (uint64_t)floor(Stream.Now * Stream.FramesPerMs);
+
+  *Position = (captured > Stream.Handed) ? (uint32_t)(captured - Stream.Handed) : 0U;
+  return BSP_ERROR_NONE;
+}
+
+int32_t Audio_Capture_Start(void)
+{
+  return BSP_ERROR_NONE;
+}
+
+int8_t Audio_Telemetry_Command(uint8_t *Buf, uint32_t Len)
+{
+  return 0;
+}
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  The USB setup of main.c for the format of Config, then the
+  *         enumeration by the host. The device stays attached, on hUSBDDevice,
+  *         until AudioSim_Detach.
+  * @param  pConfig: receives the configuration descriptor
+  * @retval Length of the configuration descriptor, -1 when the device does not
+  *         enumerate
+  */
+int32_t AudioSim_Attach(const AudioSim_Config_t *Config, uint8_t *pConfig, uint16_t Size)
+{
+  UsbSim_Reset(Sim_Packet);
+  memset(&hUSBDDevice, 0, sizeof(hUSBDDevice));
+  USBD_AUDIO_Init_Microphone_Descriptor_Config(&hUSBDDevice, Config->Fs, Config->Channels,
+                                               (Config->Channels == 2U) ? 0x0003U : 0x0000U, Config->Bits);
+  (void)USBD_Init(&hUSBDDevice, &AUDIO_Desc, 0);
+  (void)USBD_RegisterClass(&hUSBDDevice, &USBD_AUDIO);
+  (void)USBD_AUDIO_RegisterInterface(&hUSBDDevice, &USBD_AUDIO_fops);
+  (void)USBD_TELEMETRY_RegisterInterface(&USBD_TELEMETRY_fops);
+  (void)USBD_Start(&hUSBDDevice);
+  return UsbSim_Enumerate(&hUSBDDevice, pConfig, Size);
+}
+
+void AudioSim_Detach(void)
+{
+  (void)USBD_DeInit(&hUSBDDevice);
+}
+
+/**
+  * @brief  Enumerates the microphone, opens the stream and runs it for Ms host
+  *         frames. Packets, latency and glitches are counted after SettleMs.
+  * @retval 0, -1 when the device does not enumerate
+  */
+int32_t AudioSim_Run(const AudioSim_Config_t *Config, uint32_t Ms, uint32_t SettleMs, AudioSim_Result_t *Result)
+{
+  static uint8_t block[SIM_MAX_BLOCK];
+  static uint8_t config[512];
+  uint32_t fs = (Config->HostFs != 0U) ? Config->HostFs : Config->Fs;
+  uint32_t block_frames = (fs / 1000U) * Config->BlockMs;
+  uint32_t subframe = Config->Bits / 8U;
+  uint32_t seed = SIM_SEED;
+  uint32_t blocks = 0, packets;
+  uint64_t tone_t = 0;
+  double block_period, next_block, isr, block_seconds = 0.0;
+  double w = 2.0 * M_PI * SIM_TONE_HZ / (double)fs;
+  uint32_t i, c;
+
+  memset(Result, 0, sizeof(*Result));
+  memset(&Stream, 0, sizeof(Stream));
+  Result->LatencyMin = 1e9f;
+  Stream.Config = Config;
+  Stream.Result = Result;
+  Stream.FramesPerMs = ((double)fs / 1000.0) * (1.0 + ((double)Config->Ppm * 1e-6));
+  Stream.Nominal = fs / 1000U;
+  Stream.Settle = SettleMs;
+  Stream.Tail = Ms - (Ms / 4U);
+  /* highest tone, plus the interpolation and rounding errors */
+  Stream.GlitchBound = (float)(2.0 * SIM_TONE_AMPLITUDE * pow(w * Config->Channels, 2.0)) + 4.0f;
+
+  if ((block_frames * Config->Channels * subframe) > sizeof(block))
+  {
+    printf("%s: block too large\n", Config->Name);
+    return -1;
+  }
+
+  if (AudioSim_Attach(Config, config, sizeof(config)) < 0)
+  {
+    printf("%s: enumeration failed\n", Config->Name);
+    AudioSim_Detach();
+    return -1;
+  }
+#ifdef USE_USB_AUDIO_CLASS_2
+  /* the host picks the sampling frequency on the clock source, the stream is closed */
+  if (Config->HostFs != 0U)
+  {
+    uint8_t freq[4] = { (uint8_t)fs, (uint8_t)(fs >> 8), (uint8_t)(fs >> 16), (uint8_t)(fs >> 24) };
+
+    if (UsbSim_Control(&hUSBDDevice, 0x21U, AUDIO_REQ_CUR, AUDIO_CS_SAM_FREQ_CONTROL << 8,
+                       MIC_CLOCK_SOURCE_ID << 8, sizeof(freq), freq) != (int32_t)sizeof(freq))
+    {
+      printf("%s: SET_CUR sampling frequency failed\n", Config->Name);
+      AudioSim_Detach();
+      return -1;
+    }
+  }
+#endif /* USE_USB_AUDIO_CLASS_2 */
+  /* the host opens the microphone: streaming interface, alternate setting 1 */
+  if (UsbSim_Control(&hUSBDDevice, 0x01U, USB_REQ_SET_INTERFACE, 1U, 1U, 0U, NULL) != 0)
+  {
+    printf("%s: SET_INTERFACE failed\n", Config->Name);
+    AudioSim_Detach();
+    return -1;
+  }
+
+  /* the capture runs from time 0, its blocks complete every block_period ms
+     of the host clock and are handed over after the interrupt latency */
+  block_period = (double)block_frames / Stream.FramesPerMs;
+  next_block = block_period;
+  isr = next_block + ((double)Config->JitterMs * 0.5 * (1.0 + Sim_Noise(&seed)));
+  for (Stream.Frame = 1; Stream.Frame <= Ms;)
+  {
+    if (isr < (double)Stream.Frame)
+    {
+      uint8_t stalled = (Config->StallMs != 0U) && (next_block >= (double)Config->StallAt) &&
+                        (next_block < (double)(Config->StallAt + Config->StallMs));
+
+      Stream.Now = isr;
+      for (i = 0; i < block_frames; i++, tone_t++)
+      {
+        for (c = 0; c < Config->Channels; c++)
+        {
+          double v = SIM_TONE_AMPLITUDE * sin(w * (double)(c + 1U) * (double)tone_t);
+
+          Sim_Sample_Put(&block[((i * Config->Channels) + c) * subframe], v, Config->Bits);
+        }
+      }
+      if (stalled == 0U)
+      {
+        double start = Sim_Time();
+
+        Send_Audio_to_USB((int16_t *)block, (uint16_t)(block_frames * Config->Channels));
+        block_seconds += Sim_Time() - start;
+        blocks++;
+      }
+      Stream.Handed += block_frames;
+      next_block += block_period;
+      /* interrupts are served in order */
+      isr = next_block + ((double)Config->JitterMs * 0.5 * (1.0 + Sim_Noise(&seed)));
+      isr = (isr < Stream.Now) ? Stream.Now : isr;
+    }
+    else
+    {
+      uint8_t paused = (Config->PauseMs != 0U) && (Stream.Frame >= Config->PauseAt) &&
+                       (Stream.Frame < (Config->PauseAt + Config->PauseMs));
+      USBD_AUDIO_StatsTypeDef stats;
+
+      Stream.Now = (double)Stream.Frame;
+      Get_USB_Audio_Stats(&stats, 1);
+      packets = stats.packets;
+      if (Trace != NULL)
+      {
+        Trace(Stream.Frame, &hUSBDDevice);
+      }
+      UsbSim_Frame(&hUSBDDevice, (paused != 0U) ? 0U : 1U);
+      Sim_Latency(packets);
+      Stream.Frame++;
+    }
+  }
+
+  Get_USB_Audio_Stats(&Result->Device, 0);
+  if (Result->Packets > Result->Silent)
+  {
+    Result->LatencyMean = (float)(Stream.LatencySum / (double)(Result->Packets - Result->Silent));
+  }
+  Result->LatencyMin = (Result->LatencyMin > Result->LatencyMax) ? 0.0f : Result->LatencyMin;
+  Result->PacketCost = UsbSim_Get_Stats()->DeviceSeconds * 1e6 / (double)UsbSim_Get_Stats()->Frames;
+  Result->PacketCostMax = UsbSim_Get_Stats()->DeviceMax * 1e6;
+  Result->BlockCost = (blocks != 0U) ? (block_seconds * 1e6 / (double)blocks) : 0.0;
+  AudioSim_Detach();
+  return 0;
+}
+
+/**
+  * @brief  Sets the function called at each host frame of the next runs
+  * @param  Callback: NULL for none
+  */
+void AudioSim_Set_Trace(AudioSim_Trace_Callback Callback)
+{
+  Trace = Callback;
+}
+
+/**
+  * @brief  Prints the report of a run: counters, latency distribution, cost
+  */
+void AudioSim_Print(const AudioSim_Config_t *Config, const AudioSim_Result_t *Result)
+{
+  const USBD_AUDIO_StatsTypeDef *dev = &Result->Device;
+  uint32_t i, peak = 1;
+
+  printf("%s\n", Config->Name);
+  printf("  device: %u packets, %u dummy, %u long, %u short, %u underruns, %u overruns, %u timeouts\n",
+         (unsigned)dev->packets, (unsigned)dev->dummy_packets, (unsigned)dev->long_packets,
+         (unsigned)dev->short_packets, (unsigned)dev->underruns, (unsigned)dev->overruns, (unsigned)dev->timeouts);
+  printf("  host:   %u packets, %u silent, %u bad size, %u glitches\n", (unsigned)Result->Packets,
+         (unsigned)Result->Silent, (unsigned)Result->BadSize, (unsigned)Result->Glitches);
+  printf("  latency %.2f / %.2f / %.2f ms (min / mean / max), cost %.2f us per packet (max %.2f), %.2f us per block\n",
+         (double)Result->LatencyMin, (double)Result->LatencyMean, (double)Result->LatencyMax,
+         Result->PacketCost, Result->PacketCostMax, Result->BlockCost);
+  for (i = 0; i < AUDIO_SIM_BINS; i++)
+  {
+    peak = (Result->Histogram[i] > peak) ? Result->Histogram[i] : peak;
+  }
+  for (i = 0; i < AUDIO_SIM_BINS; i++)
+  {
+    if (Result->Histogram[i] != 0U)
+    {
+      printf("  %5.2f ms %7u %.*s\n", (double)((float)i * AUDIO_SIM_BIN_MS), (unsigned)Result->Histogram[i],
+             (int)((40U * Result->Histogram[i]) / peak), "########################################");
+    }
+  }
+}
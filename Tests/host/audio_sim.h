@@ -0,0 +1,83 @@
+/**
+  ******************************************************************************
+  * @file    audio_sim.h
+  * @author  SRA
+  * @brief   USB microphone streaming on the simulated bus: the board stand-ins
+  *          of usbd_audio_if.c, a producer calling Send_Audio_to_USB from a
+  *          microphone clock with jitter and skew, and the checks of the
+  *          stream the simulated host receives
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __AUDIO_SIM_H
+#define __AUDIO_SIM_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbd_audio_if.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define AUDIO_SIM_BIN_MS     0.25f   /* latency histogram resolution */
+#define AUDIO_SIM_BINS       64U     /* the last bin holds everything above */
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct
+{
+  const char *Name;
+  uint32_t Fs;
+  uint8_t Channels;
+  uint8_t Bits;          /* 16, 24 or 32 */
+  uint8_t BlockMs;       /* block of the microphone interrupt */
+  float Ppm;             /* microphone clock against the host frame clock, > 0: faster */
+  float JitterMs;        /* latency of the block interrupt, uniform in [0, JitterMs) */
+  uint32_t StallAt;      /* the producer loses its blocks for StallMs from StallAt, 0: never */
+  uint32_t StallMs;
+  uint32_t PauseAt;      /* the host does not poll the microphone for PauseMs from PauseAt, 0: never */
+  uint32_t PauseMs;
+  uint32_t HostFs;       /* UAC2: sampling frequency the host sets on the clock source before
+                            streaming, Fs being the start up one of the descriptor. 0: Fs */
+} AudioSim_Config_t;
+
+typedef struct
+{
+  USBD_AUDIO_StatsTypeDef Device;      /* class statistics at the end of the run */
+  uint32_t Packets;                    /* packets read by the host after the settling time */
+  uint32_t Silent;                     /* of them, all zeros: dummy packets or ring not written yet */
+  uint32_t BadSize;                    /* of them, not nominal within one frame or not whole frames */
+  uint32_t Glitches;                   /* discontinuities of the test tones */
+  uint32_t TailSilent;                 /* silent packets and glitches of the last quarter of the run */
+  uint32_t TailGlitches;
+  uint32_t Histogram[AUDIO_SIM_BINS];  /* capture to host latency of the packets */
+  float LatencyMin;                    /* ms */
+  float LatencyMax;
+  float LatencyMean;
+  double PacketCost;                   /* device time on SOF and packet completion, mean and max, us */
+  double PacketCostMax;
+  double BlockCost;                    /* device time in Send_Audio_to_USB, mean, us */
+} AudioSim_Result_t;
+
+/* Called at each host frame, before its SOF: the class state is the one the
+   SOF handler sees */
+typedef void (*AudioSim_Trace_Callback)(uint32_t Frame, USBD_HandleTypeDef *pdev);
+
+/* Exported variables --------------------------------------------------------*/
+extern USBD_HandleTypeDef hUSBDDevice;
+
+/* Exported functions --------------------------------------------------------*/
+int32_t AudioSim_Attach(const AudioSim_Config_t *Config, uint8_t *pConfig, uint16_t Size);
+void AudioSim_Detach(void);
+int32_t AudioSim_Run(const AudioSim_Config_t *Config, uint32_t Ms, uint32_t SettleMs, AudioSim_Result_t *Result);
+void AudioSim_Set_Trace(AudioSim_Trace_Callback Callback);
+void AudioSim_Print(const AudioSim_Config_t *Config, const AudioSim_Result_t *Result);
+
+#endif /* __AUDIO_SIM_H */
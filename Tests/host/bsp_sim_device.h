@@ -0,0 +1,50 @@
+/**
+  ******************************************************************************
+  * @file    bsp_sim_device.h
+  * @author  SRA
+  * @brief   Forced in front of the tests that include the CCA02M2 audio driver:
+  *          the device headers are the target ones, the core registers and
+  *          intrinsics the processing code reaches are host stand-ins
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __BSP_SIM_DEVICE_H
+#define __BSP_SIM_DEVICE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l4xx_hal.h"
+
+/* Exported variables --------------------------------------------------------*/
+/* Cycle counter of the block timestamps, it does not run on the host; the test
+   defines it */
+extern DWT_Type BspSim_DWT;
+
+/* Exported macro ------------------------------------------------------------*/
+#undef DWT
+#define DWT (&BspSim_DWT)
+
+/* The test calls the driver from a single thread: barriers are compiler
+   barriers, exclusive stores always succeed, there is no interrupt to mask */
+#define __DMB()            __sync_synchronize()
+#define __DSB()            __sync_synchronize()
+#define __ISB()            __sync_synchronize()
+#define __LDREXW(addr)     (*(addr))
+#define __STREXW(val, addr) ((*(addr) = (val)), 0U)
+#define __CLREX()          do { } while (0)
+#define __get_PRIMASK()    0U
+#define __set_PRIMASK(x)   ((void)(x))
+#define __disable_irq()    do { } while (0)
+#define __enable_irq()     do { } while (0)
+
+#endif /* __BSP_SIM_DEVICE_H */
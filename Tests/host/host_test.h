@@ -0,0 +1,112 @@
+/**
+  ******************************************************************************
+  * @file    host_test.h
+  * @author  SRA
+  * @brief   Checks, timing and signal helpers shared by the host tests
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __HOST_TEST_H
+#define __HOST_TEST_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/* Exported variables --------------------------------------------------------*/
+static int HostTest_Failures = 0;
+static int HostTest_Bench = 0;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Reports and counts a failed check, the test goes on */
+#define HOST_CHECK(cond, ...)                                   \
+  do {                                                          \
+    if (!(cond))                                                \
+    {                                                           \
+      HostTest_Failures++;                                      \
+      printf("FAIL %s:%d: ", __FILE__, __LINE__);               \
+      printf(__VA_ARGS__);                                      \
+      printf("\n");                                             \
+    }                                                           \
+  } while (0)
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Parses the command line: -b selects the benchmark loops
+  */
+static inline void HostTest_Init(int argc, char **argv)
+{
+  int i;
+
+  for (i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "-b") == 0)
+    {
+      HostTest_Bench = 1;
+    }
+  }
+}
+
+/**
+  * @brief  Prints the verdict
+  * @retval Process exit code: 0 when every check passed
+  */
+static inline int HostTest_Result(const char *name)
+{
+  if (HostTest_Failures != 0)
+  {
+    printf("%s: %d check(s) FAILED\n", name, HostTest_Failures);
+    return 1;
+  }
+  printf("%s: OK\n", name);
+  return 0;
+}
+
+/**
+  * @brief  Monotonic time, in seconds
+  */
+static inline double HostTest_Time(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+/**
+  * @brief  Deterministic pseudo-random generator (xorshift32), the same
+  *         sequence on every host
+  */
+static inline uint32_t HostTest_Rand(uint32_t *state)
+{
+  uint32_t x = *state;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return x;
+}
+
+/**
+  * @brief  Uniform noise in [-1, 1)
+  */
+static inline float HostTest_Noise(uint32_t *state)
+{
+  return ((float)(HostTest_Rand(state) >> 8) / 8388608.0f) - 1.0f;
+}
+
+#endif /* __HOST_TEST_H */
@@ -0,0 +1,269 @@
+/**
+  ******************************************************************************
+  * @file    test_bsp_dfsdm.c
+  * @author  SRA
+  * @brief   16-bit DFSDM block conversion of the CCA02M2 audio driver:
+  *          DFSDM_Block_Process and DFSDM_Planar_Process against the
+  *          sample by sample gain, high pass filter and saturation they
+  *          replace. Output samples and filter states must be bit-exact for
+  *          every channel count, sampling frequency, block length, gain and
+  *          DFSDM result, over chains of blocks. -b also times the kernels.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+/* The driver itself: its kernels and buffers are static */
+#include "cca02m2_audio.c"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define MAX_SAMPLES        ((48000U / 1000U) * AUDIO_IN_MAX_BLOCK_MS)
+#define CHAIN_BLOCKS       6U      /* blocks converted in a row, the states carry over */
+#define TEST_CHAINS        4000U
+#define BENCH_CHAINS       40000U
+#define GUARD              0xA5A5U
+
+/* Private variables ---------------------------------------------------------*/
+DWT_Type BspSim_DWT;
+
+static const uint32_t Rates[] = { 8000U, 16000U, 32000U, 48000U };
+static const uint32_t Blocks[] = { 1U, 2U, 5U, AUDIO_IN_MAX_BLOCK_MS };
+
+static int32_t Dma[4][2U * MAX_SAMPLES];
+static uint16_t RefOut[(4U * MAX_SAMPLES) + 1U];
+static uint16_t BlockOut[(4U * MAX_SAMPLES) + 1U];
+static int16_t Planes[4][2U * MAX_SAMPLES];
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  The conversion of the DFSDM callbacks before the block kernels, one
+  *         sample at a time through AudioInCtx
+  */
+static void Ref_Process(uint32_t Offset)
+{
+  uint32_t i, j;
+
+  for (j = 0; j < AudioInCtx[1].ChannelsNbr; j ++)
+  {
+    for (i = 0; i < ((AudioInCtx[1].SampleRate / (uint32_t)1000) * AudioInCtx[1].BlockMs); i++)
+    {
+      AudioInCtx[1].HP_Filters[j].Z = ((MicRecBuff[j][i + Offset] / 256) * (int32_t)(AudioInCtx[1].Volume)) / 128;
+      AudioInCtx[1].HP_Filters[j].oldOut = (0xFC * (AudioInCtx[1].HP_Filters[j].oldOut + AudioInCtx[1].HP_Filters[j].Z - AudioInCtx[1].HP_Filters[j].oldIn)) / 256;
+      AudioInCtx[1].HP_Filters[j].oldIn = AudioInCtx[1].HP_Filters[j].Z;
+      AudioInCtx[1].pBuff[(i * AudioInCtx[1].ChannelsNbr) + j] = (uint16_t)(SaturaLH(AudioInCtx[1].HP_Filters[j].oldOut, -32760, 32760));
+    }
+  }
+}
+
+/**
+  * @brief  A DFSDM result: 24 bits left aligned, the channel and flag bits
+  *         below. Full scale, clipping and small signals are all drawn.
+  */
+static int32_t Dfsdm_Result(uint32_t *seed)
+{
+  uint32_t r = HostTest_Rand(seed);
+  uint32_t low = HostTest_Rand(seed) & 0x17U;
+  int32_t v;
+
+  switch (r & 3U)
+  {
+    case 0:
+      v = (int32_t)(HostTest_Rand(seed) & 0xFFFFFF00U);
+      break;
+    case 1:
+      v = ((r & 4U) != 0U) ? 0x7FFFFF00 : (int32_t)0x80000000U;
+      break;
+    case 2:
+      v = (int32_t)(HostTest_Rand(seed) % (1U << 20)) - (1 << 19);
+      break;
+    default:
+      v = (int32_t)(HostTest_Rand(seed) % 4096U) - 2048;
+      break;
+  }
+  return (int32_t)(((uint32_t)v & 0xFFFFFF00U) | low);
+}
+
+static void Setup(uint32_t Rate, uint32_t Channels, uint32_t BlockMs, uint32_t Volume)
+{
+  uint32_t j;
+
+  AudioInCtx[1].SampleRate = Rate;
+  AudioInCtx[1].ChannelsNbr = Channels;
+  AudioInCtx[1].BlockMs = BlockMs;
+  AudioInCtx[1].Volume = Volume;
+  for (j = 0; j < 4U; j++)
+  {
+    MicRecBuff[j] = Dma[j];
+    PlanarBuff[j] = Planes[j];
+  }
+}
+
+/**
+  * @brief  Converts a chain of blocks, alternating the halves of the DMA
+  *         buffers, with the reference and with the kernels from the same
+  *         filter states
+  * @param  pMismatches  Blocks that differ, interleaved and planar
+  */
+static void Run_Chain(uint32_t Rate, uint32_t Channels, uint32_t BlockMs, uint32_t Volume, uint32_t *seed,
+                      uint32_t pMismatches[2])
+{
+  HP_FilterState_TypeDef start[4], ref[4];
+  uint32_t samples = (Rate / 1000U) * BlockMs;
+  uint32_t b, i, j, half;
+  uint32_t sequence;
+
+  Setup(Rate, Channels, BlockMs, Volume);
+  for (j = 0; j < 4U; j++)
+  {
+    start[j].Z = (int32_t)(HostTest_Rand(seed) % 40000U) - 20000;
+    start[j].oldIn = start[j].Z;
+    start[j].oldOut = (int32_t)(HostTest_Rand(seed) % 80000U) - 40000;
+  }
+
+  for (b = 0; b < CHAIN_BLOCKS; b++)
+  {
+    half = b & 1U;
+    for (j = 0; j < 4U; j++)
+    {
+      for (i = 0; i < (2U * samples); i++)
+      {
+        Dma[j][i] = Dfsdm_Result(seed);
+      }
+    }
+
+    /* reference */
+    (void)memcpy(AudioInCtx[1].HP_Filters, start, sizeof(start));
+    (void)memset(RefOut, 0, sizeof(RefOut));
+    RefOut[samples * Channels] = GUARD;
+    AudioInCtx[1].pBuff = RefOut;
+    Ref_Process(half * samples);
+    (void)memcpy(ref, AudioInCtx[1].HP_Filters, sizeof(ref));
+
+    /* interleaved */
+    (void)memcpy(AudioInCtx[1].HP_Filters, start, sizeof(start));
+    (void)memset(BlockOut, 0, sizeof(BlockOut));
+    BlockOut[samples * Channels] = GUARD;
+    AudioInCtx[1].pBuff = BlockOut;
+    DFSDM_Block_Process(half * samples);
+    if ((memcmp(RefOut, BlockOut, sizeof(BlockOut)) != 0) || (memcmp(ref, AudioInCtx[1].HP_Filters, sizeof(ref)) != 0))
+    {
+      pMismatches[0]++;
+    }
+
+    /* planar */
+    (void)memcpy(AudioInCtx[1].HP_Filters, start, sizeof(start));
+    (void)memset(Planes, 0, sizeof(Planes));
+    sequence = PlanarSequence;
+    DFSDM_Planar_Process(half);
+    for (j = 0; j < Channels; j++)
+    {
+      for (i = 0; i < samples; i++)
+      {
+        if ((uint16_t)Planes[j][(half * samples) + i] != RefOut[(i * Channels) + j])
+        {
+          break;
+        }
+      }
+      if ((i < samples) || (PlanarBlock.pPlane[j] != &Planes[j][half * samples]))
+      {
+        break;
+      }
+    }
+    if ((j < Channels) || (memcmp(ref, AudioInCtx[1].HP_Filters, sizeof(ref)) != 0) ||
+        (PlanarBlock.Channels != Channels) || (PlanarBlock.Samples != samples) ||
+        (PlanarBlock.Sequence != sequence) || (PlanarBlock.ReleaseSequence != (sequence + 2U)) ||
+        (PlanarSequence != (sequence + 1U)))
+    {
+      pMismatches[1]++;
+    }
+
+    (void)memcpy(start, ref, sizeof(start));
+  }
+}
+
+/**
+  * @brief  Host time of the reference and of the kernels on the largest
+  *         interleaved block of the 1 ms callbacks
+  */
+static void Bench(uint32_t *seed)
+{
+  const uint32_t rounds = 200000U;
+  uint32_t samples = 48U;
+  double t0, t_ref, t_block, t_planar;
+  uint32_t i, j, r;
+
+  Setup(48000U, 4U, 1U, 128U);
+  for (j = 0; j < 4U; j++)
+  {
+    for (i = 0; i < (2U * samples); i++)
+    {
+      Dma[j][i] = Dfsdm_Result(seed) / 64;
+    }
+  }
+  AudioInCtx[1].pBuff = RefOut;
+  t0 = HostTest_Time();
+  for (r = 0; r < rounds; r++)
+  {
+    Ref_Process((r & 1U) * samples);
+  }
+  t_ref = HostTest_Time() - t0;
+  AudioInCtx[1].pBuff = BlockOut;
+  t0 = HostTest_Time();
+  for (r = 0; r < rounds; r++)
+  {
+    DFSDM_Block_Process((r & 1U) * samples);
+  }
+  t_block = HostTest_Time() - t0;
+  t0 = HostTest_Time();
+  for (r = 0; r < rounds; r++)
+  {
+    DFSDM_Planar_Process(r & 1U);
+  }
+  t_planar = HostTest_Time() - t0;
+
+  printf("48 kHz 4 ch 1 ms blocks: reference %.1f ns, interleaved kernel %.1f ns, planar kernel %.1f ns per sample\n",
+         t_ref * 1e9 / ((double)rounds * 4.0 * (double)samples),
+         t_block * 1e9 / ((double)rounds * 4.0 * (double)samples),
+         t_planar * 1e9 / ((double)rounds * 4.0 * (double)samples));
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t seed = 0x2545F491U;
+  uint32_t chains, c, blocks = 0;
+  uint32_t mismatches[2] = { 0U, 0U };
+  uint32_t rate, channels, block_ms, volume;
+
+  HostTest_Init(argc, argv);
+  chains = HostTest_Bench ? BENCH_CHAINS : TEST_CHAINS;
+  for (c = 0; c < chains; c++)
+  {
+    channels = 1U + (c % 4U);
+    rate = Rates[(c / 4U) % 4U];
+    block_ms = Blocks[(c / 16U) % 4U];
+    /* unity, full and zero gain, then any */
+    volume = ((c % 5U) == 0U) ? 128U : ((c % 7U) == 0U) ? 255U : ((c % 11U) == 0U) ? 0U : (HostTest_Rand(&seed) % 256U);
+    Run_Chain(rate, channels, block_ms, volume, &seed, mismatches);
+    blocks += CHAIN_BLOCKS;
+  }
+  printf("%u blocks, differing from the sample by sample conversion: %u interleaved, %u planar\n",
+         (unsigned)blocks, (unsigned)mismatches[0], (unsigned)mismatches[1]);
+  HOST_CHECK(mismatches[0] == 0U, "DFSDM_Block_Process: %u blocks not bit-exact", (unsigned)mismatches[0]);
+  HOST_CHECK(mismatches[1] == 0U, "DFSDM_Planar_Process: %u blocks not bit-exact", (unsigned)mismatches[1]);
+
+  if (HostTest_Bench)
+  {
+    Bench(&seed);
+  }
+  return HostTest_Result("test_bsp_dfsdm");
+}
@@ -0,0 +1,284 @@
+/**
+  ******************************************************************************
+  * @file    test_bsp_hires.c
+  * @author  SRA
+  * @brief   24 and 32-bit DFSDM block conversion of the CCA02M2 audio driver:
+  *          DFSDM_HiRes_Process against the sample by sample gain, high pass
+  *          filter and saturation followed by the in place 3 bytes packing it
+  *          replaces. Output bytes and filter states must be bit-exact for
+  *          every channel count, sampling frequency, block length, gain,
+  *          resolution and DFSDM result, over chains of blocks. -b also times
+  *          the kernels.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+/* The driver itself: its kernels and buffers are static */
+#include "cca02m2_audio.c"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define MAX_SAMPLES        ((48000U / 1000U) * AUDIO_IN_MAX_BLOCK_MS)
+#define CHAIN_BLOCKS       6U      /* blocks converted in a row, the states carry over */
+#define TEST_CHAINS        4000U
+#define BENCH_CHAINS       40000U
+#define GUARD              0xA5U
+
+/* Private variables ---------------------------------------------------------*/
+DWT_Type BspSim_DWT;
+
+static const uint32_t Rates[] = { 8000U, 16000U, 32000U, 48000U };
+static const uint32_t Blocks[] = { 1U, 2U, 5U, AUDIO_IN_MAX_BLOCK_MS };
+
+static int32_t Dma[4][2U * MAX_SAMPLES];
+/* Words, as the record buffer of the application, and 4 guard bytes */
+static uint32_t RefOut[(4U * MAX_SAMPLES) + 1U];
+static uint32_t BlockOut[(4U * MAX_SAMPLES) + 1U];
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  The 3 bytes packing of the driver before the block kernels: every 4
+  *         samples are read as 4 words and written as 3 words, in place
+  */
+static void Ref_Pack24(const int32_t *pSrc, uint8_t *pDst, uint32_t Samples)
+{
+  uint32_t i;
+  uint32_t a, b, c, d;
+  uint32_t w[3];
+
+  for (i = 0; (i + 4U) <= Samples; i += 4U)
+  {
+    a = (uint32_t)pSrc[i];
+    b = (uint32_t)pSrc[i + 1U];
+    c = (uint32_t)pSrc[i + 2U];
+    d = (uint32_t)pSrc[i + 3U];
+    w[0] = (a >> 8) | (b << 16);
+    w[1] = (b >> 16) | ((c << 8) & 0xFFFF0000U);
+    w[2] = (c >> 24) | (d & 0xFFFFFF00U);
+    (void)memcpy(pDst, w, 12U);
+    pDst = &pDst[12];
+  }
+  for (; i < Samples; i++)
+  {
+    a = (uint32_t)pSrc[i] >> 8;
+    (void)memcpy(pDst, &a, 3U);
+    pDst = &pDst[3];
+  }
+}
+
+/**
+  * @brief  The conversion of the DFSDM callbacks before the block kernels, one
+  *         sample at a time through AudioInCtx, then packed in place
+  */
+static void Ref_Process(uint32_t Offset)
+{
+  uint32_t i, j;
+  uint32_t samples = (AudioInCtx[1].SampleRate / (uint32_t)1000) * AudioInCtx[1].BlockMs;
+  uint32_t channels = AudioInCtx[1].ChannelsNbr;
+  int32_t *pOut = (int32_t *)AudioInCtx[1].pBuff;
+  int32_t sum;
+
+  for (j = 0; j < channels; j ++)
+  {
+    for (i = 0; i < samples; i++)
+    {
+      AudioInCtx[1].HP_Filters[j].Z = ((MicRecBuff[j][i + Offset] / 256) * (int32_t)(AudioInCtx[1].Volume)) / 64;
+      sum = AudioInCtx[1].HP_Filters[j].oldOut + AudioInCtx[1].HP_Filters[j].Z - AudioInCtx[1].HP_Filters[j].oldIn;
+      AudioInCtx[1].HP_Filters[j].oldOut = sum - (sum / 64);
+      AudioInCtx[1].HP_Filters[j].oldIn = AudioInCtx[1].HP_Filters[j].Z;
+      pOut[(i * channels) + j] = (int32_t)((uint32_t)SaturaLH(AudioInCtx[1].HP_Filters[j].oldOut, -8388608, 8388607) << 8);
+    }
+  }
+
+  if (AudioInCtx[1].BitsPerSample == AUDIO_RESOLUTION_24b)
+  {
+    Ref_Pack24(pOut, (uint8_t *)pOut, samples * channels);
+  }
+}
+
+/**
+  * @brief  A DFSDM result: 24 bits left aligned, the channel and flag bits
+  *         below. Full scale, clipping and small signals are all drawn.
+  */
+static int32_t Dfsdm_Result(uint32_t *seed)
+{
+  uint32_t r = HostTest_Rand(seed);
+  uint32_t low = HostTest_Rand(seed) & 0x17U;
+  int32_t v;
+
+  switch (r & 3U)
+  {
+    case 0:
+      v = (int32_t)(HostTest_Rand(seed) & 0xFFFFFF00U);
+      break;
+    case 1:
+      v = ((r & 4U) != 0U) ? 0x7FFFFF00 : (int32_t)0x80000000U;
+      break;
+    case 2:
+      v = (int32_t)(HostTest_Rand(seed) % (1U << 20)) - (1 << 19);
+      break;
+    default:
+      v = (int32_t)(HostTest_Rand(seed) % 4096U) - 2048;
+      break;
+  }
+  return (int32_t)(((uint32_t)v & 0xFFFFFF00U) | low);
+}
+
+static void Setup(uint32_t Rate, uint32_t Channels, uint32_t BlockMs, uint32_t Volume, uint32_t Bits)
+{
+  uint32_t j;
+
+  AudioInCtx[1].SampleRate = Rate;
+  AudioInCtx[1].ChannelsNbr = Channels;
+  AudioInCtx[1].BlockMs = BlockMs;
+  AudioInCtx[1].Volume = Volume;
+  AudioInCtx[1].BitsPerSample = Bits;
+  for (j = 0; j < 4U; j++)
+  {
+    MicRecBuff[j] = Dma[j];
+  }
+}
+
+/**
+  * @brief  Converts a chain of blocks, alternating the halves of the DMA
+  *         buffers, with the reference and with the kernel from the same
+  *         filter states
+  * @retval Blocks that differ
+  */
+static uint32_t Run_Chain(uint32_t Rate, uint32_t Channels, uint32_t BlockMs, uint32_t Volume, uint32_t Bits,
+                          uint32_t *seed)
+{
+  HP_FilterState_TypeDef start[4], ref[4];
+  uint32_t samples = (Rate / 1000U) * BlockMs;
+  uint32_t bytes = samples * Channels * (Bits / 8U);
+  uint32_t b, i, j, half;
+  uint32_t mismatches = 0;
+
+  Setup(Rate, Channels, BlockMs, Volume, Bits);
+  for (j = 0; j < 4U; j++)
+  {
+    start[j].Z = (int32_t)(HostTest_Rand(seed) % 40000000U) - 20000000;
+    start[j].oldIn = start[j].Z;
+    start[j].oldOut = (int32_t)(HostTest_Rand(seed) % 16000000U) - 8000000;
+  }
+
+  for (b = 0; b < CHAIN_BLOCKS; b++)
+  {
+    half = b & 1U;
+    for (j = 0; j < 4U; j++)
+    {
+      for (i = 0; i < (2U * samples); i++)
+      {
+        Dma[j][i] = Dfsdm_Result(seed);
+      }
+    }
+
+    /* reference: the packing reads the whole 32-bit block, the bytes after the packed ones are left over */
+    (void)memcpy(AudioInCtx[1].HP_Filters, start, sizeof(start));
+    (void)memset(RefOut, GUARD, sizeof(RefOut));
+    AudioInCtx[1].pBuff = (uint16_t *)RefOut;
+    Ref_Process(half * samples);
+    (void)memcpy(ref, AudioInCtx[1].HP_Filters, sizeof(ref));
+
+    /* block kernel */
+    (void)memcpy(AudioInCtx[1].HP_Filters, start, sizeof(start));
+    (void)memset(BlockOut, GUARD, sizeof(BlockOut));
+    AudioInCtx[1].pBuff = (uint16_t *)BlockOut;
+    DFSDM_HiRes_Process(half * samples);
+    if ((memcmp(RefOut, BlockOut, bytes) != 0) || (((uint8_t *)BlockOut)[bytes] != GUARD) ||
+        (memcmp(ref, AudioInCtx[1].HP_Filters, sizeof(ref)) != 0))
+    {
+      mismatches++;
+    }
+
+    (void)memcpy(start, ref, sizeof(start));
+  }
+  return mismatches;
+}
+
+/**
+  * @brief  Host time of the reference and of the kernel on the largest
+  *         interleaved block of the 1 ms callbacks
+  */
+static void Bench(uint32_t *seed)
+{
+  const uint32_t rounds = 200000U;
+  uint32_t samples = 48U;
+  double t0, t_ref[2], t_block[2];
+  uint32_t i, j, r, k;
+
+  for (k = 0; k < 2U; k++)
+  {
+    Setup(48000U, 4U, 1U, 64U, (k == 0U) ? AUDIO_RESOLUTION_24b : AUDIO_RESOLUTION_32b);
+    for (j = 0; j < 4U; j++)
+    {
+      for (i = 0; i < (2U * samples); i++)
+      {
+        Dma[j][i] = Dfsdm_Result(seed) / 64;
+      }
+    }
+    AudioInCtx[1].pBuff = (uint16_t *)RefOut;
+    t0 = HostTest_Time();
+    for (r = 0; r < rounds; r++)
+    {
+      Ref_Process((r & 1U) * samples);
+    }
+    t_ref[k] = HostTest_Time() - t0;
+    AudioInCtx[1].pBuff = (uint16_t *)BlockOut;
+    t0 = HostTest_Time();
+    for (r = 0; r < rounds; r++)
+    {
+      DFSDM_HiRes_Process((r & 1U) * samples);
+    }
+    t_block[k] = HostTest_Time() - t0;
+  }
+
+  printf("48 kHz 4 ch 1 ms blocks: 24-bit reference %.1f ns, kernel %.1f ns; 32-bit reference %.1f ns, kernel %.1f ns per sample\n",
+         t_ref[0] * 1e9 / ((double)rounds * 4.0 * (double)samples),
+         t_block[0] * 1e9 / ((double)rounds * 4.0 * (double)samples),
+         t_ref[1] * 1e9 / ((double)rounds * 4.0 * (double)samples),
+         t_block[1] * 1e9 / ((double)rounds * 4.0 * (double)samples));
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t seed = 0x1B873593U;
+  uint32_t chains, c, blocks = 0;
+  uint32_t mismatches[2] = { 0U, 0U };
+  uint32_t rate, channels, block_ms, volume, k;
+
+  HostTest_Init(argc, argv);
+  chains = HostTest_Bench ? BENCH_CHAINS : TEST_CHAINS;
+  for (c = 0; c < chains; c++)
+  {
+    channels = 1U + (c % 4U);
+    rate = Rates[(c / 4U) % 4U];
+    block_ms = Blocks[(c / 16U) % 4U];
+    k = (c / 64U) % 2U;
+    /* unity, full and zero gain, then any */
+    volume = ((c % 5U) == 0U) ? 64U : ((c % 7U) == 0U) ? 255U : ((c % 11U) == 0U) ? 0U : (HostTest_Rand(&seed) % 256U);
+    mismatches[k] += Run_Chain(rate, channels, block_ms, volume, (k == 0U) ? AUDIO_RESOLUTION_24b : AUDIO_RESOLUTION_32b,
+                               &seed);
+    blocks += CHAIN_BLOCKS;
+  }
+  printf("%u blocks, differing from the sample by sample conversion: %u at 24 bits, %u at 32 bits\n",
+         (unsigned)blocks, (unsigned)mismatches[0], (unsigned)mismatches[1]);
+  HOST_CHECK(mismatches[0] == 0U, "DFSDM_HiRes_Process 24-bit: %u blocks not bit-exact", (unsigned)mismatches[0]);
+  HOST_CHECK(mismatches[1] == 0U, "DFSDM_HiRes_Process 32-bit: %u blocks not bit-exact", (unsigned)mismatches[1]);
+
+  if (HostTest_Bench)
+  {
+    Bench(&seed);
+  }
+  return HostTest_Result("test_bsp_hires");
+}
@@ -0,0 +1,188 @@
+/**
+  ******************************************************************************
+  * @file    test_bsp_skew.c
+  * @author  SRA
+  * @brief   Skew self-test of the CCA02M2 audio driver: CCA02M2_AUDIO_IN_CheckSkew
+  *          called between the blocks of a simulated DFSDM group, the DMA
+  *          counters of the filters all alike, with one microphone plane
+  *          shifted by a capture skew on top of the acoustic delay of the
+  *          sound. The skew must be measured, the acoustic delay not taken
+  *          for one, and the uncorrelated noise of a quiet room give no
+  *          result.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+/* The driver itself: the DMA buffers and the state of the self-test are static */
+#include "cca02m2_audio.c"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define MAX_LENGTH         (2U * (48000U / 1000U) * AUDIO_IN_MAX_BLOCK_MS)
+#define MAX_BLOCKS         2000U   /* a result within 2000 blocks */
+#define HISTORY            32U     /* delays of the planes, in samples */
+
+/* Private types -------------------------------------------------------------*/
+typedef struct
+{
+  const char *Name;
+  uint32_t Rate;
+  uint32_t Channels;
+  uint32_t BlockMs;
+  int32_t Acoustic;        /* delay of the sound on the last microphone, samples */
+  int32_t Skew;            /* capture skew of the last microphone, samples */
+  float Noise;             /* uncorrelated noise of each microphone against the sound */
+  int32_t Expected;        /* skew to report, -1: none, the microphones not coherent */
+} Skew_Case_t;
+
+/* Private variables ---------------------------------------------------------*/
+DWT_Type BspSim_DWT;
+
+static int32_t Dma[4][MAX_LENGTH];
+static DMA_Channel_TypeDef DmaChannel;
+static DMA_HandleTypeDef hDma;
+static float Sound[HISTORY];
+
+static const Skew_Case_t Cases[] =
+{
+  { "16 kHz 2 mics aligned",                  16000U, 2U, 1U,  0,  0, 0.1f,  0 },
+  { "16 kHz 2 mics, sound 2 samples late",    16000U, 2U, 1U,  2,  0, 0.1f,  0 },
+  { "16 kHz 2 mics, sound 2 samples early",   16000U, 2U, 1U, -2,  0, 0.1f,  0 },
+  { "16 kHz 2 mics, skew 1",                  16000U, 2U, 1U,  0,  3, 0.1f,  1 },
+  { "16 kHz 2 mics, skew -2",                 16000U, 2U, 1U,  0, -4, 0.1f,  2 },
+  { "16 kHz 4 mics, skew 3",                  16000U, 4U, 1U,  2,  3, 0.1f,  3 },
+  { "48 kHz 4 mics aligned, 4 ms blocks",     48000U, 4U, 4U,  5,  0, 0.1f,  0 },
+  { "48 kHz 4 mics, skew 1, 4 ms blocks",     48000U, 4U, 4U,  5,  1, 0.1f,  1 },
+  { "48 kHz 2 mics, skew 9 (beyond range)",   48000U, 2U, 1U,  0,  9, 0.1f,  4 },
+  { "8 kHz 2 mics, skew 1",                    8000U, 2U, 1U,  0,  2, 0.1f,  1 },
+  { "32 kHz 4 mics, skew 2, 16 ms blocks",    32000U, 4U, 16U, 1,  4, 0.1f,  2 },
+  { "16 kHz 4 mics, quiet room",              16000U, 4U, 1U,  0,  3, 10.0f, -1 },
+};
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Sample of the microphone Mic at the DMA position of the first one:
+  *         the sound Delay samples ago plus its own noise, as a DFSDM result
+  */
+static int32_t Mic_Sample(int32_t Delay, float Noise, uint32_t Mic, uint32_t *seed)
+{
+  float v = Sound[Delay] + (Noise * HostTest_Noise(seed));
+
+  return (int32_t)((uint32_t)((int32_t)(v * 400000.0f)) << 8) | (int32_t)Mic;
+}
+
+/**
+  * @brief  Records the sound through the simulated group and calls the
+  *         self-test between the DMA transfers, at a random position of each
+  *         block, until it reports
+  * @param  pSkew    Skew reported
+  * @param  pBlocks  Blocks recorded
+  * @retval Status of the last call
+  */
+static int32_t Run_Case(const Skew_Case_t *Case, uint32_t *seed, uint32_t *pSkew, uint32_t *pBlocks)
+{
+  uint32_t length = 2U * (Case->Rate / 1000U) * Case->BlockMs;
+  uint32_t position = 0;
+  uint32_t until;
+  uint32_t b, j, k;
+  int32_t delay;
+  int32_t ret = BSP_ERROR_BUSY;
+
+  (void)memset(Dma, 0, sizeof(Dma));
+  (void)memset(Sound, 0, sizeof(Sound));
+  hDma.Instance = &DmaChannel;
+  DmaChannel.CNDTR = length;
+  hAudioInDfsdmFilter[0].hdmaReg = &hDma;
+  for (j = 0; j < 4U; j++)
+  {
+    MicRecBuff[j] = Dma[j];
+  }
+  AudioInCtx[1].SampleRate = Case->Rate;
+  AudioInCtx[1].ChannelsNbr = Case->Channels;
+  AudioInCtx[1].BlockMs = Case->BlockMs;
+  AudioInCtx[1].IsMultiBuff = 0;
+  AudioInCtx[1].State = AUDIO_IN_STATE_RECORDING;
+  DfsdmDmaLength = length;
+  DfsdmSkewSamples = 0;
+  AUDIO_IN_Counters_Reset(1U);
+
+  for (b = 0; (b < MAX_BLOCKS) && (ret == BSP_ERROR_BUSY); b++)
+  {
+    /* To the end of the half, then into the next one where the self-test reads the counter */
+    until = (((position / (length / 2U)) + 1U) * (length / 2U)) + (HostTest_Rand(seed) % (length / 2U));
+    for (; position < until; position++)
+    {
+      (void)memmove(&Sound[1], &Sound[0], sizeof(Sound) - sizeof(Sound[0]));
+      Sound[0] = HostTest_Noise(seed);
+      for (j = 0; j < Case->Channels; j++)
+      {
+        /* The acoustic delay grows across the board, the skew is on the last microphone */
+        delay = 12 + ((Case->Acoustic * (int32_t)j) / (int32_t)(Case->Channels - 1U));
+        if (j == (Case->Channels - 1U))
+        {
+          delay += Case->Skew;
+        }
+        Dma[j][position % length] = Mic_Sample(delay, Case->Noise, j, seed);
+      }
+      if (((position + 1U) % (length / 2U)) == 0U)
+      {
+        AudioInCounters[1].Blocks++;
+      }
+    }
+    position %= length;
+    DmaChannel.CNDTR = length - position;
+    ret = CCA02M2_AUDIO_IN_CheckSkew(1U, pSkew);
+  }
+  *pBlocks = b;
+
+  /* Wrong parameters and a stopped recording */
+  k = 0;
+  k += (CCA02M2_AUDIO_IN_CheckSkew(0U, pSkew) == BSP_ERROR_WRONG_PARAM) ? 0U : 1U;
+  k += (CCA02M2_AUDIO_IN_CheckSkew(1U, NULL) == BSP_ERROR_WRONG_PARAM) ? 0U : 1U;
+  AudioInCtx[1].State = AUDIO_IN_STATE_STOP;
+  k += (CCA02M2_AUDIO_IN_CheckSkew(1U, pSkew) == BSP_ERROR_BUSY) ? 0U : 1U;
+  HOST_CHECK(k == 0U, "%s: %u wrong parameters or states not rejected", Case->Name, (unsigned)k);
+  return ret;
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t seed = 0x6C8E9CF5U;
+  uint32_t c, skew, blocks;
+  int32_t ret;
+
+  HostTest_Init(argc, argv);
+  for (c = 0; c < (sizeof(Cases) / sizeof(Cases[0])); c++)
+  {
+    skew = UINT32_MAX;
+    ret = Run_Case(&Cases[c], &seed, &skew, &blocks);
+    if (ret == BSP_ERROR_NONE)
+    {
+      printf("%-40s skew %u after %u blocks\n", Cases[c].Name, (unsigned)skew, (unsigned)blocks);
+    }
+    else
+    {
+      printf("%-40s no result after %u blocks\n", Cases[c].Name, (unsigned)blocks);
+    }
+    if (Cases[c].Expected < 0)
+    {
+      HOST_CHECK(ret == BSP_ERROR_BUSY, "%s: reported %u on uncorrelated microphones", Cases[c].Name, (unsigned)skew);
+    }
+    else
+    {
+      HOST_CHECK((ret == BSP_ERROR_NONE) && (skew == (uint32_t)Cases[c].Expected), "%s: expected %d, got %u (status %d)",
+                 Cases[c].Name, (int)Cases[c].Expected, (unsigned)skew, (int)ret);
+    }
+  }
+  return HostTest_Result("test_bsp_skew");
+}
@@ -0,0 +1,321 @@
+/**
+  ******************************************************************************
+  * @file    test_fft_mel.c
+  * @author  SRA
+  * @brief   GenericFFT: log-mel and MFCC features of fft_mel against a double
+  *          precision reference, accuracy of the fast logarithm, frames/s
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdlib.h>
+#include "fft_mel.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+/* Same front end as the firmware features (AUDIO_FEATURES_xxx in audio_application.h) */
+#define FS                 16000U
+#define FRAME_LEN          512U
+#define HOP                160U
+#define MELS               40U
+#define MFCC               13U
+#define F_MIN              20.0f
+#define F_MAX              8000.0f
+
+#define TEST_SAMPLES       FS              /* 1 s, 100 frames */
+#define BENCH_SECONDS      200U
+#define BLOCK              123U            /* not a divisor of the hop */
+#define MAX_FRAMES         (TEST_SAMPLES / HOP)
+
+/* Fast log: ln(m) = 2 atanh(t), t = (m - 1) / (m + 1) in [0, 1/3) for m in [1, 2). The series is cut after t^7,
+   the remainder is below 2 t^9 / (9 (1 - t^2)) = 1.27e-5 at t = 1/3, in natural log units. The float32
+   arithmetic of the series adds a few 1e-7. */
+#define FAST_LOG_BOUND     2e-5
+
+/* Log-mel against the double precision reference: the fast log above, plus the float32 rfft and filterbank
+   rounding (about 1e-4 relative on the weakest bands of the test signal, 1.3e-4 overall) */
+#define LOG_MEL_BOUND      2e-4
+/* MFCC: orthonormal DCT-II of the log-mel, |error| <= sqrt(MELS) * LOG_MEL_BOUND */
+#define MFCC_BOUND         (6.33 * LOG_MEL_BOUND)
+/* Q8 output: the float result rounded to 1/256 */
+#define Q8_BOUND           (0.5 / 256.0)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  FFT_mel_instance_t *Instance;
+  uint32_t Frames;
+  float Features[MAX_FRAMES][MELS];
+  double LogError;        /* fast log against ln() of the same band energies */
+} Mel_Capture_t;
+
+/* Private variables ---------------------------------------------------------*/
+static int16_t Signal[TEST_SAMPLES];
+static double Cos_Table[FRAME_LEN];
+static double Sin_Table[FRAME_LEN];
+static double Ref_LogMel[MAX_FRAMES][MELS];
+
+/* Private functions ---------------------------------------------------------*/
+static double Mel_From_Hz(double hz)
+{
+  return 2595.0 * log10(1.0 + (hz / 700.0));
+}
+
+static double Mel_To_Hz(double mel)
+{
+  return 700.0 * (pow(10.0, mel / 2595.0) - 1.0);
+}
+
+/**
+  * @brief  Two tones, a chirp and broadband noise, so that every mel band has energy
+  */
+static void Make_Signal(void)
+{
+  uint32_t seed = 1U;
+  uint32_t i;
+
+  for (i = 0; i < TEST_SAMPLES; i++)
+  {
+    double t = (double)i / (double)FS;
+    double v = (0.3 * sin(2.0 * M_PI * 440.0 * t)) + (0.1 * sin(2.0 * M_PI * 3150.0 * t))
+               + (0.2 * sin(2.0 * M_PI * (300.0 + (2000.0 * t)) * t)) + (0.02 * (double)HostTest_Noise(&seed));
+
+    Signal[i] = (int16_t)lrint(v * 32767.0);
+  }
+}
+
+/**
+  * @brief  Reference log-mel: periodic Hann window, DFT, triangular HTK mel bands over the bins
+  *         strictly inside each triangle (bin 0 excluded), natural log, all in double precision
+  * @retval Number of frames
+  */
+static uint32_t Reference(void)
+{
+  double frame[FRAME_LEN];
+  double power[FRAME_LEN / 2U];
+  double edges[MELS + 2U];
+  uint32_t f, n, k, m;
+
+  for (n = 0; n < FRAME_LEN; n++)
+  {
+    Cos_Table[n] = cos(2.0 * M_PI * (double)n / (double)FRAME_LEN);
+    Sin_Table[n] = sin(2.0 * M_PI * (double)n / (double)FRAME_LEN);
+  }
+  for (m = 0; m < (MELS + 2U); m++)
+  {
+    edges[m] = Mel_To_Hz(Mel_From_Hz(F_MIN) + (((Mel_From_Hz(F_MAX) - Mel_From_Hz(F_MIN)) * (double)m) / (double)(MELS + 1U)));
+  }
+
+  for (f = 0; f < MAX_FRAMES; f++)
+  {
+    /* the frame ends with the last hop, the analysis buffer starts zeroed */
+    int32_t first = (int32_t)((f + 1U) * HOP) - (int32_t)FRAME_LEN;
+
+    for (n = 0; n < FRAME_LEN; n++)
+    {
+      int32_t idx = first + (int32_t)n;
+      double x = (idx >= 0) ? ((double)Signal[idx] / 32768.0) : 0.0;
+
+      frame[n] = x * 0.5 * (1.0 - Cos_Table[n]);
+    }
+    for (k = 1; k < (FRAME_LEN / 2U); k++)
+    {
+      double re = 0.0, im = 0.0;
+
+      for (n = 0; n < FRAME_LEN; n++)
+      {
+        uint32_t p = (k * n) % FRAME_LEN;
+
+        re += frame[n] * Cos_Table[p];
+        im -= frame[n] * Sin_Table[p];
+      }
+      power[k] = (re * re) + (im * im);
+    }
+    for (m = 0; m < MELS; m++)
+    {
+      double energy = 0.0;
+
+      for (k = 1; k < (FRAME_LEN / 2U); k++)
+      {
+        double hz = (double)k * (double)FS / (double)FRAME_LEN;
+
+        if ((hz > edges[m]) && (hz < edges[m + 2U]))
+        {
+          energy += power[k] * ((hz <= edges[m + 1U]) ? ((hz - edges[m]) / (edges[m + 1U] - edges[m]))
+                                : ((edges[m + 2U] - hz) / (edges[m + 2U] - edges[m + 1U])));
+        }
+      }
+      Ref_LogMel[f][m] = log((energy > 1e-10) ? energy : 1e-10);
+    }
+  }
+  return MAX_FRAMES;
+}
+
+static double Ref_Mfcc(uint32_t frame, uint32_t k)
+{
+  double scale = (k == 0U) ? sqrt(1.0 / (double)MELS) : sqrt(2.0 / (double)MELS);
+  double acc = 0.0;
+  uint32_t m;
+
+  for (m = 0; m < MELS; m++)
+  {
+    acc += Ref_LogMel[frame][m] * cos((M_PI * (double)k * ((double)m + 0.5)) / (double)MELS);
+  }
+  return scale * acc;
+}
+
+/**
+  * @brief  Stores the features of each frame, and checks the fast log on the band energies of the
+  *         instance itself: the filterbank is applied in double to the float power spectrum
+  */
+static void Mel_Callback(void *features, uint32_t len, void *param)
+{
+  Mel_Capture_t *cap = (Mel_Capture_t *)param;
+  FFT_mel_context_t *ctx = &cap->Instance->context;
+  const float32_t *weights = ctx->weights;
+  uint32_t m, k;
+
+  for (m = 0; m < MELS; m++)
+  {
+    double energy = 0.0;
+
+    for (k = 0; k < ctx->band_len[m]; k++)
+    {
+      energy += (double)ctx->power[ctx->band_start[m] + k] * (double)weights[k];
+    }
+    weights = &weights[ctx->band_len[m]];
+    if (energy > 1e-10)
+    {
+      double e = fabs((double)ctx->mel[m] - log(energy));
+
+      cap->LogError = (e > cap->LogError) ? e : cap->LogError;
+    }
+  }
+
+  if (cap->Frames < MAX_FRAMES)
+  {
+    for (k = 0; k < len; k++)
+    {
+      cap->Features[cap->Frames][k] = (cap->Instance->init_params.output_type == FFT_MEL_OUTPUT_Q8)
+                                      ? ((float)((int16_t *)features)[k] / 256.0f) : ((float *)features)[k];
+    }
+  }
+  cap->Frames++;
+}
+
+static void Mel_Setup(FFT_mel_instance_t *mel, uint32_t mfcc, FFT_mel_output_t output, Mel_Capture_t *cap)
+{
+  memset(mel, 0, sizeof(*mel));
+  memset(cap, 0, sizeof(*cap));
+  cap->Instance = mel;
+  mel->init_params.FFT_len = FRAME_LEN;
+  mel->init_params.hop = HOP;
+  mel->init_params.sample_rate = FS;
+  mel->init_params.num_mels = MELS;
+  mel->init_params.f_min = F_MIN;
+  mel->init_params.f_max = F_MAX;
+  mel->init_params.num_mfcc = mfcc;
+  mel->init_params.win_type = FFT_HANNING_WIN;
+  mel->init_params.data_type = INT16;
+  mel->init_params.output_type = output;
+  mel->init_params.callback = Mel_Callback;
+  mel->init_params.callback_param = cap;
+  HOST_CHECK(FFT_Mel_Init(mel) == FFT_ERROR_NONE, "FFT_Mel_Init mfcc %u", (unsigned)mfcc);
+}
+
+/**
+  * @brief  Feeds the test signal in blocks of BLOCK samples and compares each frame with the reference
+  * @retval Largest error
+  */
+static double Run(const char *name, uint32_t mfcc, FFT_mel_output_t output, double bound, Mel_Capture_t *cap)
+{
+  FFT_mel_instance_t mel;
+  uint32_t i, f, k;
+  int32_t frames = 0;
+  double max_error = 0.0;
+
+  Mel_Setup(&mel, mfcc, output, cap);
+  for (i = 0; i < TEST_SAMPLES; i += BLOCK)
+  {
+    uint32_t len = ((i + BLOCK) <= TEST_SAMPLES) ? BLOCK : (TEST_SAMPLES - i);
+
+    frames += FFT_Mel_Data_Input(&Signal[i], len, &mel);
+  }
+  HOST_CHECK((frames == (int32_t)MAX_FRAMES) && (cap->Frames == MAX_FRAMES), "%s: %d frames, expected %u", name,
+             (int)frames, (unsigned)MAX_FRAMES);
+
+  for (f = 0; f < cap->Frames; f++)
+  {
+    for (k = 0; k < ((mfcc != 0U) ? mfcc : MELS); k++)
+    {
+      double ref = (mfcc != 0U) ? Ref_Mfcc(f, k) : Ref_LogMel[f][k];
+      double e = fabs((double)cap->Features[f][k] - ref);
+
+      if (e > max_error)
+      {
+        max_error = e;
+      }
+    }
+  }
+  HOST_CHECK(max_error <= bound, "%s: max error %.3g above %.3g", name, max_error, bound);
+  HOST_CHECK(cap->LogError <= FAST_LOG_BOUND, "%s: fast log error %.3g above %.3g", name, cap->LogError, FAST_LOG_BOUND);
+  printf("%-16s max error %.3g (bound %.3g), fast log error %.3g (bound %.3g)\n", name, max_error, bound,
+         cap->LogError, FAST_LOG_BOUND);
+  (void)FFT_Mel_DeInit(&mel);
+  return max_error;
+}
+
+/**
+  * @brief  Frames per second of the whole extractor, without callback
+  */
+static void Bench(uint32_t mfcc)
+{
+  FFT_mel_instance_t mel;
+  Mel_Capture_t cap;
+  uint32_t r, loops = HostTest_Bench ? BENCH_SECONDS : 20U;
+  int32_t frames = 0;
+  double start, seconds;
+
+  Mel_Setup(&mel, mfcc, FFT_MEL_OUTPUT_Q8, &cap);
+  mel.init_params.callback = NULL;
+  start = HostTest_Time();
+  for (r = 0; r < loops; r++)
+  {
+    frames += FFT_Mel_Data_Input(Signal, TEST_SAMPLES, &mel);
+  }
+  seconds = HostTest_Time() - start;
+  printf("%-16s %6d frames, %7.2f us/frame, %8.0f frames/s (%.0fx real time)\n", (mfcc != 0U) ? "MFCC bench" : "log-mel bench",
+         (int)frames, seconds * 1e6 / (double)frames, (double)frames / seconds,
+         ((double)frames / seconds) / ((double)FS / (double)HOP));
+  (void)FFT_Mel_DeInit(&mel);
+}
+
+int main(int argc, char **argv)
+{
+  static Mel_Capture_t cap;
+
+  HostTest_Init(argc, argv);
+  Make_Signal();
+  (void)Reference();
+
+  (void)Run("log-mel float", 0U, FFT_MEL_OUTPUT_FLOAT32, LOG_MEL_BOUND, &cap);
+  (void)Run("MFCC float", MFCC, FFT_MEL_OUTPUT_FLOAT32, MFCC_BOUND, &cap);
+  (void)Run("log-mel Q8", 0U, FFT_MEL_OUTPUT_Q8, LOG_MEL_BOUND + Q8_BOUND, &cap);
+  (void)Run("MFCC Q8", MFCC, FFT_MEL_OUTPUT_Q8, MFCC_BOUND + Q8_BOUND, &cap);
+
+  Bench(0U);
+  Bench(MFCC);
+
+  return HostTest_Result("test_fft_mel");
+}
@@ -0,0 +1,223 @@
+/**
+  ******************************************************************************
+  * @file    test_fft_multi.c
+  * @author  SRA
+  * @brief   GenericFFT: FFT_Multi_Process() of planar and interleaved frames
+  *          of several channels against FFT_Direct_Process() of each channel
+  *          on its own instance, for the three output types, with the time of
+  *          a frame both ways
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdlib.h>
+#include "fft.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define MAX_LEN            1024U
+#define MAX_CHANNELS       8U
+#define FRAMES             8U
+#define BENCH_FRAMES       2000U
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  const char *Name;
+  uint32_t Len;
+  uint32_t Channels;
+  FFT_layout_t Layout;
+  FFT_windows_t Win;
+  FFT_data_type_t Type;
+  FFT_output_type_t Output;
+  uint8_t UserBuffer;      /* arena given by the caller instead of the heap */
+} Multi_Case_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const Multi_Case_t Cases[] =
+{
+  { "1 ch planar float complex",          512U, 1U, FFT_PLANAR,      FFT_HANNING_WIN,         FLOAT32, COMPLEX,   0U },
+  { "2 ch interleaved int16 magnitude",   512U, 2U, FFT_INTERLEAVED, FFT_HAMMING_WIN,         INT16,   MAGNITUDE, 0U },
+  { "4 ch planar int16 power",           1024U, 4U, FFT_PLANAR,      FFT_HANNING_WIN,         INT16,   POWER,     0U },
+  { "4 ch interleaved int16 power",      1024U, 4U, FFT_INTERLEAVED, FFT_HANNING_WIN,         INT16,   POWER,     0U },
+  { "4 ch interleaved int32 complex",     256U, 4U, FFT_INTERLEAVED, FFT_RECT_WIN,            INT32,   COMPLEX,   0U },
+  { "3 ch planar float magnitude, arena", 256U, 3U, FFT_PLANAR,      FFT_BLACKMAN_HARRIS_WIN, FLOAT32, MAGNITUDE, 1U },
+  { "8 ch interleaved float power",       256U, 8U, FFT_INTERLEAVED, FFT_TUKEY_0_75_WIN,      FLOAT32, POWER,     0U },
+};
+
+static int32_t Input[MAX_CHANNELS * MAX_LEN];      /* typed frames of all the channels */
+static int32_t Channel[MAX_LEN];                   /* typed frame of one channel */
+static float32_t Out[MAX_CHANNELS * MAX_LEN];
+static float32_t Ref[MAX_LEN];
+static float32_t Arena[(MAX_CHANNELS + 3U) * MAX_LEN];
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t Sample_Size(FFT_data_type_t Type)
+{
+  return (Type == INT16) ? sizeof(int16_t) : sizeof(int32_t);
+}
+
+/**
+  * @brief  Writes sample v of the given type at index i of buf
+  */
+static void Put(void *buf, FFT_data_type_t Type, uint32_t i, float v)
+{
+  switch (Type)
+  {
+    case INT16:
+      ((int16_t *)buf)[i] = (int16_t)lrintf(v * 32767.0f);
+      break;
+    case INT32:
+      ((int32_t *)buf)[i] = (int32_t)lrint((double)v * 2147483647.0);
+      break;
+    default:
+      ((float32_t *)buf)[i] = v;
+      break;
+  }
+}
+
+/**
+  * @brief  One frame per channel, a tone of its own plus noise, in the layout of the case
+  */
+static void Make_Frames(const Multi_Case_t *c, uint32_t *seed)
+{
+  uint32_t ch, n;
+
+  for (ch = 0; ch < c->Channels; ch++)
+  {
+    float f = (float)(5U + (7U * ch)) + (0.5f * HostTest_Noise(seed));
+
+    for (n = 0; n < c->Len; n++)
+    {
+      float v = (0.5f * sinf((2.0f * (float)M_PI * f * (float)n) / (float)c->Len)) + (0.2f * HostTest_Noise(seed));
+      uint32_t i = (c->Layout == FFT_PLANAR) ? ((ch * c->Len) + n) : ((n * c->Channels) + ch);
+
+      Put(Input, c->Type, i, v);
+    }
+  }
+}
+
+/**
+  * @brief  Copies channel ch of the input frames into Channel, in its own layout
+  */
+static void Extract_Channel(const Multi_Case_t *c, uint32_t ch)
+{
+  uint32_t size = Sample_Size(c->Type);
+  uint32_t n;
+
+  for (n = 0; n < c->Len; n++)
+  {
+    uint32_t i = (c->Layout == FFT_PLANAR) ? ((ch * c->Len) + n) : ((n * c->Channels) + ch);
+
+    memcpy(&((uint8_t *)Channel)[n * size], &((uint8_t *)Input)[i * size], size);
+  }
+}
+
+static void Run(const Multi_Case_t *c, uint32_t *seed)
+{
+  FFT_multi_instance_t multi;
+  FFT_instance_t single;
+  uint32_t out_len = (c->Output == COMPLEX) ? c->Len : (c->Len / 2U);
+  uint32_t mismatches = 0;
+  uint32_t f, ch, k;
+  double t_multi, t_single;
+
+  memset(&multi, 0, sizeof(multi));
+  memset(&single, 0, sizeof(single));
+  multi.init_params.FFT_len = c->Len;
+  multi.init_params.channels = c->Channels;
+  multi.init_params.layout = c->Layout;
+  multi.init_params.win_type = c->Win;
+  multi.init_params.data_type = c->Type;
+  multi.init_params.output_type = c->Output;
+  if (c->UserBuffer != 0U)
+  {
+    HOST_CHECK((uint32_t)FFT_Multi_getMemorySize(&multi) <= sizeof(Arena), "%s: arena of %d bytes", c->Name,
+               (int)FFT_Multi_getMemorySize(&multi));
+    multi.init_params.userBuffer = Arena;
+  }
+  single.init_params.use_direct_process = DIRECT_PROCESS_ENABLED;
+  single.init_params.FFT_len = c->Len;
+  single.init_params.win_type = c->Win;
+  single.init_params.data_type = c->Type;
+  single.init_params.output_type = c->Output;
+  HOST_CHECK(FFT_Multi_Init(&multi) == FFT_ERROR_NONE, "%s: FFT_Multi_Init", c->Name);
+  HOST_CHECK(FFT_Init(&single) == FFT_ERROR_NONE, "%s: FFT_Init", c->Name);
+
+  for (f = 0; f < FRAMES; f++)
+  {
+    Make_Frames(c, seed);
+    HOST_CHECK(FFT_Multi_Process(&multi, Input, Out) == FFT_ERROR_NONE, "%s: FFT_Multi_Process", c->Name);
+    for (ch = 0; ch < c->Channels; ch++)
+    {
+      Extract_Channel(c, ch);
+      (void)FFT_Direct_Process(&single, Channel, Ref);
+      for (k = 0; k < out_len; k++)
+      {
+        mismatches += (Out[(ch * out_len) + k] != Ref[k]) ? 1U : 0U;
+      }
+    }
+  }
+
+  /* One call for all the channels against one call per channel, the deinterleaving left out */
+  t_multi = HostTest_Time();
+  for (f = 0; f < BENCH_FRAMES; f++)
+  {
+    (void)FFT_Multi_Process(&multi, Input, Out);
+  }
+  t_multi = (HostTest_Time() - t_multi) / (double)BENCH_FRAMES;
+  t_single = HostTest_Time();
+  for (f = 0; f < BENCH_FRAMES; f++)
+  {
+    for (ch = 0; ch < c->Channels; ch++)
+    {
+      (void)FFT_Direct_Process(&single, Channel, Ref);
+    }
+  }
+  t_single = (HostTest_Time() - t_single) / (double)BENCH_FRAMES;
+
+  printf("%-36s %4u values differ | %7.2f us/frame, per channel %7.2f us/frame\n", c->Name, (unsigned)mismatches,
+         t_multi * 1e6, t_single * 1e6);
+  HOST_CHECK(mismatches == 0U, "%s: %u spectrum values differ from the per-channel FFT", c->Name, (unsigned)mismatches);
+  (void)FFT_Multi_DeInit(&multi);
+  (void)FFT_DeInit(&single);
+}
+
+int main(int argc, char **argv)
+{
+  FFT_multi_instance_t bad;
+  uint32_t seed = 0xBADC0DEU;
+  uint32_t n;
+
+  HostTest_Init(argc, argv);
+  for (n = 0; n < (sizeof(Cases) / sizeof(Cases[0])); n++)
+  {
+    Run(&Cases[n], &seed);
+  }
+
+  /* Invalid parameters */
+  memset(&bad, 0, sizeof(bad));
+  bad.init_params.FFT_len = 512U;
+  bad.init_params.channels = 0U;
+  HOST_CHECK(FFT_Multi_Init(&bad) == FFT_ERROR_INVALID_PARAMETER, "no channel accepted");
+  bad.init_params.channels = 2U;
+  bad.init_params.FFT_len = 500U;
+  HOST_CHECK(FFT_Multi_Init(&bad) == FFT_ERROR_INVALID_PARAMETER, "FFT length 500 accepted");
+  bad.init_params.FFT_len = 512U;
+  bad.init_params.layout = (FFT_layout_t)2;
+  HOST_CHECK(FFT_Multi_Init(&bad) == FFT_ERROR_INVALID_PARAMETER, "unknown layout accepted");
+  HOST_CHECK(FFT_Multi_Process(&bad, Input, Out) == FFT_ERROR_INVALID_EXECUTION, "process of a failed instance");
+
+  return HostTest_Result("test_fft_multi");
+}
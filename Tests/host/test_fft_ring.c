@@ -0,0 +1,206 @@
+/**
+  ******************************************************************************
+  * @file    test_fft_ring.c
+  * @author  SRA
+  * @brief   GenericFFT: the streaming input of FFT_Data_Input(), its typed
+  *          bulk converters and circular analysis buffer, fed with chunks of
+  *          irregular lengths, against FFT_Direct_Process() of the same frames
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdlib.h>
+#include "fft.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define MAX_LEN            1024U
+#define TEST_SAMPLES       32768U
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  const char *Name;
+  uint32_t Len;
+  float32_t Overlap;
+  FFT_windows_t Win;
+  FFT_data_type_t Type;
+  uint32_t MaxChunk;       /* chunks of 1 to MaxChunk samples */
+} Ring_Case_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const Ring_Case_t Cases[] =
+{
+  { "512 Hann int16, no overlap",          512U, 0.0f,   FFT_HANNING_WIN,         INT16,    700U },
+  { "512 Hamming float, 50%",              512U, 0.5f,   FFT_HAMMING_WIN,         FLOAT32,  300U },
+  { "1024 Hann int16, 75%",               1024U, 0.75f,  FFT_HANNING_WIN,         INT16,    257U },
+  { "1024 rect int32, 75%",               1024U, 0.75f,  FFT_RECT_WIN,            INT32,   3000U },
+  { "256 Blackman-Harris float, 87.5%",    256U, 0.875f, FFT_BLACKMAN_HARRIS_WIN, FLOAT32,   31U },
+  { "256 Tukey 0.25 int16, 50%, 1 sample", 256U, 0.5f,   FFT_TUKEY_0_25_WIN,      INT16,      1U },
+};
+
+static float32_t Signal_F[TEST_SAMPLES];
+static int16_t Signal_S[TEST_SAMPLES];
+static int32_t Signal_L[TEST_SAMPLES];
+static int32_t Frame[MAX_LEN];           /* typed frame of the reference, int32_t or float32_t or int16_t */
+static float32_t Out[MAX_LEN];
+static float32_t Ref[MAX_LEN];
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  A tone, a slow chirp and noise, below full scale
+  */
+static void Make_Signal(void)
+{
+  uint32_t seed = 7U;
+  uint32_t i;
+
+  for (i = 0; i < TEST_SAMPLES; i++)
+  {
+    float t = (float)i / 16000.0f;
+    float v = (0.4f * sinf(2.0f * (float)M_PI * 1000.0f * t)) + (0.2f * sinf(2.0f * (float)M_PI * (100.0f + (500.0f * t)) * t))
+              + (0.1f * HostTest_Noise(&seed));
+
+    Signal_F[i] = v;
+    Signal_S[i] = (int16_t)lrintf(v * 32767.0f);
+    Signal_L[i] = (int32_t)lrint((double)v * 2147483647.0);
+  }
+}
+
+static void *Samples(FFT_data_type_t Type, uint32_t Offset)
+{
+  void *p;
+
+  switch (Type)
+  {
+    case INT16:
+      p = &Signal_S[Offset];
+      break;
+    case INT32:
+      p = &Signal_L[Offset];
+      break;
+    default:
+      p = &Signal_F[Offset];
+      break;
+  }
+  return p;
+}
+
+/**
+  * @brief  The frame of Len samples ending at End, in the input type, zeros
+  *         before the first sample as in the zeroed analysis buffer
+  */
+static void Make_Frame(FFT_data_type_t Type, uint32_t Len, uint32_t End)
+{
+  uint32_t n;
+
+  for (n = 0; n < Len; n++)
+  {
+    int32_t idx = (int32_t)End - (int32_t)Len + (int32_t)n;
+
+    switch (Type)
+    {
+      case INT16:
+        ((int16_t *)Frame)[n] = (idx >= 0) ? Signal_S[idx] : 0;
+        break;
+      case INT32:
+        Frame[n] = (idx >= 0) ? Signal_L[idx] : 0;
+        break;
+      default:
+        ((float32_t *)Frame)[n] = (idx >= 0) ? Signal_F[idx] : 0.0f;
+        break;
+    }
+  }
+}
+
+/**
+  * @brief  Streams the signal in chunks of random lengths and checks every
+  *         completed frame, bit-exact, against the direct FFT of the samples
+  *         of the last completed hop
+  */
+static void Run(const Ring_Case_t *c, uint32_t *seed)
+{
+  FFT_instance_t stream;
+  FFT_instance_t direct;
+  uint32_t hop;
+  uint32_t fed = 0;
+  uint32_t frames = 0, missed = 0, spurious = 0, mismatches = 0;
+
+  memset(&stream, 0, sizeof(stream));
+  memset(&direct, 0, sizeof(direct));
+  stream.init_params.use_direct_process = DIRECT_PROCESS_DISABLED;
+  stream.init_params.FFT_len = c->Len;
+  stream.init_params.overlap = c->Overlap;
+  stream.init_params.win_type = c->Win;
+  stream.init_params.data_type = c->Type;
+  stream.init_params.output_type = COMPLEX;
+  direct.init_params = stream.init_params;
+  direct.init_params.use_direct_process = DIRECT_PROCESS_ENABLED;
+  HOST_CHECK(FFT_Init(&stream) == FFT_ERROR_NONE, "%s: FFT_Init", c->Name);
+  HOST_CHECK(FFT_Init(&direct) == FFT_ERROR_NONE, "%s: FFT_Init direct", c->Name);
+  hop = stream.context.new_data_len;
+
+  while (fed < TEST_SAMPLES)
+  {
+    uint32_t chunk = 1U + (HostTest_Rand(seed) % c->MaxChunk);
+    uint32_t hops;
+    int32_t ret;
+
+    if (chunk > (TEST_SAMPLES - fed))
+    {
+      chunk = TEST_SAMPLES - fed;
+    }
+    hops = ((fed + chunk) / hop) - (fed / hop);
+    ret = FFT_Data_Input(Samples(c->Type, fed), chunk, &stream);
+    fed += chunk;
+    missed += ((hops != 0U) && (ret != 1)) ? 1U : 0U;
+    spurious += ((hops == 0U) && (ret != 0)) ? 1U : 0U;
+    if (ret == 1)
+    {
+      uint32_t k;
+
+      /* The frame is the one of the last hop completed by the chunk */
+      Make_Frame(c->Type, c->Len, (fed / hop) * hop);
+      (void)FFT_Process(&stream, Out);
+      (void)FFT_Direct_Process(&direct, Frame, Ref);
+      for (k = 0; k < c->Len; k++)
+      {
+        mismatches += (Out[k] != Ref[k]) ? 1U : 0U;
+      }
+      frames++;
+    }
+  }
+  printf("%-38s hop %4u: %4u frames, %u missed, %u spurious, %u values differ\n", c->Name, (unsigned)hop,
+         (unsigned)frames, (unsigned)missed, (unsigned)spurious, (unsigned)mismatches);
+  HOST_CHECK(frames > 0U, "%s: no frame", c->Name);
+  HOST_CHECK((missed == 0U) && (spurious == 0U), "%s: %u hops not reported, %u reported without a hop", c->Name,
+             (unsigned)missed, (unsigned)spurious);
+  HOST_CHECK(mismatches == 0U, "%s: %u spectrum values differ from the direct FFT", c->Name, (unsigned)mismatches);
+  (void)FFT_DeInit(&stream);
+  (void)FFT_DeInit(&direct);
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t seed = 0x1234567U;
+  uint32_t n;
+
+  HostTest_Init(argc, argv);
+  Make_Signal();
+  for (n = 0; n < (sizeof(Cases) / sizeof(Cases[0])); n++)
+  {
+    Run(&Cases[n], &seed);
+  }
+  return HostTest_Result("test_fft_ring");
+}
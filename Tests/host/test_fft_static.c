@@ -0,0 +1,254 @@
+/**
+  ******************************************************************************
+  * @file    test_fft_static.c
+  * @author  SRA
+  * @brief   GenericFFT: instances declared with FFT_STATIC_INSTANCE and
+  *          FFT_STATIC_INSTANCE_CONST_WIN against instances allocated by
+  *          FFT_Init on the heap, on the same stream. The static ones must
+  *          not allocate, fill their compile time block exactly and give the
+  *          spectra of the heap ones, bit-exact with a computed window and
+  *          within the rounding of the table with a const one
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdlib.h>
+#include "fft.h"
+#include "fft_windows.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define MAX_LEN            1024U
+#define TEST_SAMPLES       16000U
+#define BLOCK              160U
+/* Window tables against the windows computed at init: a few float rounding steps */
+#define TABLE_BOUND        1e-6f
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  const char *Name;
+  FFT_instance_t *Static;
+  uint32_t BufferBytes;    /* sizeof the block of the static instance */
+  float32_t *Buffer;
+  FFT_windows_t Win;       /* of the heap instance, the one of the table for a const window */
+  float Bound;             /* spectrum error against the heap instance, relative to its peak */
+} Static_Case_t;
+
+/* Private variables ---------------------------------------------------------*/
+FFT_STATIC_INSTANCE(Hann_1024, 1024U, 256U, FFT_HANNING_WIN, INT16, MAGNITUDE);
+FFT_STATIC_INSTANCE(Rect_512, 512U, 512U, FFT_RECT_WIN, FLOAT32, COMPLEX);
+FFT_STATIC_INSTANCE(Blackman_256, 256U, 32U, FFT_BLACKMAN_HARRIS_WIN, INT32, POWER);
+FFT_STATIC_INSTANCE_CONST_WIN(Hann_Table_1024, 1024U, 256U, FFT_Hanning_1024, INT16, MAGNITUDE);
+FFT_STATIC_INSTANCE_CONST_WIN(Hamming_Table_256, 256U, 64U, FFT_Hamming_256, FLOAT32, POWER);
+FFT_STATIC_INSTANCE_CONST_WIN(Hann_Table_512, 512U, 128U, FFT_Hanning_512, FLOAT32, COMPLEX);
+
+static const Static_Case_t Cases[] =
+{
+  { "1024 Hann int16 magnitude",            &Hann_1024,         sizeof(Hann_1024_buffer),         Hann_1024_buffer,
+    FFT_HANNING_WIN,         0.0f },
+  { "512 rect float complex",               &Rect_512,          sizeof(Rect_512_buffer),          Rect_512_buffer,
+    FFT_RECT_WIN,            0.0f },
+  { "256 Blackman-Harris int32 power",      &Blackman_256,      sizeof(Blackman_256_buffer),      Blackman_256_buffer,
+    FFT_BLACKMAN_HARRIS_WIN, 0.0f },
+  { "1024 Hann table int16 magnitude",      &Hann_Table_1024,   sizeof(Hann_Table_1024_buffer),   Hann_Table_1024_buffer,
+    FFT_HANNING_WIN,         1e-5f },
+  { "256 Hamming table float power",        &Hamming_Table_256, sizeof(Hamming_Table_256_buffer), Hamming_Table_256_buffer,
+    FFT_HAMMING_WIN,         1e-5f },
+  { "512 Hann table float complex",         &Hann_Table_512,    sizeof(Hann_Table_512_buffer),    Hann_Table_512_buffer,
+    FFT_HANNING_WIN,         1e-5f },
+};
+
+static const struct
+{
+  const char *Name;
+  const float32_t *Table;
+  uint32_t Len;
+  FFT_windows_t Win;
+} Tables[] =
+{
+  { "FFT_Hanning_256",  FFT_Hanning_256,  256U,  FFT_HANNING_WIN },
+  { "FFT_Hanning_512",  FFT_Hanning_512,  512U,  FFT_HANNING_WIN },
+  { "FFT_Hanning_1024", FFT_Hanning_1024, 1024U, FFT_HANNING_WIN },
+  { "FFT_Hamming_256",  FFT_Hamming_256,  256U,  FFT_HAMMING_WIN },
+  { "FFT_Hamming_512",  FFT_Hamming_512,  512U,  FFT_HAMMING_WIN },
+  { "FFT_Hamming_1024", FFT_Hamming_1024, 1024U, FFT_HAMMING_WIN },
+};
+
+static float32_t Signal_F[TEST_SAMPLES];
+static int16_t Signal_S[TEST_SAMPLES];
+static int32_t Signal_L[TEST_SAMPLES];
+static float32_t Out[MAX_LEN];
+static float32_t Ref[MAX_LEN];
+static uint32_t Heap_Calls;
+
+/* Private functions ---------------------------------------------------------*/
+static void *Refusing_Malloc(size_t size)
+{
+  (void)size;
+  Heap_Calls++;
+  return NULL;
+}
+
+static void Counting_Free(void *ptr)
+{
+  Heap_Calls += (ptr != NULL) ? 1U : 0U;
+}
+
+static void Make_Signal(void)
+{
+  uint32_t seed = 11U;
+  uint32_t i;
+
+  for (i = 0; i < TEST_SAMPLES; i++)
+  {
+    float v = (0.5f * sinf((2.0f * (float)M_PI * 1234.0f * (float)i) / 16000.0f)) + (0.2f * HostTest_Noise(&seed));
+
+    Signal_F[i] = v;
+    Signal_S[i] = (int16_t)lrintf(v * 32767.0f);
+    Signal_L[i] = (int32_t)lrint((double)v * 2147483647.0);
+  }
+}
+
+static void *Samples(FFT_data_type_t Type, uint32_t Offset)
+{
+  void *p;
+
+  switch (Type)
+  {
+    case INT16:
+      p = &Signal_S[Offset];
+      break;
+    case INT32:
+      p = &Signal_L[Offset];
+      break;
+    default:
+      p = &Signal_F[Offset];
+      break;
+  }
+  return p;
+}
+
+static void Run(const Static_Case_t *c)
+{
+  FFT_instance_t *s = c->Static;
+  FFT_instance_t heap;
+  uint32_t out_len = (s->init_params.output_type == COMPLEX) ? s->init_params.FFT_len : (s->init_params.FFT_len / 2U);
+  uint32_t done, k, frames = 0;
+  float error = 0.0f;
+
+  /* Static: the block is the whole memory, the heap is never called */
+  Heap_Calls = 0;
+  FFT_set_allocation_functions(Refusing_Malloc, Counting_Free);
+  HOST_CHECK(FFT_Init(s) == FFT_ERROR_NONE, "%s: FFT_Init of the static instance", c->Name);
+  HOST_CHECK(Heap_Calls == 0U, "%s: %u heap calls", c->Name, (unsigned)Heap_Calls);
+  FFT_set_allocation_functions(malloc, free);
+  HOST_CHECK((uint32_t)FFT_getMemorySize(s) == c->BufferBytes, "%s: FFT_getMemorySize %d, static block %u bytes",
+             c->Name, (int)FFT_getMemorySize(s), (unsigned)c->BufferBytes);
+  HOST_CHECK(((uintptr_t)c->Buffer % FFT_STATIC_ALIGNMENT) == 0U, "%s: block not aligned", c->Name);
+  /* A const window is used as is, nothing computed */
+  HOST_CHECK((s->init_params.userWindow == NULL)
+             || ((s->context.win == NULL) && (s->context.winCoeffs == s->init_params.userWindow)),
+             "%s: window table not used in place", c->Name);
+
+  memset(&heap, 0, sizeof(heap));
+  heap.init_params = s->init_params;
+  heap.init_params.win_type = c->Win;
+  heap.init_params.userBuffer = NULL;
+  heap.init_params.userWindow = NULL;
+  heap.init_params.user_memory = FFT_USER_NONE;
+  HOST_CHECK(FFT_Init(&heap) == FFT_ERROR_NONE, "%s: FFT_Init of the heap instance", c->Name);
+
+  for (done = 0; done < TEST_SAMPLES; done += BLOCK)
+  {
+    int32_t ready = FFT_Data_Input(Samples(s->init_params.data_type, done), BLOCK, s);
+
+    HOST_CHECK(FFT_Data_Input(Samples(s->init_params.data_type, done), BLOCK, &heap) == ready, "%s: hops differ",
+               c->Name);
+    if (ready == 1)
+    {
+      float peak = 0.0f;
+      float e = 0.0f;
+
+      (void)FFT_Process(s, Out);
+      (void)FFT_Process(&heap, Ref);
+      for (k = 0; k < out_len; k++)
+      {
+        peak = (fabsf(Ref[k]) > peak) ? fabsf(Ref[k]) : peak;
+        e = (fabsf(Out[k] - Ref[k]) > e) ? fabsf(Out[k] - Ref[k]) : e;
+      }
+      e /= peak;
+      error = (e > error) ? e : error;
+      frames++;
+    }
+  }
+  printf("%-36s %5u bytes, %3u frames, error %.2e of the peak\n", c->Name, (unsigned)c->BufferBytes, (unsigned)frames,
+         (double)error);
+  HOST_CHECK(frames > 0U, "%s: no frame", c->Name);
+  HOST_CHECK(error <= c->Bound, "%s: error %.2e, bound %.2e", c->Name, (double)error, (double)c->Bound);
+
+  /* A static instance can be initialized again, nothing to free */
+  Heap_Calls = 0;
+  FFT_set_allocation_functions(Refusing_Malloc, Counting_Free);
+  (void)FFT_DeInit(s);
+  HOST_CHECK(FFT_Init(s) == FFT_ERROR_NONE, "%s: FFT_Init again", c->Name);
+  (void)FFT_DeInit(s);
+  HOST_CHECK(Heap_Calls == 0U, "%s: %u heap calls", c->Name, (unsigned)Heap_Calls);
+  FFT_set_allocation_functions(malloc, free);
+  (void)FFT_DeInit(&heap);
+}
+
+/**
+  * @brief  The const tables of fft_windows.h against the windows FFT_Init computes
+  */
+static void Check_Tables(void)
+{
+  uint32_t t, n;
+
+  for (t = 0; t < (sizeof(Tables) / sizeof(Tables[0])); t++)
+  {
+    FFT_instance_t heap;
+    float error = 0.0f;
+
+    memset(&heap, 0, sizeof(heap));
+    heap.init_params.use_direct_process = DIRECT_PROCESS_ENABLED;
+    heap.init_params.FFT_len = Tables[t].Len;
+    heap.init_params.win_type = Tables[t].Win;
+    heap.init_params.data_type = FLOAT32;
+    heap.init_params.output_type = COMPLEX;
+    (void)FFT_Init(&heap);
+    for (n = 0; n < Tables[t].Len; n++)
+    {
+      float e = fabsf(Tables[t].Table[n] - heap.context.win[n]);
+
+      error = (e > error) ? e : error;
+    }
+    HOST_CHECK(error <= TABLE_BOUND, "%s: %.2e from the computed window", Tables[t].Name, (double)error);
+    (void)FFT_DeInit(&heap);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t n;
+
+  HostTest_Init(argc, argv);
+  Make_Signal();
+  Check_Tables();
+  for (n = 0; n < (sizeof(Cases) / sizeof(Cases[0])); n++)
+  {
+    Run(&Cases[n]);
+  }
+  return HostTest_Result("test_fft_static");
+}
@@ -0,0 +1,237 @@
+/**
+  ******************************************************************************
+  * @file    test_fft_stft.c
+  * @author  SRA
+  * @brief   GenericFFT: FFT_STFT_Process() analysis and weighted overlap-add
+  *          synthesis must give the input back, delayed by FFT_len samples in
+  *          buffered mode and by FFT_len - hop in low latency mode, for the
+  *          windows whose square is COLA at several hops, and windows that
+  *          are not must be refused
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdlib.h>
+#include "fft.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define TEST_SAMPLES       20000U
+/* Float round trip: the forward and inverse rfft and the window products, against a 0.7 full scale signal */
+#define FLOAT_BOUND        2e-6f
+/* int16: the input and output quantization, one LSB, plus the float round trip */
+#define INT16_BOUND        (1.0f + (32768.0f * FLOAT_BOUND))
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  const char *Name;
+  uint32_t Len;
+  uint32_t Hop;
+  FFT_windows_t Win;
+  FFT_stft_latency_t Latency;
+  FFT_data_type_t Type;
+  float Gain;              /* applied to the spectrum by the callback, 0: no callback */
+} Stft_Case_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const Stft_Case_t Cases[] =
+{
+  { "512 Hann, hop 128, buffered",            512U, 128U, FFT_HANNING_WIN,      FFT_STFT_BUFFERED,    FLOAT32, 0.0f },
+  { "512 Hann, hop 128, low latency",         512U, 128U, FFT_HANNING_WIN,      FFT_STFT_LOW_LATENCY, FLOAT32, 0.0f },
+  { "256 Hann, hop 32, buffered",             256U,  32U, FFT_HANNING_WIN,      FFT_STFT_BUFFERED,    FLOAT32, 0.0f },
+  { "256 Hann, hop 32, low latency",          256U,  32U, FFT_HANNING_WIN,      FFT_STFT_LOW_LATENCY, FLOAT32, 0.0f },
+  { "512 sqrt Hann, hop 256, buffered",       512U, 256U, FFT_SQRT_HANNING_WIN, FFT_STFT_BUFFERED,    FLOAT32, 0.0f },
+  { "512 sqrt Hann, hop 256, low latency",    512U, 256U, FFT_SQRT_HANNING_WIN, FFT_STFT_LOW_LATENCY, FLOAT32, 0.0f },
+  { "1024 sqrt Hann, hop 256, buffered",     1024U, 256U, FFT_SQRT_HANNING_WIN, FFT_STFT_BUFFERED,    FLOAT32, 0.0f },
+  { "1024 sqrt Hann, hop 256, low latency",  1024U, 256U, FFT_SQRT_HANNING_WIN, FFT_STFT_LOW_LATENCY, FLOAT32, 0.0f },
+  { "256 rect, hop 256, buffered",            256U, 256U, FFT_RECT_WIN,         FFT_STFT_BUFFERED,    FLOAT32, 0.0f },
+  { "256 rect, hop 256, low latency",         256U, 256U, FFT_RECT_WIN,         FFT_STFT_LOW_LATENCY, FLOAT32, 0.0f },
+  { "256 rect, hop 64, buffered",             256U,  64U, FFT_RECT_WIN,         FFT_STFT_BUFFERED,    FLOAT32, 0.0f },
+  { "256 rect, hop 64, low latency",          256U,  64U, FFT_RECT_WIN,         FFT_STFT_LOW_LATENCY, FLOAT32, 0.0f },
+  { "512 Hamming, hop 128, low latency",      512U, 128U, FFT_HAMMING_WIN,      FFT_STFT_LOW_LATENCY, FLOAT32, 0.0f },
+  { "512 sqrt Hann int16 in place, buffered", 512U, 256U, FFT_SQRT_HANNING_WIN, FFT_STFT_BUFFERED,    INT16,   0.0f },
+  { "512 Hann, hop 128, callback gain 0.5",   512U, 128U, FFT_HANNING_WIN,      FFT_STFT_LOW_LATENCY, FLOAT32, 0.5f },
+};
+
+static float32_t Input[TEST_SAMPLES];
+static float32_t Output[TEST_SAMPLES];
+static int16_t Samples[TEST_SAMPLES];
+static uint32_t Frames;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Spectrum callback: a flat gain, counting the frames
+  */
+static void Gain_Callback(float32_t *spectrum, uint32_t len, void *param)
+{
+  arm_scale_f32(spectrum, *(float *)param, spectrum, len);
+  Frames++;
+}
+
+/**
+  * @brief  Two tones, a chirp and noise, 0.7 full scale at most
+  */
+static void Make_Signal(void)
+{
+  uint32_t seed = 3U;
+  uint32_t i;
+
+  for (i = 0; i < TEST_SAMPLES; i++)
+  {
+    float t = (float)i / 16000.0f;
+
+    Input[i] = (0.3f * sinf(2.0f * (float)M_PI * 440.0f * t)) + (0.2f * sinf(2.0f * (float)M_PI * 3000.0f * t))
+               + (0.1f * sinf(2.0f * (float)M_PI * (200.0f + (800.0f * t)) * t)) + (0.1f * HostTest_Noise(&seed));
+  }
+}
+
+/**
+  * @brief  Streams the signal in blocks of random lengths, multiples of the hop
+  *         in low latency mode, and compares the output with the delayed input
+  */
+static void Run(const Stft_Case_t *c, uint32_t *seed)
+{
+  FFT_stft_instance_t stft;
+  uint32_t delay = (c->Latency == FFT_STFT_BUFFERED) ? c->Len : (c->Len - c->Hop);
+  uint32_t done = 0;
+  uint32_t n;
+  float gain = (c->Gain != 0.0f) ? c->Gain : 1.0f;
+  float error = 0.0f;
+  float bound = (c->Type == INT16) ? (INT16_BOUND / 32768.0f) : FLOAT_BOUND;
+
+  memset(&stft, 0, sizeof(stft));
+  stft.init_params.FFT_len = c->Len;
+  stft.init_params.hop = c->Hop;
+  stft.init_params.win_type = c->Win;
+  stft.init_params.data_type = c->Type;
+  stft.init_params.latency = c->Latency;
+  if (c->Gain != 0.0f)
+  {
+    stft.init_params.callback = Gain_Callback;
+    stft.init_params.callback_param = &gain;
+  }
+  Frames = 0;
+  HOST_CHECK(FFT_STFT_Init(&stft) == FFT_ERROR_NONE, "%s: FFT_STFT_Init", c->Name);
+
+  if (c->Type == INT16)
+  {
+    for (n = 0; n < TEST_SAMPLES; n++)
+    {
+      Samples[n] = (int16_t)lrintf(Input[n] * 32767.0f);
+    }
+  }
+
+  while (done < TEST_SAMPLES)
+  {
+    uint32_t len = (c->Latency == FFT_STFT_BUFFERED) ? (1U + (HostTest_Rand(seed) % (3U * c->Len)))
+                   : (c->Hop * (1U + (HostTest_Rand(seed) % 4U)));
+
+    if (len > (TEST_SAMPLES - done))
+    {
+      len = (c->Latency == FFT_STFT_BUFFERED) ? (TEST_SAMPLES - done) : (((TEST_SAMPLES - done) / c->Hop) * c->Hop);
+    }
+    if (len == 0U)
+    {
+      break;
+    }
+    if (c->Type == INT16)
+    {
+      /* In place: the output overwrites the input block */
+      HOST_CHECK(FFT_STFT_Process(&stft, &Samples[done], &Samples[done], len) == FFT_ERROR_NONE, "%s: process",
+                 c->Name);
+    }
+    else
+    {
+      HOST_CHECK(FFT_STFT_Process(&stft, &Input[done], &Output[done], len) == FFT_ERROR_NONE, "%s: process", c->Name);
+    }
+    done += len;
+  }
+
+  for (n = 0; n < done; n++)
+  {
+    float expected = (n >= delay) ? (gain * Input[n - delay]) : 0.0f;
+    float out;
+    float e;
+
+    if (c->Type == INT16)
+    {
+      expected = (n >= delay) ? ((float)(int16_t)lrintf(Input[n - delay] * 32767.0f) / 32768.0f) : 0.0f;
+      out = (float)Samples[n] / 32768.0f;
+    }
+    else
+    {
+      out = Output[n];
+    }
+    e = fabsf(out - expected);
+    error = (e > error) ? e : error;
+  }
+  printf("%-40s delay %4u: %5u samples, error max %.2e\n", c->Name, (unsigned)delay, (unsigned)done, (double)error);
+  HOST_CHECK(error <= bound, "%s: error %.2e, bound %.2e", c->Name, (double)error, (double)bound);
+  HOST_CHECK((c->Gain == 0.0f) || (Frames == (done / c->Hop)), "%s: %u callbacks for %u hops", c->Name,
+             (unsigned)Frames, (unsigned)(done / c->Hop));
+  (void)FFT_STFT_DeInit(&stft);
+}
+
+/**
+  * @brief  Initializes an instance that must be refused
+  */
+static void Refused(const char *Name, uint32_t Len, uint32_t Hop, FFT_windows_t Win)
+{
+  FFT_stft_instance_t stft;
+
+  memset(&stft, 0, sizeof(stft));
+  stft.init_params.FFT_len = Len;
+  stft.init_params.hop = Hop;
+  stft.init_params.win_type = Win;
+  stft.init_params.data_type = FLOAT32;
+  stft.init_params.latency = FFT_STFT_BUFFERED;
+  HOST_CHECK(FFT_STFT_Init(&stft) == FFT_ERROR_INVALID_PARAMETER, "%s accepted", Name);
+  (void)FFT_STFT_DeInit(&stft);
+}
+
+int main(int argc, char **argv)
+{
+  FFT_stft_instance_t stft;
+  uint32_t seed = 0xC0FFEEU;
+  uint32_t n;
+
+  HostTest_Init(argc, argv);
+  Make_Signal();
+  for (n = 0; n < (sizeof(Cases) / sizeof(Cases[0])); n++)
+  {
+    Run(&Cases[n], &seed);
+  }
+
+  /* The squared window is not COLA, or the hop does not divide the frame */
+  Refused("Hann, hop FFT_len / 2", 512U, 256U, FFT_HANNING_WIN);
+  Refused("sqrt Hann, hop FFT_len", 512U, 512U, FFT_SQRT_HANNING_WIN);
+  Refused("Blackman-Harris, hop FFT_len / 2", 512U, 256U, FFT_BLACKMAN_HARRIS_WIN);
+  Refused("hop 100 of 512", 512U, 100U, FFT_RECT_WIN);
+  Refused("hop 0", 512U, 0U, FFT_RECT_WIN);
+
+  /* Low latency blocks must be whole hops */
+  memset(&stft, 0, sizeof(stft));
+  stft.init_params.FFT_len = 512U;
+  stft.init_params.hop = 128U;
+  stft.init_params.win_type = FFT_HANNING_WIN;
+  stft.init_params.data_type = FLOAT32;
+  stft.init_params.latency = FFT_STFT_LOW_LATENCY;
+  HOST_CHECK(FFT_STFT_Init(&stft) == FFT_ERROR_NONE, "low latency init");
+  HOST_CHECK(FFT_STFT_Process(&stft, Input, Output, 100U) == FFT_ERROR_INVALID_PARAMETER,
+             "low latency block of 100 samples accepted");
+  (void)FFT_STFT_DeInit(&stft);
+
+  return HostTest_Result("test_fft_stft");
+}
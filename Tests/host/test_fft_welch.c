@@ -0,0 +1,254 @@
+/**
+  ******************************************************************************
+  * @file    test_fft_welch.c
+  * @author  SRA
+  * @brief   GenericFFT: the Welch accumulator of FFT_Welch_Data_Input(). The
+  *          PSD of white noise must be flat at its variance, the one of a
+  *          tone peak at the level of its window and hold its power in the
+  *          band around it, whatever the window, with block and exponential
+  *          averaging, and the per-bin statistics must bound the PSD
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdlib.h>
+#include "fft.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define LEN                512U
+#define BINS               (LEN / 2U)
+#define MAX_SAMPLES        (LEN * 200U)   /* 400 segments of half a frame */
+#define BLOCK              333U    /* not a divisor of the hop */
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+  SIGNAL_NOISE = 0, SIGNAL_TONE
+} Signal_t;
+
+typedef struct
+{
+  const char *Name;
+  Signal_t Signal;
+  float Amplitude;         /* noise: uniform in [-a, a), tone: a sin */
+  float Bin;               /* tone frequency in bins */
+  FFT_windows_t Win;
+  FFT_data_type_t Type;
+  FFT_welch_averaging_t Averaging;
+  uint32_t Frames;
+  float Alpha;
+  float Bound;             /* relative error of the expected level */
+} Welch_Case_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const Welch_Case_t Cases[] =
+{
+  { "noise, Hann, block of 200",             SIGNAL_NOISE, 0.5f,  0.0f,  FFT_HANNING_WIN,  FLOAT32, FFT_WELCH_BLOCK,       200U, 0.0f,  0.03f },
+  { "noise, rect, block of 200",             SIGNAL_NOISE, 0.5f,  0.0f,  FFT_RECT_WIN,     FLOAT32, FFT_WELCH_BLOCK,       200U, 0.0f,  0.03f },
+  { "noise int16, Hamming, exponential",     SIGNAL_NOISE, 0.25f, 0.0f,  FFT_HAMMING_WIN,  INT16,   FFT_WELCH_EXPONENTIAL, 400U, 0.02f, 0.05f },
+  { "tone on bin 40, Hann, block of 20",     SIGNAL_TONE,  0.5f,  40.0f, FFT_HANNING_WIN,  FLOAT32, FFT_WELCH_BLOCK,        20U, 0.0f,  0.005f },
+  { "tone on bin 40.5, Hann, block of 20",   SIGNAL_TONE,  0.5f,  40.5f, FFT_HANNING_WIN,  FLOAT32, FFT_WELCH_BLOCK,        20U, 0.0f,  0.01f },
+  { "tone int16 on bin 100.3, Blackman-Harris", SIGNAL_TONE, 0.3f, 100.3f, FFT_BLACKMAN_HARRIS_WIN, INT16, FFT_WELCH_BLOCK, 20U, 0.0f, 0.01f },
+};
+
+static float32_t Signal_F[MAX_SAMPLES];
+static int16_t Signal_S[MAX_SAMPLES];
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Fills the signal of the case, in both input types
+  * @retval Variance of the signal as seen by the library
+  */
+static float Make_Signal(const Welch_Case_t *c, uint32_t Samples, uint32_t *seed)
+{
+  double power = 0.0;
+  uint32_t i;
+
+  /* The tone phase restarts every 100 frames, a whole number of periods of the bins used, to keep it accurate */
+  for (i = 0; i < Samples; i++)
+  {
+    float v = (c->Signal == SIGNAL_NOISE) ? (c->Amplitude * HostTest_Noise(seed))
+              : (c->Amplitude * sinf((2.0f * (float)M_PI * c->Bin * (float)(i % (LEN * 100U))) / (float)LEN));
+
+    Signal_S[i] = (int16_t)lrintf(v * 32768.0f);
+    Signal_F[i] = (c->Type == INT16) ? ((float)Signal_S[i] / 32768.0f) : v;
+    power += (double)Signal_F[i] * (double)Signal_F[i];
+  }
+  return (float)(power / (double)Samples);
+}
+
+/**
+  * @brief  Sum of the window coefficients and of their squares, as computed by the library
+  */
+static void Window_Sums(FFT_instance_t *fft, double *sum, double *sum_sq)
+{
+  uint32_t n;
+
+  *sum = 0.0;
+  *sum_sq = 0.0;
+  for (n = 0; n < LEN; n++)
+  {
+    double w = (fft->context.winCoeffs != NULL) ? (double)fft->context.winCoeffs[n] : 1.0;
+
+    *sum += w;
+    *sum_sq += w * w;
+  }
+}
+
+static void Run(const Welch_Case_t *c, uint32_t *seed)
+{
+  FFT_instance_t fft;
+  FFT_welch_instance_t welch;
+  uint16_t edges[2];
+  uint32_t hop = LEN / 2U;
+  /* The first segments hold the zeros of the analysis buffer: the block PSD is the one of the second result
+     period, the exponential one has forgotten them. The signal ends with a result period. */
+  uint32_t segments = (c->Averaging == FFT_WELCH_BLOCK) ? (2U * c->Frames) : (8U * (c->Frames / 8U));
+  uint32_t samples = segments * hop;
+  uint32_t done = 0, results = 0, reported = 0, bad_stats = 0;
+  uint32_t k;
+  float variance;
+  double mean = 0.0, lo = INFINITY, hi = 0.0;
+  double sum, sum_sq;
+
+  variance = Make_Signal(c, samples, seed);
+
+  memset(&fft, 0, sizeof(fft));
+  memset(&welch, 0, sizeof(welch));
+  fft.init_params.use_direct_process = DIRECT_PROCESS_DISABLED;
+  fft.init_params.FFT_len = LEN;
+  fft.init_params.overlap = 0.5f;
+  fft.init_params.win_type = c->Win;
+  fft.init_params.data_type = c->Type;
+  fft.init_params.output_type = POWER;
+  HOST_CHECK(FFT_Init(&fft) == FFT_ERROR_NONE, "%s: FFT_Init", c->Name);
+  Window_Sums(&fft, &sum, &sum_sq);
+
+  welch.init_params.averaging = c->Averaging;
+  welch.init_params.frames = c->Frames;
+  welch.init_params.alpha = c->Alpha;
+  welch.init_params.stats = FFT_WELCH_STAT_MIN | FFT_WELCH_STAT_MAX | FFT_WELCH_STAT_PEAK_HOLD;
+  welch.init_params.peak_decay = 1.0f;
+  if (c->Signal == SIGNAL_TONE)
+  {
+    /* The main lobe of the window and then some */
+    edges[0] = (uint16_t)(c->Bin - 6.0f);
+    edges[1] = (uint16_t)(c->Bin + 7.0f);
+    welch.init_params.band_edges = edges;
+    welch.init_params.num_bands = 1U;
+  }
+  if (c->Averaging == FFT_WELCH_EXPONENTIAL)
+  {
+    /* A result every 8 segments, the average running over the whole signal */
+    welch.init_params.frames = 8U;
+  }
+  HOST_CHECK(FFT_Welch_Init(&welch, &fft) == FFT_ERROR_NONE, "%s: FFT_Welch_Init", c->Name);
+
+  while (done < samples)
+  {
+    uint32_t len = ((samples - done) < BLOCK) ? (samples - done) : BLOCK;
+    void *data = (c->Type == INT16) ? (void *)&Signal_S[done] : (void *)&Signal_F[done];
+
+    if (FFT_Welch_Data_Input(data, len, &welch) == 1)
+    {
+      reported++;
+    }
+    done += len;
+  }
+  results = welch.context.results;
+
+  /* The statistics of the last result period bound its block average */
+  for (k = 1; k < BINS; k++)
+  {
+    float psd = welch.context.psd[k];
+
+    if (c->Averaging == FFT_WELCH_BLOCK)
+    {
+      bad_stats += ((welch.context.min[k] > psd) || (welch.context.max[k] < psd)) ? 1U : 0U;
+    }
+    bad_stats += (welch.context.peak[k] < welch.context.max[k]) ? 1U : 0U;
+  }
+
+  if (c->Signal == SIGNAL_NOISE)
+  {
+    /* E|X_k|^2 = variance * sum(w^2), divided by the window energy: the variance in every bin but the packed
+       DC/Nyquist one */
+    for (k = 1; k < BINS; k++)
+    {
+      double psd = (double)welch.context.psd[k];
+
+      mean += psd;
+      lo = (psd < lo) ? psd : lo;
+      hi = (psd > hi) ? psd : hi;
+    }
+    mean /= (double)(BINS - 1U);
+    printf("%-42s %3u results, PSD mean %.4e (variance %.4e), bins in [%.2f, %.2f] of it\n", c->Name,
+           (unsigned)results, mean, (double)variance, lo / mean, hi / mean);
+    HOST_CHECK(fabs((mean / (double)variance) - 1.0) <= (double)c->Bound, "%s: PSD %.4e, variance %.4e", c->Name,
+               mean, (double)variance);
+    HOST_CHECK((lo > (0.5 * mean)) && (hi < (1.5 * mean)), "%s: PSD not flat, bins in [%.2f, %.2f] of the mean",
+               c->Name, lo / mean, hi / mean);
+  }
+  else
+  {
+    /* Parseval: the positive frequencies hold LEN * A^2 / 4 once divided by the window energy. A tone on a bin
+       peaks at (A * sum(w) / 2)^2 / sum(w^2) */
+    double band = (double)welch.context.bands[0];
+    double expected_band = (double)LEN * (double)c->Amplitude * (double)c->Amplitude / 4.0;
+    double peak = (double)welch.context.psd[(uint32_t)c->Bin];
+    double expected_peak = ((double)c->Amplitude * sum / 2.0) * ((double)c->Amplitude * sum / 2.0) / sum_sq;
+
+    printf("%-42s %3u results, band %.4e (expected %.4e), peak %.4e (on a bin %.4e)\n", c->Name, (unsigned)results,
+           band, expected_band, peak, expected_peak);
+    HOST_CHECK(fabs((band / expected_band) - 1.0) <= (double)c->Bound, "%s: band %.4e, expected %.4e", c->Name, band,
+               expected_band);
+    HOST_CHECK((c->Bin != floorf(c->Bin)) || (fabs((peak / expected_peak) - 1.0) <= (double)c->Bound),
+               "%s: peak %.4e, expected %.4e", c->Name, peak, expected_peak);
+  }
+  HOST_CHECK((results > 0U) && (reported == results), "%s: %u results, %u reported", c->Name, (unsigned)results,
+             (unsigned)reported);
+  HOST_CHECK(bad_stats == 0U, "%s: %u bins outside of their min/max/peak", c->Name, (unsigned)bad_stats);
+  (void)FFT_Welch_DeInit(&welch);
+  (void)FFT_DeInit(&fft);
+}
+
+int main(int argc, char **argv)
+{
+  FFT_instance_t fft;
+  FFT_welch_instance_t welch;
+  uint32_t seed = 0x5EED5U;
+  uint32_t n;
+
+  HostTest_Init(argc, argv);
+  for (n = 0; n < (sizeof(Cases) / sizeof(Cases[0])); n++)
+  {
+    Run(&Cases[n], &seed);
+  }
+
+  /* Only a streaming POWER instance can be accumulated */
+  memset(&fft, 0, sizeof(fft));
+  memset(&welch, 0, sizeof(welch));
+  fft.init_params.FFT_len = LEN;
+  fft.init_params.overlap = 0.5f;
+  fft.init_params.win_type = FFT_HANNING_WIN;
+  fft.init_params.data_type = FLOAT32;
+  fft.init_params.output_type = MAGNITUDE;
+  (void)FFT_Init(&fft);
+  welch.init_params.frames = 10U;
+  HOST_CHECK(FFT_Welch_Init(&welch, &fft) == FFT_ERROR_INVALID_PARAMETER, "MAGNITUDE instance accepted");
+  (void)FFT_DeInit(&fft);
+
+  return HostTest_Result("test_fft_welch");
+}
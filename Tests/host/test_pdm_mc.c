@@ -0,0 +1,356 @@
+/**
+  ******************************************************************************
+  * @file    test_pdm_mc.c
+  * @author  SRA
+  * @brief   Multi-channel PDM to PCM decimator of Addons/PDM_MC against a bit
+  *          by bit reference: 64-bit CIC integrators stepped on each PDM bit,
+  *          then the combs, FIR, DC removal and gain of the library. The
+  *          outputs must be bit-exact for every decimation, channel count,
+  *          block length, byte order, layout and gain, and the tones of a
+  *          sigma-delta modulator must come out at their level with the
+  *          SINAD of the decimation. -b also times both.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdlib.h>
+#include "pdm2pcm_mc.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define TEST_MS            400U
+#define BENCH_MS           4000U
+#define SETTLE_MS          100U    /* FIR and DC removal transients, left out of the tone measures */
+
+#define TONE_HZ            1000.0
+#define TONE_STEP_HZ       100.0   /* tone of microphone c: TONE_HZ + c * TONE_STEP_HZ */
+
+/* Full-scale PDM maps to full-scale PCM at 0 dB of gain: a tone comes out at
+   its modulator level within the passband ripple of the droop compensation */
+#define LEVEL_BOUND_DB     0.15
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  const char *Name;
+  uint32_t Decimation;
+  uint32_t Fs;
+  uint32_t Channels;
+  uint32_t Samples;        /* output samples per channel and per call */
+  uint32_t Endianness;
+  PDM2PCM_MC_layout_t Layout;
+  int32_t Gain;            /* dB */
+  double Amplitude;        /* of the modulator input tones, full scale 1 */
+  double MinSinad;         /* dB, 0: the output clips, bit-exactness only */
+} PDM_Case_t;
+
+typedef struct
+{
+  int64_t integrator[PDM2PCM_MC_CIC_ORDER];
+  int64_t comb[PDM2PCM_MC_CIC_ORDER];
+  int32_t delay[PDM2PCM_MC_FIR_TAPS];
+  uint32_t phase;
+  int32_t hp_in;
+  int32_t hp_out;
+} Ref_Channel_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const PDM_Case_t Cases[] =
+{
+  { "1.024 MHz 4 mics, 16 kHz",              64U, 16000U, 4U, 16U, PDM2PCM_MC_ENDIANNESS_LE, PDM2PCM_MC_OUTPUT_INTERLEAVED,   0, 0.5,  66.0 },
+  { "1.28 MHz 2 mics, 16 kHz, planar",       80U, 16000U, 2U, 16U, PDM2PCM_MC_ENDIANNESS_LE, PDM2PCM_MC_OUTPUT_PLANAR,        0, 0.5,  70.0 },
+  { "1.024 MHz 1 mic on I2S, 8 kHz",        128U,  8000U, 1U,  8U, PDM2PCM_MC_ENDIANNESS_BE, PDM2PCM_MC_OUTPUT_INTERLEAVED,   0, 0.5,  76.0 },
+  { "1.536 MHz 4 mics, 32 kHz, planar",      48U, 32000U, 4U, 32U, PDM2PCM_MC_ENDIANNESS_LE, PDM2PCM_MC_OUTPUT_PLANAR,        0, 0.5,  60.0 },
+  { "768 kHz 3 mics, 48 kHz",                16U, 48000U, 3U, 48U, PDM2PCM_MC_ENDIANNESS_LE, PDM2PCM_MC_OUTPUT_INTERLEAVED,   0, 0.5,  36.0 },
+  { "2.048 MHz 2 mics, 8 kHz",              256U,  8000U, 2U,  8U, PDM2PCM_MC_ENDIANNESS_LE, PDM2PCM_MC_OUTPUT_INTERLEAVED,   0, 0.5,  76.0 },
+  { "1.024 MHz 4 mics, 16 kHz, 5 samples",   64U, 16000U, 4U,  5U, PDM2PCM_MC_ENDIANNESS_LE, PDM2PCM_MC_OUTPUT_PLANAR,        0, 0.5,  66.0 },
+  { "1.024 MHz 2 mics, 16 kHz, +12 dB",      64U, 16000U, 2U, 16U, PDM2PCM_MC_ENDIANNESS_LE, PDM2PCM_MC_OUTPUT_INTERLEAVED,  12, 0.1,  54.0 },
+  { "1.024 MHz 2 mics, 16 kHz, -12 dB",      64U, 16000U, 2U, 16U, PDM2PCM_MC_ENDIANNESS_LE, PDM2PCM_MC_OUTPUT_INTERLEAVED, -12, 0.5,  60.0 },
+  { "1.024 MHz 4 mics, 16 kHz, clipping",    64U, 16000U, 4U, 16U, PDM2PCM_MC_ENDIANNESS_LE, PDM2PCM_MC_OUTPUT_INTERLEAVED,  24, 0.5,   0.0 },
+};
+
+/* The FIR taps of pdm2pcm_mc.c */
+static const int16_t Ref_Fir[(PDM2PCM_MC_FIR_TAPS + 1U) / 2U] =
+{
+  -1, -1, 0, -2, 3, 16, -5, -56, -5, 138, 56, -276,
+  -195, 470, 496, -698, -1072, 894, 2139, -895, -4332, -67, 11108, 17335
+};
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Second order sigma-delta modulator of a tone, one bit per byte
+  */
+static void Modulate(double Amplitude, double Freq, double Offset, double Fpdm, uint32_t Bits, uint8_t *pBits)
+{
+  double i1 = 0.0, i2 = 0.0, y = 0.0, x;
+  uint32_t k;
+
+  for (k = 0; k < Bits; k++)
+  {
+    x = (Amplitude * sin(2.0 * M_PI * Freq * (double)k / Fpdm)) + Offset;
+    i1 += x - y;
+    i2 += i1 - y;
+    y = (i2 >= 0.0) ? 1.0 : -1.0;
+    pBits[k] = (y > 0.0) ? 1U : 0U;
+  }
+}
+
+/**
+  * @brief  Output samples of a channel, one PDM bit at a time through the CIC
+  *         and with the scales the instance computed
+  */
+static void Ref_Process(const PDM2PCM_MC_instance_t *inst, Ref_Channel_t *r, const uint8_t *pBits, uint32_t Bits,
+                        int16_t *pOut)
+{
+  uint32_t ratio = inst->init_params.decimation / 2U;
+  uint32_t k, j, n = 0, count = 0;
+  int64_t v, t, acc;
+  int32_t x, y;
+
+  for (k = 0; k < Bits; k++)
+  {
+    r->integrator[0] += (pBits[k] != 0U) ? 1 : -1;
+    for (j = 1; j < PDM2PCM_MC_CIC_ORDER; j++)
+    {
+      r->integrator[j] += r->integrator[j - 1U];
+    }
+    if (++count < ratio)
+    {
+      continue;
+    }
+    count = 0;
+    v = r->integrator[PDM2PCM_MC_CIC_ORDER - 1U];
+    for (j = 0; j < PDM2PCM_MC_CIC_ORDER; j++)
+    {
+      t = v - r->comb[j];
+      r->comb[j] = v;
+      v = t;
+    }
+    memmove(&r->delay[0], &r->delay[1], (PDM2PCM_MC_FIR_TAPS - 1U) * sizeof(int32_t));
+    r->delay[PDM2PCM_MC_FIR_TAPS - 1U] = (int32_t)((v * inst->cic_scale) >> inst->cic_shift);
+    if (++r->phase < 2U)
+    {
+      continue;
+    }
+    r->phase = 0;
+
+    acc = 0;
+    for (j = 0; j < PDM2PCM_MC_FIR_TAPS; j++)
+    {
+      acc += (int64_t)r->delay[j] * Ref_Fir[(j < ((PDM2PCM_MC_FIR_TAPS + 1U) / 2U)) ? j : (PDM2PCM_MC_FIR_TAPS - 1U - j)];
+    }
+    x = (int32_t)(acc >> 15);
+    y = x - r->hp_in + (int32_t)(((int64_t)r->hp_out * inst->hp_pole) >> 31);
+    r->hp_in = x;
+    r->hp_out = y;
+    acc = ((int64_t)y * inst->gain) >> 24;
+    pOut[n++] = (int16_t)((acc > 32767) ? 32767 : ((acc < -32768) ? -32768 : acc));
+  }
+}
+
+/**
+  * @brief  Level, in dB of full scale, and SINAD of a tone
+  */
+static void Tone_Measure(const int16_t *pIn, uint32_t Count, double Freq, double Fs, double *pLevel, double *pSinad)
+{
+  double s = 0.0, c = 0.0, p = 0.0, a;
+  uint32_t k;
+
+  for (k = 0; k < Count; k++)
+  {
+    s += (double)pIn[k] * sin(2.0 * M_PI * Freq * (double)k / Fs);
+    c += (double)pIn[k] * cos(2.0 * M_PI * Freq * (double)k / Fs);
+    p += (double)pIn[k] * (double)pIn[k];
+  }
+  a = 2.0 * sqrt((s * s) + (c * c)) / (double)Count;
+  *pLevel = 20.0 * log10(a / 32768.0);
+  *pSinad = 10.0 * log10((a * a / 2.0) / ((p / (double)Count) - (a * a / 2.0)));
+}
+
+static void Run(const PDM_Case_t *c, uint32_t ms)
+{
+  PDM2PCM_MC_instance_t inst;
+  Ref_Channel_t ref[PDM2PCM_MC_MAX_CHANNELS];
+  uint32_t ratio = c->Decimation / 2U;
+  uint32_t calls = (ms * c->Fs) / (1000U * c->Samples);
+  uint32_t samples = calls * c->Samples;
+  uint32_t bits = samples * c->Decimation;
+  uint32_t call_bytes = (c->Samples * c->Decimation) / 8U;
+  uint8_t *pdm_bits = malloc((size_t)bits * c->Channels);
+  uint8_t *pdm = malloc((size_t)(bits / 8U) * c->Channels);
+  int16_t *out = malloc((size_t)samples * c->Channels * sizeof(int16_t));
+  int16_t *chan = malloc((size_t)samples * sizeof(int16_t));
+  int16_t *ref_out = malloc((size_t)samples * sizeof(int16_t));
+  uint32_t settle = (SETTLE_MS * c->Fs) / 1000U;
+  uint32_t ch, k, n, b, mismatches = 0;
+  double t0, t_lib, t_ref = 0.0, level, sinad, expected, scale_error;
+  double worst_level = 0.0, worst_sinad = 1e9;
+
+  /* byte-interleaved PDM of the microphones, bits MSB first */
+  for (ch = 0; ch < c->Channels; ch++)
+  {
+    Modulate(c->Amplitude, TONE_HZ + (TONE_STEP_HZ * ch), 0.001 * ch, (double)c->Fs * c->Decimation, bits,
+             &pdm_bits[(size_t)ch * bits]);
+    for (b = 0; b < (bits / 8U); b++)
+    {
+      uint8_t v = 0;
+
+      for (k = 0; k < 8U; k++)
+      {
+        v = (uint8_t)((v << 1) | pdm_bits[((size_t)ch * bits) + (b * 8U) + k]);
+      }
+      pdm[((size_t)b * c->Channels) + ch] = v;
+    }
+  }
+  if (c->Endianness == PDM2PCM_MC_ENDIANNESS_BE)
+  {
+    /* an I2S peripheral stores 16-bit words: the bytes come swapped */
+    for (b = 0; b < (bits / 8U); b += 2U)
+    {
+      uint8_t t = pdm[b];
+
+      pdm[b] = pdm[b + 1U];
+      pdm[b + 1U] = t;
+    }
+  }
+
+  memset(&inst, 0, sizeof(inst));
+  inst.init_params.channels = c->Channels;
+  inst.init_params.decimation = c->Decimation;
+  inst.init_params.samples = c->Samples;
+  inst.init_params.sample_rate = c->Fs;
+  inst.init_params.endianness = c->Endianness;
+  inst.init_params.mic_gain = c->Gain;
+  inst.init_params.layout = c->Layout;
+  if (PDM2PCM_MC_Init(&inst) != PDM2PCM_MC_ERROR_NONE)
+  {
+    HOST_CHECK(0, "%s: PDM2PCM_MC_Init failed", c->Name);
+    goto end;
+  }
+  /* the CIC scale maps its full scale, ratio^4, to 1.0 in PDM2PCM_MC_CIC_BITS fractional bits */
+  scale_error = ((double)inst.cic_scale * pow((double)ratio, 4.0) / ldexp(1.0, 23 + (int)inst.cic_shift)) - 1.0;
+  HOST_CHECK(fabs(scale_error) < 1e-8, "%s: CIC scale off by %g", c->Name, scale_error);
+
+  t0 = HostTest_Time();
+  for (n = 0; n < calls; n++)
+  {
+    (void)PDM2PCM_MC_Process(&inst, &pdm[(size_t)n * call_bytes * c->Channels], &out[(size_t)n * c->Samples * c->Channels]);
+  }
+  t_lib = HostTest_Time() - t0;
+
+  memset(ref, 0, sizeof(ref));
+  for (ch = 0; ch < c->Channels; ch++)
+  {
+    for (n = 0; n < calls; n++)
+    {
+      for (k = 0; k < c->Samples; k++)
+      {
+        chan[(n * c->Samples) + k] = (c->Layout == PDM2PCM_MC_OUTPUT_PLANAR) ?
+                                     out[(((size_t)n * c->Channels) + ch) * c->Samples + k] :
+                                     out[(((size_t)n * c->Samples) + k) * c->Channels + ch];
+      }
+    }
+    t0 = HostTest_Time();
+    Ref_Process(&inst, &ref[ch], &pdm_bits[(size_t)ch * bits], bits, ref_out);
+    t_ref += HostTest_Time() - t0;
+    for (k = 0; k < samples; k++)
+    {
+      mismatches += (chan[k] != ref_out[k]) ? 1U : 0U;
+    }
+
+    if (c->MinSinad > 0.0)
+    {
+      Tone_Measure(&chan[settle], samples - settle, TONE_HZ + (TONE_STEP_HZ * ch), (double)c->Fs, &level, &sinad);
+      expected = 20.0 * log10(c->Amplitude) + (double)c->Gain;
+      worst_level = (fabs(level - expected) > fabs(worst_level)) ? (level - expected) : worst_level;
+      worst_sinad = (sinad < worst_sinad) ? sinad : worst_sinad;
+    }
+  }
+
+  printf("%-38s %u mismatches", c->Name, (unsigned)mismatches);
+  if (c->MinSinad > 0.0)
+  {
+    printf(", level %+.3f dB, SINAD %.1f dB", worst_level, worst_sinad);
+  }
+  printf(" | %.2f us per ms and microphone, bit by bit %.2f us\n",
+         t_lib * 1e6 / ((double)ms * c->Channels), t_ref * 1e6 / ((double)ms * c->Channels));
+  HOST_CHECK(mismatches == 0U, "%s: %u samples differ from the bit by bit reference", c->Name, (unsigned)mismatches);
+  if (c->MinSinad > 0.0)
+  {
+    HOST_CHECK(fabs(worst_level) <= LEVEL_BOUND_DB, "%s: level off by %.3f dB", c->Name, worst_level);
+    HOST_CHECK(worst_sinad >= c->MinSinad, "%s: SINAD %.1f dB, bound %.1f dB", c->Name, worst_sinad, c->MinSinad);
+  }
+
+end:
+  free(pdm_bits);
+  free(pdm);
+  free(out);
+  free(chan);
+  free(ref_out);
+}
+
+/**
+  * @brief  Parameters PDM2PCM_MC_Init, PDM2PCM_MC_SetGain and
+  *         PDM2PCM_MC_Process reject
+  */
+static void Check_Parameters(void)
+{
+  static const uint32_t bad[][3] =   /* channels, decimation, endianness */
+  {
+    { 0U, 64U, PDM2PCM_MC_ENDIANNESS_LE }, { PDM2PCM_MC_MAX_CHANNELS + 1U, 64U, PDM2PCM_MC_ENDIANNESS_LE },
+    { 1U, 8U, PDM2PCM_MC_ENDIANNESS_LE }, { 1U, 40U, PDM2PCM_MC_ENDIANNESS_LE }, { 1U, 272U, PDM2PCM_MC_ENDIANNESS_LE },
+    { 2U, 64U, PDM2PCM_MC_ENDIANNESS_BE }, { 1U, 64U, 2U }
+  };
+  PDM2PCM_MC_instance_t inst;
+  uint8_t in[8] = { 0 };
+  int16_t out[1];
+  uint32_t i;
+
+  for (i = 0; i < (sizeof(bad) / sizeof(bad[0])); i++)
+  {
+    memset(&inst, 0, sizeof(inst));
+    inst.init_params.channels = bad[i][0];
+    inst.init_params.decimation = bad[i][1];
+    inst.init_params.endianness = bad[i][2];
+    inst.init_params.samples = 1U;
+    inst.init_params.sample_rate = 16000U;
+    HOST_CHECK(PDM2PCM_MC_Init(&inst) == PDM2PCM_MC_ERROR_INVALID_PARAMETER,
+               "%u channels, decimation %u, endianness %u accepted", (unsigned)bad[i][0], (unsigned)bad[i][1],
+               (unsigned)bad[i][2]);
+  }
+
+  memset(&inst, 0, sizeof(inst));
+  inst.init_params.channels = 1U;
+  inst.init_params.decimation = 64U;
+  inst.init_params.samples = 1U;
+  inst.init_params.sample_rate = 16000U;
+  HOST_CHECK(PDM2PCM_MC_Init(&inst) == PDM2PCM_MC_ERROR_NONE, "1 channel, decimation 64 rejected");
+  HOST_CHECK(PDM2PCM_MC_SetGain(&inst, 52) == PDM2PCM_MC_ERROR_INVALID_PARAMETER, "gain of 52 dB accepted");
+  HOST_CHECK(PDM2PCM_MC_SetGain(&inst, -13) == PDM2PCM_MC_ERROR_INVALID_PARAMETER, "gain of -13 dB accepted");
+  HOST_CHECK(PDM2PCM_MC_Process(&inst, NULL, out) == PDM2PCM_MC_ERROR_INVALID_PARAMETER, "NULL input accepted");
+  HOST_CHECK(PDM2PCM_MC_Process(&inst, in, NULL) == PDM2PCM_MC_ERROR_INVALID_PARAMETER, "NULL output accepted");
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t i;
+
+  HostTest_Init(argc, argv);
+  Check_Parameters();
+  for (i = 0; i < sizeof(Cases) / sizeof(Cases[0]); i++)
+  {
+    Run(&Cases[i], HostTest_Bench ? BENCH_MS : TEST_MS);
+  }
+  return HostTest_Result("test_pdm_mc");
+}
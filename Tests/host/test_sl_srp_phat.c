@@ -0,0 +1,357 @@
+/**
+  ******************************************************************************
+  * @file    test_sl_srp_phat.c
+  * @author  SRA
+  * @brief   AcousticSL: accuracy and cost of SRP-PHAT against GCC-PHAT on the
+  *          4 microphones of the CCA02M2, SRP-PHAT on 6 microphone circles,
+  *          and the sources of AcousticSL_ProcessMulti() with two talkers
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdlib.h>
+#include "acoustic_sl.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define FS                 16000U
+#define SAMPLES_PER_MS     (FS / 1000U)
+#define WINDOW             256U
+#define RESOLUTION         4U
+#define SOURCE_TONES       64U
+#define SOUND_SPEED        343.1f
+#define TEST_MS            160U    /* 10 windows: the histogram tracker settles */
+#define BENCH_MS           4000U
+#define AZIMUTH_STEP       15
+
+/* Largest azimuth error accepted over the sweep, in degrees */
+#define MAX_ERROR          (2 * (int32_t)RESOLUTION)
+#define MAX_SOURCES        4U
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  const char *Name;
+  uint32_t Algorithm;
+  uint32_t Mics;
+  int16_t Coordinates[ACOUSTIC_SL_SRPP_MAX_CHANNELS][3];  /* decimals of a millimeter */
+} SL_Setup_t;
+
+typedef struct
+{
+  const char *Name;
+  uint32_t Setup;          /* index in Setups */
+  int32_t Azimuth[2];      /* louder source first */
+  float Gain2;             /* amplitude of the second source, the first is 1 */
+  uint32_t MinSeparation;  /* 0: ACOUSTIC_SL_DEFAULT_MIN_SEPARATION */
+  uint8_t Suppressed;      /* the second source is closer to the first than MinSeparation */
+} SL_Pair_Case_t;
+
+typedef struct
+{
+  int32_t MaxError;
+  float MeanError;
+  uint32_t Frames;
+  double Seconds;
+} SL_Result_t;
+
+/* Private variables ---------------------------------------------------------*/
+/* MIC1/MIC2 and MIC3/MIC4 as the two orthogonal 40 mm pairs of GCC-PHAT, the
+   coordinates are the ones its atan2 of the pair angles assumes */
+static const SL_Setup_t Setups[] =
+{
+  { "GCCP 4 mics", ACOUSTIC_SL_ALGORITHM_GCCP, 4U,
+    { { 0, -200, 0 }, { 0, 200, 0 }, { -200, 0, 0 }, { 200, 0, 0 } } },
+  { "SRPP 4 mics", ACOUSTIC_SL_ALGORITHM_SRPP, 4U,
+    { { 0, -200, 0 }, { 0, 200, 0 }, { -200, 0, 0 }, { 200, 0, 0 } } },
+  { "SRPP 6 mics", ACOUSTIC_SL_ALGORITHM_SRPP, 6U,
+    { { 200, 0, 0 }, { 100, 173, 0 }, { -100, 173, 0 }, { -200, 0, 0 }, { -100, -173, 0 }, { 100, -173, 0 } } },
+  { "SRPP 6 100mm", ACOUSTIC_SL_ALGORITHM_SRPP, 6U,
+    { { 1000, 0, 0 }, { 500, 866, 0 }, { -500, 866, 0 }, { -1000, 0, 0 }, { -500, -866, 0 }, { 500, -866, 0 } } },
+};
+
+/* Two uncorrelated talkers on the 100 mm circle, the 20 mm ones cannot tell them apart: each scene with a
+   suppression radius below the distance of the talkers, then above it */
+static const SL_Pair_Case_t Pair_Cases[] =
+{
+  { "60/200, default radius",  3U, {  60, 200 }, 0.7f,   0U, 0U },
+  { "60/200, radius 150",      3U, {  60, 200 }, 0.7f, 150U, 1U },
+  { "300/240, radius 40",      3U, { 300, 240 }, 0.8f,  40U, 0U },
+  { "300/240, radius 70",      3U, { 300, 240 }, 0.8f,  70U, 1U },
+};
+
+static float Tone_Freq[SOURCE_TONES];
+static float Tone_Phase[SOURCE_TONES];
+/* Talkers of the pair cases: each holds its own bands, as speech mostly does, the first one wider ones */
+static float Pair_Freq[2][SOURCE_TONES];
+static float Pair_Phase[2][SOURCE_TONES];
+
+/* Private functions ---------------------------------------------------------*/
+static int32_t Angle_Error(int32_t estimate, int32_t truth)
+{
+  int32_t e = abs(estimate - truth) % 360;
+
+  return (e > 180) ? (360 - e) : e;
+}
+
+/**
+  * @brief  Delays of a far-field source from the given azimuth at each microphone
+  */
+static void Set_Delays(const SL_Setup_t *setup, int32_t azimuth, float *delay)
+{
+  float ux = cosf((float)azimuth * (float)M_PI / 180.0f);
+  float uy = sinf((float)azimuth * (float)M_PI / 180.0f);
+  uint32_t m;
+
+  for (m = 0; m < setup->Mics; m++)
+  {
+    delay[m] = (((float)setup->Coordinates[m][0] * ux) + ((float)setup->Coordinates[m][1] * uy)) / (10000.0f * SOUND_SPEED);
+  }
+}
+
+/**
+  * @brief  One millisecond of interleaved samples from time t: the broadband
+  *         source of the sweep or, with gain2 > 0, the two talkers, plus
+  *         uncorrelated noise 20 dB below the first one on each microphone
+  */
+static void Make_Block(const SL_Setup_t *setup, const float *delay1, const float *delay2, float gain2, uint32_t t,
+                       int16_t *buffer, uint32_t *seed)
+{
+  const float *freq1 = (gain2 > 0.0f) ? Pair_Freq[0] : Tone_Freq;
+  const float *phase1 = (gain2 > 0.0f) ? Pair_Phase[0] : Tone_Phase;
+  uint32_t m, i, k;
+
+  for (i = 0; i < SAMPLES_PER_MS; i++, t++)
+  {
+    for (m = 0; m < setup->Mics; m++)
+    {
+      float time = (float)t / (float)FS;
+      float v = 0.0f;
+
+      for (k = 0; k < SOURCE_TONES; k++)
+      {
+        v += cosf((2.0f * (float)M_PI * freq1[k] * (time + delay1[m])) + phase1[k]);
+        if (gain2 > 0.0f)
+        {
+          v += gain2 * cosf((2.0f * (float)M_PI * Pair_Freq[1][k] * (time + delay2[m])) + Pair_Phase[1][k]);
+        }
+      }
+      v += HostTest_Noise(seed) * 0.1f * sqrtf((float)SOURCE_TONES);
+      buffer[(i * setup->Mics) + m] = (int16_t)(v * 150.0f);
+    }
+  }
+}
+
+/**
+  * @brief  Initializes a handler for the setup, memory from the heap
+  */
+static void Init(const SL_Setup_t *setup, AcousticSL_Handler_t *handler)
+{
+  AcousticSL_Config_t config;
+
+  memset(handler, 0, sizeof(*handler));
+  memset(&config, 0, sizeof(config));
+  handler->algorithm = setup->Algorithm;
+  handler->sampling_frequency = FS;
+  handler->channel_number = setup->Mics;
+  handler->ptr_M1_channels = setup->Mics;
+  handler->ptr_M2_channels = setup->Mics;
+  handler->ptr_M3_channels = setup->Mics;
+  handler->ptr_M4_channels = setup->Mics;
+  handler->M12_distance = 400;
+  handler->M34_distance = 400;
+  handler->samples_to_process = WINDOW;
+  memcpy(handler->mic_coordinates, setup->Coordinates, sizeof(handler->mic_coordinates));
+  HOST_CHECK(AcousticSL_getMemorySize(handler) == 0U, "%s: getMemorySize", setup->Name);
+  handler->pInternalMemory = calloc(1, handler->internal_memory_size);
+  HOST_CHECK(AcousticSL_Init(handler) == 0U, "%s: Init", setup->Name);
+  memset(&config, 0, sizeof(config));
+  config.resolution = RESOLUTION;
+  config.threshold = 1;
+  HOST_CHECK(AcousticSL_setConfig(handler, &config) == 0U, "%s: setConfig", setup->Name);
+}
+
+/**
+  * @brief  Feeds a far-field broadband source from the given azimuth
+  * @retval Last estimated angle
+  */
+static int32_t Run(const SL_Setup_t *setup, int32_t azimuth, uint32_t ms_total, SL_Result_t *res)
+{
+  AcousticSL_Handler_t handler;
+  int16_t buffer[SAMPLES_PER_MS * ACOUSTIC_SL_SRPP_MAX_CHANNELS];
+  float delay[ACOUSTIC_SL_SRPP_MAX_CHANNELS];
+  uint32_t seed = 0x1234567U;
+  int32_t angle = ACOUSTIC_SL_NO_AUDIO_DETECTED;
+  uint32_t ms;
+
+  Init(setup, &handler);
+  Set_Delays(setup, azimuth, delay);
+  for (ms = 0; ms < ms_total; ms++)
+  {
+    Make_Block(setup, delay, delay, 0.0f, ms * SAMPLES_PER_MS, buffer, &seed);
+    if (AcousticSL_Data_Input(&buffer[0], &buffer[1], &buffer[2], &buffer[3], &handler) == 1U)
+    {
+      double start = HostTest_Time();
+
+      (void)AcousticSL_Process(&angle, &handler);
+      res->Seconds += HostTest_Time() - start;
+      res->Frames++;
+    }
+  }
+  free(handler.pInternalMemory);
+  return angle;
+}
+
+/**
+  * @brief  Two talkers through AcousticSL_ProcessMulti(): the louder one
+  *         first, the other one reported unless within the suppression
+  *         radius, confidences in decreasing order and read from the map
+  */
+static void Run_Pair(const SL_Pair_Case_t *c)
+{
+  const SL_Setup_t *setup = &Setups[c->Setup];
+  AcousticSL_Handler_t handler;
+  AcousticSL_MultiOutput_t out;
+  AcousticSL_Source_t sources[MAX_SOURCES];
+  float map[ACOUSTIC_SL_SRP_MAP_MAX_LENGTH];
+  int16_t buffer[SAMPLES_PER_MS * ACOUSTIC_SL_SRPP_MAX_CHANNELS];
+  float delay1[ACOUSTIC_SL_SRPP_MAX_CHANNELS];
+  float delay2[ACOUSTIC_SL_SRPP_MAX_CHANNELS];
+  uint32_t radius = (c->MinSeparation > 0U) ? c->MinSeparation : ACOUSTIC_SL_DEFAULT_MIN_SEPARATION;
+  uint32_t seed = 0x7654321U;
+  uint32_t ms, i, j, found2 = 0, close = 0, unordered = 0;
+  int32_t index;
+
+  Init(setup, &handler);
+  Set_Delays(setup, c->Azimuth[0], delay1);
+  Set_Delays(setup, c->Azimuth[1], delay2);
+  memset(&out, 0, sizeof(out));
+  out.pSources = sources;
+  out.max_sources = MAX_SOURCES;
+  out.min_separation = c->MinSeparation;
+  out.pSRP_map = map;
+  out.SRP_map_size = ACOUSTIC_SL_SRP_MAP_MAX_LENGTH;
+
+  for (ms = 0; ms < TEST_MS; ms++)
+  {
+    Make_Block(setup, delay1, delay2, c->Gain2, ms * SAMPLES_PER_MS, buffer, &seed);
+    if (AcousticSL_Data_Input(&buffer[0], &buffer[1], &buffer[2], &buffer[3], &handler) == 1U)
+    {
+      (void)AcousticSL_ProcessMulti(&out, &handler);
+    }
+  }
+
+  printf("%-36s", c->Name);
+  for (i = 0; i < out.sources_number; i++)
+  {
+    printf(" %3d (%.2f)", (int)sources[i].angle, (double)sources[i].confidence);
+    found2 += ((i > 0U) && (Angle_Error(sources[i].angle, c->Azimuth[1]) <= MAX_ERROR)) ? 1U : 0U;
+    unordered += ((i > 0U) && (sources[i].confidence > sources[i - 1U].confidence)) ? 1U : 0U;
+    for (j = 0; j < i; j++)
+    {
+      close += (Angle_Error(sources[i].angle, sources[j].angle) < (int32_t)radius) ? 1U : 0U;
+    }
+  }
+  printf("\n");
+
+  HOST_CHECK(out.sources_number >= 1U, "%s: no source", c->Name);
+  HOST_CHECK(Angle_Error(sources[0].angle, c->Azimuth[0]) <= MAX_ERROR, "%s: first source %d, talker at %d", c->Name,
+             (int)sources[0].angle, (int)c->Azimuth[0]);
+  HOST_CHECK(close == 0U, "%s: %u sources within %u degrees of a stronger one", c->Name, (unsigned)close,
+             (unsigned)radius);
+  HOST_CHECK(unordered == 0U, "%s: confidences not in decreasing order", c->Name);
+  HOST_CHECK((sources[0].confidence > 0.0f) && (sources[0].confidence <= 1.0f), "%s: confidence %.3f", c->Name,
+             (double)sources[0].confidence);
+  if (c->Suppressed == 0U)
+  {
+    HOST_CHECK((out.sources_number >= 2U) && (found2 == 1U)
+               && (Angle_Error(sources[1].angle, c->Azimuth[1]) <= MAX_ERROR),
+               "%s: second talker at %d not the second source", c->Name, (int)c->Azimuth[1]);
+  }
+  else
+  {
+    HOST_CHECK(found2 == 0U, "%s: second talker reported within the radius", c->Name);
+  }
+
+  /* The confidence is the map at the source, the map covers the circle */
+  HOST_CHECK(out.SRP_map_length == (360U / RESOLUTION), "%s: map of %u points", c->Name, (unsigned)out.SRP_map_length);
+  index = (int32_t)lrintf(((float)sources[0].angle - out.SRP_map_first_angle) / out.SRP_map_step);
+  index = (index + (int32_t)out.SRP_map_length) % (int32_t)out.SRP_map_length;
+  HOST_CHECK(map[index] == sources[0].confidence, "%s: map %.4f at the first source, confidence %.4f", c->Name,
+             (double)map[index], (double)sources[0].confidence);
+  free(handler.pInternalMemory);
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t seed = 42U;
+  double gccp_cost = 0.0;
+  uint32_t s, k;
+
+  HostTest_Init(argc, argv);
+  for (k = 0; k < SOURCE_TONES; k++)
+  {
+    Tone_Freq[k] = 200.0f + (3800.0f * (0.5f + (0.5f * HostTest_Noise(&seed))));
+    Tone_Phase[k] = (float)M_PI * HostTest_Noise(&seed);
+  }
+  for (k = 0; k < SOURCE_TONES; k++)
+  {
+    float band = 200.0f + (300.0f * (float)(k % 12U));
+
+    Pair_Freq[0][k] = band + (100.0f * (1.0f + HostTest_Noise(&seed)));
+    Pair_Phase[0][k] = (float)M_PI * HostTest_Noise(&seed);
+    Pair_Freq[1][k] = band + 250.0f + (25.0f * HostTest_Noise(&seed));
+    Pair_Phase[1][k] = (float)M_PI * HostTest_Noise(&seed);
+  }
+
+  for (s = 0; s < sizeof(Setups) / sizeof(Setups[0]); s++)
+  {
+    const SL_Setup_t *setup = &Setups[s];
+    SL_Result_t res;
+    int32_t azimuth, points = 0;
+    double cost;
+
+    memset(&res, 0, sizeof(res));
+    for (azimuth = 0; azimuth < 360; azimuth += AZIMUTH_STEP)
+    {
+      int32_t angle = Run(setup, azimuth, HostTest_Bench ? BENCH_MS : TEST_MS, &res);
+      int32_t error = Angle_Error(angle, azimuth);
+
+      HOST_CHECK(error <= MAX_ERROR, "%s: azimuth %d estimated %d", setup->Name, (int)azimuth, (int)angle);
+      res.MaxError = (error > res.MaxError) ? error : res.MaxError;
+      res.MeanError += (float)error;
+      points++;
+    }
+    res.MeanError /= (float)points;
+    cost = res.Seconds * 1e6 / (double)res.Frames;
+    if (setup->Algorithm == ACOUSTIC_SL_ALGORITHM_GCCP)
+    {
+      gccp_cost = cost;
+    }
+    printf("%-12s error max %3d mean %5.2f deg | %6u frames, %8.1f us/frame, %7.0f frames/s",
+           setup->Name, (int)res.MaxError, (double)res.MeanError, (unsigned)res.Frames, cost, 1e6 / cost);
+    if (gccp_cost > 0.0)
+    {
+      printf(", x%.2f GCCP", cost / gccp_cost);
+    }
+    printf("\n");
+  }
+
+  for (s = 0; s < sizeof(Pair_Cases) / sizeof(Pair_Cases[0]); s++)
+  {
+    Run_Pair(&Pair_Cases[s]);
+  }
+
+  return HostTest_Result("test_sl_srp_phat");
+}
@@ -0,0 +1,394 @@
+/**
+  ******************************************************************************
+  * @file    test_sl_track.c
+  * @author  SRA
+  * @brief   AcousticSL: the alpha-beta tracker. Fed with clean steps, it wraps
+  *          its angle on the circle, 359.5 and above reported as 0, and holds
+  *          it at the ends of the range of a single pair; behind
+  *          AcousticSL_ProcessMulti(), it follows a talker moving around the
+  *          4 microphones of the CCA02M2 across 0/360 degrees and reports its
+  *          angular velocity
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdlib.h>
+/* The library itself: the tracker and the internal state are static */
+#include "AcousticSL.c"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+/* SOUND_SPEED is the one of the library */
+#define FS                 16000U
+#define SAMPLES_PER_MS     (FS / 1000U)
+#define WINDOW             256U
+#define HOP                128U
+#define MAX_MICS           4U
+#define SOURCE_TONES       64U
+#define SETTLE_MS          500U    /* the tracker locks on the talker and its velocity */
+#define STEP_UPDATES       250U    /* 2 s of updates of the tracker, one per hop */
+#define STEP_SETTLE        60U
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  const char *Name;
+  uint32_t Algorithm;
+  uint32_t Mics;
+  uint32_t Resolution;
+  float Start;             /* azimuth of the talker at time 0, degrees */
+  float Rate;              /* angular velocity of the talker, degrees per second */
+  uint32_t MoveMs;         /* the talker stops after it, 0: moves all along */
+  uint32_t Ms;
+  float MaxError;          /* tracked angle against the talker, after settling, degrees */
+  float VelocityError;     /* mean reported velocity against the talker one while it moves, degrees per
+                              second, 0: not checked */
+} Track_Case_t;
+
+typedef struct
+{
+  float MaxError;
+  float Velocity;          /* mean reported velocity while the talker moves */
+  uint32_t Moving;
+  int32_t Min;             /* range of the estimates */
+  int32_t Max;
+  uint32_t Estimates;
+  uint32_t Wrapped;        /* estimates on either side of 0/360 after one another */
+} Track_Result_t;
+
+/* Private variables ---------------------------------------------------------*/
+/* Same cross as test_sl_srp_phat: MIC1/MIC2 and MIC3/MIC4 are the 40 mm pairs */
+static const int16_t Coordinates[MAX_MICS][3] =
+{
+  { 0, -200, 0 }, { 0, 200, 0 }, { -200, 0, 0 }, { 200, 0, 0 }
+};
+
+static const Track_Case_t Cases[] =
+{
+  { "SRPP 4 mics, +30 deg/s across 0",   ACOUSTIC_SL_ALGORITHM_SRPP, 4U, 4U, 315.0f,  30.0f, 0U, 3000U, 12.0f, 15.0f },
+  { "SRPP 4 mics, -30 deg/s across 0",   ACOUSTIC_SL_ALGORITHM_SRPP, 4U, 4U,  45.0f, -30.0f, 0U, 3000U, 12.0f, 15.0f },
+  { "GCCP 4 mics, +45 deg/s across 0",   ACOUSTIC_SL_ALGORITHM_GCCP, 4U, 1U, 300.0f,  45.0f, 0U, 3000U, 15.0f, 20.0f },
+  { "GCCP 4 mics, still at 359.5 deg",   ACOUSTIC_SL_ALGORITHM_GCCP, 4U, 1U, 359.5f,   0.0f, 0U, 2000U,  4.0f,  5.0f },
+  { "GCCP 2 mics, +60 deg/s to 80 deg",  ACOUSTIC_SL_ALGORITHM_GCCP, 2U, 1U,  20.0f,  60.0f, 1000U, 2500U, 15.0f,  0.0f },
+  { "GCCP 2 mics, -60 deg/s to -80 deg", ACOUSTIC_SL_ALGORITHM_GCCP, 2U, 1U, -20.0f, -60.0f, 1000U, 2500U, 15.0f,  0.0f },
+};
+
+static float Tone_Freq[SOURCE_TONES];
+static float Tone_Phase[SOURCE_TONES];
+
+/* Private functions ---------------------------------------------------------*/
+static float Angle_Error(float estimate, float truth)
+{
+  float e = fmodf(fabsf(estimate - truth), 360.0f);
+
+  return (e > 180.0f) ? (360.0f - e) : e;
+}
+
+/**
+  * @brief  Initializes the library with the alpha-beta tracker
+  * @retval The internal state, where the tracker is reached
+  */
+static libSoundSourceLoc_Handler_Internal *Tracker_Init(AcousticSL_Handler_t *handler, uint32_t Algorithm,
+                                                        uint32_t Mics, uint32_t Resolution)
+{
+  AcousticSL_Config_t config;
+
+  memset(handler, 0, sizeof(*handler));
+  memset(&config, 0, sizeof(config));
+  handler->algorithm = Algorithm;
+  handler->sampling_frequency = FS;
+  handler->channel_number = Mics;
+  handler->ptr_M1_channels = Mics;
+  handler->ptr_M2_channels = Mics;
+  handler->ptr_M3_channels = Mics;
+  handler->ptr_M4_channels = Mics;
+  handler->M12_distance = 400;
+  handler->M34_distance = 400;
+  handler->samples_to_process = WINDOW;
+  handler->hop_size = HOP;
+  memcpy(handler->mic_coordinates, Coordinates, sizeof(Coordinates));
+  HOST_CHECK(AcousticSL_getMemorySize(handler) == 0U, "getMemorySize");
+  handler->pInternalMemory = calloc(1, handler->internal_memory_size);
+  HOST_CHECK(AcousticSL_Init(handler) == 0U, "Init");
+  config.resolution = Resolution;
+  config.threshold = 1;
+  config.tracker = ACOUSTIC_SL_TRACKER_ALPHA_BETA;
+  HOST_CHECK(AcousticSL_setConfig(handler, &config) == 0U, "setConfig");
+  return (libSoundSourceLoc_Handler_Internal *)handler->pInternalMemory;
+}
+
+/**
+  * @brief  Steps the tracker on the circle with clean measurements of a talker
+  *         moving at Rate from Start, then holds it through missed ones
+  */
+static void Step_Circle(float Start, float Rate)
+{
+  AcousticSL_Handler_t handler;
+  libSoundSourceLoc_Handler_Internal *sl = Tracker_Init(&handler, ACOUSTIC_SL_ALGORITHM_GCCP, 4U, 1U);
+  float truth = Start;
+  float error = 0.0f;
+  float velocity = 0.0f;
+  int32_t angle, last = -1;
+  uint32_t n, wraps = 0, out = 0;
+
+  for (n = 0; n < STEP_UPDATES; n++)
+  {
+    truth = fmodf(Start + (Rate * sl->Track_Period * (float)n) + 360.0f, 360.0f);
+    angle = (int32_t)lroundf(truth) % 360;
+    TrackAngle(sl, &angle, 360U);
+    out += ((angle < 0) || (angle > 359)) ? 1U : 0U;
+    wraps += ((last >= 0) && (abs(angle - last) > 180)) ? 1U : 0U;
+    last = angle;
+    if (n >= STEP_SETTLE)
+    {
+      float e = Angle_Error((float)angle, truth);
+
+      error = (e > error) ? e : error;
+      velocity += sl->Track_Velocity;
+    }
+  }
+  /* The measurements are whole degrees: the velocity jitters around the rate */
+  velocity /= (float)(STEP_UPDATES - STEP_SETTLE);
+  printf("circle %6.1f deg %+5.1f deg/s: error max %4.2f deg, velocity %6.2f deg/s, %u wraps\n", (double)Start,
+         (double)Rate, (double)error, (double)velocity, (unsigned)wraps);
+  HOST_CHECK(out == 0U, "circle %+.1f deg/s: %u angles out of [0, 359]", (double)Rate, (unsigned)out);
+  HOST_CHECK(error <= 1.0f, "circle %+.1f deg/s: error %.2f deg", (double)Rate, (double)error);
+  HOST_CHECK(fabsf(velocity - Rate) <= 0.5f, "circle %+.1f deg/s: velocity %.2f deg/s", (double)Rate,
+             (double)velocity);
+  HOST_CHECK(wraps == ((Rate == 0.0f) ? 0U : 1U), "circle %+.1f deg/s: %u wraps", (double)Rate, (unsigned)wraps);
+
+  /* Missed detections: the last direction is held with a decaying velocity */
+  angle = -1;
+  TrackAngle(sl, &angle, 360U);
+  HOST_CHECK((angle == last) || (Angle_Error((float)angle, (float)last) <= 1.0f), "circle %+.1f deg/s: held at %d, "
+             "tracked %d", (double)Rate, (int)angle, (int)last);
+  HOST_CHECK(fabsf(sl->Track_Velocity) < fabsf(Rate) || (Rate == 0.0f), "circle %+.1f deg/s: velocity %.2f deg/s held",
+             (double)Rate, (double)sl->Track_Velocity);
+  free(handler.pInternalMemory);
+}
+
+/**
+  * @brief  The tracked angle in [359.5, 360) reported as 0 and not 360, whether
+  *         it is updated or held through a missed detection
+  */
+static void Step_Round(void)
+{
+  AcousticSL_Handler_t handler;
+  libSoundSourceLoc_Handler_Internal *sl = Tracker_Init(&handler, ACOUSTIC_SL_ALGORITHM_GCCP, 4U, 1U);
+  int32_t angle;
+  uint32_t n, bad = 0;
+
+  for (n = 0; n < STEP_UPDATES; n++)
+  {
+    /* A talker at 359.5: the measurements alternate between 359 and 0 */
+    angle = ((n % 2U) == 0U) ? 359 : 0;
+    TrackAngle(sl, &angle, 360U);
+    bad += ((angle != 359) && (angle != 0)) ? 1U : 0U;
+  }
+  HOST_CHECK(bad == 0U, "359.5 deg: %u angles not 359 or 0", (unsigned)bad);
+
+  sl->Track_Angle = 359.7f;
+  sl->Track_Velocity = 0.0f;
+  angle = -1;
+  TrackAngle(sl, &angle, 360U);
+  HOST_CHECK(angle == 0, "359.7 deg held: %d", (int)angle);
+  angle = 0;
+  TrackAngle(sl, &angle, 360U);
+  HOST_CHECK(angle == 0, "359.7 deg updated with 0: %d", (int)angle);
+  free(handler.pInternalMemory);
+}
+
+/**
+  * @brief  Steps the tracker of a single pair, range [0, 180], with a talker
+  *         moving at Rate into the end of the range and staying there: the
+  *         overshooting track is held at the end, its velocity dropped
+  */
+static void Step_Pair(float Start, float Rate)
+{
+  AcousticSL_Handler_t handler;
+  libSoundSourceLoc_Handler_Internal *sl = Tracker_Init(&handler, ACOUSTIC_SL_ALGORITHM_GCCP, 2U, 1U);
+  float end = (Rate > 0.0f) ? 180.0f : 0.0f;
+  int32_t angle;
+  uint32_t n, out = 0, saturated = 0;
+
+  for (n = 0; n < STEP_UPDATES; n++)
+  {
+    float truth = Start + (Rate * sl->Track_Period * (float)n);
+
+    truth = (Rate > 0.0f) ? fminf(truth, end) : fmaxf(truth, end);
+    angle = (int32_t)lroundf(truth);
+    TrackAngle(sl, &angle, 180U);
+    out += ((angle < 0) || (angle > 180)) ? 1U : 0U;
+    if (sl->Track_Angle == end)
+    {
+      /* Held at the end: no velocity carries the track beyond it */
+      saturated++;
+      HOST_CHECK(sl->Track_Velocity == 0.0f, "pair %+.1f deg/s: velocity %.2f deg/s at the end", (double)Rate,
+                 (double)sl->Track_Velocity);
+    }
+  }
+  printf("pair   %6.1f deg %+5.1f deg/s: %u updates at %3.0f deg, velocity %6.2f deg/s\n", (double)Start,
+         (double)Rate, (unsigned)saturated, (double)end, (double)sl->Track_Velocity);
+  HOST_CHECK(out == 0U, "pair %+.1f deg/s: %u angles out of [0, 180]", (double)Rate, (unsigned)out);
+  HOST_CHECK(saturated > (STEP_UPDATES / 2U), "pair %+.1f deg/s: %u updates at the end", (double)Rate,
+             (unsigned)saturated);
+  HOST_CHECK(fabsf(sl->Track_Velocity) < 0.5f, "pair %+.1f deg/s: velocity %.2f deg/s at rest", (double)Rate,
+             (double)sl->Track_Velocity);
+  free(handler.pInternalMemory);
+}
+
+/**
+  * @brief  Azimuth of the talker at time ms: it moves at the case rate, then
+  *         stays where it is after MoveMs
+  */
+static float Talker_Azimuth(const Track_Case_t *c, uint32_t ms)
+{
+  if ((c->MoveMs != 0U) && (ms > c->MoveMs))
+  {
+    ms = c->MoveMs;
+  }
+  return c->Start + ((c->Rate * (float)ms) / 1000.0f);
+}
+
+/**
+  * @brief  Feeds the broadband talker of the case, with uncorrelated noise
+  *         20 dB below it on each microphone, and checks each tracked estimate
+  */
+static void Run(const Track_Case_t *c, Track_Result_t *res)
+{
+  AcousticSL_Handler_t handler;
+  AcousticSL_MultiOutput_t output;
+  AcousticSL_Source_t sources[1];
+  int16_t buffer[SAMPLES_PER_MS * MAX_MICS];
+  float delay[MAX_MICS];
+  uint32_t seed = 0x2545F491U;
+  int32_t last = ACOUSTIC_SL_NO_AUDIO_DETECTED;
+  uint32_t m, i, k, ms, t = 0;
+
+  memset(&output, 0, sizeof(output));
+  memset(res, 0, sizeof(*res));
+  res->Min = INT32_MAX;
+  res->Max = INT32_MIN;
+  (void)Tracker_Init(&handler, c->Algorithm, c->Mics, c->Resolution);
+  output.pSources = sources;
+  output.max_sources = 1U;
+
+  for (ms = 0; ms < c->Ms; ms++)
+  {
+    /* The 2 mics pair is MIC1/MIC2 on the y axis: its angle runs from -90, towards MIC2, to 90 */
+    float azimuth = Talker_Azimuth(c, ms);
+    float a = ((c->Mics == 2U) ? -azimuth : azimuth) * (float)M_PI / 180.0f;
+
+    for (m = 0; m < c->Mics; m++)
+    {
+      delay[m] = (((float)Coordinates[m][0] * cosf(a)) + ((float)Coordinates[m][1] * sinf(a))) / (10000.0f * SOUND_SPEED);
+    }
+    for (i = 0; i < SAMPLES_PER_MS; i++, t++)
+    {
+      for (m = 0; m < c->Mics; m++)
+      {
+        float time = ((float)t / (float)FS) + delay[m];
+        float v = 0.0f;
+
+        for (k = 0; k < SOURCE_TONES; k++)
+        {
+          v += cosf((2.0f * (float)M_PI * Tone_Freq[k] * time) + Tone_Phase[k]);
+        }
+        v += HostTest_Noise(&seed) * 0.1f * sqrtf((float)SOURCE_TONES);
+        buffer[(i * c->Mics) + m] = (int16_t)(v * 150.0f);
+      }
+    }
+    if (AcousticSL_Data_Input(&buffer[0], &buffer[1], &buffer[2], &buffer[3], &handler) == 1U)
+    {
+      (void)AcousticSL_ProcessMulti(&output, &handler);
+      if (output.estimated_angle == ACOUSTIC_SL_NO_AUDIO_DETECTED)
+      {
+        continue;
+      }
+      res->Estimates++;
+      res->Min = (output.estimated_angle < res->Min) ? output.estimated_angle : res->Min;
+      res->Max = (output.estimated_angle > res->Max) ? output.estimated_angle : res->Max;
+      if ((last != ACOUSTIC_SL_NO_AUDIO_DETECTED) && (abs(output.estimated_angle - last) > 180))
+      {
+        res->Wrapped++;
+      }
+      last = output.estimated_angle;
+      if (ms >= SETTLE_MS)
+      {
+        float error = Angle_Error((float)output.estimated_angle, azimuth);
+
+        res->MaxError = (error > res->MaxError) ? error : res->MaxError;
+        if ((c->MoveMs == 0U) || (ms < c->MoveMs))
+        {
+          res->Velocity += output.angular_velocity;
+          res->Moving++;
+        }
+      }
+    }
+  }
+  res->Velocity = (res->Moving != 0U) ? (res->Velocity / (float)res->Moving) : 0.0f;
+  free(handler.pInternalMemory);
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t seed = 42U;
+  uint32_t n, k;
+
+  HostTest_Init(argc, argv);
+  for (k = 0; k < SOURCE_TONES; k++)
+  {
+    Tone_Freq[k] = 200.0f + (3800.0f * (0.5f + (0.5f * HostTest_Noise(&seed))));
+    Tone_Phase[k] = (float)M_PI * HostTest_Noise(&seed);
+  }
+
+  Step_Circle(340.0f, 30.0f);
+  Step_Circle(20.0f, -30.0f);
+  Step_Circle(350.0f, 90.0f);
+  Step_Circle(0.0f, 0.0f);
+  Step_Round();
+  Step_Pair(150.0f, 60.0f);
+  Step_Pair(30.0f, -60.0f);
+  Step_Pair(90.0f, 180.0f);
+
+  for (n = 0; n < sizeof(Cases) / sizeof(Cases[0]); n++)
+  {
+    const Track_Case_t *c = &Cases[n];
+    Track_Result_t res;
+
+    Run(c, &res);
+    printf("%-36s %4u estimates in [%4d, %4d], %u wraps, error max %5.2f deg, velocity %6.2f deg/s\n",
+           c->Name, (unsigned)res.Estimates, (int)res.Min, (int)res.Max, (unsigned)res.Wrapped,
+           (double)res.MaxError, (double)res.Velocity);
+
+    HOST_CHECK(res.Estimates > ((c->Ms * SAMPLES_PER_MS) / HOP / 2U), "%s: %u estimates", c->Name, (unsigned)res.Estimates);
+    HOST_CHECK(res.MaxError <= c->MaxError, "%s: error %.2f deg, bound %.2f", c->Name, (double)res.MaxError,
+               (double)c->MaxError);
+    HOST_CHECK((c->VelocityError == 0.0f) || (fabsf(res.Velocity - c->Rate) <= c->VelocityError),
+               "%s: velocity %.2f deg/s, talker %.2f", c->Name, (double)res.Velocity, (double)c->Rate);
+    if (c->Mics == 4U)
+    {
+      /* On the circle: no 360, and a talker moving across 0 is followed across it, the
+         estimate jittering on either side of it for a while at the crossing */
+      HOST_CHECK((res.Min >= 0) && (res.Max <= 359), "%s: estimates in [%d, %d]", c->Name, (int)res.Min, (int)res.Max);
+      HOST_CHECK((c->Rate == 0.0f) || (res.Wrapped >= 1U), "%s: not followed across 0", c->Name);
+    }
+    else
+    {
+      HOST_CHECK((res.Min >= -90) && (res.Max <= 90), "%s: estimates in [%d, %d]", c->Name, (int)res.Min, (int)res.Max);
+    }
+  }
+
+  return HostTest_Result("test_sl_track");
+}
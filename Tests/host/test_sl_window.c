@@ -0,0 +1,175 @@
+/**
+  ******************************************************************************
+  * @file    test_sl_window.c
+  * @author  SRA
+  * @brief   AcousticSL: the window triggered by AcousticSL_Data_Input() stays
+  *          intact until the next trigger, so AcousticSL_Process() deferred by
+  *          up to one hop gives the same estimates as an immediate call
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdlib.h>
+#include "acoustic_sl.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define WINDOW             256U
+#define MAX_MICS           4U
+#define TEST_MS            400U
+#define SOUND_SPEED        343.1f
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  const char *Name;
+  uint32_t Algorithm;
+  uint32_t Fs;
+  uint32_t Mics;
+  uint16_t Hop;
+} SL_Case_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const SL_Case_t Cases[] =
+{
+  { "GCCP 2 mics 16 kHz",         ACOUSTIC_SL_ALGORITHM_GCCP, 16000U, 2U, 0U },
+  { "GCCP 2 mics 16 kHz hop 64",  ACOUSTIC_SL_ALGORITHM_GCCP, 16000U, 2U, 64U },
+  { "GCCP 4 mics 16 kHz hop 100", ACOUSTIC_SL_ALGORITHM_GCCP, 16000U, 4U, 100U },
+  { "GCCP 2 mics 48 kHz hop 64",  ACOUSTIC_SL_ALGORITHM_GCCP, 48000U, 2U, 64U },
+  { "SRPP 4 mics 16 kHz hop 128", ACOUSTIC_SL_ALGORITHM_SRPP, 16000U, 4U, 128U },
+};
+
+/* Same cross as test_sl_srp_phat: MIC1/MIC2 and MIC3/MIC4 are the 40 mm pairs */
+static const int16_t Coordinates[MAX_MICS][3] =
+{
+  { 0, -200, 0 }, { 0, 200, 0 }, { -200, 0, 0 }, { 200, 0, 0 }
+};
+
+/* Private functions ---------------------------------------------------------*/
+static void SL_Setup(const SL_Case_t *c, AcousticSL_Handler_t *handler)
+{
+  AcousticSL_Config_t config;
+
+  memset(handler, 0, sizeof(*handler));
+  memset(&config, 0, sizeof(config));
+  handler->algorithm = c->Algorithm;
+  handler->sampling_frequency = c->Fs;
+  handler->channel_number = c->Mics;
+  handler->ptr_M1_channels = c->Mics;
+  handler->ptr_M2_channels = c->Mics;
+  handler->ptr_M3_channels = c->Mics;
+  handler->ptr_M4_channels = c->Mics;
+  handler->M12_distance = 400;
+  handler->M34_distance = 400;
+  handler->samples_to_process = WINDOW;
+  handler->hop_size = c->Hop;
+  memcpy(handler->mic_coordinates, Coordinates, sizeof(Coordinates));
+  (void)AcousticSL_getMemorySize(handler);
+  handler->pInternalMemory = calloc(1, handler->internal_memory_size);
+  HOST_CHECK(AcousticSL_Init(handler) == 0U, "%s: Init", c->Name);
+  config.resolution = 4;
+  config.threshold = 1;
+  HOST_CHECK(AcousticSL_setConfig(handler, &config) == 0U, "%s: setConfig", c->Name);
+}
+
+/**
+  * @brief  Feeds two instances with the same moving source: the first one is
+  *         processed at each trigger, the second one in the last millisecond
+  *         before the next trigger. Their estimates must be identical.
+  */
+static void Run(const SL_Case_t *c)
+{
+  AcousticSL_Handler_t now, late;
+  int16_t buffer[48U * MAX_MICS];
+  uint32_t per_ms = c->Fs / 1000U;
+  uint32_t seed = 7U;
+  uint32_t ms, i, m, t = 0;
+  uint32_t triggers = 0, compared = 0, pending_ms = 0, longest = 0;
+  uint8_t pending = 0;
+  int32_t angle_now = 0, angle_late = 0, expected = 0;
+  int failures = HostTest_Failures;
+
+  SL_Setup(c, &now);
+  SL_Setup(c, &late);
+
+  for (ms = 0; ms < TEST_MS; ms++)
+  {
+    float azimuth = (float)ms * 0.9f * (float)M_PI / 180.0f;
+    float ux = cosf(azimuth);
+    float uy = sinf(azimuth);
+    uint8_t trig_now, trig_late;
+
+    for (i = 0; i < per_ms; i++, t++)
+    {
+      float s = HostTest_Noise(&seed);
+      static float history[64];
+
+      history[t % 64U] = s;
+      for (m = 0; m < c->Mics; m++)
+      {
+        /* whole-sample delays are enough here, the estimates only have to match */
+        float d = (((float)Coordinates[m][0] * ux) + ((float)Coordinates[m][1] * uy)) * (float)c->Fs / (10000.0f * SOUND_SPEED);
+        int32_t lag = (int32_t)lroundf(d) + 8;
+
+        buffer[(i * c->Mics) + m] = (int16_t)(8000.0f * history[(t + 64U - (uint32_t)lag) % 64U]);
+      }
+    }
+
+    /* same data: the late instance triggers on the same millisecond, its pending
+       window is processed just before the input that starts the next one */
+    trig_now = (uint8_t)AcousticSL_Data_Input(&buffer[0], &buffer[1], &buffer[2], &buffer[3], &now);
+    if ((trig_now != 0U) && (pending != 0U))
+    {
+      uint32_t ret_late = AcousticSL_Process(&angle_late, &late);
+
+      HOST_CHECK(ret_late == 0U, "%s: deferred Process returned 0x%x", c->Name, (unsigned)ret_late);
+      HOST_CHECK(angle_late == expected, "%s: deferred estimate %d, immediate %d", c->Name, (int)angle_late, (int)expected);
+      longest = (pending_ms > longest) ? pending_ms : longest;
+      pending = 0;
+      compared++;
+    }
+    trig_late = (uint8_t)AcousticSL_Data_Input(&buffer[0], &buffer[1], &buffer[2], &buffer[3], &late);
+    HOST_CHECK(trig_now == trig_late, "%s: triggers differ at %u ms", c->Name, (unsigned)ms);
+
+    pending_ms++;
+    if (trig_now != 0U)
+    {
+      uint32_t ret_now = AcousticSL_Process(&angle_now, &now);
+
+      HOST_CHECK(ret_now == 0U, "%s: Process returned 0x%x", c->Name, (unsigned)ret_now);
+      triggers++;
+      expected = angle_now;
+      pending = 1;
+      pending_ms = 0;
+    }
+  }
+
+  HOST_CHECK(compared + 1U >= triggers, "%s: %u triggers, %u compared", c->Name, (unsigned)triggers, (unsigned)compared);
+  printf("%-28s %3u windows deferred by up to %2u ms, estimates identical: %s\n", c->Name, (unsigned)compared,
+         (unsigned)longest, (HostTest_Failures == failures) ? "yes" : "no");
+  free(now.pInternalMemory);
+  free(late.pInternalMemory);
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t i;
+
+  HostTest_Init(argc, argv);
+  for (i = 0; i < sizeof(Cases) / sizeof(Cases[0]); i++)
+  {
+    Run(&Cases[i]);
+  }
+  return HostTest_Result("test_sl_window");
+}
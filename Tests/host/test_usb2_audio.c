@@ -0,0 +1,358 @@
+/**
+  ******************************************************************************
+  * @file    test_usb2_audio.c
+  * @author  SRA
+  * @brief   USB microphone: the UAC2 class on a simulated host. The host reads
+  *          the descriptors of the audio function, queries and sets the
+  *          sampling frequency on the clock source, then streams from the
+  *          asynchronous endpoint fed by Send_Audio_to_USB with interrupt
+  *          jitter and clock skew, with the gates of test_usb_audio.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include "audio_sim.h"
+#include "usb_sim.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define TEST_MS            3000U
+#define BENCH_MS           60000U
+#define SETTLE_MS          300U    /* start of the stream and lock of the rate estimate */
+#define COST_BOUND_US      25.0
+#define MAX_EVENT_GLITCHES 4U
+
+/* After the settling time the packets of one frame more, less those of one
+   frame less, than nominal add up to the clock offset, within the frames the
+   fill level still moves by while the rate estimate settles, 8 frames at 48 kHz */
+#define SKEW_BOUND_MS      (8.0 / 48.0)
+
+#define CLOCK_REQ_IN       0xA1U   /* class request to an entity of interface 0 */
+#define CLOCK_REQ_OUT      0x21U
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  AudioSim_Config_t Sim;
+  uint8_t Disturbed;       /* the producer stalls (underrun) or the host pauses (overrun) */
+} USB_Case_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const USB_Case_t Cases[] =
+{
+  { { "48 kHz 2 ch 16 bit, 1 ms blocks",                   48000U, 2U, 16U, 1U,    0.0f, 0.0f,    0U,  0U,    0U,  0U,     0U }, 0U },
+  { { "48 kHz 2 ch 16 bit, 1 ms blocks, +150 ppm, jitter",  48000U, 2U, 16U, 1U,  150.0f, 0.9f,    0U,  0U,    0U,  0U,     0U }, 0U },
+  { { "48 kHz 4 ch 16 bit, 1 ms blocks, -300 ppm, jitter",  48000U, 4U, 16U, 1U, -300.0f, 0.5f,    0U,  0U,    0U,  0U,     0U }, 0U },
+  { { "48 kHz 2 ch 24 bit, 1 ms blocks, -50 ppm, jitter",   48000U, 2U, 24U, 1U,  -50.0f, 0.5f,    0U,  0U,    0U,  0U,     0U }, 0U },
+  { { "16 kHz 8 ch 32 bit, 1 ms blocks, +500 ppm, jitter",  16000U, 8U, 32U, 1U,  500.0f, 0.5f,    0U,  0U,    0U,  0U,     0U }, 0U },
+  { { "host set 32 kHz 2 ch 16 bit, -200 ppm, jitter",      48000U, 2U, 16U, 1U, -200.0f, 0.5f,    0U,  0U,    0U,  0U, 32000U }, 0U },
+  { { "host set 16 kHz 4 ch 16 bit, +80 ppm, jitter",       48000U, 4U, 16U, 1U,   80.0f, 0.9f,    0U,  0U,    0U,  0U, 16000U }, 0U },
+  { { "96 kHz 2 ch 24 bit, 1 ms blocks, +100 ppm, jitter",  96000U, 2U, 24U, 1U,  100.0f, 0.5f,    0U,  0U,    0U,  0U,     0U }, 0U },
+  { { "96 kHz 4 ch 16 bit, 1 ms blocks, -100 ppm, jitter",  96000U, 4U, 16U, 1U, -100.0f, 0.5f,    0U,  0U,    0U,  0U,     0U }, 0U },
+  { { "host set 48 kHz 4 ch 16 bit, +50 ppm, jitter",       96000U, 4U, 16U, 1U,   50.0f, 0.5f,    0U,  0U,    0U,  0U, 48000U }, 0U },
+  { { "48 kHz 2 ch 16 bit, producer stalled 8 ms",          48000U, 2U, 16U, 1U,    0.0f, 0.5f, 1000U,  8U,    0U,  0U,     0U }, 1U },
+  { { "48 kHz 2 ch 16 bit, host busy 12 ms",                48000U, 2U, 16U, 1U,    0.0f, 0.5f,    0U,  0U, 1000U, 12U,     0U }, 1U },
+};
+
+static const uint32_t Frequencies[] = AUDIO2_IN_FREQUENCIES;
+
+/* Formats whose packets exceed the endpoint: AUDIO_IN_PACKET bytes, 1023 at most at full speed */
+static const AudioSim_Config_t Rejected[] =
+{
+  { "96 kHz 4 ch 24 bit", 96000U, 4U, 24U, 1U, 0.0f, 0.0f, 0U, 0U, 0U, 0U, 0U },
+  { "96 kHz 8 ch 16 bit", 96000U, 8U, 16U, 1U, 0.0f, 0.0f, 0U, 0U, 0U, 0U, 0U },
+  { "48 kHz 8 ch 24 bit", 48000U, 8U, 24U, 1U, 0.0f, 0.0f, 0U, 0U, 0U, 0U, 0U },
+  { "96 kHz 3 ch 32 bit", 96000U, 3U, 32U, 1U, 0.0f, 0.0f, 0U, 0U, 0U, 0U, 0U },
+};
+
+static USBD_AUDIO_StatsTypeDef Settled;   /* class statistics at the end of the settling time */
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t Get_U32(const uint8_t *p)
+{
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static int32_t Clock_Request(uint8_t bmRequest, uint8_t bRequest, uint8_t Selector, uint16_t wLength, uint8_t *pData)
+{
+  return UsbSim_Control(&hUSBDDevice, bmRequest, bRequest, (uint16_t)(Selector << 8), MIC_CLOCK_SOURCE_ID << 8,
+                        wLength, pData);
+}
+
+static uint32_t Clock_Get_Frequency(void)
+{
+  uint8_t freq[4];
+
+  if (Clock_Request(CLOCK_REQ_IN, AUDIO_REQ_CUR, AUDIO_CS_SAM_FREQ_CONTROL, sizeof(freq), freq) != (int32_t)sizeof(freq))
+  {
+    return 0;
+  }
+  return Get_U32(freq);
+}
+
+static int32_t Clock_Set_Frequency(uint32_t Freq)
+{
+  uint8_t freq[4] = { (uint8_t)Freq, (uint8_t)(Freq >> 8), (uint8_t)(Freq >> 16), (uint8_t)(Freq >> 24) };
+
+  return Clock_Request(CLOCK_REQ_OUT, AUDIO_REQ_CUR, AUDIO_CS_SAM_FREQ_CONTROL, sizeof(freq), freq);
+}
+
+/**
+  * @brief  The audio function of the configuration descriptor: interface
+  *         association, AC header, clock source, format and endpoint of the
+  *         streaming interface
+  */
+static void Check_Descriptors(const AudioSim_Config_t *cfg, const uint8_t *pConfig, int32_t Len)
+{
+  uint8_t desc[18];
+  uint8_t iad = 0, header = 0, clock = 0, format = 0, endpoint = 0;
+  uint8_t subclass = 0;
+  uint32_t max_packet = ((cfg->Fs / 1000U) + 1U) * cfg->Channels * (cfg->Bits / 8U);
+  int32_t i;
+
+  HOST_CHECK(UsbSim_Control(&hUSBDDevice, 0x80U, USB_REQ_GET_DESCRIPTOR, USB_DESC_TYPE_DEVICE << 8, 0U, 18U, desc) == 18,
+             "%s: device descriptor", cfg->Name);
+  HOST_CHECK((desc[4] == 0xEFU) && (desc[5] == 0x02U) && (desc[6] == 0x01U),
+             "%s: device class %02X/%02X/%02X, not an interface association", cfg->Name, desc[4], desc[5], desc[6]);
+
+  for (i = 0; (i + 2) <= Len; i += pConfig[i])
+  {
+    const uint8_t *d = &pConfig[i];
+
+    if (d[0] < 2U)
+    {
+      break;
+    }
+    switch (d[1])
+    {
+      case USB_INTERFACE_ASSOCIATION_DESCRIPTOR_TYPE:
+        iad++;
+        HOST_CHECK((d[4] == USB_DEVICE_CLASS_AUDIO) && (d[6] == AUDIO_PROTOCOL_IP_VERSION_02_00),
+                   "%s: function class %u protocol %02X", cfg->Name, d[4], d[6]);
+        break;
+      case USB_INTERFACE_DESCRIPTOR_TYPE:
+        subclass = d[6];
+        break;
+      case AUDIO_INTERFACE_DESCRIPTOR_TYPE:
+        if ((subclass == AUDIO_SUBCLASS_AUDIOCONTROL) && (d[2] == AUDIO_CONTROL_HEADER))
+        {
+          header++;
+          HOST_CHECK((d[3] == 0x00U) && (d[4] == 0x02U), "%s: bcdADC %02X%02X", cfg->Name, d[4], d[3]);
+        }
+        else if ((subclass == AUDIO_SUBCLASS_AUDIOCONTROL) && (d[2] == AUDIO_CONTROL_CLOCK_SOURCE))
+        {
+          clock++;
+          HOST_CHECK(d[3] == MIC_CLOCK_SOURCE_ID, "%s: clock source ID %02X", cfg->Name, d[3]);
+        }
+        else if ((subclass == AUDIO_SUBCLASS_AUDIOSTREAMING) && (d[2] == AUDIO_STREAMING_FORMAT_TYPE))
+        {
+          format++;
+          /* 32-bit subslots carry the 24 significant bits of the microphones */
+          HOST_CHECK((d[3] == AUDIO_FORMAT_TYPE_I) && (d[4] == (cfg->Bits / 8U)) &&
+                     (d[5] == ((cfg->Bits == 16U) ? 16U : 24U)),
+                     "%s: format type %u, subslot %u bytes, %u bits", cfg->Name, d[3], d[4], d[5]);
+        }
+        break;
+      case USB_DESC_TYPE_ENDPOINT:
+        if (d[2] == AUDIO_IN_EP)
+        {
+          endpoint++;
+          HOST_CHECK((d[3] & 0x0FU) == 0x05U, "%s: endpoint attributes %02X, not isochronous asynchronous",
+                     cfg->Name, d[3]);
+          HOST_CHECK(((uint32_t)(d[4] | (d[5] << 8)) == max_packet) && (max_packet <= AUDIO_IN_PACKET_MAX),
+                     "%s: wMaxPacketSize %u, %u expected, %u at most", cfg->Name,
+                     (unsigned)(d[4] | (d[5] << 8)), (unsigned)max_packet, (unsigned)AUDIO_IN_PACKET_MAX);
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  HOST_CHECK((iad == 1U) && (header == 1U) && (clock == 1U) && (format == 1U) && (endpoint == 1U),
+             "%s: %u IAD, %u AC headers, %u clock sources, %u formats, %u microphone endpoints",
+             cfg->Name, iad, header, clock, format, endpoint);
+}
+
+/**
+  * @brief  Clock source requests: current frequency, the range of the
+  *         frequencies up to the descriptor one, validity, and the frequency
+  *         set by the host, an unsupported one being ignored
+  */
+static void Check_Clock(const AudioSim_Config_t *cfg)
+{
+  uint8_t range[2U + (12U * AUDIO2_IN_MAX_FREQUENCIES)];
+  uint8_t valid = 0;
+  uint32_t expected = 0, i, n;
+  int32_t len;
+
+  HOST_CHECK(Clock_Get_Frequency() == cfg->Fs, "%s: GET_CUR frequency %u", cfg->Name, (unsigned)Clock_Get_Frequency());
+
+  len = Clock_Request(CLOCK_REQ_IN, AUDIO_REQ_RANGE, AUDIO_CS_SAM_FREQ_CONTROL, sizeof(range), range);
+  n = (len >= 2) ? (uint32_t)(range[0] | (range[1] << 8)) : 0U;
+  HOST_CHECK(len == (int32_t)(2U + (12U * n)), "%s: GET_RANGE %d bytes for %u subranges", cfg->Name, (int)len, (unsigned)n);
+  for (i = 0; i < (sizeof(Frequencies) / sizeof(Frequencies[0])); i++)
+  {
+    if (Frequencies[i] <= cfg->Fs)
+    {
+      HOST_CHECK((expected < n) && (Get_U32(&range[2U + (12U * expected)]) == Frequencies[i]) &&
+                 (Get_U32(&range[6U + (12U * expected)]) == Frequencies[i]) &&
+                 (Get_U32(&range[10U + (12U * expected)]) == 0U),
+                 "%s: subrange %u is not %u Hz", cfg->Name, (unsigned)expected, (unsigned)Frequencies[i]);
+      expected++;
+    }
+  }
+  HOST_CHECK(n == expected, "%s: %u subranges, %u frequencies up to %u Hz", cfg->Name, (unsigned)n,
+             (unsigned)expected, (unsigned)cfg->Fs);
+
+  HOST_CHECK((Clock_Request(CLOCK_REQ_IN, AUDIO_REQ_CUR, AUDIO_CS_CLOCK_VALID_CONTROL, 1U, &valid) == 1) && (valid == 1U),
+             "%s: clock not valid", cfg->Name);
+
+  (void)Clock_Set_Frequency(44100U);
+  HOST_CHECK(Clock_Get_Frequency() == cfg->Fs, "%s: 44.1 kHz accepted, %u Hz", cfg->Name, (unsigned)Clock_Get_Frequency());
+  for (i = 0; i < (sizeof(Frequencies) / sizeof(Frequencies[0])); i++)
+  {
+    if (Frequencies[i] <= cfg->Fs)
+    {
+      /* The application records up to AUDIO_IN_SAMPLING_FREQUENCY, it refuses
+         the frequencies above and the clock stays where it was */
+      expected = (Frequencies[i] <= AUDIO_IN_SAMPLING_FREQUENCY) ? Frequencies[i] : Clock_Get_Frequency();
+      HOST_CHECK((Clock_Set_Frequency(Frequencies[i]) == 4) && (Clock_Get_Frequency() == expected),
+                 "%s: SET_CUR %u Hz, GET_CUR %u Hz", cfg->Name, (unsigned)Frequencies[i],
+                 (unsigned)Clock_Get_Frequency());
+    }
+  }
+}
+
+static void Check_Function(const AudioSim_Config_t *cfg)
+{
+  uint8_t config[512];
+  int32_t len;
+
+  len = AudioSim_Attach(cfg, config, sizeof(config));
+  HOST_CHECK(len > 0, "%s: enumeration failed", cfg->Name);
+  if (len > 0)
+  {
+    Check_Descriptors(cfg, config, len);
+    Check_Clock(cfg);
+  }
+  AudioSim_Detach();
+}
+
+/**
+  * @brief  A format with packets larger than the endpoint is refused by the
+  *         descriptor set up and the class does not start: the device does
+  *         not enumerate and no packet is sent
+  */
+static void Check_Rejected(const AudioSim_Config_t *cfg)
+{
+  uint8_t config[512];
+  int32_t len;
+
+  HOST_CHECK(USBD_AUDIO_Init_Microphone_Descriptor_Config(&hUSBDDevice, cfg->Fs, cfg->Channels, 0x0000U, cfg->Bits)
+             == USBD_FAIL, "%s: format accepted", cfg->Name);
+  len = AudioSim_Attach(cfg, config, sizeof(config));
+  HOST_CHECK(len < 0, "%s: enumerated", cfg->Name);
+  AudioSim_Detach();
+}
+
+/**
+  * @brief  Keeps the class statistics the SOF of the end of the settling time sees
+  */
+static void Stats_Trace(uint32_t Frame, USBD_HandleTypeDef *pdev)
+{
+  if ((Frame == SETTLE_MS) && (pdev->pClassData != NULL))
+  {
+    Settled = ((USBD_AUDIO_HandleTypeDef *)pdev->pClassData)->stats;
+  }
+}
+
+static float Latency_Bound(const AudioSim_Config_t *cfg)
+{
+  return (float)(((AUDIO_IN_PACKET_NUM / 2U) + 1U) * cfg->BlockMs) + cfg->JitterMs + 1.0f;
+}
+
+static void Run(const USB_Case_t *c, uint32_t ms)
+{
+  const AudioSim_Config_t *cfg = &c->Sim;
+  AudioSim_Result_t res;
+  const USBD_AUDIO_StatsTypeDef *dev = &res.Device;
+  uint32_t fs = (cfg->HostFs != 0U) ? cfg->HostFs : cfg->Fs;
+  double skew;
+  int32_t net;
+
+  memset(&Settled, 0, sizeof(Settled));
+  if (AudioSim_Run(cfg, ms, SETTLE_MS, &res) != 0)
+  {
+    HOST_CHECK(0, "%s: the stream did not start", cfg->Name);
+    return;
+  }
+  AudioSim_Print(cfg, &res);
+
+  HOST_CHECK(UsbSim_Get_Stats()->Oversize == 0U, "%s: packets over wMaxPacketSize", cfg->Name);
+  HOST_CHECK(res.BadSize == 0U, "%s: %u packets of a wrong size", cfg->Name, (unsigned)res.BadSize);
+  HOST_CHECK(dev->timeouts == 0U, "%s: %u timeouts", cfg->Name, (unsigned)dev->timeouts);
+  if (c->Disturbed == 0U)
+  {
+    HOST_CHECK(dev->dummy_packets <= ((uint32_t)cfg->BlockMs + 2U), "%s: %u dummy packets", cfg->Name, (unsigned)dev->dummy_packets);
+    HOST_CHECK(dev->underruns == 0U, "%s: %u underruns", cfg->Name, (unsigned)dev->underruns);
+    HOST_CHECK(dev->overruns == 0U, "%s: %u overruns", cfg->Name, (unsigned)dev->overruns);
+    HOST_CHECK(res.Silent == 0U, "%s: %u silent packets", cfg->Name, (unsigned)res.Silent);
+    HOST_CHECK(res.Glitches == 0U, "%s: %u glitches", cfg->Name, (unsigned)res.Glitches);
+    HOST_CHECK(res.LatencyMax <= Latency_Bound(cfg), "%s: latency %.2f ms, bound %.2f ms", cfg->Name,
+               (double)res.LatencyMax, (double)Latency_Bound(cfg));
+    /* the asynchronous endpoint follows the microphone clock */
+    net = (int32_t)(dev->long_packets - Settled.long_packets) - (int32_t)(dev->short_packets - Settled.short_packets);
+    skew = (double)(fs / 1000U) * (double)(ms - SETTLE_MS) * (double)cfg->Ppm * 1e-6;
+    HOST_CHECK(fabs((double)net - skew) <= (SKEW_BOUND_MS * (double)(fs / 1000U)),
+               "%s: %d frames of packet size correction, clock offset %.1f", cfg->Name, (int)net, skew);
+  }
+  else
+  {
+    if (cfg->StallMs != 0U)
+    {
+      HOST_CHECK((dev->underruns != 0U) && (dev->overruns == 0U), "%s: %u underruns, %u overruns", cfg->Name,
+                 (unsigned)dev->underruns, (unsigned)dev->overruns);
+    }
+    else
+    {
+      HOST_CHECK((dev->overruns != 0U) && (dev->underruns == 0U), "%s: %u overruns, %u underruns", cfg->Name,
+                 (unsigned)dev->overruns, (unsigned)dev->underruns);
+    }
+    HOST_CHECK(res.Glitches <= MAX_EVENT_GLITCHES, "%s: %u glitches", cfg->Name, (unsigned)res.Glitches);
+    HOST_CHECK((res.TailSilent == 0U) && (res.TailGlitches == 0U), "%s: not recovered, %u silent packets, %u glitches",
+               cfg->Name, (unsigned)res.TailSilent, (unsigned)res.TailGlitches);
+  }
+  HOST_CHECK(res.PacketCost <= COST_BOUND_US, "%s: %.2f us per packet", cfg->Name, res.PacketCost);
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t i;
+
+  HostTest_Init(argc, argv);
+  AudioSim_Set_Trace(Stats_Trace);
+  for (i = 0; i < sizeof(Cases) / sizeof(Cases[0]); i++)
+  {
+    if (Cases[i].Sim.HostFs == 0U)
+    {
+      Check_Function(&Cases[i].Sim);
+    }
+    Run(&Cases[i], HostTest_Bench ? BENCH_MS : TEST_MS);
+  }
+  for (i = 0; i < sizeof(Rejected) / sizeof(Rejected[0]); i++)
+  {
+    Check_Rejected(&Rejected[i]);
+  }
+  return HostTest_Result("test_usb2_audio");
+}
@@ -0,0 +1,130 @@
+/**
+  ******************************************************************************
+  * @file    test_usb_audio.c
+  * @author  SRA
+  * @brief   USB microphone: the UAC1 class on a simulated host, fed by
+  *          Send_Audio_to_USB with interrupt jitter and clock skew. Steady
+  *          streams have no underrun, overrun, dummy packet or glitch and
+  *          a bounded latency; a stalled producer or a busy host recover.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "audio_sim.h"
+#include "usb_sim.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define TEST_MS            3000U
+#define BENCH_MS           60000U
+#define SETTLE_MS          300U    /* start of the stream and lock of the resampler */
+
+/* Mean device time per packet. The target budget is tens of us at 80 MHz, a
+   host core spends a few: the bound only catches an order of magnitude */
+#define COST_BOUND_US      25.0
+
+/* A stall or a pause breaks the tones where the stream restarts or skips, not
+   after: a ring read past its write pointer keeps glitching until relocked.
+   The gap of the blocks dropped by a busy host spreads over the 4 taps of the
+   resampler */
+#define MAX_EVENT_GLITCHES 6U
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  AudioSim_Config_t Sim;
+  uint8_t Disturbed;       /* the producer stalls (underrun) or the host pauses (overrun) */
+} USB_Case_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const USB_Case_t Cases[] =
+{
+  { { "48 kHz 2 ch 16 bit, 1 ms blocks",                   48000U, 2U, 16U, 1U,    0.0f, 0.0f,    0U,  0U,    0U,  0U, 0U }, 0U },
+  { { "48 kHz 2 ch 16 bit, 1 ms blocks, +150 ppm, jitter",  48000U, 2U, 16U, 1U,  150.0f, 0.9f,    0U,  0U,    0U,  0U, 0U }, 0U },
+  { { "48 kHz 4 ch 16 bit, 1 ms blocks, -300 ppm, jitter",  48000U, 4U, 16U, 1U, -300.0f, 0.5f,    0U,  0U,    0U,  0U, 0U }, 0U },
+  { { "16 kHz 4 ch 16 bit, 4 ms blocks, +80 ppm, jitter",   16000U, 4U, 16U, 4U,   80.0f, 3.0f,    0U,  0U,    0U,  0U, 0U }, 0U },
+  { { "48 kHz 2 ch 24 bit, 1 ms blocks, -50 ppm, jitter",   48000U, 2U, 24U, 1U,  -50.0f, 0.5f,    0U,  0U,    0U,  0U, 0U }, 0U },
+  { { "16 kHz 8 ch 32 bit, 1 ms blocks, +500 ppm, jitter",  16000U, 8U, 32U, 1U,  500.0f, 0.5f,    0U,  0U,    0U,  0U, 0U }, 0U },
+  { { "48 kHz 2 ch 16 bit, producer stalled 8 ms",          48000U, 2U, 16U, 1U,    0.0f, 0.5f, 1000U,  8U,    0U,  0U, 0U }, 1U },
+  { { "48 kHz 2 ch 16 bit, host busy 12 ms",                48000U, 2U, 16U, 1U,    0.0f, 0.5f,    0U,  0U, 1000U, 12U, 0U }, 1U },
+};
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Largest capture to host latency accepted: the ring is kept half
+  *         full, AUDIO_IN_PACKET_NUM / 2 blocks, plus the block being captured,
+  *         its interrupt latency and one frame of resampler correction
+  */
+static float Latency_Bound(const AudioSim_Config_t *cfg)
+{
+  return (float)(((AUDIO_IN_PACKET_NUM / 2U) + 1U) * cfg->BlockMs) + cfg->JitterMs + 1.0f;
+}
+
+static void Run(const USB_Case_t *c, uint32_t ms)
+{
+  const AudioSim_Config_t *cfg = &c->Sim;
+  AudioSim_Result_t res;
+  const USBD_AUDIO_StatsTypeDef *dev = &res.Device;
+
+  if (AudioSim_Run(cfg, ms, SETTLE_MS, &res) != 0)
+  {
+    HOST_CHECK(0, "%s: the stream did not start", cfg->Name);
+    return;
+  }
+  AudioSim_Print(cfg, &res);
+
+  HOST_CHECK(UsbSim_Get_Stats()->Oversize == 0U, "%s: packets over wMaxPacketSize", cfg->Name);
+  HOST_CHECK(res.BadSize == 0U, "%s: %u packets of a wrong size", cfg->Name, (unsigned)res.BadSize);
+  HOST_CHECK(dev->timeouts == 0U, "%s: %u timeouts", cfg->Name, (unsigned)dev->timeouts);
+  if (c->Disturbed == 0U)
+  {
+    /* dummy packets only until the first block is written */
+    HOST_CHECK(dev->dummy_packets <= ((uint32_t)cfg->BlockMs + 2U), "%s: %u dummy packets", cfg->Name, (unsigned)dev->dummy_packets);
+    HOST_CHECK(dev->underruns == 0U, "%s: %u underruns", cfg->Name, (unsigned)dev->underruns);
+    HOST_CHECK(dev->overruns == 0U, "%s: %u overruns", cfg->Name, (unsigned)dev->overruns);
+    HOST_CHECK(res.Silent == 0U, "%s: %u silent packets", cfg->Name, (unsigned)res.Silent);
+    HOST_CHECK(res.Glitches == 0U, "%s: %u glitches", cfg->Name, (unsigned)res.Glitches);
+    HOST_CHECK(res.LatencyMax <= Latency_Bound(cfg), "%s: latency %.2f ms, bound %.2f ms", cfg->Name,
+               (double)res.LatencyMax, (double)Latency_Bound(cfg));
+  }
+  else
+  {
+    /* the counters see the event, the stream is clean again afterwards */
+    if (cfg->StallMs != 0U)
+    {
+      HOST_CHECK((dev->underruns != 0U) && (dev->overruns == 0U), "%s: %u underruns, %u overruns", cfg->Name,
+                 (unsigned)dev->underruns, (unsigned)dev->overruns);
+    }
+    else
+    {
+      HOST_CHECK((dev->overruns != 0U) && (dev->underruns == 0U), "%s: %u overruns, %u underruns", cfg->Name,
+                 (unsigned)dev->overruns, (unsigned)dev->underruns);
+    }
+    HOST_CHECK(res.Glitches <= MAX_EVENT_GLITCHES, "%s: %u glitches", cfg->Name, (unsigned)res.Glitches);
+    HOST_CHECK((res.TailSilent == 0U) && (res.TailGlitches == 0U), "%s: not recovered, %u silent packets, %u glitches",
+               cfg->Name, (unsigned)res.TailSilent, (unsigned)res.TailGlitches);
+  }
+  HOST_CHECK(res.PacketCost <= COST_BOUND_US, "%s: %.2f us per packet", cfg->Name, res.PacketCost);
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t i;
+
+  HostTest_Init(argc, argv);
+  for (i = 0; i < sizeof(Cases) / sizeof(Cases[0]); i++)
+  {
+    Run(&Cases[i], HostTest_Bench ? BENCH_MS : TEST_MS);
+  }
+  return HostTest_Result("test_usb_audio");
+}
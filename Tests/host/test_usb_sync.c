@@ -0,0 +1,209 @@
+/**
+  ******************************************************************************
+  * @file    test_usb_sync.c
+  * @author  SRA
+  * @brief   USB microphone: lock of the SOF driven resampler of the UAC1 class
+  *          (AUDIO_IN_SYNC_KP, AUDIO_IN_SYNC_KI) on a microphone clock offset
+  *          from the host frame clock. Within AUDIO_IN_SYNC_MAX_DEVIATION the
+  *          ratio settles on the offset and the fill level on its set point,
+  *          beyond it the stream reports the slips.
+  *
+  *          test_usb_sync [-b] [ppm ...] runs the given offsets instead of the
+  *          sweep.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdlib.h>
+#include "audio_sim.h"
+#include "cca02m2_audio.h"
+#include "host_test.h"
+
+/* Private define ------------------------------------------------------------*/
+#define TEST_MS            20000U
+#define BENCH_MS           200000U
+#define MAX_OFFSETS        32U
+
+/* Locked: the integral term within LOCK_PPM of the offset and the fill level
+   within LOCK_FILL_MS of its set point, averaged over a sync period, until the
+   end. The fill level is counted in whole frames: near the offsets where it
+   slips by one frame every sync periods the integral term cycles by tens of ppm */
+#define LOCK_PPM           25.0
+#define LOCK_FILL_MS       0.05
+#define LOCK_BOUND_MS      5000U
+
+/* Mean residuals over the last quarter of the run */
+#define RATIO_BOUND_PPM    2.0
+#define FILL_BOUND_MS      0.01
+
+#ifdef AUDIO_IN_RESAMPLING
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  double Ppm;
+  uint32_t Tail;            /* first frame of the last quarter */
+  uint32_t LockMs;          /* first frame of the locked run, 0: not locked at the end */
+  double FillAcc;           /* fill level error accumulated over the sync period */
+  uint32_t FillCount;
+  double PeakFill;          /* largest period error, ms */
+  double TailRatio;         /* sums over the last quarter */
+  double TailFill;
+  uint32_t TailCount;
+  double TailFillMax;
+} Sync_Trace_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const float Sweep[] =
+{
+  0.0f, 20.0f, -20.0f, 100.0f, -100.0f, 500.0f, -500.0f, 1000.0f, -1000.0f,
+  2000.0f, -2000.0f, 4000.0f, -4000.0f, 6000.0f, -6000.0f
+};
+
+static Sync_Trace_t Sync;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Samples the controller on each SOF: ratio, integral term, and the
+  *         fill level error it sees (ring plus frames captured and not passed
+  *         yet), averaged over its sync period
+  */
+static void Sync_Trace(uint32_t Frame, USBD_HandleTypeDef *pdev)
+{
+  USBD_AUDIO_HandleTypeDef *haudio = (USBD_AUDIO_HandleTypeDef *)pdev->pClassData;
+  uint32_t frame_dim, nominal, pending = 0;
+  double fill, ratio_err, rate_err;
+
+  if ((haudio == NULL) || (haudio->state != STATE_USB_BUFFER_WRITE_STARTED))
+  {
+    Sync.LockMs = 0;
+    Sync.FillAcc = 0.0;
+    Sync.FillCount = 0;
+    return;
+  }
+  frame_dim = haudio->channels * haudio->subframe;
+  nominal = haudio->paketDimension / frame_dim;
+  (void)CCA02M2_AUDIO_IN_GetPosition(CCA02M2_AUDIO_INSTANCE, &pending);
+  fill = (double)(((haudio->wr_ptr + haudio->buffer_length) - haudio->rd_ptr) % haudio->buffer_length) / (double)frame_dim;
+  fill += (double)pending - (double)haudio->phase - ((double)(((AUDIO_IN_PACKET_NUM / 2) + 1U) * haudio->dataAmount) / (double)frame_dim);
+  Sync.FillAcc += fill / (double)nominal;
+  if (++Sync.FillCount < AUDIO_IN_SYNC_PERIOD)
+  {
+    return;
+  }
+  fill = Sync.FillAcc / (double)AUDIO_IN_SYNC_PERIOD;
+  Sync.FillAcc = 0.0;
+  Sync.FillCount = 0;
+
+  ratio_err = (((double)haudio->ratio - 1.0) * 1e6) - Sync.Ppm;
+  rate_err = ((double)haudio->integrator * 1e6) - Sync.Ppm;
+  Sync.PeakFill = (fabs(fill) > Sync.PeakFill) ? fabs(fill) : Sync.PeakFill;
+  if ((fabs(rate_err) <= LOCK_PPM) && (fabs(fill) <= LOCK_FILL_MS))
+  {
+    Sync.LockMs = (Sync.LockMs == 0U) ? Frame : Sync.LockMs;
+  }
+  else
+  {
+    Sync.LockMs = 0;
+  }
+  if (Frame >= Sync.Tail)
+  {
+    Sync.TailRatio += ratio_err;
+    Sync.TailFill += fill;
+    Sync.TailFillMax = (fabs(fill) > Sync.TailFillMax) ? fabs(fill) : Sync.TailFillMax;
+    Sync.TailCount++;
+  }
+}
+
+static void Run(float ppm, uint32_t ms)
+{
+  AudioSim_Config_t cfg = { "", 48000U, 2U, 16U, 1U, ppm, 0.5f, 0U, 0U, 0U, 0U, 0U };
+  AudioSim_Result_t res;
+  const USBD_AUDIO_StatsTypeDef *dev = &res.Device;
+  uint8_t in_range = (fabsf(ppm) * 1e-6f) < (AUDIO_IN_SYNC_MAX_DEVIATION * 0.9f);
+  char name[48];
+  double tail_ratio, tail_fill;
+
+  snprintf(name, sizeof(name), "%+6.0f ppm", (double)ppm);
+  cfg.Name = name;
+  memset(&Sync, 0, sizeof(Sync));
+  Sync.Ppm = (double)ppm;
+  Sync.Tail = ms - (ms / 4U);
+  if (AudioSim_Run(&cfg, ms, 0U, &res) != 0)
+  {
+    HOST_CHECK(0, "%s: the stream did not start", name);
+    return;
+  }
+  tail_ratio = (Sync.TailCount != 0U) ? (Sync.TailRatio / (double)Sync.TailCount) : 1e9;
+  tail_fill = (Sync.TailCount != 0U) ? (Sync.TailFill / (double)Sync.TailCount) : 1e9;
+
+  printf("%s: lock %6.2f s, fill error peak %6.3f ms, last quarter ratio %+7.3f ppm, fill %+7.4f ms (max %.4f) | "
+         "%u underruns, %u overruns, %u glitches\n",
+         name, (double)Sync.LockMs * 1e-3, Sync.PeakFill, tail_ratio, tail_fill, Sync.TailFillMax,
+         (unsigned)dev->underruns, (unsigned)dev->overruns, (unsigned)res.Glitches);
+
+  if (in_range != 0U)
+  {
+    HOST_CHECK((Sync.LockMs != 0U) && (Sync.LockMs <= LOCK_BOUND_MS), "%s: locked at %u ms", name, (unsigned)Sync.LockMs);
+    HOST_CHECK(fabs(tail_ratio) <= RATIO_BOUND_PPM, "%s: ratio off by %.3f ppm", name, tail_ratio);
+    HOST_CHECK(fabs(tail_fill) <= FILL_BOUND_MS, "%s: fill level off by %.4f ms", name, tail_fill);
+    HOST_CHECK((dev->underruns + dev->overruns + res.Glitches) == 0U, "%s: %u underruns, %u overruns, %u glitches",
+               name, (unsigned)dev->underruns, (unsigned)dev->overruns, (unsigned)res.Glitches);
+  }
+  else
+  {
+    /* beyond the deviation bound the ring slips, and says so */
+    HOST_CHECK((dev->underruns + dev->overruns) != 0U, "%s: the slips are not counted", name);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  float offsets[MAX_OFFSETS];
+  uint32_t count = 0, i;
+  int a;
+
+  HostTest_Init(argc, argv);
+  AudioSim_Set_Trace(Sync_Trace);
+  for (a = 1; (a < argc) && (count < MAX_OFFSETS); a++)
+  {
+    if (strcmp(argv[a], "-b") != 0)
+    {
+      offsets[count++] = strtof(argv[a], NULL);
+    }
+  }
+  if (count == 0U)
+  {
+    for (i = 0; i < sizeof(Sweep) / sizeof(Sweep[0]); i++)
+    {
+      offsets[count++] = Sweep[i];
+    }
+  }
+
+  printf("KP %g per ms of error, KI %g per ms and per %u SOFs, deviation bound %.0f ppm\n",
+         (double)AUDIO_IN_SYNC_KP, (double)AUDIO_IN_SYNC_KI, (unsigned)AUDIO_IN_SYNC_PERIOD,
+         (double)AUDIO_IN_SYNC_MAX_DEVIATION * 1e6);
+  for (i = 0; i < count; i++)
+  {
+    Run(offsets[i], HostTest_Bench ? BENCH_MS : TEST_MS);
+  }
+  return HostTest_Result("test_usb_sync");
+}
+#else
+int main(int argc, char **argv)
+{
+  HostTest_Init(argc, argv);
+  printf("AUDIO_IN_RESAMPLING is not defined: packets follow the fill level, nothing to lock\n");
+  return HostTest_Result("test_usb_sync");
+}
+#endif /* AUDIO_IN_RESAMPLING */
@@ -0,0 +1,412 @@
+/**
+  ******************************************************************************
+  * @file    usb_sim.c
+  * @author  SRA
+  * @brief   Simulated USB full speed bus for the host tests. The USBD_LL_xxx
+  *          functions stand in for usbd_conf.c and the PCD driver: endpoints
+  *          only record what the stack arms. The simulated host then reads the
+  *          armed IN packets and hands the completions back to the stack, as
+  *          the PCD interrupt does on the target.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "usb_sim.h"
+
+/* Private define ------------------------------------------------------------*/
+#define SIM_EP_NUM           16U
+#define SIM_DEVICE_ADDRESS   7U
+#define SIM_MAX_CONFIG       512U
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  uint8_t *pBuf;
+  uint32_t Len;
+  uint16_t Mps;
+  uint8_t Type;
+  uint8_t Open;
+  uint8_t Armed;
+  uint8_t Stall;
+} Sim_Endpoint_t;
+
+/* Private variables ---------------------------------------------------------*/
+DWT_Type UsbSim_DWT;
+
+static Sim_Endpoint_t Sim_In[SIM_EP_NUM];
+static Sim_Endpoint_t Sim_Out[SIM_EP_NUM];
+static UsbSim_Packet_Callback Sim_Callback;
+static UsbSim_Stats_t Sim_Stats;
+
+/* Private functions ---------------------------------------------------------*/
+static double Sim_Time(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+static Sim_Endpoint_t *Sim_Endpoint(uint8_t ep_addr)
+{
+  return ((ep_addr & 0x80U) != 0U) ? &Sim_In[ep_addr & 0xFU] : &Sim_Out[ep_addr & 0xFU];
+}
+
+/* Stand-in low layer --------------------------------------------------------*/
+USBD_StatusTypeDef USBD_LL_Init(USBD_HandleTypeDef *pdev)
+{
+  return USBD_OK;
+}
+
+USBD_StatusTypeDef USBD_LL_DeInit(USBD_HandleTypeDef *pdev)
+{
+  return USBD_OK;
+}
+
+USBD_StatusTypeDef USBD_LL_Start(USBD_HandleTypeDef *pdev)
+{
+  return USBD_OK;
+}
+
+USBD_StatusTypeDef USBD_LL_Stop(USBD_HandleTypeDef *pdev)
+{
+  return USBD_OK;
+}
+
+USBD_StatusTypeDef USBD_LL_OpenEP(USBD_HandleTypeDef *pdev, uint8_t ep_addr, uint8_t ep_type, uint16_t ep_mps)
+{
+  Sim_Endpoint_t *ep = Sim_Endpoint(ep_addr);
+
+  memset(ep, 0, sizeof(*ep));
+  ep->Type = ep_type;
+  ep->Mps = ep_mps;
+  ep->Open = 1U;
+  return USBD_OK;
+}
+
+USBD_StatusTypeDef USBD_LL_CloseEP(USBD_HandleTypeDef *pdev, uint8_t ep_addr)
+{
+  Sim_Endpoint(ep_addr)->Open = 0U;
+  Sim_Endpoint(ep_addr)->Armed = 0U;
+  return USBD_OK;
+}
+
+USBD_StatusTypeDef USBD_LL_FlushEP(USBD_HandleTypeDef *pdev, uint8_t ep_addr)
+{
+  Sim_Endpoint(ep_addr)->Armed = 0U;
+  return USBD_OK;
+}
+
+USBD_StatusTypeDef USBD_LL_StallEP(USBD_HandleTypeDef *pdev, uint8_t ep_addr)
+{
+  Sim_Endpoint(ep_addr)->Stall = 1U;
+  return USBD_OK;
+}
+
+USBD_StatusTypeDef USBD_LL_ClearStallEP(USBD_HandleTypeDef *pdev, uint8_t ep_addr)
+{
+  Sim_Endpoint(ep_addr)->Stall = 0U;
+  return USBD_OK;
+}
+
+uint8_t USBD_LL_IsStallEP(USBD_HandleTypeDef *pdev, uint8_t ep_addr)
+{
+  return Sim_Endpoint(ep_addr)->Stall;
+}
+
+USBD_StatusTypeDef USBD_LL_SetUSBAddress(USBD_HandleTypeDef *pdev, uint8_t dev_addr)
+{
+  return USBD_OK;
+}
+
+USBD_StatusTypeDef USBD_LL_Transmit(USBD_HandleTypeDef *pdev, uint8_t ep_addr, uint8_t *pbuf, uint32_t size)
+{
+  Sim_Endpoint_t *ep = &Sim_In[ep_addr & 0xFU];
+
+  ep->pBuf = pbuf;
+  ep->Len = size;
+  ep->Armed = 1U;
+  return USBD_OK;
+}
+
+USBD_StatusTypeDef USBD_LL_PrepareReceive(USBD_HandleTypeDef *pdev, uint8_t ep_addr, uint8_t *pbuf, uint32_t size)
+{
+  Sim_Endpoint_t *ep = &Sim_Out[ep_addr & 0xFU];
+
+  ep->pBuf = pbuf;
+  ep->Len = size;
+  ep->Armed = 1U;
+  return USBD_OK;
+}
+
+uint32_t USBD_LL_GetRxDataSize(USBD_HandleTypeDef *pdev, uint8_t ep_addr)
+{
+  return Sim_Out[ep_addr & 0xFU].Len;
+}
+
+void USBD_LL_Delay(uint32_t Delay)
+{
+}
+
+/* Simulated host ------------------------------------------------------------*/
+/**
+  * @brief  Clears the bus: endpoints, statistics and the packet callback
+  * @param  Callback: called for each IN packet read by the host, may be NULL
+  */
+void UsbSim_Reset(UsbSim_Packet_Callback Callback)
+{
+  memset(Sim_In, 0, sizeof(Sim_In));
+  memset(Sim_Out, 0, sizeof(Sim_Out));
+  memset(&Sim_Stats, 0, sizeof(Sim_Stats));
+  memset(&UsbSim_DWT, 0, sizeof(UsbSim_DWT));
+  Sim_Callback = Callback;
+}
+
+/**
+  * @brief  Attaches the device: bus reset at full speed
+  */
+void UsbSim_Connect(USBD_HandleTypeDef *pdev)
+{
+  (void)USBD_LL_SetSpeed(pdev, USBD_SPEED_FULL);
+  (void)USBD_LL_Reset(pdev);
+}
+
+/**
+  * @brief  Runs a control transfer: setup, data stage in 64 byte packets and
+  *         status stage, the way a host controller does
+  * @param  pData: data of the OUT stage, filled by the IN stage
+  * @retval Bytes of the data stage, -1 when the device stalls or does not answer
+  */
+int32_t UsbSim_Control(USBD_HandleTypeDef *pdev, uint8_t bmRequest, uint8_t bRequest, uint16_t wValue,
+                       uint16_t wIndex, uint16_t wLength, uint8_t *pData)
+{
+  uint8_t setup[8] = { bmRequest, bRequest, LOBYTE(wValue), HIBYTE(wValue),
+                       LOBYTE(wIndex), HIBYTE(wIndex), LOBYTE(wLength), HIBYTE(wLength) };
+  uint32_t done = 0;
+  uint32_t len;
+
+  /* a SETUP token clears the halt of the control endpoint */
+  Sim_In[0].Armed = 0U;
+  Sim_In[0].Stall = 0U;
+  Sim_Out[0].Armed = 0U;
+  Sim_Out[0].Stall = 0U;
+  (void)USBD_LL_SetupStage(pdev, setup);
+
+  if (((bmRequest & 0x80U) != 0U) && (wLength != 0U))
+  {
+    for (;;)
+    {
+      if ((Sim_In[0].Armed == 0U) || ((Sim_In[0].Stall != 0U) && (done == 0U)))
+      {
+        return -1;
+      }
+      len = (Sim_In[0].Len < USB_MAX_EP0_SIZE) ? Sim_In[0].Len : USB_MAX_EP0_SIZE;
+      if (len > (wLength - done))
+      {
+        /* babble: the device sends more than asked */
+        return -1;
+      }
+      if (len != 0U)
+      {
+        memcpy(&pData[done], Sim_In[0].pBuf, len);
+      }
+      done += len;
+      Sim_In[0].Armed = 0U;
+      (void)USBD_LL_DataInStage(pdev, 0U, Sim_In[0].pBuf + len);
+      if ((len < USB_MAX_EP0_SIZE) || (done == wLength))
+      {
+        break;
+      }
+    }
+    /* status stage: zero length OUT */
+    (void)USBD_LL_DataOutStage(pdev, 0U, NULL);
+    return (int32_t)done;
+  }
+
+  while (done < wLength)
+  {
+    if ((Sim_Out[0].Armed == 0U) || (Sim_Out[0].Stall != 0U))
+    {
+      return -1;
+    }
+    len = ((wLength - done) < USB_MAX_EP0_SIZE) ? (wLength - done) : USB_MAX_EP0_SIZE;
+    memcpy(Sim_Out[0].pBuf, &pData[done], len);
+    Sim_Out[0].Armed = 0U;
+    done += len;
+    (void)USBD_LL_DataOutStage(pdev, 0U, Sim_Out[0].pBuf + len);
+  }
+  /* status stage: zero length IN */
+  if ((Sim_In[0].Armed == 0U) || (Sim_In[0].Len != 0U) || (Sim_In[0].Stall != 0U))
+  {
+    return -1;
+  }
+  Sim_In[0].Armed = 0U;
+  (void)USBD_LL_DataInStage(pdev, 0U, NULL);
+  return (int32_t)done;
+}
+
+/**
+  * @brief  Enumerates the device as a host does and checks the descriptors
+  *         it reads: lengths, total length of the configuration, endpoints
+  * @param  pConfig: returns the configuration descriptor
+  * @retval Length of the configuration descriptor, -1 on failure
+  */
+int32_t UsbSim_Enumerate(USBD_HandleTypeDef *pdev, uint8_t *pConfig, uint16_t Size)
+{
+  uint8_t desc[USB_MAX_EP0_SIZE * 4U];
+  uint8_t strings[3];
+  int32_t len, total;
+  uint16_t offset, interfaces = 0, last = 0xFFFFU;
+  uint32_t i;
+
+  UsbSim_Connect(pdev);
+  len = UsbSim_Control(pdev, 0x80U, USB_REQ_GET_DESCRIPTOR, USB_DESC_TYPE_DEVICE << 8, 0U, 18U, desc);
+  if ((len != 18) || (desc[0] != 18U) || (desc[1] != USB_DESC_TYPE_DEVICE) || (desc[7] != USB_MAX_EP0_SIZE))
+  {
+    printf("device descriptor: %d bytes\n", (int)len);
+    return -1;
+  }
+  memcpy(strings, &desc[14], sizeof(strings));
+  if (UsbSim_Control(pdev, 0x00U, USB_REQ_SET_ADDRESS, SIM_DEVICE_ADDRESS, 0U, 0U, NULL) != 0)
+  {
+    printf("SET_ADDRESS failed\n");
+    return -1;
+  }
+
+  len = UsbSim_Control(pdev, 0x80U, USB_REQ_GET_DESCRIPTOR, USB_DESC_TYPE_CONFIGURATION << 8, 0U, 9U, pConfig);
+  total = (len == 9) ? (int32_t)(pConfig[2] | (pConfig[3] << 8)) : -1;
+  if ((total < 9) || (total > (int32_t)Size) || (total > (int32_t)SIM_MAX_CONFIG))
+  {
+    printf("configuration descriptor: %d bytes, wTotalLength %d\n", (int)len, (int)total);
+    return -1;
+  }
+  len = UsbSim_Control(pdev, 0x80U, USB_REQ_GET_DESCRIPTOR, USB_DESC_TYPE_CONFIGURATION << 8, 0U, (uint16_t)total, pConfig);
+  if (len != total)
+  {
+    printf("configuration descriptor: %d bytes read, wTotalLength %d\n", (int)len, (int)total);
+    return -1;
+  }
+  for (offset = 0; offset < total; offset += pConfig[offset])
+  {
+    if ((pConfig[offset] < 2U) || ((offset + pConfig[offset]) > total))
+    {
+      printf("configuration descriptor: bad bLength %u at %u\n", pConfig[offset], offset);
+      return -1;
+    }
+    if ((pConfig[offset + 1U] == USB_DESC_TYPE_INTERFACE) && (pConfig[offset + 2U] != last))
+    {
+      last = pConfig[offset + 2U];
+      interfaces++;
+    }
+    if ((pConfig[offset + 1U] == USB_DESC_TYPE_ENDPOINT) && ((pConfig[offset + 4U] | (pConfig[offset + 5U] << 8)) == 0U))
+    {
+      printf("configuration descriptor: endpoint 0x%02x without wMaxPacketSize\n", pConfig[offset + 2U]);
+      return -1;
+    }
+  }
+  if (interfaces != pConfig[4])
+  {
+    printf("configuration descriptor: %u interfaces, bNumInterfaces %u\n", interfaces, pConfig[4]);
+    return -1;
+  }
+
+  for (i = 0; i < sizeof(strings); i++)
+  {
+    if (strings[i] == 0U)
+    {
+      continue;
+    }
+    len = UsbSim_Control(pdev, 0x80U, USB_REQ_GET_DESCRIPTOR, (USB_DESC_TYPE_STRING << 8) | strings[i], 0x0409U, 255U, desc);
+    if ((len < 2) || (desc[0] != len) || (desc[1] != USB_DESC_TYPE_STRING))
+    {
+      printf("string descriptor %u: %d bytes\n", strings[i], (int)len);
+      return -1;
+    }
+  }
+
+  if (UsbSim_Control(pdev, 0x00U, USB_REQ_SET_CONFIGURATION, pConfig[5], 0U, 0U, NULL) != 0)
+  {
+    printf("SET_CONFIGURATION failed\n");
+    return -1;
+  }
+  return total;
+}
+
+/**
+  * @brief  One frame of the bus: SOF, then an IN token to each IN endpoint.
+  *         The packet armed by the device is read and the device is told, as
+  *         the transfer complete interrupt does.
+  * @param  PollIsoc: 0 to skip the isochronous endpoints, as a busy host does
+  */
+void UsbSim_Frame(USBD_HandleTypeDef *pdev, uint8_t PollIsoc)
+{
+  double start = Sim_Time();
+  double device;
+  uint8_t n;
+
+  Sim_Stats.Frames++;
+  (void)USBD_LL_SOF(pdev);
+  device = Sim_Time() - start;
+
+  for (n = 1; n < SIM_EP_NUM; n++)
+  {
+    Sim_Endpoint_t *ep = &Sim_In[n];
+
+    if ((ep->Open == 0U) || ((ep->Type == USBD_EP_TYPE_ISOC) && (PollIsoc == 0U)))
+    {
+      continue;
+    }
+    if (ep->Armed == 0U)
+    {
+      if (ep->Type == USBD_EP_TYPE_ISOC)
+      {
+        Sim_Stats.IsocMissed++;
+        start = Sim_Time();
+        (void)USBD_LL_IsoINIncomplete(pdev, n);
+        device += Sim_Time() - start;
+      }
+      continue;
+    }
+    /* a bulk transfer longer than wMaxPacketSize completes in the same frame */
+    if (ep->Type == USBD_EP_TYPE_ISOC)
+    {
+      Sim_Stats.IsocPackets++;
+      Sim_Stats.Oversize += (ep->Len > ep->Mps) ? 1U : 0U;
+    }
+    ep->Armed = 0U;
+    if (Sim_Callback != NULL)
+    {
+      Sim_Callback(n | 0x80U, ep->pBuf, ep->Len);
+    }
+    start = Sim_Time();
+    (void)USBD_LL_DataInStage(pdev, n, ep->pBuf + ep->Len);
+    device += Sim_Time() - start;
+  }
+
+  Sim_Stats.DeviceSeconds += device;
+  if (device > Sim_Stats.DeviceMax)
+  {
+    Sim_Stats.DeviceMax = device;
+  }
+}
+
+/**
+  * @brief  Bus statistics since UsbSim_Reset
+  */
+const UsbSim_Stats_t *UsbSim_Get_Stats(void)
+{
+  return &Sim_Stats;
+}
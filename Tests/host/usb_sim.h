@@ -0,0 +1,51 @@
+/**
+  ******************************************************************************
+  * @file    usb_sim.h
+  * @author  SRA
+  * @brief   Simulated USB full speed bus for the host tests: the USBD_LL_xxx
+  *          low layer the device stack runs on, and a host issuing control
+  *          transfers, SOF and IN tokens on a virtual 1 ms frame clock
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __USB_SIM_H
+#define __USB_SIM_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbd_core.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Called for each IN packet read by the host, before the device is told */
+typedef void (*UsbSim_Packet_Callback)(uint8_t ep_addr, const uint8_t *pData, uint32_t Len);
+
+typedef struct
+{
+  uint32_t Frames;          /* SOFs issued */
+  uint32_t IsocPackets;     /* isochronous IN packets read */
+  uint32_t IsocMissed;      /* IN tokens of an isochronous endpoint without a packet armed */
+  uint32_t Oversize;        /* packets longer than the endpoint wMaxPacketSize */
+  double   DeviceSeconds;   /* host time spent in the device stack on SOF and IN completions */
+  double   DeviceMax;       /* longest frame of it */
+} UsbSim_Stats_t;
+
+/* Exported functions --------------------------------------------------------*/
+void UsbSim_Reset(UsbSim_Packet_Callback Callback);
+void UsbSim_Connect(USBD_HandleTypeDef *pdev);
+int32_t UsbSim_Control(USBD_HandleTypeDef *pdev, uint8_t bmRequest, uint8_t bRequest, uint16_t wValue,
+                       uint16_t wIndex, uint16_t wLength, uint8_t *pData);
+int32_t UsbSim_Enumerate(USBD_HandleTypeDef *pdev, uint8_t *pConfig, uint16_t Size);
+void UsbSim_Frame(USBD_HandleTypeDef *pdev, uint8_t PollIsoc);
+const UsbSim_Stats_t *UsbSim_Get_Stats(void);
+
+#endif /* __USB_SIM_H */
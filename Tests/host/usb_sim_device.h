@@ -0,0 +1,47 @@
+/**
+  ******************************************************************************
+  * @file    usb_sim_device.h
+  * @author  SRA
+  * @brief   Forced in front of the firmware sources of the USB simulation: the
+  *          device headers are the target ones, the core registers the code
+  *          reads are plain variables of the harness
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2022 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __USB_SIM_DEVICE_H
+#define __USB_SIM_DEVICE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l4xx_hal.h"
+
+/* Exported variables --------------------------------------------------------*/
+/* Cycle counter of the packet statistics, it does not run on the host */
+extern DWT_Type UsbSim_DWT;
+
+/* Exported macro ------------------------------------------------------------*/
+#undef DWT
+#define DWT (&UsbSim_DWT)
+
+/* The simulation runs interrupts one after the other on a single thread:
+   barriers are compiler barriers, exclusive stores always succeed, there is
+   no interrupt to mask */
+#define __DMB()            __sync_synchronize()
+#define __LDREXW(addr)     (*(addr))
+#define __STREXW(val, addr) ((*(addr) = (val)), 0U)
+#define __CLREX()          do { } while (0)
+#define __get_PRIMASK()    0U
+#define __set_PRIMASK(x)   ((void)(x))
+#define __disable_irq()    do { } while (0)
+
+#endif /* __USB_SIM_DEVICE_H */
@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+"""Records the raw PDM frames streamed by the board built with USE_AUDIO_PDM_CAPTURE.
+
+The frames come on the bulk IN endpoint of the telemetry interface: a 16-byte
+header (Audio_PDM_Header_t of audio_application.h) in a short packet, then one
+plane per microphone. The frames are written to the output file as received,
+header included. A gap in the sequence numbers means that the board dropped
+frames the host did not take in time; the frames received are whole, the
+board copies them out of the capture buffer. Telemetry records found between
+frames are skipped.
+
+Requires pyusb and a libusb driver bound to interface 2.
+
+    python3 pdm_capture.py capture.pdm --seconds 10
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+import usb.core
+import usb.util
+
+VID = 0x0483
+PID = 0x5730
+INTERFACE = 2
+EP_IN = 0x82
+EP_OUT = 0x02
+PACKET = 64
+
+CMD_PDM = 0x84
+PDM_MAGIC = 0x314D4450
+HEADER = struct.Struct("<IIIHBB")
+
+
+def read_exact(dev, size, timeout):
+    data = bytearray()
+    while len(data) < size:
+        data += dev.read(EP_IN, size - len(data), timeout)
+    return bytes(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("output", help="framed capture file")
+    parser.add_argument("--seconds", type=float, default=10.0, help="capture length")
+    args = parser.parse_args()
+
+    dev = usb.core.find(idVendor=VID, idProduct=PID)
+    if dev is None:
+        sys.exit("board not found")
+    if dev.is_kernel_driver_active(INTERFACE):
+        dev.detach_kernel_driver(INTERFACE)
+    usb.util.claim_interface(dev, INTERFACE)
+
+    # Stop a previous capture and drain what is queued
+    dev.write(EP_OUT, bytes([CMD_PDM, 0]))
+    try:
+        while True:
+            dev.read(EP_IN, PACKET, 100)
+    except usb.core.USBTimeoutError:
+        pass
+
+    frames = dropped = 0
+    last = None
+    dev.write(EP_OUT, bytes([CMD_PDM, 1]))
+    end = time.monotonic() + args.seconds
+    with open(args.output, "wb") as out:
+        try:
+            while time.monotonic() < end:
+                head = bytes(dev.read(EP_IN, PACKET, 1000))
+                if len(head) != HEADER.size:
+                    continue
+                magic, seq, clock, plane, mics, fmt = HEADER.unpack(head)
+                if magic != PDM_MAGIC:
+                    continue
+                frame = head + read_exact(dev, plane * mics, 1000)
+                if last is not None and seq != last + 1:
+                    dropped += seq - last - 1
+                out.write(frame)
+                frames += 1
+                last = seq
+        finally:
+            dev.write(EP_OUT, bytes([CMD_PDM, 0]))
+            usb.util.release_interface(dev, INTERFACE)
+
+    print("%d frames written, %d dropped by the board" % (frames, dropped))
+
+
+if __name__ == "__main__":
+    main()